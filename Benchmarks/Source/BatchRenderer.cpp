@@ -0,0 +1,335 @@
+#include "BatchRenderer.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int midiChannel = 1;
+    constexpr uint32_t jobSeedStep = 0x9e3779b9u;   // Spreads the job seeds, golden ratio of 2^32
+
+    juce::String formatSeconds(double value)
+    {
+        return juce::String(value, 2).paddedLeft(' ', 10);
+    }
+}
+
+/**
+ * @brief Jobs and results shared by the workers of a batch.
+ */
+struct BatchRenderer::Batch
+{
+    const Settings& settings;                            ///< Parameters of the batch
+    const std::vector<Job>& jobs;                        ///< Every job, in order
+    std::vector<Result>& results;                        ///< One result per job, in job order
+    const std::function<void(const Result&)>& onResult;  ///< Called as jobs finish
+    std::atomic<size_t> nextJob{ 0 };                    ///< Next job to hand out
+    juce::CriticalSection resultLock;                    ///< Serializes result reporting
+
+    /**
+     * @brief Stores a job's result and reports it.
+     */
+    void finish(size_t index, const Result& result)
+    {
+        const juce::ScopedLock scope(resultLock);
+        results[index] = result;
+
+        if (onResult)
+            onResult(result);
+    }
+};
+
+/**
+ * @brief Worker thread owning one headless processor, rendering jobs until none are left.
+ */
+class BatchRenderer::Worker : public juce::Thread
+{
+public:
+    Worker(Batch& batchRef, int index)
+        : juce::Thread("Batch render " + juce::String(index + 1)), batch(batchRef)
+    {
+    }
+
+    void run() override
+    {
+        for (auto index = batch.nextJob++; index < batch.jobs.size() && !threadShouldExit(); index = batch.nextJob++)
+            batch.finish(index, render(batch.jobs[index]));
+
+        // Released on the thread that used it
+        processor.reset();
+    }
+
+private:
+    /**
+     * @brief Creates the processor and loads the preset, returns false if the preset could not be loaded.
+     */
+    bool createProcessor()
+    {
+        const auto& settings = batch.settings;
+
+        processor = std::make_unique<DigitalSynthesizerAudioProcessor>();
+
+        // The workers already fill the cores, and quality never drops under load
+        processor->setMultiCoreRenderingEnabled(false);
+        processor->getQualityGovernor().setEnabled(false);
+
+        if (settings.preset != juce::File() && !OfflineRenderBenchmark::loadPreset(*processor, settings.preset))
+        {
+            processor.reset();
+            return false;
+        }
+
+        processor->setPlayConfigDetails(0, processor->getTotalNumOutputChannels(), settings.sampleRate, settings.blockSize);
+        buffer.setSize(processor->getTotalNumOutputChannels(), settings.blockSize);
+        return true;
+    }
+
+    /**
+     * @brief Renders a job into its file.
+     */
+    Result render(const Job& job)
+    {
+        const auto& settings = batch.settings;
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        Result result;
+        result.name = job.name;
+
+        std::vector<OfflineRenderBenchmark::TimedEvent> events;
+        if (job.midiFile != juce::File())
+        {
+            if (!readMidiFile(job.midiFile, settings.sampleRate, events))
+            {
+                result.error = "unreadable MIDI file";
+                return result;
+            }
+        }
+        else
+        {
+            const auto noteSamples = static_cast<juce::int64>(std::ceil(settings.noteSeconds * settings.sampleRate));
+            events.push_back({ 0, juce::MidiMessage::noteOn(midiChannel, job.note, static_cast<juce::uint8>(job.velocity)) });
+            events.push_back({ noteSamples, juce::MidiMessage::noteOff(midiChannel, job.note) });
+        }
+
+        if (processor == nullptr && !createProcessor())
+        {
+            result.error = "could not load preset";
+            return result;
+        }
+
+        // Reseeded and prepared per job, so the audio does not depend on which worker renders it
+        processor->setRandomSeed(job.seed);
+        processor->prepareToPlay(settings.sampleRate, settings.blockSize);
+
+        const int numChannels = processor->getTotalNumOutputChannels();
+        const auto file = settings.outputDirectory.getChildFile(job.name + getFileExtension(settings.format));
+        auto writer = createWriter(settings, file, numChannels);
+        if (writer == nullptr)
+        {
+            result.error = "could not write " + file.getFileName();
+            return result;
+        }
+
+        const juce::int64 lastEvent = events.empty() ? 0 : events.back().samplePosition;
+        const juce::int64 endSample = lastEvent + static_cast<juce::int64>(std::ceil(settings.tailSeconds * settings.sampleRate));
+        const int silentBlocksToEnd = juce::jmax(1, static_cast<int>(std::ceil(silenceSeconds * settings.sampleRate / settings.blockSize)));
+
+        juce::MidiBuffer midi;
+        size_t nextEvent = 0;
+        juce::int64 position = 0;
+        int silentBlocks = 0;
+
+        while (position < endSample && silentBlocks < silentBlocksToEnd)
+        {
+            const int length = static_cast<int>(juce::jmin<juce::int64>(settings.blockSize, endSample - position));
+            buffer.setSize(numChannels, length, false, false, true);
+
+            midi.clear();
+            for (; nextEvent < events.size() && events[nextEvent].samplePosition < position + length; ++nextEvent)
+                midi.addEvent(events[nextEvent].message, static_cast<int>(events[nextEvent].samplePosition - position));
+
+            buffer.clear();
+            processor->processBlock(buffer, midi);
+
+            if (!writer->writeFromAudioSampleBuffer(buffer, 0, length))
+            {
+                result.error = "could not write " + file.getFileName();
+                processor.reset();
+                return result;
+            }
+
+            position += length;
+
+            // The tail ends once the output stays silent after the last event
+            if (position > lastEvent)
+                silentBlocks = buffer.getMagnitude(0, length) < silenceThreshold ? silentBlocks + 1 : 0;
+        }
+
+        // Flushes and closes the file
+        writer.reset();
+
+        // Voices still sounding would leak into the next job, so that one starts from a fresh processor
+        result.truncated = silentBlocks < silentBlocksToEnd;
+        if (result.truncated)
+            processor.reset();
+
+        result.rendered = true;
+        result.audioSeconds = static_cast<double>(position) / settings.sampleRate;
+        result.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+        return result;
+    }
+
+    Batch& batch;                                                ///< Batch the jobs are taken from
+    std::unique_ptr<DigitalSynthesizerAudioProcessor> processor; ///< Headless processor, created on first use
+    juce::AudioBuffer<float> buffer;                             ///< The one block in flight
+};
+
+std::vector<BatchRenderer::Result> BatchRenderer::run(const Settings& settings, const std::function<void(const Result&)>& onResult)
+{
+    jassert(settings.sampleRate > 0.0 && settings.blockSize > 0);
+
+    const auto jobs = createJobs(settings);
+    std::vector<Result> results(jobs.size());
+    if (jobs.empty())
+        return results;
+
+    Batch batch{ settings, jobs, results, onResult };
+
+    const int requestedThreads = settings.numThreads > 0 ? settings.numThreads : juce::SystemStats::getNumCpus();
+    const int numWorkers = juce::jlimit(1, static_cast<int>(jobs.size()), requestedThreads);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>(batch, i));
+        workers.back()->startThread();
+    }
+
+    for (auto& worker : workers)
+        worker->waitForThreadToExit(-1);
+
+    return results;
+}
+
+juce::String BatchRenderer::formatHeader()
+{
+    return juce::String("job").paddedRight(' ', 32) + "    result" + "   audio s" + "  render s" + "  x realtime";
+}
+
+juce::String BatchRenderer::formatResult(const Result& result)
+{
+    if (!result.rendered)
+        return result.name.paddedRight(' ', 32) + juce::String("FAIL").paddedLeft(' ', 10) + "  " + result.error;
+
+    const double realtime = result.renderSeconds > 0.0 ? result.audioSeconds / result.renderSeconds : 0.0;
+    return result.name.paddedRight(' ', 32)
+        + juce::String(result.truncated ? "truncated" : "ok").paddedLeft(' ', 10)
+        + formatSeconds(result.audioSeconds)
+        + formatSeconds(result.renderSeconds)
+        + juce::String(realtime, 1).paddedLeft(' ', 12);
+}
+
+juce::String BatchRenderer::getFileExtension(Format format)
+{
+    return format == Format::Flac ? ".flac" : ".wav";
+}
+
+std::vector<BatchRenderer::Job> BatchRenderer::createJobs(const Settings& settings)
+{
+    std::vector<Job> jobs;
+    juce::StringArray names;
+
+    // Two MIDI files of the same name in different folders must not write the same file
+    const auto addJob = [&jobs, &names](Job job)
+        {
+            const auto base = job.name;
+            for (int suffix = 2; names.contains(job.name, true); ++suffix)
+                job.name = base + "-" + juce::String(suffix);
+
+            names.add(job.name);
+            jobs.push_back(std::move(job));
+        };
+
+    for (const auto& midiFile : settings.midiFiles)
+        addJob({ midiFile.getFileNameWithoutExtension(), midiFile, -1, 0, 0 });
+
+    for (int note = juce::jmax(0, settings.notes.getStart()); note < juce::jmin(128, settings.notes.getEnd()); ++note)
+    {
+        for (const int velocity : settings.velocities)
+        {
+            // Zero-padded note numbers keep the files in pitch order
+            const auto name = juce::String(note).paddedLeft('0', 3) + "-"
+                + juce::MidiMessage::getMidiNoteName(note, true, true, 4) + "-v" + juce::String(velocity);
+            addJob({ name, {}, note, juce::jlimit(1, 127, velocity), 0 });
+        }
+    }
+
+    // Seeds follow the job order alone, whatever the thread count
+    for (size_t i = 0; i < jobs.size(); ++i)
+        jobs[i].seed = settings.seed + static_cast<uint32_t>(i) * jobSeedStep;
+
+    return jobs;
+}
+
+bool BatchRenderer::readMidiFile(const juce::File& file, double sampleRate, std::vector<OfflineRenderBenchmark::TimedEvent>& events)
+{
+    juce::FileInputStream stream(file);
+    juce::MidiFile midiFile;
+    if (!stream.openedOk() || !midiFile.readFrom(stream))
+        return false;
+
+    midiFile.convertTimestampTicksToSeconds();
+
+    events.clear();
+    for (int track = 0; track < midiFile.getNumTracks(); ++track)
+    {
+        for (const auto* holder : *midiFile.getTrack(track))
+        {
+            const auto& message = holder->message;
+            if (message.isMetaEvent() || message.isSysEx())
+                continue;
+
+            const auto position = static_cast<juce::int64>(std::llround(juce::jmax(0.0, message.getTimeStamp()) * sampleRate));
+            events.push_back({ position, message });
+        }
+    }
+
+    // Stable, so events on the same sample keep their order within a track
+    std::stable_sort(events.begin(), events.end(), [](const auto& a, const auto& b)
+        {
+            return a.samplePosition < b.samplePosition;
+        });
+
+    return true;
+}
+
+std::unique_ptr<juce::AudioFormatWriter> BatchRenderer::createWriter(const Settings& settings, const juce::File& file, int numChannels)
+{
+    if (!file.getParentDirectory().createDirectory() || (file.existsAsFile() && !file.deleteFile()))
+        return nullptr;
+
+    std::unique_ptr<juce::AudioFormat> format;
+    if (settings.format == Format::Flac)
+    {
+#if JUCE_USE_FLAC
+        format = std::make_unique<juce::FlacAudioFormat>();
+#else
+        return nullptr;
+#endif
+    }
+    else
+    {
+        format = std::make_unique<juce::WavAudioFormat>();
+    }
+
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+        return nullptr;
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(
+        stream.get(), settings.sampleRate, static_cast<unsigned int>(numChannels), settings.bitDepth, {}, 0));
+
+    // The writer owns the stream from here
+    if (writer != nullptr)
+        stream.release();
+
+    return writer;
+}
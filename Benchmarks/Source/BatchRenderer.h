@@ -0,0 +1,132 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "OfflineRenderBenchmark.h"
+
+/**
+ * @class BatchRenderer
+ * @brief Renders MIDI files and single notes through a preset to audio files, one job per worker thread at a time.
+ *
+ * Every worker owns a headless DigitalSynthesizerAudioProcessor with the
+ * preset loaded and takes the next job from a shared list, so throughput grows
+ * with the number of cores. A job is rendered block by block straight into a
+ * streaming WAV or FLAC writer: memory stays at one block per worker plus the
+ * job's MIDI events, however long the renders are.
+ *
+ * Each job reseeds the processor from the run's seed and the job's position in
+ * the list and starts from a prepared processor, so a job renders the same
+ * audio whichever worker takes it and however many workers run. A job whose
+ * tail is cut off leaves voices sounding, so its worker starts again from a
+ * fresh processor.
+ */
+class BatchRenderer
+{
+public:
+    /**
+     * @enum Format
+     * @brief Audio file format written.
+     */
+    enum class Format
+    {
+        Wav,    ///< WAV, 16 or 24-bit integer or 32-bit float
+        Flac    ///< FLAC, 16 or 24-bit
+    };
+
+    /**
+     * @struct Settings
+     * @brief Parameters of a batch.
+     */
+    struct Settings
+    {
+        juce::File preset;                        ///< Preset to render, none for the default patch
+        juce::Array<juce::File> midiFiles;        ///< MIDI files, one job each
+        juce::Range<int> notes;                   ///< MIDI notes rendered one job each, end exclusive, may be empty
+        juce::Array<int> velocities{ 100 };       ///< Velocities of every note job
+        double noteSeconds = 2.0;                 ///< Time a note job holds its note
+        double tailSeconds = 4.0;                 ///< Longest release rendered after the last event
+        juce::File outputDirectory;               ///< Directory the files are written to
+        Format format = Format::Wav;              ///< File format
+        int bitDepth = 24;                        ///< Bits per sample
+        double sampleRate = 48000.0;              ///< Sample rate in Hz
+        int blockSize = 512;                      ///< Samples per processBlock call
+        int numThreads = 0;                       ///< Worker threads, 0 for one per core
+        uint32_t seed = 0;                        ///< Seed every job's seed is derived from
+    };
+
+    /**
+     * @struct Result
+     * @brief Outcome of one job.
+     */
+    struct Result
+    {
+        juce::String name;                        ///< Job name, also the output file name
+        bool rendered = false;                    ///< False if the job failed, see error
+        juce::String error;                       ///< Why the job failed
+        double audioSeconds = 0.0;                ///< Length of the written file
+        double renderSeconds = 0.0;               ///< Wall time the job took
+        bool truncated = false;                   ///< True if the tail still sounded at the tail limit
+    };
+
+    /**
+     * @brief Renders every job and writes the files.
+     * @param settings Parameters of the batch.
+     * @param onResult Called after each job, in completion order, from the worker threads one at a time.
+     * @return The results in job order.
+     */
+    static std::vector<Result> run(const Settings& settings, const std::function<void(const Result&)>& onResult = {});
+
+    /**
+     * @brief Returns the header line matching formatResult().
+     */
+    static juce::String formatHeader();
+
+    /**
+     * @brief Returns one result as a table row.
+     */
+    static juce::String formatResult(const Result& result);
+
+    /**
+     * @brief Returns the file extension of a format, with the dot.
+     */
+    static juce::String getFileExtension(Format format);
+
+private:
+    /**
+     * @struct Job
+     * @brief One output file: a MIDI file, or a note at a velocity.
+     */
+    struct Job
+    {
+        juce::String name;                        ///< Output file name without extension
+        juce::File midiFile;                      ///< MIDI file to play, none for a note job
+        int note = -1;                            ///< Note of a note job
+        int velocity = 0;                         ///< Velocity of a note job
+        uint32_t seed = 0;                        ///< Random seed of the job
+    };
+
+    struct Batch;
+    class Worker;
+
+    static constexpr float silenceThreshold = 1.0e-6f;   ///< Peak below which a tail block counts as silent, about -120 dBFS
+    static constexpr double silenceSeconds = 0.05;       ///< Silence that ends a tail before the limit
+
+    /**
+     * @brief Returns the MIDI file jobs followed by the note jobs, named and seeded.
+     */
+    static std::vector<Job> createJobs(const Settings& settings);
+
+    /**
+     * @brief Reads every track of a MIDI file into one list of events, sorted by position.
+     * @param file The MIDI file.
+     * @param sampleRate Sample rate the positions are counted in.
+     * @param events Receives the channel messages; meta and system exclusive events are dropped.
+     * @return False if the file could not be read.
+     */
+    static bool readMidiFile(const juce::File& file, double sampleRate, std::vector<OfflineRenderBenchmark::TimedEvent>& events);
+
+    /**
+     * @brief Creates a streaming writer for a job's output file, replacing any existing file.
+     * @return The writer, or nullptr if the file could not be opened or the format rejects the settings.
+     */
+    static std::unique_ptr<juce::AudioFormatWriter> createWriter(const Settings& settings, const juce::File& file, int numChannels);
+};
@@ -0,0 +1,107 @@
+#include "FastMathAccuracy.h"
+#include "../../Source/Modules/FastMath/FastMath.h"
+#include "../../Source/Modules/FastMath/PitchTable.h"
+
+namespace
+{
+    juce::String formatError(double error)
+    {
+        return juce::String(error, 2, true).paddedLeft(' ', 12);
+    }
+}
+
+std::vector<FastMathAccuracy::Result> FastMathAccuracy::run(const juce::String& filter,
+    const std::function<void(const Result&)>& onResult)
+{
+    std::vector<Result> results;
+
+    for (const auto& errorCase : createCases())
+    {
+        if (filter.isNotEmpty() && !errorCase.name.containsIgnoreCase(filter))
+            continue;
+
+        results.push_back(check(errorCase));
+
+        if (onResult)
+            onResult(results.back());
+    }
+
+    return results;
+}
+
+juce::String FastMathAccuracy::formatHeader()
+{
+    return juce::String("function").paddedRight(' ', 26) + juce::String("range").paddedRight(' ', 16)
+        + "  error" + "       bound" + "   max error" + "    result";
+}
+
+juce::String FastMathAccuracy::formatResult(const Result& result)
+{
+    return result.name.paddedRight(' ', 26) + result.range.paddedRight(' ', 16)
+        + juce::String(result.relative ? "  rel" : "  abs").paddedRight(' ', 7)
+        + formatError(result.bound) + formatError(result.maxError)
+        + juce::String(result.passed ? "pass" : "FAIL").paddedLeft(' ', 10)
+        + (result.passed ? juce::String() : "  at x = " + juce::String(result.worstInput, 7));
+}
+
+std::vector<FastMathAccuracy::Case> FastMathAccuracy::createCases()
+{
+    // Ranges and bounds as documented on each function in FastMath.h and on PitchTable
+    return {
+        { "tanh", "-8 to 8", -8.0, 8.0, false, false, 1.0e-4,
+          [](float x) { return FastMath::tanh(x); }, [](double x) { return std::tanh(x); } },
+        { "atan", "1e-6 to 1e6", 1.0e-6, 1.0e6, true, false, 2.0e-4,
+          [](float x) { return FastMath::atan(x); }, [](double x) { return std::atan(x); } },
+        { "sin", "-64 to 64", -64.0, 64.0, false, false, 6.0e-6,
+          [](float x) { return FastMath::sin(x); }, [](double x) { return std::sin(x); } },
+        { "cos", "-64 to 64", -64.0, 64.0, false, false, 6.0e-6,
+          [](float x) { return FastMath::cos(x); }, [](double x) { return std::cos(x); } },
+        { "tan", "0 to 1.52", 0.0, 1.52, false, true, 6.0e-6,
+          [](float x) { return FastMath::tan(x); }, [](double x) { return std::tan(x); } },
+        { "exp2", "-126 to 127", -126.0, 127.0, false, true, 2.5e-7,
+          [](float x) { return FastMath::exp2(x); }, [](double x) { return std::exp2(x); } },
+        { "log2", "2^-16 to 2^16", std::ldexp(1.0, -16), std::ldexp(1.0, 16), true, false, 2.5e-6,
+          [](float x) { return FastMath::log2(x); }, [](double x) { return std::log2(x); } },
+        { "centsToRatio", "-1200 to 1200", -1200.0, 1200.0, false, true, 2.5e-7,
+          [](float x) { return FastMath::centsToRatio(x); }, [](double x) { return std::exp2(x / 1200.0); } },
+        { "gainToDecibels", "1e-5 to 16", 1.0e-5, 16.0, true, false, 2.5e-5,
+          [](float x) { return FastMath::gainToDecibels(x); }, [](double x) { return 20.0 * std::log10(x); } },
+        { "PitchTable::centsToRatio", "-5000 to 5000", -5000.0, 5000.0, false, true, 2.0e-7,
+          [](float x) { return PitchTable::centsToRatio(x); }, [](double x) { return std::exp2(x / 1200.0); } },
+    };
+}
+
+FastMathAccuracy::Result FastMathAccuracy::check(const Case& errorCase)
+{
+    Result result;
+    result.name = errorCase.name;
+    result.range = errorCase.range;
+    result.relative = errorCase.relative;
+    result.bound = errorCase.bound;
+
+    const double logRatio = errorCase.logarithmic ? std::log(errorCase.end / errorCase.start) : 0.0;
+
+    for (int i = 0; i <= pointsPerCase; ++i)
+    {
+        const double position = static_cast<double>(i) / pointsPerCase;
+        const double x = errorCase.logarithmic ? errorCase.start * std::exp(logRatio * position)
+                                               : errorCase.start + (errorCase.end - errorCase.start) * position;
+
+        // Compare against the exact value at the input the approximation actually sees
+        const float input = static_cast<float>(x);
+        const double reference = errorCase.reference(static_cast<double>(input));
+        double error = std::abs(static_cast<double>(errorCase.approximation(input)) - reference);
+
+        if (errorCase.relative && reference != 0.0)
+            error /= std::abs(reference);
+
+        if (error > result.maxError)
+        {
+            result.maxError = error;
+            result.worstInput = input;
+        }
+    }
+
+    result.passed = result.maxError <= result.bound;
+    return result;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class FastMathAccuracy
+ * @brief Sweeps every FastMath approximation against the standard library and checks its documented error bound.
+ *
+ * Each case samples the input range its bound is stated for, rounds every
+ * input to float the way the audio thread sees it, and takes the reference
+ * in double precision from that same float. A case passes when the largest
+ * absolute or relative error found stays within the bound quoted in
+ * FastMath.h or PitchTable.h, so a change to a polynomial or table cannot
+ * silently loosen it.
+ */
+class FastMathAccuracy
+{
+public:
+    /**
+     * @struct Result
+     * @brief Outcome of one case.
+     */
+    struct Result
+    {
+        juce::String name;                 ///< Function checked
+        juce::String range;                ///< Input range swept, as text
+        bool relative = false;             ///< True if the error is relative to the reference
+        double bound = 0.0;                ///< Documented error bound
+        double maxError = 0.0;             ///< Largest error found
+        float worstInput = 0.0f;           ///< Input where the largest error occurred
+        bool passed = false;               ///< True if the largest error is within the bound
+    };
+
+    /**
+     * @brief Runs every case.
+     * @param filter Runs only cases whose name contains the text, all if empty.
+     * @param onResult Called after each case, in run order.
+     * @return The results in run order.
+     */
+    static std::vector<Result> run(const juce::String& filter, const std::function<void(const Result&)>& onResult = {});
+
+    /**
+     * @brief Returns the header line matching formatResult().
+     */
+    static juce::String formatHeader();
+
+    /**
+     * @brief Returns one result as a table row.
+     */
+    static juce::String formatResult(const Result& result);
+
+private:
+    /**
+     * @struct Case
+     * @brief One function, the range its bound holds on and how the range is sampled.
+     */
+    struct Case
+    {
+        juce::String name;                                     ///< Function name
+        juce::String range;                                    ///< Input range, as text
+        double start = 0.0;                                    ///< Lowest input
+        double end = 0.0;                                      ///< Highest input
+        bool logarithmic = false;                              ///< Samples evenly in log(x) instead of x, for positive ranges
+        bool relative = false;                                 ///< Error is relative to the reference
+        double bound = 0.0;                                    ///< Documented error bound
+        std::function<float(float)> approximation;             ///< FastMath function
+        std::function<double(double)> reference;               ///< Exact function in double precision
+    };
+
+    static constexpr int pointsPerCase = 1 << 22;              ///< Inputs sampled per case, ends included
+
+    /**
+     * @brief Returns one case per approximation, with the bounds quoted in FastMath.h and PitchTable.h.
+     */
+    static std::vector<Case> createCases();
+
+    /**
+     * @brief Sweeps a case and returns its largest error.
+     */
+    static Result check(const Case& errorCase);
+};
@@ -0,0 +1,284 @@
+#include "GoldenRender.h"
+#include "OfflineRenderBenchmark.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int fftOrder = 12;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int hopSize = fftSize / 2;
+
+    constexpr double lowestBandHz = 31.25;      // Centre of the first third-octave band, 1 kHz divided by 2^5
+
+    double getRms(const juce::AudioBuffer<float>& audio)
+    {
+        double sum = 0.0;
+        for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+        {
+            const float* data = audio.getReadPointer(ch);
+            for (int i = 0; i < audio.getNumSamples(); ++i)
+                sum += static_cast<double>(data[i]) * data[i];
+        }
+
+        const int count = audio.getNumChannels() * audio.getNumSamples();
+        return count > 0 ? std::sqrt(sum / count) : 0.0;
+    }
+
+    juce::String formatDecibels(double value)
+    {
+        return juce::String(value, 1).paddedLeft(' ', 12);
+    }
+}
+
+std::vector<GoldenRender::Result> GoldenRender::run(const Settings& settings, const std::function<void(const Result&)>& onResult)
+{
+    std::vector<Result> results;
+
+    for (const auto& renderCase : createCases(settings))
+    {
+        if (settings.filter.isNotEmpty() && !renderCase.name.containsIgnoreCase(settings.filter))
+            continue;
+
+        Result result;
+        result.name = renderCase.name;
+
+        juce::AudioBuffer<float> rendered;
+        result.rendered = render(renderCase, settings.seconds, rendered);
+
+        const auto file = settings.referenceDirectory.getChildFile(renderCase.name + ".wav");
+        juce::AudioBuffer<float> reference;
+        double referenceRate = 0.0;
+
+        if (!result.rendered)
+        {
+            // Reported as such, nothing to compare or write
+        }
+        else if (settings.update)
+        {
+            result.hasReference = writeReference(file, rendered, renderCase.sampleRate);
+            result.passed = result.hasReference;
+        }
+        else if (readReference(file, reference, referenceRate)
+                 && referenceRate == renderCase.sampleRate
+                 && reference.getNumChannels() == rendered.getNumChannels()
+                 && reference.getNumSamples() == rendered.getNumSamples())
+        {
+            result.hasReference = true;
+            result.rmsErrorDb = getRmsErrorDb(rendered, reference);
+
+            // A silent reference has no spectrum to match; the RMS check alone holds it to the floor
+            if (getRms(reference) >= silenceFloor)
+                result.bandErrorDb = getBandErrorDb(getBandLevels(rendered, renderCase.sampleRate),
+                                                    getBandLevels(reference, renderCase.sampleRate));
+
+            result.passed = result.rmsErrorDb <= settings.maxRmsErrorDb && result.bandErrorDb <= settings.maxBandErrorDb;
+        }
+
+        if (onResult)
+            onResult(result);
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+juce::String GoldenRender::formatHeader()
+{
+    return juce::String("case").paddedRight(' ', 24) + "    result" + "  rms err dB" + "  band err dB";
+}
+
+juce::String GoldenRender::formatResult(const Result& result)
+{
+    const juce::String status = !result.rendered ? "no preset"
+                              : !result.hasReference ? "NO REF"
+                              : result.passed ? "pass" : "FAIL";
+
+    auto row = result.name.paddedRight(' ', 24) + status.paddedLeft(' ', 10);
+    if (result.hasReference)
+        row += formatDecibels(result.rmsErrorDb) + formatDecibels(result.bandErrorDb).paddedLeft(' ', 13);
+
+    return row;
+}
+
+std::vector<GoldenRender::Case> GoldenRender::createCases(const Settings& settings)
+{
+    std::vector<Case> cases;
+
+    for (const auto& preset : settings.presets)
+        cases.push_back({ preset.getFileNameWithoutExtension(), preset, 48000.0, 256, true });
+
+    cases.push_back({ "Default", {}, 48000.0, 256, true });
+    cases.push_back({ "Default-44k1-OddBlocks", {}, 44100.0, 37, true });
+    cases.push_back({ "Default-Silence", {}, 48000.0, 256, false });
+    return cases;
+}
+
+bool GoldenRender::render(const Case& renderCase, double seconds, juce::AudioBuffer<float>& output)
+{
+    jassert(renderCase.sampleRate > 0.0 && renderCase.blockSize > 0);
+
+    auto processor = std::make_unique<DigitalSynthesizerAudioProcessor>();
+    processor->setMultiCoreRenderingEnabled(false);
+
+    // Quality never drops under load, so the render depends on the patch alone
+    processor->getQualityGovernor().setEnabled(false);
+
+    if (renderCase.preset != juce::File() && !OfflineRenderBenchmark::loadPreset(*processor, renderCase.preset))
+        return false;
+
+    const int numChannels = processor->getTotalNumOutputChannels();
+    processor->setPlayConfigDetails(0, numChannels, renderCase.sampleRate, renderCase.blockSize);
+    processor->prepareToPlay(renderCase.sampleRate, renderCase.blockSize);
+
+    const int numSamples = juce::jmax(1, static_cast<int>(std::ceil(seconds * renderCase.sampleRate)));
+    const auto events = renderCase.playNotes
+        ? OfflineRenderBenchmark::createSequence(renderCase.sampleRate, numSamples)
+        : std::vector<OfflineRenderBenchmark::TimedEvent>{};
+
+    output.setSize(numChannels, numSamples);
+
+    juce::AudioBuffer<float> buffer(numChannels, renderCase.blockSize);
+    juce::MidiBuffer midi;
+    size_t nextEvent = 0;
+
+    for (int blockStart = 0; blockStart < numSamples; blockStart += renderCase.blockSize)
+    {
+        // The last block is cut short, as a host ends a bounce
+        const int length = juce::jmin(renderCase.blockSize, numSamples - blockStart);
+        buffer.setSize(numChannels, length, false, false, true);
+
+        midi.clear();
+        for (; nextEvent < events.size() && events[nextEvent].samplePosition < blockStart + length; ++nextEvent)
+            midi.addEvent(events[nextEvent].message, static_cast<int>(events[nextEvent].samplePosition - blockStart));
+
+        buffer.clear();
+        processor->processBlock(buffer, midi);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            output.copyFrom(ch, blockStart, buffer, ch, 0, length);
+    }
+
+    processor->releaseResources();
+    return true;
+}
+
+bool GoldenRender::writeReference(const juce::File& file, const juce::AudioBuffer<float>& audio, double sampleRate)
+{
+    if (!file.getParentDirectory().createDirectory() || (file.existsAsFile() && !file.deleteFile()))
+        return false;
+
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+        return false;
+
+    // 32 bits stores the floats unchanged, so a reference never carries quantization noise
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(
+        stream.get(), sampleRate, static_cast<unsigned int>(audio.getNumChannels()), 32, {}, 0));
+
+    if (writer == nullptr)
+        return false;
+
+    stream.release();
+    return writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+}
+
+bool GoldenRender::readReference(const juce::File& file, juce::AudioBuffer<float>& audio, double& sampleRate)
+{
+    if (!file.existsAsFile())
+        return false;
+
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatReader> reader(format.createReaderFor(file.createInputStream().release(), true));
+    if (reader == nullptr || reader->lengthInSamples > std::numeric_limits<int>::max())
+        return false;
+
+    const int numSamples = static_cast<int>(reader->lengthInSamples);
+    audio.setSize(static_cast<int>(reader->numChannels), numSamples);
+    sampleRate = reader->sampleRate;
+    return reader->read(&audio, 0, numSamples, 0, true, true);
+}
+
+double GoldenRender::getRmsErrorDb(const juce::AudioBuffer<float>& rendered, const juce::AudioBuffer<float>& reference)
+{
+    jassert(rendered.getNumChannels() == reference.getNumChannels() && rendered.getNumSamples() == reference.getNumSamples());
+
+    juce::AudioBuffer<float> difference(rendered);
+    for (int ch = 0; ch < difference.getNumChannels(); ++ch)
+        difference.addFrom(ch, 0, reference, ch, 0, reference.getNumSamples(), -1.0f);
+
+    return juce::Decibels::gainToDecibels(getRms(difference) / juce::jmax(silenceFloor, getRms(reference)), -300.0);
+}
+
+std::vector<double> GoldenRender::getBandLevels(const juce::AudioBuffer<float>& audio, double sampleRate)
+{
+    juce::dsp::FFT fft(fftOrder);
+    std::vector<float> window(static_cast<size_t>(fftSize));
+    for (int i = 0; i < fftSize; ++i)
+        window[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * static_cast<float>(i) / fftSize);
+
+    // Magnitudes come back in place, in the first half of a buffer twice the frame length
+    std::vector<float> frame(static_cast<size_t>(2 * fftSize));
+    std::vector<double> power(static_cast<size_t>(fftSize / 2 + 1), 0.0);
+
+    const int numSamples = audio.getNumSamples();
+    const int numFrames = juce::jmax(1, 1 + (numSamples - fftSize) / hopSize);
+
+    for (int f = 0; f < numFrames; ++f)
+    {
+        const int start = f * hopSize;
+        std::fill(frame.begin(), frame.end(), 0.0f);
+
+        for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+        {
+            const float* data = audio.getReadPointer(ch);
+            for (int i = 0; i < fftSize && start + i < numSamples; ++i)
+                frame[static_cast<size_t>(i)] += data[start + i] * window[static_cast<size_t>(i)];
+        }
+
+        fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+
+        for (size_t bin = 0; bin < power.size(); ++bin)
+            power[bin] += static_cast<double>(frame[bin]) * frame[bin] / numFrames;
+    }
+
+    const double binHz = sampleRate / fftSize;
+    const double halfBand = std::pow(2.0, 1.0 / 6.0);
+
+    std::vector<double> levels;
+    for (int band = 0; ; ++band)
+    {
+        const double centre = lowestBandHz * std::pow(2.0, band / 3.0);
+        if (centre * halfBand > sampleRate * 0.5)
+            break;
+
+        const auto firstBin = static_cast<size_t>(std::ceil(centre / halfBand / binHz));
+        const auto endBin = juce::jmin(power.size(), static_cast<size_t>(std::ceil(centre * halfBand / binHz)));
+
+        double sum = 0.0;
+        for (size_t bin = firstBin; bin < endBin; ++bin)
+            sum += power[bin];
+
+        levels.push_back(10.0 * std::log10(sum + 1.0e-30));
+    }
+
+    return levels;
+}
+
+double GoldenRender::getBandErrorDb(const std::vector<double>& rendered, const std::vector<double>& reference)
+{
+    jassert(rendered.size() == reference.size());
+
+    if (reference.empty())
+        return 0.0;
+
+    const double loudest = *std::max_element(reference.begin(), reference.end());
+
+    double error = 0.0;
+    for (size_t band = 0; band < reference.size(); ++band)
+        if (reference[band] >= loudest - bandRangeDb)
+            error = juce::jmax(error, std::abs(rendered[band] - reference[band]));
+
+    return error;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class GoldenRender
+ * @brief Renders fixed cases through the processor and compares them with stored reference renders.
+ *
+ * Every shipped preset plays the benchmark's scripted sequence, and a few
+ * cases on the default patch cover what the presets do not: another sample
+ * rate with an odd block size, so events land inside blocks at uneven
+ * offsets, and a render with no notes at all, which must stay silent. The
+ * noise and step LFO generators start from fixed seeds, so a render only
+ * changes when the sound does.
+ *
+ * A render passes when the RMS of its difference to the reference, relative
+ * to the reference level, and the largest deviation of its averaged
+ * third-octave spectrum both stay within the tolerances. References are
+ * 32-bit float WAV files, written by an update run after an intended change.
+ */
+class GoldenRender
+{
+public:
+    /**
+     * @struct Settings
+     * @brief Parameters of a check or update run.
+     */
+    struct Settings
+    {
+        juce::Array<juce::File> presets;   ///< Preset files rendered on top of the default patch cases
+        juce::File referenceDirectory;     ///< Directory holding one WAV file per case
+        double seconds = 6.0;              ///< Length of every render
+        bool update = false;               ///< Writes the renders as the new references instead of comparing
+        double maxRmsErrorDb = -60.0;      ///< Largest difference RMS, in dB relative to the reference
+        double maxBandErrorDb = 0.5;       ///< Largest third-octave band deviation in dB
+        juce::String filter;               ///< Runs only cases whose name contains the text, all if empty
+    };
+
+    /**
+     * @struct Result
+     * @brief Outcome of one case.
+     */
+    struct Result
+    {
+        juce::String name;                 ///< Case name, also the reference file name
+        bool rendered = false;             ///< False if the preset could not be loaded
+        bool hasReference = false;         ///< False if no usable reference was found
+        bool passed = false;               ///< True if within tolerance, or written in an update run
+        double rmsErrorDb = 0.0;           ///< Difference RMS in dB relative to the reference
+        double bandErrorDb = 0.0;          ///< Largest third-octave band deviation in dB
+    };
+
+    /**
+     * @brief Renders every case and checks it, or writes it as the new reference.
+     * @param settings Parameters of the run.
+     * @param onResult Called after each case, in run order.
+     * @return The results in run order.
+     */
+    static std::vector<Result> run(const Settings& settings, const std::function<void(const Result&)>& onResult = {});
+
+    /**
+     * @brief Returns the header line matching formatResult().
+     */
+    static juce::String formatHeader();
+
+    /**
+     * @brief Returns one result as a table row.
+     */
+    static juce::String formatResult(const Result& result);
+
+private:
+    /**
+     * @struct Case
+     * @brief One render: a patch, a stream format and whether notes play.
+     */
+    struct Case
+    {
+        juce::String name;                 ///< Case name
+        juce::File preset;                 ///< Preset to load, none for the default patch
+        double sampleRate = 48000.0;       ///< Sample rate in Hz
+        int blockSize = 256;               ///< Samples per processBlock call
+        bool playNotes = true;             ///< Plays the scripted sequence, or nothing
+    };
+
+    static constexpr double silenceFloor = 1.0e-5;   ///< Reference RMS below which errors are taken against -100 dBFS
+    static constexpr double bandRangeDb = 60.0;      ///< Bands further below the loudest reference band are not compared
+
+    /**
+     * @brief Returns the presets' cases followed by the default patch cases.
+     */
+    static std::vector<Case> createCases(const Settings& settings);
+
+    /**
+     * @brief Renders a case from a fresh processor.
+     * @param renderCase The case.
+     * @param seconds Length of the render.
+     * @param output Receives the render.
+     * @return False if the preset could not be loaded.
+     */
+    static bool render(const Case& renderCase, double seconds, juce::AudioBuffer<float>& output);
+
+    /**
+     * @brief Writes a render as a 32-bit float WAV file, replacing any existing one.
+     */
+    static bool writeReference(const juce::File& file, const juce::AudioBuffer<float>& audio, double sampleRate);
+
+    /**
+     * @brief Reads a reference, returns false if it is missing or unreadable.
+     */
+    static bool readReference(const juce::File& file, juce::AudioBuffer<float>& audio, double& sampleRate);
+
+    /**
+     * @brief Returns the RMS of the difference in dB relative to the reference RMS.
+     */
+    static double getRmsErrorDb(const juce::AudioBuffer<float>& rendered, const juce::AudioBuffer<float>& reference);
+
+    /**
+     * @brief Returns the third-octave band powers in dB of the channel sum, averaged over Hann-windowed frames.
+     */
+    static std::vector<double> getBandLevels(const juce::AudioBuffer<float>& audio, double sampleRate);
+
+    /**
+     * @brief Returns the largest band deviation in dB among the bands within range of the loudest reference band.
+     */
+    static double getBandErrorDb(const std::vector<double>& rendered, const std::vector<double>& reference);
+};
@@ -0,0 +1,377 @@
+#include <JuceHeader.h>
+#include "BatchRenderer.h"
+#include "FastMathAccuracy.h"
+#include "GoldenRender.h"
+#include "ModuleBenchmarks.h"
+#include "OfflineRenderBenchmark.h"
+#include <iostream>
+
+namespace
+{
+    const juce::String usage{
+        "Usage: DigitalSynthesizerBenchmarks [options]\n"
+        "       DigitalSynthesizerBenchmarks --modules [options]\n"
+        "       DigitalSynthesizerBenchmarks --golden [options]\n"
+        "       DigitalSynthesizerBenchmarks --batch [options]\n"
+        "       DigitalSynthesizerBenchmarks --accuracy [options]\n"
+        "\n"
+        "Renders a preset offline through the processor and reports per-block timings.\n"
+        "\n"
+        "  --preset=<file>      Preset to render (default: Presets/Freaks.xml)\n"
+        "  --rates=<list>       Comma-separated sample rates (default: 44100,48000,96000)\n"
+        "  --blocks=<list>      Comma-separated block sizes (default: 64,128,256,512,1024)\n"
+        "  --seconds=<value>    Measured length of each render (default: 20)\n"
+        "  --warmup=<value>     Unmeasured lead-in of each render (default: 1)\n"
+        "  --multicore          Render oscillators on worker threads\n"
+        "  --help               Show this text\n"
+        "\n"
+        "With --modules, times each DSP module on its own instead:\n"
+        "\n"
+        "  --rate=<value>       Sample rate (default: 48000)\n"
+        "  --block=<value>      Block size (default: 256)\n"
+        "  --time=<value>       Seconds measured per case (default: 0.5)\n"
+        "  --filter=<text>      Run only cases whose name contains the text\n"
+        "  --json=<file>        Also write the results as JSON\n"
+        "\n"
+        "With --golden, renders the presets and default patch cases and compares them\n"
+        "with the reference renders, exiting with 1 if any differs:\n"
+        "\n"
+        "  --presets=<list>     Comma-separated presets (default: Presets/Mario.xml,Presets/Bounce.xml,Presets/Freaks.xml)\n"
+        "  --references=<dir>   Reference WAV directory (default: Benchmarks/Golden)\n"
+        "  --seconds=<value>    Length of each render (default: 6)\n"
+        "  --max-rms=<dB>       Largest difference RMS relative to the reference (default: -60)\n"
+        "  --max-band=<dB>      Largest third-octave band deviation (default: 0.5)\n"
+        "  --filter=<text>      Run only cases whose name contains the text\n"
+        "  --update             Write the renders as the new references instead\n"
+        "\n"
+        "With --batch, renders MIDI files and single notes through a preset to audio\n"
+        "files, one job per worker thread at a time:\n"
+        "\n"
+        "  --preset=<file>      Preset to render (default: the default patch)\n"
+        "  --midi=<list>        Comma-separated MIDI files, one output file each\n"
+        "  --notes=<lo-hi>      MIDI note range rendered one note per file, inclusive\n"
+        "  --velocities=<list>  Comma-separated velocities of every note (default: 100)\n"
+        "  --length=<value>     Seconds each note is held (default: 2)\n"
+        "  --tail=<value>       Longest release after the last event in seconds (default: 4)\n"
+        "  --out=<dir>          Output directory (default: Renders)\n"
+        "  --format=<wav|flac>  Output format (default: wav)\n"
+        "  --bits=<value>       Bits per sample: 16, 24, or 32 for float WAV (default: 24)\n"
+        "  --rate=<value>       Sample rate (default: 48000)\n"
+        "  --block=<value>      Block size (default: 512)\n"
+        "  --threads=<value>    Worker threads (default: one per core)\n"
+        "  --seed=<value>       Seed the jobs' random seeds are derived from (default: 0)\n"
+        "\n"
+        "With --accuracy, sweeps the FastMath approximations and the PitchTable ratio lookup\n"
+        "against the standard library and exits with 1 if any exceeds its documented error bound:\n"
+        "\n"
+        "  --filter=<text>      Run only functions whose name contains the text\n" };
+
+    juce::Array<double> parseList(const juce::String& text)
+    {
+        juce::StringArray tokens;
+        tokens.addTokens(text, ",", {});
+        tokens.trim();
+        tokens.removeEmptyStrings();
+
+        juce::Array<double> values;
+        for (const auto& token : tokens)
+            values.add(token.getDoubleValue());
+
+        return values;
+    }
+
+    juce::String getOption(const juce::ArgumentList& args, const juce::String& option, const juce::String& fallback)
+    {
+        return args.containsOption(option) ? args.getValueForOption(option) : fallback;
+    }
+
+    int runModuleBenchmarks(const juce::ArgumentList& args)
+    {
+        ModuleBenchmarks::Settings settings;
+        settings.sampleRate = getOption(args, "--rate", "48000").getDoubleValue();
+        settings.blockSize = getOption(args, "--block", "256").getIntValue();
+        settings.secondsPerCase = getOption(args, "--time", "0.5").getDoubleValue();
+        settings.filter = getOption(args, "--filter", {});
+
+        if (settings.sampleRate <= 0.0 || settings.blockSize < 1 || settings.secondsPerCase <= 0.0)
+        {
+            std::cout << usage;
+            return 1;
+        }
+
+        std::cout << "Sample rate " << settings.sampleRate << " Hz, block size " << settings.blockSize
+            << std::endl << std::endl;
+        std::cout << ModuleBenchmarks::formatHeader() << std::endl;
+
+        const auto results = ModuleBenchmarks::run(settings, [](const ModuleBenchmarks::Result& result)
+            {
+                std::cout << ModuleBenchmarks::formatResult(result) << std::endl;
+            });
+
+        if (args.containsOption("--json"))
+        {
+            const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--json"));
+            if (!file.replaceWithText(ModuleBenchmarks::toJson(settings, results)))
+            {
+                std::cout << "Could not write " << file.getFullPathName() << std::endl;
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    int runGoldenRenders(const juce::ArgumentList& args)
+    {
+        const auto workingDirectory = juce::File::getCurrentWorkingDirectory();
+
+        GoldenRender::Settings settings;
+        settings.referenceDirectory = workingDirectory.getChildFile(getOption(args, "--references", "Benchmarks/Golden"));
+        settings.seconds = getOption(args, "--seconds", "6").getDoubleValue();
+        settings.maxRmsErrorDb = getOption(args, "--max-rms", "-60").getDoubleValue();
+        settings.maxBandErrorDb = getOption(args, "--max-band", "0.5").getDoubleValue();
+        settings.filter = getOption(args, "--filter", {});
+        settings.update = args.containsOption("--update");
+
+        juce::StringArray presets;
+        presets.addTokens(getOption(args, "--presets", "Presets/Mario.xml,Presets/Bounce.xml,Presets/Freaks.xml"), ",", {});
+        presets.trim();
+        presets.removeEmptyStrings();
+
+        for (const auto& preset : presets)
+            settings.presets.add(workingDirectory.getChildFile(preset));
+
+        if (settings.seconds <= 0.0 || settings.maxBandErrorDb < 0.0)
+        {
+            std::cout << usage;
+            return 1;
+        }
+
+        // No references ship with the repository; checking against none would only list every case as failed
+        if (!settings.update && settings.referenceDirectory.findChildFiles(juce::File::findFiles, false, "*.wav").isEmpty())
+        {
+            std::cout << "Error: no golden references in " << settings.referenceDirectory.getFullPathName() << std::endl
+                << "Render them once with --golden --update on a build whose sound is known to be right,"
+                   " then keep the files for later checks" << std::endl;
+            return 1;
+        }
+
+        std::cout << (settings.update ? "Writing" : "Checking") << " references in "
+            << settings.referenceDirectory.getFullPathName() << std::endl << std::endl;
+        std::cout << GoldenRender::formatHeader() << std::endl;
+
+        const auto results = GoldenRender::run(settings, [](const GoldenRender::Result& result)
+            {
+                std::cout << GoldenRender::formatResult(result) << std::endl;
+            });
+
+        const auto failed = std::count_if(results.begin(), results.end(), [](const GoldenRender::Result& result)
+            {
+                return !result.passed;
+            });
+
+        if (failed > 0)
+        {
+            std::cout << std::endl << failed << " of " << results.size() << " cases "
+                << (settings.update ? "could not be written" : "failed") << std::endl;
+
+            const auto missing = std::count_if(results.begin(), results.end(), [](const GoldenRender::Result& result)
+                {
+                    return result.rendered && !result.hasReference;
+                });
+
+            if (!settings.update && missing > 0)
+                std::cout << "Error: " << missing << " of them have no reference; write them with --golden --update"
+                    " --filter=<case> once their sound is known to be right" << std::endl;
+
+            return 1;
+        }
+
+        return 0;
+    }
+
+    int runBatchRender(const juce::ArgumentList& args)
+    {
+        const auto workingDirectory = juce::File::getCurrentWorkingDirectory();
+
+        BatchRenderer::Settings settings;
+        if (args.containsOption("--preset"))
+            settings.preset = workingDirectory.getChildFile(args.getValueForOption("--preset"));
+
+        juce::StringArray midiFiles;
+        midiFiles.addTokens(getOption(args, "--midi", {}), ",", {});
+        midiFiles.trim();
+        midiFiles.removeEmptyStrings();
+
+        for (const auto& midiFile : midiFiles)
+            settings.midiFiles.add(workingDirectory.getChildFile(midiFile));
+
+        if (args.containsOption("--notes"))
+        {
+            const auto range = args.getValueForOption("--notes");
+            const int low = range.upToFirstOccurrenceOf("-", false, false).getIntValue();
+            const int high = range.contains("-") ? range.fromFirstOccurrenceOf("-", false, false).getIntValue() : low;
+            settings.notes = { low, high + 1 };
+        }
+
+        settings.velocities.clear();
+        for (const double velocity : parseList(getOption(args, "--velocities", "100")))
+            settings.velocities.add(static_cast<int>(velocity));
+
+        settings.noteSeconds = getOption(args, "--length", "2").getDoubleValue();
+        settings.tailSeconds = getOption(args, "--tail", "4").getDoubleValue();
+        settings.outputDirectory = workingDirectory.getChildFile(getOption(args, "--out", "Renders"));
+        settings.bitDepth = getOption(args, "--bits", "24").getIntValue();
+        settings.sampleRate = getOption(args, "--rate", "48000").getDoubleValue();
+        settings.blockSize = getOption(args, "--block", "512").getIntValue();
+        settings.numThreads = getOption(args, "--threads", "0").getIntValue();
+        settings.seed = static_cast<uint32_t>(getOption(args, "--seed", "0").getLargeIntValue());
+
+        const auto format = getOption(args, "--format", "wav").toLowerCase();
+        settings.format = format == "flac" ? BatchRenderer::Format::Flac : BatchRenderer::Format::Wav;
+
+        if (settings.preset != juce::File() && !settings.preset.existsAsFile())
+        {
+            std::cout << "Preset not found: " << settings.preset.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        if ((format != "wav" && format != "flac")
+            || (settings.midiFiles.isEmpty() && settings.notes.isEmpty())
+            || settings.notes.getStart() < 0 || settings.notes.getEnd() > 128
+            || settings.velocities.isEmpty()
+            || std::any_of(settings.velocities.begin(), settings.velocities.end(), [](int velocity) { return velocity < 1 || velocity > 127; })
+            || settings.noteSeconds <= 0.0 || settings.tailSeconds < 0.0
+            || settings.sampleRate <= 0.0 || settings.blockSize < 1 || settings.numThreads < 0)
+        {
+            std::cout << usage;
+            return 1;
+        }
+
+        std::cout << "Rendering to " << settings.outputDirectory.getFullPathName() << std::endl << std::endl;
+        std::cout << BatchRenderer::formatHeader() << std::endl;
+
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+        const auto results = BatchRenderer::run(settings, [](const BatchRenderer::Result& result)
+            {
+                std::cout << BatchRenderer::formatResult(result) << std::endl;
+            });
+
+        const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+        double audioSeconds = 0.0;
+        int failed = 0;
+        for (const auto& result : results)
+        {
+            audioSeconds += result.audioSeconds;
+            failed += result.rendered ? 0 : 1;
+        }
+
+        std::cout << std::endl << results.size() << " files, " << juce::String(audioSeconds, 1) << " s of audio in "
+            << juce::String(wallSeconds, 1) << " s, " << juce::String(wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0, 1)
+            << "x realtime" << std::endl;
+
+        if (failed > 0)
+        {
+            std::cout << failed << " of " << results.size() << " jobs failed" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    int runAccuracyChecks(const juce::ArgumentList& args)
+    {
+        std::cout << FastMathAccuracy::formatHeader() << std::endl;
+
+        const auto results = FastMathAccuracy::run(getOption(args, "--filter", {}), [](const FastMathAccuracy::Result& result)
+            {
+                std::cout << FastMathAccuracy::formatResult(result) << std::endl;
+            });
+
+        const auto failed = std::count_if(results.begin(), results.end(), [](const FastMathAccuracy::Result& result)
+            {
+                return !result.passed;
+            });
+
+        if (failed > 0)
+        {
+            std::cout << std::endl << failed << " of " << results.size() << " functions exceed their bound" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // The processor's timers and async updaters need a message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList args(argc, argv);
+    if (args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    if (args.containsOption("--modules"))
+        return runModuleBenchmarks(args);
+
+    if (args.containsOption("--golden"))
+        return runGoldenRenders(args);
+
+    if (args.containsOption("--batch"))
+        return runBatchRender(args);
+
+    if (args.containsOption("--accuracy"))
+        return runAccuracyChecks(args);
+
+    OfflineRenderBenchmark::Settings settings;
+    settings.preset = juce::File::getCurrentWorkingDirectory()
+        .getChildFile(getOption(args, "--preset", "Presets/Freaks.xml"));
+    settings.seconds = getOption(args, "--seconds", "20").getDoubleValue();
+    settings.warmUpSeconds = getOption(args, "--warmup", "1").getDoubleValue();
+    settings.multiCore = args.containsOption("--multicore");
+
+    const auto rates = parseList(getOption(args, "--rates", "44100,48000,96000"));
+    const auto blocks = parseList(getOption(args, "--blocks", "64,128,256,512,1024"));
+
+    if (!settings.preset.existsAsFile())
+    {
+        std::cout << "Preset not found: " << settings.preset.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    if (rates.isEmpty() || blocks.isEmpty() || settings.seconds <= 0.0 || settings.warmUpSeconds < 0.0
+        || std::any_of(rates.begin(), rates.end(), [](double rate) { return rate <= 0.0; })
+        || std::any_of(blocks.begin(), blocks.end(), [](double size) { return size < 1.0; }))
+    {
+        std::cout << usage;
+        return 1;
+    }
+
+    std::cout << "Preset " << settings.preset.getFileName() << ", " << settings.seconds << " s per run"
+        << (settings.multiCore ? ", multi-core" : "") << std::endl << std::endl;
+    std::cout << OfflineRenderBenchmark::formatHeader() << std::endl;
+
+    for (const double rate : rates)
+    {
+        for (const double size : blocks)
+        {
+            settings.sampleRate = rate;
+            settings.blockSize = static_cast<int>(size);
+
+            OfflineRenderBenchmark::Result result;
+            if (!OfflineRenderBenchmark::run(settings, result))
+            {
+                std::cout << "Could not load preset " << settings.preset.getFullPathName() << std::endl;
+                return 1;
+            }
+
+            std::cout << OfflineRenderBenchmark::formatResult(result) << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,510 @@
+#include "ModuleBenchmarks.h"
+#include "Statistics.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int numChannels = 2;
+    constexpr int heldNotes[] = { 48, 55, 60, 64 };
+    constexpr int unisonVoiceCounts[] = { 1, 4, 8, 16 };
+    constexpr int envelopePolyphony[] = { 1, 4, 8, 16 };
+
+    const juce::StringArray waveformNames{ "Sine", "Square", "Triangle", "Sawtooth", "WhiteNoise" };
+    const juce::StringArray filterTypeNames{ "LowPass", "HighPass", "BandPass", "Talkbox" };
+    const juce::StringArray slopeNames{ "12dB", "24dB" };
+    const juce::StringArray vowelNames{ "A", "E", "I", "O", "U" };
+    const juce::StringArray lfoTypeNames{ "Sine", "Triangle", "Square", "Steps" };
+    const juce::StringArray crossModNames{ "Off", "FM", "Ring", "Sync" };
+
+    void setParameter(juce::AudioProcessorValueTreeState& apvts, const juce::String& id, float value)
+    {
+        auto* parameter = apvts.getParameter(id);
+        jassert(parameter != nullptr);
+
+        if (parameter != nullptr)
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    juce::String formatNanoseconds(double value)
+    {
+        return juce::String(value, 0).paddedLeft(' ', 12);
+    }
+}
+
+std::vector<ModuleBenchmarks::Result> ModuleBenchmarks::run(const Settings& settings, const std::function<void(const Result&)>& onResult)
+{
+    jassert(settings.sampleRate > 0.0 && settings.blockSize > 0);
+
+    const int blockSize = settings.blockSize;
+    const auto sampleRate = settings.sampleRate;
+
+    // Owns the modules and their parameters, processBlock is never called
+    auto processor = std::make_unique<DigitalSynthesizerAudioProcessor>();
+    processor->setPlayConfigDetails(0, numChannels, sampleRate, blockSize);
+    processor->prepareToPlay(sampleRate, blockSize);
+    auto& apvts = processor->getAPVTS();
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::AudioBuffer<float> noise(numChannels, blockSize);
+    std::vector<float> envelopeOutput(static_cast<size_t>(blockSize));
+
+    juce::Random random(0x5eed);
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        for (int i = 0; i < blockSize; ++i)
+            noise.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    const auto copyNoise = [&buffer, &noise]
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                buffer.copyFrom(channel, 0, noise, channel, 0, noise.getNumSamples());
+        };
+
+    std::vector<Case> cases;
+
+    // Oscillator: raw output of held notes, a sustaining envelope and no filter linked
+    auto& oscillator = *processor->getOscillator(0);
+    auto& noteEnvelope = *processor->getEnvelope(0);
+
+    const auto holdNotes = [&noteEnvelope](Oscillator& target)
+        {
+            noteEnvelope.resetAllVoices();
+            noteEnvelope.setParameters(0.001f, 0.1f, 1.0f, 0.05f);
+
+            target.setEnvelope(&noteEnvelope);
+            target.setFilters(nullptr, 0);
+            target.removeReleasedNotesIf([](int) { return true; });
+
+            for (const int note : heldNotes)
+            {
+                noteEnvelope.noteOn(note, 0);
+                target.noteOn(note, 0.8f);
+            }
+        };
+
+    const auto renderHeld = [&noteEnvelope, &buffer, blockSize](Oscillator& target)
+        {
+            noteEnvelope.beginBlock(blockSize);
+            target.processBlock(buffer, 0, blockSize);
+            noteEnvelope.endBlock();
+        };
+
+    for (int waveform = 0; waveform < waveformNames.size(); ++waveform)
+    {
+        for (const int voices : unisonVoiceCounts)
+        {
+            cases.push_back({
+                "Oscillator/" + waveformNames[waveform] + "/voices:" + juce::String(voices),
+                [&, waveform, voices]
+                {
+                    using ParamID = Oscillator::ParamID;
+                    const auto detune = Oscillator::getKnobParamSpecs(ParamID::Detune, 0);
+
+                    setParameter(apvts, Oscillator::getComboBoxParamSpecs(ParamID::Waveform, 0).paramID, static_cast<float>(waveform));
+                    setParameter(apvts, Oscillator::getKnobParamSpecs(ParamID::Voices, 0).id, static_cast<float>(voices));
+                    setParameter(apvts, detune.id, detune.minValue + (detune.maxValue - detune.minValue) * 0.25f);
+                    setParameter(apvts, Oscillator::getToggleParamSpecs(ParamID::Bypass, 0).first, 0.0f);
+
+                    oscillator.updateFromParameters();
+                    holdNotes(oscillator);
+                },
+                [&buffer] { buffer.clear(); },
+                [&] { renderHeld(oscillator); }
+            });
+        }
+    }
+
+#if NUM_OF_OSCILLATORS > 1
+    // Cross-modulation: the second oscillator's sawtooth stack, modulated by the first oscillator's sine
+    auto& carrier = *processor->getOscillator(1);
+
+    for (int mode = 0; mode < crossModNames.size(); ++mode)
+    {
+        cases.push_back({
+            "Oscillator/CrossMod/" + crossModNames[mode] + "/voices:8",
+            [&, mode]
+            {
+                using ParamID = Oscillator::ParamID;
+                const auto detune = Oscillator::getKnobParamSpecs(ParamID::Detune, 1);
+
+                setParameter(apvts, Oscillator::getComboBoxParamSpecs(ParamID::Waveform, 0).paramID, 0.0f);
+                setParameter(apvts, Oscillator::getToggleParamSpecs(ParamID::Bypass, 0).first, 0.0f);
+                setParameter(apvts, Oscillator::getComboBoxParamSpecs(ParamID::Waveform, 1).paramID, 3.0f);
+                setParameter(apvts, Oscillator::getKnobParamSpecs(ParamID::Voices, 1).id, 8.0f);
+                setParameter(apvts, detune.id, detune.minValue + (detune.maxValue - detune.minValue) * 0.25f);
+                setParameter(apvts, Oscillator::getToggleParamSpecs(ParamID::Bypass, 1).first, 0.0f);
+                setParameter(apvts, Oscillator::getComboBoxParamSpecs(ParamID::CrossMod, 1).paramID, static_cast<float>(mode));
+                setParameter(apvts, Oscillator::getKnobParamSpecs(ParamID::CrossAmount, 1).id, 0.5f);
+
+                // The modulator resolves first, as in the processor
+                oscillator.updateFromParameters();
+                carrier.updateFromParameters();
+                holdNotes(carrier);
+            },
+            [&buffer] { buffer.clear(); },
+            [&] { renderHeld(carrier); }
+        });
+    }
+#endif
+
+    // Note render cache: the same chord struck every block, rendered live and replayed from the cache
+    for (const bool cached : { false, true })
+    {
+        cases.push_back({
+            juce::String("Oscillator/NoteCache/") + (cached ? "Replay" : "Live") + "/voices:8",
+            [&, cached]
+            {
+                using ParamID = Oscillator::ParamID;
+                const auto detune = Oscillator::getKnobParamSpecs(ParamID::Detune, 0);
+
+                setParameter(apvts, Oscillator::getComboBoxParamSpecs(ParamID::Waveform, 0).paramID, 3.0f);
+                setParameter(apvts, Oscillator::getKnobParamSpecs(ParamID::Voices, 0).id, 8.0f);
+                setParameter(apvts, detune.id, detune.minValue + (detune.maxValue - detune.minValue) * 0.25f);
+                setParameter(apvts, Oscillator::getToggleParamSpecs(ParamID::Bypass, 0).first, 0.0f);
+
+                oscillator.setRenderCacheEnabled(cached);
+                oscillator.updateFromParameters();
+                holdNotes(oscillator);
+            },
+            [&]
+            {
+                buffer.clear();
+                noteEnvelope.resetAllVoices();
+                oscillator.removeReleasedNotesIf([](int) { return true; });
+
+                // A pad's key goes up at once, so no hit takes over the phases of the one before
+                for (const int note : heldNotes)
+                {
+                    noteEnvelope.noteOn(note, 0);
+                    oscillator.noteOn(note, 0.8f);
+                    oscillator.noteOff(note);
+                }
+            },
+            [&] { renderHeld(oscillator); }
+        });
+    }
+
+    // Filter: one shared instance over white noise
+    auto& filter = *processor->getFilter(0);
+
+    for (int type = 0; type < filterTypeNames.size(); ++type)
+    {
+        // The talkbox bank does not use the slope
+        const int numSlopes = type == static_cast<int>(Filter::Type::Talkbox) ? 1 : slopeNames.size();
+
+        for (int slope = 0; slope < numSlopes; ++slope)
+        {
+            for (const bool driven : { false, true })
+            {
+                auto name = "Filter/" + filterTypeNames[type];
+                if (numSlopes > 1)
+                    name << "/" << slopeNames[slope];
+                name << (driven ? "/drive+mix" : "/clean");
+
+                cases.push_back({
+                    name,
+                    [&, type, slope, driven]
+                    {
+                        using ParamID = Filter::ParamID;
+                        const auto cutoff = Filter::getKnobParamSpecs(ParamID::Cutoff, 0);
+                        const auto resonance = Filter::getKnobParamSpecs(ParamID::Resonance, 0);
+                        const auto drive = Filter::getKnobParamSpecs(ParamID::Drive, 0);
+
+                        setParameter(apvts, Filter::getComboBoxParamSpecs(ParamID::Type, 0).paramID, static_cast<float>(type));
+                        setParameter(apvts, Filter::getComboBoxParamSpecs(ParamID::Slope, 0).paramID, static_cast<float>(slope));
+                        setParameter(apvts, Filter::getComboBoxParamSpecs(ParamID::Oversampling, 0).paramID, 0.0f);
+                        setParameter(apvts, cutoff.id, cutoff.defaultValue);
+                        setParameter(apvts, resonance.id, resonance.minValue + (resonance.maxValue - resonance.minValue) * 0.5f);
+                        setParameter(apvts, drive.id, driven ? drive.maxValue * 0.5f : drive.minValue);
+                        setParameter(apvts, Filter::getKnobParamSpecs(ParamID::Mix, 0).id, driven ? 0.5f : 1.0f);
+                        setParameter(apvts, Filter::getToggleParamSpecs(ParamID::Bypass, 0).first, 0.0f);
+                        setParameter(apvts, Filter::getToggleParamSpecs(ParamID::Poly, 0).first, 0.0f);
+
+                        filter.updateFromParameters();
+                        filter.updateParametersIfNeeded();
+                        filter.reset();
+                    },
+                    copyNoise,
+                    [&filter, &buffer]
+                    {
+                        juce::dsp::AudioBlock<float> block(buffer);
+                        filter.process(juce::dsp::ProcessContextReplacing<float>(block));
+                    }
+                });
+            }
+        }
+    }
+
+    // Talkbox on its own, without the surrounding filter chain
+    TalkboxFilter talkbox;
+    talkbox.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+    int talkboxBlock = 0;
+
+    for (int vowel = 0; vowel < vowelNames.size(); ++vowel)
+    {
+        for (const bool sweep : { false, true })
+        {
+            cases.push_back({
+                "TalkboxFilter/" + vowelNames[vowel] + (sweep ? "/morph-sweep" : "/static"),
+                [&, vowel]
+                {
+                    talkbox.setVowel(static_cast<TalkboxFilter::Vowel>(vowel));
+                    talkbox.setQFactor(FormattingUtils::resonanceMax / 2); // The factor knob's default
+                    talkbox.setMorph(0.0f);
+                    talkbox.updateFiltersIfNeeded();
+                    talkbox.reset();
+                    talkboxBlock = 0;
+                },
+                [&, sweep]
+                {
+                    copyNoise();
+
+                    // One sweep per second, as an LFO on the morph would
+                    if (sweep)
+                    {
+                        const double seconds = static_cast<double>(talkboxBlock++) * blockSize / sampleRate;
+                        talkbox.setMorph(static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * seconds)));
+                    }
+                },
+                [&talkbox, &buffer]
+                {
+                    talkbox.updateFiltersIfNeeded();
+                    juce::dsp::AudioBlock<float> block(buffer);
+                    talkbox.process(block);
+                }
+            });
+        }
+    }
+
+    // Ladder cutoff under an audio-rate sweep: per-sample pitches against a cutoff stepped every modulation sub-block
+    ZdfLadder ladder;
+    ladder.prepare(sampleRate);
+    std::vector<float> sweepPitches(static_cast<size_t>(blockSize));
+    int ladderBlock = 0;
+
+    for (const bool perSample : { true, false })
+    {
+        cases.push_back({
+            juce::String("ZdfLadder/LPF24/cutoff-sweep/") + (perSample ? "per-sample" : "sub-block"),
+            [&]
+            {
+                ladder.setMode(ZdfLadder::Mode::LPF24);
+                ladder.setResonance(0.5f);
+                ladder.setDrive(1.0f);
+                ladder.setCutoffFrequencyHz(1000.0f);
+                ladder.reset();
+                ladderBlock = 0;
+            },
+            [&]
+            {
+                copyNoise();
+
+                // A 5 Hz sweep over four octaves around 1 kHz, as an LFO on the cutoff would
+                const double start = static_cast<double>(ladderBlock++) * blockSize;
+                for (int i = 0; i < blockSize; ++i)
+                    sweepPitches[static_cast<size_t>(i)] = std::log2(1000.0f)
+                        + 2.0f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 5.0 * (start + i) / sampleRate));
+            },
+            [&, perSample]
+            {
+                juce::dsp::AudioBlock<float> block(buffer);
+                if (perSample)
+                {
+                    ladder.process(block, sweepPitches.data(), 1, 0.0f);
+                    return;
+                }
+
+                for (int offset = 0; offset < blockSize; offset += ModulationRouter::subBlockSize)
+                {
+                    const int length = juce::jmin(ModulationRouter::subBlockSize, blockSize - offset);
+                    auto subBlock = block.getSubBlock(static_cast<size_t>(offset), static_cast<size_t>(length));
+                    ladder.setCutoffFrequencyHz(std::exp2(sweepPitches[static_cast<size_t>(offset)]));
+                    ladder.process(subBlock);
+                }
+            }
+        });
+    }
+
+    // Envelope: notes retrigger every quarter second and release halfway, so every stage is rendered
+    auto& envelope = *processor->getEnvelope(0);
+    const int cycleBlocks = juce::jmax(2, static_cast<int>(sampleRate * 0.25 / blockSize));
+    int envelopeBlock = 0;
+
+    for (const int polyphony : envelopePolyphony)
+    {
+        cases.push_back({
+            "Envelope/polyphony:" + juce::String(polyphony),
+            [&]
+            {
+                envelope.resetAllVoices();
+                envelope.setParameters(0.05f, 0.1f, 0.7f, 0.05f);
+                envelopeBlock = 0;
+            },
+            {},
+            [&, polyphony]
+            {
+                const int phase = envelopeBlock++ % cycleBlocks;
+
+                envelope.beginBlock(blockSize);
+
+                for (int voice = 0; voice < polyphony; ++voice)
+                {
+                    if (phase == 0)
+                        envelope.noteOn(48 + voice, 0);
+                    else if (phase == cycleBlocks / 2)
+                        envelope.noteOff(48 + voice, blockSize / 2);
+                }
+
+                for (int voice = 0; voice < polyphony; ++voice)
+                    envelope.renderNote(48 + voice, envelopeOutput.data(), 0, blockSize);
+
+                envelope.endBlock();
+            }
+        });
+    }
+
+    // LFO: free running, as the processor advances it once per block
+    auto& lfo = *processor->getLFO(0);
+
+    for (int type = 0; type < lfoTypeNames.size(); ++type)
+    {
+        cases.push_back({
+            "LFO/" + lfoTypeNames[type],
+            [&lfo, type]
+            {
+                lfo.setType(static_cast<LFO::Type>(type));
+                lfo.setMode(LFO::Mode::Free);
+                lfo.setFrequency(5.0f);
+                lfo.setShape(0.3f);
+                lfo.setNumSteps(8);
+                lfo.setBypassed(false);
+                lfo.resetPhase();
+            },
+            {},
+            [&lfo, blockSize, sampleRate] { lfo.advance(blockSize, static_cast<float>(sampleRate)); }
+        });
+    }
+
+    // Instantiation: what a host pays per plugin instance when a session loads, teardown untimed
+    std::unique_ptr<DigitalSynthesizerAudioProcessor> instance;
+
+    cases.push_back({
+        "Instance/construct",
+        [&instance] { instance.reset(); },
+        [&instance] { instance.reset(); },
+        [&instance] { instance = std::make_unique<DigitalSynthesizerAudioProcessor>(); }
+    });
+
+    cases.push_back({
+        "Instance/construct+prepare",
+        [&instance] { instance.reset(); },
+        [&instance] { instance.reset(); },
+        [&instance, sampleRate, blockSize]
+        {
+            instance = std::make_unique<DigitalSynthesizerAudioProcessor>();
+            instance->setPlayConfigDetails(0, numChannels, sampleRate, blockSize);
+            instance->prepareToPlay(sampleRate, blockSize);
+        }
+    });
+
+    std::vector<Result> results;
+    for (const auto& benchmarkCase : cases)
+    {
+        if (settings.filter.isNotEmpty() && !benchmarkCase.name.containsIgnoreCase(settings.filter))
+            continue;
+
+        results.push_back(measure(settings, benchmarkCase));
+
+        if (onResult != nullptr)
+            onResult(results.back());
+    }
+
+    instance.reset();
+    processor->releaseResources();
+    return results;
+}
+
+ModuleBenchmarks::Result ModuleBenchmarks::measure(const Settings& settings, const Case& benchmarkCase)
+{
+    benchmarkCase.setUp();
+
+    const auto runBlock = [&benchmarkCase]
+        {
+            if (benchmarkCase.prepareBlock != nullptr)
+                benchmarkCase.prepareBlock();
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            benchmarkCase.processBlock();
+            return juce::Time::getHighResolutionTicks() - startTicks;
+        };
+
+    for (int i = 0; i < warmUpBlocks; ++i)
+        runBlock();
+
+    const auto budgetTicks = juce::Time::secondsToHighResolutionTicks(settings.secondsPerCase);
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    std::vector<double> blockTimes;
+    blockTimes.reserve(static_cast<size_t>(minBlocks) * 16);
+
+    while (static_cast<int>(blockTimes.size()) < minBlocks
+           || juce::Time::getHighResolutionTicks() - startTicks < budgetTicks)
+    {
+        blockTimes.push_back(juce::Time::highResolutionTicksToSeconds(runBlock()) * 1.0e9);
+    }
+
+    std::sort(blockTimes.begin(), blockTimes.end());
+
+    Result result;
+    result.name = benchmarkCase.name;
+    result.numBlocks = static_cast<int>(blockTimes.size());
+    result.mean = Statistics::getMean(blockTimes);
+    result.median = Statistics::getPercentile(blockTimes, 0.5);
+    result.p99 = Statistics::getPercentile(blockTimes, 0.99);
+    result.best = blockTimes.front();
+    result.perSample = result.median / settings.blockSize;
+    return result;
+}
+
+juce::String ModuleBenchmarks::formatHeader()
+{
+    return juce::String("case").paddedRight(' ', 40)
+        + "  blocks     mean ns   median ns      p99 ns     best ns  ns/sample";
+}
+
+juce::String ModuleBenchmarks::formatResult(const Result& result)
+{
+    return result.name.paddedRight(' ', 40)
+        + juce::String(result.numBlocks).paddedLeft(' ', 8)
+        + formatNanoseconds(result.mean)
+        + formatNanoseconds(result.median)
+        + formatNanoseconds(result.p99)
+        + formatNanoseconds(result.best)
+        + juce::String(result.perSample, 2).paddedLeft(' ', 11);
+}
+
+juce::String ModuleBenchmarks::toJson(const Settings& settings, const std::vector<Result>& results)
+{
+    juce::Array<juce::var> benchmarks;
+    for (const auto& result : results)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("name", result.name);
+        entry->setProperty("blocks", result.numBlocks);
+        entry->setProperty("meanNs", result.mean);
+        entry->setProperty("medianNs", result.median);
+        entry->setProperty("p99Ns", result.p99);
+        entry->setProperty("bestNs", result.best);
+        entry->setProperty("nsPerSample", result.perSample);
+        benchmarks.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("sampleRate", settings.sampleRate);
+    root->setProperty("blockSize", settings.blockSize);
+    root->setProperty("benchmarks", benchmarks);
+
+    return juce::JSON::toString(juce::var(root));
+}
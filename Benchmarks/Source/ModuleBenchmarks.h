@@ -0,0 +1,94 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class ModuleBenchmarks
+ * @brief Times the DSP modules one at a time, so a regression can be pinned on a single stage.
+ *
+ * Every case drives one module the way the processor does during a block:
+ * - Oscillator::processBlock for each waveform and unison voice count
+ * - Filter::process for each type and slope, clean and with drive and mix
+ * - TalkboxFilter::process for each vowel, static and with a morph sweep
+ * - Envelope::renderNote for a range of polyphony, cycling through every stage
+ * - LFO::advance for each type
+ * - Constructing a processor, and constructing and preparing one, as a host does per instance
+ *
+ * The oscillator, filter, envelope and LFO cases use the modules of a processor
+ * that is prepared but never run, configured through their parameters. Each
+ * block is timed on its own after a short warm-up, for a fixed amount of time.
+ */
+class ModuleBenchmarks
+{
+public:
+    /**
+     * @struct Settings
+     * @brief Parameters shared by every case.
+     */
+    struct Settings
+    {
+        double sampleRate = 48000.0;       ///< Sample rate in Hz
+        int blockSize = 256;               ///< Samples per timed call
+        double secondsPerCase = 0.5;       ///< Time spent measuring each case
+        juce::String filter;               ///< Runs only cases whose name contains this, if not empty
+    };
+
+    /**
+     * @struct Result
+     * @brief Timings of one case. Times are in nanoseconds per block.
+     */
+    struct Result
+    {
+        juce::String name;                 ///< Case name, "Module/variant/..."
+        int numBlocks = 0;                 ///< Measured blocks
+        double mean = 0.0;                 ///< Mean block time
+        double median = 0.0;               ///< 50th percentile block time
+        double p99 = 0.0;                  ///< 99th percentile block time
+        double best = 0.0;                 ///< Fastest block
+        double perSample = 0.0;            ///< Median block time divided by the block size
+    };
+
+    /**
+     * @brief Runs every case matching the settings' filter.
+     * @param settings Parameters shared by every case.
+     * @param onResult Called after each case, for progress output.
+     * @return The results in run order.
+     */
+    static std::vector<Result> run(const Settings& settings, const std::function<void(const Result&)>& onResult = {});
+
+    /**
+     * @brief Returns the header line matching formatResult().
+     */
+    static juce::String formatHeader();
+
+    /**
+     * @brief Returns one result as a table row.
+     */
+    static juce::String formatResult(const Result& result);
+
+    /**
+     * @brief Returns the settings and results as a JSON document, for tracking between releases.
+     */
+    static juce::String toJson(const Settings& settings, const std::vector<Result>& results);
+
+private:
+    /**
+     * @struct Case
+     * @brief One configuration of one module.
+     */
+    struct Case
+    {
+        juce::String name;                  ///< Case name, "Module/variant/..."
+        std::function<void()> setUp;        ///< Configures the module, once before the warm-up
+        std::function<void()> prepareBlock; ///< Resets the input before every block, not timed
+        std::function<void()> processBlock; ///< The timed call
+    };
+
+    /**
+     * @brief Warms a case up, then times its blocks.
+     */
+    static Result measure(const Settings& settings, const Case& benchmarkCase);
+
+    static constexpr int warmUpBlocks = 64;   ///< Blocks run before measuring
+    static constexpr int minBlocks = 200;     ///< Blocks measured even when the time runs out first
+};
@@ -0,0 +1,194 @@
+#include "OfflineRenderBenchmark.h"
+#include "Statistics.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double tempo = 120.0;       // Beats per minute of the scripted sequence
+    constexpr int midiChannel = 1;
+
+    // Chords cycled one per bar, low to high
+    constexpr int chords[][4] = {
+        { 48, 55, 60, 64 },               // C
+        { 45, 52, 57, 60 },               // Am
+        { 41, 48, 53, 57 },               // F
+        { 43, 50, 55, 59 }                // G
+    };
+
+    constexpr juce::uint8 arpeggioVelocities[] = { 110, 70, 90, 70 };
+
+    juce::String formatMicroseconds(double value)
+    {
+        return juce::String(value, 1).paddedLeft(' ', 10);
+    }
+}
+
+bool OfflineRenderBenchmark::run(const Settings& settings, Result& result)
+{
+    jassert(settings.sampleRate > 0.0 && settings.blockSize > 0);
+
+    auto processor = std::make_unique<DigitalSynthesizerAudioProcessor>();
+    processor->setMultiCoreRenderingEnabled(settings.multiCore);
+
+    // Timings must stay comparable between runs, so quality never drops under load
+    processor->getQualityGovernor().setEnabled(false);
+
+    if (!loadPreset(*processor, settings.preset))
+        return false;
+
+    const int numChannels = processor->getTotalNumOutputChannels();
+    processor->setPlayConfigDetails(0, numChannels, settings.sampleRate, settings.blockSize);
+    processor->prepareToPlay(settings.sampleRate, settings.blockSize);
+
+    // Whole blocks only, so every measured call does the same amount of work
+    const auto toBlocks = [&settings](double seconds)
+        {
+            return static_cast<int>(std::ceil(seconds * settings.sampleRate / settings.blockSize));
+        };
+
+    const int warmUpBlocks = juce::jmax(0, toBlocks(settings.warmUpSeconds));
+    const int measuredBlocks = juce::jmax(1, toBlocks(settings.seconds));
+    const int totalBlocks = warmUpBlocks + measuredBlocks;
+
+    const auto events = createSequence(settings.sampleRate,
+                                       static_cast<juce::int64>(totalBlocks) * settings.blockSize);
+
+    juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+    juce::MidiBuffer midi;
+
+    std::vector<double> blockTimes;
+    blockTimes.reserve(static_cast<size_t>(measuredBlocks));
+
+    size_t nextEvent = 0;
+    juce::int64 measuredTicks = 0;
+
+    for (int block = 0; block < totalBlocks; ++block)
+    {
+        const auto blockStart = static_cast<juce::int64>(block) * settings.blockSize;
+        const auto blockEnd = blockStart + settings.blockSize;
+
+        midi.clear();
+        for (; nextEvent < events.size() && events[nextEvent].samplePosition < blockEnd; ++nextEvent)
+            midi.addEvent(events[nextEvent].message, static_cast<int>(events[nextEvent].samplePosition - blockStart));
+
+        buffer.clear();
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        processor->processBlock(buffer, midi);
+        const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+
+        if (block < warmUpBlocks)
+            continue;
+
+        measuredTicks += elapsedTicks;
+        blockTimes.push_back(juce::Time::highResolutionTicksToSeconds(elapsedTicks) * 1.0e6);
+    }
+
+    processor->releaseResources();
+
+    std::sort(blockTimes.begin(), blockTimes.end());
+
+    const double audioSeconds = static_cast<double>(measuredBlocks) * settings.blockSize / settings.sampleRate;
+    const double renderSeconds = juce::Time::highResolutionTicksToSeconds(measuredTicks);
+
+    result.sampleRate = settings.sampleRate;
+    result.blockSize = settings.blockSize;
+    result.numBlocks = measuredBlocks;
+    result.realtimeFactor = renderSeconds > 0.0 ? audioSeconds / renderSeconds : 0.0;
+    result.budget = settings.blockSize / settings.sampleRate * 1.0e6;
+    result.median = Statistics::getPercentile(blockTimes, 0.5);
+    result.p90 = Statistics::getPercentile(blockTimes, 0.9);
+    result.p99 = Statistics::getPercentile(blockTimes, 0.99);
+    result.p999 = Statistics::getPercentile(blockTimes, 0.999);
+    result.worst = blockTimes.back();
+    result.overruns = static_cast<int>(blockTimes.end() - std::upper_bound(blockTimes.begin(), blockTimes.end(), result.budget));
+    return true;
+}
+
+juce::String OfflineRenderBenchmark::formatHeader()
+{
+    return "    rate  block  blocks   realtime  budget us    p50 us    p90 us    p99 us  p99.9 us    max us  overruns";
+}
+
+juce::String OfflineRenderBenchmark::formatResult(const Result& result)
+{
+    return juce::String(result.sampleRate, 0).paddedLeft(' ', 8)
+        + juce::String(result.blockSize).paddedLeft(' ', 7)
+        + juce::String(result.numBlocks).paddedLeft(' ', 8)
+        + (juce::String(result.realtimeFactor, 1) + "x").paddedLeft(' ', 11)
+        + formatMicroseconds(result.budget).paddedLeft(' ', 11)
+        + formatMicroseconds(result.median)
+        + formatMicroseconds(result.p90)
+        + formatMicroseconds(result.p99)
+        + formatMicroseconds(result.p999)
+        + formatMicroseconds(result.worst)
+        + juce::String(result.overruns).paddedLeft(' ', 10);
+}
+
+std::vector<OfflineRenderBenchmark::TimedEvent> OfflineRenderBenchmark::createSequence(double sampleRate, juce::int64 numSamples)
+{
+    const double samplesPerBeat = sampleRate * 60.0 / tempo;
+    const double samplesPerBar = samplesPerBeat * 4.0;
+    const double samplesPerStep = samplesPerBeat / 4.0;
+
+    std::vector<TimedEvent> events;
+
+    const auto addNote = [&events, numSamples](double start, double length, int note, juce::uint8 velocity)
+        {
+            const auto on = static_cast<juce::int64>(start);
+            const auto off = static_cast<juce::int64>(start + length);
+            if (off >= numSamples)
+                return;
+
+            events.push_back({ on, juce::MidiMessage::noteOn(midiChannel, note, velocity) });
+            events.push_back({ off, juce::MidiMessage::noteOff(midiChannel, note) });
+        };
+
+    const int numBars = static_cast<int>(std::ceil(static_cast<double>(numSamples) / samplesPerBar));
+    for (int bar = 0; bar < numBars; ++bar)
+    {
+        const auto& chord = chords[bar % juce::numElementsInArray(chords)];
+        const double barStart = bar * samplesPerBar;
+
+        for (const int note : chord)
+            addNote(barStart, samplesPerBeat * 3.5, note, 90);
+
+        // Up two octaves through the chord tones and back, one note per sixteenth
+        for (int step = 0; step < 16; ++step)
+        {
+            const int position = step < 8 ? step : 15 - step;
+            const int note = chord[position % 4] + 12 * (1 + position / 4);
+            addNote(barStart + step * samplesPerStep, samplesPerStep * 0.75, note,
+                    arpeggioVelocities[step % juce::numElementsInArray(arpeggioVelocities)]);
+        }
+    }
+
+    // Releases first at a shared position, as a sequencer sends them
+    std::stable_sort(events.begin(), events.end(), [](const TimedEvent& a, const TimedEvent& b)
+        {
+            if (a.samplePosition != b.samplePosition)
+                return a.samplePosition < b.samplePosition;
+
+            return a.message.isNoteOff() && !b.message.isNoteOff();
+        });
+
+    return events;
+}
+
+bool OfflineRenderBenchmark::loadPreset(DigitalSynthesizerAudioProcessor& processor, const juce::File& preset)
+{
+    const auto xml = juce::XmlDocument::parse(preset);
+    if (xml == nullptr)
+        return false;
+
+    auto& apvts = processor.getAPVTS();
+    const auto state = juce::ValueTree::fromXml(*xml);
+    if (!state.hasType(apvts.state.getType()))
+        return false;
+
+    // Same steps as PresetManager, without the background thread and the fade
+    apvts.replaceState(state);
+    processor.getModulationRouter().disconnectAll();
+    processor.restoreModulationRouting();
+    return true;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+class DigitalSynthesizerAudioProcessor;
+
+/**
+ * @class OfflineRenderBenchmark
+ * @brief Renders a preset through the processor offline and measures the time spent per block.
+ *
+ * A fresh DigitalSynthesizerAudioProcessor is created for every run, without an
+ * editor, so only the audio path and the proxies that keep modulation alive are
+ * measured. The preset is applied synchronously, then a scripted sequence of held
+ * chords and a fast arpeggio is fed through processBlock at the requested sample
+ * rate and block size, the way a host would.
+ */
+class OfflineRenderBenchmark
+{
+public:
+    /**
+     * @struct Settings
+     * @brief Parameters of one run.
+     */
+    struct Settings
+    {
+        juce::File preset;                 ///< Preset file to render
+        double sampleRate = 48000.0;       ///< Sample rate in Hz
+        int blockSize = 256;               ///< Samples per processBlock call
+        double seconds = 20.0;             ///< Length of the measured render
+        double warmUpSeconds = 1.0;        ///< Rendered before measuring, not counted
+        bool multiCore = false;            ///< Renders oscillators on worker threads
+    };
+
+    /**
+     * @struct Result
+     * @brief Timings of one run. Block times are in microseconds.
+     */
+    struct Result
+    {
+        double sampleRate = 0.0;           ///< Sample rate in Hz
+        int blockSize = 0;                 ///< Samples per block
+        int numBlocks = 0;                 ///< Measured blocks
+        double realtimeFactor = 0.0;       ///< Rendered audio time divided by the time it took
+        double budget = 0.0;               ///< Audio time of one block
+        double median = 0.0;               ///< 50th percentile block time
+        double p90 = 0.0;                  ///< 90th percentile block time
+        double p99 = 0.0;                  ///< 99th percentile block time
+        double p999 = 0.0;                 ///< 99.9th percentile block time
+        double worst = 0.0;                ///< Slowest block
+        int overruns = 0;                  ///< Blocks slower than their budget
+    };
+
+    /**
+     * @struct TimedEvent
+     * @brief A MIDI message and the sample it lands on, counted from the start of the render.
+     */
+    struct TimedEvent
+    {
+        juce::int64 samplePosition = 0;    ///< Absolute sample position
+        juce::MidiMessage message;         ///< Message sent at that position
+    };
+
+    /**
+     * @brief Renders a preset with the given settings.
+     * @param settings Parameters of the run.
+     * @param result Receives the timings.
+     * @return False if the preset could not be loaded.
+     */
+    static bool run(const Settings& settings, Result& result);
+
+    /**
+     * @brief Returns the header line matching formatResult().
+     */
+    static juce::String formatHeader();
+
+    /**
+     * @brief Returns one result as a table row.
+     */
+    static juce::String formatResult(const Result& result);
+
+    /**
+     * @brief Builds the scripted sequence, sorted by position.
+     *
+     * Four-note chords change every bar at 120 BPM and are held for most of it,
+     * while a sixteenth-note arpeggio runs over two octaves on top, so voices
+     * start, sustain and release throughout the render. The golden renders
+     * play the same sequence.
+     *
+     * @param sampleRate Sample rate in Hz.
+     * @param numSamples Length of the sequence; every note is released before it ends.
+     */
+    static std::vector<TimedEvent> createSequence(double sampleRate, juce::int64 numSamples);
+
+    /**
+     * @brief Reads a preset file and swaps it into the processor.
+     */
+    static bool loadPreset(DigitalSynthesizerAudioProcessor& processor, const juce::File& preset);
+};
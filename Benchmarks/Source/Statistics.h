@@ -0,0 +1,34 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @namespace Statistics
+ * @brief Summary statistics over measured block times.
+ */
+namespace Statistics
+{
+    /**
+     * @brief Returns a nearest-rank percentile of sorted values.
+     * @param sorted Values in ascending order, not empty.
+     * @param fraction Percentile between 0 and 1.
+     */
+    inline double getPercentile(const std::vector<double>& sorted, double fraction)
+    {
+        jassert(!sorted.empty());
+
+        const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+        return sorted[juce::jlimit<size_t>(1, sorted.size(), rank) - 1];
+    }
+
+    /**
+     * @brief Returns the arithmetic mean of values, or 0 if there are none.
+     */
+    inline double getMean(const std::vector<double>& values)
+    {
+        if (values.empty())
+            return 0.0;
+
+        return std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+    }
+}
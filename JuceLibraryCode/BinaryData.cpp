@@ -2694,6 +2694,729 @@ static const unsigned char temp_binary_data_5[] =
 
 const char* WhiteNoise_png = (const char*) temp_binary_data_5;
 
+//================== Bounce.xml ==================
+static const unsigned char temp_binary_data_6[] =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+"\n"
+"<PARAMETERS editorWidth=\"1343\" editorHeight=\"561\">\n"
+"  <PARAM id=\"ENV1_ATTACK\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV1_DECAY\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV1_LINK\"/>\n"
+"  <PARAM id=\"ENV1_MODE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE\" value=\"0.3850000202655792\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_MAX\" value=\"1.0\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_MIN\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_SOURCE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_DECAY\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_LINK\"/>\n"
+"  <PARAM id=\"ENV2_MODE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE\" value=\"0.6130000352859497\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF\" value=\"0.6440000534057617\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR\" value=\"0.4620000123977661\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_LINK\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_MIX\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH\" value=\"0.5890000462532043\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_RES\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_SLOPE\"/>\n"
+"  <PARAM id=\"FILTER1_TYPE\"/>\n"
+"  <PARAM id=\"FILTER1_VOWEL\"/>\n"
+"  <PARAM id=\"FILTER2_BYPASS\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF\" value=\"0.3210000097751617\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_INDEX\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_MAX\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_MIN\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_SOURCE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_LINK\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_MIX\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_RES\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_SLOPE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_TYPE\"/>\n"
+"  <PARAM id=\"FILTER2_VOWEL\"/>\n"
+"  <PARAM id=\"LFO1_BYPASS\"/>\n"
+"  <PARAM id=\"LFO1_FREQ\" value=\"0.25\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO1_MODE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE\" value=\"0.5\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO1_STEPS\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO1_TYPE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO2_BYPASS\"/>\n"
+"  <PARAM id=\"LFO2_FREQ\" value=\"0.25\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO2_MODE\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO2_STEPS\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO2_TYPE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"LFO3_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO3_FREQ\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO3_MODE\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO3_STEPS\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO3_TYPE\"/>\n"
+"  <PARAM id=\"LFO4_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO4_FREQ\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO4_MODE\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO4_STEPS\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO4_TYPE\"/>\n"
+"  <PARAM id=\"OSC1_BYPASS\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_OCTAVE\" value=\"2.0\"/>\n"
+"  <PARAM id=\"OSC1_PAN\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_VOICES\" value=\"1.0\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME\" value=\"0.6599999666213989\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_WAVEFORM\" value=\"2.0\"/>\n"
+"  <PARAM id=\"OSC2_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE\" value=\"0.4399999976158142\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_OCTAVE\"/>\n"
+"  <PARAM id=\"OSC2_PAN\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_VOICES\" value=\"3.0\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME\" value=\"0.1599999964237213\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_WAVEFORM\" value=\"1.0\"/>\n"
+"</PARAMETERS>\n";
+
+const char* Bounce_xml = (const char*) temp_binary_data_6;
+
+//================== Freaks.xml ==================
+static const unsigned char temp_binary_data_7[] =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+"\n"
+"<PARAMETERS editorWidth=\"1343\" editorHeight=\"561\">\n"
+"  <PARAM id=\"ENV1_ATTACK\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV1_DECAY\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV1_LINK\"/>\n"
+"  <PARAM id=\"ENV1_MODE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE\" value=\"0.1820000112056732\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN\" value=\"1.0\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_DECAY\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_LINK\"/>\n"
+"  <PARAM id=\"ENV2_MODE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE\" value=\"0.2110000103712082\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN\" value=\"0.3999999761581421\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_BYPASS\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF\" value=\"0.3210000097751617\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_MAX\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_MIN\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_SOURCE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_LINK\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER1_MIX\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH\" value=\"0.3710000216960907\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_INDEX\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_MAX\" value=\"0.6490000486373901\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_MIN\" value=\"0.3710000216960907\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_SOURCE\" value=\"3.0\"/>\n"
+"  <PARAM id=\"FILTER1_RES\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_SLOPE\"/>\n"
+"  <PARAM id=\"FILTER1_TYPE\" value=\"3.0\"/>\n"
+"  <PARAM id=\"FILTER1_VOWEL\"/>\n"
+"  <PARAM id=\"FILTER2_BYPASS\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF\" value=\"0.3210000097751617\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR\" value=\"0.4620000123977661\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_LINK\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_MIX\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH\" value=\"0.5890000462532043\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_RES\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_SLOPE\"/>\n"
+"  <PARAM id=\"FILTER2_TYPE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_VOWEL\"/>\n"
+"  <PARAM id=\"LFO1_BYPASS\"/>\n"
+"  <PARAM id=\"LFO1_FREQ\" value=\"0.3550000190734863\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO1_MODE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE\" value=\"0.5\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO1_STEPS\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO1_TYPE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO2_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO2_FREQ\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO2_MODE\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO2_STEPS\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO2_TYPE\"/>\n"
+"  <PARAM id=\"LFO3_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO3_FREQ\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO3_MODE\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO3_STEPS\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO3_TYPE\"/>\n"
+"  <PARAM id=\"LFO4_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO4_FREQ\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO4_MODE\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO4_STEPS\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO4_TYPE\"/>\n"
+"  <PARAM id=\"OSC1_BYPASS\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_OCTAVE\" value=\"2.0\"/>\n"
+"  <PARAM id=\"OSC1_PAN\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_VOICES\" value=\"1.0\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME\" value=\"0.9799999594688416\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_WAVEFORM\" value=\"3.0\"/>\n"
+"  <PARAM id=\"OSC2_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_OCTAVE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"OSC2_PAN\" value=\"0.5\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_VOICES\" value=\"1.0\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME\" value=\"0.1599999964237213\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_WAVEFORM\" value=\"3.0\"/>\n"
+"</PARAMETERS>\n";
+
+const char* Freaks_xml = (const char*) temp_binary_data_7;
+
+//================== Mario.xml ==================
+static const unsigned char temp_binary_data_8[] =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+"\n"
+"<PARAMETERS editorWidth=\"1343\" editorHeight=\"561\">\n"
+"  <PARAM id=\"ENV1_ATTACK\" value=\"0.03500000014901161\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_ATTACK_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV1_DECAY\" value=\"0.1600000113248825\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_DECAY_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV1_LINK\"/>\n"
+"  <PARAM id=\"ENV1_MODE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE\" value=\"0.3450000286102295\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_INDEX\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_MAX\" value=\"0.5360000133514404\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_MIN\" value=\"0.3450000286102295\"/>\n"
+"  <PARAM id=\"ENV1_RELEASE_MOD_SOURCE\" value=\"4.0\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN\" value=\"1.0\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV1_SUSTAIN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK\" value=\"0.0\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_ATTACK_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_DECAY\" value=\"0.2100000083446503\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_DECAY_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_LINK\"/>\n"
+"  <PARAM id=\"ENV2_MODE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE\" value=\"0.2980000078678131\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_RELEASE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN\" value=\"1.0\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_MAX\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_MIN\"/>\n"
+"  <PARAM id=\"ENV2_SUSTAIN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_BYPASS\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF\" value=\"0.3210000097751617\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_CUTOFF_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_DRIVE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR\" value=\"0.987000048160553\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_FACTOR_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_LINK\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER1_MIX\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_MIX_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH\" value=\"0.6860000491142273\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_MAX\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_MIN\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_MORPH_MOD_SOURCE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_RES\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER1_RES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER1_SLOPE\"/>\n"
+"  <PARAM id=\"FILTER1_TYPE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER1_VOWEL\"/>\n"
+"  <PARAM id=\"FILTER2_BYPASS\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF\" value=\"0.4770000278949738\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_INDEX\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_MAX\" value=\"0.8140000104904175\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_MIN\" value=\"0.4770000278949738\"/>\n"
+"  <PARAM id=\"FILTER2_CUTOFF_MOD_SOURCE\" value=\"4.0\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE\" value=\"0.3199999928474426\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_DRIVE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_FACTOR_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_LINK\" value=\"2.0\"/>\n"
+"  <PARAM id=\"FILTER2_MIX\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_MIX_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_MORPH_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_RES\" value=\"0.2450000047683716\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_MAX\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_MIN\"/>\n"
+"  <PARAM id=\"FILTER2_RES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"FILTER2_SLOPE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"FILTER2_TYPE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"FILTER2_VOWEL\"/>\n"
+"  <PARAM id=\"LFO1_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO1_FREQ\" value=\"0.3890000283718109\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO1_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO1_MODE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO1_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO1_STEPS\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO1_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO1_TYPE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"LFO2_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO2_FREQ\" value=\"0.1100000068545341\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO2_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO2_MODE\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO2_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO2_STEPS\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO2_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO2_TYPE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"LFO3_BYPASS\" value=\"1.0\"/>\n"
+"  <PARAM id=\"LFO3_FREQ\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO3_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO3_MODE\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO3_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO3_STEPS\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO3_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO3_TYPE\"/>\n"
+"  <PARAM id=\"LFO4_BYPASS\" value=\"1.0\"/>\n"
+"  <PARAM id=\"LFO4_FREQ\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO4_FREQ_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO4_MODE\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO4_SHAPE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO4_STEPS\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_INDEX\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_MAX\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_MIN\"/>\n"
+"  <PARAM id=\"LFO4_STEPS_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"LFO4_TYPE\"/>\n"
+"  <PARAM id=\"OSC1_BYPASS\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE\" value=\"0.3999999761581421\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_DETUNE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_OCTAVE\" value=\"1.0\"/>\n"
+"  <PARAM id=\"OSC1_PAN\" value=\"0.5\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_PAN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_VOICES\" value=\"3.0\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_VOICES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC1_VOLUME_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC1_WAVEFORM\" value=\"1.0\"/>\n"
+"  <PARAM id=\"OSC2_BYPASS\" value=\"0.0\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE\" value=\"0.0\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_DETUNE_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_OCTAVE\" value=\"2.0\"/>\n"
+"  <PARAM id=\"OSC2_PAN\" value=\"0.5\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_PAN_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_VOICES\" value=\"1.0\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_VOICES_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME\" value=\"0.3299999833106995\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_INDEX\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_MAX\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_MIN\"/>\n"
+"  <PARAM id=\"OSC2_VOLUME_MOD_SOURCE\"/>\n"
+"  <PARAM id=\"OSC2_WAVEFORM\" value=\"4.0\"/>\n"
+"</PARAMETERS>\n";
+
+const char* Mario_xml = (const char*) temp_binary_data_8;
+
 
 const char* getNamedResource (const char* resourceNameUTF8, int& numBytes);
 const char* getNamedResource (const char* resourceNameUTF8, int& numBytes)
@@ -2712,6 +3435,9 @@ const char* getNamedResource (const char* resourceNameUTF8, int& numBytes)
         case 0xf36f4027:  numBytes = 6685; return Square_png;
         case 0xdd99fb92:  numBytes = 10872; return Triangle_png;
         case 0x5bf5a97b:  numBytes = 40624; return WhiteNoise_png;
+        case 0x281e4e00:  numBytes = 8732; return Bounce_xml;
+        case 0x96b99d48:  numBytes = 8886; return Freaks_xml;
+        case 0x3ce3d03c:  numBytes = 9060; return Mario_xml;
         default: break;
     }
 
@@ -2726,7 +3452,10 @@ const char* namedResourceList[] =
     "Sine_png",
     "Square_png",
     "Triangle_png",
-    "WhiteNoise_png"
+    "WhiteNoise_png",
+    "Bounce_xml",
+    "Freaks_xml",
+    "Mario_xml"
 };
 
 const char* originalFilenames[] =
@@ -2736,7 +3465,10 @@ const char* originalFilenames[] =
     "Sine.png",
     "Square.png",
     "Triangle.png",
-    "WhiteNoise.png"
+    "WhiteNoise.png",
+    "Bounce.xml",
+    "Freaks.xml",
+    "Mario.xml"
 };
 
 const char* getNamedResourceOriginalFilename (const char* resourceNameUTF8);
@@ -26,8 +26,17 @@ namespace BinaryData
     extern const char*   WhiteNoise_png;
     const int            WhiteNoise_pngSize = 40624;
 
+    extern const char*   Bounce_xml;
+    const int            Bounce_xmlSize = 8732;
+
+    extern const char*   Freaks_xml;
+    const int            Freaks_xmlSize = 8886;
+
+    extern const char*   Mario_xml;
+    const int            Mario_xmlSize = 9060;
+
     // Number of elements in the namedResourceList and originalFileNames arrays.
-    const int namedResourceListSize = 6;
+    const int namedResourceListSize = 9;
 
     // Points to the start of a list of resource names.
     extern const char* namedResourceList[];
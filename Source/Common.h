@@ -1,5 +1,8 @@
 ﻿#pragma once
 
+#include <algorithm>
+#include <array>
+#include <initializer_list>
 #include <vector>
 #include <map>
 #include <set>
@@ -17,10 +20,61 @@ juce::File getProjectPath();
 
 inline const juce::URL projectUrl{ "https://github.com/dorzay/DigitalSynthesizer" }; ///< Repository's URL.
 
-#define NUM_OF_OSCILLATORS 2 ///< Number of oscillators in the synth.
-#define NUM_OF_ENVELOPES   2 ///< Number of ADSR envelopes.
-#define NUM_OF_FILTERS     2 ///< Number of DSP filters.
-#define NUM_OF_LFOS        4 ///< Number of LFO modules.
+// Module counts are build-time configuration. Each one can be overridden by a build
+// variant's preprocessor definitions (see the exporter configurations in the .jucer);
+// modules beyond the count are never created and register no parameters.
+#ifndef NUM_OF_OSCILLATORS
+ #define NUM_OF_OSCILLATORS 2 ///< Number of oscillators in the synth.
+#endif
+#ifndef NUM_OF_ENVELOPES
+ #define NUM_OF_ENVELOPES   2 ///< Number of ADSR envelopes.
+#endif
+#ifndef NUM_OF_FILTERS
+ #define NUM_OF_FILTERS     2 ///< Number of DSP filters.
+#endif
+#ifndef NUM_OF_LFOS
+ #define NUM_OF_LFOS        4 ///< Number of LFO modules.
+#endif
+
+// Per-stage timing of the audio callback, see StageProfiler.h. Off unless a build variant turns it on.
+#ifndef STAGE_PROFILING
+ #define STAGE_PROFILING    0 ///< 1 to compile the stage profiler and its overlay in.
+#endif
+
+// OpenGL editor rendering, see GpuRenderer.h. Needs the juce_opengl module; off, the editor only renders in software.
+#ifndef OPENGL_RENDERING
+ #define OPENGL_RENDERING   1 ///< 1 to let the editor render through an OpenGL context once enabled from the menu.
+#endif
+
+// Parameter control over OSC, see OscRemoteControl.h. Needs the juce_osc module; off, remote control is compiled out.
+#ifndef OSC_REMOTE_CONTROL
+ #define OSC_REMOTE_CONTROL 1 ///< 1 to let the processor listen for OSC once a port is chosen from the menu.
+#endif
+
+// Counting of heap allocations on the audio thread, see AllocationTracker.h. Replaces the global operator new, debug builds only.
+#ifndef ALLOCATION_TRACKING
+ #define ALLOCATION_TRACKING 0 ///< 1 to count every allocation processBlock and its render workers make.
+#endif
+
+/**
+ * @namespace SynthConfig
+ * @brief Compile-time module counts of this build variant.
+ */
+namespace SynthConfig
+{
+    inline constexpr int numOscillators = NUM_OF_OSCILLATORS; ///< Number of oscillators
+    inline constexpr int numEnvelopes = NUM_OF_ENVELOPES;     ///< Number of ADSR envelopes
+    inline constexpr int numFilters = NUM_OF_FILTERS;         ///< Number of filters
+    inline constexpr int numLfos = NUM_OF_LFOS;               ///< Number of LFOs
+
+    /** Rows of the editor, each row holds one oscillator, envelope and filter. */
+    inline constexpr int numModuleRows = std::max({ numOscillators, numEnvelopes, numFilters });
+
+    static_assert(numOscillators >= 1 && numOscillators <= 8, "NUM_OF_OSCILLATORS must be between 1 and 8");
+    static_assert(numEnvelopes >= 1 && numEnvelopes <= 8, "NUM_OF_ENVELOPES must be between 1 and 8");
+    static_assert(numFilters >= 0 && numFilters <= 8, "NUM_OF_FILTERS must be between 0 and 8");
+    static_assert(numLfos >= 0 && numLfos <= 8, "NUM_OF_LFOS must be between 0 and 8");
+}
 
 /**
  * @namespace UI
@@ -231,6 +285,59 @@ struct ComboBoxParamSpecs
     int defaultIndex;          ///< Default selection index
 };
 
+/**
+ * @class ParamSpecTable
+ * @brief Parameter specs of every instance of a module type, built once per process.
+ *
+ * Spec getters assemble their IDs by string concatenation. Keeping the
+ * results in a function-local table runs the builder once per instance and
+ * listed parameter, when the first plugin instance creates its layout;
+ * every later call, from any instance, copies reference-counted strings.
+ *
+ * @tparam Spec Spec type returned by the builder.
+ * @tparam ID Parameter enum of the module, ending in Count.
+ * @tparam NumInstances Number of module instances.
+ */
+template <typename Spec, typename ID, int NumInstances>
+class ParamSpecTable
+{
+public:
+    /**
+     * @brief Builds the specs of the listed parameters for every instance.
+     * @param ids Parameters the builder handles.
+     * @param build Called as build(id, instanceIndex).
+     */
+    template <typename Builder>
+    ParamSpecTable(std::initializer_list<ID> ids, Builder&& build)
+    {
+        for (int index = 0; index < NumInstances; ++index)
+        {
+            for (const auto id : ids)
+            {
+                const auto entry = static_cast<size_t>(index) * numIDs + static_cast<size_t>(id);
+                specs[entry] = build(id, index);
+                built[entry] = true;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the spec of one parameter of one instance.
+     */
+    const Spec& get(ID id, int index) const noexcept
+    {
+        const auto entry = static_cast<size_t>(index) * numIDs + static_cast<size_t>(id);
+        jassert(index >= 0 && index < NumInstances && built[entry]);
+        return specs[entry];
+    }
+
+private:
+    static constexpr size_t numIDs = static_cast<size_t>(ID::Count); ///< Entries per instance
+
+    std::array<Spec, numIDs * NumInstances> specs{};  ///< Specs by instance, then parameter
+    std::array<bool, numIDs * NumInstances> built{};  ///< True for the entries the builder filled
+};
+
 /**
  * @namespace MidiController
  * @brief Mapping of MIDI CC numbers to synth controls (Arturia MiniLab).
@@ -0,0 +1,453 @@
+#include "Arpeggiator.h"
+
+namespace
+{
+    /** @brief Rate choice labels, longest first. */
+    const juce::StringArray rateChoices{ "1/2", "1/4", "1/4T", "1/8", "1/8T", "1/16", "1/16T", "1/32" };
+
+    /** @brief Length of one step in quarter notes per rate choice. */
+    constexpr std::array<double, 8> rateQuarterNotes{ 2.0, 1.0, 2.0 / 3.0, 0.5, 1.0 / 3.0, 0.25, 1.0 / 6.0, 0.125 };
+
+    constexpr int defaultRate = 5;   // 1/16
+
+    constexpr int never = std::numeric_limits<int>::max();
+
+    bool isNote(const MidiEventList::Event& event) noexcept
+    {
+        return event.type == MidiEventList::Type::NoteOn || event.type == MidiEventList::Type::NoteOff;
+    }
+
+    /**
+     * @brief Returns the first sample at or after a position, 0 for positions already past.
+     */
+    int toSample(double position) noexcept
+    {
+        return position <= 0.0 ? 0 : static_cast<int>(juce::jmin(std::ceil(position), static_cast<double>(never)));
+    }
+}
+
+Arpeggiator::Arpeggiator(juce::AudioProcessorValueTreeState& apvts)
+{
+    modeHandle = apvts.getRawParameterValue(getModeParamSpecs().paramID);
+    rateHandle = apvts.getRawParameterValue(getRateParamSpecs().paramID);
+    octavesHandle = apvts.getRawParameterValue(getOctavesParamSpecs().id);
+    gateHandle = apvts.getRawParameterValue(getGateParamSpecs().id);
+    numStepsHandle = apvts.getRawParameterValue(getNumStepsParamSpecs().id);
+    jassert(modeHandle != nullptr && rateHandle != nullptr && octavesHandle != nullptr
+        && gateHandle != nullptr && numStepsHandle != nullptr);
+
+    for (int i = 0; i < maxSteps; ++i)
+    {
+        stepHandles[static_cast<size_t>(i)] = apvts.getRawParameterValue(getStepParamSpecs(i).id);
+        jassert(stepHandles[static_cast<size_t>(i)] != nullptr);
+    }
+}
+
+ComboBoxParamSpecs Arpeggiator::getModeParamSpecs()
+{
+    ComboBoxParamSpecs spec;
+
+    spec.paramID = "ARP_MODE";
+    spec.label = "Arp Mode";
+    spec.choices = { "Off", "Up", "Down", "Up/Down", "As Played", "Random", "Sequence" };
+    spec.defaultIndex = static_cast<int>(Mode::Off);
+
+    jassert(spec.choices.size() == static_cast<int>(Mode::Count));
+    return spec;
+}
+
+ComboBoxParamSpecs Arpeggiator::getRateParamSpecs()
+{
+    ComboBoxParamSpecs spec;
+
+    spec.paramID = "ARP_RATE";
+    spec.label = "Arp Rate";
+    spec.choices = rateChoices;
+    spec.defaultIndex = defaultRate;
+
+    jassert(spec.choices.size() == static_cast<int>(rateQuarterNotes.size()));
+    return spec;
+}
+
+KnobParamSpecs Arpeggiator::getOctavesParamSpecs()
+{
+    return { "ARP_OCTAVES", "Arp Octaves", 1.0f, static_cast<float>(maxOctaves), 1.0f, 1.0f,
+             FormattingUtils::FormatType::Normal, true };
+}
+
+KnobParamSpecs Arpeggiator::getGateParamSpecs()
+{
+    return { "ARP_GATE", "Arp Gate", 0.05f, 1.0f, 0.01f, 0.5f, FormattingUtils::FormatType::Percent };
+}
+
+KnobParamSpecs Arpeggiator::getNumStepsParamSpecs()
+{
+    return { "ARP_STEPS", "Arp Steps", 1.0f, static_cast<float>(maxSteps), 1.0f, 8.0f,
+             FormattingUtils::FormatType::Normal, true };
+}
+
+KnobParamSpecs Arpeggiator::getStepParamSpecs(int step)
+{
+    jassert(step >= 0 && step < maxSteps);
+
+    const auto number = juce::String(step + 1);
+    return { "ARP_STEP_" + number, "Arp Step " + number,
+             static_cast<float>(-maxStepOffset), static_cast<float>(maxStepOffset), 1.0f, 0.0f,
+             FormattingUtils::FormatType::Normal, true };
+}
+
+void Arpeggiator::addParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout)
+{
+    for (const auto& spec : { getModeParamSpecs(), getRateParamSpecs() })
+    {
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            spec.paramID, spec.label, spec.choices, spec.defaultIndex));
+    }
+
+    const auto gateSpec = getGateParamSpecs();
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        gateSpec.id, gateSpec.name,
+        juce::NormalisableRange<float>(gateSpec.minValue, gateSpec.maxValue, gateSpec.stepSize),
+        gateSpec.defaultValue));
+
+    std::vector<KnobParamSpecs> intSpecs{ getOctavesParamSpecs(), getNumStepsParamSpecs() };
+    for (int i = 0; i < maxSteps; ++i)
+        intSpecs.push_back(getStepParamSpecs(i));
+
+    for (const auto& spec : intSpecs)
+    {
+        layout.add(std::make_unique<juce::AudioParameterInt>(
+            spec.id, spec.name,
+            static_cast<int>(spec.minValue),
+            static_cast<int>(spec.maxValue),
+            static_cast<int>(spec.defaultValue)));
+    }
+}
+
+void Arpeggiator::prepare(double newSampleRate)
+{
+    jassert(newSampleRate > 0.0);
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void Arpeggiator::reset() noexcept
+{
+    numHeldKeys = 0;
+    numSoundingNotes = 0;
+    numGenerated = 0;
+    nextStepSample = 0.0;
+    gateEndSample = 0.0;
+    lastGridStep = -1;
+    clockRunning = false;
+    patternPosition = 0;
+    random.setSeed(randomSeed + seedOffset);
+}
+
+void Arpeggiator::setSeedOffset(uint32_t offset) noexcept
+{
+    seedOffset = offset;
+}
+
+void Arpeggiator::process(MidiEventList& events, const LFO::Transport& transport, int numSamples)
+{
+    const bool switched = updateFromParameters();
+    numGenerated = 0;
+
+    if (mode == Mode::Off)
+    {
+        // Keys are tracked even while off, so switching on mid-chord plays them
+        if (!switched)
+        {
+            for (const auto& event : events)
+                if (isNote(event))
+                    handleKey(event);
+
+            return;
+        }
+
+        // The arpeggiated notes end and the held keys sound again, as if just pressed
+        releaseSounding(0);
+        for (int i = 0; i < numHeldKeys; ++i)
+        {
+            const auto& key = heldKeys[static_cast<size_t>(i)];
+            addEvent(MidiEventList::Type::NoteOn, 0, key.note, key.velocity, key.channel);
+        }
+
+        clockRunning = false;
+
+        for (const auto& event : events)
+        {
+            if (!isNote(event))
+                continue;
+
+            handleKey(event);
+            addEvent(event.type, event.sample, event.number, event.value, event.channel);
+        }
+
+        events.replaceNotes(generated.data(), numGenerated);
+        return;
+    }
+
+    if (switched)
+    {
+        // The held keys sounded on their own until now
+        for (int i = 0; i < numHeldKeys; ++i)
+        {
+            const auto& key = heldKeys[static_cast<size_t>(i)];
+            addEvent(MidiEventList::Type::NoteOff, 0, key.note, 0, key.channel);
+        }
+
+        patternPosition = 0;
+        clockRunning = numHeldKeys > 0;
+        nextStepSample = 0.0;
+    }
+
+    stepSamples = getStepSamples(transport.bpm);
+    const bool synced = transport.isPlaying;
+
+    // On the song grid, the first step boundary at or after the block start, unless already played
+    juce::int64 gridStep = 0;
+    double gridStepSample = 0.0;
+    if (synced)
+    {
+        const double quarterNotes = rateQuarterNotes[static_cast<size_t>(rateIndex)];
+        gridStep = static_cast<juce::int64>(std::ceil(transport.ppqPosition / quarterNotes - 1.0e-9));
+        if (gridStep == lastGridStep)
+            ++gridStep;
+
+        gridStepSample = (static_cast<double>(gridStep) * quarterNotes - transport.ppqPosition)
+                       * sampleRate * 60.0 / transport.bpm;
+    }
+
+    auto nextEvent = events.begin();
+
+    for (;;)
+    {
+        while (nextEvent != events.end() && !isNote(*nextEvent))
+            ++nextEvent;
+
+        const int keySample = nextEvent != events.end() ? nextEvent->sample : never;
+        const int gateSample = numSoundingNotes > 0 ? toSample(gateEndSample) : never;
+        const int stepSample = synced ? (numHeldKeys > 0 ? toSample(gridStepSample) : never)
+                                      : (clockRunning ? toSample(nextStepSample) : never);
+
+        const int sample = juce::jmin(keySample, gateSample, stepSample);
+        if (sample >= numSamples)
+            break;
+
+        // At a shared sample the last notes end first, and a key pressed on a step joins it
+        if (gateSample == sample)
+        {
+            releaseSounding(sample);
+        }
+        else if (keySample == sample)
+        {
+            const bool wasIdle = numHeldKeys == 0;
+            handleKey(*nextEvent++);
+
+            if (wasIdle && numHeldKeys > 0)
+            {
+                patternPosition = 0;
+                if (!clockRunning)
+                {
+                    clockRunning = true;
+                    nextStepSample = sample;
+                }
+            }
+        }
+        else
+        {
+            playStep(sample);
+
+            if (synced)
+            {
+                lastGridStep = gridStep++;
+                gridStepSample += stepSamples;
+
+                // The free clock carries on from here should the host stop
+                nextStepSample = sample + stepSamples;
+            }
+            else
+            {
+                nextStepSample += stepSamples;
+            }
+        }
+    }
+
+    nextStepSample -= numSamples;
+    gateEndSample -= numSamples;
+
+    events.replaceNotes(generated.data(), numGenerated);
+}
+
+bool Arpeggiator::updateFromParameters() noexcept
+{
+    const int modeIndex = juce::jlimit(0, static_cast<int>(Mode::Count) - 1, static_cast<int>(modeHandle->load()));
+    const auto newMode = static_cast<Mode>(modeIndex);
+    const bool switched = (newMode == Mode::Off) != (mode == Mode::Off);
+    mode = newMode;
+
+    rateIndex = juce::jlimit(0, static_cast<int>(rateQuarterNotes.size()) - 1, static_cast<int>(rateHandle->load()));
+    octaves = juce::jlimit(1, maxOctaves, static_cast<int>(octavesHandle->load()));
+    gate = juce::jlimit(0.05f, 1.0f, gateHandle->load());
+    numSteps = juce::jlimit(1, maxSteps, static_cast<int>(numStepsHandle->load()));
+
+    for (size_t i = 0; i < stepOffsets.size(); ++i)
+        stepOffsets[i] = juce::jlimit(-maxStepOffset, maxStepOffset, juce::roundToInt(stepHandles[i]->load()));
+
+    return switched;
+}
+
+void Arpeggiator::handleKey(const MidiEventList::Event& event) noexcept
+{
+    const auto findIn = [this, &event](const std::array<Key, numMidiNotes>& keys)
+        {
+            for (int i = 0; i < numHeldKeys; ++i)
+                if (keys[static_cast<size_t>(i)].note == event.number)
+                    return i;
+
+            return -1;
+        };
+
+    const int held = findIn(heldKeys);
+    const int sorted = findIn(sortedKeys);
+
+    if (event.type == MidiEventList::Type::NoteOn)
+    {
+        const Key key{ event.number, event.channel, event.value };
+
+        // A key pressed again keeps its place and takes the new velocity
+        if (held >= 0)
+        {
+            heldKeys[static_cast<size_t>(held)] = key;
+            sortedKeys[static_cast<size_t>(sorted)] = key;
+            return;
+        }
+
+        if (numHeldKeys == numMidiNotes)
+            return;
+
+        heldKeys[static_cast<size_t>(numHeldKeys)] = key;
+
+        int insert = numHeldKeys;
+        for (; insert > 0 && sortedKeys[static_cast<size_t>(insert - 1)].note > key.note; --insert)
+            sortedKeys[static_cast<size_t>(insert)] = sortedKeys[static_cast<size_t>(insert - 1)];
+
+        sortedKeys[static_cast<size_t>(insert)] = key;
+        ++numHeldKeys;
+        return;
+    }
+
+    if (held < 0)
+        return;
+
+    std::copy(heldKeys.begin() + held + 1, heldKeys.begin() + numHeldKeys, heldKeys.begin() + held);
+    std::copy(sortedKeys.begin() + sorted + 1, sortedKeys.begin() + numHeldKeys, sortedKeys.begin() + sorted);
+    --numHeldKeys;
+}
+
+void Arpeggiator::playStep(int sample) noexcept
+{
+    releaseSounding(sample);
+
+    // With every key up the pattern ends here, and a new key restarts it
+    if (numHeldKeys == 0)
+    {
+        clockRunning = false;
+        return;
+    }
+
+    const auto start = [this, sample](const Key& key, int note)
+        {
+            // Keep room for the note-offs of everything sounding, this note included
+            if (note < 0 || note >= numMidiNotes || numGenerated + numSoundingNotes + 2 > maxEventsPerBlock)
+                return;
+
+            addEvent(MidiEventList::Type::NoteOn, sample, note, key.velocity, key.channel);
+            soundingNotes[static_cast<size_t>(numSoundingNotes++)] = { static_cast<uint8_t>(note), key.channel, key.velocity };
+        };
+
+    if (mode == Mode::Sequence)
+    {
+        const int offset = stepOffsets[static_cast<size_t>(patternPosition % numSteps)];
+        for (int i = 0; i < numHeldKeys; ++i)
+            start(sortedKeys[static_cast<size_t>(i)], sortedKeys[static_cast<size_t>(i)].note + offset);
+    }
+    else
+    {
+        int octave = 0;
+        const auto& key = getPatternKey(patternPosition, octave);
+        start(key, key.note + 12 * octave);
+    }
+
+    patternPosition = (patternPosition + 1) & std::numeric_limits<int>::max();
+    gateEndSample = sample + juce::jmax(1.0, gate * stepSamples);
+}
+
+void Arpeggiator::releaseSounding(int sample) noexcept
+{
+    for (int i = 0; i < numSoundingNotes; ++i)
+    {
+        const auto& note = soundingNotes[static_cast<size_t>(i)];
+        addEvent(MidiEventList::Type::NoteOff, sample, note.note, 0, note.channel);
+    }
+
+    numSoundingNotes = 0;
+}
+
+bool Arpeggiator::addEvent(MidiEventList::Type type, int sample, int note, uint16_t velocity, uint8_t channel) noexcept
+{
+    if (numGenerated == maxEventsPerBlock)
+        return false;
+
+    auto& event = generated[static_cast<size_t>(numGenerated++)];
+    event.sample = sample;
+    event.type = type;
+    event.channel = channel;
+    event.number = static_cast<uint8_t>(note);
+    event.value = velocity;
+    return true;
+}
+
+double Arpeggiator::getStepSamples(double bpm) const noexcept
+{
+    jassert(bpm > 0.0);
+    return juce::jmax(1.0, rateQuarterNotes[static_cast<size_t>(rateIndex)] * sampleRate * 60.0 / bpm);
+}
+
+const Arpeggiator::Key& Arpeggiator::getPatternKey(int position, int& octave) noexcept
+{
+    jassert(numHeldKeys > 0);
+
+    const int length = numHeldKeys * octaves;
+    int index = 0;
+
+    switch (mode)
+    {
+    case Mode::Down:
+        index = length - 1 - position % length;
+        break;
+
+    case Mode::UpDown:
+    {
+        // Ping-pong over the pattern, the turning notes played once
+        const int period = juce::jmax(1, 2 * length - 2);
+        const int phase = position % period;
+        index = phase < length ? phase : period - phase;
+        break;
+    }
+
+    case Mode::Random:
+        index = juce::jmin(length - 1, static_cast<int>(random.nextUnipolar() * static_cast<float>(length)));
+        break;
+
+    default:
+        index = position % length;
+        break;
+    }
+
+    octave = index / numHeldKeys;
+    const auto& keys = mode == Mode::AsPlayed ? heldKeys : sortedKeys;
+    return keys[static_cast<size_t>(index % numHeldKeys)];
+}
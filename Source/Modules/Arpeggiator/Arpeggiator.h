@@ -0,0 +1,211 @@
+#pragma once
+
+#include "../../Common.h"
+#include "../LFO/LFO.h"
+#include "../MidiEventList/MidiEventList.h"
+#include "../NoiseGenerator/NoiseGenerator.h"
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * @class Arpeggiator
+ * @brief Tempo-synced arpeggiator and step sequencer that plays the held keys.
+ *
+ * Once per block, right after the MIDI is decoded, the arpeggiator takes the
+ * keys out of the event list and puts its own notes in their place, at the
+ * sample positions of this block's steps. The render loop then handles them
+ * like played notes, so nothing reaches a MidiBuffer and only the steps'
+ * note-ons split the block.
+ *
+ * While the host plays, steps lie on the song's grid of the RATE division;
+ * otherwise the clock starts at the first key pressed. The Up, Down, Up/Down,
+ * As Played and Random modes walk the held keys over OCTAVES octaves, one
+ * note per step. Sequence plays every held key each step, transposed by
+ * that step's offset, over the first STEPS steps. Every note lasts GATE of
+ * its step.
+ */
+class Arpeggiator
+{
+public:
+    /**
+     * @enum Mode
+     * @brief Order the held keys are played in, or Off to pass them through.
+     */
+    enum class Mode
+    {
+        Off,       ///< Keys play as usual
+        Up,        ///< Lowest to highest, octave by octave
+        Down,      ///< Highest to lowest, octave by octave
+        UpDown,    ///< Up, then down without repeating the ends
+        AsPlayed,  ///< In the order the keys were pressed
+        Random,    ///< Any held key in any octave, from a fixed seed
+        Sequence,  ///< Every held key, transposed by the step's offset
+        Count
+    };
+
+    static constexpr int maxSteps = 16;             ///< Steps of the sequencer
+    static constexpr int maxOctaves = 4;            ///< Widest octave range
+    static constexpr int maxStepOffset = 24;        ///< Largest step transposition in semitones
+    static constexpr int maxEventsPerBlock = 512;   ///< Notes generated per block at most
+
+    /**
+     * @brief Constructs the arpeggiator and resolves its parameter handles.
+     * @param apvts Reference to the AudioProcessorValueTreeState.
+     */
+    explicit Arpeggiator(juce::AudioProcessorValueTreeState& apvts);
+
+    /**
+     * @brief Returns the mode parameter spec.
+     */
+    static ComboBoxParamSpecs getModeParamSpecs();
+
+    /**
+     * @brief Returns the step rate parameter spec, note divisions of the tempo.
+     */
+    static ComboBoxParamSpecs getRateParamSpecs();
+
+    /**
+     * @brief Returns the octave range parameter spec.
+     */
+    static KnobParamSpecs getOctavesParamSpecs();
+
+    /**
+     * @brief Returns the gate parameter spec, the fraction of a step a note lasts.
+     */
+    static KnobParamSpecs getGateParamSpecs();
+
+    /**
+     * @brief Returns the parameter spec of the number of sequencer steps played.
+     */
+    static KnobParamSpecs getNumStepsParamSpecs();
+
+    /**
+     * @brief Returns the transposition parameter spec of a sequencer step, in semitones.
+     * @param step Step index, 0 to maxSteps - 1.
+     */
+    static KnobParamSpecs getStepParamSpecs(int step);
+
+    /**
+     * @brief Adds the mode, rate, octave, gate and sequencer parameters to the APVTS layout.
+     * @param layout The parameter layout to append to.
+     */
+    static void addParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout);
+
+    /**
+     * @brief Sets the sample rate and forgets every key. Not real-time safe.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Forgets every key and note and restarts the clock and the random sequence.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Offsets the seed of the Random mode. Takes effect at the next reset(), 0 is the built-in seed.
+     */
+    void setSeedOffset(uint32_t offset) noexcept;
+
+    /**
+     * @brief Reads the parameters and replaces the block's keys by the arpeggiated notes.
+     *
+     * Audio thread, once per block before anything walks the events. With
+     * the mode Off the keys are only tracked, so switching on mid-chord picks
+     * them up; switching either way releases what the other side played.
+     *
+     * @param events The block's decoded MIDI, rewritten in place.
+     * @param transport Host tempo and position at the start of the block.
+     * @param numSamples Block length.
+     */
+    void process(MidiEventList& events, const LFO::Transport& transport, int numSamples);
+
+private:
+    /**
+     * @struct Key
+     * @brief A held key.
+     */
+    struct Key
+    {
+        uint8_t note = 0;         ///< Incoming MIDI note number
+        uint8_t channel = 1;      ///< MIDI channel it was played on
+        uint16_t velocity = 0;    ///< Note-on velocity, 0 to 127
+    };
+
+    static constexpr int numMidiNotes = 128;        ///< Keys that can be held
+    static constexpr uint32_t randomSeed = 0x41525031u; ///< Seed of the Random mode, restored by reset() plus seedOffset
+
+    /**
+     * @brief Reads the parameters. Returns true if the mode switched between Off and on.
+     */
+    bool updateFromParameters() noexcept;
+
+    /**
+     * @brief Records a key press or release.
+     */
+    void handleKey(const MidiEventList::Event& event) noexcept;
+
+    /**
+     * @brief Releases the previous step and starts the notes of the next one.
+     * @param sample Position of the step in the block.
+     */
+    void playStep(int sample) noexcept;
+
+    /**
+     * @brief Ends every note the arpeggiator started.
+     */
+    void releaseSounding(int sample) noexcept;
+
+    /**
+     * @brief Appends a generated note event, returns false once the block is full.
+     */
+    bool addEvent(MidiEventList::Type type, int sample, int note, uint16_t velocity, uint8_t channel) noexcept;
+
+    /**
+     * @brief Returns the length of a step in samples at a tempo.
+     */
+    double getStepSamples(double bpm) const noexcept;
+
+    /**
+     * @brief Returns the key and octave the pattern plays at a position.
+     * @param position Steps played since the keys were first pressed.
+     * @param octave Receives the octave above the key.
+     */
+    const Key& getPatternKey(int position, int& octave) noexcept;
+
+    std::array<Key, numMidiNotes> heldKeys{};           ///< Held keys in the order they were pressed
+    std::array<Key, numMidiNotes> sortedKeys{};         ///< Held keys from lowest to highest
+    int numHeldKeys = 0;                                ///< Entries in heldKeys and sortedKeys
+
+    std::array<Key, numMidiNotes> soundingNotes{};      ///< Notes started by the last step, note after transposition
+    int numSoundingNotes = 0;                           ///< Entries in soundingNotes
+
+    std::array<MidiEventList::Event, maxEventsPerBlock> generated{}; ///< Notes of the current block
+    int numGenerated = 0;                               ///< Entries in generated
+
+    double sampleRate = 44100.0;                        ///< Current sample rate
+    double stepSamples = 1.0;                           ///< Length of a step in the current block, in samples
+    double nextStepSample = 0.0;                        ///< Free-running position of the next step, from the block start
+    double gateEndSample = 0.0;                         ///< Position the sounding notes end at, from the block start
+    juce::int64 lastGridStep = -1;                      ///< Last song grid step played, so a boundary plays once
+    bool clockRunning = false;                          ///< True from the first key until a step finds none held
+    int patternPosition = 0;                            ///< Steps played since the keys were first pressed
+
+    Mode mode = Mode::Off;                              ///< Current mode
+    int rateIndex = 0;                                  ///< Current step division
+    int octaves = 1;                                    ///< Current octave range
+    float gate = 0.5f;                                  ///< Current gate, fraction of a step
+    int numSteps = 8;                                   ///< Current number of sequencer steps
+    std::array<int, maxSteps> stepOffsets{};            ///< Current step transpositions in semitones
+
+    NoiseGenerator random{ randomSeed };                ///< Source of the Random mode
+    uint32_t seedOffset = 0;                            ///< Added to randomSeed by reset()
+
+    std::atomic<float>* modeHandle = nullptr;           ///< Cached handle of the mode parameter
+    std::atomic<float>* rateHandle = nullptr;           ///< Cached handle of the rate parameter
+    std::atomic<float>* octavesHandle = nullptr;        ///< Cached handle of the octave parameter
+    std::atomic<float>* gateHandle = nullptr;           ///< Cached handle of the gate parameter
+    std::atomic<float>* numStepsHandle = nullptr;       ///< Cached handle of the step count parameter
+    std::array<std::atomic<float>*, maxSteps> stepHandles{}; ///< Cached handles of the step transpositions
+
+    JUCE_DECLARE_NON_COPYABLE(Arpeggiator)
+};
@@ -95,6 +95,14 @@ void ComboBox::drawTintedDrawable(juce::Graphics& g, const juce::Drawable* drawa
     if (drawable == nullptr)
         return;
 
+    // Bitmap icons are tinted straight from their cached image, without a scratch image per paint
+    if (auto* drawableImage = dynamic_cast<const juce::DrawableImage*>(drawable))
+    {
+        g.setColour(tintColor);
+        g.drawImage(drawableImage->getImage(), bounds.toFloat(), juce::RectanglePlacement::centred, true);
+        return;
+    }
+
     juce::Image tempImage(juce::Image::ARGB, bounds.getWidth(), bounds.getHeight(), true);
     juce::Graphics tempG(tempImage);
 
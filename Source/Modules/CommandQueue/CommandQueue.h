@@ -0,0 +1,103 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class CommandQueue
+ * @brief Bounded lock-free multi-producer/single-consumer queue of small commands.
+ *
+ * Any thread may push, including the audio thread and host automation threads.
+ * A single consumer, usually the message thread, pops. Every cell carries a
+ * sequence number, so a producer claims a cell with one compare-and-swap and
+ * neither side ever waits for the other. Nothing allocates after construction.
+ *
+ * @tparam Command Trivially copyable command type.
+ * @tparam capacity Number of cells, a power of two.
+ */
+template <typename Command, int capacity>
+class CommandQueue
+{
+public:
+    static_assert(capacity > 1 && (capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<Command>, "commands are copied between threads");
+
+    /**
+     * @brief Constructs an empty queue.
+     */
+    CommandQueue()
+    {
+        for (int i = 0; i < capacity; ++i)
+            cells[i].sequence.store(static_cast<size_t>(i), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Appends a command. Safe to call from any thread.
+     * @param command The command to append.
+     * @return False if the queue is full and the command was dropped.
+     */
+    bool push(const Command& command) noexcept
+    {
+        size_t position = writePosition.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = cells[position & mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0)
+            {
+                if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.command = command;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false; // The consumer has not freed this cell yet
+            }
+            else
+            {
+                position = writePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest command. Consumer thread only.
+     * @param command Receives the command.
+     * @return False if no complete command is waiting.
+     */
+    bool pop(Command& command) noexcept
+    {
+        auto& cell = cells[readPosition & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != readPosition + 1)
+            return false;
+
+        command = cell.command;
+        cell.sequence.store(readPosition + capacity, std::memory_order_release);
+        ++readPosition;
+        return true;
+    }
+
+private:
+    /**
+     * @struct Cell
+     * @brief One queue entry and the sequence number marking whose turn it is.
+     */
+    struct Cell
+    {
+        std::atomic<size_t> sequence{ 0 }; ///< position while free, position + 1 once written
+        Command command{};                 ///< Payload
+    };
+
+    static constexpr size_t mask = static_cast<size_t>(capacity - 1); ///< Wraps positions to cell indices
+
+    std::array<Cell, capacity> cells;          ///< Ring of cells
+    std::atomic<size_t> writePosition{ 0 };    ///< Next position a producer claims
+    size_t readPosition = 0;                   ///< Next position the consumer reads
+
+    JUCE_DECLARE_NON_COPYABLE(CommandQueue)
+};
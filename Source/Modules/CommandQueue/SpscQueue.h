@@ -0,0 +1,69 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class SpscQueue
+ * @brief Bounded wait-free single-producer/single-consumer queue of small items.
+ *
+ * One thread pushes and one other thread pops. Either side finishes in a fixed
+ * number of steps, one load and one store of the other side's position, so
+ * neither can be held up however the threads are scheduled. Use CommandQueue
+ * when several threads push. Nothing allocates after construction.
+ *
+ * @tparam Item Trivially copyable item type.
+ * @tparam capacity Number of slots, a power of two.
+ */
+template <typename Item, int capacity>
+class SpscQueue
+{
+public:
+    static_assert(capacity > 1 && (capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<Item>, "items are copied between threads");
+
+    /**
+     * @brief Constructs an empty queue.
+     */
+    SpscQueue() = default;
+
+    /**
+     * @brief Appends an item. Producer thread only.
+     * @param item The item to append.
+     * @return False if the queue is full and the item was dropped.
+     */
+    bool push(const Item& item) noexcept
+    {
+        const size_t position = writePosition.load(std::memory_order_relaxed);
+        if (position - readPosition.load(std::memory_order_acquire) == static_cast<size_t>(capacity))
+            return false;
+
+        items[position & mask] = item;
+        writePosition.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item. Consumer thread only.
+     * @param item Receives the item.
+     * @return False if the queue is empty.
+     */
+    bool pop(Item& item) noexcept
+    {
+        const size_t position = readPosition.load(std::memory_order_relaxed);
+        if (position == writePosition.load(std::memory_order_acquire))
+            return false;
+
+        item = items[position & mask];
+        readPosition.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr size_t mask = static_cast<size_t>(capacity - 1); ///< Wraps positions to slot indices
+
+    std::array<Item, capacity> items{};                    ///< Ring of slots
+    alignas(64) std::atomic<size_t> writePosition{ 0 };    ///< Next position the producer writes, on its own cache line
+    alignas(64) std::atomic<size_t> readPosition{ 0 };     ///< Next position the consumer reads, on its own cache line
+
+    JUCE_DECLARE_NON_COPYABLE(SpscQueue)
+};
@@ -0,0 +1,88 @@
+#include "DspLoadIndicator.h"
+
+DspLoadIndicator::DspLoadIndicator(DspLoadMeter& meterIn, const QualityGovernor& governorIn)
+    : meter(meterIn), governor(governorIn)
+{
+    refreshScheduler->add(this);
+}
+
+DspLoadIndicator::~DspLoadIndicator()
+{
+    refreshScheduler->remove(this);
+}
+
+void DspLoadIndicator::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds();
+    g.fillAll(UI::Colors::VolumeMeterBackground);
+    g.setColour(UI::Colors::VolumeMeterText);
+
+    const auto toPercent = [](float value)
+        {
+            return juce::String(juce::roundToInt(value * 100.0f)) + "%";
+        };
+
+    auto header = bounds.removeFromTop(16).reduced(8, 0);
+    g.setFont(juce::Font(UI::Fonts::defaultFontSize));
+    g.drawText("DSP", header, juce::Justification::centredLeft);
+    if (qualityLevel > 0)
+        g.drawText("Eco " + juce::String(qualityLevel), header, juce::Justification::centred);
+    g.drawText(toPercent(load), header, juce::Justification::centredRight);
+
+    auto bar = bounds.removeFromTop(10).reduced(8, 1).toFloat();
+    g.setColour(UI::Colors::VolumeMeterBarBackground);
+    g.fillRect(bar);
+
+    const juce::Colour barColour = overruns > 0 ? juce::Colours::red
+                                 : load >= warningLoad ? juce::Colours::yellow
+                                 : juce::Colours::green;
+    g.setColour(barColour);
+    g.fillRect(bar.withWidth(bar.getWidth() * juce::jlimit(0.0f, 1.0f, load)));
+
+    // Peak marker
+    const float peakX = bar.getX() + bar.getWidth() * juce::jlimit(0.0f, 1.0f, peakLoad);
+    g.setColour(UI::Colors::VolumeMeterText);
+    g.drawLine(peakX, bar.getY(), peakX, bar.getBottom(), 2.0f);
+
+    auto footer = bounds.reduced(8, 2);
+    g.setFont(9.0f);
+    g.drawText("Peak " + toPercent(peakLoad), footer, juce::Justification::centredLeft);
+
+    g.setColour(overruns > 0 ? juce::Colours::red : UI::Colors::VolumeMeterText);
+    g.drawText("Xruns " + juce::String(overruns), footer, juce::Justification::centredRight);
+}
+
+void DspLoadIndicator::mouseDown(const juce::MouseEvent&)
+{
+    meter.resetPeaks();
+    refresh();
+}
+
+void DspLoadIndicator::refresh()
+{
+    const float latestLoad = meter.getLoad();
+    const float latestPeak = meter.getPeakLoad();
+    const int latestOverruns = meter.getNumOverruns();
+    const int latestLevel = governor.getLevel();
+
+    // Whole percent steps are all the readout shows
+    if (juce::roundToInt(latestLoad * 100.0f) == juce::roundToInt(load * 100.0f)
+        && juce::roundToInt(latestPeak * 100.0f) == juce::roundToInt(peakLoad * 100.0f)
+        && latestOverruns == overruns
+        && latestLevel == qualityLevel)
+        return;
+
+    load = latestLoad;
+    peakLoad = latestPeak;
+    overruns = latestOverruns;
+    qualityLevel = latestLevel;
+    repaint();
+}
+
+void DspLoadIndicator::visibilityChanged()
+{
+    if (isVisible())
+        refreshScheduler->add(this);
+    else
+        refreshScheduler->remove(this);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../../Common.h"
+#include "../RefreshScheduler/RefreshScheduler.h"
+#include "DspLoadMeter.h"
+#include "QualityGovernor.h"
+#include <JuceHeader.h>
+
+/**
+ * @class DspLoadIndicator
+ * @brief Shows the audio callback's load, its peak and the blocks that overran, below the master meter.
+ *
+ * The bar turns yellow as the load nears the deadline and red once a block
+ * has overrun, and the quality governor's level shows while it is above full
+ * quality. Clicking the indicator clears the peak and the overrun count.
+ */
+class DspLoadIndicator : public juce::Component, private RefreshScheduler::Client
+{
+public:
+    static constexpr int height = 46; ///< Preferred height in pixels.
+
+    /**
+     * @brief Constructs the indicator.
+     * @param meter The processor's load meter.
+     * @param governor The processor's quality governor.
+     */
+    DspLoadIndicator(DspLoadMeter& meter, const QualityGovernor& governor);
+
+    /**
+     * @brief Leaves the refresh scheduler.
+     */
+    ~DspLoadIndicator() override;
+
+    /**
+     * @brief Draws the load bar and the peak and overrun readouts.
+     * @param g JUCE graphics context
+     */
+    void paint(juce::Graphics& g) override;
+
+    /**
+     * @brief Clears the peak load and the overrun count.
+     */
+    void mouseDown(const juce::MouseEvent& event) override;
+
+private:
+    static constexpr float warningLoad = 0.7f;  ///< Load from which the bar turns yellow
+
+    DspLoadMeter& meter;                        ///< The processor's load meter
+    const QualityGovernor& governor;            ///< The processor's quality governor
+
+    float load = 0.0f;                          ///< Smoothed load at the last tick
+    float peakLoad = 0.0f;                      ///< Peak load at the last tick
+    int overruns = 0;                           ///< Overrun count at the last tick
+    int qualityLevel = 0;                       ///< Governor level at the last tick
+
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler; ///< Shared UI refresh tick.
+
+    /**
+     * @brief Shared refresh tick, repaints when a reading changed.
+     */
+    void refresh() override;
+
+    /**
+     * @brief Registers with the scheduler while shown only.
+     */
+    void visibilityChanged() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspLoadIndicator)
+};
@@ -0,0 +1,67 @@
+#include "DspLoadMeter.h"
+
+DspLoadMeter::ScopedMeasurement::ScopedMeasurement(DspLoadMeter& meterIn, int numSamplesIn) noexcept
+    : meter(meterIn), numSamples(numSamplesIn), start(juce::Time::getHighResolutionTicks())
+{
+}
+
+DspLoadMeter::ScopedMeasurement::~ScopedMeasurement()
+{
+    meter.addBlock(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start), numSamples);
+}
+
+void DspLoadMeter::prepare(double newSampleRate)
+{
+    jassert(newSampleRate > 0.0);
+    sampleRate = newSampleRate;
+    smoothedLoad = 0.0f;
+
+    load.store(0.0f);
+    resetPeaks();
+}
+
+void DspLoadMeter::addBlock(double seconds, int numSamples) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    // Hosts may call with fewer samples than prepared, the deadline follows the actual block
+    const double deadline = numSamples / sampleRate;
+    const auto blockLoad = static_cast<float>(seconds / deadline);
+
+    // Frame-rate independent smoothing, a block's weight grows with the time it covers
+    const auto weight = static_cast<float>(1.0 - std::exp(-deadline / smoothingSeconds));
+    smoothedLoad += weight * (blockLoad - smoothedLoad);
+    load.store(smoothedLoad, std::memory_order_relaxed);
+
+    // resetPeaks() may store concurrently, only ever raise what is there
+    float previousPeak = peakLoad.load(std::memory_order_relaxed);
+    while (blockLoad > previousPeak
+           && !peakLoad.compare_exchange_weak(previousPeak, blockLoad, std::memory_order_relaxed))
+    {
+    }
+
+    if (blockLoad > 1.0f)
+        overruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+float DspLoadMeter::getLoad() const noexcept
+{
+    return load.load(std::memory_order_relaxed);
+}
+
+float DspLoadMeter::getPeakLoad() const noexcept
+{
+    return peakLoad.load(std::memory_order_relaxed);
+}
+
+int DspLoadMeter::getNumOverruns() const noexcept
+{
+    return overruns.load(std::memory_order_relaxed);
+}
+
+void DspLoadMeter::resetPeaks() noexcept
+{
+    peakLoad.store(0.0f, std::memory_order_relaxed);
+    overruns.store(0, std::memory_order_relaxed);
+}
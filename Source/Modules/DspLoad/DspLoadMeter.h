@@ -0,0 +1,96 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class DspLoadMeter
+ * @brief Measures how much of each block's deadline the audio callback uses.
+ *
+ * The audio thread times every processBlock call and compares it with the
+ * time the block covers, numSamples / sampleRate. The smoothed load, the
+ * peak load and the number of blocks that overran their deadline are kept in
+ * atomics, so the UI reads them without locking.
+ */
+class DspLoadMeter
+{
+public:
+    /**
+     * @class ScopedMeasurement
+     * @brief Times the scope it lives in as one audio callback.
+     */
+    class ScopedMeasurement
+    {
+    public:
+        /**
+         * @brief Starts timing a block.
+         * @param meter Meter to report to.
+         * @param numSamples Samples in the block, which set its deadline.
+         */
+        ScopedMeasurement(DspLoadMeter& meter, int numSamples) noexcept;
+
+        /**
+         * @brief Reports the block's duration to the meter.
+         */
+        ~ScopedMeasurement();
+
+    private:
+        DspLoadMeter& meter;       ///< Meter to report to
+        int numSamples;            ///< Samples in the block
+        juce::int64 start;         ///< High resolution ticks at entry
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedMeasurement)
+    };
+
+    /**
+     * @brief Constructs an idle meter.
+     */
+    DspLoadMeter() = default;
+
+    /**
+     * @brief Sets the sample rate deadlines are derived from and clears every reading.
+     *
+     * Call from prepareToPlay(), never while the audio thread is running.
+     *
+     * @param sampleRate Sample rate in Hz.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Adds one block to the readings. Audio thread only.
+     * @param seconds Time the callback took.
+     * @param numSamples Samples in the block.
+     */
+    void addBlock(double seconds, int numSamples) noexcept;
+
+    /**
+     * @brief Returns the smoothed load, 1.0 being a callback that takes its whole deadline.
+     */
+    float getLoad() const noexcept;
+
+    /**
+     * @brief Returns the largest load of a single block since the last reset.
+     */
+    float getPeakLoad() const noexcept;
+
+    /**
+     * @brief Returns how many blocks took longer than their deadline since the last reset.
+     */
+    int getNumOverruns() const noexcept;
+
+    /**
+     * @brief Clears the peak load and the overrun count. Safe from any thread.
+     */
+    void resetPeaks() noexcept;
+
+private:
+    static constexpr double smoothingSeconds = 0.3; ///< Time constant of the smoothed load
+
+    double sampleRate = 44100.0;                    ///< Sample rate deadlines are derived from
+    float smoothedLoad = 0.0f;                      ///< Audio thread copy of the smoothed load
+
+    std::atomic<float> load{ 0.0f };                ///< Smoothed load, published per block
+    std::atomic<float> peakLoad{ 0.0f };            ///< Largest block load since the last reset
+    std::atomic<int> overruns{ 0 };                 ///< Blocks over their deadline since the last reset
+
+    JUCE_DECLARE_NON_COPYABLE(DspLoadMeter)
+};
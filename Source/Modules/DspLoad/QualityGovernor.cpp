@@ -0,0 +1,81 @@
+#include "QualityGovernor.h"
+
+// Detune shimmer and modulation resolution go first, table interpolation last
+const std::array<QualityGovernor::Limits, QualityGovernor::numLevels> QualityGovernor::levels{ {
+    { 16, true,  true,  32  },
+    { 8,  true,  true,  64  },
+    { 4,  false, true,  64  },
+    { 2,  false, false, 128 },
+    { 1,  false, false, 256 }
+} };
+
+// Oversampling choice 1 is 2x, so filters bounce at 2x or at the higher factor they are set to
+const QualityGovernor::Limits QualityGovernor::offlineLimits{ 16, true, true, 8, true, 1 };
+
+void QualityGovernor::prepare(double newSampleRate)
+{
+    jassert(newSampleRate > 0.0);
+    sampleRate = newSampleRate;
+    secondsOverloaded = secondsRelaxed = 0.0;
+    currentLevel = 0;
+    publishedLevel.store(0);
+}
+
+void QualityGovernor::setEnabled(bool shouldBeEnabled) noexcept
+{
+    enabled.store(shouldBeEnabled);
+}
+
+bool QualityGovernor::isEnabled() const noexcept
+{
+    return enabled.load();
+}
+
+void QualityGovernor::setHighQualityOffline(bool shouldBeEnabled) noexcept
+{
+    highQualityOffline.store(shouldBeEnabled);
+}
+
+bool QualityGovernor::isHighQualityOffline() const noexcept
+{
+    return highQualityOffline.load();
+}
+
+void QualityGovernor::update(float load, int numSamples) noexcept
+{
+    if (!enabled.load(std::memory_order_relaxed))
+    {
+        secondsOverloaded = secondsRelaxed = 0.0;
+        currentLevel = 0;
+        publishedLevel.store(0, std::memory_order_relaxed);
+        return;
+    }
+
+    const double seconds = numSamples / sampleRate;
+    secondsOverloaded = (load > degradeLoad) ? secondsOverloaded + seconds : 0.0;
+    secondsRelaxed = (load < restoreLoad) ? secondsRelaxed + seconds : 0.0;
+
+    // Both timers restart after a step, so the smoothed load settles at the new level first
+    if (secondsOverloaded >= degradeSeconds && currentLevel < numLevels - 1)
+    {
+        ++currentLevel;
+        secondsOverloaded = secondsRelaxed = 0.0;
+    }
+    else if (secondsRelaxed >= restoreSeconds && currentLevel > 0)
+    {
+        --currentLevel;
+        secondsOverloaded = secondsRelaxed = 0.0;
+    }
+
+    publishedLevel.store(currentLevel, std::memory_order_relaxed);
+}
+
+const QualityGovernor::Limits& QualityGovernor::getLimits() const noexcept
+{
+    return levels[static_cast<size_t>(currentLevel)];
+}
+
+int QualityGovernor::getLevel() const noexcept
+{
+    return publishedLevel.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class QualityGovernor
+ * @brief Trades rendering quality for CPU time while the audio callback nears its deadline.
+ *
+ * Fed the smoothed load of the DspLoadMeter once per rendered block, the
+ * governor steps down one quality level at a time while the load stays above
+ * a threshold, and steps back up once it has stayed well below it for a while.
+ * Each level caps a cost the processor hands to its modules:
+ * - the unison voices an Oscillator renders
+ * - filter oversampling
+ * - linear or truncated wavetable reads
+ * - the sub-block length modulation is applied at
+ *
+ * Offline renders are never degraded; the processor only consults the
+ * governor while running in real time. With high quality offline renders
+ * enabled, a bounce goes the other way and uses the offline limits, which
+ * spend more than full quality: cubic table reads, at least 2x filter
+ * oversampling and modulation applied every few samples.
+ */
+class QualityGovernor
+{
+public:
+    /**
+     * @struct Limits
+     * @brief The costs allowed at one quality level.
+     */
+    struct Limits
+    {
+        int maxUnisonVoices = 16;         ///< Unison voices rendered per note at most
+        bool allowOversampling = true;    ///< False forces filters to run at the host rate
+        bool interpolateTables = true;    ///< False reads wavetables without interpolation
+        int modulationSubBlockSize = 32;  ///< Samples between modulation updates
+        bool cubicTables = false;         ///< True reads wavetables with cubic instead of linear interpolation
+        int minOversampling = 0;          ///< Filter oversampling choice used at least, 0 for the parameter's own
+    };
+
+    static constexpr int numLevels = 5;   ///< Quality levels, 0 being full quality
+
+    /** @brief Limits of high quality offline renders, above full quality. */
+    static const Limits offlineLimits;
+
+    /**
+     * @brief Constructs a governor at full quality.
+     */
+    QualityGovernor() = default;
+
+    /**
+     * @brief Sets the sample rate block durations are derived from and returns to full quality.
+     *
+     * Call from prepareToPlay(), never while the audio thread is running.
+     *
+     * @param sampleRate Sample rate in Hz.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Enables or disables the governor. Disabling returns to full quality at the next block.
+     * @param shouldBeEnabled True to scale quality with the load.
+     */
+    void setEnabled(bool shouldBeEnabled) noexcept;
+
+    /**
+     * @brief Returns true if the governor scales quality with the load.
+     */
+    bool isEnabled() const noexcept;
+
+    /**
+     * @brief Enables or disables the offline limits for renders the host runs offline.
+     * @param shouldBeEnabled True to render bounces above full quality.
+     */
+    void setHighQualityOffline(bool shouldBeEnabled) noexcept;
+
+    /**
+     * @brief Returns true if offline renders use the offline limits.
+     */
+    bool isHighQualityOffline() const noexcept;
+
+    /**
+     * @brief Moves between levels according to the load. Audio thread only.
+     * @param load Smoothed callback load, 1.0 being the whole deadline.
+     * @param numSamples Samples in the block about to be rendered.
+     */
+    void update(float load, int numSamples) noexcept;
+
+    /**
+     * @brief Returns the limits of the current level. Audio thread only.
+     */
+    const Limits& getLimits() const noexcept;
+
+    /**
+     * @brief Returns the current level, 0 being full quality. Safe from any thread.
+     */
+    int getLevel() const noexcept;
+
+private:
+    static constexpr float degradeLoad = 0.85f;     ///< Load above which quality steps down
+    static constexpr float restoreLoad = 0.55f;     ///< Load below which quality steps back up
+    static constexpr double degradeSeconds = 0.25;  ///< Time above degradeLoad before stepping down
+    static constexpr double restoreSeconds = 3.0;   ///< Time below restoreLoad before stepping up
+
+    /** @brief Limits per level, in the order they are given up. */
+    static const std::array<Limits, numLevels> levels;
+
+    double sampleRate = 44100.0;                    ///< Sample rate block durations are derived from
+    double secondsOverloaded = 0.0;                 ///< Time the load has stayed above degradeLoad
+    double secondsRelaxed = 0.0;                    ///< Time the load has stayed below restoreLoad
+    int currentLevel = 0;                           ///< Audio thread copy of the level
+
+    std::atomic<bool> enabled{ true };              ///< True if the governor may degrade quality
+    std::atomic<bool> highQualityOffline{ true };   ///< True if offline renders use the offline limits
+    std::atomic<int> publishedLevel{ 0 };           ///< Level for the UI
+
+    JUCE_DECLARE_NON_COPYABLE(QualityGovernor)
+};
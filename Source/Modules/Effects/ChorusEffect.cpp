@@ -0,0 +1,77 @@
+#include "ChorusEffect.h"
+#include "../FastMath/FastMath.h"
+
+void ChorusEffect::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    const int maxDelaySamples = static_cast<int>(std::ceil((baseDelayMs + maxDepthMs) * 0.001 * sampleRate)) + 2;
+    for (auto& line : lines)
+        line.prepare(maxDelaySamples);
+
+    reset();
+}
+
+void ChorusEffect::reset() noexcept
+{
+    for (auto& line : lines)
+        line.reset();
+
+    phase = 0.0f;
+}
+
+size_t ChorusEffect::getMemoryBytes() const noexcept
+{
+    size_t bytes = 0;
+    for (const auto& line : lines)
+        bytes += line.getMemoryBytes();
+
+    return bytes;
+}
+
+void ChorusEffect::setParameters(float rateHz, float depth) noexcept
+{
+    const float sampleRate = static_cast<float>(currentSampleRate);
+    phaseIncrement = juce::MathConstants<float>::twoPi * juce::jlimit(minRateHz, maxRateHz, rateHz) / sampleRate;
+    depthSamples = juce::jlimit(0.0f, 1.0f, depth) * maxDepthMs * 0.001f * sampleRate;
+}
+
+void ChorusEffect::process(float* const* channels, int numChannels, int numSamples, float mixFrom, float mixTo) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    const float mixStep = (mixTo - mixFrom) / static_cast<float>(numSamples);
+    const float centre = baseDelayMs * 0.001f * static_cast<float>(currentSampleRate);
+    const float swing = 0.5f * depthSamples;
+
+    for (int ch = 0; ch < juce::jmin(numChannels, 2); ++ch)
+    {
+        float* data = channels[ch];
+        auto& line = lines[static_cast<size_t>(ch)];
+        float mix = mixFrom;
+        float tapPhase = phase + static_cast<float>(ch) * juce::MathConstants<float>::halfPi;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            mix += mixStep;
+            tapPhase += phaseIncrement;
+
+            const float x = data[i];
+            line.push(x);
+
+            // Opposite taps: sin(p + pi) is -sin(p), one sine serves both
+            const float modulation = swing * FastMath::sin(tapPhase);
+            const float wet = 0.5f * (line.readFractional(centre + modulation) + line.readFractional(centre - modulation));
+
+            data[i] = x + mix * (wet - x);
+        }
+    }
+
+    phase = std::fmod(phase + phaseIncrement * static_cast<float>(numSamples), juce::MathConstants<float>::twoPi);
+}
+
+float ChorusEffect::getTailSeconds() noexcept
+{
+    return (baseDelayMs + maxDepthMs) * 0.001f;
+}
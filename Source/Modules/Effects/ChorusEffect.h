@@ -0,0 +1,69 @@
+#pragma once
+
+#include "DelayLine.h"
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * @class ChorusEffect
+ * @brief Two-voice stereo chorus on short modulated delays.
+ *
+ * Each channel reads two taps half a cycle apart, and the right channel's
+ * taps run a quarter cycle behind the left's. The taps' pitch wobble thus
+ * cancels out in the sum and stays subtle on unison stacks, which already
+ * carry their own detune.
+ */
+class ChorusEffect
+{
+public:
+    static constexpr float minRateHz = 0.05f;       ///< Slowest modulation rate
+    static constexpr float maxRateHz = 5.0f;        ///< Fastest modulation rate
+
+    /**
+     * @brief Sizes the delay lines for a sample rate. Not real-time safe.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Clears the delay lines.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Returns the bytes of delay storage prepare() allocated.
+     */
+    size_t getMemoryBytes() const noexcept;
+
+    /**
+     * @brief Sets the modulation rate and depth.
+     * @param rateHz Modulation rate in Hz.
+     * @param depth Modulation depth in [0, 1].
+     */
+    void setParameters(float rateHz, float depth) noexcept;
+
+    /**
+     * @brief Choruses a block in place, crossfading from the dry signal by the mix.
+     * @param channels Channel pointers.
+     * @param numChannels Number of channels, 1 or 2.
+     * @param numSamples Number of samples.
+     * @param mixFrom Mix at the start of the block.
+     * @param mixTo Mix at the end of the block.
+     */
+    void process(float* const* channels, int numChannels, int numSamples, float mixFrom, float mixTo) noexcept;
+
+    /**
+     * @brief Returns the longest delay a tap reads, the chorus tail.
+     */
+    static float getTailSeconds() noexcept;
+
+private:
+    static constexpr float baseDelayMs = 12.0f;     ///< Delay at the centre of the modulation
+    static constexpr float maxDepthMs = 6.0f;       ///< Delay swing at full depth
+
+    std::array<DelayLine, 2> lines;                 ///< Delay line per channel
+
+    double currentSampleRate = 44100.0;             ///< Prepared sample rate
+    float phaseIncrement = 0.0f;                    ///< Modulation phase step per sample
+    float depthSamples = 0.0f;                      ///< Delay swing in samples
+    float phase = 0.0f;                             ///< Modulation phase at the start of the next block
+};
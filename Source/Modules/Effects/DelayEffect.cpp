@@ -0,0 +1,94 @@
+#include "DelayEffect.h"
+#include "../FastMath/FastMath.h"
+
+void DelayEffect::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    const float wobbleSamples = wobbleMs * 0.001f * static_cast<float>(sampleRate);
+    const int maxDelaySamples = static_cast<int>(std::ceil(maxTimeMs * 0.001f * sampleRate + 2.0f * wobbleSamples)) + 2;
+    for (auto& line : lines)
+        line.prepare(maxDelaySamples);
+
+    dampingCoefficient = 1.0f - std::exp(-juce::MathConstants<float>::twoPi * dampingHz / static_cast<float>(sampleRate));
+    delaySamples = targetDelaySamples;
+    reset();
+}
+
+void DelayEffect::reset() noexcept
+{
+    for (auto& line : lines)
+        line.reset();
+
+    dampingState.fill(0.0f);
+    wobblePhase = 0.0f;
+    delaySamples = targetDelaySamples;
+}
+
+size_t DelayEffect::getMemoryBytes() const noexcept
+{
+    size_t bytes = 0;
+    for (const auto& line : lines)
+        bytes += line.getMemoryBytes();
+
+    return bytes;
+}
+
+void DelayEffect::setParameters(float timeMs, float feedback) noexcept
+{
+    targetDelaySamples = juce::jlimit(minTimeMs, maxTimeMs, timeMs) * 0.001f * static_cast<float>(currentSampleRate);
+    feedbackGain = juce::jlimit(0.0f, maxFeedback, feedback);
+}
+
+void DelayEffect::process(float* const* channels, int numChannels, int numSamples, float mixFrom, float mixTo) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    const float step = 1.0f / static_cast<float>(numSamples);
+    const float delayStep = (targetDelaySamples - delaySamples) * step;
+    const float mixStep = (mixTo - mixFrom) * step;
+    const float wobbleIncrement = juce::MathConstants<float>::twoPi * wobbleHz / static_cast<float>(currentSampleRate);
+    const float wobbleDepth = wobbleMs * 0.001f * static_cast<float>(currentSampleRate);
+
+    for (int ch = 0; ch < juce::jmin(numChannels, 2); ++ch)
+    {
+        float* data = channels[ch];
+        auto& line = lines[static_cast<size_t>(ch)];
+        float damping = dampingState[static_cast<size_t>(ch)];
+        float delay = delaySamples;
+        float mix = mixFrom;
+        float phase = wobblePhase + static_cast<float>(ch) * juce::MathConstants<float>::halfPi;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            delay += delayStep;
+            mix += mixStep;
+            phase += wobbleIncrement;
+
+            const float x = data[i];
+            const float delayed = line.readFractional(delay + wobbleDepth * (1.0f + FastMath::sin(phase)));
+
+            damping += dampingCoefficient * (delayed - damping);
+            line.push(x + feedbackGain * damping);
+
+            data[i] = x + mix * (delayed - x);
+        }
+
+        juce::dsp::util::snapToZero(damping);
+        dampingState[static_cast<size_t>(ch)] = damping;
+    }
+
+    delaySamples = targetDelaySamples;
+    wobblePhase = std::fmod(wobblePhase + wobbleIncrement * static_cast<float>(numSamples), juce::MathConstants<float>::twoPi);
+}
+
+float DelayEffect::getTailSeconds(float timeMs, float feedback) noexcept
+{
+    const float seconds = juce::jlimit(minTimeMs, maxTimeMs, timeMs) * 0.001f;
+    const float gain = juce::jlimit(0.0f, maxFeedback, feedback);
+
+    // Every pass through the loop scales the echo by the feedback gain
+    const float repeats = gain > 0.001f ? std::ceil(std::log(0.001f) / std::log(gain)) : 0.0f;
+    return seconds * (1.0f + repeats);
+}
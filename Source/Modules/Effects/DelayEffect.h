@@ -0,0 +1,75 @@
+#pragma once
+
+#include "DelayLine.h"
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * @class DelayEffect
+ * @brief Stereo feedback delay with a slow wobble on the delay time and a damped feedback path.
+ *
+ * The delay time ramps linearly to a new setting across a block, and the two
+ * channels wobble a quarter cycle apart, which widens the echoes without a
+ * separate ping-pong path.
+ */
+class DelayEffect
+{
+public:
+    static constexpr float minTimeMs = 1.0f;        ///< Shortest delay time
+    static constexpr float maxTimeMs = 2000.0f;     ///< Longest delay time
+    static constexpr float maxFeedback = 0.95f;     ///< Highest feedback gain
+
+    /**
+     * @brief Sizes the delay lines for a sample rate. Not real-time safe.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Clears the delay lines.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Returns the bytes of delay storage prepare() allocated.
+     */
+    size_t getMemoryBytes() const noexcept;
+
+    /**
+     * @brief Sets the delay time and the feedback, taking effect over the next block.
+     * @param timeMs Delay time in milliseconds.
+     * @param feedback Feedback gain in [0, maxFeedback].
+     */
+    void setParameters(float timeMs, float feedback) noexcept;
+
+    /**
+     * @brief Delays a block in place, crossfading from the dry signal by the mix.
+     * @param channels Channel pointers.
+     * @param numChannels Number of channels, 1 or 2.
+     * @param numSamples Number of samples.
+     * @param mixFrom Mix at the start of the block.
+     * @param mixTo Mix at the end of the block.
+     */
+    void process(float* const* channels, int numChannels, int numSamples, float mixFrom, float mixTo) noexcept;
+
+    /**
+     * @brief Returns how long echoes take to decay by 60 dB.
+     * @param timeMs Delay time in milliseconds.
+     * @param feedback Feedback gain.
+     */
+    static float getTailSeconds(float timeMs, float feedback) noexcept;
+
+private:
+    static constexpr float wobbleMs = 0.6f;         ///< Peak delay time deviation
+    static constexpr float wobbleHz = 0.4f;         ///< Rate of the deviation
+    static constexpr float dampingHz = 5000.0f;     ///< Corner of the feedback low-pass
+
+    std::array<DelayLine, 2> lines;                 ///< Delay line per channel
+    std::array<float, 2> dampingState{};            ///< Feedback low-pass state per channel
+
+    double currentSampleRate = 44100.0;             ///< Prepared sample rate
+    float delaySamples = 0.0f;                      ///< Delay reached at the end of the last block
+    float targetDelaySamples = 0.0f;                ///< Delay the next block ramps to
+    float feedbackGain = 0.0f;                      ///< Current feedback gain
+    float dampingCoefficient = 1.0f;                ///< One-pole coefficient of the feedback low-pass
+    float wobblePhase = 0.0f;                       ///< Phase of the delay time wobble
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * @class DelayLine
+ * @brief Power-of-two circular buffer with whole and fractional sample reads.
+ *
+ * The storage is sized once in prepare(), so pushing and reading never
+ * allocate; wrapping is a mask instead of a branch.
+ */
+class DelayLine
+{
+public:
+    /**
+     * @brief Allocates room for a delay. Not real-time safe.
+     * @param maxDelaySamples Longest delay that will be read.
+     */
+    void prepare(int maxDelaySamples)
+    {
+        const int size = juce::nextPowerOfTwo(juce::jmax(4, maxDelaySamples + 2));
+        buffer.assign(static_cast<size_t>(size), 0.0f);
+        mask = size - 1;
+        writeIndex = 0;
+    }
+
+    /**
+     * @brief Clears the stored samples.
+     */
+    void reset() noexcept
+    {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        writeIndex = 0;
+    }
+
+    /**
+     * @brief Returns the bytes of storage prepare() allocated.
+     */
+    size_t getMemoryBytes() const noexcept
+    {
+        return buffer.capacity() * sizeof(float);
+    }
+
+    /**
+     * @brief Appends a sample.
+     */
+    void push(float sample) noexcept
+    {
+        buffer[static_cast<size_t>(writeIndex)] = sample;
+        writeIndex = (writeIndex + 1) & mask;
+    }
+
+    /**
+     * @brief Returns the sample pushed delay samples ago, 1 being the last one.
+     */
+    float read(int delay) const noexcept
+    {
+        return buffer[static_cast<size_t>((writeIndex - delay) & mask)];
+    }
+
+    /**
+     * @brief Returns the signal delay samples ago, linearly interpolated.
+     * @param delay Delay in samples, at least 1.
+     */
+    float readFractional(float delay) const noexcept
+    {
+        const int whole = static_cast<int>(delay);
+        const float fraction = delay - static_cast<float>(whole);
+        const float a = read(whole);
+        return a + fraction * (read(whole + 1) - a);
+    }
+
+private:
+    std::vector<float> buffer;  ///< Circular storage, a power of two long
+    int mask = 0;               ///< Storage length minus one
+    int writeIndex = 0;         ///< Index the next sample is written to
+};
@@ -0,0 +1,179 @@
+#include "EffectsChain.h"
+
+EffectsChain::EffectsChain(juce::AudioProcessorValueTreeState& apvts)
+{
+    for (int i = 0; i < static_cast<int>(ParamID::Count); ++i)
+    {
+        const auto param = static_cast<ParamID>(i);
+        const auto toggle = getToggleParamSpecs(param);
+        const juce::String id = toggle.first.isNotEmpty() ? toggle.first : getKnobParamSpecs(param).id;
+
+        handles[static_cast<size_t>(i)] = apvts.getRawParameterValue(id);
+        jassert(handles[static_cast<size_t>(i)] != nullptr);
+    }
+}
+
+KnobParamSpecs EffectsChain::getKnobParamSpecs(ParamID param)
+{
+    using Format = FormattingUtils::FormatType;
+
+    switch (param)
+    {
+    case ParamID::ChorusRate:
+        return { "FX_CHORUS_RATE", "Chorus Rate", ChorusEffect::minRateHz, ChorusEffect::maxRateHz, 0.01f, 0.8f, Format::Normal };
+    case ParamID::ChorusDepth:
+        return { "FX_CHORUS_DEPTH", "Chorus Depth", 0.0f, 1.0f, 0.01f, 0.5f, Format::Percent };
+    case ParamID::ChorusMix:
+        return { "FX_CHORUS_MIX", "Chorus Mix", 0.0f, 1.0f, 0.01f, 0.5f, Format::Percent };
+    case ParamID::DelayTime:
+        return { "FX_DELAY_TIME", "Delay Time", DelayEffect::minTimeMs, DelayEffect::maxTimeMs, 1.0f, 375.0f, Format::Time };
+    case ParamID::DelayFeedback:
+        return { "FX_DELAY_FEEDBACK", "Delay Feedback", 0.0f, DelayEffect::maxFeedback, 0.01f, 0.35f, Format::Percent };
+    case ParamID::DelayMix:
+        return { "FX_DELAY_MIX", "Delay Mix", 0.0f, 1.0f, 0.01f, 0.3f, Format::Percent };
+    case ParamID::ReverbDecay:
+        return { "FX_REVERB_DECAY", "Reverb Decay", ReverbEffect::minDecaySeconds, ReverbEffect::maxDecaySeconds, 0.01f, 2.0f, Format::Normal };
+    case ParamID::ReverbDamping:
+        return { "FX_REVERB_DAMPING", "Reverb Damping", 0.0f, 1.0f, 0.01f, 0.4f, Format::Percent };
+    case ParamID::ReverbMix:
+        return { "FX_REVERB_MIX", "Reverb Mix", 0.0f, 1.0f, 0.01f, 0.25f, Format::Percent };
+    default:
+        return {};
+    }
+}
+
+std::pair<juce::String, juce::String> EffectsChain::getToggleParamSpecs(ParamID param)
+{
+    switch (param)
+    {
+    case ParamID::ChorusEnabled: return { "FX_CHORUS_ON", "Chorus" };
+    case ParamID::DelayEnabled:  return { "FX_DELAY_ON", "Delay" };
+    case ParamID::ReverbEnabled: return { "FX_REVERB_ON", "Reverb" };
+    default:                     return { "", "" };
+    }
+}
+
+void EffectsChain::addParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout)
+{
+    for (int i = 0; i < static_cast<int>(ParamID::Count); ++i)
+    {
+        const auto param = static_cast<ParamID>(i);
+
+        if (const auto [toggleID, toggleLabel] = getToggleParamSpecs(param); toggleID.isNotEmpty())
+        {
+            layout.add(std::make_unique<juce::AudioParameterBool>(toggleID, toggleLabel, false));
+            continue;
+        }
+
+        const auto spec = getKnobParamSpecs(param);
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            spec.id, spec.name,
+            juce::NormalisableRange<float>(spec.minValue, spec.maxValue, spec.stepSize),
+            spec.defaultValue));
+    }
+}
+
+void EffectsChain::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    chorus.prepare(sampleRate);
+    delay.prepare(sampleRate);
+    reverb.prepare(sampleRate);
+
+    reset();
+    updateFromParameters();
+}
+
+void EffectsChain::reset() noexcept
+{
+    chorus.reset();
+    delay.reset();
+    reverb.reset();
+
+    for (auto* slot : { &chorusSlot, &delaySlot, &reverbSlot })
+    {
+        slot->mix = 0.0f;
+        slot->idle = true;
+    }
+
+    silentSamples = 0;
+}
+
+float EffectsChain::value(ParamID param) const noexcept
+{
+    return handles[static_cast<size_t>(param)]->load();
+}
+
+void EffectsChain::updateFromParameters() noexcept
+{
+    const bool chorusOn = value(ParamID::ChorusEnabled) > 0.5f;
+    const bool delayOn = value(ParamID::DelayEnabled) > 0.5f;
+    const bool reverbOn = value(ParamID::ReverbEnabled) > 0.5f;
+
+    chorusSlot.target = chorusOn ? value(ParamID::ChorusMix) : 0.0f;
+    delaySlot.target = delayOn ? value(ParamID::DelayMix) : 0.0f;
+    reverbSlot.target = reverbOn ? value(ParamID::ReverbMix) : 0.0f;
+
+    // Switched off effects keep their settings, they are only read while running
+    if (chorusOn)
+        chorus.setParameters(value(ParamID::ChorusRate), value(ParamID::ChorusDepth));
+    if (delayOn)
+        delay.setParameters(value(ParamID::DelayTime), value(ParamID::DelayFeedback));
+    if (reverbOn)
+        reverb.setParameters(value(ParamID::ReverbDecay), value(ParamID::ReverbDamping));
+
+    tailSamples = static_cast<int>(std::ceil(computeTailSeconds(chorusOn, delayOn, reverbOn) * currentSampleRate));
+}
+
+void EffectsChain::process(juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
+    if (numChannels == 0 || numSamples <= 0)
+        return;
+
+    // Nothing running and nothing fading in
+    if (chorusSlot.idle && delaySlot.idle && reverbSlot.idle
+        && chorusSlot.target == 0.0f && delaySlot.target == 0.0f && reverbSlot.target == 0.0f)
+        return;
+
+    const bool inputSilent = buffer.getMagnitude(0, numSamples) < silenceThreshold;
+    silentSamples = inputSilent ? juce::jmin(silentSamples + numSamples, std::numeric_limits<int>::max() / 2) : 0;
+
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    processSlot(chorus, chorusSlot, channels, numChannels, numSamples);
+    processSlot(delay, delaySlot, channels, numChannels, numSamples);
+    processSlot(reverb, reverbSlot, channels, numChannels, numSamples);
+}
+
+bool EffectsChain::isSilent() const noexcept
+{
+    const bool running = !chorusSlot.idle || !delaySlot.idle || !reverbSlot.idle;
+    return !running || silentSamples >= tailSamples;
+}
+
+double EffectsChain::getTailLengthSeconds() const
+{
+    return computeTailSeconds(value(ParamID::ChorusEnabled) > 0.5f,
+        value(ParamID::DelayEnabled) > 0.5f,
+        value(ParamID::ReverbEnabled) > 0.5f);
+}
+
+size_t EffectsChain::getMemoryBytes() const noexcept
+{
+    return chorus.getMemoryBytes() + delay.getMemoryBytes() + reverb.getMemoryBytes();
+}
+
+float EffectsChain::computeTailSeconds(bool chorusOn, bool delayOn, bool reverbOn) const noexcept
+{
+    // The effects run in series, so their tails add up
+    float tail = 0.0f;
+    if (chorusOn)
+        tail += ChorusEffect::getTailSeconds();
+    if (delayOn)
+        tail += DelayEffect::getTailSeconds(value(ParamID::DelayTime), value(ParamID::DelayFeedback));
+    if (reverbOn)
+        tail += ReverbEffect::getTailSeconds(value(ParamID::ReverbDecay));
+
+    return tail;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "../../Common.h"
+#include "ChorusEffect.h"
+#include "DelayEffect.h"
+#include "ReverbEffect.h"
+#include <JuceHeader.h>
+
+/**
+ * @class EffectsChain
+ * @brief Chorus, delay and reverb over the main mix, run once per block after rendering.
+ *
+ * The effects are concrete members called in a fixed order, so there is no
+ * per-sample dispatch. Each one fades in and out over a block when it is
+ * switched, and once faded out it is skipped altogether and restarts empty,
+ * so a switched off effect costs nothing. Every delay line is sized in
+ * prepare().
+ */
+class EffectsChain
+{
+public:
+    /**
+     * @enum ParamID
+     * @brief Identifiers for the effect parameters.
+     */
+    enum class ParamID
+    {
+        ChorusEnabled,  ///< Chorus on/off
+        ChorusRate,     ///< Chorus modulation rate in Hz
+        ChorusDepth,    ///< Chorus modulation depth
+        ChorusMix,      ///< Chorus dry/wet
+        DelayEnabled,   ///< Delay on/off
+        DelayTime,      ///< Delay time in ms
+        DelayFeedback,  ///< Delay feedback gain
+        DelayMix,       ///< Delay dry/wet
+        ReverbEnabled,  ///< Reverb on/off
+        ReverbDecay,    ///< Reverb decay time in seconds
+        ReverbDamping,  ///< Reverb high-frequency damping
+        ReverbMix,      ///< Reverb dry/wet
+        Count           ///< Number of parameters
+    };
+
+    /**
+     * @brief Constructs the chain and resolves its parameter handles.
+     * @param apvts Reference to the AudioProcessorValueTreeState.
+     */
+    explicit EffectsChain(juce::AudioProcessorValueTreeState& apvts);
+
+    /**
+     * @brief Returns the knob specification for a continuous parameter.
+     * @param param Parameter ID.
+     */
+    static KnobParamSpecs getKnobParamSpecs(ParamID param);
+
+    /**
+     * @brief Returns the ID and label of an on/off parameter.
+     * @param param Parameter ID.
+     */
+    static std::pair<juce::String, juce::String> getToggleParamSpecs(ParamID param);
+
+    /**
+     * @brief Adds every effect parameter to the APVTS layout.
+     * @param layout The parameter layout to append to.
+     */
+    static void addParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout);
+
+    /**
+     * @brief Sizes every delay line for a sample rate and clears them. Not real-time safe.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Clears every effect, all of them restarting idle.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Reads every effect parameter. Audio thread, once per block.
+     */
+    void updateFromParameters() noexcept;
+
+    /**
+     * @brief Runs the chain over a block in place.
+     * @param buffer The main mix; its first two channels are processed.
+     * @param numSamples Number of samples.
+     */
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) noexcept;
+
+    /**
+     * @brief Returns true once the input has been silent for longer than the active effects ring.
+     */
+    bool isSilent() const noexcept;
+
+    /**
+     * @brief Returns the longest tail of the switched on effects, from the current parameter values.
+     */
+    double getTailLengthSeconds() const;
+
+    /**
+     * @brief Returns the bytes of delay storage the effects hold.
+     */
+    size_t getMemoryBytes() const noexcept;
+
+private:
+    /**
+     * @struct Slot
+     * @brief Fade bookkeeping of one effect.
+     */
+    struct Slot
+    {
+        float mix = 0.0f;    ///< Mix reached at the end of the last block
+        float target = 0.0f; ///< Mix this block ramps to, 0 while switched off
+        bool idle = true;    ///< True while skipped, with its state cleared
+    };
+
+    /**
+     * @brief Runs one effect, or skips it while it stays faded out.
+     */
+    template <typename Effect>
+    static void processSlot(Effect& effect, Slot& slot, float* const* channels, int numChannels, int numSamples) noexcept
+    {
+        const float mixFrom = slot.mix;
+        slot.mix = slot.target;
+
+        if (mixFrom == 0.0f && slot.target == 0.0f)
+        {
+            if (!slot.idle)
+            {
+                effect.reset();
+                slot.idle = true;
+            }
+            return;
+        }
+
+        slot.idle = false;
+        effect.process(channels, numChannels, numSamples, mixFrom, slot.target);
+    }
+
+    /**
+     * @brief Returns the value of a parameter.
+     */
+    float value(ParamID param) const noexcept;
+
+    /**
+     * @brief Returns the tail of the effects whose on/off parameter is set.
+     */
+    float computeTailSeconds(bool chorusOn, bool delayOn, bool reverbOn) const noexcept;
+
+    static constexpr float silenceThreshold = 1.0e-5f;  ///< Input level below which the input counts as silent
+
+    ChorusEffect chorus;                                ///< First effect
+    DelayEffect delay;                                  ///< Second effect
+    ReverbEffect reverb;                                ///< Last effect
+
+    Slot chorusSlot;                                    ///< Fade state of the chorus
+    Slot delaySlot;                                     ///< Fade state of the delay
+    Slot reverbSlot;                                    ///< Fade state of the reverb
+
+    double currentSampleRate = 44100.0;                 ///< Prepared sample rate
+    int silentSamples = 0;                              ///< Consecutive input samples below the threshold
+    int tailSamples = 0;                                ///< Tail of the effects currently running
+
+    std::array<std::atomic<float>*, static_cast<size_t>(ParamID::Count)> handles{}; ///< Cached parameter handles
+
+    JUCE_DECLARE_NON_COPYABLE(EffectsChain)
+};
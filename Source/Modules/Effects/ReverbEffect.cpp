@@ -0,0 +1,143 @@
+#include "ReverbEffect.h"
+
+namespace
+{
+    // Mutually prime lengths at 44.1 kHz, between 25 and 36 ms
+    constexpr std::array<int, 8> referenceLengths = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+    constexpr double referenceSampleRate = 44100.0;
+}
+
+void ReverbEffect::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    int longest = 0;
+    for (int line = 0; line < numLines; ++line)
+    {
+        const auto l = static_cast<size_t>(line);
+        lengths[l] = juce::jmax(1, juce::roundToInt(referenceLengths[l] * sampleRate / referenceSampleRate));
+        longest = juce::jmax(longest, lengths[l]);
+    }
+
+    lineSize = juce::nextPowerOfTwo(longest + 1);
+    storage.assign(static_cast<size_t>(lineSize * numLines), 0.0f);
+
+    // Force the gains to be recomputed for the new lengths
+    currentDecay = 0.0f;
+    currentDamping = -1.0f;
+    reset();
+}
+
+void ReverbEffect::reset() noexcept
+{
+    std::fill(storage.begin(), storage.end(), 0.0f);
+    lowPassState.fill(0.0f);
+    writeIndex = 0;
+}
+
+size_t ReverbEffect::getMemoryBytes() const noexcept
+{
+    return storage.capacity() * sizeof(float);
+}
+
+void ReverbEffect::setParameters(float decaySeconds, float damping) noexcept
+{
+    decaySeconds = juce::jlimit(minDecaySeconds, maxDecaySeconds, decaySeconds);
+    damping = juce::jlimit(0.0f, 1.0f, damping);
+
+    if (decaySeconds != currentDecay)
+    {
+        currentDecay = decaySeconds;
+
+        // -60 dB over the decay time, spread over the passes of each line
+        for (int line = 0; line < numLines; ++line)
+        {
+            const auto l = static_cast<size_t>(line);
+            const double passesPerDecay = decaySeconds * currentSampleRate / lengths[l];
+            gains[l] = static_cast<float>(std::pow(0.001, 1.0 / passesPerDecay));
+        }
+    }
+
+    if (damping != currentDamping)
+    {
+        currentDamping = damping;
+        dampingCoefficient = 1.0f - 0.9f * damping;
+    }
+}
+
+void ReverbEffect::process(float* const* channels, int numChannels, int numSamples, float mixFrom, float mixTo) noexcept
+{
+    if (numSamples <= 0 || numChannels <= 0 || storage.empty())
+        return;
+
+    const bool isStereo = numChannels > 1;
+    float* left = channels[0];
+    float* right = isStereo ? channels[1] : nullptr;
+
+    const int mask = lineSize - 1;
+    const float mixStep = (mixTo - mixFrom) / static_cast<float>(numSamples);
+    const float hadamardScale = 1.0f / std::sqrt(static_cast<float>(numLines));
+    float mix = mixFrom;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        mix += mixStep;
+
+        const float inLeft = left[i];
+        const float inRight = isStereo ? right[i] : inLeft;
+
+        Lanes taps;
+        for (int line = 0; line < numLines; ++line)
+        {
+            const auto l = static_cast<size_t>(line);
+            const float delayed = storage[static_cast<size_t>(line * lineSize + ((writeIndex - lengths[l]) & mask))];
+            lowPassState[l] += dampingCoefficient * (delayed - lowPassState[l]);
+            taps[l] = lowPassState[l] * gains[l];
+        }
+
+        const float wetLeft = outputGain * (taps[0] - taps[2] + taps[4] - taps[6]);
+        const float wetRight = outputGain * (taps[1] - taps[3] + taps[5] - taps[7]);
+
+        // In-place fast Walsh-Hadamard transform, an orthogonal mix of every line into every other
+        Lanes mixed = taps;
+        for (int half = 1; half < numLines; half <<= 1)
+        {
+            for (int start = 0; start < numLines; start += 2 * half)
+            {
+                for (int j = start; j < start + half; ++j)
+                {
+                    const float a = mixed[static_cast<size_t>(j)];
+                    const float b = mixed[static_cast<size_t>(j + half)];
+                    mixed[static_cast<size_t>(j)] = a + b;
+                    mixed[static_cast<size_t>(j + half)] = a - b;
+                }
+            }
+        }
+
+        for (int line = 0; line < numLines; ++line)
+        {
+            const float input = (line & 1) ? inRight : inLeft;
+            storage[static_cast<size_t>(line * lineSize + writeIndex)] = mixed[static_cast<size_t>(line)] * hadamardScale + input * inputGain;
+        }
+
+        writeIndex = (writeIndex + 1) & mask;
+
+        if (isStereo)
+        {
+            left[i] = inLeft + mix * (wetLeft - inLeft);
+            right[i] = inRight + mix * (wetRight - inRight);
+        }
+        else
+        {
+            left[i] = inLeft + mix * (0.5f * (wetLeft + wetRight) - inLeft);
+        }
+    }
+
+    for (auto& state : lowPassState)
+        juce::dsp::util::snapToZero(state);
+}
+
+float ReverbEffect::getTailSeconds(float decaySeconds) noexcept
+{
+    return juce::jlimit(minDecaySeconds, maxDecaySeconds, decaySeconds);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+/**
+ * @class ReverbEffect
+ * @brief Eight-line feedback delay network reverb.
+ *
+ * The lines are mixed through a fast Walsh-Hadamard transform, so the
+ * feedback matrix costs 24 additions per sample instead of a matrix
+ * product. Every line loses the same level per second, which sets the
+ * decay time independently of the line lengths, and a one-pole low-pass in
+ * each line darkens the tail by the damping. The left input feeds the even
+ * lines and the right input the odd ones, and the outputs tap them the
+ * same way, so the tail stays decorrelated between the channels.
+ */
+class ReverbEffect
+{
+public:
+    static constexpr float minDecaySeconds = 0.2f;   ///< Shortest decay time
+    static constexpr float maxDecaySeconds = 10.0f;  ///< Longest decay time
+
+    /**
+     * @brief Sizes the delay lines for a sample rate. Not real-time safe.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Clears the delay lines.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Returns the bytes of delay storage prepare() allocated.
+     */
+    size_t getMemoryBytes() const noexcept;
+
+    /**
+     * @brief Sets the decay time and the damping, recomputing the line gains only if they changed.
+     * @param decaySeconds Time for the tail to fall by 60 dB.
+     * @param damping High-frequency damping in [0, 1].
+     */
+    void setParameters(float decaySeconds, float damping) noexcept;
+
+    /**
+     * @brief Reverberates a block in place, crossfading from the dry signal by the mix.
+     * @param channels Channel pointers.
+     * @param numChannels Number of channels, 1 or 2.
+     * @param numSamples Number of samples.
+     * @param mixFrom Mix at the start of the block.
+     * @param mixTo Mix at the end of the block.
+     */
+    void process(float* const* channels, int numChannels, int numSamples, float mixFrom, float mixTo) noexcept;
+
+    /**
+     * @brief Returns the tail length for a decay time.
+     */
+    static float getTailSeconds(float decaySeconds) noexcept;
+
+private:
+    static constexpr int numLines = 8;               ///< Delay lines in the network
+    static constexpr float inputGain = 0.35f;        ///< Level fed into each line
+    static constexpr float outputGain = 0.5f;        ///< Level of each channel's tap sum
+
+    using Lanes = std::array<float, numLines>;       ///< One value per line
+
+    std::vector<float> storage;                      ///< Every line's circular buffer, back to back
+    std::array<int, numLines> lengths{};             ///< Line lengths in samples
+    int lineSize = 0;                                ///< Storage per line, a power of two
+    int writeIndex = 0;                              ///< Shared write index of every line
+
+    Lanes gains{};                                   ///< Per-pass gain of every line
+    Lanes lowPassState{};                            ///< Damping filter state of every line
+    float dampingCoefficient = 1.0f;                 ///< One-pole coefficient, 1 for no damping
+
+    double currentSampleRate = 44100.0;              ///< Prepared sample rate
+    float currentDecay = 0.0f;                       ///< Decay the gains were computed for
+    float currentDamping = -1.0f;                    ///< Damping the coefficient was computed for
+};
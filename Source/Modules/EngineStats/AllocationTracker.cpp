@@ -0,0 +1,90 @@
+#include "AllocationTracker.h"
+
+namespace
+{
+    thread_local int realtimeDepth = 0;            // Open ScopedRealtime scopes on this thread
+    std::atomic<int> numAllocations{ 0 };          // Allocations counted since the last reset
+    std::atomic<size_t> lastAllocationBytes{ 0 };  // Size of the latest counted allocation
+
+    [[maybe_unused]] void recordAllocation(size_t bytes) noexcept
+    {
+        if (realtimeDepth == 0)
+            return;
+
+        numAllocations.fetch_add(1, std::memory_order_relaxed);
+        lastAllocationBytes.store(bytes, std::memory_order_relaxed);
+    }
+}
+
+AllocationTracker::ScopedRealtime::ScopedRealtime() noexcept
+{
+#if ALLOCATION_TRACKING
+    ++realtimeDepth;
+#endif
+}
+
+AllocationTracker::ScopedRealtime::~ScopedRealtime()
+{
+#if ALLOCATION_TRACKING
+    --realtimeDepth;
+#endif
+}
+
+bool AllocationTracker::isEnabled() noexcept
+{
+    return ALLOCATION_TRACKING != 0;
+}
+
+int AllocationTracker::getNumAllocations() noexcept
+{
+    return numAllocations.load(std::memory_order_relaxed);
+}
+
+size_t AllocationTracker::getLastAllocationBytes() noexcept
+{
+    return lastAllocationBytes.load(std::memory_order_relaxed);
+}
+
+void AllocationTracker::reset() noexcept
+{
+    numAllocations.store(0, std::memory_order_relaxed);
+    lastAllocationBytes.store(0, std::memory_order_relaxed);
+}
+
+#if ALLOCATION_TRACKING
+//==============================================================================
+// Replaced global allocation functions, malloc-backed so the matching deletes stay trivial
+
+void* operator new(std::size_t size)
+{
+    recordAllocation(size);
+
+    if (void* memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    recordAllocation(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept                            { std::free(memory); }
+void operator delete[](void* memory) noexcept                          { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept               { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept             { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept     { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept   { std::free(memory); }
+#endif
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../../Common.h"
+#include <JuceHeader.h>
+
+/**
+ * @class AllocationTracker
+ * @brief Debug counter of the heap allocations made on the audio thread.
+ *
+ * With ALLOCATION_TRACKING on, the global operator new is replaced by one that
+ * counts every allocation made while a ScopedRealtime lives on the calling
+ * thread, and keeps the size of the latest. processBlock and the render
+ * workers open that scope, so any count above zero is a real-time violation
+ * to hunt down. Over-aligned allocations keep the library's own operator and
+ * are not counted.
+ *
+ * The replacement applies to the whole binary and, where symbols are shared,
+ * to the host as well, so the flag is for debug builds only. With it off the
+ * scope compiles to nothing and every reading is zero.
+ */
+class AllocationTracker
+{
+public:
+    /**
+     * @class ScopedRealtime
+     * @brief Marks the calling thread as real-time for its lifetime. May nest.
+     */
+    class ScopedRealtime
+    {
+    public:
+        /** @brief Enters the real-time scope. */
+        ScopedRealtime() noexcept;
+
+        /** @brief Leaves the real-time scope. */
+        ~ScopedRealtime();
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedRealtime)
+    };
+
+    /**
+     * @brief Returns true if this build counts allocations.
+     */
+    static bool isEnabled() noexcept;
+
+    /**
+     * @brief Returns how many allocations real-time scopes made since the last reset.
+     */
+    static int getNumAllocations() noexcept;
+
+    /**
+     * @brief Returns the size in bytes of the latest counted allocation, 0 if none.
+     */
+    static size_t getLastAllocationBytes() noexcept;
+
+    /**
+     * @brief Clears the count. Safe from any thread.
+     */
+    static void reset() noexcept;
+
+private:
+    AllocationTracker() = delete;
+};
@@ -0,0 +1,109 @@
+#include "EngineStats.h"
+#include "AllocationTracker.h"
+
+juce::String EngineStats::Snapshot::toLogLine() const
+{
+    juce::String line("engine-stats");
+    line << " blocks=" << blocksRendered
+         << " skipped=" << blocksSkipped;
+
+    for (size_t i = 0; i < activeVoices.size(); ++i)
+        line << " osc" << static_cast<int>(i + 1) << ".voices=" << activeVoices[i]
+             << " osc" << static_cast<int>(i + 1) << ".peak=" << peakVoices[i];
+
+    for (size_t i = 0; i < activeEnvelopeVoices.size(); ++i)
+        line << " env" << static_cast<int>(i + 1) << ".voices=" << activeEnvelopeVoices[i];
+
+    line << " stolen=" << stolenVoices
+         << " memory=" << static_cast<juce::int64>(memoryBytes)
+         << " allocations=" << audioThreadAllocations
+         << " lastAllocation=" << static_cast<juce::int64>(lastAllocationBytes);
+
+    return line;
+}
+
+void EngineStats::prepare() noexcept
+{
+    for (auto& voices : activeVoices)
+        voices.store(0, std::memory_order_relaxed);
+
+    for (auto& voices : activeEnvelopeVoices)
+        voices.store(0, std::memory_order_relaxed);
+
+    blocksRendered.store(0, std::memory_order_relaxed);
+    blocksSkipped.store(0, std::memory_order_relaxed);
+    resetPeaks();
+}
+
+void EngineStats::addBlock(bool rendered) noexcept
+{
+    auto& counter = rendered ? blocksRendered : blocksSkipped;
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void EngineStats::setOscillatorVoices(int oscillator, int numActive) noexcept
+{
+    jassert(juce::isPositiveAndBelow(oscillator, SynthConfig::numOscillators));
+    const auto index = static_cast<size_t>(oscillator);
+    activeVoices[index].store(numActive, std::memory_order_relaxed);
+
+    // resetPeaks() may store concurrently, only ever raise what is there
+    int previousPeak = peakVoices[index].load(std::memory_order_relaxed);
+    while (numActive > previousPeak
+           && !peakVoices[index].compare_exchange_weak(previousPeak, numActive, std::memory_order_relaxed))
+    {
+    }
+}
+
+void EngineStats::setEnvelopeVoices(int envelope, int numActive) noexcept
+{
+    jassert(juce::isPositiveAndBelow(envelope, SynthConfig::numEnvelopes));
+    activeEnvelopeVoices[static_cast<size_t>(envelope)].store(numActive, std::memory_order_relaxed);
+}
+
+void EngineStats::addStolenVoices(int count) noexcept
+{
+    if (count > 0)
+        stolenVoices.fetch_add(count, std::memory_order_relaxed);
+}
+
+void EngineStats::setMemoryBytes(size_t bytes) noexcept
+{
+    memoryBytes.store(bytes, std::memory_order_relaxed);
+}
+
+EngineStats::Snapshot EngineStats::getSnapshot() const noexcept
+{
+    Snapshot snapshot;
+
+    for (size_t i = 0; i < activeVoices.size(); ++i)
+    {
+        snapshot.activeVoices[i] = activeVoices[i].load(std::memory_order_relaxed);
+        snapshot.peakVoices[i] = peakVoices[i].load(std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < activeEnvelopeVoices.size(); ++i)
+        snapshot.activeEnvelopeVoices[i] = activeEnvelopeVoices[i].load(std::memory_order_relaxed);
+
+    snapshot.stolenVoices = stolenVoices.load(std::memory_order_relaxed);
+    snapshot.blocksRendered = blocksRendered.load(std::memory_order_relaxed);
+    snapshot.blocksSkipped = blocksSkipped.load(std::memory_order_relaxed);
+    snapshot.memoryBytes = memoryBytes.load(std::memory_order_relaxed);
+    snapshot.audioThreadAllocations = AllocationTracker::getNumAllocations();
+    snapshot.lastAllocationBytes = AllocationTracker::getLastAllocationBytes();
+    return snapshot;
+}
+
+void EngineStats::resetPeaks() noexcept
+{
+    for (size_t i = 0; i < peakVoices.size(); ++i)
+        peakVoices[i].store(activeVoices[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    stolenVoices.store(0, std::memory_order_relaxed);
+    AllocationTracker::reset();
+}
+
+void EngineStats::writeToLog() const
+{
+    juce::Logger::writeToLog(getSnapshot().toLogLine());
+}
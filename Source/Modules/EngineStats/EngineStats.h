@@ -0,0 +1,112 @@
+#pragma once
+
+#include "../../Common.h"
+#include <JuceHeader.h>
+
+/**
+ * @class EngineStats
+ * @brief Counters describing what the engine holds and does, for the editor and fleet logs.
+ *
+ * The audio thread publishes the active notes of every oscillator, the active
+ * voices of every envelope, stolen voices and block counts once per block;
+ * prepareToPlay() publishes the bytes the engine holds in buffers and tables.
+ * Every value is an atomic, so any thread takes a Snapshot without locking.
+ * Allocations on the audio thread come from AllocationTracker and read zero
+ * unless ALLOCATION_TRACKING is on.
+ */
+class EngineStats
+{
+public:
+    /**
+     * @struct Snapshot
+     * @brief Copy of every counter at one moment.
+     */
+    struct Snapshot
+    {
+        std::array<int, SynthConfig::numOscillators> activeVoices{};        ///< Notes sounding per oscillator
+        std::array<int, SynthConfig::numOscillators> peakVoices{};          ///< Most notes per oscillator since the last reset
+        std::array<int, SynthConfig::numEnvelopes> activeEnvelopeVoices{};  ///< Voices in use per envelope, fading ones included
+        int stolenVoices = 0;                                               ///< Voices stolen since the last reset
+        juce::int64 blocksRendered = 0;                                     ///< Blocks that rendered audio since prepareToPlay()
+        juce::int64 blocksSkipped = 0;                                      ///< Silent blocks skipped since prepareToPlay()
+        size_t memoryBytes = 0;                                             ///< Bytes held in buffers and tables
+        int audioThreadAllocations = 0;                                     ///< Heap allocations on the audio thread since the last reset
+        size_t lastAllocationBytes = 0;                                     ///< Size of the latest of those allocations
+
+        /**
+         * @brief Formats the snapshot as one line of space separated key=value pairs.
+         * @return Line starting with "engine-stats", stable across versions for log parsers.
+         */
+        juce::String toLogLine() const;
+    };
+
+    /**
+     * @brief Constructs zeroed counters.
+     */
+    EngineStats() = default;
+
+    /**
+     * @brief Clears every counter but the memory reading.
+     *
+     * Call from prepareToPlay(), never while the audio thread is running.
+     */
+    void prepare() noexcept;
+
+    /**
+     * @brief Counts one block. Audio thread only.
+     * @param rendered True if the block rendered audio, false if it was skipped as silent.
+     */
+    void addBlock(bool rendered) noexcept;
+
+    /**
+     * @brief Publishes the notes an oscillator plays, raising its peak. Audio thread only.
+     * @param oscillator Oscillator index.
+     * @param numActive Notes sounding, released ones included.
+     */
+    void setOscillatorVoices(int oscillator, int numActive) noexcept;
+
+    /**
+     * @brief Publishes the voices an envelope has in use. Audio thread only.
+     * @param envelope Envelope index.
+     * @param numActive Voices in use.
+     */
+    void setEnvelopeVoices(int envelope, int numActive) noexcept;
+
+    /**
+     * @brief Counts voices taken from sounding notes for new ones. Audio thread only.
+     * @param count Voices stolen.
+     */
+    void addStolenVoices(int count) noexcept;
+
+    /**
+     * @brief Publishes the bytes the engine holds. Call whenever a buffer or table is resized.
+     * @param bytes Bytes held.
+     */
+    void setMemoryBytes(size_t bytes) noexcept;
+
+    /**
+     * @brief Returns a copy of every counter. Safe from any thread.
+     */
+    Snapshot getSnapshot() const noexcept;
+
+    /**
+     * @brief Lowers the peaks to the current values and clears the steal and allocation counts. Safe from any thread.
+     */
+    void resetPeaks() noexcept;
+
+    /**
+     * @brief Writes the current snapshot to the current juce::Logger.
+     */
+    void writeToLog() const;
+
+private:
+    std::array<std::atomic<int>, SynthConfig::numOscillators> activeVoices{};         ///< Notes sounding per oscillator
+    std::array<std::atomic<int>, SynthConfig::numOscillators> peakVoices{};           ///< Most notes per oscillator since the last reset
+    std::array<std::atomic<int>, SynthConfig::numEnvelopes> activeEnvelopeVoices{};   ///< Voices in use per envelope
+    std::atomic<int> stolenVoices{ 0 };                                               ///< Voices stolen since the last reset
+    std::atomic<juce::int64> blocksRendered{ 0 };                                     ///< Blocks that rendered audio
+    std::atomic<juce::int64> blocksSkipped{ 0 };                                      ///< Silent blocks skipped
+    std::atomic<size_t> memoryBytes{ 0 };                                             ///< Bytes held in buffers and tables
+
+    JUCE_DECLARE_NON_COPYABLE(EngineStats)
+};
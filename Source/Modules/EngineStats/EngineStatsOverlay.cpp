@@ -0,0 +1,89 @@
+#include "EngineStatsOverlay.h"
+#include "AllocationTracker.h"
+
+EngineStatsOverlay::EngineStatsOverlay(const EngineStats& statsIn)
+    : stats(statsIn)
+{
+    setInterceptsMouseClicks(false, false);
+    snapshot = stats.getSnapshot();
+    refreshScheduler->add(this);
+}
+
+EngineStatsOverlay::~EngineStatsOverlay()
+{
+    refreshScheduler->remove(this);
+}
+
+int EngineStatsOverlay::getPreferredHeight()
+{
+    // One row per oscillator and envelope, then steals, blocks, memory and allocations
+    return rowHeight * (SynthConfig::numOscillators + SynthConfig::numEnvelopes + 4) + 8;
+}
+
+void EngineStatsOverlay::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.withAlpha(0.75f));
+    g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 11.0f, juce::Font::plain));
+    g.setColour(juce::Colours::white);
+
+    auto area = getLocalBounds().reduced(6, 4);
+
+    const auto drawRow = [&g, &area](const juce::String& name, const juce::String& value)
+        {
+            auto row = area.removeFromTop(rowHeight);
+            g.drawText(name, row.removeFromLeft(96), juce::Justification::centredLeft);
+            g.drawText(value, row, juce::Justification::centredRight);
+        };
+
+    for (size_t i = 0; i < snapshot.activeVoices.size(); ++i)
+        drawRow("Osc " + juce::String(static_cast<int>(i + 1)) + " voices",
+                juce::String(snapshot.activeVoices[i]) + " (peak " + juce::String(snapshot.peakVoices[i]) + ")");
+
+    for (size_t i = 0; i < snapshot.activeEnvelopeVoices.size(); ++i)
+        drawRow("Env " + juce::String(static_cast<int>(i + 1)) + " voices", juce::String(snapshot.activeEnvelopeVoices[i]));
+
+    drawRow("Stolen", juce::String(snapshot.stolenVoices));
+    drawRow("Blocks", juce::String(snapshot.blocksRendered) + " / " + juce::String(snapshot.blocksSkipped) + " skipped");
+    drawRow("Memory", juce::File::descriptionOfSizeInBytes(static_cast<juce::int64>(snapshot.memoryBytes)));
+
+    if (!AllocationTracker::isEnabled())
+    {
+        g.setColour(juce::Colours::grey);
+        drawRow("Allocations", "not tracked");
+        return;
+    }
+
+    // Any allocation on the audio thread is a bug
+    g.setColour(snapshot.audioThreadAllocations > 0 ? juce::Colours::orangered : juce::Colours::white);
+    drawRow("Allocations", snapshot.audioThreadAllocations > 0
+        ? juce::String(snapshot.audioThreadAllocations) + ", last " + juce::String(static_cast<juce::int64>(snapshot.lastAllocationBytes)) + " B"
+        : juce::String("0"));
+}
+
+void EngineStatsOverlay::visibilityChanged()
+{
+    if (isVisible())
+        refreshScheduler->add(this);
+    else
+        refreshScheduler->remove(this);
+}
+
+void EngineStatsOverlay::refresh()
+{
+    const auto latest = stats.getSnapshot();
+
+    const bool changed = latest.activeVoices != snapshot.activeVoices
+        || latest.peakVoices != snapshot.peakVoices
+        || latest.activeEnvelopeVoices != snapshot.activeEnvelopeVoices
+        || latest.stolenVoices != snapshot.stolenVoices
+        || latest.blocksRendered != snapshot.blocksRendered
+        || latest.blocksSkipped != snapshot.blocksSkipped
+        || latest.memoryBytes != snapshot.memoryBytes
+        || latest.audioThreadAllocations != snapshot.audioThreadAllocations;
+
+    if (!changed)
+        return;
+
+    snapshot = latest;
+    repaint();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "EngineStats.h"
+#include "../RefreshScheduler/RefreshScheduler.h"
+#include <JuceHeader.h>
+
+/**
+ * @class EngineStatsOverlay
+ * @brief Translucent table of the engine's voice, block, memory and allocation counters.
+ *
+ * Shows the active and peak notes of every oscillator, the voices of every
+ * envelope, stolen voices, rendered and skipped blocks, the memory held and,
+ * in builds tracking them, allocations on the audio thread, highlighted once
+ * there are any. Ignores the mouse, so the controls beneath stay usable.
+ */
+class EngineStatsOverlay : public juce::Component, private RefreshScheduler::Client
+{
+public:
+    static constexpr int width = 220;      ///< Width in pixels
+    static constexpr int rowHeight = 14;   ///< Height of one row in pixels
+
+    /**
+     * @brief Constructs the overlay for a set of counters.
+     * @param stats Counters to read, must outlive the overlay.
+     */
+    explicit EngineStatsOverlay(const EngineStats& stats);
+
+    /**
+     * @brief Leaves the refresh scheduler.
+     */
+    ~EngineStatsOverlay() override;
+
+    /**
+     * @brief Returns the height needed to show every row.
+     */
+    static int getPreferredHeight();
+
+    /**
+     * @brief Draws the table.
+     */
+    void paint(juce::Graphics& g) override;
+
+    /**
+     * @brief Starts or stops refreshing along with visibility.
+     */
+    void visibilityChanged() override;
+
+private:
+    /**
+     * @brief Fetches the latest snapshot and repaints if it changed.
+     */
+    void refresh() override;
+
+    const EngineStats& stats;                                        ///< Counters read on every frame
+    EngineStats::Snapshot snapshot;                                  ///< Values currently shown
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler;  ///< Shared UI refresh tick
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineStatsOverlay)
+};
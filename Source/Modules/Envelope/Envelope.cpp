@@ -5,7 +5,19 @@ Envelope::Envelope(int index, juce::AudioProcessorValueTreeState& apvts)
     : envelopeIndex(index), apvts(apvts)
 {
     name = "Envelope " + juce::String(index + 1);
+    resetAllVoices();
     setParameters(attackNorm, decayNorm, sustainNorm, releaseNorm);
+
+    // Resolve parameter handles once, so the audio thread never looks IDs up by name
+    modeHandle = apvts.getRawParameterValue(getEnvelopeModeParamSpecs(index).paramID);
+    jassert(modeHandle != nullptr);
+
+    const auto& specs = getParamSpecs(index);
+    for (size_t stage = 0; stage < stageHandles.size(); ++stage)
+    {
+        stageHandles[stage] = apvts.getRawParameterValue(specs[stage].id);
+        jassert(stageHandles[stage] != nullptr);
+    }
 }
 
 void Envelope::addParameters(int index, juce::AudioProcessorValueTreeState::ParameterLayout& layout)
@@ -38,7 +50,21 @@ juce::String Envelope::getName() const
     return name;
 }
 
-std::vector<Envelope::KnobParamSpecs> Envelope::getParamSpecs(int index)
+const std::vector<Envelope::KnobParamSpecs>& Envelope::getParamSpecs(int index)
+{
+    static const auto table = []
+        {
+            std::array<std::vector<KnobParamSpecs>, NUM_OF_ENVELOPES> specs;
+            for (int i = 0; i < NUM_OF_ENVELOPES; ++i)
+                specs[static_cast<size_t>(i)] = makeParamSpecs(i);
+            return specs;
+        }();
+
+    jassert(index >= 0 && index < NUM_OF_ENVELOPES);
+    return table[static_cast<size_t>(index)];
+}
+
+std::vector<Envelope::KnobParamSpecs> Envelope::makeParamSpecs(int index)
 {
     const int ID = index + 1;
     const juce::String prefix = "ENV" + juce::String(ID) + "_";
@@ -75,7 +101,9 @@ Envelope::ComboBoxParamSpecs Envelope::getEnvelopeLinkParamSpecs(int index)
 
     spec.paramID = "ENV" + juce::String(index + 1) + "_LINK";
     spec.label = "Link";
-    spec.defaultIndex = index + 1;
+
+    // Envelope i drives oscillator i, envelopes without a matching oscillator start unlinked
+    spec.defaultIndex = (index < NUM_OF_OSCILLATORS) ? index + 1 : 0;
 
     return spec;
 }
@@ -90,24 +118,51 @@ void Envelope::setParameters(float attack, float decay, float sustain, float rel
     juce::ADSR::Parameters newParams = mapToADSRParams(attack, decay, sustain, release);
 
     for (auto& voice : voiceEnvelopes)
-    {
-        voice.params = newParams;
         voice.adsr.setParameters(newParams);
-    }
 }
 
 void Envelope::updateFromParameters()
 {
-    const auto modeSpec = getEnvelopeModeParamSpecs(envelopeIndex);
-    int modeIndex = static_cast<int>(apvts.getRawParameterValue(modeSpec.paramID)->load());
-    setMode(static_cast<Mode>(modeIndex));
+    const auto newMode = static_cast<Mode>(static_cast<int>(modeHandle->load()));
+    if (newMode != mode)
+        setMode(newMode);
+
+    float a = ModulationTarget::apply(modulationTargets[0], stageHandles[0]->load());
+    float d = ModulationTarget::apply(modulationTargets[1], stageHandles[1]->load());
+    float s = ModulationTarget::apply(modulationTargets[2], stageHandles[2]->load());
+    float r = ModulationTarget::apply(modulationTargets[3], stageHandles[3]->load());
+
+    // Unchanged settings skip remapping and reconfiguring every voice
+    if (a != attackNorm || d != decayNorm || s != sustainNorm || r != releaseNorm)
+        setParameters(a, d, s, r);
+}
+
+void Envelope::setReleaseFade(float seconds) noexcept
+{
+    // Reconfiguring every voice only when the fade moved
+    if (seconds == releaseFade)
+        return;
+
+    releaseFade = seconds;
+    for (auto& voice : voiceEnvelopes)
+        voice.adsr.setMinimumRelease(seconds);
+}
+
+void Envelope::setModulationTarget(ADSR stage, const ModulationTarget* target)
+{
+    if (stage == ADSR::Count)
+        return;
+
+    modulationTargets[static_cast<size_t>(stage)] = target;
+}
 
-    const auto& specs = getParamSpecs(envelopeIndex);
-    float a = apvts.getRawParameterValue(specs[0].id)->load();
-    float d = apvts.getRawParameterValue(specs[1].id)->load();
-    float s = apvts.getRawParameterValue(specs[2].id)->load();
-    float r = apvts.getRawParameterValue(specs[3].id)->load();
-    setParameters(a, d, s, r);
+void Envelope::prepareToPlay(double newSampleRate, int samplesPerBlock)
+{
+    setSampleRate(newSampleRate);
+    voiceBlocks.setSize(voiceCapacity, samplesPerBlock);
+    voiceBlocks.clear();
+    preparedBlockSize = samplesPerBlock;
+    blockSize = 0;
 }
 
 void Envelope::setSampleRate(double newRate)
@@ -120,45 +175,106 @@ void Envelope::setSampleRate(double newRate)
     }
 }
 
-void Envelope::noteOn(int midiNote)
+void Envelope::beginBlock(int numSamples)
 {
+    // The processor splits host blocks beyond the prepared size, so this only ever shrinks the view
+    jassert(numSamples <= preparedBlockSize);
+    voiceBlocks.setSize(voiceCapacity, numSamples, false, false, true);
+    blockSize = numSamples;
+
     for (auto& voice : voiceEnvelopes)
+        voice.renderedSamples = 0;
+}
+
+void Envelope::endBlock()
+{
+    for (int i = 0; i < voiceCapacity; ++i)
     {
-        // If this voice is already handling the same note, reset it before reusing
-        if (voice.active && voice.midiNote == midiNote)
-        {
-            voice.adsr.reset();
-            voice.active = false;
-            voice.midiNote = -1;
-        }
+        if (voiceEnvelopes[i].active)
+            renderVoiceTo(i, blockSize);
+    }
+}
 
-        // Use the first inactive voice
-        if (!voice.active)
-        {
-            voice.midiNote = midiNote;
-            voice.active = true;
+bool Envelope::noteOn(int midiNote, int sampleOffset)
+{
+    sampleOffset = juce::jlimit(0, blockSize, sampleOffset);
 
-            voice.params = mapToADSRParams(attackNorm, decayNorm, sustainNorm, releaseNorm);
-            voice.adsr.setSampleRate(sampleRate);
-            voice.adsr.setParameters(voice.params);
-            voice.adsr.noteOn();
+    // Retriggering a note restarts its own voice, after it played up to the event
+    int voiceIndex = findVoice(midiNote);
+    if (voiceIndex >= 0)
+        renderVoiceTo(voiceIndex, sampleOffset);
 
-            return;
-        }
+    voiceIndex = findVoice(midiNote);
+    if (voiceIndex < 0)
+    {
+        // Use the next free voice, the caller drops notes beyond the capacity
+        if (numFreeVoices == 0 || midiNote < 0 || midiNote >= numMidiNotes)
+            return false;
+
+        voiceIndex = freeVoices[--numFreeVoices];
+        noteToVoice[midiNote] = voiceIndex;
+
+        // Nothing reads this note before the event, its clock starts there
+        voiceEnvelopes[voiceIndex].renderedSamples = sampleOffset;
     }
+
+    auto& voice = voiceEnvelopes[voiceIndex];
+    voice.midiNote = midiNote;
+    voice.active = true;
+    voice.adsr.reset();
+    voice.adsr.noteOn();
+    return true;
 }
 
-void Envelope::noteOff(int midiNote)
+void Envelope::noteOff(int midiNote, int sampleOffset)
 {
-    for (auto& voice : voiceEnvelopes)
-    {
-        if (voice.active && voice.midiNote == midiNote)
-        {
-            voice.adsr.setSampleRate(sampleRate);
-            voice.adsr.setParameters(mapToADSRParams(attackNorm, decayNorm, sustainNorm, releaseNorm));
-            voice.adsr.noteOff();
-        }
-    }
+    const int voiceIndex = findVoice(midiNote);
+    if (voiceIndex < 0)
+        return;
+
+    renderVoiceTo(voiceIndex, juce::jlimit(0, blockSize, sampleOffset));
+
+    // The voice may have finished on its own before the event
+    if (voiceEnvelopes[voiceIndex].active)
+        voiceEnvelopes[voiceIndex].adsr.noteOff();
+}
+
+void Envelope::fadeOut(int midiNote, int sampleOffset, float seconds)
+{
+    const int voiceIndex = findVoice(midiNote);
+    if (voiceIndex < 0)
+        return;
+
+    renderVoiceTo(voiceIndex, juce::jlimit(0, blockSize, sampleOffset));
+
+    if (voiceEnvelopes[voiceIndex].active)
+        voiceEnvelopes[voiceIndex].adsr.fadeOut(seconds);
+}
+
+void Envelope::stopNote(int midiNote)
+{
+    const int voiceIndex = findVoice(midiNote);
+    if (voiceIndex < 0)
+        return;
+
+    voiceEnvelopes[voiceIndex].adsr.reset();
+    releaseVoice(voiceIndex);
+}
+
+void Envelope::moveNote(int fromNote, int toNote)
+{
+    if (fromNote == toNote || toNote < 0 || toNote >= numMidiNotes)
+        return;
+
+    const int voiceIndex = findVoice(fromNote);
+    if (voiceIndex < 0)
+        return;
+
+    stopNote(toNote);
+
+    noteToVoice[fromNote] = -1;
+    noteToVoice[toNote] = voiceIndex;
+    voiceEnvelopes[voiceIndex].midiNote = toNote;
 }
 
 void Envelope::resetAllVoices()
@@ -167,50 +283,89 @@ void Envelope::resetAllVoices()
     {
         voice.adsr.reset();
         voice.active = false;
+        voice.midiNote = -1;
     }
+
+    noteToVoice.fill(-1);
+
+    // Hand out low indices first
+    numFreeVoices = voiceCapacity;
+    for (int i = 0; i < voiceCapacity; ++i)
+        freeVoices[i] = voiceCapacity - 1 - i;
 }
 
 bool Envelope::isNoteActive(int midiNote) const
 {
-    for (const auto& voice : voiceEnvelopes)
-    {
-        if (voice.active && voice.midiNote == midiNote)
-            return true;
-    }
-    return false;
+    return findVoice(midiNote) >= 0;
+}
+
+float Envelope::getNoteLevel(int midiNote) const
+{
+    const int voiceIndex = findVoice(midiNote);
+    return voiceIndex >= 0 ? voiceEnvelopes[voiceIndex].adsr.getCurrentValue() : -1.0f;
 }
 
 bool Envelope::isActive() const
 {
-    for (const auto& voice : voiceEnvelopes)
+    return numFreeVoices < voiceCapacity;
+}
+
+int Envelope::getNumActiveVoices() const noexcept
+{
+    return voiceCapacity - numFreeVoices;
+}
+
+size_t Envelope::getMemoryBytes() const noexcept
+{
+    // beginBlock() only shrinks the visible size, the prepared storage stays
+    return static_cast<size_t>(voiceCapacity) * static_cast<size_t>(preparedBlockSize) * sizeof(float);
+}
+
+float Envelope::getReleaseTimeSeconds() const
+{
+    const float releaseNormalized = stageHandles[static_cast<size_t>(ADSR::Release)]->load();
+    return FormattingUtils::normalizedToValue(releaseNormalized, FormattingUtils::FormatType::Time, MIN_ADSR_TIME_MS, MAX_ADSR_TIME_MS) / 1000.0f;
+}
+
+void Envelope::renderNote(int midiNote, float* dest, int startSample, int numSamples)
+{
+    const int voiceIndex = findVoice(midiNote);
+    const bool insideBlock = (startSample >= 0 && startSample + numSamples <= blockSize);
+    jassert(insideBlock); // Ranges must lie inside the block passed to beginBlock()
+
+    if (voiceIndex < 0 || !insideBlock)
     {
-        if (voice.active)
-            return true;
+        juce::FloatVectorOperations::clear(dest, numSamples);
+        return;
     }
-    return false;
+
+    renderVoiceTo(voiceIndex, startSample + numSamples);
+    juce::FloatVectorOperations::copy(dest, voiceBlocks.getReadPointer(voiceIndex, startSample), numSamples);
 }
 
-float Envelope::getNextSampleForNote(int midiNote)
+void Envelope::renderModulation(float* dest, int startSample, int numSamples)
 {
-    float mixedSample = 0.0f;
+    const bool insideBlock = (startSample >= 0 && startSample + numSamples <= blockSize);
+    jassert(insideBlock); // Ranges must lie inside the block passed to beginBlock()
 
-    for (auto& voice : voiceEnvelopes)
-    {
-        if (voice.active && voice.midiNote == midiNote)
-        {
-            float sample = voice.adsr.getNextSample();
+    juce::FloatVectorOperations::clear(dest, numSamples);
+    if (!insideBlock)
+        return;
 
-            if (!voice.adsr.isActive())
-            {
-                voice.active = false;
-                voice.midiNote = -1;
-            }
+    int count = 0;
+    for (int i = 0; i < voiceCapacity; ++i)
+    {
+        if (!voiceEnvelopes[i].active)
+            continue;
 
-            mixedSample += (sample < 0.0f) ? 0.0f : sample;
-        }
+        // Keep a voice ending in the range, its note still has to read the tail
+        renderVoiceTo(i, startSample + numSamples, false);
+        juce::FloatVectorOperations::add(dest, voiceBlocks.getReadPointer(i, startSample), numSamples);
+        ++count;
     }
 
-    return mixedSample;
+    if (count > 1)
+        juce::FloatVectorOperations::multiply(dest, 1.0f / static_cast<float>(count), numSamples);
 }
 
 float Envelope::getModulationValue() const
@@ -231,21 +386,40 @@ float Envelope::getModulationValue() const
     return (count > 0) ? (sum / count) : 0.0f;
 }
 
-void Envelope::tick()
+void Envelope::renderVoiceTo(int voiceIndex, int position, bool freeIfFinished)
 {
-    for (auto& voice : voiceEnvelopes)
-    {
-        if (voice.active)
-        {
-            voice.adsr.getNextSample();
+    auto& voice = voiceEnvelopes[voiceIndex];
 
-            if (!voice.adsr.isActive())
-            {
-                voice.active = false;
-                voice.midiNote = -1;
-            }
-        }
+    // Already rendered ranges are read back as they are, a voice never goes back in time
+    if (position > voice.renderedSamples)
+    {
+        voice.adsr.render(voiceBlocks.getWritePointer(voiceIndex, voice.renderedSamples), position - voice.renderedSamples);
+        voice.renderedSamples = position;
     }
+
+    // A voice kept for renderModulation() is freed by the next read of its note
+    if (freeIfFinished && !voice.adsr.isActive())
+        releaseVoice(voiceIndex);
+}
+
+int Envelope::findVoice(int midiNote) const noexcept
+{
+    if (midiNote < 0 || midiNote >= numMidiNotes)
+        return -1;
+
+    return noteToVoice[midiNote];
+}
+
+void Envelope::releaseVoice(int voiceIndex) noexcept
+{
+    auto& voice = voiceEnvelopes[voiceIndex];
+    if (!voice.active)
+        return;
+
+    noteToVoice[voice.midiNote] = -1;
+    voice.active = false;
+    voice.midiNote = -1;
+    freeVoices[numFreeVoices++] = voiceIndex;
 }
 
 const std::vector<std::pair<Envelope::Mode, juce::String>>& Envelope::getModeList()
@@ -302,6 +476,30 @@ juce::ADSR::Parameters Envelope::mapToADSRParams(float attack, float decay, floa
 //==============================================================================
 // Envelope::EnvelopeADSR
 
+void Envelope::EnvelopeADSR::setSampleRate(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0.0);
+    sampleRate = newSampleRate;
+    recalculateRates();
+}
+
+void Envelope::EnvelopeADSR::setParameters(const juce::ADSR::Parameters& newParameters) noexcept
+{
+    parameters = newParameters;
+    recalculateRates();
+}
+
+const juce::ADSR::Parameters& Envelope::EnvelopeADSR::getParameters() const noexcept
+{
+    return parameters;
+}
+
+void Envelope::EnvelopeADSR::setMinimumRelease(float seconds) noexcept
+{
+    minimumRelease = juce::jmax(0.0f, seconds);
+    recalculateRates();
+}
+
 void Envelope::EnvelopeADSR::setMode(Envelope::Mode m) noexcept
 {
     mode = m;
@@ -309,65 +507,207 @@ void Envelope::EnvelopeADSR::setMode(Envelope::Mode m) noexcept
 
 void Envelope::EnvelopeADSR::noteOn() noexcept
 {
-    juce::ADSR::noteOn();
-
-    attackEnded = false;
     releaseTriggered = false;
+    fading = false;
 
-    if (mode == Envelope::Mode::AutoRelease)
+    if (attackRate > 0.0f)
     {
-        const auto& p = getParameters();
-
-        const bool isInstantStart = p.attack <= 0.0001f;
-        const bool isInstantEnd = p.release <= 0.0001f;
+        state = State::Attack;
+    }
+    else if (decayRate > 0.0f)
+    {
+        envelopeVal = 1.0f;
+        state = State::Decay;
+    }
+    else
+    {
+        envelopeVal = parameters.sustain;
+        state = State::Sustain;
+    }
 
-        if (isInstantStart)
-            attackEnded = true;
+    if (mode == Envelope::Mode::AutoRelease)
+    {
+        const bool isInstantStart = parameters.attack <= 0.0001f;
+        const bool isInstantEnd = parameters.release <= 0.0001f;
 
         if (isInstantStart && isInstantEnd)
         {
-            // Set release to a very small non-zero value to allow decay
-            auto adjustedParams = p;
-            adjustedParams.release = 0.05f;
-            juce::ADSR::setParameters(adjustedParams);
-
-            // Jump directly to release phase
-            juce::ADSR::noteOff();
+            // Jump directly to a short release so the note is still audible
+            startRelease(0.05f);
             releaseTriggered = true;
         }
     }
 }
 
+void Envelope::EnvelopeADSR::noteOff() noexcept
+{
+    // A fade keeps its own, shorter time
+    if (!fading)
+        startRelease(getReleaseSeconds());
+}
+
+void Envelope::EnvelopeADSR::fadeOut(float seconds) noexcept
+{
+    startRelease(seconds);
+    fading = (state == State::Release);
+}
+
+void Envelope::EnvelopeADSR::reset() noexcept
+{
+    envelopeVal = 0.0f;
+    state = State::Idle;
+    fading = false;
+}
+
+bool Envelope::EnvelopeADSR::isActive() const noexcept
+{
+    return state != State::Idle;
+}
+
 float Envelope::EnvelopeADSR::getNextSample() noexcept
 {
-    float value = juce::ADSR::getNextSample();
+    float value = 0.0f;
+    render(&value, 1);
+    return value;
+}
+
+void Envelope::EnvelopeADSR::render(float* dest, int numSamples) noexcept
+{
+    int i = 0;
 
-    if (mode == Envelope::Mode::AutoRelease && !releaseTriggered)
+    while (i < numSamples)
     {
-        const auto& p = getParameters();
+        const int remaining = numSamples - i;
 
-        if (!attackEnded)
-        {
-            if (value >= 0.99f)
-                attackEnded = true;
-        }
-        else
+        switch (state)
         {
-            if (value <= p.sustain)
+        case State::Idle:
+            juce::FloatVectorOperations::clear(dest + i, remaining);
+            i = numSamples;
+            break;
+
+        case State::Attack:
+            i += renderRamp(dest + i, remaining, attackRate, 1.0f);
+            break;
+
+        case State::Decay:
+            i += renderRamp(dest + i, remaining, -decayRate, parameters.sustain);
+            break;
+
+        case State::Sustain:
+            // Auto Release leaves the sustain as soon as it is reached
+            if (mode == Envelope::Mode::AutoRelease && !releaseTriggered)
             {
-                juce::ADSR::noteOff();
+                startRelease(getReleaseSeconds());
                 releaseTriggered = true;
+                break;
             }
+
+            envelopeVal = parameters.sustain;
+            juce::FloatVectorOperations::fill(dest + i, envelopeVal, remaining);
+            i = numSamples;
+            break;
+
+        case State::Release:
+            i += renderRamp(dest + i, remaining, -releaseRate, 0.0f);
+            break;
         }
     }
-
-    lastValue = value;
-    return value;
 }
 
 float Envelope::EnvelopeADSR::getCurrentValue() const noexcept
 {
-    return lastValue;
+    return envelopeVal;
+}
+
+int Envelope::EnvelopeADSR::renderRamp(float* dest, int numSamples, float rate, float target) noexcept
+{
+    // Samples until the segment reaches its target, at least one
+    const float distance = target - envelopeVal;
+    int steps = 1;
+    if (rate != 0.0f && distance * rate > 0.0f)
+        steps = static_cast<int>(std::ceil(juce::jmin(static_cast<double>(distance / rate), static_cast<double>(numSamples) + 1.0)));
+    steps = juce::jmax(1, steps);
+
+    const int count = juce::jmin(steps, numSamples);
+    const float start = envelopeVal;
+
+    // Closed form, so the loop has no carried dependency and vectorizes
+    for (int n = 0; n < count; ++n)
+        dest[n] = start + rate * static_cast<float>(n + 1);
+
+    if (count == steps)
+    {
+        dest[count - 1] = target;
+        envelopeVal = target;
+        goToNextState();
+    }
+    else
+    {
+        envelopeVal = dest[count - 1];
+    }
+
+    return count;
+}
+
+void Envelope::EnvelopeADSR::startRelease(float releaseSeconds) noexcept
+{
+    if (state == State::Idle)
+        return;
+
+    if (releaseSeconds > 0.0f)
+    {
+        releaseRate = static_cast<float>(envelopeVal / (releaseSeconds * sampleRate));
+        state = State::Release;
+    }
+    else
+    {
+        reset();
+    }
 }
 
+void Envelope::EnvelopeADSR::goToNextState() noexcept
+{
+    switch (state)
+    {
+    case State::Attack:
+        state = (decayRate > 0.0f) ? State::Decay : State::Sustain;
+        break;
+    case State::Decay:
+        state = State::Sustain;
+        break;
+    case State::Release:
+        reset();
+        break;
+    default:
+        break;
+    }
+}
 
+float Envelope::EnvelopeADSR::getReleaseSeconds() const noexcept
+{
+    return juce::jmax(parameters.release, minimumRelease);
+}
+
+void Envelope::EnvelopeADSR::recalculateRates() noexcept
+{
+    const auto getRate = [this](float distance, float timeInSeconds)
+    {
+        return timeInSeconds > 0.0f ? static_cast<float>(distance / (timeInSeconds * sampleRate)) : -1.0f;
+    };
+
+    attackRate = getRate(1.0f, parameters.attack);
+    decayRate = getRate(1.0f - parameters.sustain, parameters.decay);
+
+    // A release in progress continues from where it is at the new speed, fades keep theirs
+    if (state == State::Release && !fading)
+    {
+        const float releaseSeconds = getReleaseSeconds();
+        releaseRate = (releaseSeconds > 0.0f) ? static_cast<float>(envelopeVal / (releaseSeconds * sampleRate)) : envelopeVal;
+    }
+
+    // Segments whose length dropped to zero end right away
+    if ((state == State::Attack && attackRate <= 0.0f)
+        || (state == State::Decay && (decayRate <= 0.0f || envelopeVal <= parameters.sustain)))
+        goToNextState();
+}
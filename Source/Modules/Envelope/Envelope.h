@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Common.h"
+#include "../Knob/ModulationTarget.h"
 #include <JuceHeader.h>
 
 /**
@@ -33,14 +34,39 @@ public:
 
     /**
      * @class Envelope::EnvelopeADSR
-     * @brief A custom ADSR subclass that supports Auto Release behavior.
+     * @brief A linear ADSR that renders whole blocks and supports Auto Release behavior.
      *
-     * Extends juce::ADSR with auto-release logic that triggers release
-     * without an external note-off in Auto-Release mode.
+     * Follows juce::ADSR's timing and segment shapes. Because every segment is
+     * a straight line, a block is rendered one segment at a time in closed form
+     * instead of stepping a state machine per sample. In Auto-Release mode the
+     * release starts on its own once the decay reaches the sustain level.
      */
-    class EnvelopeADSR : public juce::ADSR
+    class EnvelopeADSR
     {
     public:
+        /**
+         * @brief Sets the sample rate used to convert segment times into rates.
+         * @param newSampleRate Audio sample rate in Hz.
+         */
+        void setSampleRate(double newSampleRate) noexcept;
+
+        /**
+         * @brief Sets the ADSR times (seconds) and sustain level.
+         * @param newParameters Parameters to use.
+         */
+        void setParameters(const juce::ADSR::Parameters& newParameters) noexcept;
+
+        /**
+         * @brief Returns the current ADSR parameters.
+         */
+        const juce::ADSR::Parameters& getParameters() const noexcept;
+
+        /**
+         * @brief Sets the shortest release, so a zero release still fades instead of cutting.
+         * @param seconds Release floor in seconds, 0 for none.
+         */
+        void setMinimumRelease(float seconds) noexcept;
+
         /**
          * @brief Sets the envelope's playback mode.
          * @param m The desired playback mode (Normal or Auto Release).
@@ -53,22 +79,93 @@ public:
         void noteOn() noexcept;
 
         /**
-         * @brief Computes the next envelope value and applies auto-release logic if needed.
+         * @brief Starts the release segment.
+         */
+        void noteOff() noexcept;
+
+        /**
+         * @brief Releases over a fixed time, ignoring later noteOff() calls and release changes.
+         * @param seconds Time to fall from the current value to zero.
+         */
+        void fadeOut(float seconds) noexcept;
+
+        /**
+         * @brief Returns the envelope to idle at zero.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Returns true while the envelope has not finished its release.
+         */
+        bool isActive() const noexcept;
+
+        /**
+         * @brief Computes the next envelope value.
          * @return The next sample value of the envelope, between 0.0 and 1.0.
          */
         float getNextSample() noexcept;
 
+        /**
+         * @brief Renders the next block of envelope values.
+         * @param dest Destination for numSamples values between 0.0 and 1.0.
+         * @param numSamples Number of samples to render.
+         */
+        void render(float* dest, int numSamples) noexcept;
+
         /**
          * @brief Returns the last computed envelope output without advancing state.
          */
         float getCurrentValue() const noexcept;
 
-        float lastValue = 0.0f; ///< Last envelope output sample.
-
     private:
+        /**
+         * @brief Internal segment of the envelope.
+         */
+        enum class State
+        {
+            Idle,
+            Attack,
+            Decay,
+            Sustain,
+            Release
+        };
+
+        /**
+         * @brief Renders part of a linear segment.
+         * @param dest Destination samples.
+         * @param numSamples Samples left in the block.
+         * @param rate Change per sample (negative for falling segments).
+         * @param target Value that ends the segment.
+         * @return Number of samples written, less than numSamples only if the segment ended.
+         */
+        int renderRamp(float* dest, int numSamples, float rate, float target) noexcept;
+
+        /**
+         * @brief Starts the release segment from the current value.
+         * @param releaseSeconds Release time to use.
+         */
+        void startRelease(float releaseSeconds) noexcept;
+
+        /** @brief Moves to the segment that follows the current one. */
+        void goToNextState() noexcept;
+
+        /** @brief Recomputes the per-sample rates from the parameters. */
+        void recalculateRates() noexcept;
+
+        /** @brief Returns the release time with the floor applied. */
+        float getReleaseSeconds() const noexcept;
+
+        juce::ADSR::Parameters parameters;            ///< Segment times (seconds) and sustain level
+        double sampleRate = 44100.0;                   ///< Sample rate used for the rates
+        State state = State::Idle;                     ///< Current segment
+        float envelopeVal = 0.0f;                      ///< Current envelope output
+        float attackRate = 0.0f;                       ///< Attack increment per sample
+        float decayRate = 0.0f;                        ///< Decay decrement per sample
+        float releaseRate = 0.0f;                      ///< Release decrement per sample
+        float minimumRelease = 0.0f;                   ///< Shortest release in seconds
         Envelope::Mode mode = Envelope::Mode::Normal;  ///< Current playback mode.
-        bool attackEnded = false;                      ///< Attack phase completed flag.
         bool releaseTriggered = false;                 ///< Auto-release triggered flag.
+        bool fading = false;                           ///< True while a fadeOut() is under way.
     };
 
     /**
@@ -95,9 +192,9 @@ public:
     /**
      * @brief Get ADSR parameter specifications for a given envelope index.
      * @param index Envelope index.
-     * @return Vector containing ADSR parameter specs.
+     * @return ADSR parameter specs, built once per process.
      */
-    static std::vector<KnobParamSpecs> getParamSpecs(int index);
+    static const std::vector<KnobParamSpecs>& getParamSpecs(int index);
 
     /**
      * @brief Returns parameter spec for the envelope mode at given index.
@@ -122,26 +219,83 @@ public:
      */
     void setParameters(float attack, float decay, float sustain, float release);
 
-    /** @brief Updates mode and ADSR parameters from APVTS. */
+    /** @brief Updates mode and ADSR parameters from APVTS, with any modulation applied. */
     void updateFromParameters();
 
+    /**
+     * @brief Assigns the modulation proxy of an ADSR stage parameter.
+     * @param stage The ADSR stage.
+     * @param target Proxy for that parameter, or nullptr to detach.
+     */
+    void setModulationTarget(ADSR stage, const ModulationTarget* target);
+
+    /**
+     * @brief Sets the sample rate and preallocates the per-voice block buffers.
+     * @param newSampleRate Audio sample rate in Hz.
+     * @param samplesPerBlock Largest block size expected from the host.
+     */
+    void prepareToPlay(double newSampleRate, int samplesPerBlock);
+
     /**
      * @brief Sets the sample rate for internal ADSR instances.
      * @param newSampleRate Audio sample rate (e.g., 44100.0 Hz).
      */
     void setSampleRate(double newSampleRate);
 
+    /**
+     * @brief Starts a new block on the envelope clock.
+     *
+     * Each voice renders every sample of the block exactly once, lazily as
+     * notes are read or events arrive, and endBlock() renders the rest.
+     *
+     * @param numSamples Number of samples in the block.
+     */
+    void beginBlock(int numSamples);
+
+    /**
+     * @brief Renders every voice to the end of the block and frees finished voices.
+     */
+    void endBlock();
+
     /**
      * @brief Trigger note-on for a specific MIDI note.
      * @param midiNote MIDI note number to activate.
+     * @param sampleOffset Position of the event within the current block.
+     * @return False if every voice is taken, in which case the note must not be played.
      */
-    void noteOn(int midiNote);
+    bool noteOn(int midiNote, int sampleOffset = 0);
 
     /**
      * @brief Trigger note-off for a specific MIDI note.
      * @param midiNote MIDI note number to release.
+     * @param sampleOffset Position of the event within the current block.
      */
-    void noteOff(int midiNote);
+    void noteOff(int midiNote, int sampleOffset = 0);
+
+    /**
+     * @brief Fades a note out quickly, used when its voice is stolen.
+     * @param midiNote MIDI note number to fade.
+     * @param sampleOffset Position of the event within the current block.
+     * @param seconds Fade time.
+     */
+    void fadeOut(int midiNote, int sampleOffset, float seconds);
+
+    /**
+     * @brief Frees a note's voice at once, without a release.
+     * @param midiNote MIDI note number to stop.
+     */
+    void stopNote(int midiNote);
+
+    /**
+     * @brief Hands a note's voice over to another note, without restarting it.
+     *
+     * Used by the Mono and Legato voice modes; a voice the new note already
+     * had is stopped first.
+     *
+     * @param fromNote MIDI note number whose voice moves.
+     * @param toNote MIDI note number the voice plays from now on.
+     */
+    void moveNote(int fromNote, int toNote);
 
     /**
      * @brief Resets all active voices' ADSR envelopes.
@@ -155,6 +309,33 @@ public:
      */
     bool isNoteActive(int midiNote) const;
 
+    /**
+     * @brief Returns a note's envelope value at the end of the last rendered range.
+     * @param midiNote MIDI note number.
+     * @return Value between 0.0 and 1.0, or -1 if the note has no voice.
+     */
+    float getNoteLevel(int midiNote) const;
+
+    /**
+     * @brief Returns the release time set on the release parameter, without modulation.
+     *
+     * Safe to call from any thread.
+     *
+     * @return Release time in seconds.
+     */
+    float getReleaseTimeSeconds() const;
+
+    /**
+     * @brief Sets the release micro-fade every voice releases over at least.
+     *
+     * A note-off releases at its own sample, so this fade bounds both the
+     * click of a short release and how long a released note keeps sounding
+     * when the release is zero. Audio thread, once per block.
+     *
+     * @param seconds Fade time in seconds, 0 to allow hard cuts.
+     */
+    void setReleaseFade(float seconds) noexcept;
+
     /**
      * @brief Returns true if any voice is currently active.
      * @return True if any envelope voice is active or releasing.
@@ -162,22 +343,51 @@ public:
     bool isActive() const;
 
     /**
-     * @brief Gets next envelope sample for a given MIDI note.
+     * @brief Returns the number of voices in use, releasing and fading ones included.
+     */
+    int getNumActiveVoices() const noexcept;
+
+    /**
+     * @brief Returns the bytes of the block buffer prepareToPlay() allocated.
+     */
+    size_t getMemoryBytes() const noexcept;
+
+    /**
+     * @brief Copies a range of the current block's envelope values for a given MIDI note.
+     *
+     * Notes without a voice read as silence. Reading the same range again
+     * returns the same values, the voice only advances once per sample.
+     *
      * @param midiNote MIDI note number.
-     * @return Next envelope output sample.
+     * @param dest Destination for numSamples envelope values.
+     * @param startSample First sample of the range within the current block.
+     * @param numSamples Number of samples to copy.
      */
-    float getNextSampleForNote(int midiNote);
+    void renderNote(int midiNote, float* dest, int startSample, int numSamples);
 
     /**
-     * @brief Computes mixed output from all active voices for modulation.
-     * @return Normalized modulation level [0.0, 1.0].
+     * @brief Writes the average of the sounding voices over a range of the current block, sample by sample.
+     *
+     * Every voice is rendered to the end of the range first, so the block's
+     * events up to that point must have been applied and none may start a
+     * voice inside the range. Notes read over the range afterwards get the
+     * same values, and a voice that finishes within it stays readable until
+     * its note reads it or endBlock() runs.
+     *
+     * @param dest Destination for numSamples values between 0.0 and 1.0.
+     * @param startSample First sample of the range within the current block.
+     * @param numSamples Number of samples to write.
      */
-    float getModulationValue() const;
+    void renderModulation(float* dest, int startSample, int numSamples);
 
     /**
-     * @brief Advances all active voices by one sample.
+     * @brief Computes mixed output from all active voices for modulation.
+     *
+     * Uses the values each voice rendered at the end of the last block.
+     *
+     * @return Normalized modulation level [0.0, 1.0].
      */
-    void tick();
+    float getModulationValue() const;
 
     /**
      * @brief Returns list of supported envelope modes and display names.
@@ -213,8 +423,14 @@ public:
 
     static constexpr float MIN_ADSR_TIME_MS = 1.0f;    ///< Minimum ADSR time in milliseconds.
     static constexpr float MAX_ADSR_TIME_MS = 5000.0f; ///< Maximum ADSR time in milliseconds.
+    static constexpr int maxPolyphony = 16;            ///< Number of simultaneous notes supported
+    static constexpr int numFadingVoices = 4;          ///< Extra voices for stolen notes fading out
+    static constexpr int voiceCapacity = maxPolyphony + numFadingVoices; ///< Voices in the pool
 
 private:
+    /** @brief Builds the specs that getParamSpecs() caches. */
+    static std::vector<KnobParamSpecs> makeParamSpecs(int index);
+
     juce::AudioProcessorValueTreeState& apvts; ///< Reference to the global APVTS
     juce::String name;                         ///< Display name of the envelope
     Mode mode = Mode::Normal;                  ///< Current playback mode
@@ -224,17 +440,49 @@ private:
     float decayNorm{ 0.0f };                   ///< Current normalized decay parameter
     float sustainNorm{ 1.0f };                 ///< Current normalized sustain parameter
     float releaseNorm{ 0.0f };                 ///< Current normalized release parameter
+    float releaseFade{ 0.0f };                 ///< Release micro-fade in seconds
+    std::array<const ModulationTarget*, static_cast<size_t>(ADSR::Count)> modulationTargets{}; ///< Modulation proxies per ADSR stage
+    std::atomic<float>* modeHandle = nullptr;                                                   ///< Cached handle of the mode parameter
+    std::array<std::atomic<float>*, static_cast<size_t>(ADSR::Count)> stageHandles{};          ///< Cached handles of the ADSR parameters
 
     struct VoiceEnvelope 
     { ///< Represents a per-note envelope voice
         int midiNote = -1;             ///< MIDI note assigned to this voice
         bool active = false;           ///< True if voice is in use
         EnvelopeADSR adsr;             ///< Custom ADSR supporting AutoRelease
-        juce::ADSR::Parameters params; ///< Cached ADSR parameters
+        int renderedSamples = 0;       ///< Samples of the current block already rendered
     };
 
-    static constexpr int maxPolyphony = 16;                 ///< Number of simultaneous voices supported
-    std::array<VoiceEnvelope, maxPolyphony> voiceEnvelopes; ///< Fixed pool of envelope voices
+    static constexpr int numMidiNotes = 128; ///< Size of the note to voice table
+
+    std::array<VoiceEnvelope, voiceCapacity> voiceEnvelopes; ///< Fixed pool of envelope voices
+    std::array<int, numMidiNotes> noteToVoice;              ///< Voice index per MIDI note, -1 if none
+    std::array<int, voiceCapacity> freeVoices;              ///< Stack of unused voice indices
+    int numFreeVoices = 0;                                  ///< Number of entries in freeVoices
+    juce::AudioBuffer<float> voiceBlocks;                   ///< Current block's envelope values, one channel per voice
+    int blockSize = 0;                                      ///< Number of samples in the current block
+    int preparedBlockSize = 0;                              ///< Samples per voice prepareToPlay() allocated
+
+    /**
+     * @brief Renders a voice up to a position in the current block.
+     * @param voiceIndex Index of the voice.
+     * @param position Block position to render up to.
+     * @param freeIfFinished Frees the voice if its release has ended, false to keep it readable.
+     */
+    void renderVoiceTo(int voiceIndex, int position, bool freeIfFinished = true);
+
+    /**
+     * @brief Returns the voice playing a note.
+     * @param midiNote MIDI note number.
+     * @return Voice index, or -1 if the note has no voice.
+     */
+    int findVoice(int midiNote) const noexcept;
+
+    /**
+     * @brief Frees a voice and clears its note from the lookup table.
+     * @param voiceIndex Index of the voice to free.
+     */
+    void releaseVoice(int voiceIndex) noexcept;
 
     /**
      * @brief Converts normalized ADSR parameters into a JUCE ADSR parameters struct.
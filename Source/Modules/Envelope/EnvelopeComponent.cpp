@@ -48,7 +48,7 @@ EnvelopeComponent::EnvelopeComponent(juce::AudioProcessorValueTreeState& apvts,
         apvts, linkSpec.paramID, linkTargetSelector);
 
     // ADSR Knobs
-    auto specs = Envelope::getParamSpecs(index);
+    const auto& specs = Envelope::getParamSpecs(index);
     knobs = {
         { &attackKnob,  Envelope::ADSR::Attack,  FormattingUtils::FormatType::Time },
         { &decayKnob,   Envelope::ADSR::Decay,   FormattingUtils::FormatType::Time },
@@ -61,6 +61,7 @@ EnvelopeComponent::EnvelopeComponent(juce::AudioProcessorValueTreeState& apvts,
         setupKnob(apvts, *knobPtr, spec, formatType);
     }
 
+    updateEnvelopeGraph();
     updateTheme();
 }
 
@@ -83,16 +84,6 @@ EnvelopeComponent::~EnvelopeComponent()
     }
 }
 
-void EnvelopeComponent::registerModulationParameters(int index, juce::AudioProcessorValueTreeState::ParameterLayout& layout)
-{
-    const auto specs = Envelope::getParamSpecs(index);
-
-    for (const auto& spec : specs)
-    {
-        KnobModulationEngine::registerParameters(layout, spec.id);
-    }
-}
-
 void EnvelopeComponent::setLinkableTargets(const std::unordered_map<std::string, Linkable*>& targets)
 {
     linkableTargets = targets;
@@ -116,7 +107,7 @@ void EnvelopeComponent::setLinkableTargets(const std::unordered_map<std::string,
             {
                 if (currentlyLinkedTarget)
                 {
-                    currentlyLinkedTarget->setEnvelope(nullptr);
+                    processor.linkEnvelope(currentlyLinkedTarget, nullptr);
                     currentlyLinkedTarget = nullptr;
                 }
 
@@ -132,11 +123,11 @@ void EnvelopeComponent::setLinkableTargets(const std::unordered_map<std::string,
                 // Unlink the previous target
                 if (currentlyLinkedTarget && currentlyLinkedTarget != it->second)
                 {
-                    currentlyLinkedTarget->setEnvelope(nullptr);
+                    processor.linkEnvelope(currentlyLinkedTarget, nullptr);
                 }
 
                 processor.registerEnvelopeLinkOwnership(it->second, this);
-                it->second->setEnvelope(processor.getEnvelope(envelopeIndex));
+                processor.linkEnvelope(it->second, processor.getEnvelope(envelopeIndex));
                 currentlyLinkedTarget = it->second;
             }
 
@@ -147,7 +138,7 @@ void EnvelopeComponent::unlinkTarget(Linkable* target)
 {
     if (currentlyLinkedTarget == target)
     {
-        target->setEnvelope(nullptr);
+        processor.linkEnvelope(target, nullptr);
         currentlyLinkedTarget = nullptr;
         linkTargetSelector.setSelectedId(1, juce::NotificationType::sendNotificationSync); // Reset UI to "-"
         linkTargetSelector.repaint();
@@ -167,7 +158,7 @@ void EnvelopeComponent::paint(juce::Graphics& g)
 
     g.setColour(UI::Colors::EnvelopeGraphStroke);
     g.drawRect(envelopeGraphArea, 2);
-    drawEnvelopeGraph(g);
+    graph.draw(g);
 }
 
 void EnvelopeComponent::resized()
@@ -202,6 +193,7 @@ void EnvelopeComponent::resized()
     envelopeGraphArea.removeFromLeft(graphLeftMargin);
     envelopeGraphArea.reduce(graphReduceX, graphReduceY);
     envelopeGraphArea.translate(graphTranslateX, graphTranslateY);
+    graph.setGraphBounds(envelopeGraphArea);
 
     // ADSR Knobs Area
     auto knobRow = rightColumn;
@@ -228,6 +220,7 @@ void EnvelopeComponent::updateTheme()
         knobPtr->updateTheme();
     }
 
+    graph.invalidateBackground();
     repaint();
 }
 
@@ -262,7 +255,7 @@ void EnvelopeComponent::setupKnob(juce::AudioProcessorValueTreeState& apvts, Kno
     knob.getSlider().updateText();
 }
 
-void EnvelopeComponent::drawEnvelopeGraph(juce::Graphics& g)
+void EnvelopeComponent::updateEnvelopeGraph()
 {
     float attackNorm = attackKnob.getSliderValue();
     float decayNorm = decayKnob.getSliderValue();
@@ -273,49 +266,11 @@ void EnvelopeComponent::drawEnvelopeGraph(juce::Graphics& g)
     float decayMs = FormattingUtils::normalizedToValue(decayNorm, FormattingUtils::FormatType::Time, Envelope::MIN_ADSR_TIME_MS, Envelope::MAX_ADSR_TIME_MS);
     float releaseMs = FormattingUtils::normalizedToValue(releaseNorm, FormattingUtils::FormatType::Time, Envelope::MIN_ADSR_TIME_MS, Envelope::MAX_ADSR_TIME_MS);
 
-    EnvelopeGraph graph;
     graph.setParameters(attackMs, decayMs, sustain, releaseMs);
-    graph.setGraphBounds(envelopeGraphArea);
-    graph.generate();
-
-    g.setFont(12.0f);
-
-    // Draw Y grid lines
-    g.setColour(UI::Colors::EnvelopeGraphGridLines);
-    for (const auto& grid : graph.getYGridLines())
-    {
-        g.drawLine(grid.line);
-    }
-
-    g.setColour(UI::Colors::EnvelopeGraphGridText);
-    for (const auto& grid : graph.getYGridLines())
-    {
-        g.drawText(grid.label,
-            static_cast<int>(grid.labelPosition.getX()), static_cast<int>(grid.labelPosition.getY()),
-           40, 16, grid.justification);
-    }
-
-    // Draw X grid lines
-    g.setColour(UI::Colors::EnvelopeGraphGridLines);
-    for (const auto& grid : graph.getXGridLines())
-    {
-        g.drawLine(grid.line);
-    }
-
-    g.setColour(UI::Colors::EnvelopeGraphGridText);
-    for (const auto& grid : graph.getXGridLines())
-    {
-        g.drawText(grid.label,
-            static_cast<int>(grid.labelPosition.getX()), static_cast<int>(grid.labelPosition.getY()),
-            40, 16, grid.justification);
-    }
-
-    // Draw envelope path
-    g.setColour(UI::Colors::EnvelopeGraphCurve);
-    g.strokePath(graph.getEnvelopePath(), juce::PathStrokeType(2.0f));
 }
 
 void EnvelopeComponent::sliderValueChanged(juce::Slider*)
 {
+    updateEnvelopeGraph();
     repaint();
 }
\ No newline at end of file
@@ -28,13 +28,6 @@ public:
     /** @brief Destructor. Releases APVTS attachments to prevent UI crashes. */
     ~EnvelopeComponent() override;
 
-    /**
-     * @brief Registers modulation-related parameters for all knobs.
-     * @param index Zero-based index of the envelope instance.
-     * @param layout Reference to the APVTS parameter layout.
-     */
-    static void registerModulationParameters(int index, juce::AudioProcessorValueTreeState::ParameterLayout& layout);
-
     /**
      * @brief Sets the list of linkable targets for this envelope.
      * @param targets Map of display names to Linkable pointers.
@@ -84,10 +77,9 @@ private:
     void setupKnob(juce::AudioProcessorValueTreeState& apvts, Knob& knob, const Envelope::KnobParamSpecs& spec, FormattingUtils::FormatType formatType);
 
     /**
-     * @brief Draws the ADSR envelope curve within the designated area.
-     * @param g Graphics context to draw onto.
+     * @brief Pushes the current ADSR knob values to the envelope graph.
      */
-    void drawEnvelopeGraph(juce::Graphics& g);
+    void updateEnvelopeGraph();
 
     /**
      * @brief Called when a slider value changes to update the envelope graph.
@@ -126,6 +118,7 @@ private:
     juce::Label linkLabel;                                        ///< Label for link target selector
     ComboBox linkTargetSelector;                                  ///< ComboBox for link target selection
     juce::Rectangle<int> envelopeGraphArea;                       ///< Bounds for drawing envelope graph
+    EnvelopeGraph graph;                                          ///< Cached envelope curve and grid
     Linkable* currentlyLinkedTarget = nullptr;                    ///< Currently linked target
 
     std::vector<std::tuple<Knob*, Envelope::ADSR, FormattingUtils::FormatType>> knobs; ///< Knob list for loop-based init
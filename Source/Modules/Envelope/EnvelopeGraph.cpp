@@ -51,31 +51,113 @@ float EnvelopeGraph::getTimeToAmplitude(const std::vector<EnvelopePoint>& points
 
 void EnvelopeGraph::setParameters(float attack, float decay, float sustain, float release)
 {
+    if (attack == attackMs && decay == decayMs && sustain == sustainLevel && release == releaseMs)
+        return;
+
     attackMs = attack;
     decayMs = decay;
     sustainLevel = sustain;
     releaseMs = release;
+    pathDirty = true;
+
+    // The time grid only moves when the relaxed axis limit does
+    const float newLimit = getRelaxedXLimit(getTotalDuration(attackMs, decayMs, releaseMs));
+    if (newLimit != xLimit)
+    {
+        xLimit = newLimit;
+        gridDirty = true;
+    }
 }
 
 void EnvelopeGraph::setGraphBounds(juce::Rectangle<int> bounds)
 {
+    if (bounds == graphBounds)
+        return;
+
     graphBounds = bounds;
+    pathDirty = gridDirty = true;
 }
 
 void EnvelopeGraph::generate()
 {
-    // Clear outputs
-    envelopePath.clear();
-    xGridLines.clear();
-    yGridLines.clear();
+    if (pathDirty)
+    {
+        envelopePath.clear();
+        computeEnvelopePath();
+        pathDirty = false;
+    }
 
-    // Compute relaxed X limit
-    float totalDuration = getTotalDuration(attackMs, decayMs, releaseMs);
-    xLimit = getRelaxedXLimit(totalDuration);
+    if (gridDirty)
+    {
+        xGridLines.clear();
+        yGridLines.clear();
+        computeYGridLines();
+        computeXGridLines();
+        gridDirty = false;
+        invalidateBackground();
+    }
+}
 
-    computeEnvelopePath();
-    computeYGridLines();
-    computeXGridLines();
+void EnvelopeGraph::invalidateBackground()
+{
+    backgroundImage = {};
+}
+
+void EnvelopeGraph::draw(juce::Graphics& g)
+{
+    generate();
+
+    if (graphBounds.isEmpty())
+        return;
+
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (backgroundImage.isNull() || scale != backgroundScale)
+        renderBackground(scale);
+
+    g.drawImage(backgroundImage, backgroundArea.toFloat());
+
+    g.setColour(UI::Colors::EnvelopeGraphCurve);
+    g.strokePath(envelopePath, juce::PathStrokeType(curveThickness));
+}
+
+void EnvelopeGraph::renderBackground(float scale)
+{
+    // Labels sit outside the plot, so the layer covers them too
+    backgroundArea = graphBounds;
+    for (const auto* lines : { &xGridLines, &yGridLines })
+        for (const auto& grid : *lines)
+            backgroundArea = backgroundArea.getUnion(juce::Rectangle<float>(grid.labelPosition.getX(), grid.labelPosition.getY(),
+                static_cast<float>(labelWidth), static_cast<float>(labelHeight)).getSmallestIntegerContainer());
+
+    backgroundScale = scale;
+    backgroundImage = juce::Image(juce::Image::ARGB,
+        juce::jmax(1, juce::roundToInt(backgroundArea.getWidth() * scale)),
+        juce::jmax(1, juce::roundToInt(backgroundArea.getHeight() * scale)),
+        true);
+
+    juce::Graphics imageGraphics(backgroundImage);
+    imageGraphics.addTransform(juce::AffineTransform::translation(static_cast<float>(-backgroundArea.getX()),
+                                                                  static_cast<float>(-backgroundArea.getY()))
+                                   .scaled(scale));
+    drawGrid(imageGraphics);
+}
+
+void EnvelopeGraph::drawGrid(juce::Graphics& g) const
+{
+    g.setFont(labelFontSize);
+
+    for (const auto* lines : { &yGridLines, &xGridLines })
+    {
+        g.setColour(UI::Colors::EnvelopeGraphGridLines);
+        for (const auto& grid : *lines)
+            g.drawLine(grid.line);
+
+        g.setColour(UI::Colors::EnvelopeGraphGridText);
+        for (const auto& grid : *lines)
+            g.drawText(grid.label,
+                static_cast<int>(grid.labelPosition.getX()), static_cast<int>(grid.labelPosition.getY()),
+                labelWidth, labelHeight, grid.justification);
+    }
 }
 
 const juce::Path& EnvelopeGraph::getEnvelopePath() const
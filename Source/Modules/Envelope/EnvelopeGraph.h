@@ -26,6 +26,10 @@ struct GridLine
 /**
  * @class EnvelopeGraph
  * @brief Compute ADSR points, path, and grid for drawing.
+ *
+ * The grid and its labels are cached in an image that is only redrawn when the
+ * bounds, the time axis range or the theme change; the curve is only rebuilt
+ * when the ADSR values change.
  */
 class EnvelopeGraph
 {
@@ -83,9 +87,18 @@ public:
      */
     void setGraphBounds(juce::Rectangle<int> bounds);
 
-    /** @brief Generate path and grid lines. */
+    /** @brief Regenerate whatever the last parameter or bounds change invalidated. */
     void generate();
 
+    /** @brief Drop the cached grid image so it is redrawn with the current theme colours. */
+    void invalidateBackground();
+
+    /**
+     * @brief Draw the cached grid layer and the envelope curve.
+     * @param g Graphics context to draw into.
+     */
+    void draw(juce::Graphics& g);
+
     /**
      * @brief Get the envelope curve path.
      * @return JUCE Path of the envelope.
@@ -118,6 +131,17 @@ private:
                                       
     const float yAxisExtra = 0.05f;   ///< Extra Y-axis headroom
 
+    bool pathDirty = true;            ///< Curve must be rebuilt
+    bool gridDirty = true;            ///< Grid lines must be recomputed
+    juce::Image backgroundImage;      ///< Cached grid and labels, null when invalid
+    juce::Rectangle<int> backgroundArea; ///< Area covered by the cached image, labels included
+    float backgroundScale = 1.0f;     ///< Pixel scale the cached image was rendered at
+
+    static constexpr int labelWidth = 40;         ///< Grid label box width
+    static constexpr int labelHeight = 16;        ///< Grid label box height
+    static constexpr float labelFontSize = 12.0f; ///< Grid label font size
+    static constexpr float curveThickness = 2.0f; ///< Curve stroke width
+
     /**
      * @brief Compute the envelope curve path based on ADSR parameters.
      */
@@ -132,4 +156,16 @@ private:
      * @brief Compute X-axis grid lines (time grid).
      */
     void computeXGridLines();
+
+    /**
+     * @brief Render the grid lines and labels into the cached image.
+     * @param scale Physical pixels per logical pixel of the target context.
+     */
+    void renderBackground(float scale);
+
+    /**
+     * @brief Draw the grid lines and labels.
+     * @param g Graphics context to draw into.
+     */
+    void drawGrid(juce::Graphics& g) const;
 };
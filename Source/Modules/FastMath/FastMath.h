@@ -0,0 +1,211 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstring>
+
+/**
+ * @namespace FastMath
+ * @brief Accuracy-bounded approximations of the transcendental functions used on the audio thread.
+ *
+ * Every function is branch-free (selects only) and inline, so loops calling it
+ * auto-vectorize. The error bounds below are the measured maxima over the stated
+ * input range at float precision; the benchmark's --accuracy mode checks them.
+ */
+namespace FastMath
+{
+    /**
+     * @brief Rational tanh approximation.
+     *
+     * (7, 6) Pade approximant, clamped to x in [-tanhClamp, tanhClamp] where it reaches +-1.
+     * Absolute error below 1.0e-4 for all x; odd and monotonic, so it is safe as a waveshaper.
+     *
+     * @param x Input value.
+     * @return Approximation of tanh(x).
+     */
+    inline float tanh(float x) noexcept
+    {
+        constexpr float tanhClamp = 4.97f;
+        x = juce::jlimit(-tanhClamp, tanhClamp, x);
+        const float x2 = x * x;
+        const float numerator = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float denominator = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return juce::jlimit(-1.0f, 1.0f, numerator / denominator);
+    }
+
+    /**
+     * @brief Polynomial arctangent approximation.
+     *
+     * Degree 9 odd polynomial on [-1, 1], folded through atan(x) = +-pi/2 - atan(1/x) outside it.
+     * Absolute error below 2.0e-4 for all x.
+     *
+     * @param x Input value.
+     * @return Approximation of atan(x).
+     */
+    inline float atan(float x) noexcept
+    {
+        const float ax = std::abs(x);
+        const bool folded = ax > 1.0f;
+        const float t = folded ? 1.0f / juce::jmax(ax, 1.0e-30f) : ax;
+        const float t2 = t * t;
+        const float r = t * (0.99999990f + t2 * (-0.33316042f + t2 * (0.19471757f + t2 * (-0.10988088f + t2 * 0.03391099f))));
+        const float shaped = folded ? juce::MathConstants<float>::halfPi - r : r;
+        return std::copysign(shaped, x);
+    }
+
+    /**
+     * @brief Polynomial sine approximation.
+     *
+     * Reduces x to [-pi/2, pi/2] and evaluates a degree 7 odd polynomial.
+     * Absolute error below 6.0e-6 for |x| up to 64 radians; beyond that precision
+     * drops with the float resolution of the reduction, to about 1.0e-4 at 2000 radians.
+     *
+     * @param x Angle in radians.
+     * @return Approximation of sin(x).
+     */
+    inline float sin(float x) noexcept
+    {
+        constexpr float invTwoPi = 1.0f / juce::MathConstants<float>::twoPi;
+
+        // Wrap to [-pi, pi]
+        x -= juce::MathConstants<float>::twoPi * std::nearbyint(x * invTwoPi);
+
+        // Reflect into [-pi/2, pi/2] where the polynomial is fitted
+        const float pi = juce::MathConstants<float>::pi;
+        x = (x > juce::MathConstants<float>::halfPi) ? pi - x : x;
+        x = (x < -juce::MathConstants<float>::halfPi) ? -pi - x : x;
+
+        const float x2 = x * x;
+        return x * (0.99999999f + x2 * (-0.16666495f + x2 * (0.0083239389f + x2 * -0.00018846443f)));
+    }
+
+    /**
+     * @brief Polynomial cosine approximation, same error bound as sin().
+     * @param x Angle in radians.
+     * @return Approximation of cos(x).
+     */
+    inline float cos(float x) noexcept
+    {
+        return sin(x + juce::MathConstants<float>::halfPi);
+    }
+
+    /**
+     * @brief Tangent approximation, as sin() over cos().
+     *
+     * Relative error below 6.0e-6 for x in [0, 1.52], which covers the bilinear
+     * prewarp tan(pi * f / fs) up to 0.484 fs.
+     *
+     * @param x Angle in radians, within (-pi/2, pi/2).
+     * @return Approximation of tan(x).
+     */
+    inline float tan(float x) noexcept
+    {
+        return sin(x) / cos(x);
+    }
+
+    /**
+     * @brief Fast base-2 exponential.
+     *
+     * Splits x into integer and fractional parts, evaluates a degree 5 polynomial for
+     * the fraction and adds the integer part straight into the exponent bits.
+     * Relative error below 2.5e-7 for x in [-126, 127]; inputs outside are clamped.
+     *
+     * @param x Exponent.
+     * @return Approximation of 2^x.
+     */
+    inline float exp2(float x) noexcept
+    {
+        x = juce::jlimit(-126.0f, 127.0f, x);
+        const float whole = std::floor(x);
+        const float f = x - whole;
+
+        const float mantissa = 0.99999990f + f * (0.69315449f + f * (0.24014182f + f * (0.055860337f + f * (0.0089495904f + f * 0.0018937541f))));
+
+        uint32_t bits;
+        std::memcpy(&bits, &mantissa, sizeof(bits));
+        bits += static_cast<uint32_t>(static_cast<int32_t>(whole)) << 23;
+
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    /**
+     * @brief Fast base-2 logarithm.
+     *
+     * Takes the exponent from the float bits and evaluates an atanh series for the
+     * mantissa, centred on 1 so its argument stays within [-0.172, 0.172].
+     * Absolute error below 2.5e-6 for x in [2^-16, 2^16]; further out the float
+     * rounding of the result dominates, up to 6.0e-6 over all positive normal x.
+     * Returns about -126 for x <= 0.
+     *
+     * @param x Input value.
+     * @return Approximation of log2(x).
+     */
+    inline float log2(float x) noexcept
+    {
+        x = juce::jmax(x, std::numeric_limits<float>::min());
+
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        int exponent = static_cast<int>((bits >> 23) & 0xff) - 127;
+        bits = (bits & 0x007fffffu) | 0x3f800000u;
+
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+
+        // Move the mantissa to [sqrt(0.5), sqrt(2)) so the series converges fast
+        const bool high = m > juce::MathConstants<float>::sqrt2;
+        m = high ? m * 0.5f : m;
+        exponent += high ? 1 : 0;
+
+        const float t = (m - 1.0f) / (m + 1.0f);
+        const float t2 = t * t;
+        constexpr float twoOverLn2 = 2.8853900817779268f;
+        return static_cast<float>(exponent) + twoOverLn2 * t * (1.0f + t2 * (1.0f / 3.0f + t2 * 0.2f));
+    }
+
+    /**
+     * @brief Converts a pitch offset in cents to a frequency ratio.
+     * @param cents Offset in cents.
+     * @return Ratio 2^(cents / 1200), relative error below 2.5e-7 within +-1200 cents.
+     */
+    inline float centsToRatio(float cents) noexcept
+    {
+        return exp2(cents * (1.0f / 1200.0f));
+    }
+
+    /**
+     * @brief Converts a linear gain to decibels, for metering.
+     * @param gain Linear gain.
+     * @param minusInfinityDb Value returned for gains at or below its own level.
+     * @return Gain in dB, absolute error below 2.5e-5 dB for gains from -100 dB to +24 dB.
+     */
+    inline float gainToDecibels(float gain, float minusInfinityDb = -100.0f) noexcept
+    {
+        constexpr float dbPerOctave = 6.0205999132796239f; // 20 * log10(2)
+        return juce::jmax(minusInfinityDb, dbPerOctave * log2(gain));
+    }
+
+    /**
+     * @brief Applies tanh() to a buffer in place.
+     * @param data Samples to shape.
+     * @param numSamples Number of samples.
+     */
+    inline void tanh(float* data, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = tanh(data[i]);
+    }
+
+    /**
+     * @brief Applies atan() to a buffer in place, after a gain.
+     * @param data Samples to shape.
+     * @param numSamples Number of samples.
+     * @param gain Gain applied before shaping.
+     */
+    inline void atan(float* data, int numSamples, float gain) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = atan(data[i] * gain);
+    }
+}
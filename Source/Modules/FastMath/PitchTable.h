@@ -0,0 +1,90 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * @namespace PitchTable
+ * @brief Precomputed pitch lookups: MIDI note frequencies and a cents-to-ratio table.
+ *
+ * Both tables are built once, on first use, so no pitch is ever computed
+ * with std::pow on the audio thread. The ratio table covers the master
+ * and member channel pitch bends combined at one cent resolution; between
+ * entries it interpolates linearly, which keeps the relative error below
+ * 2.0e-7 over the whole range. That bound is checked by the Benchmarks
+ * app's --accuracy mode.
+ */
+namespace PitchTable
+{
+    static constexpr int numMidiNotes = 128;    ///< Entries of the note frequency table
+    static constexpr int maxCents = 5000;       ///< Largest offset covered by the ratio table, +-50 semitones
+
+    /**
+     * @brief Returns the frequency table, indexed by MIDI note.
+     */
+    inline const std::array<double, numMidiNotes>& getNoteFrequencies() noexcept
+    {
+        static const auto table = []
+            {
+                std::array<double, numMidiNotes> frequencies{};
+                for (int note = 0; note < numMidiNotes; ++note)
+                    frequencies[static_cast<size_t>(note)] = juce::MidiMessage::getMidiNoteInHertz(note);
+                return frequencies;
+            }();
+        return table;
+    }
+
+    /**
+     * @brief Returns the ratio table, entry i holding 2^((i - maxCents) / 1200).
+     */
+    inline const std::array<float, 2 * maxCents + 2>& getCentRatios() noexcept
+    {
+        // One extra entry past +maxCents so interpolation never reads out of bounds
+        static const auto table = []
+            {
+                std::array<float, 2 * maxCents + 2> ratios{};
+                for (size_t i = 0; i < ratios.size(); ++i)
+                    ratios[i] = static_cast<float>(std::pow(2.0, (static_cast<double>(i) - maxCents) / 1200.0));
+                return ratios;
+            }();
+        return table;
+    }
+
+    /**
+     * @brief Returns the frequency of a MIDI note.
+     * @param midiNote MIDI note number, 0 to 127.
+     * @return Frequency in Hz, A4 being 440 Hz.
+     */
+    inline double noteToFrequency(int midiNote) noexcept
+    {
+        jassert(midiNote >= 0 && midiNote < numMidiNotes);
+        return getNoteFrequencies()[static_cast<size_t>(midiNote)];
+    }
+
+    /**
+     * @brief Converts a pitch offset in cents to a frequency ratio.
+     * @param cents Offset in cents, clamped to +-maxCents.
+     * @return Ratio 2^(cents / 1200), linearly interpolated between whole cents.
+     */
+    inline float centsToRatio(float cents) noexcept
+    {
+        // The offset from -maxCents is taken in double, in float it would round away the fraction's low bits
+        const double position = juce::jlimit(0.0, 2.0 * maxCents, static_cast<double>(cents) + maxCents);
+        const int whole = static_cast<int>(position);
+        const float fraction = static_cast<float>(position - whole);
+
+        const auto& ratios = getCentRatios();
+        const float lower = ratios[static_cast<size_t>(whole)];
+        return lower + fraction * (ratios[static_cast<size_t>(whole) + 1] - lower);
+    }
+
+    /**
+     * @brief Converts a pitch offset in semitones to a frequency ratio.
+     * @param semitones Offset in semitones, clamped to +-50.
+     * @return Ratio 2^(semitones / 12).
+     */
+    inline float semitonesToRatio(float semitones) noexcept
+    {
+        return centsToRatio(semitones * 100.0f);
+    }
+}
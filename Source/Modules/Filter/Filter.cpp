@@ -1,12 +1,51 @@
 ﻿#include "Filter.h"
 #include "../../Modules/Linkable/LinkableUtils.h"
+#include "../../Modules/SignalGraph/SignalGraph.h"
+#include "../../Modules/FastMath/FastMath.h"
 
-Filter::Filter(int index)
+namespace
+{
+    /**
+     * @brief Maps a normalized cutoff to log2 of Hz, the FrequencyLowPass mapping without its final exponential.
+     */
+    float cutoffNormalizedToPitch(float normalized) noexcept
+    {
+        constexpr float log2Of10 = 3.3219280949f;
+        const float warped = std::sqrt(juce::jlimit(0.0f, 1.0f, normalized));
+        return log2Of10 * juce::jmap(warped, FormattingUtils::logFreqMin, FormattingUtils::logFreqMax);
+    }
+}
+
+Filter::Filter(int index, const juce::AudioProcessorValueTreeState& apvts)
 {
     name = "Filter " + juce::String(index + 1);
+
+    // Resolve parameter handles once, so the audio thread never looks IDs up by name
+    const juce::String prefix = "FILTER" + juce::String(index + 1) + "_";
+    handles.cutoff = apvts.getRawParameterValue(prefix + "CUTOFF");
+    handles.resonance = apvts.getRawParameterValue(prefix + "RES");
+    handles.drive = apvts.getRawParameterValue(prefix + "DRIVE");
+    handles.mix = apvts.getRawParameterValue(prefix + "MIX");
+    handles.slope = apvts.getRawParameterValue(prefix + "SLOPE");
+    handles.bypass = apvts.getRawParameterValue(prefix + "BYPASS");
+    handles.poly = apvts.getRawParameterValue(prefix + "POLY");
+    handles.type = apvts.getRawParameterValue(prefix + "TYPE");
+    handles.morph = apvts.getRawParameterValue(prefix + "MORPH");
+    handles.factor = apvts.getRawParameterValue(prefix + "FACTOR");
+    handles.vowel = apvts.getRawParameterValue(prefix + "VOWEL");
+    handles.oversampling = apvts.getRawParameterValue(prefix + "OVERSAMPLING");
+    jassert(handles.isComplete());
 }
 
 Filter::KnobParamSpecs Filter::getKnobParamSpecs(ParamID id, int filterIndex)
+{
+    static const ParamSpecTable<KnobParamSpecs, ParamID, NUM_OF_FILTERS> table(
+        { ParamID::Cutoff, ParamID::Resonance, ParamID::Drive, ParamID::Mix },
+        &makeKnobParamSpecs);
+    return table.get(id, filterIndex);
+}
+
+Filter::KnobParamSpecs Filter::makeKnobParamSpecs(ParamID id, int filterIndex)
 {
     const juce::String prefix = "FILTER" + juce::String(filterIndex + 1) + "_";
 
@@ -52,6 +91,14 @@ Filter::KnobParamSpecs Filter::getKnobParamSpecs(ParamID id, int filterIndex)
 }
 
 Filter::ComboBoxParamSpecs Filter::getComboBoxParamSpecs(ParamID id, int filterIndex)
+{
+    static const ParamSpecTable<ComboBoxParamSpecs, ParamID, NUM_OF_FILTERS> table(
+        { ParamID::Type, ParamID::Link, ParamID::Slope, ParamID::Oversampling },
+        &makeComboBoxParamSpecs);
+    return table.get(id, filterIndex);
+}
+
+Filter::ComboBoxParamSpecs Filter::makeComboBoxParamSpecs(ParamID id, int filterIndex)
 {
     const juce::String prefix = "FILTER" + juce::String(filterIndex + 1) + "_";
 
@@ -91,6 +138,13 @@ Filter::ComboBoxParamSpecs Filter::getComboBoxParamSpecs(ParamID id, int filterI
         break;
     }
 
+    case ParamID::Oversampling:
+        spec.paramID = prefix + "OVERSAMPLING";
+        spec.label = "Oversampling";
+        spec.choices = { "1x", "2x", "4x" };
+        spec.defaultIndex = static_cast<int>(Parameters::Default::OversamplingFactor);
+        break;
+
     default:
         jassertfalse;
         break;
@@ -100,6 +154,14 @@ Filter::ComboBoxParamSpecs Filter::getComboBoxParamSpecs(ParamID id, int filterI
 }
 
 std::pair<juce::String, juce::String> Filter::getToggleParamSpecs(ParamID id, int filterIndex)
+{
+    static const ParamSpecTable<std::pair<juce::String, juce::String>, ParamID, NUM_OF_FILTERS> table(
+        { ParamID::Bypass, ParamID::Poly },
+        &makeToggleParamSpecs);
+    return table.get(id, filterIndex);
+}
+
+std::pair<juce::String, juce::String> Filter::makeToggleParamSpecs(ParamID id, int filterIndex)
 {
     const juce::String prefix = "FILTER" + juce::String(filterIndex + 1) + "_";
 
@@ -108,6 +170,9 @@ std::pair<juce::String, juce::String> Filter::getToggleParamSpecs(ParamID id, in
     case ParamID::Bypass:
         return { prefix + "BYPASS", "Bypass" };
 
+    case ParamID::Poly:
+        return { prefix + "POLY", "Poly" };
+
     default:
         jassertfalse;
         return { "", "" };
@@ -118,8 +183,8 @@ void Filter::addParameters(int filterIndex, juce::AudioProcessorValueTreeState::
 {
     using ParamID = Filter::ParamID;
 
-    // Static ComboBoxes: Type, Slope
-    for (auto id : { ParamID::Type, ParamID::Slope })
+    // Static ComboBoxes: Type, Slope, Oversampling
+    for (auto id : { ParamID::Type, ParamID::Slope, ParamID::Oversampling })
     {
         auto spec = getComboBoxParamSpecs(id, filterIndex);
         layout.add(std::make_unique<juce::AudioParameterChoice>(
@@ -131,6 +196,7 @@ void Filter::addParameters(int filterIndex, juce::AudioProcessorValueTreeState::
         auto spec = getComboBoxParamSpecs(ParamID::Link, filterIndex);
         juce::StringArray linkChoices = getDefaultLinkableTargetNames();
         linkChoices.insert(0, "-");
+        linkChoices.add(SignalGraph::getBusName());
         layout.add(std::make_unique<juce::AudioParameterChoice>(
             spec.paramID, spec.label, linkChoices, spec.defaultIndex));
     }
@@ -172,6 +238,12 @@ void Filter::addParameters(int filterIndex, juce::AudioProcessorValueTreeState::
         auto [bypassID, bypassLabel] = getToggleParamSpecs(ParamID::Bypass, filterIndex);
         layout.add(std::make_unique<juce::AudioParameterBool>(bypassID, bypassLabel, false));
     }
+
+    // Poly Toggle
+    {
+        auto [polyID, polyLabel] = getToggleParamSpecs(ParamID::Poly, filterIndex);
+        layout.add(std::make_unique<juce::AudioParameterBool>(polyID, polyLabel, Parameters::Default::Poly));
+    }
 }
 
 juce::String Filter::getName() const
@@ -189,35 +261,159 @@ TalkboxFilter& Filter::getTalkboxFilter()
     return talkboxFilter;
 }
 
-void Filter::prepareToPlay(double sampleRate, int samplesPerBlock)
+void Filter::prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels)
 {
+    jassert(numChannels == 1 || numChannels == 2);
     currentSampleRate = sampleRate;
     currentBlockSize = static_cast<juce::uint32>(samplesPerBlock);
+    currentNumChannels = static_cast<juce::uint32>(juce::jlimit(1, 2, numChannels));
 
-    juce::dsp::ProcessSpec spec{ currentSampleRate, currentBlockSize, 2 };
-    ladderFilter.prepare(spec);
+    juce::dsp::ProcessSpec spec{ currentSampleRate, currentBlockSize, currentNumChannels };
     talkboxFilter.prepare(spec);
+    prepareOversamplers(oversamplers);
+    cutoffPitches.assign(currentBlockSize, 0.0f);
+    cutoffPitchesLength = 0;
+
+    for (auto& voice : voices)
+    {
+        talkboxFilter.prepareVoice(voice.talkbox, spec);
+        prepareOversamplers(voice.oversamplers);
+    }
+
+    prepareLaddersForOversampling();
+    needsUpdate = true;
+}
+
+void Filter::prepareOversamplers(OversamplerSet& set) const
+{
+    for (int i = 0; i < numOversamplers; ++i)
+    {
+        // Polyphase IIR half-band stages: the cheapest resampler with enough image rejection for drive
+        set[i] = std::make_unique<juce::dsp::Oversampling<float>>(
+            static_cast<size_t>(currentNumChannels), static_cast<size_t>(i + 1), juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+        set[i]->initProcessing(static_cast<size_t>(currentBlockSize));
+    }
+}
+
+void Filter::prepareLaddersForOversampling()
+{
+    preparedOversampling = currentParams.oversampling;
+
+    const double ladderRate = currentSampleRate * getOversamplingRatio();
+
+    // The ladders keep their state in place, so re-preparing on the audio thread never allocates
+    ladderFilter.prepare(ladderRate);
+    for (auto& voice : voices)
+        voice.ladder.prepare(ladderRate);
+
+    for (auto& resampler : oversamplers)
+        resampler->reset();
+    for (auto& voice : voices)
+        for (auto& resampler : voice.oversamplers)
+            resampler->reset();
+}
+
+int Filter::getOversamplingRatio() const noexcept
+{
+    return 1 << static_cast<int>(currentParams.oversampling);
+}
+
+void Filter::setScratchBuffers(ScratchBuffers* buffers)
+{
+    scratchBuffers = buffers;
 }
 
 void Filter::reset()
 {
-    ladderFilter.reset();
-    talkboxFilter.reset();
+    clearChain(ladderFilter, oversamplers, nullptr);
+    sleepState.setAsleep();
+
+    for (int i = 0; i < maxVoices; ++i)
+        resetVoice(i);
+
     needsUpdate = true;
 }
 
+bool Filter::isPolyphonic() const
+{
+    return currentParams.poly;
+}
+
+void Filter::resetVoice(int voiceIndex)
+{
+    jassert(voiceIndex >= 0 && voiceIndex < maxVoices);
+
+    auto& voice = voices[voiceIndex];
+    clearChain(voice.ladder, voice.oversamplers, &voice.talkbox);
+    voice.sleep.setAsleep();
+}
+
+void Filter::clearChain(ZdfLadder& ladder, OversamplerSet& resamplers, TalkboxFilter::VoiceState* talkboxVoice)
+{
+    ladder.reset();
+
+    if (talkboxVoice != nullptr)
+        talkboxFilter.resetVoice(*talkboxVoice);
+    else
+        talkboxFilter.reset();
+
+    for (auto& resampler : resamplers)
+        if (resampler != nullptr)
+            resampler->reset();
+}
+
 void Filter::process(juce::dsp::ProcessContextReplacing<float> context)
+{
+    processChain(context, ladderFilter, oversamplers, nullptr, sleepState, 0.0f);
+}
+
+bool Filter::isAsleep() const noexcept
+{
+    return sleepState.isAsleep();
+}
+
+void Filter::processVoice(int voiceIndex, juce::dsp::ProcessContextReplacing<float> context, float cutoffOctaves)
+{
+    jassert(voiceIndex >= 0 && voiceIndex < maxVoices);
+
+    auto& voice = voices[voiceIndex];
+
+    // Only touch the ladder when the note's expression moved
+    if (cutoffOctaves != voice.cutoffOctaves)
+    {
+        voice.cutoffOctaves = cutoffOctaves;
+        voice.ladder.setCutoffFrequencyHz(juce::jlimit(FormattingUtils::freqMinHz, FormattingUtils::freqMaxHz,
+            currentParams.cutoffHz * FastMath::exp2(cutoffOctaves)));
+    }
+
+    processChain(context, voice.ladder, voice.oversamplers, &voice.talkbox, voice.sleep, cutoffOctaves);
+}
+
+void Filter::processChain(juce::dsp::ProcessContextReplacing<float> context,
+    ZdfLadder& ladder,
+    OversamplerSet& resamplers,
+    TalkboxFilter::VoiceState* talkboxVoice,
+    SleepState& sleep,
+    float cutoffOctaves)
 {
     if (currentParams.bypass)
         return;
 
     auto& block = context.getOutputBlock();
-    const bool needsDryWet = currentParams.mix < 1.0f;
 
-    juce::AudioBuffer<float> dryCopy;
+    // A decayed chain fed silence would only output silence, the block passes through as it is
+    if (sleep.canSkip(block))
+        return;
+    jassert(scratchBuffers != nullptr); // setScratchBuffers() must be called before processing
+    const bool needsDryWet = currentParams.mix < 1.0f && scratchBuffers != nullptr;
+
+    juce::AudioBuffer<float>* dryBuffer = nullptr;
     if (needsDryWet)
     {
-        dryCopy.setSize((int)block.getNumChannels(), (int)block.getNumSamples());
+        auto& dryCopy = scratchBuffers->get(ScratchBuffers::Slot::FilterDry,
+            (int)block.getNumChannels(), (int)block.getNumSamples());
+        dryBuffer = &dryCopy;
+
         for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
             dryCopy.copyFrom((int)ch, 0, block.getChannelPointer(ch), (int)block.getNumSamples());
     }
@@ -228,24 +424,108 @@ void Filter::process(juce::dsp::ProcessContextReplacing<float> context)
         needsUpdate = false;
     }
 
-    if (currentParams.drive > 0.0f)
-        applyDrive(block);
+    processNonLinearStages(block, ladder, resamplers, cutoffOctaves);
 
+    // The talkbox formants are linear, so they stay at the base rate
     if (currentParams.type == Type::Talkbox)
-        talkboxFilter.process(block);
-    else
-        ladderFilter.process(context);
+    {
+        if (talkboxVoice != nullptr)
+            talkboxFilter.process(block, *talkboxVoice);
+        else
+            talkboxFilter.process(block);
+    }
 
     if (needsDryWet)
     {
         for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
             float* wet = block.getChannelPointer(ch);
-            const float* dry = dryCopy.getReadPointer((int)ch);
+            const float* dry = dryBuffer->getReadPointer((int)ch);
             for (size_t i = 0; i < block.getNumSamples(); ++i)
                 wet[i] = (1.0f - currentParams.mix) * dry[i] + currentParams.mix * wet[i];
         }
     }
+
+    // Cleared on falling asleep, so waking restarts from exact silence
+    if (sleep.settle(block, getChainStateMagnitude(ladder, talkboxVoice)))
+        clearChain(ladder, resamplers, talkboxVoice);
+}
+
+float Filter::getChainStateMagnitude(const ZdfLadder& ladder, const TalkboxFilter::VoiceState* talkboxVoice) const noexcept
+{
+    // Only the filter of the current type runs, the other one's state stays frozen until it is cleared
+    if (currentParams.type != Type::Talkbox)
+        return ladder.getStateMagnitude();
+
+    return talkboxVoice != nullptr ? TalkboxFilter::getStateMagnitude(*talkboxVoice)
+                                   : talkboxFilter.getStateMagnitude();
+}
+
+void Filter::processNonLinearStages(juce::dsp::AudioBlock<float>& block,
+    ZdfLadder& ladder,
+    OversamplerSet& resamplers,
+    float cutoffOctaves)
+{
+    const bool runDrive = currentParams.drive > 0.0f;
+    const bool runLadder = currentParams.type != Type::Talkbox;
+    if (!runDrive && !runLadder)
+        return;
+
+    // A cutoff moving within the sub-block is followed per sample, each pitch held over its oversampled samples
+    const float* pitches = runLadder ? getCutoffPitches(static_cast<int>(block.getNumSamples())) : nullptr;
+    const auto runLadderOn = [&](juce::dsp::AudioBlock<float>& target)
+        {
+            if (pitches != nullptr)
+                ladder.process(target, pitches, getOversamplingRatio(), cutoffOctaves);
+            else
+                ladder.process(target);
+        };
+
+    const int resamplerIndex = static_cast<int>(currentParams.oversampling) - 1;
+    auto* resampler = (resamplerIndex >= 0) ? resamplers[resamplerIndex].get() : nullptr;
+
+    if (resampler == nullptr)
+    {
+        if (runDrive)
+            applyDrive(block);
+        if (runLadder)
+            runLadderOn(block);
+        return;
+    }
+
+    jassert(block.getNumChannels() <= currentNumChannels && block.getNumSamples() <= currentBlockSize);
+
+    auto upsampled = resampler->processSamplesUp(block);
+    if (runDrive)
+        applyDrive(upsampled);
+    if (runLadder)
+        runLadderOn(upsampled);
+    resampler->processSamplesDown(block);
+}
+
+const float* Filter::getCutoffPitches(int numSamples)
+{
+    if (cutoffModulation == nullptr || numSamples <= 0 || numSamples > static_cast<int>(cutoffPitches.size()))
+        return nullptr;
+
+    // Every chain of this filter shares the sub-block, so the spans are read once for all voices
+    if (cutoffPitchesLength != numSamples)
+    {
+        const float first = cutoffModulation->getValueAt(modulationStart, cutoffNormalized);
+        bool moving = false;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float normalized = (i == 0) ? first : cutoffModulation->getValueAt(modulationStart + i, cutoffNormalized);
+            moving |= std::abs(normalized - first) > parameterEpsilon;
+            cutoffPitches[static_cast<size_t>(i)] = cutoffNormalizedToPitch(normalized);
+        }
+
+        cutoffMoving = moving;
+        cutoffPitchesLength = numSamples;
+    }
+
+    return cutoffMoving ? cutoffPitches.data() : nullptr;
 }
 
 void Filter::updateParametersIfNeeded()
@@ -255,77 +535,233 @@ void Filter::updateParametersIfNeeded()
         updateFilter();
         needsUpdate = false;
     }
+
+    // One coefficient rebuild for however many talkbox settings changed
+    talkboxFilter.updateFiltersIfNeeded();
 }
 
-void Filter::updateFromParameters(const juce::AudioProcessorValueTreeState& apvts, int filterIndex)
+void Filter::setOversamplingAllowed(bool shouldAllow) noexcept
 {
-    const juce::String prefix = "FILTER" + juce::String(filterIndex + 1) + "_";
+    oversamplingAllowed = shouldAllow;
+}
 
-    currentParams.cutoffHz = FormattingUtils::normalizedToValue(
-        apvts.getRawParameterValue(prefix + "CUTOFF")->load(),
-        FormattingUtils::FormatType::FrequencyLowPass,
-        FormattingUtils::freqMinHz,
-        FormattingUtils::freqMaxHz);
+void Filter::setMinimumOversampling(Oversampling minimum) noexcept
+{
+    minimumOversampling = minimum;
+}
+
+void Filter::updateFromParameters()
+{
+    bool changed = false;
+
+    // A new block starts, the previous one's cutoff pitches are stale
+    modulationStart = 0;
+    cutoffPitchesLength = 0;
+
+    cutoffNormalized = ModulationTarget::apply(cutoffModulation, handles.cutoff->load());
+    changed |= setCutoffNormalized(cutoffNormalized);
+
+    const float resonance = ModulationTarget::apply(resonanceModulation, handles.resonance->load());
+    changed |= std::abs(resonance - currentParams.resonance) > parameterEpsilon;
+    currentParams.resonance = resonance;
 
-    currentParams.resonance = apvts.getRawParameterValue(prefix + "RES")->load();
-    currentParams.drive = apvts.getRawParameterValue(prefix + "DRIVE")->load();
-    currentParams.mix = apvts.getRawParameterValue(prefix + "MIX")->load();
+    const float drive = ModulationTarget::apply(driveModulation, handles.drive->load());
+    changed |= std::abs(drive - currentParams.drive) > parameterEpsilon;
+    currentParams.drive = drive;
 
-    const float slopeNorm = apvts.getRawParameterValue(prefix + "SLOPE")->load();
+    // Mix is read directly by processChain, so it needs no filter update
+    currentParams.mix = ModulationTarget::apply(mixModulation, handles.mix->load());
+
+    const float slopeNorm = handles.slope->load();
     int slopeIndex = static_cast<int>(juce::jmap(slopeNorm, 0.0f, 1.0f, 0.0f, static_cast<float>(static_cast<int>(Slope::Count) - 1)) + 0.5f);
     slopeIndex = std::clamp(slopeIndex, 0, static_cast<int>(Slope::Count) - 1);
-    currentParams.slope = static_cast<Slope>(slopeIndex);
+    const auto slope = static_cast<Slope>(slopeIndex);
+    changed |= slope != currentParams.slope;
+    currentParams.slope = slope;
+
+    currentParams.bypass = (handles.bypass->load() > 0.5f);
+
+    // Voice ladders only follow the parameters in poly mode, so switching it on must reconfigure them
+    const bool poly = (handles.poly->load() > 0.5f);
+    changed |= poly != currentParams.poly;
+    currentParams.poly = poly;
 
-    currentParams.bypass = (apvts.getRawParameterValue(prefix + "BYPASS")->load() > 0.5f);
+    auto typeIdx = static_cast<int>(handles.type->load());
+    const auto type = static_cast<Type>(juce::jlimit(0, static_cast<int>(Type::Count) - 1, typeIdx));
+    changed |= type != currentParams.type;
+    currentParams.type = type;
 
-    auto typeIdx = static_cast<int>(apvts.getRawParameterValue(prefix + "TYPE")->load());
-    currentParams.type = static_cast<Type>(juce::jlimit(0, static_cast<int>(Type::Count) - 1, typeIdx));
+    const auto oversamplingIdx = oversamplingAllowed
+        ? juce::jmax(static_cast<int>(handles.oversampling->load()), static_cast<int>(minimumOversampling))
+        : 0;
+    const auto oversampling = static_cast<Oversampling>(juce::jlimit(0, static_cast<int>(Oversampling::Count) - 1, oversamplingIdx));
+    changed |= oversampling != currentParams.oversampling;
+    currentParams.oversampling = oversampling;
 
     // Talkbox Logic
     if (currentParams.type == Type::Talkbox)
     {
-        const float morphNorm = apvts.getRawParameterValue(prefix + "MORPH")->load();
-        const float morphValue = morphNorm;
+        morphNormalized = ModulationTarget::apply(morphModulation, handles.morph->load());
+        const float morphValue = morphNormalized;
 
-        const float factorNorm = apvts.getRawParameterValue(prefix + "FACTOR")->load();
-        const float factorValue = FormattingUtils::normalizedToValue(factorNorm, FormattingUtils::FormatType::Resonance, FormattingUtils::resonanceMin, FormattingUtils::resonanceMax);
+        factorNormalized = ModulationTarget::apply(factorModulation, handles.factor->load());
+        const float factorValue = FormattingUtils::normalizedToValue(factorNormalized, FormattingUtils::FormatType::Resonance, FormattingUtils::resonanceMin, FormattingUtils::resonanceMax);
 
-        const int vowelIdx = static_cast<int>(apvts.getRawParameterValue(prefix + "VOWEL")->load());
+        const int vowelIdx = static_cast<int>(handles.vowel->load());
         const auto vowel = static_cast<TalkboxFilter::Vowel>(juce::jlimit(0, static_cast<int>(TalkboxFilter::Vowel::Count) - 1, vowelIdx));
 
+        // The setters only mark the talkbox dirty, updateParametersIfNeeded() rebuilds it once
         talkboxFilter.setVowel(vowel);
         talkboxFilter.setMorph(morphValue);
         talkboxFilter.setQFactor(factorValue);
     }
 
-    needsUpdate = true;
+    if (changed)
+        needsUpdate = true;
+}
+
+bool Filter::setCutoffNormalized(float normalized)
+{
+    if (std::abs(normalized - activeCutoffNormalized) <= parameterEpsilon)
+        return false;
+
+    activeCutoffNormalized = normalized;
+    currentParams.cutoffHz = FormattingUtils::normalizedToValue(
+        normalized,
+        FormattingUtils::FormatType::FrequencyLowPass,
+        FormattingUtils::freqMinHz,
+        FormattingUtils::freqMaxHz);
+
+    return true;
+}
+
+void Filter::setModulationTarget(ParamID id, const ModulationTarget* target)
+{
+    switch (id)
+    {
+    case ParamID::Cutoff:
+        cutoffModulation = target;
+        break;
+    case ParamID::Resonance:
+        resonanceModulation = target;
+        break;
+    case ParamID::Drive:
+        driveModulation = target;
+        break;
+    case ParamID::Mix:
+        mixModulation = target;
+        break;
+    default:
+        break;
+    }
+}
+
+void Filter::setModulationTarget(TalkboxFilter::ParamID id, const ModulationTarget* target)
+{
+    switch (id)
+    {
+    case TalkboxFilter::ParamID::Morph:
+        morphModulation = target;
+        break;
+    case TalkboxFilter::ParamID::Factor:
+        factorModulation = target;
+        break;
+    default:
+        break;
+    }
+}
+
+void Filter::applyModulation(int sampleIndex)
+{
+    bool ladderChanged = false;
+
+    modulationStart = sampleIndex;
+    cutoffPitchesLength = 0;
+
+    if (cutoffModulation != nullptr)
+        ladderChanged |= setCutoffNormalized(cutoffModulation->getValueAt(sampleIndex, cutoffNormalized));
+
+    if (resonanceModulation != nullptr)
+    {
+        const float resonance = resonanceModulation->getValueAt(sampleIndex, currentParams.resonance);
+        ladderChanged |= std::abs(resonance - currentParams.resonance) > parameterEpsilon;
+        currentParams.resonance = resonance;
+    }
+
+    if (driveModulation != nullptr)
+    {
+        const float drive = driveModulation->getValueAt(sampleIndex, currentParams.drive);
+        ladderChanged |= std::abs(drive - currentParams.drive) > parameterEpsilon;
+        currentParams.drive = drive;
+    }
+
+    // Mix is read directly by processChain, so it needs no filter update
+    if (mixModulation != nullptr)
+        currentParams.mix = mixModulation->getValueAt(sampleIndex, currentParams.mix);
+
+    if (currentParams.type == Type::Talkbox)
+    {
+        if (morphModulation != nullptr)
+            talkboxFilter.setMorph(morphModulation->getValueAt(sampleIndex, morphNormalized));
+
+        if (factorModulation != nullptr)
+            talkboxFilter.setQFactor(FormattingUtils::normalizedToValue(
+                factorModulation->getValueAt(sampleIndex, factorNormalized),
+                FormattingUtils::FormatType::Resonance,
+                FormattingUtils::resonanceMin,
+                FormattingUtils::resonanceMax));
+    }
+
+    if (ladderChanged)
+        needsUpdate = true;
+
+    updateParametersIfNeeded();
 }
 
 void Filter::updateFilter()
 {
-    juce::dsp::LadderFilterMode ladderMode = juce::dsp::LadderFilterMode::LPF24;
+    ZdfLadder::Mode ladderMode = ZdfLadder::Mode::LPF24;
 
     switch (currentParams.type)
     {
     case Type::LowPass:
-        ladderMode = (currentParams.slope == Slope::dB12) ? juce::dsp::LadderFilterMode::LPF12 : juce::dsp::LadderFilterMode::LPF24;
+        ladderMode = (currentParams.slope == Slope::dB12) ? ZdfLadder::Mode::LPF12 : ZdfLadder::Mode::LPF24;
         break;
     case Type::HighPass:
-        ladderMode = (currentParams.slope == Slope::dB12) ? juce::dsp::LadderFilterMode::HPF12 : juce::dsp::LadderFilterMode::HPF24;
+        ladderMode = (currentParams.slope == Slope::dB12) ? ZdfLadder::Mode::HPF12 : ZdfLadder::Mode::HPF24;
         break;
     case Type::BandPass:
-        ladderMode = (currentParams.slope == Slope::dB12) ? juce::dsp::LadderFilterMode::BPF12 : juce::dsp::LadderFilterMode::BPF24;
+        ladderMode = (currentParams.slope == Slope::dB12) ? ZdfLadder::Mode::BPF12 : ZdfLadder::Mode::BPF24;
         break;
     default:
-        ladderMode = juce::dsp::LadderFilterMode::LPF24;
+        ladderMode = ZdfLadder::Mode::LPF24;
         break;
     }
 
-    ladderFilter.setMode(ladderMode);
-    ladderFilter.setCutoffFrequencyHz(currentParams.cutoffHz);
-    ladderFilter.setResonance(currentParams.resonance);
-    float shapedDrive = std::pow(currentParams.drive, 1.5f);
-    ladderFilter.setDrive(1.0f + shapedDrive * 3.0f);
+    // A new oversampling factor changes the rate the ladders run at
+    if (currentParams.oversampling != preparedOversampling)
+        prepareLaddersForOversampling();
+
+    configureLadder(ladderFilter, ladderMode);
+
+    // Voice ladders only need to follow the parameters while poly mode is on
+    if (currentParams.poly)
+    {
+        for (auto& voice : voices)
+        {
+            configureLadder(voice.ladder, ladderMode);
+            voice.cutoffOctaves = 0.0f; // The next processVoice() reapplies the note's offset
+        }
+    }
+}
+
+void Filter::configureLadder(ZdfLadder& ladder, ZdfLadder::Mode mode) const
+{
+    ladder.setMode(mode);
+    ladder.setCutoffFrequencyHz(currentParams.cutoffHz);
+    ladder.setResonance(currentParams.resonance);
+    float shapedDrive = currentParams.drive * std::sqrt(currentParams.drive);
+    ladder.setDrive(1.0f + shapedDrive * 3.0f);
 }
 
 void Filter::applyDrive(juce::dsp::AudioBlock<float>& block)
@@ -343,42 +779,29 @@ void Filter::applyDrive(juce::dsp::AudioBlock<float>& block)
         const float gain = 1.0f + drive * 4.0f;
 
         for (int ch = 0; ch < numChannels; ++ch)
-        {
-            float* data = block.getChannelPointer(ch);
-            for (int i = 0; i < numSamples; ++i)
-            {
-                float x = data[i] * gain;
-                data[i] = std::atan(x); // Smooth harmonics
-            }
-        }
+            FastMath::atan(block.getChannelPointer(ch), numSamples, gain); // Smooth harmonics
     }
     else
     {
         // Asymmetric tanh drive
-        float shapedDrive = std::pow(drive, 2.0f);
+        float shapedDrive = drive * drive;
         float preGainPos = 1.0f + shapedDrive * 5.0f;
         float preGainNeg = 1.0f + shapedDrive * 4.0f;
 
-        float normPos = 1.0f / std::tanh(preGainPos);
-        float normNeg = 1.0f / std::tanh(preGainNeg);
+        float normPos = 1.0f / FastMath::tanh(preGainPos);
+        float normNeg = 1.0f / FastMath::tanh(preGainNeg);
 
         for (int ch = 0; ch < numChannels; ++ch)
         {
             float* data = block.getChannelPointer(ch);
             for (int i = 0; i < numSamples; ++i)
             {
-                float sample = data[i];
-
-                if (sample >= 0.0f)
-                {
-                    sample *= preGainPos;
-                    data[i] = std::tanh(sample) * normPos;
-                }
-                else
-                {
-                    sample *= preGainNeg;
-                    data[i] = std::tanh(sample) * normNeg;
-                }
+                // Selects instead of branches, so the loop vectorizes
+                const float sample = data[i];
+                const bool positive = sample >= 0.0f;
+                const float preGain = positive ? preGainPos : preGainNeg;
+                const float norm = positive ? normPos : normNeg;
+                data[i] = FastMath::tanh(sample * preGain) * norm;
             }
         }
     }
@@ -1,12 +1,20 @@
 #pragma once
 
 #include "TalkboxFilter.h"
+#include "ZdfLadder.h"
 #include "../../Common.h"
+#include "../Knob/ModulationTarget.h"
+#include "../ScratchBuffers/ScratchBuffers.h"
+#include "../SleepState/SleepState.h"
 #include <JuceHeader.h>
 
 /**
  * @class Filter
  * @brief A filter module of basic Filters and Talkbox.
+ *
+ * The shared chain and every voice chain sleep once their input is silent and
+ * the ladder or formant history has decayed, skipping their blocks until the
+ * input is not silent again.
  */
 class Filter
 {
@@ -24,7 +32,9 @@ public:
         Slope,      ///< Filter slope (12/24 dB)
         Type,       ///< Filter type (LP, HP, BP)
         Bypass,     ///< Bypass toggle
+        Poly,       ///< Per-voice (polyphonic) filtering toggle
         Link,       ///< Oscillator linking target
+        Oversampling, ///< Oversampling factor of the drive and ladder stages
         Count
     };
 
@@ -52,6 +62,18 @@ public:
         Count
     };
 
+    /**
+     * @enum Oversampling
+     * @brief Oversampling factors for the non-linear drive and ladder stages.
+     */
+    enum class Oversampling
+    {
+        x1 = 0, ///< Base sample rate
+        x2 = 1, ///< 2x oversampling
+        x4 = 2, ///< 4x oversampling
+        Count
+    };
+
     /**
      * @struct Parameters
      * @brief Holds all filter values
@@ -64,7 +86,9 @@ public:
         float mix;         ///< Dry/wet mix (0.0 dry, 1.0 wet)
         Slope slope;       ///< Filter slope
         bool  bypass;      ///< Bypass toggle
+        bool  poly;        ///< Per-voice filtering
         Type  type;        ///< Filter type
+        Oversampling oversampling = Oversampling::x1; ///< Oversampling factor of drive and ladder
 
         /**
          * @struct Default
@@ -78,15 +102,20 @@ public:
             static constexpr float Mix = 1.0f;                 ///< Default wet mix
             static constexpr Slope Slope = Slope::dB12;        ///< Default slope: 12 dB/oct
             static constexpr bool  Bypass = false;             ///< Default bypass state
+            static constexpr bool  Poly = false;               ///< Default: one filter for all notes
             static constexpr Type  FilterType = Type::LowPass; ///< Default filter type
+            static constexpr Oversampling OversamplingFactor = Oversampling::x1; ///< Default: no oversampling
         };
     };
 
+    static constexpr int maxVoices = 20; ///< Per-voice filter states available in poly mode, one per envelope voice
+
     /**
      * @brief Constructs a Filter instance with a specific index.
      * @param index Filter index (used for parameter ID suffixes).
+     * @param apvts Parameter tree the filter resolves its parameter handles from.
      */
-    Filter(int index);
+    Filter(int index, const juce::AudioProcessorValueTreeState& apvts);
 
     using KnobParamSpecs = ::KnobParamSpecs;           ///< Knob parameter spec alias
     using ComboBoxParamSpecs = ::ComboBoxParamSpecs;   ///< ComboBox parameter spec alias
@@ -144,8 +173,15 @@ public:
      * @brief Prepares the DSP modules for playback.
      * @param sampleRate Current audio sample rate.
      * @param samplesPerBlock Expected block size.
+     * @param numChannels Channels of the output bus, 1 or 2; a mono bus keeps half the filter state.
+     */
+    void prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels = 2);
+
+    /**
+     * @brief Sets the shared scratch buffers used for the dry copy.
+     * @param buffers Pointer to the processor-owned scratch buffers.
      */
-    void prepareToPlay(double sampleRate, int samplesPerBlock);
+    void setScratchBuffers(ScratchBuffers* buffers);
 
     /**
      * @brief Resets internal DSP state.
@@ -159,26 +195,223 @@ public:
     void process(juce::dsp::ProcessContextReplacing<float> context);
 
     /**
-     * @brief Updates the internal filter coefficients if needed.
+     * @brief Returns true while the shared chain sleeps on silent input.
+     */
+    bool isAsleep() const noexcept;
+
+    /**
+     * @brief Returns true if the filter runs one instance per voice.
+     * @return True if poly mode is enabled.
+     */
+    bool isPolyphonic() const;
+
+    /**
+     * @brief Clears the filter state of one voice, called when a new note takes it.
+     * @param voiceIndex Voice index in range [0, maxVoices).
+     */
+    void resetVoice(int voiceIndex);
+
+    /**
+     * @brief Processes a single voice's audio through that voice's own filter state.
+     * @param voiceIndex Voice index in range [0, maxVoices).
+     * @param context The processing context replacing float.
+     * @param cutoffOctaves Per-note cutoff offset in octaves, from the note's expression lanes.
+     */
+    void processVoice(int voiceIndex, juce::dsp::ProcessContextReplacing<float> context, float cutoffOctaves = 0.0f);
+
+    /**
+     * @brief Updates the ladder and talkbox coefficients if any of their settings changed.
      */
     void updateParametersIfNeeded();
 
     /**
-     * @brief Updates parameter values from the APVTS tree.
-     * @param apvts Reference to APVTS.
-     * @param filterIndex Filter index.
+     * @brief Updates parameter values from the cached APVTS handles.
      */
-    void updateFromParameters(const juce::AudioProcessorValueTreeState& apvts, int filterIndex);
+    void updateFromParameters();
+
+    /**
+     * @brief Allows or forbids oversampling, applied from the next updateFromParameters().
+     * @param shouldAllow False runs drive and ladder at the host rate, whatever the Oversampling parameter says.
+     */
+    void setOversamplingAllowed(bool shouldAllow) noexcept;
+
+    /**
+     * @brief Raises the oversampling to at least a factor, applied from the next updateFromParameters().
+     * @param minimum Lowest factor used while oversampling is allowed, x1 for the parameter's own.
+     */
+    void setMinimumOversampling(Oversampling minimum) noexcept;
+
+    /**
+     * @brief Assigns the modulation proxy of a filter parameter, read per block and per sub-block.
+     * Only Cutoff, Resonance, Drive and Mix are modulatable; other IDs are ignored.
+     * @param id The modulated parameter.
+     * @param target Proxy for that parameter, or nullptr to detach.
+     */
+    void setModulationTarget(ParamID id, const ModulationTarget* target);
+
+    /**
+     * @brief Assigns the modulation proxy of a talkbox parameter, read per block and per sub-block.
+     * Only Morph and Factor are modulatable; other IDs are ignored.
+     * @param id The modulated talkbox parameter.
+     * @param target Proxy for that parameter, or nullptr to detach.
+     */
+    void setModulationTarget(TalkboxFilter::ParamID id, const ModulationTarget* target);
+
+    /**
+     * @brief Samples the modulation spans at a point of the block and updates the filter if they moved.
+     * Called by the processor before rendering each sub-block; a cutoff that moves within the
+     * sub-block is then followed sample by sample from the spans.
+     * @param sampleIndex Sample index relative to the start of the block, where the sub-block starts.
+     */
+    void applyModulation(int sampleIndex);
     ///@}
 
 private:
+    /** @brief Builds the spec that getKnobParamSpecs() caches. */
+    static KnobParamSpecs makeKnobParamSpecs(ParamID id, int filterIndex);
+
+    /** @brief Builds the spec that getComboBoxParamSpecs() caches. */
+    static ComboBoxParamSpecs makeComboBoxParamSpecs(ParamID id, int filterIndex);
+
+    /** @brief Builds the spec that getToggleParamSpecs() caches. */
+    static std::pair<juce::String, juce::String> makeToggleParamSpecs(ParamID id, int filterIndex);
+
     juce::String name;                           ///< Display name of the filter
     Parameters currentParams;                    ///< The live parameter state
     double currentSampleRate = 44100.0;          ///< Cached sample rate in Hz
     juce::uint32 currentBlockSize = 512;         ///< Cached block size
+    juce::uint32 currentNumChannels = 2;         ///< Channels the filters are prepared for
     TalkboxFilter talkboxFilter;                 ///< Talkbox filter instance
+    ScratchBuffers* scratchBuffers = nullptr;    ///< Shared scratch buffers
     bool needsUpdate = true;                     ///< Flag indicating parameter change
-    juce::dsp::LadderFilter<float> ladderFilter; ///< Core Ladder filter processor
+    float cutoffNormalized = 0.0f;               ///< Unmodulated cutoff, normalized
+    float activeCutoffNormalized = -1.0f;        ///< Normalized cutoff that currentParams.cutoffHz was computed from
+    float morphNormalized = 0.0f;                ///< Unmodulated talkbox morph, normalized
+    float factorNormalized = 0.0f;               ///< Unmodulated talkbox factor, normalized
+
+    /**
+     * @struct ParameterHandles
+     * @brief APVTS value handles resolved once at construction.
+     */
+    struct ParameterHandles
+    {
+        std::atomic<float>* cutoff = nullptr;    ///< Cutoff, normalized
+        std::atomic<float>* resonance = nullptr; ///< Resonance
+        std::atomic<float>* drive = nullptr;     ///< Drive
+        std::atomic<float>* mix = nullptr;       ///< Dry/wet mix
+        std::atomic<float>* slope = nullptr;     ///< Slope, normalized
+        std::atomic<float>* bypass = nullptr;    ///< Bypass toggle
+        std::atomic<float>* poly = nullptr;      ///< Poly toggle
+        std::atomic<float>* type = nullptr;      ///< Filter type choice
+        std::atomic<float>* morph = nullptr;     ///< Talkbox morph
+        std::atomic<float>* factor = nullptr;    ///< Talkbox factor
+        std::atomic<float>* vowel = nullptr;     ///< Talkbox vowel choice
+        std::atomic<float>* oversampling = nullptr; ///< Oversampling choice
+
+        /**
+         * @brief Returns true if every handle was found in the APVTS.
+         */
+        bool isComplete() const noexcept
+        {
+            return cutoff && resonance && drive && mix && slope && bypass
+                && poly && type && morph && factor && vowel && oversampling;
+        }
+    };
+
+    ParameterHandles handles; ///< Cached parameter handles
+
+    static constexpr float parameterEpsilon = 1.0e-5f; ///< Smallest parameter change that triggers a filter update
+
+    /**
+     * @brief Sets the cutoff from a normalized value, skipping the Hz mapping if it did not move.
+     * @param normalized Normalized cutoff in range [0.0, 1.0].
+     * @return True if the cutoff changed by more than parameterEpsilon.
+     */
+    bool setCutoffNormalized(float normalized);
+
+    const ModulationTarget* cutoffModulation = nullptr;    ///< Modulation proxy for Cutoff
+    const ModulationTarget* resonanceModulation = nullptr; ///< Modulation proxy for Resonance
+    const ModulationTarget* driveModulation = nullptr;     ///< Modulation proxy for Drive
+    const ModulationTarget* mixModulation = nullptr;       ///< Modulation proxy for Mix
+    const ModulationTarget* morphModulation = nullptr;     ///< Modulation proxy for talkbox Morph
+    const ModulationTarget* factorModulation = nullptr;    ///< Modulation proxy for talkbox Factor
+    ZdfLadder ladderFilter;                                ///< Ladder of the shared filter chain
+
+    std::vector<float> cutoffPitches;                      ///< Modulated cutoff of every sample of the sub-block, as log2 of Hz
+    int modulationStart = 0;                               ///< Block sample the current sub-block starts at
+    int cutoffPitchesLength = 0;                           ///< Samples cutoffPitches holds for the current sub-block, 0 if stale
+    bool cutoffMoving = false;                             ///< True if the cutoff moves within the current sub-block
+
+    /**
+     * @brief Returns the modulated cutoff of every sample of the current sub-block, filled once per sub-block.
+     * @param numSamples Length of the sub-block.
+     * @return Pitches as log2 of Hz, or nullptr if the cutoff holds still over the sub-block.
+     */
+    const float* getCutoffPitches(int numSamples);
+
+    static constexpr int numOversamplers = static_cast<int>(Oversampling::Count) - 1; ///< Resamplers for every factor above 1x
+
+    /** @brief One polyphase IIR resampler per oversampling factor, index 0 is 2x. */
+    using OversamplerSet = std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, numOversamplers>;
+
+    OversamplerSet oversamplers;                          ///< Resamplers of the shared filter chain
+    Oversampling preparedOversampling = Oversampling::x1; ///< Factor the ladders are currently prepared for
+    bool oversamplingAllowed = true;                      ///< False while the quality governor forbids oversampling
+    Oversampling minimumOversampling = Oversampling::x1;  ///< Factor used at least, raised for offline renders
+
+    /**
+     * @struct Voice
+     * @brief Filter state owned by one voice in poly mode.
+     */
+    struct Voice
+    {
+        ZdfLadder ladder;                      ///< Per-voice ladder state
+        TalkboxFilter::VoiceState talkbox;     ///< Per-voice formant state (shared coefficients)
+        OversamplerSet oversamplers;           ///< Per-voice resampling filter states
+        float cutoffOctaves = 0.0f;            ///< Expression offset the ladder cutoff currently includes
+        SleepState sleep;                      ///< Skips the voice's blocks once its tail decayed
+    };
+
+    std::array<Voice, maxVoices> voices; ///< Per-voice filter states
+    SleepState sleepState;               ///< Skips the shared chain's blocks once its tail decayed
+
+    /**
+     * @brief Runs drive, filtering and dry/wet mix with the given filter state.
+     * @param context The processing context replacing float.
+     * @param ladder Ladder instance to use.
+     * @param resamplers Resampler set belonging to the same chain as the ladder.
+     * @param talkboxVoice Talkbox voice state, or nullptr for the shared one.
+     * @param sleep Sleep state of the same chain.
+     * @param cutoffOctaves Expression offset of the voice, added to a modulated cutoff.
+     */
+    void processChain(juce::dsp::ProcessContextReplacing<float> context,
+        ZdfLadder& ladder,
+        OversamplerSet& resamplers,
+        TalkboxFilter::VoiceState* talkboxVoice,
+        SleepState& sleep,
+        float cutoffOctaves);
+
+    /**
+     * @brief Returns the largest magnitude the running filter of a chain still holds.
+     * @param ladder Ladder instance of the chain.
+     * @param talkboxVoice Talkbox voice state, or nullptr for the shared one.
+     */
+    float getChainStateMagnitude(const ZdfLadder& ladder, const TalkboxFilter::VoiceState* talkboxVoice) const noexcept;
+
+    /**
+     * @brief Clears the ladder, resampler and formant state of a chain.
+     * @param ladder Ladder instance of the chain.
+     * @param resamplers Resampler set of the chain.
+     * @param talkboxVoice Talkbox voice state, or nullptr for the shared one.
+     */
+    void clearChain(ZdfLadder& ladder, OversamplerSet& resamplers, TalkboxFilter::VoiceState* talkboxVoice);
+
+    /**
+     * @brief Applies mode, cutoff, resonance and drive to a ladder instance.
+     * @param ladder Ladder instance to configure.
+     * @param mode Ladder mode derived from type and slope.
+     */
+    void configureLadder(ZdfLadder& ladder, ZdfLadder::Mode mode) const;
 
     /**
      * @brief Applies cutoff, resonance, drive, and slope to the Ladder filter.
@@ -190,4 +423,32 @@ private:
      * @param block Audio block to apply drive on.
      */
     void applyDrive(juce::dsp::AudioBlock<float>& block);
+
+    /**
+     * @brief Runs drive and, outside talkbox mode, the ladder at the selected oversampling factor.
+     * @param block Audio block at the base sample rate, processed in place.
+     * @param ladder Ladder instance to use.
+     * @param resamplers Resampler set belonging to the same chain as the ladder.
+     * @param cutoffOctaves Expression offset of the voice, added to a modulated cutoff.
+     */
+    void processNonLinearStages(juce::dsp::AudioBlock<float>& block,
+        ZdfLadder& ladder,
+        OversamplerSet& resamplers,
+        float cutoffOctaves);
+
+    /**
+     * @brief Creates one resampler per oversampling factor.
+     * @param set Set to fill.
+     */
+    void prepareOversamplers(OversamplerSet& set) const;
+
+    /**
+     * @brief Prepares all ladders for the sample rate of the selected oversampling factor.
+     */
+    void prepareLaddersForOversampling();
+
+    /**
+     * @brief Returns the number of samples the selected oversampling factor produces per input sample.
+     */
+    int getOversamplingRatio() const noexcept;
 };
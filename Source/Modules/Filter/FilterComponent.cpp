@@ -36,6 +36,12 @@ FilterComponent::FilterComponent(juce::AudioProcessorValueTreeState& apvts, Digi
     bypassAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(apvts, paramID, bypassToggle);
     addAndMakeVisible(bypassToggle);
 
+    // Poly Toggle
+    polyToggle.setButtonText("Poly");
+    auto polySpec = Filter::getToggleParamSpecs(Filter::ParamID::Poly, filterIndex);
+    polyAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(apvts, polySpec.first, polyToggle);
+    addAndMakeVisible(polyToggle);
+
     // Link ComboBox
     linkLabel.setText("Link:", juce::dontSendNotification);
     linkLabel.setFont(juce::Font(UI::Fonts::defaultFontSize));
@@ -99,6 +105,11 @@ FilterComponent::FilterComponent(juce::AudioProcessorValueTreeState& apvts, Digi
     resonanceKnob.getSlider().onValueChange = [this]() { updateGraphFromKnobs(); };
     driveKnob.getSlider().onValueChange = [this]() { updateGraphFromKnobs(); };
     mixKnob.getSlider().onValueChange = [this]() { updateGraphFromKnobs(); };
+    morphKnob.getSlider().onValueChange = [this]() { updateGraphFromKnobs(); };
+    factorKnob.getSlider().onValueChange = [this]() { updateGraphFromKnobs(); };
+    vowelSelector.onChange = [this]() { updateGraphFromKnobs(); };
+
+    updateGraphFromKnobs();
 
     updateTheme();
 }
@@ -115,6 +126,7 @@ FilterComponent::~FilterComponent()
     typeAttachment.reset();
     linkAttachment.reset();
     bypassAttachment.reset();
+    polyAttachment.reset();
     slopeAttachment.reset();
     vowelAttachment.reset();
 
@@ -125,24 +137,6 @@ FilterComponent::~FilterComponent()
     }
 }
 
-void FilterComponent::registerModulationParameters(int index, juce::AudioProcessorValueTreeState::ParameterLayout& layout)
-{
-    for (Filter::ParamID id : { Filter::ParamID::Cutoff, Filter::ParamID::Resonance, Filter::ParamID::Drive, Filter::ParamID::Mix })
-    {
-        const auto spec = Filter::getKnobParamSpecs(id, index);
-        KnobModulationEngine::registerParameters(layout, spec.id);
-    }
-
-    // Talkbox-specific knobs
-    {
-        const auto morphSpec = TalkboxFilter::getKnobParamSpecs(TalkboxFilter::ParamID::Morph, index);
-        const auto factorSpec = TalkboxFilter::getKnobParamSpecs(TalkboxFilter::ParamID::Factor, index);
-
-        KnobModulationEngine::registerParameters(layout, morphSpec.id);
-        KnobModulationEngine::registerParameters(layout, factorSpec.id);
-    }
-}
-
 int FilterComponent::getTotalWidth()
 {
     return totalWidth;
@@ -178,12 +172,7 @@ void FilterComponent::paint(juce::Graphics& g)
             40, 16, grid.justification);
     }
 
-    // Draw FilterGraph content
-    g.reduceClipRegion(graphArea.toNearestInt());
-    filterGraph.paint(g);
-
-    // Forward current knob values to update graph
-    updateGraphFromKnobs();
+    // The graph itself is a child component and paints its own cached curve
 }
 
 void FilterComponent::resized()
@@ -194,9 +183,11 @@ void FilterComponent::resized()
     auto titleRow = bounds.removeFromTop(selectorHeight);
     const int oneThirdWidth = titleRow.getWidth() / 3;
 
-    // Bypass Toggle on Left
+    // Bypass and Poly Toggles on Left
     auto bypassArea = titleRow.removeFromLeft(oneThirdWidth);
+    auto polyArea = bypassArea.removeFromRight(bypassArea.getWidth() / 2);
     bypassToggle.setBounds(bypassArea.reduced(rowPadding));
+    polyToggle.setBounds(polyArea.reduced(rowPadding));
 
     // Title in Center
     auto titleArea = titleRow.removeFromLeft(oneThirdWidth);
@@ -297,6 +288,10 @@ void FilterComponent::updateTheme()
     bypassToggle.setColour(juce::ToggleButton::tickColourId, UI::Colors::FilterText);
     bypassToggle.setColour(juce::ToggleButton::tickDisabledColourId, UI::Colors::FilterText.withAlpha(0.4f));
 
+    polyToggle.setColour(juce::ToggleButton::textColourId, UI::Colors::FilterText);
+    polyToggle.setColour(juce::ToggleButton::tickColourId, UI::Colors::FilterText);
+    polyToggle.setColour(juce::ToggleButton::tickDisabledColourId, UI::Colors::FilterText.withAlpha(0.4f));
+
     typeSelector.updateTheme();
     slopeSelector.updateTheme();
     linkSelector.updateTheme();
@@ -394,23 +389,50 @@ void FilterComponent::setLinkableTargets(const std::unordered_map<std::string, L
     for (const auto& [name, ptr] : linkableTargets)
         linkSelector.addItem(name, id++);
 
+    // Last, as in the parameter's choices
+    linkSelector.addItem(SignalGraph::getBusName(), id++);
+
     linkSelector.setSelectedId(1, juce::dontSendNotification);
     currentlyLinkedTarget = nullptr;
+    linkedToBus = false;
 
     linkSelector.onChange = [this]()
         {
             const auto selectedName = linkSelector.getText().toStdString();
+            auto* filter = processor.getFilter(this->filterIndex);
+
+            // Drop the current link unless it is the one selected again
+            const auto releaseCurrent = [this, filter](const Linkable* keep, bool keepBus)
+                {
+                    if (currentlyLinkedTarget && currentlyLinkedTarget != keep)
+                    {
+                        processor.unlinkFilter(currentlyLinkedTarget, filter);
+                        processor.unregisterFilterLink(currentlyLinkedTarget, this);
+                        currentlyLinkedTarget = nullptr;
+                    }
+
+                    if (linkedToBus && !keepBus)
+                    {
+                        processor.getSignalGraph().disconnectFilter(SignalGraph::bus, filter);
+                        linkedToBus = false;
+                    }
+                };
 
             // User selected "-"
             if (selectedName == "-")
             {
-                if (currentlyLinkedTarget)
-                {
-                    if (auto* osc = dynamic_cast<Oscillator*>(currentlyLinkedTarget))
-                        osc->setFilter(nullptr);
+                releaseCurrent(nullptr, false);
+                return;
+            }
+
+            // Every oscillator without a filter of its own sums into this one
+            if (selectedName == SignalGraph::getBusName().toStdString())
+            {
+                releaseCurrent(nullptr, true);
+                if (filter != nullptr)
+                    processor.getSignalGraph().connectFilter(SignalGraph::bus, filter);
 
-                    currentlyLinkedTarget = nullptr;
-                }
+                linkedToBus = true;
                 return;
             }
 
@@ -418,14 +440,10 @@ void FilterComponent::setLinkableTargets(const std::unordered_map<std::string, L
             auto it = linkableTargets.find(selectedName);
             if (it != linkableTargets.end())
             {
-                if (currentlyLinkedTarget && currentlyLinkedTarget != it->second)
-                {
-                    if (auto* prevOsc = dynamic_cast<Oscillator*>(currentlyLinkedTarget))
-                        prevOsc->setFilter(nullptr);
-                }
+                releaseCurrent(it->second, false);
 
-                if (auto* osc = dynamic_cast<Oscillator*>(it->second))
-                    osc->setFilter(processor.getFilter(this->filterIndex));
+                // Appended to the target's chain, after any filter linked to it before
+                processor.linkFilter(it->second, filter);
 
                 processor.registerFilterLinkOwnership(it->second, this);
                 currentlyLinkedTarget = it->second;
@@ -437,9 +455,7 @@ void FilterComponent::unlinkTarget(Linkable* target)
 {
     if (currentlyLinkedTarget == target)
     {
-        if (auto* osc = dynamic_cast<Oscillator*>(target))
-            osc->setFilter(nullptr);
-
+        processor.unlinkFilter(target, processor.getFilter(this->filterIndex));
         currentlyLinkedTarget = nullptr;
         linkSelector.setSelectedId(1, juce::dontSendNotification); // reset to "-"
     }
@@ -475,13 +491,17 @@ void FilterComponent::updateGraphFromKnobs()
     filterGraph.setDrive(driveKnob.getSliderValue());
     filterGraph.setMix(mixKnob.getSliderValue());
 
+    // Derive the bands from the knobs, rather than reading the audio thread's filter state
     if (type == Filter::Type::Talkbox)
     {
-        const auto& talkboxFilter = processor.getFilter(filterIndex)->getTalkboxFilter();
-        filterGraph.setTalkboxBands(talkboxFilter.getFormantBandsForGraph());
+        const auto vowel = static_cast<TalkboxFilter::Vowel>(juce::jlimit(0,
+            static_cast<int>(TalkboxFilter::Vowel::Count) - 1, vowelSelector.getSelectedId() - 1));
+        const float q = FormattingUtils::normalizedToValue(
+            factorKnob.getSliderValue(),
+            FormattingUtils::FormatType::Resonance,
+            FormattingUtils::resonanceMin,
+            FormattingUtils::resonanceMax);
+
+        filterGraph.setTalkboxBands(TalkboxFilter::computeFormantBands(vowel, morphKnob.getSliderValue(), q));
     }
-
-    filterGraph.generateAxisGridLines(lastGraphArea.toFloat());
-    filterGraph.repaint();
-    repaint(graphArea);
 }
\ No newline at end of file
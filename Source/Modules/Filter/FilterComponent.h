@@ -29,13 +29,6 @@ public:
     /** @brief Destructor. Resets all APVTS attachments and cleans up knobs. */
     ~FilterComponent() override;
 
-    /**
-     * @brief Registers modulation parameters for filter knobs.
-     * @param index Filter index.
-     * @param layout Reference to the APVTS parameter layout.
-     */
-    static void registerModulationParameters(int index, juce::AudioProcessorValueTreeState::ParameterLayout& layout);
-
     /**
      * @brief Returns the total width.
      * @return Width in pixels.
@@ -107,6 +100,7 @@ private:
     juce::Label typeLabel;           ///< Label for filter type
     ComboBox typeSelector;           ///< Filter type selector
     juce::ToggleButton bypassToggle; ///< Bypass on/off toggle
+    juce::ToggleButton polyToggle;   ///< Per-voice filtering toggle
     juce::Label linkLabel;           ///< Label for link selector
     ComboBox linkSelector;           ///< Oscillator linking selector
     juce::Label slopeLabel;          ///< Label for slope selector
@@ -126,6 +120,7 @@ private:
 
     std::unordered_map<std::string, Linkable*> linkableTargets; ///< Available link targets
     Linkable* currentlyLinkedTarget = nullptr;                  ///< Active link target
+    bool linkedToBus = false;                                   ///< True while the filter runs on the oscillator bus
 
     /**
      * @brief Initializes and binds a knob to its parameter.
@@ -140,6 +135,7 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> typeAttachment;   ///< APVTS attachment for type
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> linkAttachment;   ///< APVTS attachment for link
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment>   bypassAttachment; ///< APVTS attachment for bypass
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment>   polyAttachment;   ///< APVTS attachment for poly
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> slopeAttachment;  ///< APVTS attachment for slope
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> vowelAttachment;  ///< APVTS attachment for vowel
 
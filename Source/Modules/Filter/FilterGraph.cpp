@@ -1,29 +1,40 @@
 ﻿#include "FilterGraph.h"
 
 FilterGraph::FilterGraph()
+    : responseThread(*this)
 {
     setInterceptsMouseClicks(false, false);
-    updateCoefficients();
+    responseThread.startThread(juce::Thread::Priority::low);
+    requestResponse();
+}
+
+FilterGraph::~FilterGraph()
+{
+    responseThread.stopThread(1000);
+    cancelPendingUpdate();
 }
 
 void FilterGraph::setSampleRate(double newSampleRate)
 {
     sampleRate = newSampleRate;
-    updateCoefficients();
+    requestResponse();
 }
 
 void FilterGraph::setType(Filter::Type newType)
 {
     type = newType;
-    updateCoefficients();
+    requestResponse();
 }
 
 void FilterGraph::setSlope(Filter::Slope newSlope)
 {
+    if (newSlope == slope)
+        return;
+
     slope = newSlope;
     maxDecibels = (slope == Filter::Slope::dB24) ? 45.0f : 25.0f;
 
-    updateCoefficients();
+    requestResponse();
 
     if (!lastPlotArea.isEmpty())
         generateAxisGridLines(lastPlotArea);
@@ -40,24 +51,33 @@ void FilterGraph::setCutoffFrequency(float cutoff)
         FormattingUtils::freqMinHz,
         FormattingUtils::freqMaxHz);
 
-    updateCoefficients();
+    requestResponse();
 }
 
 void FilterGraph::setResonance(float res)
 {
     resonance = res;
-    updateCoefficients();
+    requestResponse();
 }
 
 void FilterGraph::setDrive(float newDrive)
 {
-    drive = juce::jmax(0.0f, newDrive);
+    const float clamped = juce::jmax(0.0f, newDrive);
+    if (clamped == drive)
+        return;
+
+    drive = clamped;
+    requestResponse();
     repaint();
 }
 
 void FilterGraph::setMix(float newMix)
 {
-    mix = juce::jlimit(0.0f, 1.0f, newMix);
+    const float clamped = juce::jlimit(0.0f, 1.0f, newMix);
+    if (clamped == mix)
+        return;
+
+    mix = clamped;
     repaint();
 }
 
@@ -71,6 +91,11 @@ void FilterGraph::paint(juce::Graphics& g)
     drawResponseCurve(g, plotArea);
 }
 
+void FilterGraph::resized()
+{
+    requestResponse();
+}
+
 const std::vector<FilterGraphGridLine>& FilterGraph::getXGridLines() const
 {
     return xGridLines;
@@ -143,58 +168,38 @@ void FilterGraph::generateAxisGridLines(juce::Rectangle<float> plotArea)
 void FilterGraph::setTalkboxBands(const std::array<TalkboxFilter::FormantBand, TalkboxFilter::numFormants>& bands)
 {
     talkboxBands = bands;
-    repaint();
+    requestResponse();
 }
 
-void FilterGraph::updateCoefficients()
+void FilterGraph::requestResponse()
 {
-    if (type == Filter::Type::Talkbox)
+    ResponseSettings settings;
+    settings.sampleRate = sampleRate;
+    settings.type = type;
+    settings.slope = slope;
+    settings.cutoffHz = cutoffHz;
+    settings.q = computeQFromResonance();
+    settings.drive = drive;
+    settings.maxDecibels = maxDecibels;
+    settings.bands = talkboxBands;
+    settings.plotArea = getLocalBounds().toFloat();
+
+    // Knob callbacks fire for every setter, only a different curve is worth computing
+    if (hasRequested && settings == lastRequested)
         return;
 
-    coeff1.reset();
-    coeff2.reset();
-
-    float q = computeQFromResonance();
-
-    switch (type)
-    {
-    case Filter::Type::LowPass:
-        coeff1 = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, cutoffHz, q);
-        break;
-    case Filter::Type::HighPass:
-        coeff1 = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, cutoffHz, q);
-        break;
-    case Filter::Type::BandPass:
-        coeff1 = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, cutoffHz, q);
-        break;
-    default:
-        coeff1 = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, cutoffHz, q);
-        break;
-    }
-
-    if (slope == Filter::Slope::dB24)
-    {
-        switch (type)
-        {
-        case Filter::Type::LowPass:
-            coeff2 = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, cutoffHz, q);
-            break;
-        case Filter::Type::HighPass:
-            coeff2 = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, cutoffHz, q);
-            break;
-        case Filter::Type::BandPass:
-            coeff2 = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, cutoffHz, q);
-            break;
-        default:
-            coeff2 = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, cutoffHz, q);
-            break;
-        }
-    }
+    lastRequested = settings;
+    hasRequested = true;
+    responseThread.request(settings);
+}
 
+void FilterGraph::handleAsyncUpdate()
+{
+    responsePath = responseThread.getResult();
     repaint();
 }
 
-float FilterGraph::getLogFrequencyPosition(float freq) const
+float FilterGraph::getLogFrequencyPosition(float freq)
 {
     float minLog = std::log10(minFrequency);
     float maxLog = std::log10(maxFrequency);
@@ -205,7 +210,18 @@ float FilterGraph::getLogFrequencyPosition(float freq) const
 
 float FilterGraph::getDecibelY(float dB, float top, float bottom) const
 {
-    return juce::jmap(juce::jlimit(minDecibels, maxDecibels, dB), minDecibels, maxDecibels, bottom, top);
+    return decibelToY(dB, top, bottom, maxDecibels);
+}
+
+float FilterGraph::decibelToY(float dB, float top, float bottom, float maxDb)
+{
+    return juce::jmap(juce::jlimit(minDecibels, maxDb, dB), minDecibels, maxDb, bottom, top);
+}
+
+float FilterGraph::getBinFrequency(int bin)
+{
+    const float position = static_cast<float>(bin) / static_cast<float>(numFrequencyBins - 1);
+    return minFrequency * std::pow(maxFrequency / minFrequency, position);
 }
 
 void FilterGraph::drawGrid(juce::Graphics& g, juce::Rectangle<float> plotArea)
@@ -239,30 +255,10 @@ void FilterGraph::drawGrid(juce::Graphics& g, juce::Rectangle<float> plotArea)
 
 void FilterGraph::drawResponseCurve(juce::Graphics& g, juce::Rectangle<float> plotArea)
 {
-    std::vector<float> magnitudes(numFrequencyBins, 0.0f);
-    generateFrequencyResponse(magnitudes);
-
-    juce::Path responsePath;
     const float left = plotArea.getX();
     const float right = plotArea.getRight();
     const float top = plotArea.getY();
     const float bottom = plotArea.getBottom();
-    const float width = plotArea.getWidth();
-
-    for (int i = 0; i < numFrequencyBins; ++i)
-    {
-        float freq = juce::jmap((float)i, 0.0f, (float)(numFrequencyBins - 1), minFrequency, maxFrequency);
-        float normX = getLogFrequencyPosition(freq);
-        float x = left + normX * width;
-
-        float dB = juce::Decibels::gainToDecibels(magnitudes[i], minDecibels);
-        float y = getDecibelY(dB, top, bottom);
-
-        if (i == 0)
-            responsePath.startNewSubPath(x, y);
-        else
-            responsePath.lineTo(x, y);
-    }
 
     // --- Drive flood overlay ---
     if (drive > 0.0f && mix > 0.0f)
@@ -294,55 +290,189 @@ void FilterGraph::drawResponseCurve(juce::Graphics& g, juce::Rectangle<float> pl
     g.strokePath(responsePath, juce::PathStrokeType(2.0f));
 }
 
-void FilterGraph::generateFrequencyResponse(std::vector<float>& magnitudes)
+float FilterGraph::computeQFromResonance() const
 {
-    magnitudes.assign(numFrequencyBins, 0.0f);
+    return FormattingUtils::normalizedToValue(
+        resonance,
+        FormattingUtils::FormatType::Resonance,
+        FormattingUtils::resonanceMin,
+        FormattingUtils::resonanceMax
+    );
+}
+bool FilterGraph::ResponseSettings::operator==(const ResponseSettings& other) const noexcept
+{
+    if (sampleRate != other.sampleRate || type != other.type || drive != other.drive
+        || maxDecibels != other.maxDecibels || plotArea != other.plotArea)
+        return false;
 
     if (type == Filter::Type::Talkbox)
     {
-        // --- Drive scaling for Talkbox ---
-        float shaped = std::pow(drive, 1.5f);
-        float gainBoost = 1.0f + shaped * 3.0f;
-
-        for (int i = 0; i < numFrequencyBins; ++i)
+        for (int i = 0; i < TalkboxFilter::numFormants; ++i)
         {
-            float freq = juce::jmap((float)i, 0.0f, (float)(numFrequencyBins - 1), minFrequency, maxFrequency);
-            float totalMag = 0.0f;
+            if (bands[i].frequency != other.bands[i].frequency || bands[i].q != other.bands[i].q
+                || bands[i].gain != other.bands[i].gain)
+                return false;
+        }
+        return true;
+    }
+
+    return slope == other.slope && cutoffHz == other.cutoffHz && q == other.q;
+}
+
+FilterGraph::ResponseThread::ResponseThread(FilterGraph& owner)
+    : juce::Thread("FilterGraph response"), graph(owner)
+{
+}
+
+void FilterGraph::ResponseThread::request(const ResponseSettings& settings)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        pending = settings;
+        hasPending = true;
+    }
 
-            for (const auto& band : talkboxBands)
+    notify();
+}
+
+juce::Path FilterGraph::ResponseThread::getResult() const
+{
+    const juce::ScopedLock sl(lock);
+    return result;
+}
+
+void FilterGraph::ResponseThread::run()
+{
+    while (!threadShouldExit())
+    {
+        ResponseSettings settings;
+        {
+            const juce::ScopedLock sl(lock);
+            if (hasPending)
             {
-                auto coeff = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, band.frequency, band.q);
-                float mag = coeff->getMagnitudeForFrequency(freq, sampleRate);
-                totalMag += band.gain * mag;
+                settings = pending;
+                hasPending = false;
             }
+        }
 
-            magnitudes[i] = gainBoost * totalMag;
+        if (settings.plotArea.isEmpty())
+        {
+            wait(-1);
+            continue;
         }
-    }
-    else
-    {
-        // Default: Ladder filter response
-        float shaped = std::pow(drive, 1.5f);
-        float gainBoost = 1.0f + shaped * 3.0f;
 
+        computeDecibels(settings);
+
+        // Bins are log-spaced, so they sit evenly along the log frequency axis
+        juce::Path path;
+        path.preallocateSpace(numFrequencyBins * 3);
+
+        const auto& area = settings.plotArea;
+        const float binWidth = area.getWidth() / static_cast<float>(numFrequencyBins - 1);
         for (int i = 0; i < numFrequencyBins; ++i)
         {
-            float freq = juce::jmap((float)i, 0.0f, (float)(numFrequencyBins - 1), minFrequency, maxFrequency);
+            const float x = area.getX() + binWidth * static_cast<float>(i);
+            const float y = decibelToY(magnitudes[i], area.getY(), area.getBottom(), settings.maxDecibels);
 
-            float mag1 = coeff1 ? coeff1->getMagnitudeForFrequency(freq, sampleRate) : 1.0f;
-            float mag2 = coeff2 ? coeff2->getMagnitudeForFrequency(freq, sampleRate) : 1.0f;
+            if (i == 0)
+                path.startNewSubPath(x, y);
+            else
+                path.lineTo(x, y);
+        }
 
-            magnitudes[i] = gainBoost * mag1 * mag2;
+        {
+            const juce::ScopedLock sl(lock);
+            result.swapWithPath(path);
         }
+
+        graph.triggerAsyncUpdate();
     }
 }
 
-float FilterGraph::computeQFromResonance() const
+void FilterGraph::ResponseThread::computeDecibels(const ResponseSettings& settings)
 {
-    return FormattingUtils::normalizedToValue(
-        resonance,
-        FormattingUtils::FormatType::Resonance,
-        FormattingUtils::resonanceMin,
-        FormattingUtils::resonanceMax
-    );
-}
\ No newline at end of file
+    updateFrequencyTables(settings.sampleRate);
+
+    // Drive scaling, same for talkbox and ladder
+    const float shaped = settings.drive * std::sqrt(settings.drive);
+    const float gainBoost = 1.0f + shaped * 3.0f;
+
+    if (settings.type == Filter::Type::Talkbox)
+    {
+        // Parallel bands: one coefficient set per band, then a weighted sum of magnitudes
+        std::fill(magnitudes.begin(), magnitudes.end(), 0.0f);
+        for (const auto& band : settings.bands)
+        {
+            auto coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass(settings.sampleRate, band.frequency, band.q);
+            applyBiquad(*coefficients, band.gain, true);
+        }
+
+        juce::FloatVectorOperations::multiply(magnitudes.data(), gainBoost, numFrequencyBins);
+    }
+    else
+    {
+        // Cascaded stages: the 24 dB slope runs the same biquad twice
+        juce::dsp::IIR::Coefficients<float>::Ptr coefficients;
+        switch (settings.type)
+        {
+        case Filter::Type::HighPass:
+            coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(settings.sampleRate, settings.cutoffHz, settings.q);
+            break;
+        case Filter::Type::BandPass:
+            coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass(settings.sampleRate, settings.cutoffHz, settings.q);
+            break;
+        default:
+            coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(settings.sampleRate, settings.cutoffHz, settings.q);
+            break;
+        }
+
+        std::fill(magnitudes.begin(), magnitudes.end(), gainBoost);
+        applyBiquad(*coefficients, 1.0f, false);
+        if (settings.slope == Filter::Slope::dB24)
+            applyBiquad(*coefficients, 1.0f, false);
+    }
+
+    for (auto& magnitude : magnitudes)
+        magnitude = juce::Decibels::gainToDecibels(magnitude, minDecibels);
+}
+
+void FilterGraph::ResponseThread::updateFrequencyTables(double newSampleRate)
+{
+    if (newSampleRate == tablesSampleRate && !cosW.empty())
+        return;
+
+    tablesSampleRate = newSampleRate;
+    cosW.resize(numFrequencyBins);
+    cos2W.resize(numFrequencyBins);
+    magnitudes.resize(numFrequencyBins);
+
+    for (int i = 0; i < numFrequencyBins; ++i)
+    {
+        const double w = juce::MathConstants<double>::twoPi * getBinFrequency(i) / newSampleRate;
+        cosW[i] = static_cast<float>(std::cos(w));
+        cos2W[i] = static_cast<float>(std::cos(2.0 * w));
+    }
+}
+
+void FilterGraph::ResponseThread::applyBiquad(const juce::dsp::IIR::Coefficients<float>& coefficients, float weight, bool accumulate)
+{
+    const float* c = coefficients.getRawCoefficients();
+    const float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+
+    // |H(e^jw)|^2 expanded in cos(w) and cos(2w), so each bin is a handful of multiply-adds
+    const float numConstant = b0 * b0 + b1 * b1 + b2 * b2;
+    const float numCos = 2.0f * (b0 * b1 + b1 * b2);
+    const float numCos2 = 2.0f * b0 * b2;
+    const float denConstant = 1.0f + a1 * a1 + a2 * a2;
+    const float denCos = 2.0f * (a1 + a1 * a2);
+    const float denCos2 = 2.0f * a2;
+
+    float* mags = magnitudes.data();
+    for (int i = 0; i < numFrequencyBins; ++i)
+    {
+        const float numerator = numConstant + numCos * cosW[i] + numCos2 * cos2W[i];
+        const float denominator = denConstant + denCos * cosW[i] + denCos2 * cos2W[i];
+        const float magnitude = weight * std::sqrt(juce::jmax(0.0f, numerator) / juce::jmax(1.0e-12f, denominator));
+        mags[i] = accumulate ? mags[i] + magnitude : mags[i] * magnitude;
+    }
+}
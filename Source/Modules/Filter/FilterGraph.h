@@ -21,15 +21,23 @@ struct FilterGraphGridLine
 /**
  * @class FilterGraph
  * @brief A real-time frequency response graph for visualizing filter behavior.
+ *
+ * The response curve is computed on a background thread whenever a setting
+ * that shapes it changes, and paint() only strokes the cached path.
  */
-class FilterGraph : public juce::Component
+class FilterGraph : public juce::Component, private juce::AsyncUpdater
 {
 public:
     /**
-     * @brief Constructs a FilterGraph component.
+     * @brief Constructs a FilterGraph component and starts its response thread.
      */
     FilterGraph();
 
+    /**
+     * @brief Stops the response thread.
+     */
+    ~FilterGraph() override;
+
     /**
      * @brief Sets the sample rate for frequency response calculations.
      * @param newSampleRate The current audio sample rate in Hz.
@@ -78,6 +86,11 @@ public:
      */
     void paint(juce::Graphics& g) override;
 
+    /**
+     * @brief Overridden JUCE function. Recomputes the curve for the new size.
+     */
+    void resized() override;
+
     /**
      * @brief Returns the list of X-axis (frequency) grid lines.
      * @return Const reference to vector of FilterGraphGridLine.
@@ -103,6 +116,91 @@ public:
     void setTalkboxBands(const std::array<TalkboxFilter::FormantBand, TalkboxFilter::numFormants>& bands);
 
 private:
+    /**
+     * @struct ResponseSettings
+     * @brief Everything the response curve depends on, copied to the response thread.
+     */
+    struct ResponseSettings
+    {
+        double sampleRate = 44100.0;               ///< Sample rate in Hz
+        Filter::Type type = Filter::Type::LowPass; ///< Filter type
+        Filter::Slope slope = Filter::Slope::dB24; ///< Filter slope
+        float cutoffHz = 1000.0f;                  ///< Cutoff frequency in Hz
+        float q = 0.707f;                          ///< Q factor derived from resonance
+        float drive = 1.0f;                        ///< Drive amount
+        float maxDecibels = 25.0f;                 ///< Top of the dB axis
+        std::array<TalkboxFilter::FormantBand, TalkboxFilter::numFormants> bands{}; ///< Formant bands (talkbox only)
+        juce::Rectangle<float> plotArea;           ///< Bounds the path is laid out in
+
+        /**
+         * @brief Returns true if both settings produce the same curve.
+         */
+        bool operator==(const ResponseSettings& other) const noexcept;
+    };
+
+    /**
+     * @class ResponseThread
+     * @brief Background thread that turns the latest settings into a response path.
+     *
+     * Requests coalesce: if settings change faster than the curve is computed,
+     * only the newest ones are processed.
+     */
+    class ResponseThread : public juce::Thread
+    {
+    public:
+        /**
+         * @brief Constructs the thread for a graph.
+         * @param owner Graph notified when a new path is ready.
+         */
+        explicit ResponseThread(FilterGraph& owner);
+
+        /**
+         * @brief Queues settings to compute, replacing any not yet started.
+         * @param settings Settings to compute the curve for.
+         */
+        void request(const ResponseSettings& settings);
+
+        /**
+         * @brief Returns the newest computed path.
+         */
+        juce::Path getResult() const;
+
+        /** @brief Computes queued requests until asked to exit. */
+        void run() override;
+
+    private:
+        /**
+         * @brief Computes the magnitude response in dB at every bin.
+         * @param settings Settings to compute with.
+         */
+        void computeDecibels(const ResponseSettings& settings);
+
+        /**
+         * @brief Rebuilds the per-bin cos(w) and cos(2w) tables if the sample rate changed.
+         * @param sampleRate Sample rate in Hz.
+         */
+        void updateFrequencyTables(double sampleRate);
+
+        /**
+         * @brief Applies a biquad's magnitude response to the magnitudes in one vectorizable pass.
+         * @param coefficients Biquad coefficients (b0, b1, b2, a1, a2).
+         * @param weight Linear gain applied to the biquad's magnitude.
+         * @param accumulate True to add weight * |H| (parallel bands), false to multiply by it (cascaded stages).
+         */
+        void applyBiquad(const juce::dsp::IIR::Coefficients<float>& coefficients, float weight, bool accumulate);
+
+        FilterGraph& graph;                       ///< Graph notified when a path is ready
+        mutable juce::CriticalSection lock;       ///< Guards pending and result
+        ResponseSettings pending;                 ///< Latest requested settings
+        bool hasPending = false;                  ///< True if pending has not been computed yet
+        juce::Path result;                        ///< Newest computed path
+
+        double tablesSampleRate = 0.0;            ///< Sample rate the frequency tables were built for
+        std::vector<float> cosW;                  ///< cos(w) per bin
+        std::vector<float> cos2W;                 ///< cos(2w) per bin
+        std::vector<float> magnitudes;            ///< Linear magnitude per bin, then dB
+    };
+
     double sampleRate = 44100.0;                 ///< Current sample rate
     Filter::Type type = Filter::Type::LowPass;   ///< Selected filter type
     Filter::Slope slope = Filter::Slope::dB24;   ///< Selected slope
@@ -111,9 +209,6 @@ private:
     float drive = 1.0f;                          ///< Drive amount [0.0  1.0]
     float mix = 1.0f;                            ///< Mix level [0.0  1.0]
 
-    juce::dsp::IIR::Coefficients<float>::Ptr coeff1; ///< First filter stage
-    juce::dsp::IIR::Coefficients<float>::Ptr coeff2; ///< Second filter stage (24 dB only)
-
     static constexpr int numFrequencyBins = 1024;   ///< Number of frequency points
     static constexpr float minFrequency = 20.0f;    ///< Minimum frequency (Hz)
     static constexpr float maxFrequency = 20000.0f; ///< Maximum frequency (Hz)
@@ -130,18 +225,35 @@ private:
     std::vector<FilterGraphGridLine> xGridLines; ///< Frequency axis lines
     std::vector<FilterGraphGridLine> yGridLines; ///< Decibel axis lines
     juce::Rectangle<float> lastPlotArea;         ///< Last used plot bounds
- 
+
+    ResponseSettings lastRequested;              ///< Settings most recently sent to the response thread
+    bool hasRequested = false;                   ///< False until the first request
+    juce::Path responsePath;                     ///< Cached response curve, stroked by paint()
+    ResponseThread responseThread;               ///< Computes responsePath off the message thread
+
     /**
-     * @brief Updates the internal IIR coefficients.
+     * @brief Sends the current settings to the response thread if they changed the curve.
      */
-    void updateCoefficients();
+    void requestResponse();
+
+    /**
+     * @brief Picks up the newest path from the response thread and repaints.
+     */
+    void handleAsyncUpdate() override;
 
     /**
      * @brief Computes normalized X position for a frequency.
      * @param freq Frequency in Hz.
      * @return Normalized [0.0  1.0].
      */
-    float getLogFrequencyPosition(float freq) const;
+    static float getLogFrequencyPosition(float freq);
+
+    /**
+     * @brief Returns the frequency of a response bin, bins are spaced logarithmically.
+     * @param bin Bin index.
+     * @return Frequency in Hz.
+     */
+    static float getBinFrequency(int bin);
 
     /**
      * @brief Converts a dB value to Y pixel coordinate.
@@ -152,6 +264,16 @@ private:
      */
     float getDecibelY(float dB, float top, float bottom) const;
 
+    /**
+     * @brief Converts a dB value to Y pixel coordinate for a given dB range.
+     * @param dB dB value.
+     * @param top Top Y boundary.
+     * @param bottom Bottom Y boundary.
+     * @param maxDb Top of the dB axis.
+     * @return Y pixel position.
+     */
+    static float decibelToY(float dB, float top, float bottom, float maxDb);
+
     /**
      * @brief Draws the background grid lines.
      * @param g Graphics context.
@@ -166,12 +288,6 @@ private:
      */
     void drawResponseCurve(juce::Graphics& g, juce::Rectangle<float> plotArea);
 
-    /**
-     * @brief Computes the magnitude response at each bin.
-     * @param magnitudes Vector to fill with magnitudes.
-     */
-    void generateFrequencyResponse(std::vector<float>& magnitudes);
-
     /**
      * @brief Computes Q factor from resonance value.
      * @return Q factor for filter design.
@@ -0,0 +1,209 @@
+#include "SidechainTalkbox.h"
+
+namespace
+{
+    constexpr int fftMask = SidechainTalkbox::fftSize - 1;
+
+    // A squared periodic Hann window overlapped by four sums to 1.5
+    constexpr float overlapGain = 1.0f / 1.5f;
+}
+
+SidechainTalkbox::SidechainTalkbox(juce::AudioProcessorValueTreeState& apvts)
+{
+    mixHandle = apvts.getRawParameterValue(getParamSpecs(ParamID::Mix).id);
+    widthHandle = apvts.getRawParameterValue(getParamSpecs(ParamID::Width).id);
+    jassert(mixHandle != nullptr && widthHandle != nullptr);
+
+    for (int i = 0; i < fftSize; ++i)
+        window[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * static_cast<float>(i) / fftSize);
+
+    updateBands(getParamSpecs(ParamID::Width).defaultValue);
+}
+
+KnobParamSpecs SidechainTalkbox::getParamSpecs(ParamID param)
+{
+    switch (param)
+    {
+    case ParamID::Mix:
+        return { "TALKBOX_MIX", "Talkbox Mix", 0.0f, 1.0f, 0.01f, 1.0f, FormattingUtils::FormatType::Percent };
+
+    case ParamID::Width:
+        return { "TALKBOX_WIDTH", "Talkbox Width", minWidth, maxWidth, 0.1f, 4.0f, FormattingUtils::FormatType::Normal };
+
+    default:
+        return {};
+    }
+}
+
+void SidechainTalkbox::addParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout)
+{
+    for (const auto param : { ParamID::Mix, ParamID::Width })
+    {
+        const auto spec = getParamSpecs(param);
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            spec.id, spec.name,
+            juce::NormalisableRange<float>(spec.minValue, spec.maxValue, spec.stepSize),
+            spec.defaultValue));
+    }
+}
+
+void SidechainTalkbox::prepare(int newNumChannels)
+{
+    jassert(newNumChannels == 1 || newNumChannels == 2);
+    numChannels = juce::jlimit(1, maxChannels, newNumChannels);
+    reset();
+}
+
+void SidechainTalkbox::reset() noexcept
+{
+    for (auto& channel : carrierInput)
+        channel.fill(0.0f);
+
+    for (auto& channel : output)
+        channel.fill(0.0f);
+
+    modulatorInput.fill(0.0f);
+    position = 0;
+    hopPosition = 0;
+    silentSamples = fftSize;
+}
+
+void SidechainTalkbox::updateFromParameters() noexcept
+{
+    mix = juce::jlimit(0.0f, 1.0f, mixHandle->load());
+
+    // Rebuilding the bands takes a pow per bin, so only when the width moved
+    const float newWidth = juce::jlimit(minWidth, maxWidth, widthHandle->load());
+    if (newWidth != width)
+        updateBands(newWidth);
+}
+
+void SidechainTalkbox::process(juce::AudioBuffer<float>& carrier, int startSample, int numSamples, const float* modulator) noexcept
+{
+    const int channels = juce::jmin(numChannels, carrier.getNumChannels());
+    if (channels == 0 || modulator == nullptr)
+        return;
+
+    // Frames end on hop boundaries, so a segment is walked in chunks that stop at each one
+    for (int done = 0; done < numSamples; )
+    {
+        const int chunk = juce::jmin(numSamples - done, hopSize - hopPosition);
+        float chunkPeak = 0.0f;
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            float* data = carrier.getWritePointer(ch, startSample + done);
+            auto& input = carrierInput[static_cast<size_t>(ch)];
+            auto& accumulator = output[static_cast<size_t>(ch)];
+
+            for (int i = 0; i < chunk; ++i)
+            {
+                const auto index = static_cast<size_t>((position + i) & fftMask);
+                chunkPeak = juce::jmax(chunkPeak, std::abs(data[i]));
+                input[index] = data[i];
+                data[i] = accumulator[index];
+                accumulator[index] = 0.0f;
+            }
+        }
+
+        for (int i = 0; i < chunk; ++i)
+            modulatorInput[static_cast<size_t>((position + i) & fftMask)] = modulator[done + i];
+
+        silentSamples = chunkPeak < silenceThreshold ? juce::jmin(fftSize, silentSamples + chunk) : 0;
+        position = (position + chunk) & fftMask;
+        hopPosition += chunk;
+        done += chunk;
+
+        if (hopPosition == hopSize)
+        {
+            hopPosition = 0;
+            processFrame();
+        }
+    }
+}
+
+bool SidechainTalkbox::isSilent() const noexcept
+{
+    return silentSamples >= fftSize;
+}
+
+void SidechainTalkbox::processFrame() noexcept
+{
+    forwardTransform(modulatorInput);
+    computeEnvelope(modulatorEnvelope);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        forwardTransform(carrierInput[static_cast<size_t>(ch)]);
+        computeEnvelope(carrierEnvelope);
+
+        // Flatten the carrier and shape it with the modulator, blended with the unchanged bins
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            const auto b = static_cast<size_t>(bin);
+            const float vocoded = juce::jmin(maxGain, modulatorEnvelope[b] / (carrierEnvelope[b] + envelopeFloor));
+            const float gain = (1.0f - mix) + mix * vocoded;
+
+            fftData[2 * b] *= gain;
+            fftData[2 * b + 1] *= gain;
+        }
+
+        fft.performRealOnlyInverseTransform(fftData.data());
+
+        auto& accumulator = output[static_cast<size_t>(ch)];
+        for (int i = 0; i < fftSize; ++i)
+        {
+            const auto index = static_cast<size_t>((position + i) & fftMask);
+            accumulator[index] += fftData[static_cast<size_t>(i)] * window[static_cast<size_t>(i)] * overlapGain;
+        }
+    }
+}
+
+void SidechainTalkbox::forwardTransform(const Frame& input) noexcept
+{
+    // The oldest sample sits at the write position
+    for (int i = 0; i < fftSize; ++i)
+    {
+        const auto index = static_cast<size_t>((position + i) & fftMask);
+        fftData[static_cast<size_t>(i)] = input[index] * window[static_cast<size_t>(i)];
+    }
+
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    fft.performRealOnlyForwardTransform(fftData.data(), true);
+}
+
+void SidechainTalkbox::computeEnvelope(Spectrum& envelope) noexcept
+{
+    prefixSums[0] = 0.0f;
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const auto b = static_cast<size_t>(bin);
+        const float magnitude = std::sqrt(fftData[2 * b] * fftData[2 * b] + fftData[2 * b + 1] * fftData[2 * b + 1]);
+        prefixSums[b + 1] = prefixSums[b] + magnitude;
+    }
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const auto b = static_cast<size_t>(bin);
+        const float sum = prefixSums[static_cast<size_t>(bandHigh[b]) + 1] - prefixSums[static_cast<size_t>(bandLow[b])];
+        envelope[b] = juce::jmax(0.0f, sum) * bandScale[b];
+    }
+}
+
+void SidechainTalkbox::updateBands(float widthSemitones) noexcept
+{
+    width = widthSemitones;
+
+    // Half the band on either side, so the band spans the width in semitones around the bin
+    const float halfRatio = std::pow(2.0f, widthSemitones / 24.0f) - 1.0f;
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const auto b = static_cast<size_t>(bin);
+        const int half = juce::jmax(1, juce::roundToInt(static_cast<float>(bin) * halfRatio));
+
+        bandLow[b] = juce::jmax(0, bin - half);
+        bandHigh[b] = juce::jmin(numBins - 1, bin + half);
+        bandScale[b] = 1.0f / static_cast<float>(bandHigh[b] - bandLow[b] + 1);
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "../../Common.h"
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * @class SidechainTalkbox
+ * @brief Vocoder that imposes the spectral envelope of a sidechain input on the synth's main mix.
+ *
+ * Both signals run through a streaming short-time FFT: every hop the last
+ * fftSize samples are windowed and transformed, the magnitude spectra are
+ * smoothed into envelopes over a band of WIDTH semitones around each bin,
+ * and every carrier bin is scaled by the modulator's envelope over the
+ * carrier's own. Flattening the carrier first lets any waveform pass on the
+ * modulator's formants. The frames are windowed again and overlap-added, so
+ * at zero MIX the carrier comes out unchanged, delayed by the fftSize
+ * samples the processor reports as latency.
+ *
+ * Every buffer is a fixed member array, so nothing allocates after
+ * construction and the cost is a few FFTs per hop, whatever the block size.
+ */
+class SidechainTalkbox
+{
+public:
+    static constexpr int fftOrder = 10;                      ///< log2 of the frame length
+    static constexpr int fftSize = 1 << fftOrder;            ///< Frame length, also the latency in samples
+    static constexpr int hopSize = fftSize / 4;              ///< Samples between frames, 75% overlap
+    static constexpr int numBins = fftSize / 2 + 1;          ///< Non-negative frequency bins
+    static constexpr int maxChannels = 2;                    ///< Carrier channels processed at most
+
+    /**
+     * @enum ParamID
+     * @brief Identifiers for the sidechain talkbox parameters.
+     */
+    enum class ParamID
+    {
+        Mix,    ///< Balance of the vocoded and the delayed dry carrier
+        Width,  ///< Envelope smoothing band in semitones
+        Count   ///< Number of parameters
+    };
+
+    /**
+     * @brief Constructs the talkbox and resolves its parameter handles.
+     * @param apvts Reference to the AudioProcessorValueTreeState.
+     */
+    explicit SidechainTalkbox(juce::AudioProcessorValueTreeState& apvts);
+
+    /**
+     * @brief Returns the knob specification for a given parameter.
+     * @param param Parameter ID.
+     */
+    static KnobParamSpecs getParamSpecs(ParamID param);
+
+    /**
+     * @brief Adds the mix and width parameters to the APVTS layout.
+     * @param layout The parameter layout to append to.
+     */
+    static void addParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout);
+
+    /**
+     * @brief Returns the latency the talkbox adds, in samples.
+     */
+    static constexpr int getLatencySamples() noexcept { return fftSize; }
+
+    /**
+     * @brief Sets the carrier channel count and clears the pipeline.
+     * @param numChannels Carrier channels, 1 or 2.
+     */
+    void prepare(int numChannels);
+
+    /**
+     * @brief Clears the pipeline, the output restarting from silence.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Reads the mix and width parameters. Audio thread, once per block.
+     */
+    void updateFromParameters() noexcept;
+
+    /**
+     * @brief Vocodes a segment of the carrier in place.
+     * @param carrier Buffer holding the carrier; its first channels, up to the prepared count, are processed.
+     * @param startSample First sample of the segment.
+     * @param numSamples Length of the segment.
+     * @param modulator Mono modulator samples of the same segment.
+     */
+    void process(juce::AudioBuffer<float>& carrier, int startSample, int numSamples, const float* modulator) noexcept;
+
+    /**
+     * @brief Returns true once the carrier has stayed silent for a whole frame, so the pipeline holds only silence.
+     */
+    bool isSilent() const noexcept;
+
+private:
+    using Frame = std::array<float, fftSize>;      ///< One frame of samples
+    using Spectrum = std::array<float, numBins>;   ///< One value per bin
+
+    static constexpr float minWidth = 1.0f;        ///< Narrowest smoothing band in semitones
+    static constexpr float maxWidth = 24.0f;       ///< Widest smoothing band in semitones
+    static constexpr float maxGain = 16.0f;        ///< Largest boost of a carrier bin, +24 dB
+    static constexpr float envelopeFloor = 1.0e-6f; ///< Keeps the carrier envelope from dividing by zero
+    static constexpr float silenceThreshold = 1.0e-5f; ///< Carrier level below which input counts as silent
+
+    /**
+     * @brief Analyses and resynthesizes the frame ending at the current position.
+     */
+    void processFrame() noexcept;
+
+    /**
+     * @brief Windows a frame in time order into fftData and transforms it.
+     * @param input Circular frame, oldest sample at position.
+     */
+    void forwardTransform(const Frame& input) noexcept;
+
+    /**
+     * @brief Smooths the magnitudes of the spectrum in fftData into an envelope.
+     * @param envelope Receives the envelope.
+     */
+    void computeEnvelope(Spectrum& envelope) noexcept;
+
+    /**
+     * @brief Recomputes the smoothing band of every bin for a width.
+     * @param widthSemitones Band width in semitones.
+     */
+    void updateBands(float widthSemitones) noexcept;
+
+    juce::dsp::FFT fft{ fftOrder };                 ///< Real FFT of one frame
+
+    Frame window{};                                 ///< Periodic Hann window, for analysis and synthesis
+    std::array<float, 2 * fftSize> fftData{};       ///< Transform workspace, interleaved complex bins
+    std::array<Frame, maxChannels> carrierInput{};  ///< Circular carrier history per channel
+    std::array<Frame, maxChannels> output{};        ///< Circular overlap-add accumulator per channel
+    Frame modulatorInput{};                         ///< Circular modulator history
+    Spectrum modulatorEnvelope{};                   ///< Modulator envelope of the current frame
+    Spectrum carrierEnvelope{};                     ///< Carrier envelope of the current frame
+    std::array<float, numBins + 1> prefixSums{};    ///< Running magnitude sums for the band averages
+
+    std::array<int, numBins> bandLow{};             ///< First bin of every bin's smoothing band
+    std::array<int, numBins> bandHigh{};            ///< Last bin of every bin's smoothing band
+    Spectrum bandScale{};                           ///< Reciprocal band length per bin
+
+    int numChannels = maxChannels;                  ///< Carrier channels processed
+    int position = 0;                               ///< Next write index of the circular buffers
+    int hopPosition = 0;                            ///< Samples since the last frame
+    int silentSamples = fftSize;                    ///< Consecutive carrier samples below the threshold
+
+    float mix = 1.0f;                               ///< Current mix, 0 dry to 1 vocoded
+    float width = 0.0f;                             ///< Width the bands were built for, 0 before the first update
+
+    std::atomic<float>* mixHandle = nullptr;        ///< Cached handle of the mix parameter
+    std::atomic<float>* widthHandle = nullptr;      ///< Cached handle of the width parameter
+
+    JUCE_DECLARE_NON_COPYABLE(SidechainTalkbox)
+};
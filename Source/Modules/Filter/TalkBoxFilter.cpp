@@ -3,24 +3,6 @@
 TalkboxFilter::TalkboxFilter() = default;
 constexpr float morphScale = 1.0f;
 
-const std::map<TalkboxFilter::Vowel, std::array<float, TalkboxFilter::numFormants>> TalkboxFilter::baseFormantMap =
-{
-    { Vowel::A, { 730.0f, 1090.0f, 2440.0f } },
-    { Vowel::E, { 530.0f, 1840.0f, 2480.0f } },
-    { Vowel::I, { 270.0f, 2290.0f, 3010.0f } },
-    { Vowel::O, { 570.0f,  840.0f, 2410.0f } },
-    { Vowel::U, { 300.0f,  870.0f, 2240.0f } }
-};
-
-const std::map<TalkboxFilter::Vowel, std::array<float, TalkboxFilter::numFormants>> TalkboxFilter::baseGainDbMap =
-{
-    { TalkboxFilter::Vowel::A, { -1.0f,  -5.0f,  -28.0f } },
-    { TalkboxFilter::Vowel::E, { -2.0f, -17.0f,  -24.0f } },
-    { TalkboxFilter::Vowel::I, { -4.0f, -24.0f,  -28.0f } },
-    { TalkboxFilter::Vowel::O, { -1.0f, -12.0f,  -22.0f } },
-    { TalkboxFilter::Vowel::U, { -5.0f, -15.0f,  -20.0f } }
-};
-
 namespace
 {
     const std::map<TalkboxFilter::Vowel, juce::String> vowelDisplayNames = {
@@ -33,6 +15,14 @@ namespace
 }
 
 TalkboxFilter::KnobParamSpecs TalkboxFilter::getKnobParamSpecs(ParamID id, int filterIndex)
+{
+    static const ParamSpecTable<KnobParamSpecs, ParamID, NUM_OF_FILTERS> table(
+        { ParamID::Morph, ParamID::Factor },
+        &makeKnobParamSpecs);
+    return table.get(id, filterIndex);
+}
+
+TalkboxFilter::KnobParamSpecs TalkboxFilter::makeKnobParamSpecs(ParamID id, int filterIndex)
 {
     const juce::String prefix = "FILTER" + juce::String(filterIndex + 1) + "_";
 
@@ -56,6 +46,14 @@ TalkboxFilter::KnobParamSpecs TalkboxFilter::getKnobParamSpecs(ParamID id, int f
 }
 
 TalkboxFilter::ComboBoxParamSpecs TalkboxFilter::getComboBoxParamSpecs(ParamID id, int filterIndex)
+{
+    static const ParamSpecTable<ComboBoxParamSpecs, ParamID, NUM_OF_FILTERS> table(
+        { ParamID::Vowel },
+        &makeComboBoxParamSpecs);
+    return table.get(id, filterIndex);
+}
+
+TalkboxFilter::ComboBoxParamSpecs TalkboxFilter::makeComboBoxParamSpecs(ParamID id, int filterIndex)
 {
     const juce::String prefix = "FILTER" + juce::String(filterIndex + 1) + "_";
 
@@ -81,53 +79,158 @@ void TalkboxFilter::prepare(const juce::dsp::ProcessSpec& spec)
 {
     sampleRate = spec.sampleRate;
 
-    for (auto& filterBand : filters)
-        for (auto& f : filterBand)
-            f.prepare(spec);
-
     isPrepared = true;
     updateFilters();
+
+    // Start on the prepared coefficients instead of ramping from the defaults
+    filters.coefficients = coefficientSlots[activeSlot.load(std::memory_order_acquire)];
+    filters.coefficientVersion = coefficientVersion.load(std::memory_order_acquire);
+    reset();
 }
 
 void TalkboxFilter::reset()
 {
-    for (auto& filterBand : filters)
-        for (auto& f : filterBand)
-            f.reset();
+    filters.state.fill({});
 }
 
 void TalkboxFilter::process(juce::dsp::AudioBlock<float>& block)
+{
+    processBank(block, filters);
+}
+
+void TalkboxFilter::prepareVoice(VoiceState& voice, const juce::dsp::ProcessSpec& spec)
+{
+    juce::ignoreUnused(spec);
+
+    voice.filters.coefficients = coefficientSlots[activeSlot.load(std::memory_order_acquire)];
+    voice.filters.coefficientVersion = coefficientVersion.load(std::memory_order_acquire);
+    resetVoice(voice);
+}
+
+void TalkboxFilter::resetVoice(VoiceState& voice)
+{
+    voice.filters.state.fill({});
+}
+
+void TalkboxFilter::process(juce::dsp::AudioBlock<float>& block, VoiceState& voice)
+{
+    // Follow the shared coefficients, only the filter history is per voice
+    processBank(block, voice.filters);
+}
+
+float TalkboxFilter::getStateMagnitude() const noexcept
+{
+    return getStateMagnitude(filters);
+}
+
+float TalkboxFilter::getStateMagnitude(const VoiceState& voice) noexcept
+{
+    return getStateMagnitude(voice.filters);
+}
+
+float TalkboxFilter::getStateMagnitude(const FilterBank& bank) noexcept
+{
+    float magnitude = 0.0f;
+    for (const auto& state : bank.state)
+    {
+        for (int l = 0; l < formantLanes; ++l)
+            magnitude = juce::jmax(magnitude, std::abs(state.z1[l]), std::abs(state.z2[l]));
+    }
+
+    return magnitude;
+}
+
+void TalkboxFilter::processBank(juce::dsp::AudioBlock<float>& block, FilterBank& bank)
 {
     if (!isPrepared)
         return;
 
-    const int numChannels = static_cast<int>(block.getNumChannels());
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), 2);
     const int numSamples = static_cast<int>(block.getNumSamples());
 
-    juce::AudioBuffer<float> tempBuffer(numChannels, numSamples);
-    tempBuffer.clear();
+    // Ramp from the coefficients this bank last used if a new set was published since
+    const auto& target = coefficientSlots[activeSlot.load(std::memory_order_acquire)];
+    const uint32_t version = coefficientVersion.load(std::memory_order_acquire);
+    const bool ramp = (bank.coefficientVersion != version);
+    const auto& from = ramp ? bank.coefficients : target;
 
-    for (int i = 0; i < numFormants; ++i)
+    for (int ch = 0; ch < numChannels; ++ch)
+        processPacked(block.getChannelPointer(ch), numSamples, bank.state[ch], from, target);
+
+    if (ramp)
     {
-        juce::AudioBuffer<float> formantBuffer(numChannels, numSamples);
+        bank.coefficients = target;
+        bank.coefficientVersion = version;
+    }
+}
 
-        for (int ch = 0; ch < numChannels; ++ch)
-            formantBuffer.copyFrom(ch, 0, block.getChannelPointer(ch), numSamples);
+void TalkboxFilter::processPacked(float* data, int numSamples, PackedState& state, const PackedCoefficients& from, const PackedCoefficients& to) noexcept
+{
+    alignas(16) Lanes b0, b2, a1, a2, gain;
+    alignas(16) Lanes db0, db2, da1, da2, dgain;
+    alignas(16) Lanes z1 = state.z1, z2 = state.z2;
 
-        juce::dsp::AudioBlock<float> formantBlock(formantBuffer);
+    // Linear steps so the last sample lands exactly on the target coefficients
+    const float step = (numSamples > 0) ? 1.0f / static_cast<float>(numSamples) : 0.0f;
+    for (int l = 0; l < formantLanes; ++l)
+    {
+        b0[l] = from.b0[l]; db0[l] = (to.b0[l] - from.b0[l]) * step;
+        b2[l] = from.b2[l]; db2[l] = (to.b2[l] - from.b2[l]) * step;
+        a1[l] = from.a1[l]; da1[l] = (to.a1[l] - from.a1[l]) * step;
+        a2[l] = from.a2[l]; da2[l] = (to.a2[l] - from.a2[l]) * step;
+        gain[l] = from.gain[l]; dgain[l] = (to.gain[l] - from.gain[l]) * step;
+    }
 
-        for (int ch = 0; ch < numChannels; ++ch)
-            filters[i][ch].process(juce::dsp::ProcessContextReplacing<float>(formantBlock.getSingleChannelBlock(ch)));
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const float x = data[n];
+        alignas(16) Lanes y;
 
-        for (int ch = 0; ch < numChannels; ++ch)
+        // Fixed lane count with no cross-lane dependency, so the compiler vectorizes this
+        for (int l = 0; l < formantLanes; ++l)
         {
-            const float compensatedGain = gains[i] * gainCompensation[i];
-            tempBuffer.addFrom(ch, 0, formantBuffer, ch, 0, numSamples, compensatedGain);
+            b0[l] += db0[l];
+            b2[l] += db2[l];
+            a1[l] += da1[l];
+            a2[l] += da2[l];
+            gain[l] += dgain[l];
+
+            const float out = b0[l] * x + z1[l];
+            z1[l] = z2[l] - a1[l] * out;
+            z2[l] = b2[l] * x - a2[l] * out;
+            y[l] = out * gain[l];
         }
+
+        float sum = 0.0f;
+        for (int l = 0; l < formantLanes; ++l)
+            sum += y[l];
+
+        data[n] = sum;
     }
 
-    for (int ch = 0; ch < numChannels; ++ch)
-        juce::FloatVectorOperations::copy(block.getChannelPointer(ch), tempBuffer.getReadPointer(ch), numSamples);
+    for (int l = 0; l < formantLanes; ++l)
+    {
+        juce::dsp::util::snapToZero(z1[l]);
+        juce::dsp::util::snapToZero(z2[l]);
+    }
+
+    state.z1 = z1;
+    state.z2 = z2;
+}
+
+void TalkboxFilter::makeBandPass(double sampleRate, float frequency, float q, PackedCoefficients& dest, int lane) noexcept
+{
+    // Same constant skirt band-pass as juce::dsp::IIR::Coefficients::makeBandPass
+    const double freq = juce::jlimit(1.0, sampleRate * 0.49, static_cast<double>(frequency));
+    const double n = 1.0 / std::tan(juce::MathConstants<double>::pi * freq / sampleRate);
+    const double nSquared = n * n;
+    const double invQ = 1.0 / juce::jmax(1.0e-3, static_cast<double>(q));
+    const double c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+    dest.b0[lane] = static_cast<float>(c1 * n * invQ);
+    dest.b2[lane] = static_cast<float>(-c1 * n * invQ);
+    dest.a1[lane] = static_cast<float>(c1 * 2.0 * (1.0 - nSquared));
+    dest.a2[lane] = static_cast<float>(c1 * (1.0 - invQ * n + nSquared));
 }
 
 std::array<TalkboxFilter::FormantBand, TalkboxFilter::numFormants> TalkboxFilter::getFormantBandsForGraph() const
@@ -144,25 +247,61 @@ std::array<TalkboxFilter::FormantBand, TalkboxFilter::numFormants> TalkboxFilter
     return bands;
 }
 
+std::array<TalkboxFilter::FormantBand, TalkboxFilter::numFormants> TalkboxFilter::computeFormantBands(Vowel vowel, float morph, float q)
+{
+    // Get base formants (ratios)
+    jassert(vowel != Vowel::Count);
+    const auto vowelIndex = static_cast<size_t>(vowel);
+    const auto& baseFormants = baseFormantTable[vowelIndex];
+    const auto& dbGains = baseGainDbTable[vowelIndex];
+
+    // Get morph center frequency using normalized morph
+    const float centerFreq = FormattingUtils::normalizedToValue(juce::jlimit(0.0f, 1.0f, morph), FormattingUtils::FormatType::VowelCenterFrequency, FormattingUtils::vowelMorphMinHz, FormattingUtils::vowelMorphMaxHz, 0);
+
+    std::array<FormantBand, numFormants> bands;
+    for (int i = 0; i < numFormants; ++i)
+    {
+        // Morph frequency = center * ratio of each formant to the vowel's middle formant
+        bands[i].frequency = centerFreq * baseFormants[i] / baseFormants[1];
+        bands[i].q = qFactorBase[i] * q;
+        bands[i].gain = std::pow(10.0f, dbGains[i] / 20.0f);
+    }
+
+    return bands;
+}
+
 void TalkboxFilter::setVowel(Vowel newVowel)
 {
     if (newVowel != currentVowel)
     {
         currentVowel = newVowel;
-        updateFilters();
+        coefficientsDirty = true;
     }
 }
 
 void TalkboxFilter::setQFactor(float q)
 {
-    qFactor = q;
-    updateFilters();
+    if (std::abs(q - qFactor) > parameterEpsilon)
+    {
+        qFactor = q;
+        coefficientsDirty = true;
+    }
 }
 
 void TalkboxFilter::setMorph(float morph)
 {
-    morphAmount = juce::jlimit(0.0f, 1.0f, morph);
-    updateFilters();
+    morph = juce::jlimit(0.0f, 1.0f, morph);
+    if (std::abs(morph - morphAmount) > parameterEpsilon)
+    {
+        morphAmount = morph;
+        coefficientsDirty = true;
+    }
+}
+
+void TalkboxFilter::updateFiltersIfNeeded()
+{
+    if (coefficientsDirty)
+        updateFilters();
 }
 
 TalkboxFilter::Vowel TalkboxFilter::getVowel() const
@@ -170,6 +309,16 @@ TalkboxFilter::Vowel TalkboxFilter::getVowel() const
     return currentVowel;
 }
 
+float TalkboxFilter::getMorph() const
+{
+    return morphAmount;
+}
+
+float TalkboxFilter::getQFactor() const
+{
+    return qFactor;
+}
+
 std::array<float, TalkboxFilter::numFormants> TalkboxFilter::getMorphedFrequencies() const
 {
     return morphedFormants;
@@ -180,34 +329,28 @@ void TalkboxFilter::updateFilters()
     if (!isPrepared)
         return;
 
-    // Get base formants (ratios)
-    const auto& baseFormants = baseFormantMap.at(currentVowel);
-    const auto& dbGains = baseGainDbMap.at(currentVowel);
-    for (int i = 0; i < numFormants; ++i)
-        gains[i] = std::pow(10.0f, dbGains[i] / 20.0f);
+    coefficientsDirty = false;
 
-    // Get morph center frequency using normalized morph
-    const float centerFreq = FormattingUtils::normalizedToValue(morphAmount, FormattingUtils::FormatType::VowelCenterFrequency, FormattingUtils::vowelMorphMinHz, FormattingUtils::vowelMorphMaxHz, 0);
+    const auto bands = computeFormantBands(currentVowel, morphAmount, qFactor);
+
+    // Write into the slot processing is not reading, then publish it
+    const int writeSlot = 1 - activeSlot.load(std::memory_order_relaxed);
+    auto& slot = coefficientSlots[writeSlot];
 
     for (int i = 0; i < numFormants; ++i)
     {
-        // Compute ratio of each formant to vowel's middle formant
-        const float ratio = baseFormants[i] / baseFormants[1];
-
-        // Morph frequency = center * ratio
-        const float morphedFreq = centerFreq * ratio;
-        const float scaledQ = qFactorBase[i] * qFactor;
-
-        auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, morphedFreq, scaledQ);
+        makeBandPass(sampleRate, bands[i].frequency, bands[i].q, slot, i);
 
-        for (int ch = 0; ch < 2; ++ch)
-            filters[i][ch].coefficients = coeffs;
-
-        morphedFormants[i] = morphedFreq;
+        morphedFormants[i] = bands[i].frequency;
+        gains[i] = bands[i].gain;
 
         // Update gain compensation
-        gainCompensation[i] = std::sqrt(scaledQ);
+        gainCompensation[i] = std::sqrt(bands[i].q);
+        slot.gain[i] = gains[i] * gainCompensation[i];
     }
+
+    activeSlot.store(writeSlot, std::memory_order_release);
+    coefficientVersion.fetch_add(1, std::memory_order_release);
 }
 
 
@@ -9,6 +9,7 @@
  *
  * The TalkboxFilter class processes audio using three parallel band-pass filters,
  * each corresponding to one of the formant frequencies of a selected vowel.
+ * The bands are packed into SIMD-friendly lanes and run in a single pass.
  * Morphing shifts all formant frequencies exponentially.
  */
 class TalkboxFilter
@@ -53,6 +54,61 @@ public:
         float gain;       ///< Gain applied to the formant
     };
 
+    static constexpr int formantLanes = (numFormants + 3) & ~3; ///< Formants padded to a multiple of four SIMD lanes
+
+    using Lanes = std::array<float, formantLanes>; ///< One value per formant lane
+
+    /**
+     * @struct PackedCoefficients
+     * @brief Band-pass coefficients and output gains of every formant, one lane each.
+     *
+     * Coefficients are normalized (a0 divided out), b1 is always zero for a band-pass
+     * and is not stored. Padding lanes are all zero and contribute nothing.
+     */
+    struct PackedCoefficients
+    {
+        alignas(16) Lanes b0{};   ///< Feed-forward coefficient 0
+        alignas(16) Lanes b2{};   ///< Feed-forward coefficient 2
+        alignas(16) Lanes a1{};   ///< Feedback coefficient 1
+        alignas(16) Lanes a2{};   ///< Feedback coefficient 2
+        alignas(16) Lanes gain{}; ///< Compensated output gain
+    };
+
+    /**
+     * @struct PackedState
+     * @brief Transposed direct form II history of every formant on one channel.
+     */
+    struct PackedState
+    {
+        alignas(16) Lanes z1{}; ///< First delay element
+        alignas(16) Lanes z2{}; ///< Second delay element
+    };
+
+    /**
+     * @struct FilterBank
+     * @brief Formant filter history per stereo channel.
+     *
+     * The bank remembers the coefficients it last ran with, so it can ramp
+     * towards newly published coefficients over its next block.
+     */
+    struct FilterBank
+    {
+        std::array<PackedState, 2> state{};   ///< History per channel
+        PackedCoefficients coefficients{};    ///< Coefficients reached at the end of the last block
+        uint32_t coefficientVersion = 0;      ///< Published version the coefficients belong to
+    };
+
+    /**
+     * @struct VoiceState
+     * @brief Filter state of a single voice in polyphonic mode.
+     *
+     * Voices share this talkbox's coefficients and only own their filter history.
+     */
+    struct VoiceState
+    {
+        FilterBank filters; ///< Per-voice band-pass filter state
+    };
+
     using KnobParamSpecs = ::KnobParamSpecs;          ///< Alias for knob specification
     using ComboBoxParamSpecs = ::ComboBoxParamSpecs;  ///< Alias for combo-box specification
 
@@ -94,6 +150,38 @@ public:
      */
     void process(juce::dsp::AudioBlock<float>& block);
 
+    /**
+     * @brief Prepares a voice's filter state with the current coefficients.
+     * @note The voice starts on the current coefficients without ramping.
+     * @param voice Voice state to prepare.
+     * @param spec DSP process specification.
+     */
+    void prepareVoice(VoiceState& voice, const juce::dsp::ProcessSpec& spec);
+
+    /**
+     * @brief Clears a voice's filter history.
+     * @param voice Voice state to reset.
+     */
+    void resetVoice(VoiceState& voice);
+
+    /**
+     * @brief Processes an audio block using a voice's own filter state.
+     * @param block Audio block to process.
+     * @param voice Voice state to use.
+     */
+    void process(juce::dsp::AudioBlock<float>& block, VoiceState& voice);
+
+    /**
+     * @brief Returns the largest magnitude the shared formant history holds.
+     */
+    float getStateMagnitude() const noexcept;
+
+    /**
+     * @brief Returns the largest magnitude a voice's formant history holds.
+     * @param voice Voice state to measure.
+     */
+    static float getStateMagnitude(const VoiceState& voice) noexcept;
+
     /**
      * @brief Returns current formant bands for graphing.
      * @return Array of FormantBand structs.
@@ -101,29 +189,55 @@ public:
     std::array<FormantBand, numFormants> getFormantBandsForGraph() const;
 
     /**
-     * @brief Sets the vowel preset.
+     * @brief Computes the formant bands for a set of talkbox settings without touching any filter state.
+     * @param vowel Vowel preset.
+     * @param morph Normalized morph in range [0.0, 1.0].
+     * @param q Q scaling factor.
+     * @return Array of FormantBand structs, with linear gains before Q compensation.
+     */
+    static std::array<FormantBand, numFormants> computeFormantBands(Vowel vowel, float morph, float q);
+
+    /**
+     * @brief Sets the vowel preset, marking the coefficients dirty if it changed.
      * @param newVowel Vowel enum to use.
      */
     void setVowel(Vowel newVowel);
 
     /**
-     * @brief Sets the Q factor for all formant filters.
+     * @brief Sets the Q factor for all formant filters, marking the coefficients dirty if it changed.
      * @param q Resonance value.
      */
     void setQFactor(float q);
 
     /**
-     * @brief Sets the morph amount for formant shifting.
+     * @brief Sets the morph amount for formant shifting, marking the coefficients dirty if it changed.
      * @param morph Normalized morph value in range [-1.0, 1.0].
      */
     void setMorph(float morph);
 
+    /**
+     * @brief Rebuilds the formant coefficients once if any setter changed them.
+     */
+    void updateFiltersIfNeeded();
+
     /**
      * @brief Gets the currently selected vowel preset.
      * @return Active Vowel enum.
      */
     Vowel getVowel() const;
 
+    /**
+     * @brief Returns the current morph amount.
+     * @return Normalized morph in range [0.0, 1.0].
+     */
+    float getMorph() const;
+
+    /**
+     * @brief Returns the current Q scaling factor.
+     * @return The Q factor.
+     */
+    float getQFactor() const;
+
     /**
      * @brief Gets current morphed formant frequencies.
      * @return Array of morphed frequencies in Hz.
@@ -131,6 +245,12 @@ public:
     std::array<float, numFormants> getMorphedFrequencies() const;
 
 private:
+    /** @brief Builds the spec that getKnobParamSpecs() caches. */
+    static KnobParamSpecs makeKnobParamSpecs(ParamID id, int filterIndex);
+
+    /** @brief Builds the spec that getComboBoxParamSpecs() caches. */
+    static ComboBoxParamSpecs makeComboBoxParamSpecs(ParamID id, int filterIndex);
+
     Vowel currentVowel = Vowel::A;            ///< Currently selected vowel preset.
     float qFactor = 5.0f;                     ///< Resonance factor (Q scaling multiplier).
     float morphAmount = 0.0f;                 ///< Morph amount for exponential shifting.
@@ -138,17 +258,75 @@ private:
     double sampleRate = 44100.0;              ///< Sample rate for filter processing.
     bool isPrepared = false;                  ///< Indicates if the filter has been prepared.
 
-    static const std::map<Vowel, std::array<float, numFormants>> baseFormantMap; ///< Map of base formant frequencies per vowel.
-    static const std::map<Vowel, std::array<float, numFormants>> baseGainDbMap;  ///< Map of formant gain values (dB) per vowel.
+    using VowelTable = std::array<std::array<float, numFormants>, static_cast<size_t>(Vowel::Count)>; ///< One row per vowel, in Vowel order
+
+    /** @brief Base formant frequencies per vowel, in Hz. */
+    static constexpr VowelTable baseFormantTable = { {
+        { 730.0f, 1090.0f, 2440.0f },   // A
+        { 530.0f, 1840.0f, 2480.0f },   // E
+        { 270.0f, 2290.0f, 3010.0f },   // I
+        { 570.0f,  840.0f, 2410.0f },   // O
+        { 300.0f,  870.0f, 2240.0f }    // U
+    } };
 
-    std::array<float, numFormants> qFactorBase = { 1.0f, 1.75f, 3.0f };            ///< Base Q ratios per formant (relative weighting).
+    /** @brief Formant gains per vowel, in dB. */
+    static constexpr VowelTable baseGainDbTable = { {
+        { -1.0f,  -5.0f, -28.0f },      // A
+        { -2.0f, -17.0f, -24.0f },      // E
+        { -4.0f, -24.0f, -28.0f },      // I
+        { -1.0f, -12.0f, -22.0f },      // O
+        { -5.0f, -15.0f, -20.0f }       // U
+    } };
+
+    static constexpr std::array<float, numFormants> qFactorBase = { 1.0f, 1.75f, 3.0f }; ///< Base Q ratios per formant (relative weighting).
     std::array<float, numFormants> gains{};                                        ///< Linear gain factors derived from dB mapping.
     std::array<float, numFormants> gainCompensation = { 1.0f, 1.0f, 1.0f };        ///< Gain compensation values per formant.
-    std::array<std::array<juce::dsp::IIR::Filter<float>, 2>, numFormants> filters; ///< Band-pass filters for each formant and stereo channel.
+    FilterBank filters;                                                            ///< Band-pass filter state for each formant and stereo channel.
+    std::array<PackedCoefficients, 2> coefficientSlots{};                          ///< Preallocated coefficient sets, one active and one being written
+    std::atomic<int> activeSlot{ 0 };                                              ///< Index of the slot processing reads from
+    std::atomic<uint32_t> coefficientVersion{ 0 };                                 ///< Incremented each time a new slot is published
     std::array<float, numFormants> morphedFormants{};                              ///< Morphed formant frequencies in Hz.
+    bool coefficientsDirty = false;                                                ///< True if the coefficients are stale
+    static constexpr float parameterEpsilon = 1.0e-5f;                             ///< Smallest morph/Q change that triggers a rebuild
 
     /**
-     * @brief Updates internal filter coefficients based on current parameters.
+     * @brief Computes coefficients into the inactive slot and publishes it.
      */
     void updateFilters();
+
+    /**
+     * @brief Computes RBJ band-pass coefficients into one lane without allocating.
+     * @param sampleRate Sample rate in Hz.
+     * @param frequency Center frequency in Hz.
+     * @param q Quality factor.
+     * @param dest Packed coefficients to write.
+     * @param lane Formant lane to write.
+     */
+    static void makeBandPass(double sampleRate, float frequency, float q, PackedCoefficients& dest, int lane) noexcept;
+
+    /**
+     * @brief Runs every formant over a channel in one pass and sums them in place.
+     *
+     * Coefficients and gains are interpolated across the block.
+     *
+     * @param data Samples to filter in place.
+     * @param numSamples Number of samples.
+     * @param state Filter history to use.
+     * @param from Coefficients at the start of the block.
+     * @param to Coefficients at the end of the block.
+     */
+    static void processPacked(float* data, int numSamples, PackedState& state, const PackedCoefficients& from, const PackedCoefficients& to) noexcept;
+
+    /**
+     * @brief Runs the formant bands of a filter bank over a block.
+     * @param block Audio block to process.
+     * @param bank Filter bank holding the state to use.
+     */
+    void processBank(juce::dsp::AudioBlock<float>& block, FilterBank& bank);
+
+    /**
+     * @brief Returns the largest magnitude in a filter bank's history, over every formant and channel.
+     * @param bank Filter bank to measure.
+     */
+    static float getStateMagnitude(const FilterBank& bank) noexcept;
 };
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "ZdfLadder.h"
+#include "../FastMath/FastMath.h"
+
+namespace
+{
+    constexpr float maxCutoffRatio = 0.48f; // Highest cutoff as a share of the rate, where the prewarp stays accurate
+
+    // Level compensation curve of the drive, the JUCE ladder's own, so presets keep their loudness
+    float getDriveGain(float drive) noexcept
+    {
+        return std::pow(drive, -2.642f) * 0.6103f + 0.3903f;
+    }
+}
+
+void ZdfLadder::prepare(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0.0);
+    sampleRate = newSampleRate;
+
+    minPitch = std::log2(FormattingUtils::freqMinHz);
+    maxPitch = std::log2(juce::jmin(FormattingUtils::freqMaxHz, maxCutoffRatio * static_cast<float>(sampleRate)));
+
+    cutoffPitch.reset(sampleRate, rampSeconds);
+    reset();
+}
+
+void ZdfLadder::reset() noexcept
+{
+    for (auto& stage : states)
+        stage.fill(0.0f);
+
+    cutoffPitch.setCurrentAndTargetValue(cutoffPitch.getTargetValue());
+    coefficients = makeCoefficients(cutoffPitch.getTargetValue());
+}
+
+void ZdfLadder::setMode(Mode newMode) noexcept
+{
+    // Weights of the stage input and the stage outputs, binomial for the high-passes
+    switch (newMode)
+    {
+    case Mode::LPF12: mix = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f }; break;
+    case Mode::LPF24: mix = { 0.0f, 0.0f, 0.0f, 0.0f, 1.0f }; break;
+    case Mode::HPF12: mix = { 1.0f, -2.0f, 1.0f, 0.0f, 0.0f }; break;
+    case Mode::HPF24: mix = { 1.0f, -4.0f, 6.0f, -4.0f, 1.0f }; break;
+    case Mode::BPF12: mix = { 0.0f, 2.0f, -2.0f, 0.0f, 0.0f }; break;
+    case Mode::BPF24: mix = { 0.0f, 0.0f, 4.0f, -8.0f, 4.0f }; break;
+    }
+}
+
+void ZdfLadder::setCutoffFrequencyHz(float frequencyHz) noexcept
+{
+    jassert(frequencyHz > 0.0f);
+    cutoffPitch.setTargetValue(juce::jlimit(minPitch, maxPitch, std::log2(frequencyHz)));
+}
+
+void ZdfLadder::setResonance(float resonance) noexcept
+{
+    // Same 0.1 floor as the JUCE ladder, so resonance 0 keeps a trace of the loop
+    feedback = 4.0f * juce::jmap(juce::jlimit(0.0f, 1.0f, resonance), 0.1f, 1.0f);
+}
+
+void ZdfLadder::setDrive(float newDrive) noexcept
+{
+    jassert(newDrive >= 1.0f);
+    drive = juce::jmax(1.0f, newDrive);
+    driveGain = getDriveGain(drive);
+}
+
+void ZdfLadder::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), numLanes);
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    jassert(static_cast<int>(block.getNumChannels()) <= numLanes);
+
+    float* channels[numLanes] = {};
+    for (int ch = 0; ch < numChannels; ++ch)
+        channels[ch] = block.getChannelPointer(static_cast<size_t>(ch));
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Coefficients only follow the ramp while it moves
+        if (cutoffPitch.isSmoothing())
+            coefficients = makeCoefficients(cutoffPitch.getNextValue());
+
+        Lanes lanes{};
+        for (int ch = 0; ch < numChannels; ++ch)
+            lanes[ch] = channels[ch][i];
+
+        processSample(lanes, coefficients);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels[ch][i] = lanes[ch];
+    }
+}
+
+void ZdfLadder::process(juce::dsp::AudioBlock<float>& block, const float* cutoffPitches,
+    int samplesPerPitch, float pitchOffset) noexcept
+{
+    jassert(cutoffPitches != nullptr && samplesPerPitch > 0);
+
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), numLanes);
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    jassert(static_cast<int>(block.getNumChannels()) <= numLanes);
+
+    float* channels[numLanes] = {};
+    for (int ch = 0; ch < numChannels; ++ch)
+        channels[ch] = block.getChannelPointer(static_cast<size_t>(ch));
+
+    float pitch = std::numeric_limits<float>::quiet_NaN();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Held pitches of an oversampled block reuse their coefficients
+        const float samplePitch = cutoffPitches[i / samplesPerPitch] + pitchOffset;
+        if (samplePitch != pitch)
+        {
+            pitch = samplePitch;
+            coefficients = makeCoefficients(pitch);
+        }
+
+        Lanes lanes{};
+        for (int ch = 0; ch < numChannels; ++ch)
+            lanes[ch] = channels[ch][i];
+
+        processSample(lanes, coefficients);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels[ch][i] = lanes[ch];
+    }
+
+    if (numSamples > 0)
+        cutoffPitch.setCurrentAndTargetValue(juce::jlimit(minPitch, maxPitch, pitch));
+}
+
+float ZdfLadder::getStateMagnitude() const noexcept
+{
+    float magnitude = 0.0f;
+    for (const auto& stage : states)
+        for (const float state : stage)
+            magnitude = juce::jmax(magnitude, std::abs(state));
+
+    return magnitude;
+}
+
+ZdfLadder::Coefficients ZdfLadder::makeCoefficients(float pitch) const noexcept
+{
+    const float frequency = FastMath::exp2(juce::jlimit(minPitch, maxPitch, pitch));
+
+    // Bilinear prewarp, so the analog cutoff lands exactly on the digital one
+    const float g = FastMath::tan(juce::MathConstants<float>::pi * frequency / static_cast<float>(sampleRate));
+
+    Coefficients c;
+    c.stateGain = 1.0f / (1.0f + g);
+    c.stageGain = g * c.stateGain;
+    const float squared = c.stageGain * c.stageGain;
+    c.loopGain = squared * squared;
+    return c;
+}
+
+void ZdfLadder::processSample(Lanes& input, const Coefficients& c) noexcept
+{
+    const float gain = c.stageGain;
+    const float inputGain = 1.0f + feedback * feedbackCompensation;
+    const float solveGain = 1.0f / (1.0f + feedback * c.loopGain);
+
+    auto& s1 = states[0];
+    auto& s2 = states[1];
+    auto& s3 = states[2];
+    auto& s4 = states[3];
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        // The fourth stage's output is gain^4 times the ladder input plus what the states contribute,
+        // so the loop is solved for this sample's ladder input instead of the previous sample's output
+        const float stateSum = c.stateGain * (gain * (gain * (gain * s1[lane] + s2[lane]) + s3[lane]) + s4[lane]);
+        const float solved = (input[lane] * inputGain - feedback * stateSum) * solveGain;
+        const float u = FastMath::tanh(solved * drive) * driveGain;
+
+        // Trapezoidal one-poles: v = (x - s) * g / (1 + g), y = v + s, s = y + v
+        const float v1 = (u - s1[lane]) * gain;
+        const float y1 = v1 + s1[lane];
+        s1[lane] = y1 + v1;
+
+        const float v2 = (y1 - s2[lane]) * gain;
+        const float y2 = v2 + s2[lane];
+        s2[lane] = y2 + v2;
+
+        const float v3 = (y2 - s3[lane]) * gain;
+        const float y3 = v3 + s3[lane];
+        s3[lane] = y3 + v3;
+
+        const float v4 = (y3 - s4[lane]) * gain;
+        const float y4 = v4 + s4[lane];
+        s4[lane] = y4 + v4;
+
+        input[lane] = mix[0] * u + mix[1] * y1 + mix[2] * y2 + mix[3] * y3 + mix[4] * y4;
+    }
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "../../Common.h"
+#include <JuceHeader.h>
+
+/**
+ * @class ZdfLadder
+ * @brief Zero-delay-feedback four-pole ladder with the channels packed into SIMD lanes.
+ *
+ * Four topology-preserving (TPT) one-pole stages in a resonant loop, solved
+ * for the current sample instead of a sample late, so the cutoff stays exact
+ * up to the top of the band and may change on every sample. The solved stage
+ * input is saturated with tanh(), which keeps self-oscillation bounded.
+ *
+ * Left and right are lanes of one state: every step of a sample runs for all
+ * lanes at once, in loops of constant length the compiler vectorizes. The
+ * cutoff comes either from setCutoffFrequencyHz(), ramped in pitch over a
+ * short time, or from a buffer of per-sample pitches handed to process()
+ * straight from the modulation spans; coefficients are only recomputed on
+ * samples where the cutoff moves. Nothing allocates.
+ */
+class ZdfLadder
+{
+public:
+    static constexpr int numLanes = 2; ///< Channels processed side by side
+
+    /**
+     * @enum Mode
+     * @brief Responses mixed from the stage outputs.
+     */
+    enum class Mode
+    {
+        LPF12,  ///< 12 dB/oct low-pass, second stage
+        LPF24,  ///< 24 dB/oct low-pass, fourth stage
+        HPF12,  ///< 12 dB/oct high-pass
+        HPF24,  ///< 24 dB/oct high-pass
+        BPF12,  ///< 12 dB/oct band-pass, unity peak
+        BPF24   ///< 24 dB/oct band-pass, unity peak
+    };
+
+    /**
+     * @brief Sets the rate the ladder runs at and clears its state.
+     * @param sampleRate Processing rate in Hz, the oversampled rate when oversampling.
+     */
+    void prepare(double sampleRate) noexcept;
+
+    /**
+     * @brief Clears the stage states and lands the cutoff on its target.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Selects the response.
+     */
+    void setMode(Mode newMode) noexcept;
+
+    /**
+     * @brief Sets the cutoff the ladder ramps to.
+     * @param frequencyHz Cutoff in Hz, limited to the audible band and below Nyquist.
+     */
+    void setCutoffFrequencyHz(float frequencyHz) noexcept;
+
+    /**
+     * @brief Sets the resonance.
+     * @param resonance Amount in range [0.0, 1.0], self-oscillating at 1.
+     */
+    void setResonance(float resonance) noexcept;
+
+    /**
+     * @brief Sets the gain into the stage saturation.
+     * @param drive Drive of at least 1, where the ladder is clean at moderate levels.
+     */
+    void setDrive(float drive) noexcept;
+
+    /**
+     * @brief Filters a block in place with the ramped cutoff.
+     * @param block Up to numLanes channels.
+     */
+    void process(juce::dsp::AudioBlock<float>& block) noexcept;
+
+    /**
+     * @brief Filters a block in place with a cutoff for every sample.
+     *
+     * The ramped cutoff lands on the last sample's cutoff, so a following
+     * process() without pitches carries on from there.
+     *
+     * @param block Up to numLanes channels.
+     * @param cutoffPitches Cutoff of each base-rate sample, as log2 of Hz.
+     * @param samplesPerPitch Processed samples each pitch holds for, the oversampling ratio.
+     * @param pitchOffset Octaves added to every pitch, the note's expression offset.
+     */
+    void process(juce::dsp::AudioBlock<float>& block, const float* cutoffPitches,
+        int samplesPerPitch, float pitchOffset) noexcept;
+
+    /**
+     * @brief Returns the largest magnitude any stage state holds, how far the ladder still rings.
+     */
+    float getStateMagnitude() const noexcept;
+
+private:
+    using Lanes = std::array<float, numLanes>; ///< One value per channel lane
+
+    /**
+     * @struct Coefficients
+     * @brief Stage coefficients of one cutoff.
+     */
+    struct Coefficients
+    {
+        float stageGain = 0.0f;     ///< g / (1 + g), the instantaneous gain of one stage
+        float stateGain = 1.0f;     ///< 1 / (1 + g), how much of its state a stage passes on
+        float loopGain = 0.0f;      ///< stageGain^4, instantaneous gain of the whole ladder
+    };
+
+    /**
+     * @brief Returns the coefficients of a cutoff pitch, limited to the valid range.
+     * @param pitch Cutoff as log2 of Hz.
+     */
+    Coefficients makeCoefficients(float pitch) const noexcept;
+
+    /**
+     * @brief Runs one sample of every lane through the ladder.
+     * @param input Input of each lane, replaced by the output.
+     * @param c Coefficients of the sample.
+     */
+    void processSample(Lanes& input, const Coefficients& c) noexcept;
+
+    static constexpr double rampSeconds = 0.05;        ///< Time a cutoff change ramps over
+    static constexpr float feedbackCompensation = 0.5f; ///< Share of the input fed back with the output, offsets the passband loss of resonance
+
+    double sampleRate = 44100.0;                       ///< Processing rate in Hz
+    float minPitch = 0.0f;                             ///< Lowest cutoff pitch
+    float maxPitch = 0.0f;                             ///< Highest cutoff pitch, below Nyquist
+    juce::SmoothedValue<float> cutoffPitch;            ///< Ramped cutoff as log2 of Hz
+    Coefficients coefficients;                         ///< Coefficients of the current cutoff
+    float feedback = 0.0f;                             ///< Resonance loop gain, 4 at self-oscillation
+    float drive = 1.0f;                                ///< Gain into the saturation
+    float driveGain = 1.0f;                            ///< Gain after the saturation, compensates the drive's level
+    std::array<float, 5> mix{ 0.0f, 0.0f, 1.0f, 0.0f, 0.0f }; ///< Weights of the stage input and the four stage outputs
+
+    alignas(16) std::array<Lanes, 4> states{};         ///< Integrator state of every stage and lane
+};
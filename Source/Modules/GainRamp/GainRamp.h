@@ -0,0 +1,76 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @namespace GainRamp
+ * @brief Block-wise rendering of smoothed gains.
+ *
+ * A SmoothedValue is advanced once per block into a buffer, so every channel
+ * reads the same ramp, and a value that is not smoothing costs a single
+ * constant multiply instead of a per-sample loop.
+ */
+namespace GainRamp
+{
+    /**
+     * @struct Ramp
+     * @brief One block of a smoothed gain: either a rendered ramp or a constant.
+     */
+    struct Ramp
+    {
+        const float* values = nullptr; ///< Rendered per-sample gains, nullptr while the gain is constant
+        float constant = 1.0f;         ///< Gain for the whole block when values is nullptr
+
+        /**
+         * @brief Returns true if the gain does not change over the block.
+         */
+        bool isConstant() const noexcept { return values == nullptr; }
+
+        /**
+         * @brief Multiplies a buffer by the ramp and an additional fixed scale.
+         * @param data Samples to scale in place.
+         * @param numSamples Number of samples, at most the rendered length.
+         * @param scale Fixed gain applied on top of the ramp.
+         */
+        void applyTo(float* data, int numSamples, float scale = 1.0f) const noexcept
+        {
+            if (isConstant())
+            {
+                juce::FloatVectorOperations::multiply(data, constant * scale, numSamples);
+                return;
+            }
+
+            juce::FloatVectorOperations::multiply(data, values, numSamples);
+            if (scale != 1.0f)
+                juce::FloatVectorOperations::multiply(data, scale, numSamples);
+        }
+    };
+
+    /**
+     * @brief Advances a smoothed value by one block.
+     *
+     * Writes into storage only while the value is smoothing. Otherwise the ramp is
+     * returned as a constant and storage is left untouched.
+     *
+     * @param value Smoothed value to advance.
+     * @param storage Buffer of at least numSamples floats for the rendered ramp.
+     * @param numSamples Number of samples in the block.
+     * @return The block's ramp.
+     */
+    inline Ramp render(juce::SmoothedValue<float>& value, float* storage, int numSamples) noexcept
+    {
+        Ramp ramp;
+
+        if (!value.isSmoothing())
+        {
+            ramp.constant = value.getCurrentValue();
+            return ramp;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            storage[i] = value.getNextValue();
+
+        ramp.values = storage;
+        return ramp;
+    }
+}
@@ -0,0 +1,94 @@
+#include "GpuRenderer.h"
+
+bool GpuRenderer::isSupported() noexcept
+{
+    return GPU_RENDERING_AVAILABLE;
+}
+
+GpuRenderer::GpuRenderer(juce::Component& targetRef)
+    : target(targetRef)
+{
+#if GPU_RENDERING_AVAILABLE
+    context.setRenderer(this);
+    context.setComponentPaintingEnabled(true);
+    context.setContinuousRepainting(false);
+#endif
+}
+
+GpuRenderer::~GpuRenderer()
+{
+    setEnabled(false);
+}
+
+void GpuRenderer::setEnabled(bool shouldEnable)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    shouldEnable = shouldEnable && isSupported();
+    if (shouldEnable == enabled)
+        return;
+
+    enabled = shouldEnable;
+
+#if GPU_RENDERING_AVAILABLE
+    if (enabled)
+    {
+        contextCreated = false;
+        context.attachTo(target);
+        startTimer(fallbackTimeoutMs);
+    }
+    else
+    {
+        stopTimer();
+        context.detach();
+        contextCreated = false;
+    }
+#endif
+}
+
+bool GpuRenderer::isEnabled() const noexcept
+{
+    return enabled;
+}
+
+bool GpuRenderer::isActive() const noexcept
+{
+#if GPU_RENDERING_AVAILABLE
+    return enabled && contextCreated;
+#else
+    return false;
+#endif
+}
+
+#if GPU_RENDERING_AVAILABLE
+void GpuRenderer::newOpenGLContextCreated()
+{
+    contextCreated = true;
+}
+
+void GpuRenderer::renderOpenGL()
+{
+}
+
+void GpuRenderer::openGLContextClosing()
+{
+    contextCreated = false;
+}
+
+void GpuRenderer::timerCallback()
+{
+    // A hidden editor creates no context yet, so the wait starts over until it shows
+    if (contextCreated || !target.isShowing())
+    {
+        if (contextCreated)
+            stopTimer();
+        return;
+    }
+
+    stopTimer();
+    setEnabled(false);
+
+    if (onFallback)
+        onFallback();
+}
+#endif
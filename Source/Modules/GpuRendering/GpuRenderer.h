@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../../Common.h"
+#include <JuceHeader.h>
+
+#define GPU_RENDERING_AVAILABLE (OPENGL_RENDERING && JUCE_MODULE_AVAILABLE_juce_opengl) ///< 1 if GpuRenderer can attach a context
+
+/**
+ * @class GpuRenderer
+ * @brief Opt-in OpenGL rendering of an editor, with the software renderer as fallback.
+ *
+ * While enabled, an OpenGL context is attached to the editor and paints its
+ * components: fills, gradients and cached images are drawn as GPU quads and
+ * textures, so compositing a large window no longer costs the message thread
+ * per pixel. The context renders only when a component repaints, never
+ * continuously.
+ *
+ * A context that has not come up within fallbackTimeoutMs of the editor
+ * showing, on systems without a usable driver, is detached again and the
+ * editor keeps painting in software; onFallback reports it. Builds without
+ * the juce_opengl module or with OPENGL_RENDERING off only render in software.
+ */
+class GpuRenderer
+#if GPU_RENDERING_AVAILABLE
+    : private juce::OpenGLRenderer, private juce::Timer
+#endif
+{
+public:
+    static constexpr int fallbackTimeoutMs = 2000; ///< Time a showing editor waits for its context before falling back
+
+    /**
+     * @brief Returns true if this build can render through OpenGL.
+     */
+    static bool isSupported() noexcept;
+
+    /**
+     * @brief Constructs a disabled renderer for a component.
+     * @param target The editor to attach to; must outlive the renderer.
+     */
+    explicit GpuRenderer(juce::Component& target);
+
+    /**
+     * @brief Detaches the context.
+     */
+    ~GpuRenderer();
+
+    /**
+     * @brief Attaches or detaches the OpenGL context. Message thread only.
+     * @param shouldEnable True to render through OpenGL; ignored if the build does not support it.
+     */
+    void setEnabled(bool shouldEnable);
+
+    /**
+     * @brief Returns true while OpenGL rendering is requested and has not fallen back.
+     */
+    bool isEnabled() const noexcept;
+
+    /**
+     * @brief Returns true once the context is up and painting.
+     */
+    bool isActive() const noexcept;
+
+    std::function<void()> onFallback; ///< Called on the message thread after a context failed to come up
+
+private:
+#if GPU_RENDERING_AVAILABLE
+    /** @brief Marks the context as up, on the OpenGL thread. */
+    void newOpenGLContextCreated() override;
+
+    /** @brief Components paint the whole frame, so nothing is drawn before them. */
+    void renderOpenGL() override;
+
+    /** @brief Marks the context as gone, on the OpenGL thread. */
+    void openGLContextClosing() override;
+
+    /** @brief Falls back to software if the context did not come up in time. */
+    void timerCallback() override;
+
+    juce::OpenGLContext context;                 ///< Context attached while enabled
+    std::atomic<bool> contextCreated{ false };   ///< Set by the OpenGL thread once the context is up
+#endif
+
+    juce::Component& target;                     ///< Editor the context attaches to
+    bool enabled = false;                        ///< True while OpenGL rendering is requested
+
+    JUCE_DECLARE_NON_COPYABLE(GpuRenderer)
+};
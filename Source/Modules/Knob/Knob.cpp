@@ -16,7 +16,8 @@ Knob::~Knob()
 
 void Knob::cleanup()
 {
-    stopTimer();
+    refreshScheduler->remove(this);
+    processor.getMidiCCMap().cancelLearn(apvts.getParameter(paramID));
     attachment.reset();
     processor.getModulationRouter().unregisterTarget(this);
 }
@@ -86,18 +87,11 @@ void Knob::initialize(juce::AudioProcessorValueTreeState& apvts, DigitalSynthesi
     slider.updateText();
     slider.repaint();
 
-    // Restore modulation state from APVTS
-    const auto ids = KnobModulationEngine::getParameterIDsFor(paramID);
-
-    if (auto* modeParam = apvts.getRawParameterValue(ids[0]))
-        modEngine.setMode(static_cast<ModulationMode>(static_cast<int>(modeParam->load())));
-
-    if (auto* indexParam = apvts.getRawParameterValue(ids[1]))
-        modEngine.setSourceIndex(static_cast<int>(indexParam->load()));
-
-    if (auto* minParam = apvts.getRawParameterValue(ids[2]))
-        if (auto* maxParam = apvts.getRawParameterValue(ids[3]))
-            modEngine.setRange(minParam->load(), maxParam->load());
+    // Restore modulation state from the stored routing
+    const auto route = processor.getModulationMatrix().getMainRoute(paramID);
+    modEngine.setMode(route.mode);
+    modEngine.setSourceIndex(route.index);
+    modEngine.setRange(route.min, route.max);
 
     if (modEngine.getMode() == ModulationMode::Envelope)
     {
@@ -125,6 +119,10 @@ void Knob::bindToParameter()
     {
         attachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, paramID, slider);
     }
+
+    // CC bindings outlive the editor, show the one this parameter already has
+    midiCC = processor.getMidiCCMap().getControllerFor(apvts.getParameter(paramID));
+    isMidiAssigned = (midiCC >= 0);
 }
 
 bool Knob::isLearning() const
@@ -165,25 +163,21 @@ void Knob::assignMidiCC(int cc)
     midiCC = cc;
     isMidiLearnActive = false;
     isMidiAssigned = true;
-    stopTimer();
+    updateRefreshState();
     repaint();
 }
 
-void Knob::handleMidiCC(int ccNumber, float ccValue)
-{
-    if (midiCC == ccNumber)
-    {
-        setSliderValue(ccValue);
-    }
-}
-
 void Knob::forgetMidiCC()
 {
+    auto* parameter = apvts.getParameter(paramID);
+    processor.getMidiCCMap().cancelLearn(parameter);
+    processor.getMidiCCMap().unbind(parameter);
+
     midiCC = -1;
     isMidiAssigned = false;
     isMidiLearnActive = false;
     glowAlpha = 0.4f;
-    stopTimer();
+    updateRefreshState();
     repaint();
 }
 
@@ -368,6 +362,9 @@ void Knob::mouseDown(const juce::MouseEvent& event)
     }
     menu.addSubMenu("LFO", lfoMenu);
 
+    // --- Extra sources, summed on top of the main one ---
+    addModulationSlotMenu(menu);
+
     // --- Clean option ---
     menu.addItem(ModMenuID::Clean, "Clean");
 
@@ -377,32 +374,36 @@ void Knob::mouseDown(const juce::MouseEvent& event)
             if (result == 0)
                 return; // Menu dismissed
 
+            // Extra sources leave the main source and MIDI mapping alone
+            if (result >= ModMenuID::SlotEnvelopeBase)
+            {
+                handleModulationSlotMenu(result);
+                return;
+            }
+
             // 1) Disconnect any live modulation and clear MIDI CC
             processor.getModulationRouter().disconnect(this);
             forgetMidiCC();
 
-            // 2) Reset all APVTS parameters (main + sub-parameters) to their defaults
-            const auto subIDs = KnobModulationEngine::getParameterIDsFor(paramID);
+            auto& matrix = processor.getModulationMatrix();
+            auto route = matrix.getMainRoute(paramID);
 
             switch (result)
             {
             case ModMenuID::MidiLearn:
                 isMidiLearnActive = true;
                 glowAlpha = 0.4f;
-                startTimerHz(midiLearnBlinkRateHz);
+                processor.getMidiCCMap().beginLearn(apvts.getParameter(paramID));
+                refreshScheduler->add(this);
                 break;
 
             case ModMenuID::Clean:
             {
-                // Gather the main parameter ID plus the four _MOD_* children
-                juce::StringArray allParamIDs;
-                allParamIDs.add(paramID);
-                allParamIDs.addArray(subIDs);
+                // 2) Reset the parameter and drop its whole routing
+                if (auto* p = apvts.getParameter(paramID))
+                    p->setValueNotifyingHost(p->getDefaultValue());
 
-                // Loop and reset each parameter in the APVTS
-                for (const auto& idToClear : allParamIDs)
-                    if (auto* p = apvts.getParameter(idToClear))
-                        p->setValueNotifyingHost(p->getDefaultValue());
+                matrix.clear(paramID);
 
                 break;
             }
@@ -414,10 +415,9 @@ void Knob::mouseDown(const juce::MouseEvent& event)
                     int index = result - ModMenuID::EnvelopeBase;
                     processor.getModulationRouter().connect({ ModulationSourceType::Envelope, index }, this);
 
-                    if (auto* modeParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(subIDs[0])))
-                        modeParam->setValueNotifyingHost(modeParam->convertTo0to1(static_cast<int>(ModulationMode::Envelope)));
-                    if (auto* indexParam = dynamic_cast<juce::AudioParameterInt*>(apvts.getParameter(subIDs[1])))
-                        indexParam->setValueNotifyingHost(indexParam->convertTo0to1(static_cast<float>(index)));
+                    route.mode = ModulationMode::Envelope;
+                    route.index = index;
+                    matrix.setMainRoute(paramID, route);
                 }
                 // --- LFO selection ---
                 else if (result >= ModMenuID::LfoBase && result < ModMenuID::LfoBase + NUM_OF_LFOS)
@@ -425,16 +425,126 @@ void Knob::mouseDown(const juce::MouseEvent& event)
                     int index = result - ModMenuID::LfoBase;
                     processor.getModulationRouter().connect({ ModulationSourceType::LFO, index }, this);
 
-                    if (auto* modeParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(subIDs[0])))
-                        modeParam->setValueNotifyingHost(modeParam->convertTo0to1(static_cast<int>(ModulationMode::LFO)));
-                    if (auto* indexParam = dynamic_cast<juce::AudioParameterInt*>(apvts.getParameter(subIDs[1])))
-                        indexParam->setValueNotifyingHost(indexParam->convertTo0to1(static_cast<float>(index)));
+                    route.mode = ModulationMode::LFO;
+                    route.index = index;
+                    matrix.setMainRoute(paramID, route);
                 }
                 break;
             }
         });
 }
 
+void Knob::addModulationSlotMenu(juce::PopupMenu& menu)
+{
+    const auto slots = processor.getModulationMatrix().getSlots(paramID);
+    const auto hasSlot = [&slots](const ModulationSourceID& id)
+        {
+            return std::any_of(slots.begin(), slots.end(), [&id](const ModulationSlot& slot) { return slot.source == id; });
+        };
+
+    const auto envelopeSources = processor.getAvailableModulationSources(ModulationSourceType::Envelope);
+    const auto lfoSources = processor.getAvailableModulationSources(ModulationSourceType::LFO);
+    const bool isFull = static_cast<int>(slots.size()) >= ModulationMatrix::maxSlotsPerParameter;
+
+    juce::PopupMenu slotMenu;
+
+    for (const auto& [id, label] : envelopeSources)
+    {
+        const bool isChecked = hasSlot(id);
+        const bool isEnabled = isChecked || (!isFull && processor.isEnvelopeLinkedToOscillator(id.index));
+        slotMenu.addItem(ModMenuID::SlotEnvelopeBase + id.index, label, isEnabled, isChecked);
+    }
+
+    for (const auto& [id, label] : lfoSources)
+    {
+        const bool isChecked = hasSlot(id);
+        auto* lfo = processor.getLFO(id.index);
+        const bool isEnabled = isChecked || (!isFull && lfo && !lfo->isBypassed());
+        slotMenu.addItem(ModMenuID::SlotLfoBase + id.index, label, isEnabled, isChecked);
+    }
+
+    // --- Depth and polarity of each slot ---
+    if (!slots.empty())
+        slotMenu.addSeparator();
+
+    for (int i = 0; i < static_cast<int>(slots.size()); ++i)
+    {
+        const auto& slot = slots[i];
+        const auto& sources = slot.source.type == ModulationSourceType::Envelope ? envelopeSources : lfoSources;
+
+        juce::String label;
+        for (const auto& [id, sourceLabel] : sources)
+            if (id == slot.source)
+                label = sourceLabel;
+
+        const int base = ModMenuID::SlotEditBase + i * slotActionCount;
+        const float amount = std::abs(slot.depth);
+
+        juce::PopupMenu editMenu;
+        editMenu.addItem(base + SlotDepthQuarter, "Depth 25%", true, amount == 0.25f);
+        editMenu.addItem(base + SlotDepthHalf, "Depth 50%", true, amount == 0.5f);
+        editMenu.addItem(base + SlotDepthFull, "Depth 100%", true, amount == 1.0f);
+        editMenu.addSeparator();
+        editMenu.addItem(base + SlotInvert, "Invert", true, slot.depth < 0.0f);
+        editMenu.addItem(base + SlotBipolar, "Bipolar", true, slot.bipolar);
+        editMenu.addSeparator();
+        editMenu.addItem(base + SlotRemove, "Remove");
+
+        slotMenu.addSubMenu(label, editMenu);
+    }
+
+    menu.addSubMenu("Add Source", slotMenu);
+}
+
+void Knob::handleModulationSlotMenu(int result)
+{
+    auto& matrix = processor.getModulationMatrix();
+    const auto slots = matrix.getSlots(paramID);
+
+    // --- Toggle a source ---
+    if (result < ModMenuID::SlotEditBase)
+    {
+        const bool isEnvelope = result < ModMenuID::SlotLfoBase;
+        const ModulationSourceID source{
+            isEnvelope ? ModulationSourceType::Envelope : ModulationSourceType::LFO,
+            result - (isEnvelope ? ModMenuID::SlotEnvelopeBase : ModMenuID::SlotLfoBase) };
+
+        const bool exists = std::any_of(slots.begin(), slots.end(),
+            [&source](const ModulationSlot& slot) { return slot.source == source; });
+
+        if (exists)
+            matrix.removeSlot(paramID, source);
+        else
+            matrix.setSlot(paramID, { source, 0.5f, !isEnvelope }); // LFOs swing around the knob by default
+
+        return;
+    }
+
+    // --- Edit a slot ---
+    const int slotIndex = (result - ModMenuID::SlotEditBase) / slotActionCount;
+    if (slotIndex >= static_cast<int>(slots.size()))
+        return;
+
+    auto slot = slots[slotIndex];
+    const float sign = slot.depth < 0.0f ? -1.0f : 1.0f;
+
+    switch ((result - ModMenuID::SlotEditBase) % slotActionCount)
+    {
+    case SlotDepthQuarter: slot.depth = 0.25f * sign; break;
+    case SlotDepthHalf:    slot.depth = 0.5f * sign;  break;
+    case SlotDepthFull:    slot.depth = 1.0f * sign;  break;
+    case SlotInvert:       slot.depth = -slot.depth;  break;
+    case SlotBipolar:      slot.bipolar = !slot.bipolar; break;
+    case SlotRemove:
+        matrix.removeSlot(paramID, slot.source);
+        return;
+    default:
+        return;
+    }
+
+    matrix.setSlot(paramID, slot);
+}
+
 void Knob::mouseDrag(const juce::MouseEvent& event)
 {
     if (modEngine.isEditing())
@@ -453,11 +563,7 @@ void Knob::mouseDrag(const juce::MouseEvent& event)
         lastDragPosition = event.position;
 
         // === Commit the live-shifted range immediately ===
-        const auto ids = KnobModulationEngine::getParameterIDsFor(paramID);
-        if (auto* minParam = apvts.getParameter(ids[2]))
-            minParam->setValueNotifyingHost(modEngine.getRange().first);
-        if (auto* maxParam = apvts.getParameter(ids[3]))
-            maxParam->setValueNotifyingHost(modEngine.getRange().second);
+        commitModulationRange();
 
         repaint();
         return;
@@ -472,14 +578,7 @@ void Knob::mouseUp(const juce::MouseEvent& event)
     if (modEngine.isEditing())
     {
         modEngine.endRangeEdit();
-        const auto ids = KnobModulationEngine::getParameterIDsFor(paramID);
-
-        if (auto* minParam = apvts.getParameter(ids[2]))
-            minParam->setValueNotifyingHost(modEngine.getRange().first);
-
-        if (auto* maxParam = apvts.getParameter(ids[3]))
-            maxParam->setValueNotifyingHost(modEngine.getRange().second);
-
+        commitModulationRange();
         repaint();
     }
     // Otherwise, if in Envelope or LFO modulation mode, commit the
@@ -487,14 +586,7 @@ void Knob::mouseUp(const juce::MouseEvent& event)
     else if (modEngine.getMode() == ModulationMode::Envelope
         || modEngine.getMode() == ModulationMode::LFO)
     {
-        const auto ids = KnobModulationEngine::getParameterIDsFor(paramID);
-
-        if (auto* minParam = apvts.getParameter(ids[2]))
-            minParam->setValueNotifyingHost(modEngine.getRange().first);
-
-        if (auto* maxParam = apvts.getParameter(ids[3]))
-            maxParam->setValueNotifyingHost(modEngine.getRange().second);
-
+        commitModulationRange();
         repaint();
     }
     else
@@ -504,11 +596,43 @@ void Knob::mouseUp(const juce::MouseEvent& event)
     }
 }
 
-void Knob::timerCallback()
+void Knob::commitModulationRange()
+{
+    auto& matrix = processor.getModulationMatrix();
+    auto route = matrix.getMainRoute(paramID);
+    std::tie(route.min, route.max) = modEngine.getRange();
+    matrix.setMainRoute(paramID, route);
+}
+
+void Knob::refresh()
 {
     if (!isShowing())
     {
-        stopTimer();
+        if (!isModulated())
+            refreshScheduler->remove(this);
+        return;
+    }
+
+    if (isModulated())
+        showModulatedValue();
+
+    if (isMidiLearnActive)
+    {
+        processor.dispatchMidiLearnEvents();
+
+        // Another knob took over MIDI Learn
+        if (isMidiLearnActive && processor.getMidiCCMap().getLearningParameter() != apvts.getParameter(paramID))
+        {
+            isMidiLearnActive = false;
+            glowAlpha = 0.4f;
+            repaint();
+        }
+    }
+
+    if (!isMidiLearnActive)
+    {
+        if (!isModulated())
+            updateRefreshState();
         return;
     }
 
@@ -544,6 +668,42 @@ void Knob::updateTheme()
     repaint();
 }
 
+void Knob::updateRefreshState()
+{
+    if (isMidiLearnActive)
+    {
+        refreshScheduler->add(this);
+        return;
+    }
+
+    if (isModulated())
+    {
+        refreshScheduler->add(this);
+        return;
+    }
+
+    refreshScheduler->remove(this);
+
+    // Modulation only moved the slider, so show the parameter's own value again
+    if (auto* param = apvts.getParameter(paramID))
+        slider.setValue(param->convertFrom0to1(param->getValue()), juce::dontSendNotification);
+}
+
+void Knob::showModulatedValue()
+{
+    auto* param = apvts.getParameter(paramID);
+    if (param == nullptr)
+        return;
+
+    const auto value = processor.getModulationRouter().getModulationValue(this);
+    if (!value.has_value())
+        return;
+
+    const auto [min, max] = modEngine.getRange();
+    const float normalized = juce::jlimit(0.0f, 1.0f, juce::jmap(*value, min, max));
+    slider.setValue(param->convertFrom0to1(normalized), juce::dontSendNotification);
+}
+
 void Knob::clearModulation()
 {
     modEngine.clear();
@@ -556,6 +716,10 @@ void Knob::setModulationMode(ModulationMode mode)
     // Always disable text entry in all modes
     slider.setTextBoxIsEditable(false);
 
+    // The router only edits links on the message thread
+    JUCE_ASSERT_MESSAGE_THREAD
+    updateRefreshState();
+
     switch (mode)
     {
     case ModulationMode::Manual:
@@ -567,15 +731,10 @@ void Knob::setModulationMode(ModulationMode mode)
     case ModulationMode::LFO:
         slider.setInterceptsMouseClicks(false, false);
 
-        // Restore modulation range from APVTS if available
-        if (auto* minParam = apvts.getParameter(paramID + "_MOD_MIN"))
+        // Restore the modulation range stored with the route
         {
-            if (auto* maxParam = apvts.getParameter(paramID + "_MOD_MAX"))
-            {
-                float minValue = minParam->getValue();
-                float maxValue = maxParam->getValue();
-                modEngine.setRange(minValue, maxValue);
-            }
+            const auto route = processor.getModulationMatrix().getMainRoute(paramID);
+            modEngine.setRange(route.min, route.max);
         }
         break;
     }
@@ -591,21 +750,6 @@ bool Knob::isModulated() const
     return modEngine.getMode() == ModulationMode::Envelope || modEngine.getMode() == ModulationMode::LFO;
 }
 
-void Knob::setModulationValue(float normalizedValue)
-{
-    modEngine.setValue(normalizedValue);
-
-    if (modEngine.getMode() == ModulationMode::Envelope || modEngine.getMode() == ModulationMode::LFO)
-    {
-        const auto [min, max] = modEngine.getRange();
-        float modScaled = min + (max - min) * normalizedValue;
-        float final = juce::jlimit(0.0f, 1.0f, modScaled);
-
-        if (auto* param = apvts.getParameter(paramID))
-            param->setValueNotifyingHost(final);
-    }
-}
-
 void Knob::setModulationRange(float minNormalized, float maxNormalized)
 {
     modEngine.setRange(minNormalized, maxNormalized);
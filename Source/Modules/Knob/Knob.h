@@ -2,6 +2,7 @@
 
 #include "../../Common.h"
 #include "KnobModulation.h"
+#include "../RefreshScheduler/RefreshScheduler.h"
 #include <JuceHeader.h>
 
 class DigitalSynthesizerAudioProcessor;
@@ -10,7 +11,7 @@ class DigitalSynthesizerAudioProcessor;
  * @class Knob
  * @brief A rotary knob component with MIDI learn functionality.
  */
-class Knob : public juce::Component, public ModulatableParameter, private juce::Timer
+class Knob : public juce::Component, public ModulatableParameter, private RefreshScheduler::Client
 {
 public:
     /**
@@ -147,20 +148,16 @@ public:
     void setSliderValue(float value, juce::NotificationType notify = juce::sendNotificationSync);
 
     /**
-     * @brief Assigns a MIDI CC number to this knob.
+     * @brief Shows a MIDI CC number as assigned to this knob.
+     *
+     * The binding itself lives in the processor's MidiCCMap; this only updates the knob's state.
+     *
      * @param cc The MIDI CC number to assign.
      */
     void assignMidiCC(int cc);
 
     /**
-     * @brief Handles incoming MIDI CC messages and updates the knob value.
-     * @param ccNumber The incoming MIDI CC number.
-     * @param ccValue The normalized MIDI CC value (0.0 to 1.0).
-     */
-    void handleMidiCC(int ccNumber, float ccValue);
-
-    /**
-     * @brief Unassigns any MIDI CC mapping from this knob.
+     * @brief Unassigns any MIDI CC mapping from this knob and disarms a pending MIDI Learn.
      */
     void forgetMidiCC();
 
@@ -200,9 +197,9 @@ public:
 
 
     /** 
-     * @brief Timer callback for handling glow animation in MIDI Learn mode.
+     * @brief Shared refresh tick for the MIDI Learn glow and the modulated value display.
      */
-    void timerCallback() override;
+    void refresh() override;
 
     /**
     * @brief Updates the visual appearance of the knob to match the current theme.
@@ -246,7 +243,6 @@ private:
     float glowAlpha = 0.4f;                         ///< Glow effect alpha for MIDI Learn.
     bool increasingGlow = true;                     ///< Glow animation direction.
     int midiCC = -1;                                ///< Assigned MIDI CC (-1 if none).
-    static constexpr int midiLearnBlinkRateHz = 30; ///< MIDI Learn blink rate (Hz).
     static constexpr float glowIncrement = 0.05f;   ///< Glow intensity increment.
     static constexpr float glowMax = 1.0f;          ///< Maximum glow intensity.
     static constexpr float glowMin = 0.2f;          ///< Minimum glow intensity.
@@ -265,9 +261,43 @@ private:
         MidiLearn = 1,     ///< MIDI Learn command.
         EnvelopeBase = 10, ///< Envelope 0 = 10, etc.
         LfoBase = 20,      ///< LFO 0 = 20, etc.
-        Clean = 99         ///< Clear modulation.
+        Clean = 99,        ///< Clear modulation.
+        SlotEnvelopeBase = 100, ///< Toggle Envelope 0 as an extra source = 100, etc.
+        SlotLfoBase = 110,      ///< Toggle LFO 0 as an extra source = 110, etc.
+        SlotEditBase = 200      ///< Extra slot n, action a = 200 + n * slotActionCount + a.
     };
 
+    /**
+     * @brief Edits offered for each extra modulation slot.
+     */
+    enum SlotAction
+    {
+        SlotDepthQuarter = 0, ///< Set depth to 25%, keeping its sign.
+        SlotDepthHalf,        ///< Set depth to 50%, keeping its sign.
+        SlotDepthFull,        ///< Set depth to 100%, keeping its sign.
+        SlotInvert,           ///< Flip the sign of the depth.
+        SlotBipolar,          ///< Toggle between unipolar and bipolar.
+        SlotRemove,           ///< Remove the slot.
+        slotActionCount       ///< Number of actions per slot.
+    };
+
+    /**
+     * @brief Adds the extra modulation sources submenu to the knob's popup menu.
+     * @param menu The popup menu being built.
+     */
+    void addModulationSlotMenu(juce::PopupMenu& menu);
+
+    /**
+     * @brief Applies a menu result from the extra modulation sources submenu.
+     * @param result Menu item ID, at least ModMenuID::SlotEnvelopeBase.
+     */
+    void handleModulationSlotMenu(int result);
+
+    /**
+     * @brief Stores the range being edited as the main route's range in the ModulationMatrix.
+     */
+    void commitModulationRange();
+
     KnobModulationEngine modEngine;      ///< Modulation logic engine.
     juce::Point<float> lastDragPosition; ///< Cached drag position.
 
@@ -277,11 +307,18 @@ private:
      */
     bool isModulated() const;
 
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler; ///< Shared UI refresh tick.
+
+    /**
+     * @brief Resyncs the slider with its parameter and registers with or leaves the
+     * refresh scheduler depending on MIDI Learn and modulation state. Message thread only.
+     */
+    void updateRefreshState();
+
     /**
-     * @brief Applies a normalized modulation value (0.01.0) to the knob.
-     * Only active in Envelope or LFO mode.
+     * @brief Moves the slider to show the latest modulated value without touching the parameter.
      */
-    void setModulationValue(float normalizedValue) override;
+    void showModulatedValue();
 
     /**
      * @brief Sets the modulation range boundaries in normalized [0.01.0] space.
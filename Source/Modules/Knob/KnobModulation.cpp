@@ -1,40 +1,4 @@
 ﻿#include "KnobModulation.h"
-#include "Knob.h"
-
-void KnobModulationEngine::registerParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout, const juce::String& paramID)
-{
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-        paramID + "_MOD_SOURCE",
-        "Mod Source",
-        juce::StringArray{ "None", "Manual", "Midi", "Envelope", "LFO" },
-        static_cast<int>(ModulationMode::None)
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterInt>(
-        paramID + "_MOD_INDEX",
-        "Mod Index",
-        0, std::max(NUM_OF_ENVELOPES, NUM_OF_LFOS) - 1, 0
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        paramID + "_MOD_MIN",
-        "Mod Min",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f),
-        0.0f
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        paramID + "_MOD_MAX",
-        "Mod Max",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f),
-        1.0f
-    ));
-}
-
-void KnobModulationEngine::setValue(float normalized)
-{
-    value = juce::jlimit(0.0f, 1.0f, normalized);
-}
 
 void KnobModulationEngine::setMode(ModulationMode newMode)
 {
@@ -66,7 +30,6 @@ int KnobModulationEngine::getSourceIndex() const
 void KnobModulationEngine::clear()
 {
     mode = ModulationMode::Manual;
-    value = 0.0f;
     min = 0.0f;
     max = 1.0f;
     delta = 1.0f;
@@ -127,11 +90,6 @@ bool KnobModulationEngine::isEditing() const
     return dragging;
 }
 
-float KnobModulationEngine::getModulationValue() const
-{
-    return value;
-}
-
 void KnobModulationEngine::shiftRange(float deltaY)
 {
     float sensitivity = 0.01f;
@@ -160,34 +118,71 @@ void KnobModulationEngine::shiftRange(float deltaY)
     delta = max - min;
 }
 
-juce::StringArray KnobModulationEngine::getParameterIDsFor(const juce::String& paramID)
+ModulationRouter::ModulationRouter()
+{
+    publishRoutingTable();
+    startTimerHz(commandTimerHz);
+}
+
+ModulationRouter::~ModulationRouter()
 {
-    return {
-        paramID + "_MOD_SOURCE",
-        paramID + "_MOD_INDEX",
-        paramID + "_MOD_MIN",
-        paramID + "_MOD_MAX"
-    };
+    stopTimer();
+    freeRetiredTables();
+    delete pendingTable.exchange(nullptr);
+    delete audioTable;
 }
 
 void ModulationRouter::registerTarget(ModulatableParameter* target)
 {
-    // No-op for now. Could track all targets if needed.
+    acquireSlot(target);
 }
 
 void ModulationRouter::unregisterTarget(ModulatableParameter* target)
 {
+    if (target == nullptr)
+        return;
+
+    jassert(isEditingThread());
+
+    // Edits queued for this target must not run once it is gone
+    processCommands();
     disconnect(target);
+
+    if (targetSlots.erase(target) > 0)
+        publishRoutingTable();
+
+    // The slot stays valid memory, a table still routing to it only writes a value nobody reads
+    if (target->modulationSlot >= 0)
+    {
+        slotOwners[target->modulationSlot] = nullptr;
+        target->modulationSlot = -1;
+    }
 }
 
 void ModulationRouter::connect(const ModulationSourceID& source, ModulatableParameter* target)
 {
-    // First remove the target from any previous connection
-    disconnect(target);
+    if (target == nullptr)
+        return;
 
-    // Store in both maps
-    sourceToTargets[source].push_back(target);
-    targetToSource[target] = source;
+    if (!isEditingThread())
+    {
+        post({ Command::Type::Connect, source, target });
+        return;
+    }
+
+    if (acquireSlot(target) < 0)
+        return;
+
+    // Rebuild only if the link actually changes, automation resends the same values
+    const auto existing = targetToSource.find(target);
+    if (existing == targetToSource.end() || !(existing->second == source))
+    {
+        // First remove the target from any previous connection
+        disconnect(target);
+
+        targetToSource[target] = source;
+        publishRoutingTable();
+    }
 
     // Notify the target of its new modulation mode
     switch (source.type)
@@ -210,93 +205,230 @@ void ModulationRouter::disconnect(ModulatableParameter* target)
     if (target == nullptr)
         return;
 
+    if (!isEditingThread())
+    {
+        post({ Command::Type::Disconnect, {}, target });
+        return;
+    }
+
     auto it = targetToSource.find(target);
-    if (it != targetToSource.end())
+    if (it == targetToSource.end())
+        return;
+
+    targetToSource.erase(it);
+    publishRoutingTable();
+
+    // Notify target it has no modulation
+    resetTargetValue(target);
+    target->setModulationMode(ModulationMode::Manual);
+    target->clearModulation();
+}
+
+void ModulationRouter::setModulationSlots(ModulatableParameter* target, const std::vector<ModulationSlot>& slots)
+{
+    jassert(isEditingThread());
+
+    if (target == nullptr || acquireSlot(target) < 0)
+        return;
+
+    if (slots.empty())
+    {
+        if (targetSlots.erase(target) == 0)
+            return;
+    }
+    else
     {
-        const auto& source = it->second;
-        auto& targets = sourceToTargets[source];
+        targetSlots[target] = slots;
+    }
 
-        // Remove the target from source's list
-        targets.erase(std::remove(targets.begin(), targets.end(), target), targets.end());
+    publishRoutingTable();
+}
 
-        // If no more targets, erase the source key entirely
-        if (targets.empty())
-            sourceToTargets.erase(source);
+void ModulationRouter::beginBlock() noexcept
+{
+    // Keep the current table until there is room to hand it back
+    if (retiredFifo.getFreeSpace() == 0)
+        return;
 
-        // Clear reverse lookup
-        targetToSource.erase(it);
+    auto* next = pendingTable.exchange(nullptr, std::memory_order_acq_rel);
+    if (next == nullptr)
+        return;
 
-        // Notify target it has no modulation
-        target->setModulationMode(ModulationMode::Manual);
-        target->clearModulation();
+    if (audioTable != nullptr)
+    {
+        const auto scope = retiredFifo.write(1);
+        retiredTables[scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2] = audioTable;
     }
+
+    audioTable = next;
+}
+
+std::optional<float> ModulationRouter::getModulationValue(const ModulatableParameter* target) const noexcept
+{
+    if (target == nullptr || target->modulationSlot < 0)
+        return std::nullopt;
+
+    const auto& slot = targetValues[target->modulationSlot];
+    if (!slot.applied.load(std::memory_order_acquire))
+        return std::nullopt;
+
+    return slot.value.load(std::memory_order_relaxed);
 }
 
 void ModulationRouter::pushModulationValue(const ModulationSourceID& source, float normalizedValue)
 {
-    lastModValues[source] = normalizedValue;
+    const int sourceSlot = getSourceSlot(source);
+    lastModValues[sourceSlot].store(normalizedValue, std::memory_order_relaxed);
+    sourcePushed[sourceSlot].store(true, std::memory_order_release);
 
-    auto it = sourceToTargets.find(source);
-    if (it == sourceToTargets.end())
+    if (audioTable == nullptr)
         return;
 
-    auto& targets = it->second;
-    for (auto targetIt = targets.begin(); targetIt != targets.end();)
+    const auto* route = audioTable->routes.data() + audioTable->firstRoute[sourceSlot];
+    const auto* end = audioTable->routes.data() + audioTable->firstRoute[sourceSlot + 1];
+
+    for (; route != end; ++route)
     {
-        if (ModulatableParameter* target = *targetIt)
-        {
-            target->setModulationValue(normalizedValue);
-            ++targetIt;
-        }
-        else
-        {
-            // Remove dangling null pointers
-            targetIt = targets.erase(targetIt);
-        }
+        auto& slot = targetValues[route->target];
+        slot.value.store(normalizedValue, std::memory_order_relaxed);
+        slot.applied.store(true, std::memory_order_release);
+    }
+}
+
+void ModulationRouter::applyModulationSlots() noexcept
+{
+    if (audioTable == nullptr || audioTable->slotSources.empty())
+        return;
+
+    auto& table = *audioTable;
+    const int numEntries = static_cast<int>(table.slotSources.size());
+    float* values = table.slotValues.data();
+
+    for (int i = 0; i < numEntries; ++i)
+        values[i] = lastModValues[table.slotSources[i]].load(std::memory_order_relaxed);
+
+    juce::FloatVectorOperations::multiply(values, table.slotGains.data(), numEntries);
+    juce::FloatVectorOperations::add(values, table.slotOffsets.data(), numEntries);
+
+    // Entries are grouped by target, so each target's sum is one contiguous run
+    for (int i = 0; i < numEntries;)
+    {
+        const int target = table.slotTargets[i];
+        float sum = 0.0f;
+
+        for (; i < numEntries && table.slotTargets[i] == target; ++i)
+            sum += values[i];
+
+        targetValues[target].offset.store(sum, std::memory_order_relaxed);
+    }
+}
+
+bool ModulationRouter::hasModulationSlots(const ModulatableParameter* target) const noexcept
+{
+    if (audioTable == nullptr || target == nullptr || target->modulationSlot < 0)
+        return false;
+
+    return audioTable->firstSlot[target->modulationSlot + 1] > audioTable->firstSlot[target->modulationSlot];
+}
+
+bool ModulationRouter::isSourceRouted(const ModulationSourceID& source) const noexcept
+{
+    return audioTable != nullptr && audioTable->sourceRouted[getSourceSlot(source)];
+}
+
+float ModulationRouter::getModulationOffset(const ModulatableParameter* target) const noexcept
+{
+    if (!hasModulationSlots(target))
+        return 0.0f;
+
+    return targetValues[target->modulationSlot].offset.load(std::memory_order_relaxed);
+}
+
+float ModulationRouter::getModulationOffsetAt(const ModulatableParameter* target, int sampleIndex) const noexcept
+{
+    if (!hasModulationSlots(target))
+        return 0.0f;
+
+    const auto& table = *audioTable;
+    float sum = 0.0f;
+
+    for (int i = table.firstSlot[target->modulationSlot]; i < table.firstSlot[target->modulationSlot + 1]; ++i)
+    {
+        const int source = table.slotSources[i];
+        const auto& span = modulationSpans[source];
+        const float value = span.isValid() ? span.getValueAt(sampleIndex) : lastModValues[source].load(std::memory_order_relaxed);
+        sum += value * table.slotGains[i] + table.slotOffsets[i];
     }
+
+    return sum;
 }
 
 void ModulationRouter::disconnectAllTargetsUsing(const ModulationSourceID& source)
 {
-    auto it = sourceToTargets.find(source);
-    if (it == sourceToTargets.end())
+    if (!isEditingThread())
+    {
+        // Requests made again before the first is processed collapse into it
+        if (!sourceDisconnectQueued[getSourceSlot(source)].exchange(true, std::memory_order_acq_rel))
+            post({ Command::Type::DisconnectSource, source, nullptr });
         return;
+    }
 
-    for (auto* target : it->second)
+    std::vector<ModulatableParameter*> targets;
+    for (const auto& [target, targetSource] : targetToSource)
     {
-        if (target)
-        {
-            target->clearModulation();
-            target->setModulationMode(ModulationMode::Manual);
+        if (targetSource == source)
+            targets.push_back(target);
+    }
 
-            // Reset to default value
-            if (auto* knob = dynamic_cast<Knob*>(target))
-            {
-                if (auto* param = knob->getAPVTS().getParameter(knob->getParamID()))
-                    param->setValueNotifyingHost(param->getDefaultValue());
-            }
+    bool slotsChanged = false;
+    for (auto it = targetSlots.begin(); it != targetSlots.end();)
+    {
+        auto& slots = it->second;
+        const auto oldSize = slots.size();
+        slots.erase(std::remove_if(slots.begin(), slots.end(),
+            [&source](const ModulationSlot& slot) { return slot.source == source; }), slots.end());
 
-            targetToSource.erase(target);
-        }
+        slotsChanged = slotsChanged || slots.size() != oldSize;
+        it = slots.empty() ? targetSlots.erase(it) : std::next(it);
     }
 
-    sourceToTargets.erase(it);
+    if (targets.empty() && !slotsChanged)
+        return;
+
+    for (auto* target : targets)
+        targetToSource.erase(target);
+
+    publishRoutingTable();
+
+    for (auto* target : targets)
+    {
+        // Modulation never wrote the base parameter, so clearing is enough to restore it
+        resetTargetValue(target);
+        target->clearModulation();
+        target->setModulationMode(ModulationMode::Manual);
+    }
 }
 
 void ModulationRouter::disconnectAll()
 {
+    if (!isEditingThread())
+    {
+        post({ Command::Type::DisconnectAll, {}, nullptr });
+        return;
+    }
+
     for (auto& [target, source] : targetToSource)
     {
-        if (target)
-        {
-            target->clearModulation();
-            target->setModulationMode(ModulationMode::Manual);
-        }
+        resetTargetValue(target);
+        target->clearModulation();
+        target->setModulationMode(ModulationMode::Manual);
     }
 
-    sourceToTargets.clear();
     targetToSource.clear();
-    lastModValues.clear();
+    publishRoutingTable();
+
+    for (auto& pushed : sourcePushed)
+        pushed.store(false, std::memory_order_relaxed);
 }
 
 std::optional<ModulationSourceID> ModulationRouter::getSourceForTarget(ModulatableParameter* target) const
@@ -310,28 +442,214 @@ std::optional<ModulationSourceID> ModulationRouter::getSourceForTarget(Modulatab
 
 void ModulationRouter::retriggerPush(const ModulationSourceID& source)
 {
-    auto valueIt = lastModValues.find(source);
-    if (valueIt == lastModValues.end())
+    const int sourceSlot = getSourceSlot(source);
+    if (!sourcePushed[sourceSlot].load(std::memory_order_acquire))
         return;
 
-    float value = valueIt->second;
-
-    auto it = sourceToTargets.find(source);
-    if (it == sourceToTargets.end())
-        return;
+    const float value = lastModValues[sourceSlot].load(std::memory_order_relaxed);
 
-    for (auto* target : it->second)
+    for (const auto& [target, targetSource] : targetToSource)
     {
-        if (target)
-            target->setModulationValue(value);
+        if (targetSource == source && target->modulationSlot >= 0)
+        {
+            auto& slot = targetValues[target->modulationSlot];
+            slot.value.store(value, std::memory_order_relaxed);
+            slot.applied.store(true, std::memory_order_release);
+        }
     }
 }
 
 void ModulationRouter::connectIfAlive(const ModulationSourceID& source, ModulatableParameter* target)
 {
-    if (lastModValues.find(source) != lastModValues.end())
+    if (sourcePushed[getSourceSlot(source)].load(std::memory_order_acquire))
     {
         connect(source, target);
         retriggerPush(source);
     }
-}
\ No newline at end of file
+}
+
+void ModulationRouter::setModulationSpan(const ModulationSourceID& source, const float* data, int numSamples)
+{
+    modulationSpans[getSourceSlot(source)] = { data, numSamples };
+}
+
+void ModulationRouter::clearModulationSpan(const ModulationSourceID& source)
+{
+    modulationSpans[getSourceSlot(source)] = {};
+}
+
+ModulationSpan ModulationRouter::getModulationSpan(const ModulationSourceID& source) const
+{
+    return modulationSpans[getSourceSlot(source)];
+}
+
+bool ModulationRouter::hasActiveSpans() const
+{
+    if (audioTable == nullptr)
+        return false;
+
+    for (int s = 0; s < numSources; ++s)
+    {
+        if (modulationSpans[s].isValid() && audioTable->sourceRouted[s])
+            return true;
+    }
+
+    return false;
+}
+
+void ModulationRouter::timerCallback()
+{
+    processCommands();
+}
+
+void ModulationRouter::processCommands()
+{
+    Command command;
+    while (commands.pop(command))
+    {
+        switch (command.type)
+        {
+        case Command::Type::Connect:
+            if (isRegistered(command.target))
+                connect(command.source, command.target);
+            break;
+
+        case Command::Type::Disconnect:
+            if (isRegistered(command.target))
+                disconnect(command.target);
+            break;
+
+        case Command::Type::DisconnectSource:
+            sourceDisconnectQueued[getSourceSlot(command.source)].store(false, std::memory_order_release);
+            disconnectAllTargetsUsing(command.source);
+            break;
+
+        case Command::Type::DisconnectAll:
+            disconnectAll();
+            break;
+        }
+    }
+}
+
+void ModulationRouter::post(const Command& command) noexcept
+{
+    if (commands.push(command))
+        return;
+
+    // Queue full, the edit is lost: raise commandQueueSize
+    jassertfalse;
+
+    if (command.type == Command::Type::DisconnectSource)
+        sourceDisconnectQueued[getSourceSlot(command.source)].store(false, std::memory_order_release);
+}
+
+bool ModulationRouter::isEditingThread() noexcept
+{
+    return juce::MessageManager::existsAndIsCurrentThread();
+}
+
+bool ModulationRouter::isRegistered(const ModulatableParameter* target) const noexcept
+{
+    return target != nullptr && std::find(slotOwners.begin(), slotOwners.end(), target) != slotOwners.end();
+}
+
+int ModulationRouter::getSourceSlot(const ModulationSourceID& source) noexcept
+{
+    const int index = source.type == ModulationSourceType::Envelope
+        ? juce::jlimit(0, NUM_OF_ENVELOPES - 1, source.index)
+        : NUM_OF_ENVELOPES + juce::jlimit(0, juce::jmax(0, NUM_OF_LFOS - 1), source.index);
+
+    jassert(index < numSources);
+    return index;
+}
+
+int ModulationRouter::acquireSlot(ModulatableParameter* target)
+{
+    if (target == nullptr)
+        return -1;
+
+    if (target->modulationSlot >= 0)
+        return target->modulationSlot;
+
+    for (int slot = 0; slot < maxTargets; ++slot)
+    {
+        if (slotOwners[slot] == nullptr)
+        {
+            slotOwners[slot] = target;
+            target->modulationSlot = slot;
+            resetTargetValue(target);
+            return slot;
+        }
+    }
+
+    jassertfalse; // Raise maxTargets
+    return -1;
+}
+
+void ModulationRouter::resetTargetValue(const ModulatableParameter* target) noexcept
+{
+    if (target->modulationSlot >= 0)
+        targetValues[target->modulationSlot].applied.store(false, std::memory_order_release);
+}
+
+void ModulationRouter::publishRoutingTable()
+{
+    auto table = std::make_unique<RoutingTable>();
+    table->routes.reserve(targetToSource.size());
+
+    for (const auto& [target, source] : targetToSource)
+        table->routes.push_back({ getSourceSlot(source), target->modulationSlot });
+
+    std::sort(table->routes.begin(), table->routes.end(),
+        [](const Route& a, const Route& b) { return a.source < b.source; });
+
+    // Count routes per source, then turn the counts into start offsets
+    for (const auto& route : table->routes)
+        ++table->firstRoute[route.source + 1];
+
+    for (int s = 0; s < numSources; ++s)
+        table->firstRoute[s + 1] += table->firstRoute[s];
+
+    for (const auto& route : table->routes)
+        table->sourceRouted[route.source] = true;
+
+    // Slots, grouped by target slot
+    std::vector<std::pair<int, ModulationSlot>> entries;
+    for (const auto& [target, slots] : targetSlots)
+        for (const auto& slot : slots)
+            entries.emplace_back(target->modulationSlot, slot);
+
+    std::sort(entries.begin(), entries.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const auto& [targetSlot, slot] : entries)
+    {
+        const int sourceSlot = getSourceSlot(slot.source);
+        table->slotSources.push_back(sourceSlot);
+        table->slotTargets.push_back(targetSlot);
+        table->slotGains.push_back(slot.bipolar ? 2.0f * slot.depth : slot.depth);
+        table->slotOffsets.push_back(slot.bipolar ? -slot.depth : 0.0f);
+        table->sourceRouted[sourceSlot] = true;
+        ++table->firstSlot[targetSlot + 1];
+    }
+
+    for (int t = 0; t < maxTargets; ++t)
+        table->firstSlot[t + 1] += table->firstSlot[t];
+
+    table->slotValues.resize(entries.size());
+
+    freeRetiredTables();
+
+    // A table the audio thread never picked up was never read, it can go right away
+    delete pendingTable.exchange(table.release(), std::memory_order_acq_rel);
+}
+
+void ModulationRouter::freeRetiredTables()
+{
+    const auto scope = retiredFifo.read(retiredFifo.getNumReady());
+    scope.forEach([this](int index)
+        {
+            delete retiredTables[index];
+            retiredTables[index] = nullptr;
+        });
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Common.h"
+#include "../CommandQueue/CommandQueue.h"
 #include <JuceHeader.h>
 
 /**
@@ -30,12 +31,6 @@ enum class ModulationSourceType
 class KnobModulationEngine
 {
 public:
-    /**
-     * @brief Applies a normalized modulation value.
-     * @param normalized Value in range [0.0, 1.0].
-     */
-    void setValue(float normalized);
-
     /**
      * @brief Sets the modulation mode.
      * @param newMode One of: Manual, MIDI, Envelope, or LFO.
@@ -102,37 +97,15 @@ public:
      */
     bool isEditing() const;
 
-    /**
-     * @brief Returns the last modulation value.
-     * @return Last applied modulation value.
-     */
-    float getModulationValue() const;
-
     /**
      * @brief Shifts the modulation range vertically.
      * @param deltaY Drag delta in Y-axis.
      */
     void shiftRange(float deltaY);
 
-    /**
-     * @brief Registers APVTS parameters for storing modulation state.
-     * @param layout Reference to the parameter layout.
-     * @param paramID Base parameter ID (e.g., \"LFO2_FREQ\").
-     */
-    static void registerParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout, const juce::String& paramID);
-
-    /**
-     * @brief Returns all modulation-related parameter IDs for a base parameter.
-     * @param paramID The base parameter ID (e.g., \"LFO2_FREQ\").
-     * @return List of parameter IDs: _MOD_SOURCE, _MOD_INDEX, _MOD_MIN, _MOD_MAX
-     */
-    static juce::StringArray getParameterIDsFor(const juce::String& paramID);
-
-
 private:
     ModulationMode mode = ModulationMode::Manual; ///< Current modulation mode (Manual, MIDI, Envelope, LFO).
     int modSourceIndex = 0;                       ///< Index of the selected modulation source.
-    float value = 0.0f;                           ///< Last received normalized modulation value.
     float min = 0.0f;                             ///< Lower modulation range boundary (normalized, [0.01.0]).
     float max = 1.0f;                             ///< Upper modulation range boundary (normalized, [0.01.0]).
     float delta = 1.0f;                           ///< Cached delta = max - min. Used for range shifting.
@@ -155,30 +128,57 @@ struct ModulationSourceID
     }
 };
 
-// Required to use ModulationSourceID as a key in unordered_map
-namespace std
+/**
+ * @brief One additional modulation source of a parameter, summed on top of its main source.
+ */
+struct ModulationSlot
+{
+    ModulationSourceID source{ ModulationSourceType::LFO, 0 }; ///< Source driving the slot.
+    float depth = 0.5f;    ///< Signed share of the normalized parameter range the source sweeps.
+    bool bipolar = false;  ///< True to swing the source around zero, false to add it from zero upward.
+};
+
+/**
+ * @brief Non-owning view of the modulation values a source rendered for the current block.
+ *
+ * The data is owned by the source (e.g. the LFO's modulation buffer) and stays valid
+ * until the source renders its next block.
+ */
+struct ModulationSpan
 {
-    template <>
-    struct hash<ModulationSourceID>
+    const float* data = nullptr; ///< Per-sample normalized values, or nullptr if the source has no span.
+    int numSamples = 0;          ///< Number of valid samples in data.
+
+    /**
+     * @brief Returns true if the span holds at least one sample.
+     */
+    bool isValid() const noexcept { return data != nullptr && numSamples > 0; }
+
+    /**
+     * @brief Returns the value at a sample of the block, clamped to the span length.
+     * @param sampleIndex Sample index relative to the start of the block.
+     */
+    float getValueAt(int sampleIndex) const noexcept
     {
-        std::size_t operator()(const ModulationSourceID& id) const noexcept
-        {
-            return std::hash<int>()(static_cast<int>(id.type)) ^ std::hash<int>()(id.index);
-        }
-    };
-}
+        return data[juce::jlimit(0, numSamples - 1, sampleIndex)];
+    }
+
+    /**
+     * @brief Returns the last value of the span.
+     */
+    float getLastValue() const noexcept { return data[numSamples - 1]; }
+};
 
 /**
  * @brief Interface for any parameter that can be modulated.
+ *
+ * Modulation values are not pushed into the parameter. The router writes them
+ * into a slot it owns, and the parameter reads its slot back with
+ * ModulationRouter::getModulationValue().
  */
 class ModulatableParameter
 {
 public:
-    /**
-     * @brief Apply a normalized modulation value (0.0 - 1.0) to the parameter.
-     */
-    virtual void setModulationValue(float normalizedValue) = 0;
-
     /**
      * @brief Set the normalized modulation bounds [min, max], both in 0.0 - 1.0 range.
      */
@@ -205,6 +205,11 @@ public:
     virtual void clearModulation() = 0;
 
     virtual ~ModulatableParameter() = default;
+
+private:
+    friend class ModulationRouter;
+
+    int modulationSlot = -1; ///< Router slot holding this target's modulation value, assigned on first connect.
 };
 
 /**
@@ -212,30 +217,114 @@ public:
  *
  * Each source (Envelope, LFO, etc.) is identified by a ModulationSourceID.
  * Each target is a pointer to a ModulatableParameter.
+ *
+ * A target has at most one main source, which maps into its [min, max] range, plus
+ * any number of ModulationSlot entries whose depth-scaled values are summed on top.
+ *
+ * Connections are edited on the message thread and compiled into a flat routing
+ * table of {source slot, target slot} records, sorted by source. The table is
+ * handed to the audio thread by an atomic pointer swap, so pushing a value walks
+ * one contiguous run of records and writes plain atomics: no hashing, virtual
+ * calls or locks on the audio thread.
+ *
+ * Only the message thread edits connections. Edits requested from any other
+ * thread (a routing change restored by the host, a bypassed LFO on the audio
+ * thread) are posted to a lock-free command queue and applied by the router's
+ * timer, so the audio thread never waits and never shares the editing maps.
  */
-class ModulationRouter
+class ModulationRouter : private juce::Timer
 {
 public:
+    static constexpr int numSources = NUM_OF_ENVELOPES + NUM_OF_LFOS; ///< Source slots, envelopes first.
+    static constexpr int maxTargets = 256; ///< Target slots, enough for every knob and its proxy.
+
+    /**
+     * @brief Publishes an empty routing table.
+     */
+    ModulationRouter();
+
+    /**
+     * @brief Frees every routing table, the audio thread must have stopped.
+     */
+    ~ModulationRouter() override;
+
     /**
      * @brief Register a target to be available for modulation.
+     *
+     * Targets that connect from outside the message thread must be registered first. Message thread only.
      */
     void registerTarget(ModulatableParameter* target);
 
     /**
-     * @brief Unregister a previously registered target.
+     * @brief Unregister a previously registered target. Message thread only.
      */
     void unregisterTarget(ModulatableParameter* target);
 
     /**
      * @brief Connect a target to a modulation source, replacing any existing link.
+     *
+     * Called off the message thread, the edit is queued and applied on the next timer tick.
      */
     void connect(const ModulationSourceID& source, ModulatableParameter* target);
 
     /**
      * @brief Disconnect a target from its current modulation source.
+     *
+     * Called off the message thread, the edit is queued and applied on the next timer tick.
      */
     void disconnect(ModulatableParameter* target);
 
+    /**
+     * @brief Replaces the additional modulation slots of a target. Message thread only.
+     * @param target The target to modulate.
+     * @param slots Slots summed on top of the target's main source, may be empty.
+     */
+    void setModulationSlots(ModulatableParameter* target, const std::vector<ModulationSlot>& slots);
+
+    /**
+     * @brief Picks up the routing table published last, call at the start of every audio block.
+     */
+    void beginBlock() noexcept;
+
+    /**
+     * @brief Sums every target's slots from the values pushed this block.
+     *
+     * One pass over the flat slot arrays: gather the source values, scale and offset
+     * them with vector operations, then accumulate per target. Call after all sources
+     * pushed. Audio thread only.
+     */
+    void applyModulationSlots() noexcept;
+
+    /**
+     * @brief Returns true if a target has additional slots in the table the audio thread uses.
+     */
+    bool hasModulationSlots(const ModulatableParameter* target) const noexcept;
+
+    /**
+     * @brief Returns true if a main link or slot reads a source in the table the audio thread uses.
+     */
+    bool isSourceRouted(const ModulationSourceID& source) const noexcept;
+
+    /**
+     * @brief Returns the summed slot offset computed by the last applyModulationSlots(), normalized.
+     */
+    float getModulationOffset(const ModulatableParameter* target) const noexcept;
+
+    /**
+     * @brief Returns the summed slot offset at a sample of the current block, normalized.
+     *
+     * Sources with a span contribute their value at sampleIndex, others their block value.
+     * Audio thread only.
+     */
+    float getModulationOffsetAt(const ModulatableParameter* target, int sampleIndex) const noexcept;
+
+    /**
+     * @brief Returns the value a target's source pushed last.
+     * @param target The target to read.
+     * @return The normalized source value, or std::nullopt if nothing was pushed since the target was last cleared.
+     */
+    std::optional<float> getModulationValue(const ModulatableParameter* target) const noexcept;
+
     /**
      * @brief Push a modulation value from a source to all linked targets.
      * @param source The ID of the modulator (e.g., Envelope 0)
@@ -245,13 +334,20 @@ public:
 
     /**
      * @brief Disconnects all modulation targets that are currently linked to a given source.
+     *
+     * Slots reading the source stop contributing as well.
+     *
+     * Wait-free when called from the audio thread: the edit is queued once per source
+     * until the message thread has applied it.
+     *
      * @param source The modulation source to disconnect all targets from.
      */
     void disconnectAllTargetsUsing(const ModulationSourceID& source);
 
     /**
      * @brief Disconnects all modulation sources and targets.
-     * restoring the modulation router to an empty state.
+     * restoring the modulation router to an empty state. Queued when called off the message thread.
+     * Slots are left alone, they follow the ModulationMatrix stored with the state.
      */
     void disconnectAll();
 
@@ -274,8 +370,161 @@ public:
      */
     void connectIfAlive(const ModulationSourceID& source, ModulatableParameter* target);
 
+    /**
+     * @brief Publishes the per-sample values a source rendered for the current block.
+     * @param source The modulation source that owns the data.
+     * @param data Pointer to numSamples normalized values, owned by the source.
+     * @param numSamples Number of samples in the block.
+     */
+    void setModulationSpan(const ModulationSourceID& source, const float* data, int numSamples);
+
+    /**
+     * @brief Removes the span of a source, so its targets fall back to the block value.
+     * @param source The modulation source.
+     */
+    void clearModulationSpan(const ModulationSourceID& source);
+
+    /**
+     * @brief Returns the span published by a source for the current block.
+     * @param source The modulation source.
+     * @return The span, or an invalid span if the source has none.
+     */
+    ModulationSpan getModulationSpan(const ModulationSourceID& source) const;
+
+    /**
+     * @brief Returns true if any source with connected targets or slots published a span this block.
+     */
+    bool hasActiveSpans() const;
+
+    static constexpr int subBlockSize = 32; ///< Samples between modulation updates in the DSP modules.
+
 private:
-    std::unordered_map<ModulationSourceID, std::vector<ModulatableParameter*>> sourceToTargets;
-    std::unordered_map<ModulatableParameter*, ModulationSourceID> targetToSource;
-    std::unordered_map<ModulationSourceID, float> lastModValues;
+    /**
+     * @brief One compiled connection.
+     */
+    struct Route
+    {
+        int source = 0; ///< Source slot.
+        int target = 0; ///< Target slot.
+    };
+
+    /**
+     * @brief Immutable snapshot of all connections, read by the audio thread.
+     */
+    struct RoutingTable
+    {
+        std::vector<Route> routes;                    ///< Connections sorted by source slot.
+        std::array<int, numSources + 1> firstRoute{}; ///< Routes of source s are [firstRoute[s], firstRoute[s + 1]).
+
+        // Additional slots as parallel arrays sorted by target slot, so the block pass vectorizes
+        std::vector<int> slotSources;                  ///< Source slot per entry.
+        std::vector<int> slotTargets;                  ///< Target slot per entry.
+        std::vector<float> slotGains;                  ///< Depth, doubled for bipolar entries.
+        std::vector<float> slotOffsets;                ///< Minus the depth for bipolar entries, else zero.
+        std::vector<float> slotValues;                 ///< Scratch for applyModulationSlots(), audio thread only.
+        std::array<int, maxTargets + 1> firstSlot{};   ///< Entries of target t are [firstSlot[t], firstSlot[t + 1]).
+        std::array<bool, numSources> sourceRouted{};   ///< True if any main link or slot reads the source.
+    };
+
+    /**
+     * @brief Routing edit posted from outside the message thread.
+     */
+    struct Command
+    {
+        enum class Type
+        {
+            Connect,
+            Disconnect,
+            DisconnectSource,
+            DisconnectAll
+        };
+
+        Type type = Type::DisconnectAll;                           ///< Edit to apply.
+        ModulationSourceID source{ ModulationSourceType::Envelope, 0 }; ///< Source of Connect and DisconnectSource.
+        ModulatableParameter* target = nullptr;                    ///< Target of Connect and Disconnect.
+    };
+
+    /**
+     * @brief Modulation value of one target, written by the audio thread.
+     */
+    struct TargetValue
+    {
+        std::atomic<float> value{ 0.0f };    ///< Last normalized source value.
+        std::atomic<bool> applied{ false };  ///< True once a value was pushed since the last clear.
+        std::atomic<float> offset{ 0.0f };   ///< Sum of the target's slots for the current block.
+    };
+
+    /**
+     * @brief Applies the queued edits.
+     */
+    void timerCallback() override;
+
+    /**
+     * @brief Applies every queued edit. Message thread only.
+     */
+    void processCommands();
+
+    /**
+     * @brief Queues an edit for the message thread.
+     */
+    void post(const Command& command) noexcept;
+
+    /**
+     * @brief Returns true if edits may be applied directly on the calling thread.
+     */
+    static bool isEditingThread() noexcept;
+
+    /**
+     * @brief Returns true if a pointer is a registered target, without dereferencing it.
+     */
+    bool isRegistered(const ModulatableParameter* target) const noexcept;
+
+    /**
+     * @brief Returns the slot of a source.
+     */
+    static int getSourceSlot(const ModulationSourceID& source) noexcept;
+
+    /**
+     * @brief Returns the slot of a target, assigning a free one if it has none.
+     * @return The slot, or -1 if every slot is taken.
+     */
+    int acquireSlot(ModulatableParameter* target);
+
+    /**
+     * @brief Marks a target as unmodulated until its source pushes again.
+     */
+    void resetTargetValue(const ModulatableParameter* target) noexcept;
+
+    /**
+     * @brief Compiles the connections into a new table and publishes it to the audio thread.
+     */
+    void publishRoutingTable();
+
+    /**
+     * @brief Frees the tables the audio thread stopped using.
+     */
+    void freeRetiredTables();
+
+    std::unordered_map<ModulatableParameter*, ModulationSourceID> targetToSource; ///< Connections, message thread only.
+    std::unordered_map<ModulatableParameter*, std::vector<ModulationSlot>> targetSlots; ///< Additional slots, message thread only.
+    std::array<ModulatableParameter*, maxTargets> slotOwners{};                   ///< Target owning each slot, message thread only.
+
+    std::array<TargetValue, maxTargets> targetValues;              ///< Modulation value per target slot.
+    std::array<std::atomic<float>, numSources> lastModValues{};    ///< Last value pushed per source slot.
+    std::array<std::atomic<bool>, numSources> sourcePushed{};      ///< True once a source pushed a value.
+    std::array<ModulationSpan, numSources> modulationSpans;        ///< Current block span per source slot, audio thread only.
+
+    std::atomic<RoutingTable*> pendingTable{ nullptr }; ///< Published table not yet picked up by the audio thread.
+    RoutingTable* audioTable = nullptr;                 ///< Table the audio thread routes with.
+
+    static constexpr int retiredQueueSize = 8;                ///< Tables the audio thread can hand back between two edits.
+    std::array<RoutingTable*, retiredQueueSize> retiredTables{}; ///< Tables replaced on the audio thread.
+    juce::AbstractFifo retiredFifo{ retiredQueueSize };       ///< SPSC indices into retiredTables.
+
+    static constexpr int commandQueueSize = 256;              ///< Edits that may wait for one timer tick.
+    static constexpr int commandTimerHz = 30;                 ///< Rate at which queued edits are applied.
+    CommandQueue<Command, commandQueueSize> commands;         ///< Edits posted off the message thread.
+    std::array<std::atomic<bool>, numSources> sourceDisconnectQueued{}; ///< True while a source's DisconnectSource waits.
+
+    JUCE_DECLARE_NON_COPYABLE(ModulationRouter)
 };
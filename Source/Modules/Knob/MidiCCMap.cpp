@@ -0,0 +1,86 @@
+#include "MidiCCMap.h"
+
+void MidiCCMap::beginLearn(juce::RangedAudioParameter* parameter) noexcept
+{
+    jassert(parameter != nullptr);
+    learning.store(parameter, std::memory_order_release);
+}
+
+void MidiCCMap::cancelLearn(juce::RangedAudioParameter* parameter) noexcept
+{
+    if (parameter == nullptr)
+    {
+        learning.store(nullptr, std::memory_order_release);
+        return;
+    }
+
+    learning.compare_exchange_strong(parameter, nullptr, std::memory_order_acq_rel);
+}
+
+juce::RangedAudioParameter* MidiCCMap::getLearningParameter() const noexcept
+{
+    return learning.load(std::memory_order_acquire);
+}
+
+void MidiCCMap::unbind(const juce::RangedAudioParameter* parameter) noexcept
+{
+    if (parameter == nullptr)
+        return;
+
+    for (auto& binding : bindings)
+    {
+        auto* expected = const_cast<juce::RangedAudioParameter*>(parameter);
+        binding.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+    }
+}
+
+int MidiCCMap::getControllerFor(const juce::RangedAudioParameter* parameter) const noexcept
+{
+    if (parameter == nullptr)
+        return -1;
+
+    for (int cc = 0; cc < numControllers; ++cc)
+        if (bindings[cc].load(std::memory_order_acquire) == parameter)
+            return cc;
+
+    return -1;
+}
+
+bool MidiCCMap::popLearnEvent(LearnEvent& event) noexcept
+{
+    const auto scope = learnFifo.read(1);
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+        return false;
+
+    event = learnEvents[scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2];
+    return true;
+}
+
+void MidiCCMap::handleController(int controller, int value, ParameterRelay& relay) noexcept
+{
+    if (!juce::isPositiveAndBelow(controller, numControllers))
+        return;
+
+    if (auto* armed = learning.exchange(nullptr, std::memory_order_acq_rel))
+    {
+        // A parameter follows one controller, so drop its previous binding first
+        unbind(armed);
+        bindings[controller].store(armed, std::memory_order_release);
+
+        const auto scope = learnFifo.write(1);
+        if (scope.blockSize1 + scope.blockSize2 > 0)
+            learnEvents[scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2] = { controller, armed };
+
+        // The learning gesture itself does not move the parameter
+        return;
+    }
+
+    auto* parameter = bindings[controller].load(std::memory_order_acquire);
+    if (parameter == nullptr)
+        return;
+
+    // Dense CC streams often repeat values, skip those rather than notify the host again
+    const float normalized = static_cast<float>(juce::jlimit(0, 127, value)) / 127.0f;
+    if (parameter->getValue() != normalized)
+        relay.push(*parameter, normalized);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../ParameterRelay/ParameterRelay.h"
+#include <JuceHeader.h>
+
+/**
+ * @class MidiCCMap
+ * @brief Lock-free MIDI CC to parameter table, owned by the processor so CC control works without an editor.
+ *
+ * The audio thread looks an incoming controller up in a fixed 128 entry table
+ * and sets the bound parameter through a ParameterRelay, which tells the host
+ * and the editor from the message thread. MIDI Learn is armed from the UI with
+ * a single atomic, the audio thread binds the next controller to it and reports
+ * the new binding back through a lock-free queue. Nothing on the audio side
+ * allocates, locks or posts a message per CC.
+ */
+class MidiCCMap
+{
+public:
+    static constexpr int numControllers = 128; ///< MIDI CC numbers 0 to 127
+
+    /**
+     * @struct LearnEvent
+     * @brief A binding made by MIDI Learn on the audio thread.
+     */
+    struct LearnEvent
+    {
+        int controller = -1;                            ///< Learned CC number
+        juce::RangedAudioParameter* parameter = nullptr; ///< Parameter it was bound to
+    };
+
+    /**
+     * @brief Constructs an empty map.
+     */
+    MidiCCMap() = default;
+
+    /**
+     * @brief Arms MIDI Learn, the next controller received binds to this parameter.
+     *
+     * Replaces any parameter armed before. Message thread only.
+     *
+     * @param parameter Parameter to learn.
+     */
+    void beginLearn(juce::RangedAudioParameter* parameter) noexcept;
+
+    /**
+     * @brief Disarms MIDI Learn.
+     * @param parameter Only disarm if this parameter is the armed one, nullptr disarms any.
+     */
+    void cancelLearn(juce::RangedAudioParameter* parameter = nullptr) noexcept;
+
+    /**
+     * @brief Returns the parameter waiting for a controller, or nullptr if none.
+     */
+    juce::RangedAudioParameter* getLearningParameter() const noexcept;
+
+    /**
+     * @brief Removes every binding of a parameter. Lock-free, safe from either thread.
+     * @param parameter Parameter to unbind.
+     */
+    void unbind(const juce::RangedAudioParameter* parameter) noexcept;
+
+    /**
+     * @brief Returns the controller bound to a parameter.
+     * @param parameter Parameter to look up.
+     * @return CC number, or -1 if the parameter is not bound.
+     */
+    int getControllerFor(const juce::RangedAudioParameter* parameter) const noexcept;
+
+    /**
+     * @brief Pops the oldest binding made by MIDI Learn. Message thread only.
+     * @param event Receives the binding.
+     * @return False if no binding is pending.
+     */
+    bool popLearnEvent(LearnEvent& event) noexcept;
+
+    /**
+     * @brief Learns or applies an incoming controller value.
+     *
+     * Audio thread only.
+     *
+     * @param controller CC number.
+     * @param value 7-bit controller value.
+     * @param relay Relay bound parameters are set through.
+     */
+    void handleController(int controller, int value, ParameterRelay& relay) noexcept;
+
+private:
+    static constexpr int learnQueueSize = 16; ///< Learn events the UI may fall behind by
+
+    std::array<std::atomic<juce::RangedAudioParameter*>, numControllers> bindings{}; ///< Parameter per CC, nullptr if unbound
+    std::atomic<juce::RangedAudioParameter*> learning{ nullptr };                     ///< Parameter armed for MIDI Learn
+
+    std::array<LearnEvent, learnQueueSize> learnEvents; ///< Pending learn events
+    juce::AbstractFifo learnFifo{ learnQueueSize };     ///< SPSC indices into learnEvents
+
+    JUCE_DECLARE_NON_COPYABLE(MidiCCMap)
+};
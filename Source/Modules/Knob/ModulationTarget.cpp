@@ -50,140 +50,169 @@ const std::vector<juce::String>& ModulationTarget::getAllBaseParameterIDs()
 
 ModulationTarget::ModulationTarget(juce::AudioProcessorValueTreeState& apvtsIn,
     ModulationRouter& router,
+    ModulationMatrix& matrix,
     const juce::String& baseParamID)
     : apvts(apvtsIn),
     modulationRouter(router),
-    sourceParamID(baseParamID + "_MOD_SOURCE"),
-    indexParamID(baseParamID + "_MOD_INDEX"),
-    minParamID(baseParamID + "_MOD_MIN"),
-    maxParamID(baseParamID + "_MOD_MAX")
+    modulationMatrix(matrix),
+    baseParamID(baseParamID)
 {
-    // Look up the core parameters
     baseParam = dynamic_cast<juce::RangedAudioParameter*>(
         apvts.getParameter(baseParamID));
     jassert(baseParam != nullptr);
 
-    minParam = dynamic_cast<juce::AudioParameterFloat*>(
-        apvts.getParameter(minParamID));
-    jassert(minParam != nullptr);
-
-    maxParam = dynamic_cast<juce::AudioParameterFloat*>(
-        apvts.getParameter(maxParamID));
-    jassert(maxParam != nullptr);
-
-    // Listen for runtime changes
-    apvts.addParameterListener(sourceParamID, this);
-    apvts.addParameterListener(indexParamID, this);
-    apvts.addParameterListener(minParamID, this);
-    apvts.addParameterListener(maxParamID, this);
+    // Register before listening, so routing edits always find this target
+    modulationRouter.registerTarget(this);
 
     // Initialize from saved state
-    int    modeInt = static_cast<int>(apvts.getRawParameterValue(sourceParamID)->load());
-    currentMode = static_cast<ModulationMode>(modeInt);
-    currentSourceIndex = static_cast<int>(apvts.getRawParameterValue(indexParamID)->load());
-    currentRange.first = apvts.getRawParameterValue(minParamID)->load();
-    currentRange.second = apvts.getRawParameterValue(maxParamID)->load();
-
-    setModulationMode(currentMode);
-    setModulationRange(currentRange.first, currentRange.second);
-
-    // Perform initial connect if needed
-    if (currentMode == ModulationMode::Envelope)
-        modulationRouter.connect({ ModulationSourceType::Envelope, currentSourceIndex }, this);
-    else if (currentMode == ModulationMode::LFO)
-        modulationRouter.connect({ ModulationSourceType::LFO,      currentSourceIndex }, this);
+    modulationMatrix.addListener(this);
+    modulationRoutingChanged(baseParamID);
 }
 
 ModulationTarget::~ModulationTarget()
 {
-    // Tear down connections and listeners
-    modulationRouter.disconnect(this);
-    apvts.removeParameterListener(sourceParamID, this);
-    apvts.removeParameterListener(indexParamID, this);
-    apvts.removeParameterListener(minParamID, this);
-    apvts.removeParameterListener(maxParamID, this);
+    modulationMatrix.removeListener(this);
+    modulationRouter.unregisterTarget(this);
 }
 
-void ModulationTarget::parameterChanged(const juce::String& parameterID,
-    float newValue)
+void ModulationTarget::updateConnection(ModulationMode mode)
 {
-    if (parameterID == sourceParamID)
-    {
-        // Source mode changed: rewire
-        auto newMode = static_cast<ModulationMode>(static_cast<int>(newValue));
-        if (newMode != currentMode)
-        {
-            modulationRouter.disconnect(this);
-            currentMode = newMode;
-
-            if (currentMode == ModulationMode::Envelope)
-                modulationRouter.connect({ ModulationSourceType::Envelope, currentSourceIndex }, this);
-            else if (currentMode == ModulationMode::LFO)
-                modulationRouter.connect({ ModulationSourceType::LFO,      currentSourceIndex }, this);
-        }
-    }
-    else if (parameterID == indexParamID)
-    {
-        // Source index changed: rewire if in an active mode
-        int newIndex = static_cast<int>(newValue);
-        if (newIndex != currentSourceIndex)
-        {
-            if (currentMode == ModulationMode::Envelope ||
-                currentMode == ModulationMode::LFO)
-            {
-                modulationRouter.disconnect(this);
-                auto type = (currentMode == ModulationMode::Envelope
-                    ? ModulationSourceType::Envelope
-                    : ModulationSourceType::LFO);
-                modulationRouter.connect({ type, newIndex }, this);
-            }
-            currentSourceIndex = newIndex;
-        }
-    }
-    else if (parameterID == minParamID || parameterID == maxParamID)
-    {
-        // Range changed: update cached bounds
-        float minVal = apvts.getRawParameterValue(minParamID)->load();
-        float maxVal = apvts.getRawParameterValue(maxParamID)->load();
-        setModulationRange(minVal, maxVal);
-    }
+    // The router ignores a link that did not change, so repeated automation values cost nothing
+    const int index = currentSourceIndex.load();
+
+    if (mode == ModulationMode::Envelope)
+        modulationRouter.connect({ ModulationSourceType::Envelope, index }, this);
+    else if (mode == ModulationMode::LFO)
+        modulationRouter.connect({ ModulationSourceType::LFO, index }, this);
+    else
+        modulationRouter.disconnect(this);
 }
 
-void ModulationTarget::setModulationValue(float normalizedValue)
+void ModulationTarget::modulationRoutingChanged(const juce::String& paramID)
 {
-    if (!baseParam)
+    if (paramID.isNotEmpty() && paramID != baseParamID)
         return;
 
-    float remapped = juce::jmap(normalizedValue,
-        currentRange.first,
-        currentRange.second);
-    baseParam->setValueNotifyingHost(remapped);
+    const auto route = modulationMatrix.getMainRoute(baseParamID);
+    currentSourceIndex.store(route.index);
+    updateConnection(route.mode);
+
+    // Disconnecting resets the range, so it is applied after the link
+    setModulationRange(route.min, route.max);
+
+    modulationRouter.setModulationSlots(this, modulationMatrix.getSlots(baseParamID));
 }
 
 void ModulationTarget::setModulationRange(float minNormalized,
     float maxNormalized)
 {
-    currentRange.first = minNormalized;
-    currentRange.second = maxNormalized;
+    rangeMin.store(minNormalized, std::memory_order_relaxed);
+    rangeMax.store(maxNormalized, std::memory_order_relaxed);
 }
 
 std::pair<float, float> ModulationTarget::getModulationRange() const
 {
-    return currentRange;
+    return { rangeMin.load(std::memory_order_relaxed), rangeMax.load(std::memory_order_relaxed) };
 }
 
 void ModulationTarget::setModulationMode(ModulationMode newMode)
 {
-    currentMode = newMode;
+    currentMode.store(newMode);
 }
 
 ModulationMode ModulationTarget::getModulationMode() const
 {
-    return currentMode;
+    return currentMode.load();
 }
 
 void ModulationTarget::clearModulation()
 {
-    currentMode = ModulationMode::Manual;
-    currentRange = { 0.0f, 1.0f };
-}
\ No newline at end of file
+    currentMode.store(ModulationMode::Manual);
+    setModulationRange(0.0f, 1.0f);
+}
+
+const juce::String& ModulationTarget::getBaseParameterID() const
+{
+    return baseParamID;
+}
+
+bool ModulationTarget::beginAutomationBlock(int numSamples) noexcept
+{
+    if (baseParam == nullptr || numSamples <= 0)
+        return false;
+
+    const float value = baseParam->getValue();
+    automationStart = automationStarted ? automationEnd : value;
+    automationEnd = value;
+    automationStarted = true;
+
+    automationStep = (automationEnd != automationStart)
+        ? (automationEnd - automationStart) / static_cast<float>(numSamples)
+        : 0.0f;
+
+    return automationStep != 0.0f;
+}
+
+float ModulationTarget::getValueAt(int sampleIndex, float unmodulatedValue) const
+{
+    const bool hasSlots = modulationRouter.hasModulationSlots(this);
+    const auto mode = currentMode.load();
+
+    std::optional<float> mainValue;
+    if (mode == ModulationMode::Envelope || mode == ModulationMode::LFO)
+    {
+        const auto type = (mode == ModulationMode::Envelope)
+            ? ModulationSourceType::Envelope
+            : ModulationSourceType::LFO;
+
+        const auto span = modulationRouter.getModulationSpan({ type, currentSourceIndex.load() });
+        if (span.isValid())
+            mainValue = span.getValueAt(sampleIndex);
+    }
+
+    const bool ramping = automationStep != 0.0f;
+    if ((!mainValue.has_value() && !hasSlots && !ramping) || baseParam == nullptr)
+        return unmodulatedValue;
+
+    // The value handed in already carries the previous sub-block's offset, start from the parameter itself
+    const float baseNormalized = ramping
+        ? automationStart + automationStep * static_cast<float>(sampleIndex)
+        : baseParam->getValue();
+
+    return combine(mainValue, baseNormalized,
+        hasSlots ? modulationRouter.getModulationOffsetAt(this, sampleIndex) : 0.0f);
+}
+
+float ModulationTarget::getModulatedValue(float unmodulatedValue) const
+{
+    const bool hasSlots = modulationRouter.hasModulationSlots(this);
+    const auto mode = currentMode.load();
+
+    std::optional<float> mainValue;
+    if (mode == ModulationMode::Envelope || mode == ModulationMode::LFO)
+        mainValue = modulationRouter.getModulationValue(this);
+
+    if ((!mainValue.has_value() && !hasSlots) || baseParam == nullptr)
+        return unmodulatedValue;
+
+    return combine(mainValue, baseParam->convertTo0to1(unmodulatedValue),
+        hasSlots ? modulationRouter.getModulationOffset(this) : 0.0f);
+}
+
+float ModulationTarget::combine(std::optional<float> mainValue, float baseNormalized, float offset) const
+{
+    // The main source replaces the base value inside its range, slots then add on top
+    float normalized = baseNormalized;
+    if (mainValue.has_value())
+    {
+        const auto [min, max] = getModulationRange();
+        normalized = juce::jmap(*mainValue, min, max);
+    }
+
+    return baseParam->convertFrom0to1(juce::jlimit(0.0f, 1.0f, normalized + offset));
+}
+
+float ModulationTarget::apply(const ModulationTarget* target, float unmodulatedValue)
+{
+    return target != nullptr ? target->getModulatedValue(unmodulatedValue) : unmodulatedValue;
+}
@@ -1,13 +1,23 @@
 #pragma once
 
 #include "KnobModulation.h"
+#include "../ModulationMatrix/ModulationMatrix.h"
 #include <JuceHeader.h>
 
 /**
- * @brief Proxy target for routing modulation values into an APVTS parameter.
+ * @brief Proxy target holding the modulation layer of one APVTS parameter.
+ *
+ * Modulation never writes the parameter itself. The router keeps the latest source
+ * value in this target's slot and DSP modules map it into the modulation range next
+ * to the base value, so the host sees no automation and saved state keeps the
+ * unmodulated value.
+ *
+ * The routing itself, the main source with its range and any additional slots, comes
+ * from the parameter's entries in the ModulationMatrix. The target follows them and
+ * hands them to the router, whose summed slot offset is added after the main source.
  */
 class ModulationTarget : public ModulatableParameter,
-    public juce::AudioProcessorValueTreeState::Listener
+    private ModulationMatrix::Listener
 {
 public:
     /**
@@ -20,10 +30,12 @@ public:
      * @brief Constructs a modulation proxy for a given base parameter.
      * @param apvts Reference to the plugins AudioProcessorValueTreeState.
      * @param router Reference to the processors ModulationRouter, for connect/disconnect.
-     * @param baseParamID The ID of the parameter to modulate (without "_MOD_*" suffix).
+     * @param matrix Reference to the processor's ModulationMatrix holding the routing.
+     * @param baseParamID The ID of the parameter to modulate.
      */
     ModulationTarget(juce::AudioProcessorValueTreeState& apvts,
         ModulationRouter& router,
+        ModulationMatrix& matrix,
         const juce::String& baseParamID);
 
     /**
@@ -31,12 +43,6 @@ public:
      */
     ~ModulationTarget() override;
 
-    /**
-    * @brief Sets the applied modulation value.
-    * @param normalizedValue Modulation amount in normalized range.
-    */
-    void setModulationValue(float normalizedValue) override;
-
     /**
      * @brief Sets the modulation range.
      * @param minNormalized Minimum modulation value.
@@ -68,26 +74,89 @@ public:
     void clearModulation() override;
 
     /**
-     * @brief Called by the APVTS when any listened parameter changes.
-     * @param parameterID The full ID of the parameter that changed.
-     * @param newValue The new normalized value of that parameter.
+     * @brief Returns the ID of the parameter this proxy modulates.
+     * @return The base parameter ID.
+     */
+    const juce::String& getBaseParameterID() const;
+
+    /**
+     * @brief Starts a block of host automation for the parameter.
+     *
+     * Hosts hand parameter changes over at block boundaries, so a change is
+     * ramped across the block it arrives in, from the value the previous block
+     * ended on, instead of stepping at its start. Call once per block, skipped
+     * blocks included. Audio thread only.
+     *
+     * @param numSamples Length of the block.
+     * @return True if the parameter moved since the last block and ramps over this one.
+     */
+    bool beginAutomationBlock(int numSamples) noexcept;
+
+    /**
+     * @brief Returns the modulated value at a sample of the current block.
+     *
+     * While the parameter ramps to new host automation, the base value is the
+     * ramp's value at sampleIndex.
+     *
+     * @param sampleIndex Sample index relative to the start of the block.
+     * @param unmodulatedValue Value to return if the source published no span and the parameter holds still.
+     * @return The source span value at sampleIndex, mapped into the modulation range.
+     */
+    float getValueAt(int sampleIndex, float unmodulatedValue) const;
+
+    /**
+     * @brief Returns the parameter value with the latest block modulation applied.
+     * @param unmodulatedValue The base value read from the APVTS.
+     * @return The modulated value in parameter units, or unmodulatedValue if not modulated.
+     */
+    float getModulatedValue(float unmodulatedValue) const;
+
+    /**
+     * @brief Null-safe helper for DSP modules that may have no proxy for a parameter.
+     * @param target The proxy, or nullptr.
+     * @param unmodulatedValue The base value read from the APVTS.
+     * @return The modulated value, or unmodulatedValue if target is null or not modulated.
      */
-    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    static float apply(const ModulationTarget* target, float unmodulatedValue);
 
 private:
+    /**
+     * @brief Connects to the source the mode and current index select, or disconnects.
+     * @param mode The requested modulation mode.
+     */
+    void updateConnection(ModulationMode mode);
+
+    /**
+     * @brief Applies this parameter's main route and hands its slots to the router.
+     */
+    void modulationRoutingChanged(const juce::String& paramID) override;
+
+    /**
+     * @brief Combines the main source value and the slot offset into parameter units.
+     * @param mainValue Normalized main source value, or std::nullopt if the main source is not applied.
+     * @param baseNormalized Normalized base value, used when there is no main source.
+     * @param offset Summed normalized slot offset.
+     * @return The modulated value in parameter units. baseParam must not be null.
+     */
+    float combine(std::optional<float> mainValue, float baseNormalized, float offset) const;
+
     juce::AudioProcessorValueTreeState& apvts; ///< Reference to the processors parameter state.
     ModulationRouter& modulationRouter;        ///< Reference to the central modulation router.
+    ModulationMatrix& modulationMatrix;        ///< Reference to the stored modulation routing.
 
     juce::RangedAudioParameter* baseParam = nullptr; ///< Pointer to the base (unmodulated) parameter.
-    juce::AudioParameterFloat* minParam = nullptr;   ///< Pointer to the minimum range parameter (_MOD_MIN).
-    juce::AudioParameterFloat* maxParam = nullptr;   ///< Pointer to the maximum range parameter (_MOD_MAX).
 
-    juce::String sourceParamID; ///< Full parameter ID for choosing the modulation source (_MOD_SOURCE).
-    juce::String indexParamID;  ///< Full parameter ID for choosing the modulation index (_MOD_INDEX).
-    juce::String minParamID;    ///< Full parameter ID for the normalized minimum modulation bound.
-    juce::String maxParamID;    ///< Full parameter ID for the normalized maximum modulation bound.
+    juce::String baseParamID; ///< ID of the modulated base parameter.
+
+    // Written from the message thread, read by the audio thread
+    std::atomic<int> currentSourceIndex{ 0 };                         ///< Last seen modulation source index.
+    std::atomic<ModulationMode> currentMode{ ModulationMode::Manual }; ///< Mode set by the router for the applied link.
+    std::atomic<float> rangeMin{ 0.0f };                              ///< Normalized lower modulation bound.
+    std::atomic<float> rangeMax{ 1.0f };                              ///< Normalized upper modulation bound.
 
-    int currentSourceIndex = 0; ///< Last seen modulation source index.
-    ModulationMode currentMode = ModulationMode::Manual; ///< Last seen modulation source mode.
-    std::pair<float, float> currentRange{ 0.0f, 1.0f };  ///< Currently cached normalized modulation range [min, max].
+    // Audio thread only
+    float automationStart = 0.0f;    ///< Normalized value at the start of the block.
+    float automationStep = 0.0f;     ///< Ramp per sample towards the host value, 0 while the parameter holds still.
+    float automationEnd = 0.0f;      ///< Normalized host value the block ends on.
+    bool automationStarted = false;  ///< True once a block recorded the host value.
 };
@@ -1,6 +1,56 @@
 ﻿#include "LFO.h"
+#include "../FastMath/FastMath.h"
+
+namespace
+{
+    /** @brief Sync choice labels, Off first. */
+    const juce::StringArray syncChoices{
+        "Off", "4/1", "2/1", "1/1", "1/2", "1/2.", "1/2T", "1/4", "1/4.", "1/4T",
+        "1/8", "1/8.", "1/8T", "1/16", "1/16.", "1/16T", "1/32"
+    };
+
+    /** @brief Length of one cycle in quarter notes per sync choice, 0 for Off. */
+    constexpr std::array<double, 17> syncQuarterNotes{
+        0.0, 16.0, 8.0, 4.0, 2.0, 3.0, 4.0 / 3.0, 1.0, 1.5, 2.0 / 3.0,
+        0.5, 0.75, 1.0 / 3.0, 0.25, 0.375, 1.0 / 6.0, 0.125
+    };
+
+    /**
+     * @brief Returns the cycle length in quarter notes of a sync choice, 0 for Off or out of range.
+     */
+    double getSyncQuarterNotes(int syncIndex)
+    {
+        return (syncIndex > 0 && syncIndex < static_cast<int>(syncQuarterNotes.size()))
+            ? syncQuarterNotes[static_cast<size_t>(syncIndex)]
+            : 0.0;
+    }
+
+    /**
+     * @brief Fills dest with kernel(phase), advancing a normalized phase and wrapping it at 1.
+     */
+    template <typename Kernel>
+    void renderPhaseKernel(float* dest, int numSamples, float& phase, float phaseDelta, Kernel&& kernel)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            dest[i] = kernel(phase);
+
+            phase += phaseDelta;
+            if (phase >= 1.0f)
+                phase -= 1.0f;
+        }
+    }
+}
 
 KnobParamSpecs LFO::getKnobParamSpecs(ParamID id, int lfoIndex)
+{
+    static const ParamSpecTable<KnobParamSpecs, ParamID, NUM_OF_LFOS> table(
+        { ParamID::Freq, ParamID::Shape, ParamID::Steps },
+        &makeKnobParamSpecs);
+    return table.get(id, lfoIndex);
+}
+
+KnobParamSpecs LFO::makeKnobParamSpecs(ParamID id, int lfoIndex)
 {
     const juce::String prefix = "LFO" + juce::String(lfoIndex + 1) + "_";
 
@@ -45,6 +95,14 @@ KnobParamSpecs LFO::getKnobParamSpecs(ParamID id, int lfoIndex)
 }
 
 ComboBoxParamSpecs LFO::getComboBoxParamSpecs(ParamID id, int lfoIndex)
+{
+    static const ParamSpecTable<ComboBoxParamSpecs, ParamID, NUM_OF_LFOS> table(
+        { ParamID::Type, ParamID::Mode, ParamID::Sync },
+        &makeComboBoxParamSpecs);
+    return table.get(id, lfoIndex);
+}
+
+ComboBoxParamSpecs LFO::makeComboBoxParamSpecs(ParamID id, int lfoIndex)
 {
     const juce::String prefix = "LFO" + juce::String(lfoIndex + 1) + "_";
     ComboBoxParamSpecs spec;
@@ -65,6 +123,14 @@ ComboBoxParamSpecs LFO::getComboBoxParamSpecs(ParamID id, int lfoIndex)
         spec.defaultIndex = static_cast<int>(Default::mode);
         break;
 
+    case ParamID::Sync:
+        spec.paramID = prefix + "SYNC";
+        spec.label = "Sync";
+        spec.choices = syncChoices;
+        spec.defaultIndex = Default::sync;
+        jassert(syncChoices.size() == static_cast<int>(syncQuarterNotes.size()));
+        break;
+
     default:
         jassertfalse;
         break;
@@ -74,6 +140,14 @@ ComboBoxParamSpecs LFO::getComboBoxParamSpecs(ParamID id, int lfoIndex)
 }
 
 std::pair<juce::String, juce::String> LFO::getToggleParamSpecs(ParamID id, int lfoIndex)
+{
+    static const ParamSpecTable<std::pair<juce::String, juce::String>, ParamID, NUM_OF_LFOS> table(
+        { ParamID::Bypass },
+        &makeToggleParamSpecs);
+    return table.get(id, lfoIndex);
+}
+
+std::pair<juce::String, juce::String> LFO::makeToggleParamSpecs(ParamID id, int lfoIndex)
 {
     const juce::String prefix = "LFO" + juce::String(lfoIndex + 1) + "_";
 
@@ -102,7 +176,7 @@ void LFO::addParameters(int lfoIndex, juce::AudioProcessorValueTreeState::Parame
     }
 
     // ComboBoxes
-    for (ParamID id : { ParamID::Type, ParamID::Mode })
+    for (ParamID id : { ParamID::Type, ParamID::Mode, ParamID::Sync })
     {
         const auto spec = getComboBoxParamSpecs(id, lfoIndex);
         layout.add(std::make_unique<juce::AudioParameterChoice>(
@@ -115,10 +189,21 @@ void LFO::addParameters(int lfoIndex, juce::AudioProcessorValueTreeState::Parame
     layout.add(std::make_unique<juce::AudioParameterBool>(bypassID, bypassLabel, Default::bypass));
 }
 
-LFO::LFO(int index)
-    : index(index)
+LFO::LFO(int index, const juce::AudioProcessorValueTreeState& apvts)
+    : index(index), stepRandom(stepSeed + static_cast<uint32_t>(index))
 {
     name = "LFO " + std::to_string(index + 1);
+
+    // Resolve parameter handles once, so the audio thread never looks IDs up by name
+    for (ParamID id : { ParamID::Freq, ParamID::Shape, ParamID::Steps })
+        handles[static_cast<size_t>(id)] = apvts.getRawParameterValue(getKnobParamSpecs(id, index).id);
+
+    for (ParamID id : { ParamID::Type, ParamID::Mode, ParamID::Sync })
+        handles[static_cast<size_t>(id)] = apvts.getRawParameterValue(getComboBoxParamSpecs(id, index).paramID);
+
+    handles[static_cast<size_t>(ParamID::Bypass)] = apvts.getRawParameterValue(getToggleParamSpecs(ParamID::Bypass, index).first);
+
+    jassert(std::all_of(handles.begin(), handles.end(), [](auto* handle) { return handle != nullptr; }));
 }
 
 const std::string& LFO::getName() const
@@ -141,6 +226,38 @@ void LFO::setMode(Mode newMode)
     mode = newMode;
 }
 
+LFO::Mode LFO::getMode() const
+{
+    return mode;
+}
+
+void LFO::setSync(int newSyncIndex)
+{
+    syncIndex = juce::jlimit(0, static_cast<int>(syncQuarterNotes.size()) - 1, newSyncIndex);
+}
+
+bool LFO::isSynced() const
+{
+    return syncIndex > 0;
+}
+
+void LFO::setTransport(const Transport& newTransport)
+{
+    transport = newTransport;
+}
+
+float LFO::getSyncedFrequency(int syncIndex, double bpm)
+{
+    const double quarterNotes = getSyncQuarterNotes(syncIndex);
+    jassert(quarterNotes > 0.0);
+    return (quarterNotes > 0.0) ? static_cast<float>(bpm / (60.0 * quarterNotes)) : 0.0f;
+}
+
+float LFO::getCurrentFrequency() const
+{
+    return isSynced() ? getSyncedFrequency(syncIndex, transport.bpm) : frequencyHz;
+}
+
 void LFO::setShape(float newShape)
 {
     shape = newShape;
@@ -164,9 +281,16 @@ void LFO::randomizeSteps()
 
     for (int i = 0; i < numSteps; ++i)
     {
-        float value = juce::Random::getSystemRandom().nextFloat(); // [0.0, 1.0]
+        float value = stepRandom.nextUnipolar(); // [0.0, 1.0)
         stepValues.push_back(value);
     }
+
+    stepGeneration.fetch_add(1, std::memory_order_release);
+}
+
+uint32_t LFO::getStepGeneration() const noexcept
+{
+    return stepGeneration.load(std::memory_order_acquire);
 }
 
 void LFO::setBypassed(bool shouldBypass)
@@ -188,33 +312,119 @@ void LFO::advance(int samplesPerBlock, float sampleRate)
         needsRetrigger = false;
     }
 
-    modulationBuffer.resize(samplesPerBlock);
-    bufferIndex = 0;
+    // A free-running synced LFO follows the song position, so a bounce lines up at any block size
+    if (isSynced() && mode == Mode::Free && transport.isPlaying)
+    {
+        const double cycles = transport.ppqPosition / getSyncQuarterNotes(syncIndex);
+        phase = static_cast<float>(cycles - std::floor(cycles));
+    }
+
+    renderFrom(0, samplesPerBlock, sampleRate);
+}
+
+void LFO::renderFrom(int startSample, int samplesPerBlock, float sampleRate)
+{
+    // The buffer is sized in prepareToPlay(), the audio thread never resizes it
+    jassert(samplesPerBlock <= static_cast<int>(modulationBuffer.size()));
+    numRendered = juce::jmin(samplesPerBlock, static_cast<int>(modulationBuffer.size()));
+
+    if (startSample >= numRendered)
+        return;
 
-    float phaseDelta = frequencyHz / sampleRate;
+    float* dest = modulationBuffer.data() + startSample;
+    const int numSamples = numRendered - startSample;
+    const float phaseDelta = getCurrentFrequency() / sampleRate;
 
-    for (int i = 0; i < samplesPerBlock; ++i)
+    // Same shapes as getValueAtPhase(), with the per-block constants hoisted out of the loop
+    switch (type)
+    {
+    case Type::Sine:
+    {
+        const float duty = juce::jlimit(0.01f, 0.99f, shape);
+        const float riseScale = juce::MathConstants<float>::pi / duty;
+        const float fallScale = juce::MathConstants<float>::pi / (1.0f - duty);
+
+        renderPhaseKernel(dest, numSamples, phase, phaseDelta, [duty, riseScale, fallScale](float p)
+            {
+                const float angle = (p < duty) ? p * riseScale
+                                               : juce::MathConstants<float>::pi + (p - duty) * fallScale;
+                return 0.5f + 0.5f * FastMath::sin(angle);
+            });
+        break;
+    }
+
+    case Type::Triangle:
+    {
+        const float skew = juce::jlimit(0.001f, 0.999f, shape);
+        const float riseScale = 1.0f / skew;
+        const float fallScale = 1.0f / (1.0f - skew);
+
+        renderPhaseKernel(dest, numSamples, phase, phaseDelta, [skew, riseScale, fallScale](float p)
+            {
+                return (p < skew) ? p * riseScale : (1.0f - p) * fallScale;
+            });
+        break;
+    }
+
+    case Type::Square:
+    {
+        const float dutyCycle = shape;
+
+        renderPhaseKernel(dest, numSamples, phase, phaseDelta, [dutyCycle](float p)
+            {
+                return p < dutyCycle ? 1.0f : 0.0f;
+            });
+        break;
+    }
+
+    case Type::Steps:
     {
-        modulationBuffer[i] = getValueAtPhase(phase);
-        phase += phaseDelta;
+        // Blend every step's ramp and random value once, the loop only indexes
+        std::array<float, maxSteps> levels{};
+        const int steps = juce::jlimit(minSteps, maxSteps, numSteps);
+        for (int step = 0; step < steps; ++step)
+        {
+            const float rampValue = static_cast<float>(step) / static_cast<float>(steps - 1);
+            const float randomValue = (step < static_cast<int>(stepValues.size())) ? stepValues[static_cast<size_t>(step)] : 0.0f;
+            levels[static_cast<size_t>(step)] = juce::jmap(shape, 0.0f, 1.0f, rampValue, randomValue);
+        }
+
+        renderPhaseKernel(dest, numSamples, phase, phaseDelta, [&levels, steps](float p)
+            {
+                const int step = juce::jlimit(0, steps - 1, static_cast<int>(p * static_cast<float>(steps)));
+                return levels[static_cast<size_t>(step)];
+            });
+        break;
+    }
 
-        if (phase >= 1.0f)
-            phase -= 1.0f;
+    default:
+        renderPhaseKernel(dest, numSamples, phase, phaseDelta, [](float) { return 0.5f; });
+        break;
     }
 }
 
-float LFO::getNextValue()
+void LFO::prepareToPlay(int samplesPerBlock)
 {
-    // If LFO is not currently modulation-active, return zero
-    if (!isModulationActive())
-        return 0.0f;
+    modulationBuffer.assign(static_cast<size_t>(samplesPerBlock), 0.0f);
+    numRendered = 0;
+}
 
-    if (modulationBuffer.empty())
-        return 0.5f; // fallback
+void LFO::setSeedOffset(uint32_t offset)
+{
+    stepRandom.setSeed(stepSeed + offset + static_cast<uint32_t>(index));
 
-    float value = modulationBuffer[bufferIndex];
-    bufferIndex = (bufferIndex + 1) % modulationBuffer.size();
-    return value;
+    if (type == Type::Steps)
+        randomizeSteps();
+}
+
+const float* LFO::getModulationBuffer() const
+{
+    return modulationBuffer.data();
+}
+
+int LFO::getModulationBufferSize() const
+{
+    return numRendered;
 }
 
 float LFO::getValueAtPhase(float phase) const
@@ -251,7 +461,7 @@ float LFO::getValueAtPhase(float phase) const
             angle = juce::jmap(localPhase, 0.0f, 1.0f, juce::MathConstants<float>::pi, juce::MathConstants<float>::twoPi);  // lower half
         }
 
-        return 0.5f + 0.5f * std::sin(angle);
+        return 0.5f + 0.5f * FastMath::sin(angle);
     }
 
 
@@ -304,33 +514,40 @@ bool LFO::isActive() const
     return isTriggered;
 }
 
-void LFO::updateFromAPVTS(juce::AudioProcessorValueTreeState& apvts)
+void LFO::updateFromParameters()
 {
-    const auto freqID = getKnobParamSpecs(ParamID::Freq, index).id;
-    const auto shapeID = getKnobParamSpecs(ParamID::Shape, index).id;
-    const auto stepsID = getKnobParamSpecs(ParamID::Steps, index).id;
-    const auto typeID = getComboBoxParamSpecs(ParamID::Type, index).paramID;
-    const auto modeID = getComboBoxParamSpecs(ParamID::Mode, index).paramID;
-    const auto bypassID = getToggleParamSpecs(ParamID::Bypass, index).first;
+    auto value = [this](ParamID id)
+        {
+            return handles[static_cast<size_t>(id)]->load();
+        };
 
-    const float freqNorm = apvts.getRawParameterValue(freqID)->load();
-    const float freqHz = FormattingUtils::normalizedToValue(
-        freqNorm,
-        FormattingUtils::FormatType::LFOFrequency,
-        FormattingUtils::lfoFreqMinHz,
-        FormattingUtils::lfoFreqMaxHz
-    );
-    setFrequency(freqHz);
+    auto modulated = [this, &value](ParamID id)
+        {
+            return ModulationTarget::apply(modulationTargets[static_cast<size_t>(id)], value(id));
+        };
 
-    setType(static_cast<Type>(static_cast<int>(*apvts.getRawParameterValue(typeID))));
-    setShape(*apvts.getRawParameterValue(shapeID));
+    // The frequency mapping is the only costly conversion, skip it when nothing moved
+    const float freqNorm = modulated(ParamID::Freq);
+    if (freqNorm != lastFreqNormalized)
+    {
+        lastFreqNormalized = freqNorm;
+        setFrequency(FormattingUtils::normalizedToValue(
+            freqNorm,
+            FormattingUtils::FormatType::LFOFrequency,
+            FormattingUtils::lfoFreqMinHz,
+            FormattingUtils::lfoFreqMaxHz
+        ));
+    }
 
-    const float stepsFloat = *apvts.getRawParameterValue(stepsID);
-    const int steps = static_cast<int>(stepsFloat);
+    setType(static_cast<Type>(static_cast<int>(value(ParamID::Type))));
+    setShape(modulated(ParamID::Shape));
+
+    const int steps = static_cast<int>(modulated(ParamID::Steps));
     setNumSteps(steps);
 
-    setMode(static_cast<Mode>(static_cast<int>(*apvts.getRawParameterValue(modeID))));
-    setBypassed(apvts.getRawParameterValue(bypassID)->load() > 0.5f);
+    setMode(static_cast<Mode>(static_cast<int>(value(ParamID::Mode))));
+    setSync(static_cast<int>(value(ParamID::Sync)));
+    setBypassed(value(ParamID::Bypass) > 0.5f);
 
     if (type == Type::Steps && static_cast<int>(stepValues.size()) != numSteps)
         randomizeSteps();
@@ -346,6 +563,20 @@ void LFO::setModulationActive(bool shouldBeActive)
     modulationActive = shouldBeActive;
 }
 
+void LFO::setModulationTarget(ParamID id, const ModulationTarget* target)
+{
+    switch (id)
+    {
+    case ParamID::Freq:
+    case ParamID::Shape:
+    case ParamID::Steps:
+        modulationTargets[static_cast<size_t>(id)] = target;
+        break;
+    default:
+        break;
+    }
+}
+
 float LFO::warpPhase(float phase, float shape)
 {
     if (shape <= 0.0f)
@@ -1,6 +1,8 @@
 ﻿#pragma once
 
 #include "../../Common.h"
+#include "../Knob/ModulationTarget.h"
+#include "../NoiseGenerator/NoiseGenerator.h"
 #include <JuceHeader.h>
 
  /**
@@ -21,6 +23,7 @@ public:
         Steps,      ///< Number of steps (Steps mode only)
         Type,       ///< LFO waveform profile
         Mode,       ///< Free-running or Retriggered
+        Sync,       ///< Tempo sync note division, Off for a free rate in Hz
         Bypass,     ///< Bypass toggle
         Count
     };
@@ -43,6 +46,17 @@ public:
         Count
     };
 
+    /**
+     * @struct Transport
+     * @brief Host tempo and position at the start of a block, read once per block by the processor.
+     */
+    struct Transport
+    {
+        double bpm = 120.0;         ///< Host tempo in beats per minute
+        double ppqPosition = 0.0;   ///< Position in quarter notes at the first sample of the block
+        bool isPlaying = false;     ///< True while the host transport runs and reports a position
+    };
+
     /**
      * @brief Centralized default values for each LFO parameter.
      */
@@ -53,6 +67,7 @@ public:
         static constexpr int steps   = 4;          ///< Default number of steps
         static constexpr Type type   = Type::Sine; ///< Default waveform type
         static constexpr Mode mode   = Mode::Free; ///< Default trigger mode
+        static constexpr int sync    = 0;          ///< Default sync division, Off
         static constexpr bool bypass = false;      ///< Default bypass state
     };
 
@@ -93,8 +108,9 @@ public:
     /**
      * @brief Constructs an LFO instance with a given index.
      * @param index The 0-based LFO index.
+     * @param apvts Parameter tree the LFO resolves its parameter handles from.
      */
-    LFO(int index);
+    LFO(int index, const juce::AudioProcessorValueTreeState& apvts);
 
     /**
      * @brief Returns the display name of the LFO.
@@ -120,6 +136,42 @@ public:
      */
     void setMode(Mode newMode);
 
+    /**
+     * @brief Returns the current phase mode.
+     * @return Free or Retrigger.
+     */
+    Mode getMode() const;
+
+    /**
+     * @brief Sets the tempo sync division.
+     * @param newSyncIndex Index into the Sync choices, 0 for Off.
+     */
+    void setSync(int newSyncIndex);
+
+    /**
+     * @brief Returns true if the rate follows the host tempo.
+     */
+    bool isSynced() const;
+
+    /**
+     * @brief Sets the host tempo and position for the coming block.
+     *
+     * A synced LFO runs at its note division of the tempo, and one in Free
+     * mode also locks its phase to the song position while the transport
+     * plays, so it lines up the same way at any block size.
+     *
+     * @param newTransport Host transport at the start of the block.
+     */
+    void setTransport(const Transport& newTransport);
+
+    /**
+     * @brief Returns the rate of a sync division at a tempo.
+     * @param syncIndex Index into the Sync choices, 1 or above.
+     * @param bpm Tempo in beats per minute.
+     * @return Frequency in Hz.
+     */
+    static float getSyncedFrequency(int syncIndex, double bpm);
+
     /**
      * @brief Sets the shape/morph parameter (0.0 – 1.0).
      * @param newShape Shape value (normalized).
@@ -137,6 +189,14 @@ public:
      */
     void randomizeSteps();
 
+    /**
+     * @brief Returns a counter bumped whenever the step values are redrawn.
+     *
+     * Lets a view tell its copy of the steps is stale when the count stayed the
+     * same, e.g. after a state restore or a new seed. Safe from any thread.
+     */
+    uint32_t getStepGeneration() const noexcept;
+
     /**
      * @brief Enables or disables the LFO output.
      * @param shouldBypass True to bypass, false to enable.
@@ -156,10 +216,39 @@ public:
     void advance(int samplesPerBlock, float sampleRate);
 
     /**
-     * @brief Returns the next LFO value from the modulation buffer.
-     * @return Normalized modulation value in [0.0, 1.0].
+     * @brief Re-renders the modulation buffer from a sample onwards, continuing from the current phase.
+     * Used after a mid-block trigger so the rest of the block follows the new phase.
+     * @param startSample First sample to render.
+     * @param samplesPerBlock Number of audio samples in the current block.
+     * @param sampleRate Host sample rate.
+     */
+    void renderFrom(int startSample, int samplesPerBlock, float sampleRate);
+
+    /**
+     * @brief Allocates the modulation buffer, so rendering never allocates.
+     * @param samplesPerBlock Largest block size expected from the host.
+     */
+    void prepareToPlay(int samplesPerBlock);
+
+    /**
+     * @brief Restarts the step randomization from the built-in seed plus an offset.
+     *
+     * Redraws the current steps, so call while the audio thread is stopped.
+     * Offset 0 is the built-in seed.
+     * @param offset Value added to the seed.
+     */
+    void setSeedOffset(uint32_t offset);
+
+    /**
+     * @brief Returns the values rendered for the current block.
+     * @return Pointer to getModulationBufferSize() normalized values.
+     */
+    const float* getModulationBuffer() const;
+
+    /**
+     * @brief Returns the number of values rendered for the current block.
      */
-    float getNextValue();
+    int getModulationBufferSize() const;
 
     /**
      * @brief Computes a single modulation value at a given phase.
@@ -196,12 +285,11 @@ public:
     bool isActive() const;
 
     /**
-     * @brief Updates the LFO’s internal parameters from the APVTS.
+     * @brief Updates the LFO’s internal parameters from the cached APVTS handles.
      * This is used to reapply the latest parameter values before calling advance().
      * Ensures that modulation reflects GUI knob changes immediately.
-     * @param apvts Reference to the processor's AudioProcessorValueTreeState.
      */
-    void updateFromAPVTS(juce::AudioProcessorValueTreeState& apvts);
+    void updateFromParameters();
 
     /**
      * @brief Returns true if the LFO should currently affect modulation output.
@@ -209,6 +297,14 @@ public:
      */
     bool isModulationActive() const;
 
+    /**
+     * @brief Assigns the modulation proxy of an LFO parameter.
+     * Only Freq, Shape and Steps are modulatable; other IDs are ignored.
+     * @param id The modulated parameter.
+     * @param target Proxy for that parameter, or nullptr to detach.
+     */
+    void setModulationTarget(ParamID id, const ModulationTarget* target);
+
     /**
      * @brief Sets whether the LFO should affect modulation output.
      * @param shouldBeActive True if LFO should affect modulated values, false to suppress output.
@@ -216,6 +312,15 @@ public:
     void setModulationActive(bool shouldBeActive);
 
 private:
+    /** @brief Builds the spec that getKnobParamSpecs() caches. */
+    static KnobParamSpecs makeKnobParamSpecs(ParamID id, int lfoIndex);
+
+    /** @brief Builds the spec that getComboBoxParamSpecs() caches. */
+    static ComboBoxParamSpecs makeComboBoxParamSpecs(ParamID id, int lfoIndex);
+
+    /** @brief Builds the spec that getToggleParamSpecs() caches. */
+    static std::pair<juce::String, juce::String> makeToggleParamSpecs(ParamID id, int lfoIndex);
+
     int index = 0;                                     ///< LFO index.
     std::string name;                                  ///< LFO name.
     bool bypassed = false;                             ///< Whether the LFO is bypassed.
@@ -223,16 +328,24 @@ private:
     bool isTriggered = false;                          ///< True if the LFO has been triggered via MIDI (Free or Retrigger mode).
     bool modulationActive = true;                      ///< True if the LFO modulation should be applied (note still held or envelope active).
     float frequencyHz = FormattingUtils::lfoFreqMinHz; ///< Current LFO frequency in Hz.
+    float lastFreqNormalized = -1.0f;                  ///< Last normalized frequency read from the parameters.
+    int syncIndex = Default::sync;                     ///< Tempo sync division, 0 for Off.
+    Transport transport;                               ///< Host transport of the current block.
     float shape = 0.5f;                                ///< Morph parameter (0.0 to 1.0), interpreted per profile.
     int numSteps = 4;                                  ///< Number of steps used when in Steps mode.
     static constexpr int minSteps = 2;                 ///< Minimum allowed number of steps in Steps mode.
     static constexpr int maxSteps = 16;                ///< Maximum allowed number of steps in Steps mode.
+    static constexpr uint32_t stepSeed = 0x4c464f31u;  ///< Step randomization seed of the first LFO, the others add their index.
     float phase = 0.0f;                                ///< Internal phase accumulator.
     Type type = Type::Sine;                            ///< Current selected waveform type.
     Mode mode = Mode::Free;                            ///< Current phase handling mode.
     std::vector<float> stepValues;                     ///< Precomputed step values used in Steps mode.
-    std::vector<float> modulationBuffer;               ///< Cached output values per block.
-    size_t bufferIndex = 0;                            ///< Read index into the modulation buffer.
+    std::atomic<uint32_t> stepGeneration{ 0 };         ///< Bumped by every randomizeSteps() call.
+    NoiseGenerator stepRandom;                         ///< Source of the step values, owned so no global generator is shared.
+    std::vector<float> modulationBuffer;               ///< Output values of the current block, sized in prepareToPlay().
+    int numRendered = 0;                               ///< Values of modulationBuffer rendered for the current block.
+    std::array<const ModulationTarget*, static_cast<size_t>(ParamID::Count)> modulationTargets{}; ///< Modulation proxies per parameter.
+    std::array<std::atomic<float>*, static_cast<size_t>(ParamID::Count)> handles{};               ///< Cached parameter handles, indexed by ParamID.
 
     /**
      * @brief Remaps a phase value to emphasize specific waveform regions.
@@ -241,4 +354,9 @@ private:
      * @return Warped phase value [0.0, 1.0]
      */
     static float warpPhase(float phase, float shape);
+
+    /**
+     * @brief Returns the rate the next render runs at, synced or free.
+     */
+    float getCurrentFrequency() const;
 };
\ No newline at end of file
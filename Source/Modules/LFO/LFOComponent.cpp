@@ -21,17 +21,13 @@ LFOComponent::~LFOComponent()
 
     typeAttachment.reset();
     modeAttachment.reset();
+    syncAttachment.reset();
     bypassAttachment.reset();
 
-    const auto freqID = LFO::getKnobParamSpecs(LFO::ParamID::Freq, index).id;
-    const auto shapeID = LFO::getKnobParamSpecs(LFO::ParamID::Shape, index).id;
-    const auto stepsID = LFO::getKnobParamSpecs(LFO::ParamID::Steps, index).id;
-    const auto typeID = LFO::getComboBoxParamSpecs(LFO::ParamID::Type, index).paramID;
-
-    apvtsRef.removeParameterListener(freqID, this);
-    apvtsRef.removeParameterListener(shapeID, this);
-    apvtsRef.removeParameterListener(stepsID, this);
-    apvtsRef.removeParameterListener(typeID, this);
+    refreshScheduler->remove(this);
+    for (auto* parameter : getGraphParameters())
+        if (parameter != nullptr)
+            parameter->removeListener(this);
 }
 
 void LFOComponent::resized()
@@ -96,7 +92,7 @@ void LFOComponent::resized()
     auto rightHalf = middleArea.reduced(rowPadding);
 
     const int selectorTotalHeight = leftHalf.getHeight();
-    const int selectorHeightEach = (selectorTotalHeight - selectorSpacing) / 2;
+    const int selectorHeightEach = (selectorTotalHeight - selectorSpacing * (numSelectorRows - 1)) / numSelectorRows;
 
     auto modeRow = leftHalf.removeFromTop(selectorHeightEach);
     modeRow.translate(0, -selectorYOffset);
@@ -110,6 +106,13 @@ void LFOComponent::resized()
     typeLabel.setBounds(typeRow.removeFromLeft(labelWidth));
     typeSelector.setBounds(typeRow.removeFromLeft(comboBoxWidth));
 
+    leftHalf.removeFromTop(selectorSpacing);
+
+    auto syncRow = leftHalf.removeFromTop(selectorHeightEach);
+    syncRow.translate(0, -selectorYOffset);
+    syncLabel.setBounds(syncRow.removeFromLeft(labelWidth));
+    syncSelector.setBounds(syncRow.removeFromLeft(comboBoxWidth));
+
     const int graphWidth = static_cast<int>(rightHalf.getWidth() * graphWidthRatioPct / 100.0f);
     const int graphHeight = rightHalf.getHeight();
     const int graphX = rightHalf.getX() + (rightHalf.getWidth() - graphWidth) / 2 + graphTranslateX;
@@ -126,7 +129,7 @@ void LFOComponent::paint(juce::Graphics& g)
     g.fillAll(UI::Colors::FilterBackground);
     g.setColour(UI::Colors::EnvelopeGraphStroke);
     g.drawRect(graphBounds, 2);
-    drawLFOGraph(g);
+    graph.draw(g);
 }
 
 void LFOComponent::updateTheme()
@@ -134,6 +137,7 @@ void LFOComponent::updateTheme()
     titleLabel.setColour(juce::Label::textColourId, UI::Colors::LFOText);
     modeLabel.setColour(juce::Label::textColourId, UI::Colors::LFOText);
     typeLabel.setColour(juce::Label::textColourId, UI::Colors::LFOText);
+    syncLabel.setColour(juce::Label::textColourId, UI::Colors::LFOText);
 
     bypassButton.setColour(juce::ToggleButton::textColourId, UI::Colors::LFOText);
     bypassButton.setColour(juce::ToggleButton::tickColourId, UI::Colors::LFOText);
@@ -141,6 +145,7 @@ void LFOComponent::updateTheme()
 
     modeSelector.updateTheme();
     typeSelector.updateTheme();
+    syncSelector.updateTheme();
 
     freqKnob.updateTheme();
     shapeKnob.updateTheme();
@@ -150,18 +155,10 @@ void LFOComponent::updateTheme()
     randomizeButton.setColour(juce::TextButton::textColourOffId, UI::Colors::LFOText);
     randomizeButton.setColour(juce::TextButton::textColourOnId, UI::Colors::LFOText);
 
+    graph.invalidateBackground();
     repaint();
 }
 
-void LFOComponent::registerModulationParameters(int index, juce::AudioProcessorValueTreeState::ParameterLayout& layout)
-{
-    for (LFO::ParamID id : { LFO::ParamID::Freq, LFO::ParamID::Shape, LFO::ParamID::Steps })
-    {
-        auto spec = LFO::getKnobParamSpecs(id, index);
-        KnobModulationEngine::registerParameters(layout, spec.id);
-    }
-}
-
 void LFOComponent::updateDynamicVisibility()
 {
     const auto selectedType = static_cast<LFO::Type>(typeSelector.getSelectedId() - 1);
@@ -169,6 +166,9 @@ void LFOComponent::updateDynamicVisibility()
 
     stepsKnob.setVisible(isSteps);
     randomizeButton.setVisible(isSteps);
+
+    // A synced rate comes from the host tempo, the frequency knob has no effect
+    freqKnob.setVisible(syncSelector.getSelectedId() <= 1);
 }
 
 void LFOComponent::initializeUI()
@@ -210,6 +210,23 @@ void LFOComponent::initializeUI()
             updateLFOGraph();
         };
 
+    syncLabel.setText("Sync:", juce::dontSendNotification);
+    syncLabel.setFont(juce::Font(UI::Fonts::defaultFontSize));
+    syncLabel.setJustificationType(juce::Justification::centredLeft);
+    addAndMakeVisible(syncLabel);
+
+    auto syncSpec = LFO::getComboBoxParamSpecs(LFO::ParamID::Sync, index);
+    for (int i = 0; i < syncSpec.choices.size(); ++i)
+        syncSelector.addItem(syncSpec.choices[i], i + 1);
+    syncSelector.setSelectedId(syncSpec.defaultIndex + 1);
+    addAndMakeVisible(syncSelector);
+    syncSelector.onChange = [this]()
+        {
+            updateDynamicVisibility();
+            resized();
+            updateLFOGraph();
+        };
+
     setupKnob(freqKnob, LFO::getKnobParamSpecs(LFO::ParamID::Freq, index));
     setupKnob(shapeKnob, LFO::getKnobParamSpecs(LFO::ParamID::Shape, index));
     setupKnob(stepsKnob, LFO::getKnobParamSpecs(LFO::ParamID::Steps, index));
@@ -227,6 +244,7 @@ void LFOComponent::initializeUI()
             if (auto* lfo = processorRef.getLFO(index))
             {
                 lfo->randomizeSteps();
+                graph.invalidatePath();
                 updateLFOGraph();
             }
         };
@@ -300,76 +318,74 @@ void LFOComponent::setupAttachments()
         typeSelector
     );
 
-    const auto freqID = LFO::getKnobParamSpecs(LFO::ParamID::Freq, index).id;
-    const auto shapeID = LFO::getKnobParamSpecs(LFO::ParamID::Shape, index).id;
-    const auto stepsID = LFO::getKnobParamSpecs(LFO::ParamID::Steps, index).id;
-    const auto typeID = LFO::getComboBoxParamSpecs(LFO::ParamID::Type, index).paramID;
+    syncAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        apvtsRef,
+        LFO::getComboBoxParamSpecs(LFO::ParamID::Sync, index).paramID,
+        syncSelector
+    );
+
+    // Changes may come from the audio thread, so listeners only raise a flag the refresh tick picks up
+    for (auto* parameter : getGraphParameters())
+        if (parameter != nullptr)
+            parameter->addListener(this);
+
+    refreshScheduler->add(this);
+}
 
-    apvtsRef.addParameterListener(freqID, this);
-    apvtsRef.addParameterListener(shapeID, this);
-    apvtsRef.addParameterListener(stepsID, this);
-    apvtsRef.addParameterListener(typeID, this);
+std::array<juce::RangedAudioParameter*, 5> LFOComponent::getGraphParameters() const
+{
+    return {
+        apvtsRef.getParameter(LFO::getKnobParamSpecs(LFO::ParamID::Freq, index).id),
+        apvtsRef.getParameter(LFO::getKnobParamSpecs(LFO::ParamID::Shape, index).id),
+        apvtsRef.getParameter(LFO::getKnobParamSpecs(LFO::ParamID::Steps, index).id),
+        apvtsRef.getParameter(LFO::getComboBoxParamSpecs(LFO::ParamID::Type, index).paramID),
+        apvtsRef.getParameter(LFO::getComboBoxParamSpecs(LFO::ParamID::Sync, index).paramID)
+    };
 }
 
 void LFOComponent::updateLFOGraph()
 {
     if (auto* lfo = processorRef.getLFO(index))
-        lfo->updateFromAPVTS(apvtsRef);
+        lfo->updateFromParameters();
 
     const auto freqID = LFO::getKnobParamSpecs(LFO::ParamID::Freq, index).id;
     const auto shapeID = LFO::getKnobParamSpecs(LFO::ParamID::Shape, index).id;
     const auto stepsID = LFO::getKnobParamSpecs(LFO::ParamID::Steps, index).id;
     const auto typeID = LFO::getComboBoxParamSpecs(LFO::ParamID::Type, index).paramID;
+    const auto syncID = LFO::getComboBoxParamSpecs(LFO::ParamID::Sync, index).paramID;
 
     const float freqNorm = apvtsRef.getRawParameterValue(freqID)->load();
     const float shape = apvtsRef.getRawParameterValue(shapeID)->load();
     const int   steps = static_cast<int>(apvtsRef.getRawParameterValue(stepsID)->load());
     const auto  type = static_cast<LFO::Type>(static_cast<int>(apvtsRef.getRawParameterValue(typeID)->load()));
 
-    const float freqHz = FormattingUtils::normalizedToValue(
-        freqNorm,
-        FormattingUtils::FormatType::LFOFrequency,
-        FormattingUtils::lfoFreqMinHz,
-        FormattingUtils::lfoFreqMaxHz
-    );
+    const int   sync = static_cast<int>(apvtsRef.getRawParameterValue(syncID)->load());
+
+    const float freqHz = (sync > 0)
+        ? LFO::getSyncedFrequency(sync, graphPreviewBpm)
+        : FormattingUtils::normalizedToValue(
+            freqNorm,
+            FormattingUtils::FormatType::LFOFrequency,
+            FormattingUtils::lfoFreqMinHz,
+            FormattingUtils::lfoFreqMaxHz
+        );
 
     graph.setParameters(type, shape, freqHz, steps);
     graph.generate();
     repaint();
 }
 
-void LFOComponent::drawLFOGraph(juce::Graphics& g)
+void LFOComponent::parameterValueChanged(int /*parameterIndex*/, float /*newValue*/)
 {
-    g.setFont(12.0f);
-
-    g.setColour(UI::Colors::EnvelopeGraphGridLines);
-    for (const auto& grid : graph.getYGridLines())
-        g.drawLine(grid.line);
-
-    g.setColour(UI::Colors::EnvelopeGraphGridText);
-    for (const auto& grid : graph.getYGridLines())
-        g.drawText(grid.label,
-            grid.labelPosition.getX(), grid.labelPosition.getY(),
-            40, 16, grid.justification);
-
-    g.setColour(UI::Colors::EnvelopeGraphGridLines);
-    for (const auto& grid : graph.getXGridLines())
-        g.drawLine(grid.line);
-
-    g.setColour(UI::Colors::EnvelopeGraphGridText);
-    for (const auto& grid : graph.getXGridLines())
-        g.drawText(grid.label,
-            grid.labelPosition.getX(), grid.labelPosition.getY(),
-            40, 16, grid.justification);
-
-    g.setColour(UI::Colors::EnvelopeGraphCurve);
-    g.strokePath(graph.getLFOPath(), juce::PathStrokeType(2.0f));
+    graphDirty.store(true, std::memory_order_release);
 }
 
-void LFOComponent::parameterChanged(const juce::String& /*paramID*/, float /*newValue*/)
+void LFOComponent::parameterGestureChanged(int /*parameterIndex*/, bool /*gestureIsStarting*/)
 {
-    juce::MessageManager::callAsync([this]
-        {
-            updateLFOGraph();
-        });
+}
+
+void LFOComponent::refresh()
+{
+    if (graphDirty.exchange(false, std::memory_order_acq_rel) || graph.isPathStale())
+        updateLFOGraph();
 }
\ No newline at end of file
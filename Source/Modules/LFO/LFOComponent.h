@@ -6,13 +6,16 @@
 #include "../../PluginProcessor.h"
 #include "./../Knob/Knob.h"
 #include "./../Combobox/Combobox.h"
+#include "./../RefreshScheduler/RefreshScheduler.h"
 #include <JuceHeader.h>
 
 /**
  * @class LFOComponent
  * @brief UI component for controlling a single LFO instance.
  */
-class LFOComponent : public juce::Component, private juce::AudioProcessorValueTreeState::Listener
+class LFOComponent : public juce::Component,
+                     private juce::AudioProcessorParameter::Listener,
+                     private RefreshScheduler::Client
 {
 public:
     /**
@@ -60,14 +63,6 @@ public:
      */
     void updateTheme();
 
-    /**
-     * @brief Registers modulation parameters for all LFO knobs at the given index.
-     * @param index LFO index.
-     * @param layout Reference to the APVTS parameter layout.
-     */
-    static void registerModulationParameters(int index,
-        juce::AudioProcessorValueTreeState::ParameterLayout& layout);
-
 
 private:
     juce::AudioProcessorValueTreeState& apvtsRef;   ///< Reference to the plugin's APVTS.
@@ -79,8 +74,10 @@ private:
     juce::ToggleButton bypassButton; ///< Toggle to bypass the LFOs output.
     juce::Label modeLabel;           ///< Label for the trigger mode selector.
     juce::Label typeLabel;           ///< Label for the waveform type selector.
+    juce::Label syncLabel;           ///< Label for the tempo sync selector.
     ComboBox modeSelector;           ///< Dropdown to select the trigger mode (Free / Retrigger).
     ComboBox typeSelector;           ///< Dropdown to select LFO waveform type.
+    ComboBox syncSelector;           ///< Dropdown to select the tempo sync division, or Off.
 
     Knob freqKnob;  ///< Knob for adjusting frequency.
     Knob shapeKnob; ///< Knob for adjusting shape/morph.
@@ -105,12 +102,15 @@ private:
     static constexpr int textBoxWidthFreq = 60;        ///< Frequency textbox width.
     static constexpr int textBoxHeightFreq = 20;       ///< Frequency textbox height.
     static constexpr int selectorSpacing = rowPadding; ///< Selector spacing.
+    static constexpr int numSelectorRows = 3;          ///< Mode, type and sync rows.
+    static constexpr double graphPreviewBpm = 120.0;   ///< Tempo the graph previews a synced rate at.
     static constexpr int selectorYOffset = 10;         ///< Selector Y offset.
     static constexpr int graphTranslateX = -5;         ///< Graph X shift.
     static constexpr int graphTranslateY = -10;        ///< Graph Y shift.
 
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> modeAttachment; ///< Attachment for mode combobox.
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> typeAttachment; ///< Attachment for type combobox.
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> syncAttachment; ///< Attachment for sync combobox.
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> bypassAttachment; ///< Attachment for bypass toggle.
 
     /**
@@ -141,12 +141,22 @@ private:
     void updateLFOGraph();
 
     /**
-     * @brief Draws the waveform curve and axis grid lines for the LFO graph.
-     * @param g Graphics context to draw into.
+     * @brief Returns the parameters the graph is drawn from.
      */
-    void drawLFOGraph(juce::Graphics& g);
+    std::array<juce::RangedAudioParameter*, 5> getGraphParameters() const;
+
+    /** @brief Marks the graph for redrawing; called on whichever thread changed the parameter. */
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+
+    /** @brief Gestures do not change the graph. */
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+
+    /** @brief Shared refresh tick, redraws the graph if a parameter changed or the LFO redrew its steps since the last one. */
+    void refresh() override;
+
+    std::atomic<bool> graphDirty{ false }; ///< Set by parameter changes, cleared when the graph is redrawn
 
-    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler; ///< Shared UI refresh tick.
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LFOComponent)
 };
\ No newline at end of file
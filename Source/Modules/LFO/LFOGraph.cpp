@@ -2,6 +2,13 @@
 
 void LFOGraph::setParameters(LFO::Type type, float shape, float freqHz, int steps)
 {
+    if (type != currentType || shape != currentShape || steps != currentSteps)
+        pathDirty = true;
+
+    // Frequency only rescales the time labels
+    if (freqHz != currentFreqHz)
+        gridDirty = true;
+
     currentType = type;
     currentShape = shape;
     currentFreqHz = freqHz;
@@ -10,25 +17,84 @@ void LFOGraph::setParameters(LFO::Type type, float shape, float freqHz, int step
 
 void LFOGraph::setGraphBounds(juce::Rectangle<int> newBounds)
 {
+    if (newBounds == bounds)
+        return;
+
     bounds = newBounds;
+    pathDirty = gridDirty = true;
 }
 
 void LFOGraph::setLFOReference(const LFO* lfoPtr)
 {
     lfo = lfoPtr;
+    pathDirty = true;
 }
 
 void LFOGraph::generate()
 {
-    lfoPath.clear();
-    xGridLines.clear();
-    yGridLines.clear();
-
     if (bounds.isEmpty() || lfo == nullptr)
+    {
+        lfoPath.clear();
+        xGridLines.clear();
+        yGridLines.clear();
+        invalidateBackground();
         return;
+    }
+
+    if (isPathStale())
+        computePath();
+
+    if (gridDirty)
+    {
+        xGridLines.clear();
+        yGridLines.clear();
 
-    // Determine graph time duration from frequency
-    const float durationSeconds = 1.0f / currentFreqHz;
+        // Determine graph time duration from frequency
+        computeYGridLines();
+        computeXGridLines(1.0f / currentFreqHz);
+
+        gridDirty = false;
+        invalidateBackground();
+    }
+}
+
+void LFOGraph::invalidatePath()
+{
+    pathDirty = true;
+}
+
+bool LFOGraph::isPathStale() const
+{
+    // A restored or reseeded patch redraws the steps without changing their count
+    return pathDirty || (lfo != nullptr && lfo->getStepGeneration() != pathStepGeneration);
+}
+
+void LFOGraph::invalidateBackground()
+{
+    backgroundImage = {};
+}
+
+void LFOGraph::draw(juce::Graphics& g)
+{
+    generate();
+
+    if (lfoPath.isEmpty())
+        return;
+
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (backgroundImage.isNull() || scale != backgroundScale)
+        renderBackground(scale);
+
+    g.drawImage(backgroundImage, backgroundArea.toFloat());
+
+    g.setColour(UI::Colors::EnvelopeGraphCurve);
+    g.strokePath(lfoPath, juce::PathStrokeType(curveThickness));
+}
+
+void LFOGraph::computePath()
+{
+    lfoPath.clear();
+    pathStepGeneration = lfo->getStepGeneration();
 
     // Precompute Y scaling with padding
     const float yMin = -yGraphPadding;
@@ -54,9 +120,46 @@ void LFOGraph::generate()
         lfoPath.lineTo(x, y);
     }
 
-    // Generate fixed grid lines
-    computeYGridLines();
-    computeXGridLines(durationSeconds);
+    pathDirty = false;
+}
+
+void LFOGraph::renderBackground(float scale)
+{
+    // Labels sit outside the plot, so the layer covers them too
+    backgroundArea = bounds;
+    for (const auto* lines : { &xGridLines, &yGridLines })
+        for (const auto& grid : *lines)
+            backgroundArea = backgroundArea.getUnion({ grid.labelPosition.getX(), grid.labelPosition.getY(), labelWidth, labelHeight });
+
+    backgroundScale = scale;
+    backgroundImage = juce::Image(juce::Image::ARGB,
+        juce::jmax(1, juce::roundToInt(backgroundArea.getWidth() * scale)),
+        juce::jmax(1, juce::roundToInt(backgroundArea.getHeight() * scale)),
+        true);
+
+    juce::Graphics imageGraphics(backgroundImage);
+    imageGraphics.addTransform(juce::AffineTransform::translation(static_cast<float>(-backgroundArea.getX()),
+                                                                  static_cast<float>(-backgroundArea.getY()))
+                                   .scaled(scale));
+    drawGrid(imageGraphics);
+}
+
+void LFOGraph::drawGrid(juce::Graphics& g) const
+{
+    g.setFont(labelFontSize);
+
+    for (const auto* lines : { &yGridLines, &xGridLines })
+    {
+        g.setColour(UI::Colors::EnvelopeGraphGridLines);
+        for (const auto& grid : *lines)
+            g.drawLine(grid.line);
+
+        g.setColour(UI::Colors::EnvelopeGraphGridText);
+        for (const auto& grid : *lines)
+            g.drawText(grid.label,
+                grid.labelPosition.getX(), grid.labelPosition.getY(),
+                labelWidth, labelHeight, grid.justification);
+    }
 }
 
 const juce::Path& LFOGraph::getLFOPath() const
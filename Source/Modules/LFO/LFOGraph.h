@@ -6,6 +6,11 @@
 /**
  * @class LFOGraph
  * @brief Renders a visual waveform representation of the LFO.
+ *
+ * The grid and its labels are drawn once into a cached image that is only
+ * rebuilt when the bounds, the frequency labels or the theme change. The
+ * waveform path is only rebuilt when the waveform itself changes, including
+ * the LFO redrawing its steps behind an unchanged step count.
  */
 class LFOGraph
 {
@@ -43,11 +48,32 @@ public:
     void setLFOReference(const LFO* lfoPtr);
 
     /**
-     * @brief Regenerates the waveform path and grid lines.
-     * Should be called after setting new parameters, LFO reference, or bounds.
+     * @brief Regenerates whatever the last parameter, reference or bounds change invalidated.
+     * Cheap when nothing changed.
      */
     void generate();
 
+    /**
+     * @brief Forces the waveform path to be rebuilt, e.g. after the LFO's steps were randomized.
+     */
+    void invalidatePath();
+
+    /**
+     * @brief Returns true if the next generate() rebuilds the path, also when the LFO redrew its steps since.
+     */
+    bool isPathStale() const;
+
+    /**
+     * @brief Drops the cached grid image so it is redrawn with the current theme colours.
+     */
+    void invalidateBackground();
+
+    /**
+     * @brief Draws the cached grid layer and the waveform.
+     * @param g Graphics context to draw into.
+     */
+    void draw(juce::Graphics& g);
+
     /**
      * @brief Returns the waveform path for rendering.
      * @return A const reference to the juce::Path representing the waveform.
@@ -81,6 +107,35 @@ private:
     std::vector<GridLine> yGridLines; ///< Y-axis grid lines and their labels.
     float yGraphPadding = 0.05f;     ///< Extra vertical padding added to the graph's Y-axis range.
 
+    bool pathDirty = true;            ///< True when the waveform path must be rebuilt.
+    uint32_t pathStepGeneration = 0;  ///< LFO step generation the path was built from.
+    bool gridDirty = true;            ///< True when the grid lines must be recomputed.
+    juce::Image backgroundImage;      ///< Cached grid and labels, null when invalid.
+    juce::Rectangle<int> backgroundArea; ///< Area covered by backgroundImage, labels included.
+    float backgroundScale = 1.0f;     ///< Physical pixel scale backgroundImage was rendered at.
+
+    static constexpr int labelWidth = 40;      ///< Width of a grid label box.
+    static constexpr int labelHeight = 16;     ///< Height of a grid label box.
+    static constexpr float labelFontSize = 12.0f; ///< Font size of grid labels.
+    static constexpr float curveThickness = 2.0f; ///< Stroke width of the waveform.
+
+    /**
+     * @brief Rebuilds the waveform path.
+     */
+    void computePath();
+
+    /**
+     * @brief Renders the grid lines and labels into backgroundImage.
+     * @param scale Physical pixels per logical pixel of the target context.
+     */
+    void renderBackground(float scale);
+
+    /**
+     * @brief Draws the grid lines and labels.
+     * @param g Graphics context to draw into.
+     */
+    void drawGrid(juce::Graphics& g) const;
+
     /**
      * @brief Computes and stores vertical grid lines.
      */
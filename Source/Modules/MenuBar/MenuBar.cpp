@@ -1,11 +1,40 @@
 #include "MenuBar.h"
 
+namespace
+{
+    /** @brief Glide times offered by the Voices menu, in milliseconds. */
+    constexpr std::array<int, 8> glideMenuTimesMs{ 0, 25, 50, 100, 200, 400, 800, 1600 };
+
+    /** @brief Release micro-fades offered by the Voices menu, in milliseconds. */
+    constexpr std::array<float, 6> releaseFadeMenuTimesMs{ 0.0f, 1.0f, 2.0f, 5.0f, 10.0f, 20.0f };
+
+    /** @brief Cross-modulation depths offered by the Voices menu. */
+    constexpr std::array<float, 5> crossAmountMenuValues{ 0.1f, 0.25f, 0.5f, 0.75f, 1.0f };
+
+    /** @brief Gates offered by the Arp menu, as fractions of a step. */
+    constexpr std::array<float, 6> arpGateMenuValues{ 0.1f, 0.25f, 0.5f, 0.75f, 0.9f, 1.0f };
+
+    /** @brief Sequencer lengths offered by the Arp menu. */
+    constexpr std::array<int, 7> arpStepMenuCounts{ 2, 3, 4, 6, 8, 12, 16 };
+
+    /** @brief UDP ports offered by the Remote menu, the usual show-control defaults. */
+    constexpr std::array<int, 4> remoteMenuPorts{ 8000, 9000, 9001, 57120 };
+}
+
 MenuBar::MenuBar(DigitalSynthesizerAudioProcessor& processorRef)
     : processor(processorRef)
 {
     tabs.push_back(createProjectTab());
     tabs.push_back(createThemeTab());
     tabs.push_back(createPresetsTab());
+    tabs.push_back(createVoicesTab());
+    tabs.push_back(createArpTab());
+    tabs.push_back(createWavetablesTab());
+    tabs.push_back(createRemoteTab());
+    tabs.push_back(createStatsTab());
+#if STAGE_PROFILING
+    tabs.push_back(createProfilerTab());
+#endif
 
     setLookAndFeel(&themedLookAndFeel);
     setModel(this);
@@ -44,6 +73,11 @@ void MenuBar::setOnThemeChanged(std::function<void()> callback)
     onThemeChanged = std::move(callback);
 }
 
+void MenuBar::setGpuRenderer(GpuRenderer* renderer)
+{
+    gpuRenderer = renderer;
+}
+
 int MenuBar::getHeight()
 {
     return height;
@@ -66,34 +100,81 @@ void MenuBar::updateTheme()
 MenuBar::Tab MenuBar::createProjectTab()
 {
     constexpr int AboutItem = 1;
+    constexpr int AdaptiveQualityItem = 2;
+    constexpr int OfflineQualityItem = 3;
+    constexpr int NoteCacheItem = 4;
+    constexpr int MultiCoreItem = 5;
 
     return {
         "Digital Synthesizer",
-        [AboutItem] {
+        [this, AboutItem, AdaptiveQualityItem, OfflineQualityItem, NoteCacheItem, MultiCoreItem] {
             juce::PopupMenu menu;
+            menu.addItem(AdaptiveQualityItem, "Reduce Quality Under Load", true,
+                         processor.getQualityGovernor().isEnabled());
+            menu.addItem(OfflineQualityItem, "High Quality Offline Renders", true,
+                         processor.getQualityGovernor().isHighQualityOffline());
+            menu.addItem(NoteCacheItem, "Cache Static Notes", true, processor.isNoteRenderCacheEnabled());
+            menu.addItem(MultiCoreItem, "Render Oscillators on Multiple Cores",
+                         RenderPool::getRecommendedWorkerCount(NUM_OF_OSCILLATORS - 1) > 0,
+                         processor.isMultiCoreRenderingEnabled());
+            menu.addSeparator();
             menu.addItem(AboutItem, "About");
             return menu;
         },
-        [AboutItem](int menuItemID) {
+        [this, AboutItem, AdaptiveQualityItem, OfflineQualityItem, NoteCacheItem, MultiCoreItem](int menuItemID) {
             if (menuItemID == AboutItem)
             {
                 juce::URL(projectUrl).launchInDefaultBrowser();
             }
+            else if (menuItemID == AdaptiveQualityItem)
+            {
+                auto& governor = processor.getQualityGovernor();
+                governor.setEnabled(!governor.isEnabled());
+            }
+            else if (menuItemID == OfflineQualityItem)
+            {
+                auto& governor = processor.getQualityGovernor();
+                governor.setHighQualityOffline(!governor.isHighQualityOffline());
+            }
+            else if (menuItemID == NoteCacheItem)
+            {
+                processor.setNoteRenderCacheEnabled(!processor.isNoteRenderCacheEnabled());
+            }
+            else if (menuItemID == MultiCoreItem)
+            {
+                processor.setMultiCoreRenderingEnabled(!processor.isMultiCoreRenderingEnabled());
+            }
         }
     };
 }
 
 MenuBar::Tab MenuBar::createThemeTab()
 {
+    constexpr int GpuRenderingItem = 1000; // Above every theme ID
+
     return {
         "Theme",
-        [] {
+        [this, GpuRenderingItem] {
             juce::PopupMenu menu;
             for (const auto& [id, name] : UI::Colors::getAvailableThemeNames())
                 menu.addItem(id, name);
+
+            menu.addSeparator();
+            menu.addItem(GpuRenderingItem, "GPU Rendering", GpuRenderer::isSupported() && gpuRenderer != nullptr,
+                         gpuRenderer != nullptr && gpuRenderer->isEnabled());
             return menu;
         },
-        [this](int menuItemID) {
+        [this, GpuRenderingItem](int menuItemID) {
+            if (menuItemID == GpuRenderingItem)
+            {
+                if (gpuRenderer != nullptr)
+                {
+                    gpuRenderer->setEnabled(!gpuRenderer->isEnabled());
+                    processor.getAPVTS().state.setProperty("openGLRendering", gpuRenderer->isEnabled(), nullptr);
+                }
+                return;
+            }
+
             UI::Colors::applyThemeByID(menuItemID);
             updateTheme();
             if (onThemeChanged)
@@ -115,6 +196,11 @@ MenuBar::Tab MenuBar::createPresetsTab()
             menu.addSeparator();
             menu.addItem(PresetLoad, "Load");
             menu.addItem(PresetSave, "Save");
+            menu.addSeparator();
+            menu.addItem(PresetPrevious, "Previous");
+            menu.addItem(PresetNext, "Next");
+            menu.addSeparator();
+            menu.addItem(PresetFolder, "Choose Folder...");
             return menu;
         },
         [this](int menuItemID) {
@@ -131,7 +217,411 @@ MenuBar::Tab MenuBar::createPresetsTab()
                 case PresetSave:
                     processor.getPresetManager()->showSaveDialogBox();
                     break;
+
+                case PresetPrevious:
+                    processor.getPresetManager()->stepPreset(-1);
+                    break;
+
+                case PresetNext:
+                    processor.getPresetManager()->stepPreset(1);
+                    break;
+
+                case PresetFolder:
+                    processor.getPresetManager()->showChooseFolderDialogBox();
+                    break;
+            }
+        }
+    };
+}
+
+MenuBar::Tab MenuBar::createVoicesTab()
+{
+    return {
+        "Voices",
+        [this] {
+            auto& apvts = processor.getAPVTS();
+            const auto polyphonySpec = VoiceAllocator::getPolyphonyParamSpecs();
+            const auto policySpec = VoiceAllocator::getStealPolicyParamSpecs();
+            const auto modeSpec = VoiceAllocator::getVoiceModeParamSpecs();
+            const auto glideSpec = VoiceAllocator::getGlideParamSpecs();
+            const auto fadeSpec = VoiceAllocator::getReleaseFadeParamSpecs();
+
+            const int polyphony = static_cast<int>(apvts.getRawParameterValue(polyphonySpec.id)->load());
+            const int policy = static_cast<int>(apvts.getRawParameterValue(policySpec.paramID)->load());
+            const int mode = static_cast<int>(apvts.getRawParameterValue(modeSpec.paramID)->load());
+            const int glideMs = juce::roundToInt(apvts.getRawParameterValue(glideSpec.id)->load());
+            const float fadeMs = apvts.getRawParameterValue(fadeSpec.id)->load();
+
+            juce::PopupMenu modeMenu;
+            for (int i = 0; i < modeSpec.choices.size(); ++i)
+                modeMenu.addItem(VoicesMode + i, modeSpec.choices[i], true, i == mode);
+
+            juce::PopupMenu glideMenu;
+            for (size_t i = 0; i < glideMenuTimesMs.size(); ++i)
+            {
+                const int timeMs = glideMenuTimesMs[i];
+                glideMenu.addItem(VoicesGlide + static_cast<int>(i), timeMs == 0 ? juce::String("Off") : juce::String(timeMs) + " ms",
+                    true, timeMs == glideMs);
+            }
+
+            juce::PopupMenu fadeMenu;
+            for (size_t i = 0; i < releaseFadeMenuTimesMs.size(); ++i)
+            {
+                const float timeMs = releaseFadeMenuTimesMs[i];
+                fadeMenu.addItem(VoicesReleaseFade + static_cast<int>(i), timeMs == 0.0f ? juce::String("Off") : juce::String(timeMs, 0) + " ms",
+                    true, std::abs(timeMs - fadeMs) < 0.05f);
+            }
+
+            juce::PopupMenu polyphonyMenu;
+            for (const int voices : { 1, 2, 4, 6, 8, 12, 16 })
+            {
+                if (voices <= VoiceAllocator::maxPolyphony)
+                    polyphonyMenu.addItem(VoicesPolyphony + voices, juce::String(voices), true, voices == polyphony);
+            }
+
+            juce::PopupMenu policyMenu;
+            for (int i = 0; i < policySpec.choices.size(); ++i)
+                policyMenu.addItem(VoicesStealPolicy + i, policySpec.choices[i], true, i == policy);
+
+            juce::PopupMenu menu;
+            menu.addSubMenu(polyphonySpec.name, polyphonyMenu);
+            menu.addSubMenu(policySpec.label, policyMenu);
+            menu.addSubMenu(fadeSpec.name, fadeMenu);
+            menu.addSeparator();
+            menu.addSubMenu(modeSpec.label, modeMenu);
+            menu.addSubMenu(glideSpec.name, glideMenu);
+            menu.addSeparator();
+
+            // How each oscillator runs through the filters linked to it
+            for (int osc = 0; osc < NUM_OF_OSCILLATORS; ++osc)
+            {
+                const auto routingSpec = Oscillator::getComboBoxParamSpecs(Oscillator::ParamID::FilterRouting, osc);
+                const int routing = static_cast<int>(apvts.getRawParameterValue(routingSpec.paramID)->load());
+
+                juce::PopupMenu routingMenu;
+                for (int i = 0; i < routingSpec.choices.size(); ++i)
+                    routingMenu.addItem(VoicesFilterRouting + osc * 10 + i, routingSpec.choices[i], true, i == routing);
+
+                menu.addSubMenu(Oscillator::getDefaultLinkableName(osc) + " " + routingSpec.label, routingMenu);
+            }
+            menu.addSeparator();
+
+            // Each oscillator after the first can be modulated by the one before it
+            for (int osc = 1; osc < NUM_OF_OSCILLATORS; ++osc)
+            {
+                const auto crossModSpec = Oscillator::getComboBoxParamSpecs(Oscillator::ParamID::CrossMod, osc);
+                const auto amountSpec = Oscillator::getKnobParamSpecs(Oscillator::ParamID::CrossAmount, osc);
+                const int crossMod = static_cast<int>(apvts.getRawParameterValue(crossModSpec.paramID)->load());
+                const float amount = apvts.getRawParameterValue(amountSpec.id)->load();
+
+                juce::PopupMenu crossModMenu;
+                for (int i = 0; i < crossModSpec.choices.size(); ++i)
+                    crossModMenu.addItem(VoicesCrossMod + osc * 20 + i, crossModSpec.choices[i], true, i == crossMod);
+
+                crossModMenu.addSeparator();
+                for (size_t i = 0; i < crossAmountMenuValues.size(); ++i)
+                {
+                    const float value = crossAmountMenuValues[i];
+                    crossModMenu.addItem(VoicesCrossMod + osc * 20 + 10 + static_cast<int>(i),
+                        juce::String(juce::roundToInt(value * 100.0f)) + "%", crossMod != 0, std::abs(value - amount) < 0.005f);
+                }
+
+                menu.addSubMenu(Oscillator::getDefaultLinkableName(osc) + " " + crossModSpec.label + " by "
+                                + Oscillator::getDefaultLinkableName(osc - 1), crossModMenu);
+            }
+            return menu;
+        },
+        [this](int menuItemID) {
+            auto& apvts = processor.getAPVTS();
+
+            const auto setValue = [&apvts](const juce::String& paramID, float value)
+                {
+                    if (auto* param = apvts.getParameter(paramID))
+                        param->setValueNotifyingHost(param->convertTo0to1(value));
+                };
+
+            if (menuItemID >= VoicesCrossMod)
+            {
+                const int osc = (menuItemID - VoicesCrossMod) / 20;
+                const int item = (menuItemID - VoicesCrossMod) % 20;
+                if (osc < 1 || osc >= NUM_OF_OSCILLATORS)
+                    return;
+
+                if (item < 10)
+                    setValue(Oscillator::getComboBoxParamSpecs(Oscillator::ParamID::CrossMod, osc).paramID, static_cast<float>(item));
+                else if (static_cast<size_t>(item - 10) < crossAmountMenuValues.size())
+                    setValue(Oscillator::getKnobParamSpecs(Oscillator::ParamID::CrossAmount, osc).id,
+                             crossAmountMenuValues[static_cast<size_t>(item - 10)]);
+            }
+            else if (menuItemID >= VoicesFilterRouting)
+            {
+                const int osc = (menuItemID - VoicesFilterRouting) / 10;
+                if (osc < NUM_OF_OSCILLATORS)
+                    setValue(Oscillator::getComboBoxParamSpecs(Oscillator::ParamID::FilterRouting, osc).paramID,
+                             static_cast<float>((menuItemID - VoicesFilterRouting) % 10));
+            }
+            else if (menuItemID >= VoicesReleaseFade)
+            {
+                const auto index = static_cast<size_t>(menuItemID - VoicesReleaseFade);
+                if (index < releaseFadeMenuTimesMs.size())
+                    setValue(VoiceAllocator::getReleaseFadeParamSpecs().id, releaseFadeMenuTimesMs[index]);
+            }
+            else if (menuItemID >= VoicesGlide)
+            {
+                const auto index = static_cast<size_t>(menuItemID - VoicesGlide);
+                if (index < glideMenuTimesMs.size())
+                    setValue(VoiceAllocator::getGlideParamSpecs().id, static_cast<float>(glideMenuTimesMs[index]));
+            }
+            else if (menuItemID >= VoicesMode)
+                setValue(VoiceAllocator::getVoiceModeParamSpecs().paramID, static_cast<float>(menuItemID - VoicesMode));
+            else if (menuItemID >= VoicesStealPolicy)
+                setValue(VoiceAllocator::getStealPolicyParamSpecs().paramID, static_cast<float>(menuItemID - VoicesStealPolicy));
+            else if (menuItemID > VoicesPolyphony)
+                setValue(VoiceAllocator::getPolyphonyParamSpecs().id, static_cast<float>(menuItemID - VoicesPolyphony));
+        }
+    };
+}
+
+MenuBar::Tab MenuBar::createArpTab()
+{
+    return {
+        "Arp",
+        [this] {
+            auto& apvts = processor.getAPVTS();
+            const auto modeSpec = Arpeggiator::getModeParamSpecs();
+            const auto rateSpec = Arpeggiator::getRateParamSpecs();
+            const auto octavesSpec = Arpeggiator::getOctavesParamSpecs();
+            const auto gateSpec = Arpeggiator::getGateParamSpecs();
+            const auto stepsSpec = Arpeggiator::getNumStepsParamSpecs();
+
+            const int mode = static_cast<int>(apvts.getRawParameterValue(modeSpec.paramID)->load());
+            const int rate = static_cast<int>(apvts.getRawParameterValue(rateSpec.paramID)->load());
+            const int octaves = static_cast<int>(apvts.getRawParameterValue(octavesSpec.id)->load());
+            const float gate = apvts.getRawParameterValue(gateSpec.id)->load();
+            const int steps = static_cast<int>(apvts.getRawParameterValue(stepsSpec.id)->load());
+
+            juce::PopupMenu modeMenu;
+            for (int i = 0; i < modeSpec.choices.size(); ++i)
+                modeMenu.addItem(ArpMode + i, modeSpec.choices[i], true, i == mode);
+
+            juce::PopupMenu rateMenu;
+            for (int i = 0; i < rateSpec.choices.size(); ++i)
+                rateMenu.addItem(ArpRate + i, rateSpec.choices[i], true, i == rate);
+
+            juce::PopupMenu octavesMenu;
+            for (int i = 1; i <= Arpeggiator::maxOctaves; ++i)
+                octavesMenu.addItem(ArpOctaves + i, juce::String(i), true, i == octaves);
+
+            juce::PopupMenu gateMenu;
+            for (size_t i = 0; i < arpGateMenuValues.size(); ++i)
+            {
+                const float value = arpGateMenuValues[i];
+                gateMenu.addItem(ArpGate + static_cast<int>(i), juce::String(juce::roundToInt(value * 100.0f)) + "%",
+                    true, std::abs(value - gate) < 0.005f);
+            }
+
+            juce::PopupMenu stepsMenu;
+            for (size_t i = 0; i < arpStepMenuCounts.size(); ++i)
+                stepsMenu.addItem(ArpSteps + static_cast<int>(i), juce::String(arpStepMenuCounts[i]), true, arpStepMenuCounts[i] == steps);
+
+            juce::PopupMenu menu;
+            menu.addSubMenu(modeSpec.label, modeMenu);
+            menu.addSubMenu(rateSpec.label, rateMenu);
+            menu.addSubMenu(octavesSpec.name, octavesMenu);
+            menu.addSubMenu(gateSpec.name, gateMenu);
+            menu.addSeparator();
+            menu.addSubMenu(stepsSpec.name, stepsMenu);
+            return menu;
+        },
+        [this](int menuItemID) {
+            auto& apvts = processor.getAPVTS();
+
+            const auto setValue = [&apvts](const juce::String& paramID, float value)
+                {
+                    if (auto* param = apvts.getParameter(paramID))
+                        param->setValueNotifyingHost(param->convertTo0to1(value));
+                };
+
+            if (menuItemID >= ArpSteps)
+            {
+                const auto index = static_cast<size_t>(menuItemID - ArpSteps);
+                if (index < arpStepMenuCounts.size())
+                    setValue(Arpeggiator::getNumStepsParamSpecs().id, static_cast<float>(arpStepMenuCounts[index]));
+            }
+            else if (menuItemID >= ArpGate)
+            {
+                const auto index = static_cast<size_t>(menuItemID - ArpGate);
+                if (index < arpGateMenuValues.size())
+                    setValue(Arpeggiator::getGateParamSpecs().id, arpGateMenuValues[index]);
+            }
+            else if (menuItemID > ArpOctaves)
+                setValue(Arpeggiator::getOctavesParamSpecs().id, static_cast<float>(menuItemID - ArpOctaves));
+            else if (menuItemID >= ArpRate)
+                setValue(Arpeggiator::getRateParamSpecs().paramID, static_cast<float>(menuItemID - ArpRate));
+            else if (menuItemID >= ArpMode)
+                setValue(Arpeggiator::getModeParamSpecs().paramID, static_cast<float>(menuItemID - ArpMode));
+        }
+    };
+}
+
+MenuBar::Tab MenuBar::createWavetablesTab()
+{
+    return {
+        "Wavetables",
+        [this] {
+            juce::PopupMenu menu;
+            for (int osc = 0; osc < NUM_OF_OSCILLATORS; ++osc)
+            {
+                const auto source = processor.getUserWavetableFile(osc);
+
+                menu.addSectionHeader(Oscillator::getDefaultLinkableName(osc));
+                menu.addItem(WavetableImport + osc, source == juce::File() ? juce::String("Import...")
+                                                                           : source.getFileName() + " - Import...");
+                menu.addItem(WavetableClear + osc, "Clear", source != juce::File());
+            }
+
+            menu.addSeparator();
+            menu.addItem(WavetableShowCache, "Show Cache Folder");
+            return menu;
+        },
+        [this](int menuItemID) {
+            if (menuItemID >= WavetableClear)
+            {
+                processor.clearUserWavetable(menuItemID - WavetableClear);
+            }
+            else if (menuItemID >= WavetableImport)
+            {
+                const int osc = menuItemID - WavetableImport;
+                if (osc >= NUM_OF_OSCILLATORS)
+                    return;
+
+                wavetableChooser = std::make_unique<juce::FileChooser>("Import Wavetable",
+                    juce::File::getSpecialLocation(juce::File::userDocumentsDirectory), "*.wav;*.aif;*.aiff;*.flac");
+
+                wavetableChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                    [this, osc](const juce::FileChooser& chooser)
+                    {
+                        const auto file = chooser.getResult();
+                        if (file.existsAsFile())
+                            processor.loadUserWavetable(osc, file);
+                    });
+            }
+            else if (menuItemID == WavetableShowCache)
+            {
+                const auto folder = UserWavetableLibrary::getCacheFolder();
+                folder.createDirectory();
+                folder.revealToUser();
+            }
+        }
+    };
+}
+
+MenuBar::Tab MenuBar::createRemoteTab()
+{
+    return {
+        "Remote",
+        [this] {
+            juce::PopupMenu menu;
+            const bool supported = OscRemoteControl::isSupported();
+            const int port = processor.getRemoteControlPort();
+
+            menu.addSectionHeader("OSC: " + juce::String(OscRemoteControl::addressPrefix) + "/<PARAM_ID>[/value]");
+            menu.addItem(RemoteOff, "Off", supported, port == 0);
+
+            for (size_t i = 0; i < remoteMenuPorts.size(); ++i)
+                menu.addItem(RemotePort + static_cast<int>(i), "UDP Port " + juce::String(remoteMenuPorts[i]),
+                             supported, port == remoteMenuPorts[i]);
+
+            return menu;
+        },
+        [this](int menuItemID) {
+            if (menuItemID == RemoteOff)
+                processor.setRemoteControlPort(0);
+            else if (juce::isPositiveAndBelow(menuItemID - RemotePort, static_cast<int>(remoteMenuPorts.size())))
+                processor.setRemoteControlPort(remoteMenuPorts[static_cast<size_t>(menuItemID - RemotePort)]);
+        }
+    };
+}
+
+void MenuBar::setEngineStatsOverlay(juce::Component* overlay)
+{
+    engineStatsOverlay = overlay;
+}
+
+MenuBar::Tab MenuBar::createStatsTab()
+{
+    return {
+        "Stats",
+        [this] {
+            juce::PopupMenu menu;
+            menu.addItem(StatsOverlay, "Show Overlay", engineStatsOverlay != nullptr,
+                         engineStatsOverlay != nullptr && engineStatsOverlay->isVisible());
+            menu.addItem(StatsWriteToLog, "Write to Log");
+            menu.addItem(StatsResetPeaks, "Reset Peaks");
+            return menu;
+        },
+        [this](int menuItemID) {
+            switch (menuItemID)
+            {
+                case StatsOverlay:
+                    if (engineStatsOverlay != nullptr)
+                        engineStatsOverlay->setVisible(!engineStatsOverlay->isVisible());
+                    break;
+
+                case StatsWriteToLog:
+                    processor.getEngineStats().writeToLog();
+                    break;
+
+                case StatsResetPeaks:
+                    processor.getEngineStats().resetPeaks();
+                    break;
             }
         }
     };
-}
\ No newline at end of file
+}
+
+#if STAGE_PROFILING
+void MenuBar::setProfilerOverlay(juce::Component* overlay)
+{
+    profilerOverlay = overlay;
+}
+
+MenuBar::Tab MenuBar::createProfilerTab()
+{
+    return {
+        "Profiler",
+        [this] {
+            juce::PopupMenu menu;
+            menu.addItem(ProfilerOverlay, "Show Overlay", profilerOverlay != nullptr,
+                         profilerOverlay != nullptr && profilerOverlay->isVisible());
+            menu.addItem(ProfilerSaveTrace, "Save Chrome Trace...");
+            return menu;
+        },
+        [this](int menuItemID) {
+            switch (menuItemID)
+            {
+                case ProfilerOverlay:
+                    if (profilerOverlay != nullptr)
+                        profilerOverlay->setVisible(!profilerOverlay->isVisible());
+                    break;
+
+                case ProfilerSaveTrace:
+                {
+                    const auto defaultFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                        .getChildFile("DigitalSynthesizerTrace.json");
+                    traceChooser = std::make_unique<juce::FileChooser>("Save Chrome Trace", defaultFile, "*.json");
+
+                    traceChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting,
+                        [this](const juce::FileChooser& chooser)
+                        {
+                            const auto file = chooser.getResult();
+                            if (file != juce::File())
+                                processor.getStageProfiler().writeChromeTrace(file);
+                        });
+                    break;
+                }
+            }
+        }
+    };
+}
+#endif
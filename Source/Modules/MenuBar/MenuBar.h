@@ -2,6 +2,7 @@
 
 #include "../../Common.h"
 #include "../../PluginProcessor.h"
+#include "../GpuRendering/GpuRenderer.h"
 #include <JuceHeader.h>
 
 /**
@@ -66,6 +67,26 @@ public:
      */
     void updateTheme();
 
+    /**
+     * @brief Sets the editor's OpenGL renderer the Theme tab toggles.
+     * @param renderer The editor's renderer, or nullptr.
+     */
+    void setGpuRenderer(GpuRenderer* renderer);
+
+    /**
+     * @brief Sets the overlay the Stats tab shows and hides.
+     * @param overlay The editor's engine stats overlay, or nullptr.
+     */
+    void setEngineStatsOverlay(juce::Component* overlay);
+
+#if STAGE_PROFILING
+    /**
+     * @brief Sets the overlay the Profiler tab shows and hides.
+     * @param overlay The editor's profiler overlay, or nullptr.
+     */
+    void setProfilerOverlay(juce::Component* overlay);
+#endif
+
 private:
     DigitalSynthesizerAudioProcessor& processor; ///< Reference to the audio processor.
 
@@ -76,9 +97,95 @@ private:
     {
         PresetInit = 1,
         PresetLoad,
-        PresetSave
+        PresetSave,
+        PresetPrevious,
+        PresetNext,
+        PresetFolder
+    };
+
+    /**
+     * @brief Menu ID ranges of the Voices tab, offset by the polyphony or the policy index.
+     *
+     * Filter routing items are offset by ten per oscillator plus the choice,
+     * cross-modulation items by twenty per oscillator plus the choice, or ten
+     * plus the amount's index.
+     */
+    enum VoicesMenuItemIDs
+    {
+        VoicesPolyphony = 100,
+        VoicesStealPolicy = 200,
+        VoicesMode = 300,
+        VoicesGlide = 400,
+        VoicesReleaseFade = 500,
+        VoicesFilterRouting = 600,
+        VoicesCrossMod = 700
+    };
+
+    /**
+     * @brief Menu ID ranges of the Arp tab, offset by the choice or the value's index.
+     */
+    enum ArpMenuItemIDs
+    {
+        ArpMode = 100,
+        ArpRate = 200,
+        ArpOctaves = 300,
+        ArpGate = 400,
+        ArpSteps = 500
     };
 
+    /**
+     * @brief Menu ID ranges of the Wavetables tab, offset by the oscillator index.
+     */
+    enum WavetableMenuItemIDs
+    {
+        WavetableShowCache = 1,
+        WavetableImport = 100,
+        WavetableClear = 200
+    };
+
+    /**
+     * @brief Menu IDs of the Remote tab, port items offset by the port's index.
+     */
+    enum RemoteMenuItemIDs
+    {
+        RemoteOff = 1,
+        RemotePort = 100
+    };
+
+    /**
+     * @brief Menu IDs of the Stats tab.
+     */
+    enum StatsMenuItemIDs
+    {
+        StatsOverlay = 1,
+        StatsWriteToLog,
+        StatsResetPeaks
+    };
+
+    std::unique_ptr<juce::FileChooser> wavetableChooser; ///< Import chooser kept alive while it is open
+    GpuRenderer* gpuRenderer = nullptr;                  ///< Editor's OpenGL renderer, toggled from the Theme tab
+    juce::Component* engineStatsOverlay = nullptr;       ///< Overlay toggled from the Stats tab
+
+#if STAGE_PROFILING
+    /**
+     * @brief Menu IDs for profiler actions.
+     */
+    enum ProfilerMenuItemIDs
+    {
+        ProfilerOverlay = 1,
+        ProfilerSaveTrace
+    };
+
+    juce::Component* profilerOverlay = nullptr;      ///< Overlay toggled from the Profiler tab
+    std::unique_ptr<juce::FileChooser> traceChooser; ///< Chooser kept alive while it is open
+
+    /**
+     * @brief Constructs the Profiler menu tab, present in profiling builds only.
+     * @return A Tab object toggling the overlay and saving Chrome traces.
+     */
+    Tab createProfilerTab();
+#endif
+
     /**
      * @struct Tab
      * @brief Represents a single top-level tab in the menu bar.
@@ -96,7 +203,7 @@ private:
     juce::LookAndFeel_V4 themedLookAndFeel;          ///< LookAndFeel object used to apply theme-specific popup styling.
 
     /**
-     * @brief Constructs the Theme menu tab.
+     * @brief Constructs the Theme menu tab, with the OpenGL rendering toggle below the themes.
      * @return A fully initialized Tab object for theme switching.
      */
     Tab createThemeTab();
@@ -107,6 +214,36 @@ private:
      */
     Tab createPresetsTab();
 
+    /**
+     * @brief Constructs the Voices menu tab, setting the polyphony limit and the stealing policy.
+     * @return A Tab object whose items write the VoiceAllocator parameters.
+     */
+    Tab createVoicesTab();
+
+    /**
+     * @brief Constructs the Arp menu tab, setting the arpeggiator mode, rate, range, gate and step count.
+     * @return A Tab object whose items write the Arpeggiator parameters.
+     */
+    Tab createArpTab();
+
+    /**
+     * @brief Constructs the Wavetables menu tab, importing and clearing each oscillator's user table.
+     * @return A Tab object whose items drive the processor's user wavetables.
+     */
+    Tab createWavetablesTab();
+
+    /**
+     * @brief Constructs the Remote menu tab, choosing the UDP port the processor listens on for OSC.
+     * @return A Tab object whose items start and stop remote control.
+     */
+    Tab createRemoteTab();
+
+    /**
+     * @brief Constructs the Stats menu tab, showing the engine counters and writing them to the log.
+     * @return A Tab object toggling the overlay, logging a snapshot and resetting the peaks.
+     */
+    Tab createStatsTab();
+
     /**
      * @brief Constructs the project tab with static branding and an About link.
      * @return A Tab object with "Digital Synthesizer" label and an About menu.
@@ -0,0 +1,101 @@
+#include "MidiEventList.h"
+
+void MidiEventList::prepare(int expectedEventsPerBlock)
+{
+    events.clear();
+    events.reserve(static_cast<size_t>(juce::jmax(0, expectedEventsPerBlock)));
+    numNoteOns = 0;
+}
+
+void MidiEventList::build(const juce::MidiBuffer& midiMessages, int numSamples)
+{
+    events.clear();
+    numNoteOns = 0;
+
+    const int lastSample = juce::jmax(0, numSamples - 1);
+
+    for (const auto metadata : midiMessages)
+    {
+        // Every event kept here is a channel message, read it in place
+        if (metadata.numBytes < 2)
+            continue;
+
+        const uint8_t status = metadata.data[0] & 0xf0;
+        const uint8_t data1 = metadata.data[1] & 0x7f;
+        const uint8_t data2 = (metadata.numBytes > 2) ? (metadata.data[2] & 0x7f) : 0;
+
+        // Only channel pressure and program change are two byte messages
+        if (metadata.numBytes < 3 && status != 0xd0 && status != 0xc0)
+            continue;
+
+        Event event;
+        event.sample = juce::jlimit(0, lastSample, metadata.samplePosition);
+        event.channel = static_cast<uint8_t>((metadata.data[0] & 0x0f) + 1);
+        event.number = data1;
+        event.value = data2;
+
+        if (status == 0x90 && data2 > 0)
+        {
+            event.type = Type::NoteOn;
+            ++numNoteOns;
+        }
+        else if (status == 0x80 || status == 0x90)
+        {
+            event.type = Type::NoteOff;
+        }
+        else if (status == 0xb0)
+        {
+            event.type = Type::Controller;
+        }
+        else if (status == 0xe0)
+        {
+            event.type = Type::PitchBend;
+            event.number = 0;
+            event.value = static_cast<uint16_t>(data1 | (data2 << 7));
+        }
+        else if (status == 0xd0)
+        {
+            event.type = Type::ChannelPressure;
+            event.number = 0;
+            event.value = data1;
+        }
+        else if (status == 0xc0)
+        {
+            event.type = Type::ProgramChange;
+            event.value = 0;
+        }
+        else
+        {
+            continue;
+        }
+
+        events.push_back(event);
+    }
+}
+
+void MidiEventList::replaceNotes(const Event* generated, int numGenerated)
+{
+    const auto isNote = [](const Event& event)
+        {
+            return event.type == Type::NoteOn || event.type == Type::NoteOff;
+        };
+
+    const auto numKept = static_cast<int>(std::remove_if(events.begin(), events.end(), isNote) - events.begin());
+    events.resize(static_cast<size_t>(numKept + numGenerated));
+
+    // Merge from the back, where neither range has been read yet
+    int kept = numKept - 1;
+    int added = numGenerated - 1;
+    for (int write = numKept + numGenerated - 1; added >= 0; --write)
+    {
+        if (kept >= 0 && events[static_cast<size_t>(kept)].sample > generated[added].sample)
+            events[static_cast<size_t>(write)] = events[static_cast<size_t>(kept--)];
+        else
+            events[static_cast<size_t>(write)] = generated[added--];
+    }
+
+    numNoteOns = static_cast<int>(std::count_if(generated, generated + numGenerated, [](const Event& event)
+        {
+            return event.type == Type::NoteOn;
+        }));
+}
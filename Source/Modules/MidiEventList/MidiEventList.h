@@ -0,0 +1,104 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class MidiEventList
+ * @brief Compact, time-ordered list of the MIDI events the synth reacts to, built once per block.
+ *
+ * The processor decodes the host's MidiBuffer into this list before rendering,
+ * so the render loop walks plain structs instead of re-parsing messages, and
+ * events the synth ignores (clock, sysex...) no longer split the
+ * block into extra segments.
+ */
+class MidiEventList
+{
+public:
+    /**
+     * @enum Type
+     * @brief Kinds of events kept in the list.
+     */
+    enum class Type : uint8_t
+    {
+        NoteOn,    ///< Note-on with a non-zero velocity
+        NoteOff,         ///< Note-off, or note-on with zero velocity
+        Controller,      ///< Control change
+        PitchBend,       ///< Pitch wheel, value is 14-bit
+        ChannelPressure, ///< Channel aftertouch, MPE pressure on member channels
+        ProgramChange    ///< Program change, number is the program
+    };
+
+    /**
+     * @struct Event
+     * @brief One decoded MIDI event.
+     */
+    struct Event
+    {
+        int sample = 0;           ///< Position within the block, clamped to the block
+        Type type = Type::NoteOn; ///< Event kind
+        uint8_t channel = 1;      ///< MIDI channel, 1 to 16
+        uint8_t number = 0;       ///< Note, controller or program number
+        uint16_t value = 0;       ///< Velocity, controller, pressure or 14-bit pitch wheel value
+
+        /**
+         * @brief Returns the velocity of a note event in [0, 1].
+         */
+        float getVelocity() const noexcept { return static_cast<float>(value) / 127.0f; }
+    };
+
+    /**
+     * @brief Constructs an empty list.
+     */
+    MidiEventList() = default;
+
+    /**
+     * @brief Reserves room for a typical block's events.
+     *
+     * Call from prepareToPlay(). Blocks with more events still work but grow the list once.
+     *
+     * @param expectedEventsPerBlock Number of events to reserve.
+     */
+    void prepare(int expectedEventsPerBlock);
+
+    /**
+     * @brief Replaces the list with the relevant events of a block.
+     * @param midiMessages Host MIDI, already ordered by sample position.
+     * @param numSamples Block length, later events are moved to its last sample.
+     */
+    void build(const juce::MidiBuffer& midiMessages, int numSamples);
+
+    /**
+     * @brief Replaces the note events with generated ones, keeping every other event.
+     *
+     * The arpeggiator feeds its notes through here, so they reach the render
+     * loop like any other event. Within the reserved room nothing allocates.
+     * A generated note follows the other events at its sample, so expression
+     * sent with it is already in place.
+     *
+     * @param generated Note-ons and note-offs in time order, positions within the block.
+     * @param numGenerated Number of generated events.
+     */
+    void replaceNotes(const Event* generated, int numGenerated);
+
+    /**
+     * @brief Returns true if the block contains at least one note-on.
+     */
+    bool hasNoteOns() const noexcept { return numNoteOns > 0; }
+
+    /**
+     * @brief Returns true if the block contains no relevant event.
+     */
+    bool isEmpty() const noexcept { return events.empty(); }
+
+    /** @brief First event, for range-based loops. */
+    std::vector<Event>::const_iterator begin() const noexcept { return events.cbegin(); }
+
+    /** @brief One past the last event, for range-based loops. */
+    std::vector<Event>::const_iterator end() const noexcept { return events.cend(); }
+
+private:
+    std::vector<Event> events; ///< Events of the current block, in time order
+    int numNoteOns = 0;        ///< Note-ons in the current block
+
+    JUCE_DECLARE_NON_COPYABLE(MidiEventList)
+};
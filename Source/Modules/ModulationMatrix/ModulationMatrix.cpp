@@ -0,0 +1,295 @@
+#include "ModulationMatrix.h"
+
+namespace
+{
+    const juce::Identifier matrixType{ "MOD_MATRIX" };
+    const juce::Identifier mainType{ "MAIN" };
+    const juce::Identifier slotType{ "SLOT" };
+    const juce::Identifier paramProperty{ "param" };
+    const juce::Identifier sourceProperty{ "source" };
+    const juce::Identifier indexProperty{ "index" };
+    const juce::Identifier depthProperty{ "depth" };
+    const juce::Identifier bipolarProperty{ "bipolar" };
+    const juce::Identifier modeProperty{ "mode" };
+    const juce::Identifier minProperty{ "min" };
+    const juce::Identifier maxProperty{ "max" };
+
+    // APVTS layout of the parameters older versions stored routing in
+    const juce::Identifier legacyParamType{ "PARAM" };
+    const juce::Identifier legacyIdProperty{ "id" };
+    const juce::Identifier legacyValueProperty{ "value" };
+    const char* const legacySuffixes[] = { "_MOD_SOURCE", "_MOD_INDEX", "_MOD_MIN", "_MOD_MAX" };
+}
+
+ModulationMatrix::ModulationMatrix(juce::AudioProcessorValueTreeState& apvts)
+    : apvts(apvts)
+{
+    apvts.state.addListener(this);
+    importLegacyParameters();
+}
+
+ModulationMatrix::~ModulationMatrix()
+{
+    cancelPendingUpdate();
+    apvts.state.removeListener(this);
+}
+
+ModulationMatrix::MainRoute ModulationMatrix::getMainRoute(const juce::String& paramID) const
+{
+    MainRoute route;
+
+    const auto tree = findMainTree(paramID);
+    if (!tree.isValid())
+        return route;
+
+    route.mode = static_cast<ModulationMode>(static_cast<int>(tree[modeProperty]));
+    route.index = static_cast<int>(tree[indexProperty]);
+    route.min = juce::jlimit(0.0f, 1.0f, static_cast<float>(tree[minProperty]));
+    route.max = juce::jlimit(route.min, 1.0f, static_cast<float>(tree[maxProperty]));
+    return route;
+}
+
+void ModulationMatrix::setMainRoute(const juce::String& paramID, const MainRoute& route)
+{
+    auto tree = findMainTree(paramID);
+
+    const MainRoute defaults;
+    if (route.mode == defaults.mode && route.index == defaults.index
+        && route.min == defaults.min && route.max == defaults.max)
+    {
+        if (tree.isValid())
+            getMatrixTree(false).removeChild(tree, nullptr);
+        return;
+    }
+
+    const bool isNew = !tree.isValid();
+    if (isNew)
+    {
+        tree = juce::ValueTree(mainType);
+        tree.setProperty(paramProperty, paramID, nullptr);
+    }
+
+    tree.setProperty(modeProperty, static_cast<int>(route.mode), nullptr);
+    tree.setProperty(indexProperty, route.index, nullptr);
+    tree.setProperty(minProperty, route.min, nullptr);
+    tree.setProperty(maxProperty, route.max, nullptr);
+
+    // Fully built before it is attached, so listeners see one change
+    if (isNew)
+        getMatrixTree(true).appendChild(tree, nullptr);
+}
+
+void ModulationMatrix::clear(const juce::String& paramID)
+{
+    auto matrix = getMatrixTree(false);
+    for (int i = matrix.getNumChildren(); --i >= 0;)
+    {
+        if (matrix.getChild(i)[paramProperty].toString() == paramID)
+            matrix.removeChild(i, nullptr);
+    }
+}
+
+std::vector<ModulationSlot> ModulationMatrix::getSlots(const juce::String& paramID) const
+{
+    std::vector<ModulationSlot> slots;
+
+    const auto matrix = getMatrixTree(false);
+    for (const auto& child : matrix)
+    {
+        if (!child.hasType(slotType) || child[paramProperty].toString() != paramID)
+            continue;
+
+        ModulationSlot slot;
+        slot.source.type = static_cast<int>(child[sourceProperty]) == static_cast<int>(ModulationSourceType::Envelope)
+            ? ModulationSourceType::Envelope
+            : ModulationSourceType::LFO;
+        slot.source.index = static_cast<int>(child[indexProperty]);
+        slot.depth = juce::jlimit(-1.0f, 1.0f, static_cast<float>(child[depthProperty]));
+        slot.bipolar = static_cast<bool>(child[bipolarProperty]);
+        slots.push_back(slot);
+
+        if (static_cast<int>(slots.size()) == maxSlotsPerParameter)
+            break;
+    }
+
+    return slots;
+}
+
+bool ModulationMatrix::setSlot(const juce::String& paramID, const ModulationSlot& slot)
+{
+    auto slotTree = findSlotTree(paramID, slot.source);
+
+    if (!slotTree.isValid())
+    {
+        if (static_cast<int>(getSlots(paramID).size()) >= maxSlotsPerParameter)
+            return false;
+
+        slotTree = juce::ValueTree(slotType);
+        slotTree.setProperty(paramProperty, paramID, nullptr);
+        slotTree.setProperty(sourceProperty, static_cast<int>(slot.source.type), nullptr);
+        slotTree.setProperty(indexProperty, slot.source.index, nullptr);
+        slotTree.setProperty(depthProperty, slot.depth, nullptr);
+        slotTree.setProperty(bipolarProperty, slot.bipolar, nullptr);
+
+        // Fully built before it is attached, so listeners see one change
+        getMatrixTree(true).appendChild(slotTree, nullptr);
+        return true;
+    }
+
+    slotTree.setProperty(depthProperty, slot.depth, nullptr);
+    slotTree.setProperty(bipolarProperty, slot.bipolar, nullptr);
+    return true;
+}
+
+void ModulationMatrix::removeSlot(const juce::String& paramID, const ModulationSourceID& source)
+{
+    auto slotTree = findSlotTree(paramID, source);
+    if (slotTree.isValid())
+        getMatrixTree(false).removeChild(slotTree, nullptr);
+}
+
+void ModulationMatrix::clearSlots(const juce::String& paramID)
+{
+    auto matrix = getMatrixTree(false);
+    for (int i = matrix.getNumChildren(); --i >= 0;)
+    {
+        const auto child = matrix.getChild(i);
+        if (child.hasType(slotType) && child[paramProperty].toString() == paramID)
+            matrix.removeChild(i, nullptr);
+    }
+}
+
+void ModulationMatrix::addListener(Listener* listener)
+{
+    listeners.add(listener);
+}
+
+void ModulationMatrix::removeListener(Listener* listener)
+{
+    listeners.remove(listener);
+}
+
+juce::ValueTree ModulationMatrix::getMatrixTree(bool createIfMissing) const
+{
+    auto matrix = apvts.state.getChildWithName(matrixType);
+    if (!matrix.isValid() && createIfMissing)
+    {
+        matrix = juce::ValueTree(matrixType);
+        apvts.state.appendChild(matrix, nullptr);
+    }
+
+    return matrix;
+}
+
+juce::ValueTree ModulationMatrix::findMainTree(const juce::String& paramID) const
+{
+    const auto matrix = getMatrixTree(false);
+    for (const auto& child : matrix)
+    {
+        if (child.hasType(mainType) && child[paramProperty].toString() == paramID)
+            return child;
+    }
+
+    return {};
+}
+
+juce::ValueTree ModulationMatrix::findSlotTree(const juce::String& paramID, const ModulationSourceID& source) const
+{
+    const auto matrix = getMatrixTree(false);
+    for (const auto& child : matrix)
+    {
+        if (child.hasType(slotType)
+            && child[paramProperty].toString() == paramID
+            && static_cast<int>(child[sourceProperty]) == static_cast<int>(source.type)
+            && static_cast<int>(child[indexProperty]) == source.index)
+            return child;
+    }
+
+    return {};
+}
+
+void ModulationMatrix::importLegacyParameters()
+{
+    std::map<juce::String, MainRoute> routes;
+
+    for (int i = apvts.state.getNumChildren(); --i >= 0;)
+    {
+        const auto child = apvts.state.getChild(i);
+        if (!child.hasType(legacyParamType))
+            continue;
+
+        const auto id = child[legacyIdProperty].toString();
+        for (int field = 0; field < 4; ++field)
+        {
+            if (!id.endsWith(legacySuffixes[field]))
+                continue;
+
+            auto& route = routes[id.dropLastCharacters(juce::String(legacySuffixes[field]).length())];
+            const float value = static_cast<float>(child[legacyValueProperty]);
+
+            switch (field)
+            {
+            case 0: route.mode = static_cast<ModulationMode>(juce::roundToInt(value)); break;
+            case 1: route.index = juce::roundToInt(value); break;
+            case 2: route.min = value; break;
+            default: route.max = value; break;
+            }
+
+            apvts.state.removeChild(i, nullptr);
+            break;
+        }
+    }
+
+    // Only the source choice makes a route, a leftover range alone is dropped
+    for (const auto& [paramID, route] : routes)
+    {
+        if (route.isModulated() && !findMainTree(paramID).isValid())
+            setMainRoute(paramID, route);
+    }
+}
+
+void ModulationMatrix::notify(const juce::String& paramID)
+{
+    // A host may restore state off the message thread, listeners then catch up all at once
+    if (!juce::MessageManager::existsAndIsCurrentThread())
+    {
+        triggerAsyncUpdate();
+        return;
+    }
+
+    listeners.call([&paramID](Listener& l) { l.modulationRoutingChanged(paramID); });
+}
+
+void ModulationMatrix::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier&)
+{
+    // Parameter values flush into the same state, only routing edits matter here
+    if (tree.hasType(slotType) || tree.hasType(mainType))
+        notify(tree[paramProperty].toString());
+}
+
+void ModulationMatrix::valueTreeChildAdded(juce::ValueTree&, juce::ValueTree& child)
+{
+    if (child.hasType(slotType) || child.hasType(mainType))
+        notify(child[paramProperty].toString());
+    else if (child.hasType(matrixType))
+        notify({});
+}
+
+void ModulationMatrix::valueTreeChildRemoved(juce::ValueTree&, juce::ValueTree& child, int)
+{
+    if (child.hasType(slotType) || child.hasType(mainType))
+        notify(child[paramProperty].toString());
+    else if (child.hasType(matrixType))
+        notify({});
+}
+
+void ModulationMatrix::valueTreeRedirected(juce::ValueTree&)
+{
+    importLegacyParameters();
+    notify({});
+}
+
+void ModulationMatrix::handleAsyncUpdate()
+{
+    listeners.call([](Listener& l) { l.modulationRoutingChanged({}); });
+}
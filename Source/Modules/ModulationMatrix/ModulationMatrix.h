@@ -0,0 +1,171 @@
+#pragma once
+
+#include "../Knob/KnobModulation.h"
+#include <JuceHeader.h>
+
+/**
+ * @class ModulationMatrix
+ * @brief Modulation routing of every parameter, stored in the plugin state.
+ *
+ * Every modulatable parameter has at most one main source, mapped into a [min, max]
+ * range, and up to maxSlotsPerParameter additional sources with their own depth and
+ * polarity. All of it lives in a MOD_MATRIX child of the APVTS state, so it is saved
+ * and restored with the state but never shows up in the host's automation list.
+ * Listeners hear about every change, including a state replaced by a preset or the host.
+ *
+ * States saved when routing was stored as _MOD_SOURCE, _MOD_INDEX, _MOD_MIN and
+ * _MOD_MAX parameters are converted when they are loaded.
+ */
+class ModulationMatrix : private juce::ValueTree::Listener,
+    private juce::AsyncUpdater
+{
+public:
+    static constexpr int maxSlotsPerParameter = 4; ///< Slots a parameter may add to its main source
+
+    /**
+     * @struct MainRoute
+     * @brief The main modulation source of a parameter and the range it sweeps.
+     */
+    struct MainRoute
+    {
+        ModulationMode mode = ModulationMode::None; ///< Envelope or LFO when modulated.
+        int index = 0;                              ///< Index of the source.
+        float min = 0.0f;                           ///< Normalized lower bound of the range.
+        float max = 1.0f;                           ///< Normalized upper bound of the range.
+
+        /**
+         * @brief Returns true if the route names a source.
+         */
+        bool isModulated() const noexcept { return mode == ModulationMode::Envelope || mode == ModulationMode::LFO; }
+
+        /**
+         * @brief Returns the source the route names, meaningful only if isModulated().
+         */
+        ModulationSourceID getSource() const noexcept
+        {
+            return { mode == ModulationMode::Envelope ? ModulationSourceType::Envelope : ModulationSourceType::LFO, index };
+        }
+    };
+
+    /**
+     * @class Listener
+     * @brief Receives slot changes, always on the message thread.
+     */
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        /**
+         * @brief Called when the main route or the slots of a parameter changed.
+         * @param paramID The base parameter ID, or an empty string if every parameter may have changed.
+         */
+        virtual void modulationRoutingChanged(const juce::String& paramID) = 0;
+    };
+
+    /**
+     * @brief Constructs the matrix on top of the processor's state.
+     * @param apvts The state that stores the slots.
+     */
+    explicit ModulationMatrix(juce::AudioProcessorValueTreeState& apvts);
+
+    /**
+     * @brief Stops listening to the state.
+     */
+    ~ModulationMatrix() override;
+
+    /**
+     * @brief Returns the main route of a parameter, a default unmodulated route if it has none.
+     * @param paramID The base parameter ID.
+     */
+    MainRoute getMainRoute(const juce::String& paramID) const;
+
+    /**
+     * @brief Stores the main route of a parameter.
+     * @param paramID The base parameter ID.
+     * @param route The route, a default route removes the entry.
+     */
+    void setMainRoute(const juce::String& paramID, const MainRoute& route);
+
+    /**
+     * @brief Removes the main route and every slot of a parameter.
+     * @param paramID The base parameter ID.
+     */
+    void clear(const juce::String& paramID);
+
+    /**
+     * @brief Returns the slots of a parameter.
+     * @param paramID The base parameter ID.
+     */
+    std::vector<ModulationSlot> getSlots(const juce::String& paramID) const;
+
+    /**
+     * @brief Adds a slot, or updates the slot that already reads the same source.
+     * @param paramID The base parameter ID.
+     * @param slot The slot to store.
+     * @return False if the parameter already has maxSlotsPerParameter other slots.
+     */
+    bool setSlot(const juce::String& paramID, const ModulationSlot& slot);
+
+    /**
+     * @brief Removes the slot of a parameter that reads a source, if any.
+     * @param paramID The base parameter ID.
+     * @param source The source of the slot to remove.
+     */
+    void removeSlot(const juce::String& paramID, const ModulationSourceID& source);
+
+    /**
+     * @brief Removes every slot of a parameter.
+     * @param paramID The base parameter ID.
+     */
+    void clearSlots(const juce::String& paramID);
+
+    /**
+     * @brief Registers a listener.
+     */
+    void addListener(Listener* listener);
+
+    /**
+     * @brief Unregisters a listener.
+     */
+    void removeListener(Listener* listener);
+
+private:
+    /**
+     * @brief Returns the MOD_MATRIX child of the state, creating it if asked to.
+     */
+    juce::ValueTree getMatrixTree(bool createIfMissing) const;
+
+    /**
+     * @brief Returns the main route tree of a parameter, or an invalid tree.
+     */
+    juce::ValueTree findMainTree(const juce::String& paramID) const;
+
+    /**
+     * @brief Returns the slot tree of a parameter that reads a source, or an invalid tree.
+     */
+    juce::ValueTree findSlotTree(const juce::String& paramID, const ModulationSourceID& source) const;
+
+    /**
+     * @brief Moves routing stored in _MOD_* parameters by older versions into the matrix.
+     */
+    void importLegacyParameters();
+
+    /**
+     * @brief Tells the listeners, deferring to the message thread when called from elsewhere.
+     */
+    void notify(const juce::String& paramID);
+
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+    void valueTreeChildAdded(juce::ValueTree& parent, juce::ValueTree& child) override;
+    void valueTreeChildRemoved(juce::ValueTree& parent, juce::ValueTree& child, int index) override;
+    void valueTreeRedirected(juce::ValueTree& tree) override;
+
+    /** @brief Delivers a deferred change to every listener. */
+    void handleAsyncUpdate() override;
+
+    juce::AudioProcessorValueTreeState& apvts; ///< State holding the MOD_MATRIX child
+    juce::ListenerList<Listener> listeners;    ///< Registered listeners
+
+    JUCE_DECLARE_NON_COPYABLE(ModulationMatrix)
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "../FastMath/PitchTable.h"
+#include <JuceHeader.h>
+
+/**
+ * @namespace NoteExpression
+ * @brief Per-note expression (MPE pitch bend, pressure and slide) routed straight into the voice kernels.
+ *
+ * Expression never touches the APVTS or the ModulationRouter: the processor
+ * tracks the latest value per MIDI channel, copies the resulting lanes into
+ * every note slot playing on that channel, and the oscillator and filter voice
+ * kernels read the lanes of the note they are rendering.
+ *
+ * Channel 1 is treated as the MPE lower zone master channel and channels 2-16
+ * as member channels, so a plain single-channel keyboard (everything on
+ * channel 1) still gets a regular, global 2 semitone pitch bend.
+ */
+namespace NoteExpression
+{
+    static constexpr int numChannels = 16;              ///< MIDI channels
+    static constexpr int masterChannel = 1;             ///< MPE lower zone master channel
+    static constexpr float masterBendRange = 2.0f;      ///< Master channel pitch bend range in semitones
+    static constexpr float memberBendRange = 48.0f;     ///< Member channel pitch bend range in semitones (MPE default)
+    static constexpr float pressureCutoffOctaves = 1.0f; ///< Cutoff raise at full pressure, in octaves
+    static constexpr float slideCutoffOctaves = 2.0f;   ///< Cutoff shift at either end of the slide range, in octaves
+
+    /**
+     * @struct Lanes
+     * @brief Expression of one note; the rows of the per-voice modulation matrix.
+     */
+    struct Lanes
+    {
+        float pitchBendSemitones = 0.0f; ///< Total pitch bend in semitones
+        float pressure = 0.0f;           ///< Pressure in [0, 1]
+        float slide = 0.5f;              ///< Slide (CC74) in [0, 1], 0.5 is neutral
+
+        /**
+         * @brief Returns the frequency ratio of the pitch bend.
+         */
+        double getPitchRatio() const noexcept
+        {
+            return (pitchBendSemitones == 0.0f) ? 1.0 : static_cast<double>(PitchTable::semitonesToRatio(pitchBendSemitones));
+        }
+
+        /**
+         * @brief Returns the filter cutoff offset in octaves from pressure and slide.
+         */
+        float getCutoffOctaves() const noexcept
+        {
+            return pressure * pressureCutoffOctaves + (slide - 0.5f) * 2.0f * slideCutoffOctaves;
+        }
+    };
+
+    /**
+     * @class ChannelState
+     * @brief Latest expression values per MIDI channel. Audio thread only.
+     */
+    class ChannelState
+    {
+    public:
+        /**
+         * @brief Constructs a state with every channel at neutral expression.
+         */
+        ChannelState() noexcept { reset(); }
+
+        /**
+         * @brief Returns every channel to neutral expression.
+         */
+        void reset() noexcept
+        {
+            bends.fill(0.0f);
+            pressures.fill(0.0f);
+            slides.fill(0.5f);
+        }
+
+        /**
+         * @brief Stores a pitch bend.
+         * @param channel MIDI channel, 1 to 16.
+         * @param value 14-bit pitch wheel value, 8192 is centre.
+         */
+        void setPitchBend(int channel, int value) noexcept
+        {
+            if (!isValid(channel))
+                return;
+
+            const float range = (channel == masterChannel) ? masterBendRange : memberBendRange;
+            bends[channel - 1] = static_cast<float>(value - 8192) / 8192.0f * range;
+        }
+
+        /**
+         * @brief Stores a channel pressure. Ignored on the master channel.
+         * @param channel MIDI channel, 1 to 16.
+         * @param value 7-bit pressure.
+         */
+        void setPressure(int channel, int value) noexcept
+        {
+            if (isValid(channel) && channel != masterChannel)
+                pressures[channel - 1] = static_cast<float>(value) / 127.0f;
+        }
+
+        /**
+         * @brief Stores a slide (CC74). Ignored on the master channel, where CC74 stays an ordinary controller.
+         * @param channel MIDI channel, 1 to 16.
+         * @param value 7-bit controller value.
+         */
+        void setSlide(int channel, int value) noexcept
+        {
+            if (isValid(channel) && channel != masterChannel)
+                slides[channel - 1] = static_cast<float>(value) / 127.0f;
+        }
+
+        /**
+         * @brief Returns the lanes of a note playing on a channel, master pitch bend included.
+         * @param channel MIDI channel, 1 to 16.
+         */
+        Lanes getLanes(int channel) const noexcept
+        {
+            Lanes lanes;
+            lanes.pitchBendSemitones = bends[masterChannel - 1];
+
+            if (isValid(channel) && channel != masterChannel)
+            {
+                lanes.pitchBendSemitones += bends[channel - 1];
+                lanes.pressure = pressures[channel - 1];
+                lanes.slide = slides[channel - 1];
+            }
+
+            return lanes;
+        }
+
+    private:
+        static bool isValid(int channel) noexcept { return channel >= 1 && channel <= numChannels; }
+
+        std::array<float, numChannels> bends{};                                    ///< Pitch bend per channel in semitones
+        std::array<float, numChannels> pressures{};                                ///< Pressure per channel
+        std::array<float, numChannels> slides{};                                   ///< Slide per channel
+    };
+}
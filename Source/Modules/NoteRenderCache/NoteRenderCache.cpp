@@ -0,0 +1,111 @@
+#include "NoteRenderCache.h"
+
+void NoteRenderCache::prepare(double sampleRate)
+{
+    jassert(sampleRate > 0.0);
+
+    capacity = juce::jmax(1, juce::roundToInt(segmentSeconds * sampleRate));
+    samples.assign(static_cast<size_t>(numEntries) * 2 * static_cast<size_t>(capacity), 0.0f);
+    clear();
+}
+
+void NoteRenderCache::release()
+{
+    samples.clear();
+    samples.shrink_to_fit();
+    capacity = 0;
+    clear();
+}
+
+void NoteRenderCache::swap(NoteRenderCache& other) noexcept
+{
+    std::swap(entries, other.entries);
+    samples.swap(other.samples);
+    std::swap(capacity, other.capacity);
+    std::swap(useCounter, other.useCounter);
+}
+
+bool NoteRenderCache::isPrepared() const noexcept
+{
+    return capacity > 0;
+}
+
+void NoteRenderCache::clear() noexcept
+{
+    for (auto& entry : entries)
+    {
+        entry.midiNote = -1;
+        entry.length = 0;
+    }
+}
+
+int NoteRenderCache::getCapacity() const noexcept
+{
+    return capacity;
+}
+
+size_t NoteRenderCache::getMemoryBytes() const noexcept
+{
+    return samples.capacity() * sizeof(float);
+}
+
+int NoteRenderCache::find(int midiNote) noexcept
+{
+    for (int i = 0; i < numEntries; ++i)
+    {
+        auto& entry = entries[static_cast<size_t>(i)];
+        if (entry.midiNote == midiNote && entry.length > 0)
+        {
+            entry.lastUsed = useCounter++;
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int NoteRenderCache::claim(int midiNote, uint32_t entriesInUse) noexcept
+{
+    if (!isPrepared())
+        return -1;
+
+    // A free entry first, then the one unused the longest
+    int chosen = -1;
+    for (int i = 0; i < numEntries; ++i)
+    {
+        if ((entriesInUse >> i) & 1u)
+            continue;
+
+        const auto& entry = entries[static_cast<size_t>(i)];
+        if (entry.midiNote < 0)
+        {
+            chosen = i;
+            break;
+        }
+
+        // Wrap-safe comparison of use order
+        if (chosen < 0 || static_cast<int32_t>(entry.lastUsed - entries[static_cast<size_t>(chosen)].lastUsed) < 0)
+            chosen = i;
+    }
+
+    if (chosen < 0)
+        return -1;
+
+    auto& entry = entries[static_cast<size_t>(chosen)];
+    entry = Entry{};
+    entry.midiNote = midiNote;
+    entry.lastUsed = useCounter++;
+    return chosen;
+}
+
+NoteRenderCache::Entry& NoteRenderCache::getEntry(int entry) noexcept
+{
+    jassert(entry >= 0 && entry < numEntries);
+    return entries[static_cast<size_t>(entry)];
+}
+
+float* NoteRenderCache::getChannel(int entry, int channel) noexcept
+{
+    jassert(isPrepared() && entry >= 0 && entry < numEntries && (channel == 0 || channel == 1));
+    return samples.data() + (static_cast<size_t>(entry) * 2 + static_cast<size_t>(channel)) * static_cast<size_t>(capacity);
+}
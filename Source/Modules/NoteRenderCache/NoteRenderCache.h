@@ -0,0 +1,116 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+/**
+ * @class NoteRenderCache
+ * @brief Bounded LRU store of rendered note segments, so a static patch renders each note once.
+ *
+ * An oscillator's unison stack is the costly part of a note and, while the
+ * patch does not change, renders the same audio every time a note starts from
+ * phase zero. The first such note captures its unison output, before envelope,
+ * velocity and pan, into an entry; later notes on the key copy the entry and
+ * go on rendering live where it ends, or as soon as anything about the note
+ * changes.
+ *
+ * Entries hold a fixed length per key and are recycled least recently used
+ * first. Each also keeps the phase increments it was rendered with, so the
+ * phases of a note handing back to live rendering follow from its position
+ * alone. The owner clears the cache whenever anything its notes render with
+ * changes. All storage is allocated by prepare(); nothing else allocates, and
+ * everything but prepare() and release() is safe on the audio thread.
+ */
+class NoteRenderCache
+{
+public:
+    static constexpr int numEntries = 32;              ///< Keys held at once
+    static constexpr int maxVoices = 16;               ///< Unison voices an entry keeps increments for
+    static constexpr double segmentSeconds = 0.5;      ///< Length captured per key
+
+    /**
+     * @struct Entry
+     * @brief One captured key.
+     */
+    struct Entry
+    {
+        int midiNote = -1;                             ///< Key the entry holds, -1 if free
+        int length = 0;                                ///< Samples captured so far
+        uint32_t lastUsed = 0;                         ///< Use order, for recycling
+        std::array<double, maxVoices> increments{};    ///< Phase increment of every unison voice, in radians per sample
+        double modulatorIncrement = 0.0;               ///< Phase increment of the cross-modulator, 0 without one
+        bool sync = false;                             ///< True if the carriers restart with the modulator's cycle
+    };
+
+    /**
+     * @brief Allocates every entry for a sample rate and clears the cache. Not real-time safe.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Frees the storage. Not real-time safe.
+     */
+    void release();
+
+    /**
+     * @brief Exchanges the storage and entries with another cache, without allocating.
+     * @param other Cache prepared or released off the audio thread.
+     */
+    void swap(NoteRenderCache& other) noexcept;
+
+    /**
+     * @brief Returns true if prepare() allocated the storage.
+     */
+    bool isPrepared() const noexcept;
+
+    /**
+     * @brief Forgets every entry.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Returns the samples an entry holds at most.
+     */
+    int getCapacity() const noexcept;
+
+    /**
+     * @brief Returns the bytes of sample storage allocated, 0 until prepare().
+     */
+    size_t getMemoryBytes() const noexcept;
+
+    /**
+     * @brief Returns the entry holding a key, marking it used.
+     * @param midiNote The key.
+     * @return Entry index, or -1 if the key is not held.
+     */
+    int find(int midiNote) noexcept;
+
+    /**
+     * @brief Claims an entry for a new capture of a key, recycling the least recently used one.
+     * @param midiNote The key.
+     * @param entriesInUse Bit per entry another note reads or writes, never recycled.
+     * @return Entry index, emptied and marked used, or -1 if every entry is in use.
+     */
+    int claim(int midiNote, uint32_t entriesInUse) noexcept;
+
+    /**
+     * @brief Returns an entry.
+     */
+    Entry& getEntry(int entry) noexcept;
+
+    /**
+     * @brief Returns the first sample of an entry's channel.
+     * @param entry Entry index.
+     * @param channel 0 for left, 1 for right.
+     */
+    float* getChannel(int entry, int channel) noexcept;
+
+private:
+    static_assert(numEntries <= 32, "Entries in use are passed as 32 bits");
+
+    std::array<Entry, numEntries> entries;             ///< Entry descriptions
+    std::vector<float> samples;                        ///< Two channels of capacity samples per entry
+    int capacity = 0;                                  ///< Samples per entry and channel
+    uint32_t useCounter = 0;                           ///< Next use order
+};
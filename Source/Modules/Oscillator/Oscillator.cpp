@@ -1,13 +1,247 @@
 #include "Oscillator.h"
+#include "../GainRamp/GainRamp.h"
+
+namespace
+{
+    constexpr double maxFmIndex = 4.0;  // Peak phase offset of full FM depth in radians, less than a cycle
+
+    /**
+     * @brief Cross-modulator read alongside a unison group, see Oscillator::CrossMod.
+     */
+    struct Modulator
+    {
+        const float* table = nullptr;   ///< Band-limited table of the modulator's waveform
+        double position = 0.0;          ///< Read position in samples
+        double increment = 0.0;         ///< Table positions advanced per sample
+        float depth = 0.0f;             ///< FM peak phase offset in table positions, or the ring mix
+    };
+
+    /**
+     * @brief Returns the table shape of a built-in periodic waveform, Sine for noise and user tables.
+     */
+    WavetableBank::Shape toTableShape(Oscillator::Waveform waveform) noexcept
+    {
+        switch (waveform)
+        {
+        case Oscillator::Waveform::Square:
+            return WavetableBank::Shape::Square;
+        case Oscillator::Waveform::Triangle:
+            return WavetableBank::Shape::Triangle;
+        case Oscillator::Waveform::Sawtooth:
+            return WavetableBank::Shape::Sawtooth;
+        default:
+            return WavetableBank::Shape::Sine;
+        }
+    }
+
+    /**
+     * @brief Renders a group of unison voices side by side and stacks them into the note lanes.
+     *
+     * Each sample reads every voice of the group before moving on, so the lane
+     * arrays stay in registers and the compiler can map the lanes onto one
+     * vector; eight voices fill an AVX register of floats. The stack is summed
+     * in the loop, no voice is written out on its own.
+     *
+     * A cross-modulator is read once per sample in the same loop and applied
+     * to every lane: FM offsets the read positions, ring modulation scales the
+     * stack and sync restarts the lanes when the modulator wraps. Each mode is
+     * its own instantiation, so Off costs nothing.
+     * @param left Left note lane, the group's mix is added to it.
+     * @param right Right note lane, or nullptr on a mono bus.
+     * @param numSamples Number of samples to render.
+     * @param positions Table read positions of the group's voices, updated in place.
+     * @param increments Table positions advanced per sample.
+     * @param tables Band-limited table of each voice.
+     * @param leftGains Left gain of each voice, or its mono gain.
+     * @param rightGains Right gain of each voice, unused on a mono bus.
+     * @param modulator Cross-modulator, advanced over the block unless Mode is Off.
+     * @param lookup Callable reading a table at a position.
+     */
+    template <Oscillator::CrossMod Mode, int NumLanes, typename Lookup>
+    void renderUnisonGroup(float* left, float* right, int numSamples, double* positions, const double* increments,
+                           const float* const* tables, const float* leftGains, const float* rightGains,
+                           Modulator& modulator, Lookup&& lookup)
+    {
+        using CrossMod = Oscillator::CrossMod;
+        constexpr double tableSize = static_cast<double>(WavetableBank::tableSize);
+
+        double position[NumLanes];
+        double increment[NumLanes];
+        double syncRatio[NumLanes];
+        float gainLeft[NumLanes];
+        float gainRight[NumLanes];
+
+        for (int lane = 0; lane < NumLanes; ++lane)
+        {
+            position[lane] = positions[lane];
+            increment[lane] = increments[lane];
+            syncRatio[lane] = (Mode == CrossMod::Sync) ? increments[lane] / modulator.increment : 0.0;
+            gainLeft[lane] = leftGains[lane];
+            gainRight[lane] = rightGains[lane];
+        }
+
+        const float* const modulatorTable = modulator.table;
+        double modulatorPosition = modulator.position;
+        const double modulatorIncrement = modulator.increment;
+        const float depth = modulator.depth;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float modulation = 0.0f;
+            bool restart = false;
+            if constexpr (Mode != CrossMod::Off)
+            {
+                modulation = lookup(modulatorTable, modulatorPosition);
+                modulatorPosition += modulatorIncrement;
+                restart = modulatorPosition >= tableSize;
+                modulatorPosition -= restart ? tableSize : 0.0;
+            }
+
+            // A table of bias keeps FM read positions positive, the peak offset is shorter than the table
+            const double readOffset = (Mode == CrossMod::FM) ? tableSize + static_cast<double>(depth * modulation) : 0.0;
+
+            float sample[NumLanes];
+            for (int lane = 0; lane < NumLanes; ++lane)
+            {
+                sample[lane] = lookup(tables[lane], position[lane] + readOffset);
+
+                // Branch-free wrap, a step is always shorter than the table
+                position[lane] += increment[lane];
+                position[lane] -= (position[lane] >= tableSize) ? tableSize : 0.0;
+
+                // Hard sync: restart where the carrier would be had it started with the modulator's new cycle
+                if constexpr (Mode == CrossMod::Sync)
+                    position[lane] = restart ? modulatorPosition * syncRatio[lane] : position[lane];
+            }
+
+            const float ringGain = (Mode == CrossMod::Ring) ? 1.0f - depth + depth * modulation : 1.0f;
+
+            float sumLeft = 0.0f;
+            for (int lane = 0; lane < NumLanes; ++lane)
+                sumLeft += sample[lane] * gainLeft[lane];
+            left[i] += sumLeft * ringGain;
+
+            if (right != nullptr)
+            {
+                float sumRight = 0.0f;
+                for (int lane = 0; lane < NumLanes; ++lane)
+                    sumRight += sample[lane] * gainRight[lane];
+                right[i] += sumRight * ringGain;
+            }
+        }
+
+        for (int lane = 0; lane < NumLanes; ++lane)
+            positions[lane] = position[lane];
+
+        modulator.position = modulatorPosition;
+    }
+
+    /**
+     * @brief Renders any number of unison voices as groups of 8, 4, 2 and 1 lanes.
+     *
+     * A 16-voice supersaw takes two passes over the note lanes, seven voices take three.
+     * Every group starts from the same modulator state, so all voices hear the same modulation.
+     * Parameters as renderUnisonGroup(), for numVoices voices.
+     */
+    template <Oscillator::CrossMod Mode, typename Lookup>
+    void renderUnisonVoices(float* left, float* right, int numSamples, int numVoices, double* positions, const double* increments,
+                            const float* const* tables, const float* leftGains, const float* rightGains,
+                            Modulator& modulator, Lookup&& lookup)
+    {
+        Modulator groupModulator = modulator;
+
+        for (int first = 0; first < numVoices; )
+        {
+            const int remaining = numVoices - first;
+            const auto renderGroup = [&](auto lanes)
+            {
+                constexpr int numLanes = decltype(lanes)::value;
+                groupModulator = modulator;
+                renderUnisonGroup<Mode, numLanes>(left, right, numSamples, positions + first, increments + first,
+                                                  tables + first, leftGains + first, rightGains + first, groupModulator, lookup);
+                first += numLanes;
+            };
+
+            if (remaining >= 8)
+                renderGroup(std::integral_constant<int, 8>{});
+            else if (remaining >= 4)
+                renderGroup(std::integral_constant<int, 4>{});
+            else if (remaining >= 2)
+                renderGroup(std::integral_constant<int, 2>{});
+            else
+                renderGroup(std::integral_constant<int, 1>{});
+        }
+
+        modulator = groupModulator;
+    }
+}
 
 Oscillator::Oscillator(double sampleRate, int i, juce::AudioProcessorValueTreeState& apvtsRef)
     : sampleRate(sampleRate), index(i), apvts(&apvtsRef)
 {
     latestParams.waveform = Waveform::Sine;
     name = getDefaultLinkableName(index);
+
+    // Resolve parameter handles once, so the audio thread never looks IDs up by name
+    handles.waveform = apvts->getRawParameterValue(getComboBoxParamSpecs(ParamID::Waveform, index).paramID);
+    handles.volume = apvts->getRawParameterValue(getKnobParamSpecs(ParamID::Volume, index).id);
+    handles.pan = apvts->getRawParameterValue(getKnobParamSpecs(ParamID::Pan, index).id);
+    handles.voices = apvts->getRawParameterValue(getKnobParamSpecs(ParamID::Voices, index).id);
+    handles.detune = apvts->getRawParameterValue(getKnobParamSpecs(ParamID::Detune, index).id);
+    handles.octave = apvts->getRawParameterValue(getComboBoxParamSpecs(ParamID::Octave, index).paramID);
+    handles.bypass = apvts->getRawParameterValue(getToggleParamSpecs(ParamID::Bypass, index).first);
+    handles.filterRouting = apvts->getRawParameterValue(getComboBoxParamSpecs(ParamID::FilterRouting, index).paramID);
+    handles.crossMod = apvts->getRawParameterValue(getComboBoxParamSpecs(ParamID::CrossMod, index).paramID);
+    handles.crossAmount = apvts->getRawParameterValue(getKnobParamSpecs(ParamID::CrossAmount, index).id);
+    handles.tablePosition = apvts->getRawParameterValue(getKnobParamSpecs(ParamID::TablePosition, index).id);
+    jassert(handles.isComplete());
+    jassert(index == 0 || (handles.crossMod != nullptr && handles.crossAmount != nullptr));
+
+    prepareToPlay(sampleRate);
+}
+
+void Oscillator::prepareToPlay(double newSampleRate)
+{
+    jassert(newSampleRate > 0.0);
+    sampleRate = newSampleRate;
+
+    const double phaseScale = juce::MathConstants<double>::twoPi / sampleRate;
+    for (int midiNote = 0; midiNote < PitchTable::numMidiNotes; ++midiNote)
+        notePhaseIncrements[static_cast<size_t>(midiNote)] = PitchTable::noteToFrequency(midiNote) * phaseScale;
+
+    // Build the ratio table here rather than on the first detuned block
+    PitchTable::getCentRatios();
+
+    latestParams.pan.left.reset(sampleRate, panSmoothingSeconds);
+    latestParams.pan.right.reset(sampleRate, panSmoothingSeconds);
+
+    noise.setSeed(noiseSeed + seedOffset + static_cast<uint32_t>(index));
+
+    // Segments rendered at another rate are of no use
+    if (renderCache.isPrepared())
+    {
+        for (int slot = 0; slot < notes.numActive; ++slot)
+            endRenderCache(slot);
+
+        renderCache.prepare(sampleRate);
+        renderSignature = {};
+    }
+}
+
+void Oscillator::setSeedOffset(uint32_t offset)
+{
+    seedOffset = offset;
 }
 
 KnobParamSpecs Oscillator::getKnobParamSpecs(ParamID id, int oscIndex)
+{
+    static const ParamSpecTable<KnobParamSpecs, ParamID, NUM_OF_OSCILLATORS> table(
+        { ParamID::Volume, ParamID::Pan, ParamID::Voices, ParamID::Detune, ParamID::CrossAmount, ParamID::TablePosition },
+        &makeKnobParamSpecs);
+    return table.get(id, oscIndex);
+}
+
+KnobParamSpecs Oscillator::makeKnobParamSpecs(ParamID id, int oscIndex)
 {
     const juce::String prefix = "OSC" + juce::String(oscIndex + 1) + "_";
 
@@ -30,7 +264,7 @@ KnobParamSpecs Oscillator::getKnobParamSpecs(ParamID id, int oscIndex)
     case ParamID::Voices:
         return {
             prefix + "VOICES", "Voices",
-            1.0f, 8.0f, 1.0f, 1.0f,
+            1.0f, static_cast<float>(maxVoices), 1.0f, 1.0f,
             FormattingUtils::FormatType::Discrete,
             true  // isDiscrete
         };
@@ -42,6 +276,20 @@ KnobParamSpecs Oscillator::getKnobParamSpecs(ParamID id, int oscIndex)
             FormattingUtils::FormatType::Normal
         };
 
+    case ParamID::TablePosition:
+        return {
+            prefix + "TABLE_POSITION", "Position",
+            0.0f, 1.0f, 0.01f, 0.0f,
+            FormattingUtils::FormatType::Normal
+        };
+
+    case ParamID::CrossAmount:
+        return {
+            prefix + "CROSS_AMOUNT", "Cross Mod Amount",
+            0.0f, 1.0f, 0.01f, 0.5f,
+            FormattingUtils::FormatType::Normal
+        };
+
     default:
         jassertfalse;
         return {};
@@ -49,6 +297,14 @@ KnobParamSpecs Oscillator::getKnobParamSpecs(ParamID id, int oscIndex)
 }
 
 ComboBoxParamSpecs Oscillator::getComboBoxParamSpecs(ParamID id, int oscIndex)
+{
+    static const ParamSpecTable<ComboBoxParamSpecs, ParamID, NUM_OF_OSCILLATORS> table(
+        { ParamID::Waveform, ParamID::Octave, ParamID::FilterRouting, ParamID::CrossMod },
+        &makeComboBoxParamSpecs);
+    return table.get(id, oscIndex);
+}
+
+ComboBoxParamSpecs Oscillator::makeComboBoxParamSpecs(ParamID id, int oscIndex)
 {
     const juce::String prefix = "OSC" + juce::String(oscIndex + 1) + "_";
 
@@ -59,7 +315,7 @@ ComboBoxParamSpecs Oscillator::getComboBoxParamSpecs(ParamID id, int oscIndex)
     case ParamID::Waveform:
         spec.paramID = prefix + "WAVEFORM";
         spec.label = "Waveform";
-        spec.choices = { "Sine", "Square", "Triangle", "Sawtooth", "White Noise" };
+        spec.choices = { "Sine", "Square", "Triangle", "Sawtooth", "White Noise", "User Table" };
         spec.defaultIndex = 0;
         break;
 
@@ -70,6 +326,20 @@ ComboBoxParamSpecs Oscillator::getComboBoxParamSpecs(ParamID id, int oscIndex)
         spec.defaultIndex = 2;  // "0" is at index 2
         break;
 
+    case ParamID::FilterRouting:
+        spec.paramID = prefix + "FILTER_ROUTING";
+        spec.label = "Filter Routing";
+        spec.choices = { "Serial", "Parallel" };
+        spec.defaultIndex = 0;
+        break;
+
+    case ParamID::CrossMod:
+        spec.paramID = prefix + "CROSS_MOD";
+        spec.label = "Cross Mod";
+        spec.choices = { "Off", "FM", "Ring", "Sync" };
+        spec.defaultIndex = 0;
+        break;
+
     default:
         jassertfalse;
         break;
@@ -79,6 +349,14 @@ ComboBoxParamSpecs Oscillator::getComboBoxParamSpecs(ParamID id, int oscIndex)
 }
 
 std::pair<juce::String, juce::String> Oscillator::getToggleParamSpecs(ParamID id, int oscIndex)
+{
+    static const ParamSpecTable<std::pair<juce::String, juce::String>, ParamID, NUM_OF_OSCILLATORS> table(
+        { ParamID::Bypass },
+        &makeToggleParamSpecs);
+    return table.get(id, oscIndex);
+}
+
+std::pair<juce::String, juce::String> Oscillator::makeToggleParamSpecs(ParamID id, int oscIndex)
 {
     const juce::String prefix = "OSC" + juce::String(oscIndex + 1) + "_";
 
@@ -133,9 +411,37 @@ void Oscillator::addParameters(int oscIndex, juce::AudioProcessorValueTreeState:
         juce::NormalisableRange<float>(detune.minValue, detune.maxValue, detune.stepSize),
         detune.defaultValue));
 
+    // User table position
+    const auto tablePosition = getKnobParamSpecs(ParamID::TablePosition, oscIndex);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        tablePosition.id, tablePosition.name,
+        juce::NormalisableRange<float>(tablePosition.minValue, tablePosition.maxValue, tablePosition.stepSize),
+        tablePosition.defaultValue));
+
     // Bypass 
     const auto bypass = getToggleParamSpecs(ParamID::Bypass, oscIndex);
     layout.add(std::make_unique<juce::AudioParameterBool>(bypass.first, bypass.second, false));
+
+    // Filter routing ComboBox
+    const auto routingSpec = getComboBoxParamSpecs(ParamID::FilterRouting, oscIndex);
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        routingSpec.paramID, routingSpec.label, routingSpec.choices, routingSpec.defaultIndex));
+
+    // The first oscillator has no oscillator before it to be modulated by
+    if (oscIndex == 0)
+        return;
+
+    // Cross-modulation ComboBox
+    const auto crossModSpec = getComboBoxParamSpecs(ParamID::CrossMod, oscIndex);
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        crossModSpec.paramID, crossModSpec.label, crossModSpec.choices, crossModSpec.defaultIndex));
+
+    // Cross-modulation amount
+    const auto crossAmount = getKnobParamSpecs(ParamID::CrossAmount, oscIndex);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        crossAmount.id, crossAmount.name,
+        juce::NormalisableRange<float>(crossAmount.minValue, crossAmount.maxValue, crossAmount.stepSize),
+        crossAmount.defaultValue));
 }
 
 void Oscillator::processBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
@@ -143,72 +449,80 @@ void Oscillator::processBlock(juce::AudioBuffer<float>& outputBuffer, int startS
     if (isBypassed())
         return;
 
-    const int numChannels = outputBuffer.getNumChannels();
-    const int numVoices = latestParams.voices;
+    if (scratchBuffers == nullptr)
+    {
+        jassertfalse; // setScratchBuffers() must be called before processing
+        return;
+    }
 
-    // Ensure cached buffers match current voice count
-    cachedDetuneCents.resize(numVoices, 0.0);
-    cachedLeftGains.resize(numVoices, 1.0f);
-    cachedRightGains.resize(numVoices, 1.0f);
+    const int numChannels = outputBuffer.getNumChannels();
 
-    // Compute unison detune and stereo pan gains per voice
-    if (numVoices > 1)
-    {
-        float detuneValue = latestParams.detune.getNextValue();
+    updateUnison();
 
-        for (int voice = 0; voice < numVoices; ++voice)
-        {
-            // Spread voices symmetrically around center
-            cachedDetuneCents[voice] = (voice - (numVoices - 1) / 2.0f) * detuneValue * detuneScale;
-
-            // Compute stereo pan gains using sinusoidal spacing
-            float panNorm = static_cast<float>(voice) / static_cast<float>(numVoices - 1);
-            float panAngle = std::sin(panNorm * juce::MathConstants<float>::halfPi);
-            cachedLeftGains[voice] = std::cos(panAngle * juce::MathConstants<float>::halfPi);
-            cachedRightGains[voice] = std::sin(panAngle * juce::MathConstants<float>::halfPi);
-        }
-    }
-    else
-    {
-        // Single voice: center pan, no detune
-        cachedDetuneCents[0] = 0.0;
-        cachedLeftGains[0] = cachedRightGains[0] = 1.0f;
-    }
+    // A polyphonic filter at the head of the chain runs inside renderNotes(), note by note
+    Filter* voiceFilter = getVoiceFilter();
+    const int firstBlockFilter = (voiceFilter != nullptr) ? 1 : 0;
 
-    if (linkedFilter == nullptr)
+    if (numFilters == firstBlockFilter)
     {
         // Write generated signal directly into output buffer
-        for (int i = 0; i < numSamples; ++i)
+        if (numChannels > 0)
         {
-            auto [left, right] = getNextSample();
-
-            if (numChannels > 0)
-                outputBuffer.addSample(0, startSample + i, left);
-            if (numChannels > 1)
-                outputBuffer.addSample(1, startSample + i, right);
+            renderNotes(outputBuffer.getWritePointer(0, startSample),
+                numChannels > 1 ? outputBuffer.getWritePointer(1, startSample) : nullptr,
+                startSample,
+                numSamples,
+                voiceFilter);
         }
 
         return;
     }
 
-    // Filtered path: render into a temp buffer first
-    juce::AudioBuffer<float> tempBuffer(2, numSamples);
+    if (numChannels == 0)
+        return;
+
+    // Filtered path: render into a scratch buffer first, one channel on a mono bus
+    const int numFilterChannels = juce::jmin(numChannels, 2);
+    auto& tempBuffer = scratchBuffers->get(ScratchBuffers::Slot::OscillatorFilter, numFilterChannels, numSamples);
     tempBuffer.clear();
 
-    for (int i = 0; i < numSamples; ++i)
+    renderNotes(tempBuffer.getWritePointer(0), numFilterChannels > 1 ? tempBuffer.getWritePointer(1) : nullptr,
+        startSample, numSamples, voiceFilter);
+
+    if (latestParams.filterRouting == FilterRouting::Parallel)
     {
-        auto [left, right] = getNextSample();
-        tempBuffer.setSample(0, i, left);
-        tempBuffer.setSample(1, i, right);
+        // Every branch filters the dry render, and the branches share the level of one
+        auto& branchBuffer = scratchBuffers->get(ScratchBuffers::Slot::OscillatorBranch, numFilterChannels, numSamples);
+        const float branchGain = 1.0f / static_cast<float>(numFilters);
+
+        for (int f = 0; f < numFilters; ++f)
+        {
+            for (int channel = 0; channel < numFilterChannels; ++channel)
+                branchBuffer.copyFrom(channel, 0, tempBuffer, channel, 0, numSamples);
+
+            juce::dsp::AudioBlock<float> block(branchBuffer);
+            {
+                PROFILE_STAGE(profiler, StageProfiler::Stage::Filter, index);
+                filters[static_cast<size_t>(f)]->process(juce::dsp::ProcessContextReplacing<float>(block));
+            }
+
+            for (int channel = 0; channel < numFilterChannels; ++channel)
+                outputBuffer.addFrom(channel, startSample, branchBuffer, channel, 0, numSamples, branchGain);
+        }
+
+        return;
     }
 
-    // Apply the linked filter
+    // Serial: each filter takes the previous one's output
     juce::dsp::AudioBlock<float> block(tempBuffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
-    linkedFilter->process(context);
+    for (int f = firstBlockFilter; f < numFilters; ++f)
+    {
+        PROFILE_STAGE(profiler, StageProfiler::Stage::Filter, index);
+        filters[static_cast<size_t>(f)]->process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
 
     // Mix filtered samples into output buffer
-    for (int channel = 0; channel < numChannels; ++channel)
+    for (int channel = 0; channel < numFilterChannels; ++channel)
     {
         outputBuffer.addFrom(channel, startSample, tempBuffer, channel, 0, numSamples);
     }
@@ -219,63 +533,50 @@ void Oscillator::updateFromParameters()
     jassert(apvts != nullptr);
 
     // Waveform
-    if (auto* param = apvts->getRawParameterValue(
-        getComboBoxParamSpecs(ParamID::Waveform, index).paramID))
+    if (auto* param = handles.waveform)
     {
         latestParams.waveform = indexToWaveform(static_cast<int>(param->load()));
     }
 
     // Volume
-    if (auto* param = apvts->getRawParameterValue(
-        getKnobParamSpecs(ParamID::Volume, index).id))
+    if (auto* param = handles.volume)
     {
-        float newAmplitude = juce::jlimit(0.0f, defaultAmplitude, param->load());
+        float newAmplitude = juce::jlimit(0.0f, defaultAmplitude,
+            ModulationTarget::apply(volumeModulation, param->load()));
         latestParams.volume = newAmplitude;
     }
 
     // Pan
-    if (auto* param = apvts->getRawParameterValue(
-        getKnobParamSpecs(ParamID::Pan, index).id))
+    if (auto* param = handles.pan)
     {
-        float panValue = juce::jlimit(0.0f, 1.0f, param->load());
+        float panValue = juce::jlimit(0.0f, 1.0f,
+            ModulationTarget::apply(panModulation, param->load()));
         latestParams.pan.left.setTargetValue(1.0f - panValue);
         latestParams.pan.right.setTargetValue(panValue);
     }
 
     // Voices
-    if (auto* param = apvts->getRawParameterValue(
-        getKnobParamSpecs(ParamID::Voices, index).id))
+    if (auto* param = handles.voices)
     {
-        int newVoiceCount = juce::jlimit(1, maxVoices, static_cast<int>(param->load()));
+        int newVoiceCount = juce::jlimit(1, unisonVoiceLimit,
+            static_cast<int>(ModulationTarget::apply(voicesModulation, param->load())));
         if (newVoiceCount != latestParams.voices)
         {
-            // Safely migrate phase data to new size
-            for (auto& [_, note] : notes)
-            {
-                std::vector<double> newPhases(newVoiceCount, 0.0);
-                for (int i = 0; i < std::min<int>(newVoiceCount, note.phases.size()); ++i)
-                    newPhases[i] = note.phases[i];
-                note.phases = std::move(newPhases);
-            }
-
+            // Phases are stored for all maxVoices, so no migration is needed
             latestParams.voices = newVoiceCount;
-            cachedDetuneCents.resize(newVoiceCount, 0.0);
-            cachedLeftGains.resize(newVoiceCount, 1.0f);
-            cachedRightGains.resize(newVoiceCount, 1.0f);
         }
     }
 
     // Detune
-    if (auto* param = apvts->getRawParameterValue(
-        getKnobParamSpecs(ParamID::Detune, index).id))
+    if (auto* param = handles.detune)
     {
-        float detune = juce::jlimit(0.0f, 1.0f, param->load());
+        float detune = juce::jlimit(0.0f, 1.0f,
+            ModulationTarget::apply(detuneModulation, param->load()));
         latestParams.detune.setTargetValue(detune);
     }
 
     // Octave
-    if (auto* param = apvts->getRawParameterValue(
-        getComboBoxParamSpecs(ParamID::Octave, index).paramID))
+    if (auto* param = handles.octave)
     {
         int octave = static_cast<int>(param->load()) - 2; // UI index 2 = octave 0
         if (octave != latestParams.octave)
@@ -288,22 +589,84 @@ void Oscillator::updateFromParameters()
             // Gracefully release all currently active notes
             if (envelope != nullptr)
             {
-                for (auto& [midiNote, noteData] : notes)
-                    envelope->noteOff(midiNote);
+                for (int slot = 0; slot < notes.numActive; ++slot)
+                    envelope->noteOff(notes.midiNotes[slot]);
             }
 
-            // Clear stored note data and reset last-note pointer
+            // Clear stored note data and reset last note
             notes.clear();
-            pLastNote = nullptr;
+            lastNoteMidi = -1;
         }
     }
 
     // Bypass
-    if (auto* param = apvts->getRawParameterValue(
-        getToggleParamSpecs(ParamID::Bypass, index).first))
+    if (auto* param = handles.bypass)
     {
         latestParams.bypass = (param->load() > 0.5f);
     }
+
+    // Filter routing
+    if (auto* param = handles.filterRouting)
+    {
+        latestParams.filterRouting = (param->load() > 0.5f) ? FilterRouting::Parallel : FilterRouting::Serial;
+    }
+
+    // Cross-modulation
+    if (auto* param = handles.crossMod)
+    {
+        latestParams.crossMod = static_cast<CrossMod>(juce::jlimit(0, 3, static_cast<int>(param->load())));
+    }
+
+    if (auto* param = handles.crossAmount)
+    {
+        latestParams.crossAmount = juce::jlimit(0.0f, 1.0f, param->load());
+    }
+
+    // User table, picked up once per block so the render never sees it change
+    userTable = sharedUserTable.load(std::memory_order_acquire);
+
+    if (auto* param = handles.tablePosition)
+    {
+        latestParams.tablePosition = juce::jlimit(0.0f, 1.0f,
+            ModulationTarget::apply(tablePositionModulation, param->load()));
+    }
+    updateUserFrame();
+
+    updateCrossMod();
+}
+
+void Oscillator::updateUserFrame() noexcept
+{
+    userFrame = (userTable != nullptr) ? juce::roundToInt(latestParams.tablePosition * static_cast<float>(userTable->getNumFrames() - 1)) : 0;
+}
+
+void Oscillator::updateCrossMod()
+{
+    crossModState.mode = CrossMod::Off;
+
+    // Noise has no cycle to modulate or to be modulated by, nor has a user table still loading
+    if (modulator == nullptr || latestParams.crossMod == CrossMod::Off || modulator->isBypassed()
+        || latestParams.waveform == Waveform::White_Noise || modulator->latestParams.waveform == Waveform::White_Noise
+        || (latestParams.waveform == Waveform::User && userTable == nullptr))
+        return;
+
+    const bool modulatorIsUser = (modulator->latestParams.waveform == Waveform::User);
+    if (modulatorIsUser && modulator->userTable == nullptr)
+        return;
+
+    crossModState.mode = latestParams.crossMod;
+    crossModState.shape = toTableShape(modulator->latestParams.waveform);
+    crossModState.userTable = modulatorIsUser ? modulator->userTable : nullptr;
+    crossModState.userFrame = modulator->userFrame;
+    crossModState.pitchRatio = std::ldexp(1.0, modulator->latestParams.octave - latestParams.octave);
+    crossModState.depth = (latestParams.crossMod == CrossMod::FM) ? latestParams.crossAmount * static_cast<float>(maxFmIndex)
+                                                                  : latestParams.crossAmount;
+}
+
+void Oscillator::setQualityLimits(int maxUnisonVoices, WavetableBank::Interpolation interpolation) noexcept
+{
+    unisonVoiceLimit = juce::jlimit(1, maxVoices, maxUnisonVoices);
+    tableInterpolation = interpolation;
 }
 
 int Oscillator::getIndex() const
@@ -341,14 +704,128 @@ Envelope* Oscillator::getEnvelope() const
     return envelope;
 }
 
-void Oscillator::setFilter(Filter* filter)
+void Oscillator::setFilters(Filter* const* chainFilters, int count)
+{
+    jassert(count >= 0 && count <= NUM_OF_FILTERS);
+    numFilters = juce::jlimit(0, NUM_OF_FILTERS, count);
+
+    for (int i = 0; i < numFilters; ++i)
+        filters[static_cast<size_t>(i)] = chainFilters[i];
+}
+
+int Oscillator::getNumFilters() const
+{
+    return numFilters;
+}
+
+Filter* Oscillator::getFilter(int position) const
+{
+    return (position >= 0 && position < numFilters) ? filters[static_cast<size_t>(position)] : nullptr;
+}
+
+Filter* Oscillator::getVoiceFilter() const noexcept
+{
+    if (numFilters == 0 || !filters[0]->isPolyphonic())
+        return nullptr;
+
+    return (numFilters == 1 || latestParams.filterRouting == FilterRouting::Serial) ? filters[0] : nullptr;
+}
+
+void Oscillator::setUserWavetable(const UserWavetable* table) noexcept
+{
+    sharedUserTable.store(table, std::memory_order_release);
+}
+
+void Oscillator::setRenderCacheEnabled(bool shouldBeEnabled)
+{
+    NoteRenderCache replacement;
+    if (shouldBeEnabled)
+        prepareRenderCache(replacement);
+
+    swapRenderCache(replacement);
+}
+
+void Oscillator::prepareRenderCache(NoteRenderCache& cache) const
+{
+    cache.prepare(sampleRate);
+}
+
+void Oscillator::swapRenderCache(NoteRenderCache& cache) noexcept
+{
+    if (cache.isPrepared() == renderCache.isPrepared())
+        return;
+
+    for (int slot = 0; slot < notes.numActive; ++slot)
+        endRenderCache(slot);
+
+    renderCache.swap(cache);
+    renderSignature = {};
+}
+
+bool Oscillator::isRenderCacheEnabled() const noexcept
 {
-    linkedFilter = filter;
+    return renderCache.isPrepared();
 }
 
-Filter* Oscillator::getFilter() const
+void Oscillator::setModulator(const Oscillator* newModulator)
 {
-    return linkedFilter;
+    jassert(newModulator != this);
+    modulator = newModulator;
+}
+
+void Oscillator::setScratchBuffers(ScratchBuffers* buffers)
+{
+    scratchBuffers = buffers;
+}
+
+void Oscillator::setModulationTarget(ParamID id, const ModulationTarget* target)
+{
+    switch (id)
+    {
+    case ParamID::Volume:
+        volumeModulation = target;
+        break;
+    case ParamID::Pan:
+        panModulation = target;
+        break;
+    case ParamID::Voices:
+        voicesModulation = target;
+        break;
+    case ParamID::Detune:
+        detuneModulation = target;
+        break;
+    case ParamID::TablePosition:
+        tablePositionModulation = target;
+        break;
+    default:
+        break;
+    }
+}
+
+void Oscillator::applyModulation(int sampleIndex)
+{
+    if (volumeModulation != nullptr)
+        latestParams.volume = juce::jlimit(0.0f, defaultAmplitude,
+            volumeModulation->getValueAt(sampleIndex, latestParams.volume));
+
+    if (panModulation != nullptr)
+    {
+        const float panValue = juce::jlimit(0.0f, 1.0f,
+            panModulation->getValueAt(sampleIndex, latestParams.pan.right.getTargetValue()));
+        latestParams.pan.left.setTargetValue(1.0f - panValue);
+        latestParams.pan.right.setTargetValue(panValue);
+    }
+
+    if (detuneModulation != nullptr)
+        latestParams.detune.setTargetValue(juce::jlimit(0.0f, 1.0f,
+            detuneModulation->getValueAt(sampleIndex, latestParams.detune.getTargetValue())));
+
+    if (tablePositionModulation != nullptr)
+    {
+        latestParams.tablePosition = juce::jlimit(0.0f, 1.0f,
+            tablePositionModulation->getValueAt(sampleIndex, latestParams.tablePosition));
+        updateUserFrame();
+    }
 }
 
 int Oscillator::waveformToIndex(Waveform wf)
@@ -366,173 +843,641 @@ int Oscillator::calculateMidiNoteWithOctaveOffset(int midiNoteNumber) const
     return juce::jlimit(0, 127, midiNoteNumber + (latestParams.octave * 12));
 }
 
-void Oscillator::noteOn(const juce::MidiMessage& message)
+void Oscillator::noteOn(int midiNoteNumber, float velocity, int channel, const NoteExpression::Lanes& expression)
 {
-    if (!message.isNoteOn() || envelope == nullptr)
+    if (envelope == nullptr)
         return;
 
     // apply octave shift
-    int midiNote = calculateMidiNoteWithOctaveOffset(message.getNoteNumber());
-    // normalize velocity 0–1
-    float velocity = message.getVelocity() / 127.0f;
-    // convert to Hz
-    double frequency = juce::MidiMessage::getMidiNoteInHertz(midiNote);
+    int midiNote = calculateMidiNoteWithOctaveOffset(midiNoteNumber);
+
+    // Retrigger keeps the slot (and its phases), otherwise claim a new one
+    int slot = notes.find(midiNote);
+    const bool isRetrigger = (slot >= 0);
+    if (!isRetrigger)
+    {
+        slot = notes.allocate();
 
-    NoteData noteData;
-    noteData.frequency = frequency;
-    noteData.velocity = velocity;
-    noteData.isReleasing = false;
+        // A stolen slot's entry stays with the cache, the new note starts without one
+        notes.cacheEntries[slot] = -1;
+
+        // New note: start its per-voice filter from silence
+        if (numFilters > 0)
+            filters[0]->resetVoice(notes.voiceIds[slot]);
+    }
+
+    notes.midiNotes[slot] = midiNote;
+    notes.velocities[slot] = velocity;
+    notes.ages[slot] = notes.nextAge++;
+    notes.channels[slot] = channel;
+    notes.expressions[slot] = expression;
+
+    // A retrigger keeps gliding to the note it was moved to
+    if (!isRetrigger)
+        notes.glideOffsets[slot] = 0.0f;
 
     // Phase continuity logic
-    // reuse last note phase if matching voice count
-    if (pLastNote && pLastNote->phases.size() == latestParams.voices)
+    // reuse last note phase if it is still playing
+    const int lastSlot = (lastNoteMidi >= 0) ? notes.find(lastNoteMidi) : -1;
+    const bool inheritsPhases = (lastSlot >= 0 && lastSlot != slot);
+    if (inheritsPhases)
     {
-        noteData.phases = pLastNote->phases;
+        // A replaying note's phases only exist once worked out from its position
+        syncRenderCachePhases(lastSlot);
+        endRenderCache(slot);
+        notes.phases[slot] = notes.phases[lastSlot];
     }
-    else
+    else if (!isRetrigger)
     {
-        noteData.phases.resize(latestParams.voices, 0.0);
+        notes.phases[slot].fill(0.0);
     }
 
-    notes[midiNote] = noteData;
-    pLastNote = &notes[midiNote];
+    // The modulator restarts with every new note, so its timbre is the same on every key
+    if (!isRetrigger)
+        notes.modulatorPhases[slot] = 0.0;
+
+    // Only a note starting from phase zero renders like every other one on its key
+    if (!isRetrigger && !inheritsPhases)
+        startRenderCache(slot);
+
+    lastNoteMidi = midiNote;
+}
+
+void Oscillator::noteOff(int midiNoteNumber)
+{
+    if (envelope == nullptr)
+        return;
+
+    int midiNote = calculateMidiNoteWithOctaveOffset(midiNoteNumber);
+
+    // The envelope already released the note at its event sample; only phase continuity is left
+    if (midiNote == lastNoteMidi && notes.find(midiNote) >= 0)
+        lastNoteMidi = -1;
 }
 
-void Oscillator::noteOff(const juce::MidiMessage& message)
+void Oscillator::stopNote(int midiNoteNumber)
 {
-    if (!message.isNoteOff() || envelope == nullptr)
+    const int midiNote = calculateMidiNoteWithOctaveOffset(midiNoteNumber);
+
+    const int slot = notes.find(midiNote);
+    if (slot < 0)
+        return;
+
+    notes.remove(slot);
+
+    if (midiNote == lastNoteMidi)
+        lastNoteMidi = -1;
+}
+
+void Oscillator::glideNote(int fromNoteNumber, int toNoteNumber, float glideSeconds)
+{
+    const int fromNote = calculateMidiNoteWithOctaveOffset(fromNoteNumber);
+    const int toNote = calculateMidiNoteWithOctaveOffset(toNoteNumber);
+    if (fromNote == toNote)
         return;
 
-    int midiNote = calculateMidiNoteWithOctaveOffset(message.getNoteNumber());
+    // A note left on the new key would be played twice
+    if (const int stale = notes.find(toNote); stale >= 0)
+        notes.remove(stale);
 
-    auto noteIter = notes.find(midiNote);
-    if (noteIter != notes.end())
+    const int slot = notes.find(fromNote);
+    if (slot < 0)
+        return;
+
+    // A gliding note leaves the pitch its entry was rendered at
+    endRenderCache(slot);
+
+    // Continue from wherever a previous glide had got to
+    float& offset = notes.glideOffsets[slot];
+    offset += static_cast<float>(fromNote - toNote);
+
+    if (glideSeconds > 0.0f)
+    {
+        notes.glideRates[slot] = std::abs(offset) / static_cast<float>(glideSeconds * sampleRate);
+    }
+    else
     {
-        // wait for zero-cross to release
-        noteIter->second.pendingNoteOff = true;
+        offset = 0.0f;
+        notes.glideRates[slot] = 0.0f;
+    }
+
+    notes.midiNotes[slot] = toNote;
+
+    if (lastNoteMidi == fromNote)
+        lastNoteMidi = toNote;
+}
+
+void Oscillator::updateNoteExpression(const NoteExpression::ChannelState& state) noexcept
+{
+    for (int slot = 0; slot < notes.numActive; ++slot)
+        notes.expressions[slot] = state.getLanes(notes.channels[slot]);
+}
+
+void Oscillator::updateUnison()
+{
+    const int numVoices = latestParams.voices;
+    const float detuneValue = latestParams.detune.getNextValue();
+
+    if (numVoices == cachedUnisonVoices && detuneValue == cachedUnisonDetune)
+        return;
 
-        // clear last note pointer
-        if (&noteIter->second == pLastNote)
-            pLastNote = nullptr;
+    cachedUnisonVoices = numVoices;
+    cachedUnisonDetune = detuneValue;
+
+    // Spread and pan come from the shared table, only the ratios follow the detune
+    const auto& layout = UnisonTable::getLayout(numVoices);
+    for (int voice = 0; voice < numVoices; ++voice)
+    {
+        const float detuneCents = layout.spread[static_cast<size_t>(voice)] * detuneValue * detuneScale;
+        cachedDetuneRatios[static_cast<size_t>(voice)] = numVoices > 1 ? PitchTable::centsToRatio(detuneCents) : 1.0;
     }
 }
 
-std::pair<float, float> Oscillator::getNextSample()
+void Oscillator::renderNotes(float* left, float* right, int startSample, int numSamples, Filter* voiceFilter)
 {
     // Nothing to play
-    if (notes.empty() || envelope == nullptr)
-        return { 0.0f, 0.0f };
+    if (notes.numActive == 0 || envelope == nullptr)
+        return;
 
-    float leftSum = 0.0f;
-    float rightSum = 0.0f;
-    const int numVoices = latestParams.voices;
+    auto& scratchBuffer = scratchBuffers->get(ScratchBuffers::Slot::OscillatorLanes, numScratchChannels, numSamples);
+
+    float* voiceData = scratchBuffer.getWritePointer(scratchVoice);
+    float* noteLeft = scratchBuffer.getWritePointer(scratchNoteLeft);
+    float* noteRight = scratchBuffer.getWritePointer(scratchNoteRight);
+    float* noteGain = scratchBuffer.getWritePointer(scratchNoteGain);
+    float* mixLeft = scratchBuffer.getWritePointer(scratchMixLeft);
+    float* mixRight = scratchBuffer.getWritePointer(scratchMixRight);
+    float* panLeft = scratchBuffer.getWritePointer(scratchPanLeft);
+    float* panRight = scratchBuffer.getWritePointer(scratchPanRight);
+
+    // A mono bus gets the centred downmix in a single lane: no right lane, no pan and a one-channel filter
+    const bool isStereo = (right != nullptr);
+
+    updateRenderCache(isStereo);
 
-    for (auto& [midiNote, note] : notes)
+    juce::FloatVectorOperations::clear(mixLeft, numSamples);
+    if (isStereo)
+        juce::FloatVectorOperations::clear(mixRight, numSamples);
+
+    // Smoothed pan ramps for the block, constants once the pan has settled
+    const auto panLeftRamp = isStereo ? GainRamp::render(latestParams.pan.left, panLeft, numSamples) : GainRamp::Ramp{};
+    const auto panRightRamp = isStereo ? GainRamp::render(latestParams.pan.right, panRight, numSamples) : GainRamp::Ramp{};
+
+    // Unison normalization is identical for every note and precomputed per voice count
+    const float gain = latestParams.volume * UnisonTable::getLayout(latestParams.voices).normalization;
+
+    for (int slot = 0; slot < notes.numActive; ++slot)
     {
-        if (note.phases.size() < numVoices)
-            continue;
+        const int midiNote = notes.midiNotes[slot];
+        const float velocity = notes.velocities[slot];
+        const auto& expression = notes.expressions[slot];
+        double notePhaseIncrement = notePhaseIncrements[static_cast<size_t>(midiNote)] * expression.getPitchRatio();
 
-        // Get current envelope value for this note
-        float env = envelope->getNextSampleForNote(midiNote);
+        float& glideOffset = notes.glideOffsets[slot];
 
-        float totalGain = 0.0f;
-        float voiceLeft = 0.0f;
-        float voiceRight = 0.0f;
-        float sumSample = 0.0f;
+        // Bent or gliding, the note no longer plays what its entry holds
+        if (notes.cacheEntries[slot] >= 0 && (glideOffset != 0.0f || expression.getPitchRatio() != 1.0))
+            endRenderCache(slot);
 
-        for (int voice = 0; voice < numVoices; ++voice)
+        juce::FloatVectorOperations::clear(noteLeft, numSamples);
+        if (isStereo)
+            juce::FloatVectorOperations::clear(noteRight, numSamples);
+
+        // Glide in steps of glideStepSamples, so the pitch moves smoothly however long the segment is
+        for (int offset = 0; offset < numSamples;)
         {
-            // Apply detune in cents (if needed)
-            double freq = note.frequency;
-            if (numVoices > 1)
-                freq *= std::pow(2.0, cachedDetuneCents[voice] / 1200.0);
+            const int length = (glideOffset != 0.0f) ? juce::jmin(glideStepSamples, numSamples - offset) : numSamples - offset;
+            const double increment = (glideOffset != 0.0f) ? notePhaseIncrement * PitchTable::semitonesToRatio(glideOffset) : notePhaseIncrement;
 
-            // Generate waveform and apply velocity and envelope
-            float s = generateWaveSample(freq, note.phases[voice]) * note.velocity * env;
+            renderCachedUnison(slot, noteLeft + offset, isStereo ? noteRight + offset : nullptr, voiceData, length, increment);
+            offset += length;
 
-            sumSample += s;
-            voiceLeft += s * cachedLeftGains[voice];
-            voiceRight += s * cachedRightGains[voice];
+            if (glideOffset != 0.0f)
+            {
+                const float glideStep = notes.glideRates[slot] * static_cast<float>(length);
+                glideOffset = (glideOffset > 0.0f) ? juce::jmax(0.0f, glideOffset - glideStep)
+                                                   : juce::jmin(0.0f, glideOffset + glideStep);
+            }
+        }
+
+        // Releases start at their event sample inside the envelope, so one read covers the segment
+        envelope->renderNote(midiNote, noteGain, startSample, numSamples);
+        juce::FloatVectorOperations::multiply(noteGain, velocity, numSamples);
 
-            totalGain += cachedLeftGains[voice] * cachedLeftGains[voice]
-                + cachedRightGains[voice] * cachedRightGains[voice];
+        if (voiceFilter == nullptr)
+        {
+            juce::FloatVectorOperations::addWithMultiply(mixLeft, noteLeft, noteGain, numSamples);
+            if (isStereo)
+                juce::FloatVectorOperations::addWithMultiply(mixRight, noteRight, noteGain, numSamples);
+            continue;
         }
 
-        // Trigger noteOff at zero-crossing
-        if (note.pendingNoteOff && note.lastSample * sumSample < 0.0f)
+        // Poly filtering: finish this note's gain staging, then run it through its own filter voice
+        juce::FloatVectorOperations::multiply(noteGain, gain, numSamples);
+        juce::FloatVectorOperations::multiply(noteLeft, noteGain, numSamples);
+        panLeftRamp.applyTo(noteLeft, numSamples);
+        if (isStereo)
         {
-            envelope->noteOff(midiNote);
-            note.pendingNoteOff = false;
+            juce::FloatVectorOperations::multiply(noteRight, noteGain, numSamples);
+            panRightRamp.applyTo(noteRight, numSamples);
         }
 
-        note.lastSample = sumSample;
+        float* noteChannels[] = { noteLeft, noteRight };
+        juce::dsp::AudioBlock<float> noteBlock(noteChannels, isStereo ? 2 : 1, static_cast<size_t>(numSamples));
+        {
+            PROFILE_STAGE(profiler, StageProfiler::Stage::Filter, index);
+            voiceFilter->processVoice(notes.voiceIds[slot], juce::dsp::ProcessContextReplacing<float>(noteBlock),
+                expression.getCutoffOctaves());
+        }
 
-        // Normalize summed signal and add to output
-        float gain = (totalGain > 0.0f)
-            ? latestParams.volume / std::sqrt(totalGain)
-            : 0.0f;
+        juce::FloatVectorOperations::add(mixLeft, noteLeft, numSamples);
+        if (isStereo)
+            juce::FloatVectorOperations::add(mixRight, noteRight, numSamples);
+    }
 
-        leftSum += voiceLeft * gain;
-        rightSum += voiceRight * gain;
+    if (voiceFilter != nullptr)
+    {
+        // Pan and normalization were applied per note before filtering
+        juce::FloatVectorOperations::add(left, mixLeft, numSamples);
+        if (right != nullptr)
+            juce::FloatVectorOperations::add(right, mixRight, numSamples);
+        return;
     }
 
-    // Apply smoothed pan gain
-    return {
-        leftSum * latestParams.pan.left.getNextValue(),
-        rightSum * latestParams.pan.right.getNextValue()
-    };
+    // Apply smoothed pan gain and normalization, then add to the destination
+    panLeftRamp.applyTo(mixLeft, numSamples, gain);
+    juce::FloatVectorOperations::add(left, mixLeft, numSamples);
+
+    if (right != nullptr)
+    {
+        panRightRamp.applyTo(mixRight, numSamples, gain);
+        juce::FloatVectorOperations::add(right, mixRight, numSamples);
+    }
+}
+
+bool Oscillator::RenderSignature::operator==(const RenderSignature& other) const noexcept
+{
+    return cacheable == other.cacheable && stereo == other.stereo && waveform == other.waveform
+        && voices == other.voices && detune == other.detune
+        && userTable == other.userTable && userFrame == other.userFrame && interpolation == other.interpolation
+        && crossMod.mode == other.crossMod.mode && crossMod.shape == other.crossMod.shape
+        && crossMod.userTable == other.crossMod.userTable && crossMod.userFrame == other.crossMod.userFrame
+        && crossMod.pitchRatio == other.crossMod.pitchRatio && crossMod.depth == other.crossMod.depth;
+}
+
+Oscillator::RenderSignature Oscillator::getRenderSignature(bool isStereo) const noexcept
+{
+    RenderSignature signature;
+    signature.cacheable = latestParams.waveform != Waveform::White_Noise
+        && (latestParams.waveform != Waveform::User || userTable != nullptr);
+    signature.stereo = isStereo;
+    signature.waveform = latestParams.waveform;
+    signature.voices = latestParams.voices;
+    signature.detune = cachedUnisonDetune;
+    signature.userTable = userTable;
+    signature.userFrame = userFrame;
+    signature.interpolation = tableInterpolation;
+    signature.crossMod = crossModState;
+    return signature;
+}
+
+void Oscillator::updateRenderCache(bool isStereo) noexcept
+{
+    if (!renderCache.isPrepared())
+        return;
+
+    const auto signature = getRenderSignature(isStereo);
+    if (signature == renderSignature)
+        return;
+
+    // Any change makes every entry stale, modulated patches simply never keep one
+    for (int slot = 0; slot < notes.numActive; ++slot)
+        endRenderCache(slot);
+
+    renderCache.clear();
+    renderSignature = signature;
+}
+
+void Oscillator::startRenderCache(int slot) noexcept
+{
+    notes.cacheEntries[slot] = -1;
+
+    if (!renderCache.isPrepared() || !renderSignature.cacheable || notes.expressions[slot].getPitchRatio() != 1.0)
+        return;
+
+    const int midiNote = notes.midiNotes[slot];
+    int entry = renderCache.find(midiNote);
+    const bool capturing = (entry < 0);
+    if (capturing)
+        entry = renderCache.claim(midiNote, getRenderCacheEntriesInUse());
+
+    if (entry < 0)
+        return;
+
+    notes.cacheEntries[slot] = entry;
+    notes.cachePositions[slot] = 0;
+    notes.cacheCapturing[slot] = capturing;
+}
+
+void Oscillator::endRenderCache(int slot) noexcept
+{
+    syncRenderCachePhases(slot);
+    notes.cacheEntries[slot] = -1;
+}
+
+void Oscillator::syncRenderCachePhases(int slot) noexcept
+{
+    // A capturing note renders live, its phases are current
+    const int entryIndex = notes.cacheEntries[slot];
+    if (entryIndex < 0 || notes.cacheCapturing[slot])
+        return;
+
+    constexpr double twoPi = juce::MathConstants<double>::twoPi;
+    const auto& entry = renderCache.getEntry(entryIndex);
+    const double time = static_cast<double>(notes.cachePositions[slot]);
+
+    // Every phase started at zero and moved at a constant rate; synced carriers restart with the modulator's cycle
+    const double modulatorPhase = std::fmod(entry.modulatorIncrement * time, twoPi);
+    auto& phases = notes.phases[slot];
+    for (size_t v = 0; v < phases.size(); ++v)
+    {
+        phases[v] = entry.sync ? std::fmod(modulatorPhase * entry.increments[v] / entry.modulatorIncrement, twoPi)
+                               : std::fmod(entry.increments[v] * time, twoPi);
+    }
+
+    notes.modulatorPhases[slot] = modulatorPhase;
+}
+
+uint32_t Oscillator::getRenderCacheEntriesInUse() const noexcept
+{
+    uint32_t inUse = 0;
+    for (int slot = 0; slot < notes.numActive; ++slot)
+    {
+        if (notes.cacheEntries[slot] >= 0)
+            inUse |= 1u << notes.cacheEntries[slot];
+    }
+    return inUse;
+}
+
+void Oscillator::renderCachedUnison(int slot, float* left, float* right, float* voiceData, int numSamples, double notePhaseIncrement)
+{
+    auto& phases = notes.phases[slot];
+    auto& modulatorPhase = notes.modulatorPhases[slot];
+
+    const int entryIndex = notes.cacheEntries[slot];
+    if (entryIndex < 0)
+    {
+        renderUnison(left, right, voiceData, numSamples, phases, notePhaseIncrement, modulatorPhase);
+        return;
+    }
+
+    auto& entry = renderCache.getEntry(entryIndex);
+    int& position = notes.cachePositions[slot];
+
+    if (!notes.cacheCapturing[slot])
+    {
+        const int numCached = juce::jlimit(0, numSamples, entry.length - position);
+        juce::FloatVectorOperations::copy(left, renderCache.getChannel(entryIndex, 0) + position, numCached);
+        if (right != nullptr)
+            juce::FloatVectorOperations::copy(right, renderCache.getChannel(entryIndex, 1) + position, numCached);
+
+        position += numCached;
+        if (numCached == numSamples)
+            return;
+
+        // The entry ends inside this segment, the rest is rendered live from the same phases
+        endRenderCache(slot);
+        renderUnison(left + numCached, right != nullptr ? right + numCached : nullptr, voiceData, numSamples - numCached,
+                     phases, notePhaseIncrement, modulatorPhase);
+        return;
+    }
+
+    // The increments let a later replay hand its phases back to live rendering
+    if (position == 0)
+    {
+        for (size_t v = 0; v < entry.increments.size(); ++v)
+            entry.increments[v] = static_cast<int>(v) < latestParams.voices ? notePhaseIncrement * cachedDetuneRatios[v] : 0.0;
+
+        entry.modulatorIncrement = (crossModState.mode != CrossMod::Off) ? notePhaseIncrement * crossModState.pitchRatio : 0.0;
+        entry.sync = (crossModState.mode == CrossMod::Sync);
+    }
+
+    renderUnison(left, right, voiceData, numSamples, phases, notePhaseIncrement, modulatorPhase);
+
+    const int numCaptured = juce::jmin(numSamples, renderCache.getCapacity() - position);
+    juce::FloatVectorOperations::copy(renderCache.getChannel(entryIndex, 0) + position, left, numCaptured);
+    if (right != nullptr)
+        juce::FloatVectorOperations::copy(renderCache.getChannel(entryIndex, 1) + position, right, numCaptured);
+
+    position += numCaptured;
+    entry.length = position;
+
+    if (position == renderCache.getCapacity())
+        notes.cacheEntries[slot] = -1;
 }
 
 bool Oscillator::isPlaying() const
 {
-    return !notes.empty();
+    return notes.numActive > 0;
+}
+
+int Oscillator::getNumActiveNotes() const noexcept
+{
+    return notes.numActive;
+}
+
+size_t Oscillator::getMemoryBytes() const noexcept
+{
+    return renderCache.getMemoryBytes();
 }
 
 void Oscillator::removeReleasedNotesIf(std::function<bool(int midiNote)> shouldRemove)
 {
-    for (auto it = notes.begin(); it != notes.end(); )
+    for (int slot = 0; slot < notes.numActive; )
     {
-        const auto& [midiNote, data] = *it;
-
-        if (data.isReleasing && shouldRemove(midiNote))
+        if (shouldRemove(notes.midiNotes[slot]))
         {
-            it = notes.erase(it); // Remove this note
+            // The last slot moves into this one, so check it again
+            notes.remove(slot);
         }
         else
         {
-            ++it;
+            ++slot;
         }
     }
 }
 
-float Oscillator::generateWaveSample(double frequency, double& phase)
+Oscillator::NotePool::NotePool() noexcept
+{
+    clear();
+}
+
+int Oscillator::NotePool::find(int midiNote) const noexcept
 {
-    float sample = 0.0f;
-    // select waveform shape
-    switch (latestParams.waveform)
+    for (int slot = 0; slot < numActive; ++slot)
     {
-    case Waveform::Sine:
-        sample = static_cast<float>(std::sin(phase));
-        break;
-    case Waveform::Square:
-        sample = static_cast<float>((std::sin(phase) >= 0.0) ? 1.0f : -1.0f);
-        break;
-    case Waveform::Triangle:
-        sample = static_cast<float>(2.0f * std::abs(2.0f * (phase / juce::MathConstants<double>::twoPi - std::floor(phase / juce::MathConstants<double>::twoPi + 0.5))) - 1.0f);
-        break;
-    case Waveform::Sawtooth:
-        sample = static_cast<float>(2.0f * (phase / juce::MathConstants<double>::twoPi - std::floor(phase / juce::MathConstants<double>::twoPi + 0.5)));
-        break;
-    case Waveform::White_Noise:
-        sample = juce::Random::getSystemRandom().nextFloat() * 2.0f - 1.0f;
-        break;
+        if (midiNotes[slot] == midiNote)
+            return slot;
     }
+    return -1;
+}
 
-    // advance phase
-    phase += (frequency / sampleRate) * juce::MathConstants<double>::twoPi;
-    // wrap phase at 2pi
-    if (phase >= juce::MathConstants<double>::twoPi)
-        phase -= juce::MathConstants<double>::twoPi;
+int Oscillator::NotePool::allocate() noexcept
+{
+    if (numActive < capacity)
+    {
+        // Voice indices are handed out from the free stack, which has capacity - numActive entries
+        const int slot = numActive++;
+        voiceIds[slot] = freeVoiceIds[capacity - numActive];
+        return slot;
+    }
+
+    // Pool is full: steal the oldest note
+    int oldest = 0;
+    for (int slot = 1; slot < numActive; ++slot)
+    {
+        // Wrap-safe comparison of start order
+        if (static_cast<int32_t>(ages[slot] - ages[oldest]) < 0)
+            oldest = slot;
+    }
+    return oldest;
+}
+
+void Oscillator::NotePool::remove(int slot) noexcept
+{
+    jassert(slot >= 0 && slot < numActive);
+
+    // Return the voice index to the free stack
+    freeVoiceIds[capacity - numActive] = voiceIds[slot];
+
+    const int last = --numActive;
+    if (slot == last)
+        return;
+
+    midiNotes[slot] = midiNotes[last];
+    velocities[slot] = velocities[last];
+    ages[slot] = ages[last];
+    voiceIds[slot] = voiceIds[last];
+    phases[slot] = phases[last];
+    modulatorPhases[slot] = modulatorPhases[last];
+    channels[slot] = channels[last];
+    expressions[slot] = expressions[last];
+    glideOffsets[slot] = glideOffsets[last];
+    glideRates[slot] = glideRates[last];
+    cacheEntries[slot] = cacheEntries[last];
+    cachePositions[slot] = cachePositions[last];
+    cacheCapturing[slot] = cacheCapturing[last];
+}
+
+void Oscillator::NotePool::clear() noexcept
+{
+    numActive = 0;
+
+    for (int i = 0; i < capacity; ++i)
+        freeVoiceIds[i] = i;
+}
+
+void Oscillator::renderUnison(float* left, float* right, float* voiceData, int numSamples,
+                              std::array<double, maxVoices>& phases, double notePhaseIncrement, double& modulatorPhase) const
+{
+    constexpr double twoPi = juce::MathConstants<double>::twoPi;
 
-    return sample;
-}
\ No newline at end of file
+    const int numVoices = latestParams.voices;
+    const auto& layout = UnisonTable::getLayout(numVoices);
+    const float* leftGains = (right != nullptr) ? layout.leftGains.data() : layout.monoGains.data();
+
+    if (latestParams.waveform == Waveform::White_Noise)
+    {
+        // Noise has no table to share, each voice is filled and stacked on its own
+        for (int voice = 0; voice < numVoices; ++voice)
+        {
+            const auto v = static_cast<size_t>(voice);
+            noise.fillBipolar(voiceData, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(left, voiceData, leftGains[v], numSamples);
+            if (right != nullptr)
+                juce::FloatVectorOperations::addWithMultiply(right, voiceData, layout.rightGains[v], numSamples);
+
+            // Keep the phase running so switching back to a periodic shape stays continuous
+            phases[v] = std::fmod(phases[v] + notePhaseIncrement * cachedDetuneRatios[v] * numSamples, twoPi);
+        }
+        return;
+    }
+
+    // A user table still loading plays nothing, its phases hold until it arrives
+    const bool isUser = (latestParams.waveform == Waveform::User);
+    if (isUser && userTable == nullptr)
+        return;
+
+    // select waveform shape once for the whole block
+    const WavetableBank::Shape shape = toTableShape(latestParams.waveform);
+
+    // Table positions for the block, each voice on the band of its own pitch
+    constexpr double phaseToIndex = WavetableBank::tableSize / twoPi;
+    std::array<double, maxVoices> positions;
+    std::array<double, maxVoices> increments;
+    std::array<const float*, maxVoices> tables;
+
+    for (int voice = 0; voice < numVoices; ++voice)
+    {
+        const auto v = static_cast<size_t>(voice);
+        const double phaseIncrement = notePhaseIncrement * cachedDetuneRatios[v];
+        tables[v] = isUser ? userTable->getTable(userFrame, phaseIncrement / twoPi)
+                           : wavetables->getTable(shape, phaseIncrement / twoPi);
+        positions[v] = phases[v] * phaseToIndex;
+        increments[v] = phaseIncrement * phaseToIndex;
+    }
+
+    // The modulator plays the note at its own octave, glide and expression included, undetuned
+    const CrossMod crossMod = crossModState.mode;
+    Modulator crossModulator;
+    if (crossMod != CrossMod::Off)
+    {
+        const double phaseIncrement = notePhaseIncrement * crossModState.pitchRatio;
+        crossModulator.table = (crossModState.userTable != nullptr)
+            ? crossModState.userTable->getTable(crossModState.userFrame, phaseIncrement / twoPi)
+            : wavetables->getTable(crossModState.shape, phaseIncrement / twoPi);
+        crossModulator.position = modulatorPhase * phaseToIndex;
+        crossModulator.increment = phaseIncrement * phaseToIndex;
+        crossModulator.depth = (crossMod == CrossMod::FM) ? crossModState.depth * static_cast<float>(phaseToIndex)
+                                                          : crossModState.depth;
+    }
+
+    const auto render = [&](auto&& lookup)
+    {
+        const auto renderMode = [&](auto mode)
+        {
+            renderUnisonVoices<decltype(mode)::value>(left, right, numSamples, numVoices, positions.data(), increments.data(),
+                                                      tables.data(), leftGains, layout.rightGains.data(), crossModulator, lookup);
+        };
+
+        switch (crossMod)
+        {
+        case CrossMod::FM:
+            renderMode(std::integral_constant<CrossMod, CrossMod::FM>{});
+            break;
+        case CrossMod::Ring:
+            renderMode(std::integral_constant<CrossMod, CrossMod::Ring>{});
+            break;
+        case CrossMod::Sync:
+            renderMode(std::integral_constant<CrossMod, CrossMod::Sync>{});
+            break;
+        default:
+            renderMode(std::integral_constant<CrossMod, CrossMod::Off>{});
+            break;
+        }
+    };
+
+    // One kernel per read mode and cross-modulation, chosen once per block so none branches per sample
+    if (tableInterpolation == WavetableBank::Interpolation::Truncated)
+        render([](const float* table, double position) { return WavetableBank::lookupTruncated(table, position); });
+    else if (tableInterpolation == WavetableBank::Interpolation::Cubic)
+        render([](const float* table, double position) { return WavetableBank::lookupCubic(table, position); });
+    else
+        render([](const float* table, double position) { return WavetableBank::lookup(table, position); });
+
+    for (int voice = 0; voice < numVoices; ++voice)
+        phases[static_cast<size_t>(voice)] = positions[static_cast<size_t>(voice)] / phaseToIndex;
+
+    if (crossMod != CrossMod::Off)
+        modulatorPhase = crossModulator.position / phaseToIndex;
+}
@@ -2,8 +2,18 @@
 
 #include "../../Common.h"
 #include "../Envelope/Envelope.h"
+#include "../FastMath/PitchTable.h"
 #include "../Filter/Filter.h"
+#include "../Knob/ModulationTarget.h"
 #include "../Linkable/Linkable.h"
+#include "../NoiseGenerator/NoiseGenerator.h"
+#include "../NoteExpression/NoteExpression.h"
+#include "../NoteRenderCache/NoteRenderCache.h"
+#include "../ScratchBuffers/ScratchBuffers.h"
+#include "../StageProfiler/StageProfiler.h"
+#include "../UserWavetable/UserWavetable.h"
+#include "UnisonTable.h"
+#include "WavetableBank.h"
 #include <JuceHeader.h>
 
 /**
@@ -13,6 +23,8 @@
 class Oscillator : public Linkable
 {
 public:
+    static constexpr int maxVoices = UnisonTable::maxVoices; ///< Maximum number of unison voices per note
+
     /**
      * @enum Waveform
      * @brief Supported waveform shapes for the oscillator.
@@ -23,7 +35,8 @@ public:
         Square,       ///< Square wave
         Triangle,     ///< Triangle wave
         Sawtooth,     ///< Sawtooth wave
-        White_Noise   ///< White noise
+        White_Noise,  ///< White noise
+        User          ///< Imported wavetable, see setUserWavetable()
     };
 
     /**
@@ -48,7 +61,34 @@ public:
         Detune,   ///< Detune amount
         Waveform, ///< Selected waveform
         Octave,   ///< Octave offset
-        Bypass    ///< Bypass toggle
+        Bypass,   ///< Bypass toggle
+        FilterRouting, ///< How the linked filters combine
+        CrossMod,    ///< How the previous oscillator modulates this one
+        CrossAmount, ///< Depth of the cross-modulation
+        TablePosition, ///< Frame read from a multi-frame user table
+        Count     ///< Number of parameters
+    };
+
+    /**
+     * @enum FilterRouting
+     * @brief How an oscillator runs through more than one linked filter.
+     */
+    enum class FilterRouting
+    {
+        Serial,   ///< Each filter takes the previous one's output
+        Parallel  ///< Each filter takes the dry signal, the branches are summed
+    };
+
+    /**
+     * @enum CrossMod
+     * @brief How an oscillator is modulated by the oscillator before it.
+     */
+    enum class CrossMod
+    {
+        Off,  ///< Plays on its own
+        FM,   ///< The modulator offsets the carrier's phase
+        Ring, ///< The modulator scales the carrier's amplitude
+        Sync  ///< The carrier restarts its cycle whenever the modulator does
     };
 
     /**
@@ -64,6 +104,10 @@ public:
         int octave = 0;                           ///< Octave offset
         Waveform waveform = Waveform::Sine;       ///< Waveform shape
         bool bypass = false;                      ///< Whether bypassed
+        FilterRouting filterRouting = FilterRouting::Serial; ///< How the linked filters combine
+        CrossMod crossMod = CrossMod::Off;        ///< Cross-modulation by the modulator
+        float crossAmount = 0.5f;                 ///< Cross-modulation depth [0, 1]
+        float tablePosition = 0.0f;               ///< Position in the user table's frames [0, 1]
     };
 
     /**
@@ -74,6 +118,25 @@ public:
      */
     Oscillator(double sampleRate, int index, juce::AudioProcessorValueTreeState& apvtsRef);
 
+    /**
+     * @brief Adopts the host sample rate and recomputes the per-rate constants.
+     *
+     * Rebuilds the phase increment of every MIDI note and the pan smoothing
+     * time, and reseeds the noise so every render from here on is identical.
+     * Call from prepareToPlay(), never while the audio thread is running.
+     *
+     * @param newSampleRate Audio sample rate in Hz.
+     */
+    void prepareToPlay(double newSampleRate);
+
+    /**
+     * @brief Offsets the noise seed, so renders with different offsets differ but each one repeats.
+     *
+     * Takes effect at the next prepareToPlay(). Offset 0 is the built-in seed.
+     * @param offset Value added to the seed.
+     */
+    void setSeedOffset(uint32_t offset);
+
     /**
      * @brief Returns parameter spec for a given knob parameter.
      * @param id The parameter ID.
@@ -118,6 +181,13 @@ public:
      */
     void updateFromParameters();
 
+    /**
+     * @brief Caps the rendering cost, applied from the next updateFromParameters().
+     * @param maxUnisonVoices Unison voices rendered at most, whatever the Voices parameter says.
+     * @param interpolation How the wavetables are read between their samples.
+     */
+    void setQualityLimits(int maxUnisonVoices, WavetableBank::Interpolation interpolation) noexcept;
+
     /**
      * @brief Returns the oscillator index.
      * @return The 0-based index.
@@ -151,6 +221,8 @@ public:
 
     /**
      * @brief Links an envelope module to the oscillator.
+     *
+     * Audio thread, applied from the processor's SignalGraph program.
      * @param newEnvelope Pointer to the envelope.
      */
     void setEnvelope(Envelope* newEnvelope) override;
@@ -162,16 +234,103 @@ public:
     Envelope* getEnvelope() const;
 
     /**
-     * @brief Links a filter to the oscillator.
-     * @param filter Pointer to the filter module.
+     * @brief Sets the filters the oscillator runs through, in signal order.
+     *
+     * Audio thread, applied from the processor's SignalGraph program.
+     * @param chainFilters The filters, may be nullptr if count is 0.
+     * @param count Number of filters, at most NUM_OF_FILTERS.
+     */
+    void setFilters(Filter* const* chainFilters, int count);
+
+    /**
+     * @brief Returns the number of linked filters.
+     */
+    int getNumFilters() const;
+
+    /**
+     * @brief Returns a linked filter.
+     * @param position Position of the filter in the chain.
+     * @return Pointer to the filter, or nullptr if out of range.
+     */
+    Filter* getFilter(int position) const;
+
+    /**
+     * @brief Sets the oscillator that cross-modulates this one.
+     *
+     * The modulator is not rendered into a buffer of its own: each note of
+     * this oscillator reads the modulator's waveform and octave and runs a
+     * modulator phase next to its carrier voices, in the same pass. Call once
+     * at construction, the modulator must update its parameters first.
+     * @param newModulator The modulating oscillator, or nullptr.
+     */
+    void setModulator(const Oscillator* newModulator);
+
+    /**
+     * @brief Sets the imported table the User waveform plays. Any thread.
+     *
+     * Picked up by the next updateFromParameters(). The table must outlive
+     * the oscillator, which UserWavetableLibrary guarantees. Until a table is
+     * set the User waveform is silent.
+     * @param table The table, or nullptr.
      */
-    void setFilter(Filter* filter);
+    void setUserWavetable(const UserWavetable* table) noexcept;
 
     /**
-     * @brief Returns the linked filter module.
-     * @return Pointer to the filter, or nullptr if none.
+     * @brief Enables or disables the note render cache, see NoteRenderCache.
+     *
+     * With the cache on, a note starting from phase zero on an unchanged patch
+     * replays the unison stack the first note on its key rendered, then goes
+     * on live. Allocates or frees the cache, so call only while the audio
+     * thread is kept out.
+     * @param shouldBeEnabled True to cache notes.
      */
-    Filter* getFilter() const;
+    void setRenderCacheEnabled(bool shouldBeEnabled);
+
+    /**
+     * @brief Allocates a note render cache for this oscillator's sample rate. Not real-time safe.
+     * @param cache Receives the storage, to be handed over with swapRenderCache().
+     */
+    void prepareRenderCache(NoteRenderCache& cache) const;
+
+    /**
+     * @brief Swaps in a cache built off the audio thread, enabling or disabling caching without allocating.
+     * @param cache A prepared cache to enable, a released one to disable; receives the previous cache for freeing.
+     */
+    void swapRenderCache(NoteRenderCache& cache) noexcept;
+
+    /**
+     * @brief Returns true if the note render cache is enabled.
+     */
+    bool isRenderCacheEnabled() const noexcept;
+
+    /**
+     * @brief Sets the shared scratch buffers used for block rendering.
+     * @param buffers Pointer to the processor-owned scratch buffers.
+     */
+    void setScratchBuffers(ScratchBuffers* buffers);
+
+#if STAGE_PROFILING
+    /**
+     * @brief Sets the profiler the linked filter's passes are timed into.
+     * @param newProfiler Processor-owned profiler, or nullptr.
+     */
+    void setProfiler(StageProfiler* newProfiler) { profiler = newProfiler; }
+#endif
+
+    /**
+     * @brief Assigns the modulation proxy of a parameter.
+     * Volume, Pan, Voices, Detune and Table Position read its block value; all but Voices also follow it per sub-block.
+     * @param id The modulated parameter.
+     * @param target Proxy for that parameter, or nullptr to detach.
+     */
+    void setModulationTarget(ParamID id, const ModulationTarget* target);
+
+    /**
+     * @brief Samples the modulation spans at a point of the block.
+     * Called by the processor before rendering each sub-block.
+     * @param sampleIndex Sample index relative to the start of the block.
+     */
+    void applyModulation(int sampleIndex);
 
     /**
      * @brief Converts a waveform enum to integer index.
@@ -195,22 +354,48 @@ public:
     int calculateMidiNoteWithOctaveOffset(int midiNoteNumber) const;
 
     /**
-     * @brief Handles a MIDI note-on message.
-     * @param message The MIDI message.
+     * @brief Starts a note.
+     * @param midiNoteNumber Raw MIDI note, before the octave offset.
+     * @param velocity Note velocity in [0, 1].
+     * @param channel MIDI channel the note plays on, 1 to 16.
+     * @param expression The channel's expression at the time of the note-on.
+     */
+    void noteOn(int midiNoteNumber, float velocity, int channel = NoteExpression::masterChannel,
+        const NoteExpression::Lanes& expression = {});
+
+    /**
+     * @brief Refreshes the expression lanes of every active note from the per-channel state.
+     * @param state Latest expression per MIDI channel.
      */
-    void noteOn(const juce::MidiMessage& message);
+    void updateNoteExpression(const NoteExpression::ChannelState& state) noexcept;
 
     /**
-     * @brief Handles a MIDI note-off message.
-     * @param message The MIDI message.
+     * @brief Forgets a released note for phase continuity.
+     *
+     * The envelope starts the release at the note-off sample itself, its
+     * release never shorter than the micro-fade, so a note-off never waits.
+     * @param midiNoteNumber Raw MIDI note, before the octave offset.
      */
-    void noteOff(const juce::MidiMessage& message);
+    void noteOff(int midiNoteNumber);
 
     /**
-     * @brief Generates the next stereo output sample.
-     * @return A pair of (left, right) samples.
+     * @brief Removes a note at once, after its envelope voice was stopped.
+     * @param midiNoteNumber Raw MIDI note, before the octave offset.
      */
-    std::pair<float, float> getNextSample();
+    void stopNote(int midiNoteNumber);
+
+    /**
+     * @brief Moves a playing note to another key, gliding its pitch there.
+     *
+     * The note keeps its slot, phases and filter voice; only its pitch moves,
+     * linearly in semitones over the glide time. Call after the envelope voice
+     * was moved with Envelope::moveNote().
+     *
+     * @param fromNoteNumber Raw MIDI note the note plays, before the octave offset.
+     * @param toNoteNumber Raw MIDI note it moves to, before the octave offset.
+     * @param glideSeconds Glide time, 0 to jump at once.
+     */
+    void glideNote(int fromNoteNumber, int toNoteNumber, float glideSeconds);
 
     /**
      * @brief Checks whether the oscillator is currently active.
@@ -218,54 +403,318 @@ public:
      */
     bool isPlaying() const;
 
+    /**
+     * @brief Returns the number of notes sounding, released and fading ones included.
+     */
+    int getNumActiveNotes() const noexcept;
+
+    /**
+     * @brief Returns the bytes the oscillator holds beyond its own size, the note render cache.
+     */
+    size_t getMemoryBytes() const noexcept;
+
     /**
      * @brief Removes notes for which the predicate returns true.
+     *
+     * Called once per block, typically with a check that the note's envelope has finished.
      * @param shouldRemove A callback taking a MIDI note number.
      */
     void removeReleasedNotesIf(std::function<bool(int midiNote)> shouldRemove);
 
 private:
-    static constexpr int maxVoices = 8;                  ///< Maximum number of voices supported
+    /** @brief Builds the spec that getKnobParamSpecs() caches. */
+    static KnobParamSpecs makeKnobParamSpecs(ParamID id, int oscIndex);
+
+    /** @brief Builds the spec that getComboBoxParamSpecs() caches. */
+    static ComboBoxParamSpecs makeComboBoxParamSpecs(ParamID id, int oscIndex);
+
+    /** @brief Builds the spec that getToggleParamSpecs() caches. */
+    static std::pair<juce::String, juce::String> makeToggleParamSpecs(ParamID id, int oscIndex);
+
     static constexpr int minOctaveOffset = -2;           ///< Minimum octave shift
     static constexpr int maxOctaveOffset = 2;            ///< Maximum octave shift
     static constexpr float detuneScale = 20.0f;          ///< Detune scaling factor in cents
     static constexpr float defaultAmplitude = 1.0f;      ///< Maximum allowed output amplitude
     static constexpr double defaultSampleRate = 44100.0; ///< Fallback sample rate in Hz
+    static constexpr double panSmoothingSeconds = 0.01;  ///< Ramp time of pan changes
+    static constexpr int glideStepSamples = 32;          ///< Samples the glide pitch holds for between steps
+    static constexpr uint32_t noiseSeed = 0x4f534331u;   ///< Noise seed of the first oscillator, the others add their index
+    uint32_t seedOffset = 0;                             ///< Added to noiseSeed, see setSeedOffset()
 
     const juce::AudioProcessorValueTreeState* apvts = nullptr; ///< Pointer to APVTS
     double sampleRate;                                         ///< Sample rate in Hz
+    std::array<double, PitchTable::numMidiNotes> notePhaseIncrements{};    ///< Radians per sample of every MIDI note at sampleRate
     int index;                                                 ///< Oscillator index
     juce::String name;                                         ///< Linkable name
     Envelope* envelope = nullptr;                              ///< Linked envelope
-    Filter* linkedFilter = nullptr;                            ///< Linked filter
+    const Oscillator* modulator = nullptr;                     ///< Oscillator cross-modulating this one, or nullptr
+    std::array<Filter*, NUM_OF_FILTERS> filters{};             ///< Linked filters in signal order
+    int numFilters = 0;                                        ///< Entries in filters
+    ScratchBuffers* scratchBuffers = nullptr;                  ///< Shared scratch buffers
+#if STAGE_PROFILING
+    StageProfiler* profiler = nullptr;                         ///< Times the filter passes
+#endif
+    mutable NoiseGenerator noise;                              ///< Noise source owned by this oscillator, safe to use from a render worker
+    const ModulationTarget* volumeModulation = nullptr;        ///< Modulation proxy for Volume
+    const ModulationTarget* panModulation = nullptr;           ///< Modulation proxy for Pan
+    const ModulationTarget* voicesModulation = nullptr;        ///< Modulation proxy for Voices
+    const ModulationTarget* detuneModulation = nullptr;        ///< Modulation proxy for Detune
+    const ModulationTarget* tablePositionModulation = nullptr; ///< Modulation proxy for Table Position
+    std::atomic<const UserWavetable*> sharedUserTable{ nullptr }; ///< Table set by setUserWavetable()
+    const UserWavetable* userTable = nullptr;                  ///< Table the User waveform plays this block
+    int userFrame = 0;                                         ///< Frame of userTable at the table position
     Params latestParams;                                       ///< Cached parameters
+    int unisonVoiceLimit = maxVoices;                          ///< Unison cap set by the quality governor
+    WavetableBank::Interpolation tableInterpolation = WavetableBank::Interpolation::Linear; ///< How the tables are read
+
+    /**
+     * @struct ParameterHandles
+     * @brief APVTS value handles resolved once at construction.
+     */
+    struct ParameterHandles
+    {
+        std::atomic<float>* waveform = nullptr; ///< Waveform choice
+        std::atomic<float>* volume = nullptr;   ///< Output gain
+        std::atomic<float>* pan = nullptr;      ///< Stereo pan
+        std::atomic<float>* voices = nullptr;   ///< Unison voice count
+        std::atomic<float>* detune = nullptr;   ///< Unison detune
+        std::atomic<float>* octave = nullptr;   ///< Octave choice
+        std::atomic<float>* bypass = nullptr;   ///< Bypass toggle
+        std::atomic<float>* filterRouting = nullptr; ///< Filter routing choice
+        std::atomic<float>* crossMod = nullptr;      ///< Cross-modulation choice, nullptr on the first oscillator
+        std::atomic<float>* crossAmount = nullptr;   ///< Cross-modulation depth, nullptr on the first oscillator
+        std::atomic<float>* tablePosition = nullptr; ///< User table position
+
+        /**
+         * @brief Returns true if every handle was found in the APVTS, the cross-modulation ones aside.
+         */
+        bool isComplete() const noexcept
+        {
+            return waveform && volume && pan && voices && detune && octave && bypass && filterRouting && tablePosition;
+        }
+    };
+
+    ParameterHandles handles; ///< Cached parameter handles
+    juce::SharedResourcePointer<WavetableBank> wavetables;      ///< Band-limited tables shared by every instance
+
+    /**
+     * @struct NotePool
+     * @brief Fixed-capacity, structure-of-arrays storage for active notes.
+     *
+     * Active notes are packed into slots [0, numActive). Removing a note moves the
+     * last active slot into its place, so iteration stays linear and no operation
+     * allocates. When the pool is full the oldest note is stolen.
+     */
+    struct NotePool
+    {
+        static constexpr int capacity = Envelope::voiceCapacity; ///< Maximum simultaneous notes, fading ones included
+
+        std::array<int, capacity> midiNotes{};                        ///< MIDI note per slot
+        std::array<float, capacity> velocities{};                     ///< Normalized MIDI velocity [0, 1]
+        std::array<uint32_t, capacity> ages{};                        ///< Start order, used to pick a note to steal
+        std::array<int, capacity> voiceIds{};                         ///< Stable per-note voice index (e.g. filter state)
+        std::array<int, capacity> freeVoiceIds{};                     ///< Stack of unused voice indices
+        std::array<std::array<double, maxVoices>, capacity> phases{}; ///< Phase value per unison voice
+        std::array<double, capacity> modulatorPhases{};               ///< Phase of the cross-modulator in radians
+        std::array<int, capacity> channels{};                         ///< MIDI channel the note plays on
+        std::array<NoteExpression::Lanes, capacity> expressions{};    ///< Per-note expression lanes
+        std::array<float, capacity> glideOffsets{};                   ///< Pitch offset from the note in semitones, gliding to 0
+        std::array<float, capacity> glideRates{};                     ///< Semitones per sample the glide offset moves by
+        std::array<int, capacity> cacheEntries{};                     ///< Render cache entry the note replays or captures, -1 for none
+        std::array<int, capacity> cachePositions{};                   ///< Samples of the entry replayed or captured so far
+        std::array<bool, capacity> cacheCapturing{};                  ///< True if the note captures its entry, false if it replays it
+        int numActive = 0;                                            ///< Number of packed active slots
+        uint32_t nextAge = 0;                                         ///< Counter assigned to the next started note
+
+        static_assert(capacity <= Filter::maxVoices, "Every note needs its own filter voice");
+
+        /**
+         * @brief Initializes the free voice index stack.
+         */
+        NotePool() noexcept;
+
+        /**
+         * @brief Finds the slot playing a MIDI note.
+         * @param midiNote MIDI note number.
+         * @return Slot index, or -1 if the note is not active.
+         */
+        int find(int midiNote) const noexcept;
+
+        /**
+         * @brief Claims a slot for a new note, stealing the oldest one if full.
+         *
+         * A stolen slot keeps its voice index.
+         *
+         * @return Slot index.
+         */
+        int allocate() noexcept;
+
+        /**
+         * @brief Releases a slot by moving the last active slot into it.
+         * @param slot Slot index to release.
+         */
+        void remove(int slot) noexcept;
+
+        /**
+         * @brief Removes all notes.
+         */
+        void clear() noexcept;
+    };
+
+    NotePool notes;        ///< Active note pool
+    int lastNoteMidi = -1; ///< Last played MIDI note, used for phase continuity
+
+    /**
+     * @enum ScratchChannel
+     * @brief Channel layout of the OscillatorLanes scratch buffer.
+     */
+    enum ScratchChannel
+    {
+        scratchVoice,       ///< Raw output of the voice currently being rendered
+        scratchNoteLeft,    ///< Left unison sum of the current note
+        scratchNoteRight,   ///< Right unison sum of the current note
+        scratchNoteGain,    ///< Per-sample velocity * envelope gain of the current note
+        scratchMixLeft,     ///< Left sum of all notes
+        scratchMixRight,    ///< Right sum of all notes
+        scratchPanLeft,     ///< Smoothed left pan gain ramp
+        scratchPanRight,    ///< Smoothed right pan gain ramp
+        numScratchChannels  ///< Number of scratch channels
+    };
+
+    /**
+     * @brief Renders all active notes over a contiguous block and adds the result.
+     * @param left Left destination, samples are added to it.
+     * @param right Right destination, samples are added to it (may be nullptr).
+     * @param startSample Position of the block within the host buffer, used for the envelope clock.
+     * @param numSamples Number of samples to render.
+     * @param voiceFilter Filter to run on each note separately, or nullptr.
+     */
+    void renderNotes(float* left, float* right, int startSample, int numSamples, Filter* voiceFilter = nullptr);
+
+    /**
+     * @brief Returns the filter that runs on each note separately, or nullptr.
+     *
+     * A polyphonic filter does so at the head of a serial chain or alone; in
+     * parallel branches it filters the oscillator's sum like any other.
+     */
+    Filter* getVoiceFilter() const noexcept;
+
+    /**
+     * @struct CrossModState
+     * @brief Cross-modulation as rendered, resolved against the modulator once per block.
+     */
+    struct CrossModState
+    {
+        CrossMod mode = CrossMod::Off;                          ///< Off unless a periodic modulator plays into a periodic carrier
+        WavetableBank::Shape shape = WavetableBank::Shape::Sine; ///< Table shape of the modulator
+        const UserWavetable* userTable = nullptr;               ///< Table of a modulator playing the User waveform, else nullptr
+        int userFrame = 0;                                      ///< Frame of userTable
+        double pitchRatio = 1.0;                                ///< Modulator frequency over carrier frequency, from the octaves
+        float depth = 0.0f;                                     ///< FM peak phase offset in radians, or the ring mix
+    };
+
+    CrossModState crossModState; ///< Resolved cross-modulation
+
+    /**
+     * @brief Resolves the cross-modulation from the parameters and the modulator's waveform and octave.
+     */
+    void updateCrossMod();
+
+    /**
+     * @brief Points userFrame at the frame under the table position.
+     */
+    void updateUserFrame() noexcept;
+
+    /**
+     * @brief Renders a note's unison stack with the current waveform and adds it to the note lanes.
+     *
+     * Periodic waveforms read the band-limited table matching each voice's
+     * pitch, with the voices stacked in lanes of up to eight. With
+     * cross-modulation the modulator is read in the same loop, once per sample
+     * for the whole stack.
+     * @param left Left note lane, or the mono lane, samples are added to it.
+     * @param right Right note lane, samples are added to it (may be nullptr).
+     * @param voiceData Scratch buffer for the noise voices, overwritten.
+     * @param numSamples Number of samples to render.
+     * @param phases Phase (in radians) of each voice, updated.
+     * @param notePhaseIncrement Phase advance per sample of the note in radians, before detune.
+     * @param modulatorPhase Phase of the note's cross-modulator in radians, updated.
+     */
+    void renderUnison(float* left, float* right, float* voiceData, int numSamples,
+                      std::array<double, maxVoices>& phases, double notePhaseIncrement, double& modulatorPhase) const;
+
+    /**
+     * @brief Recomputes the unison detune ratios if the voice count or detune changed.
+     *
+     * Pan gains come from UnisonTable. The ratios only move on parameter changes, so the many segments of a dense MIDI
+     * block reuse the ratios of the first one.
+     */
+    void updateUnison();
+
+    std::array<double, maxVoices> cachedDetuneRatios{}; ///< Cached Unison State frequency ratios per voice
+    int cachedUnisonVoices = 0;                         ///< Voice count the ratios were computed for, 0 if never
+    float cachedUnisonDetune = 0.0f;                    ///< Detune value the ratios were computed for
 
     /**
-     * @struct NoteData
-     * @brief Internal state for each MIDI note.
+     * @struct RenderSignature
+     * @brief Everything a note's unison stack depends on besides its key, compared to keep the render cache valid.
      */
-    struct NoteData
+    struct RenderSignature
     {
-        double frequency = 0.0;              ///< Frequency of the note in Hz
-        float velocity = 0.0f;               ///< Normalized MIDI velocity [0, 1]
-        std::vector<double> phases;          ///< Phase value per voice
-        bool isReleasing = false;            ///< Whether the note is in release phase
-        float lastSample = 0.0f;             ///< Last sample used for zero-crossing
-        bool pendingNoteOff = false;         ///< True if noteOff is queued for zero-crossing
+        bool cacheable = false;                                  ///< False for noise and for a user table still loading
+        bool stereo = false;                                     ///< Stereo lanes, or the mono downmix
+        Waveform waveform = Waveform::Sine;                      ///< Carrier waveform
+        int voices = 0;                                          ///< Unison voice count
+        float detune = 0.0f;                                     ///< Unison detune the ratios follow
+        const UserWavetable* userTable = nullptr;                ///< Table of the User waveform
+        int userFrame = 0;                                       ///< Frame of userTable
+        WavetableBank::Interpolation interpolation = WavetableBank::Interpolation::Linear; ///< Table reads
+        CrossModState crossMod;                                  ///< Resolved cross-modulation
+
+        /** @brief Returns true if both render every key identically. */
+        bool operator==(const RenderSignature& other) const noexcept;
     };
 
-    std::unordered_map<int, NoteData> notes; ///< Active note map
-    NoteData* pLastNote = nullptr;           ///< Last played note
+    static_assert(NoteRenderCache::maxVoices >= maxVoices, "A cache entry must hold every unison voice");
+
+    NoteRenderCache renderCache;           ///< Captured note segments, allocated while enabled
+    RenderSignature renderSignature;       ///< What the captured segments were rendered with
+
+    /**
+     * @brief Returns the signature of the current parameters.
+     * @param isStereo True if the notes render into stereo lanes.
+     */
+    RenderSignature getRenderSignature(bool isStereo) const noexcept;
+
+    /**
+     * @brief Clears the render cache if the signature changed, handing every cached note back to live rendering first.
+     */
+    void updateRenderCache(bool isStereo) noexcept;
+
+    /**
+     * @brief Starts a note on its cache entry: replays the key if held, or claims an entry to capture it.
+     */
+    void startRenderCache(int slot) noexcept;
 
     /**
-     * @brief Generates a single waveform sample for a frequency/phase.
-     * @param frequency Frequency in Hz.
-     * @param phase Phase (in radians), passed by reference and updated.
-     * @return The sample value.
+     * @brief Stops a note reading or writing its entry, so it renders live from where it is.
      */
-    float generateWaveSample(double frequency, double& phase);
+    void endRenderCache(int slot) noexcept;
 
-    std::vector<double> cachedDetuneCents; ///< Cached Unison State detune offsets per voice
-    std::vector<float> cachedLeftGains;    ///< Cached Unison State left gain per voice
-    std::vector<float> cachedRightGains;   ///< Cached Unison State right gain per voice
+    /**
+     * @brief Works out the phases a replaying note would have, had it rendered live to its position.
+     */
+    void syncRenderCachePhases(int slot) noexcept;
+
+    /**
+     * @brief Returns a bit per cache entry an active note replays or captures.
+     */
+    uint32_t getRenderCacheEntriesInUse() const noexcept;
+
+    /**
+     * @brief Renders a note's unison stack from its cache entry, live, or live while capturing it.
+     *
+     * Parameters as renderUnison(), for the note in a slot; the note lanes must be cleared.
+     */
+    void renderCachedUnison(int slot, float* left, float* right, float* voiceData, int numSamples, double notePhaseIncrement);
 };
@@ -6,7 +6,8 @@ OscillatorComponent::OscillatorComponent(juce::AudioProcessorValueTreeState& apv
     volumeKnob(apvts, processor, "", "", Knob::KnobParams(), Knob::KnobStyle::Rotary),
     panKnob(apvts, processor, "", "", Knob::KnobParams(), Knob::KnobStyle::Rotary),
     voicesKnob(apvts, processor, "", "", Knob::KnobParams(), Knob::KnobStyle::Rotary),
-    detuneKnob(apvts, processor, "", "", Knob::KnobParams(), Knob::KnobStyle::Rotary)
+    detuneKnob(apvts, processor, "", "", Knob::KnobParams(), Knob::KnobStyle::Rotary),
+    tablePositionKnob(apvts, processor, "", "", Knob::KnobParams(), Knob::KnobStyle::Rotary)
 {
     const auto waveformSpec = Oscillator::getComboBoxParamSpecs(Oscillator::ParamID::Waveform, index);
     const auto octaveSpec = Oscillator::getComboBoxParamSpecs(Oscillator::ParamID::Octave, index);
@@ -53,12 +54,14 @@ OscillatorComponent::OscillatorComponent(juce::AudioProcessorValueTreeState& apv
     setupKnob(panKnob, Oscillator::ParamID::Pan);
     setupKnob(voicesKnob, Oscillator::ParamID::Voices);
     setupKnob(detuneKnob, Oscillator::ParamID::Detune);
+    setupKnob(tablePositionKnob, Oscillator::ParamID::TablePosition);
 
     // Bind knob parameters
     volumeKnob.bindToParameter();
     panKnob.bindToParameter();
     voicesKnob.bindToParameter();
     detuneKnob.bindToParameter();
+    tablePositionKnob.bindToParameter();
 
     // Attachments
     waveformAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
@@ -78,20 +81,6 @@ OscillatorComponent::~OscillatorComponent()
     octaveAttachment.reset();
 }
 
-void OscillatorComponent::registerModulationParameters(int index, juce::AudioProcessorValueTreeState::ParameterLayout& layout)
-{
-    for (Oscillator::ParamID id : {
-        Oscillator::ParamID::Volume,
-            Oscillator::ParamID::Pan,
-            Oscillator::ParamID::Detune,
-            Oscillator::ParamID::Voices
-    })
-    {
-        auto spec = Oscillator::getKnobParamSpecs(id, index);
-        KnobModulationEngine::registerParameters(layout, spec.id);
-    }
-}
-
 int OscillatorComponent::getTotalHeight()
 {
     return titleHeight + selectorHeight + knobRowHeight + 10;
@@ -142,7 +131,8 @@ void OscillatorComponent::resized()
     volumeKnob.setBounds(knobRow.removeFromLeft(knobWidth).reduced(knobSpacing));
     panKnob.setBounds(knobRow.removeFromLeft(knobWidth).reduced(knobSpacing));
     voicesKnob.setBounds(knobRow.removeFromLeft(knobWidth).reduced(knobSpacing));
-    detuneKnob.setBounds(knobRow.reduced(knobSpacing));
+    detuneKnob.setBounds(knobRow.removeFromLeft(knobWidth).reduced(knobSpacing));
+    tablePositionKnob.setBounds(knobRow.reduced(knobSpacing));
 }
 
 void OscillatorComponent::updateTheme()
@@ -159,6 +149,7 @@ void OscillatorComponent::updateTheme()
     panKnob.updateTheme();
     voicesKnob.updateTheme();
     detuneKnob.updateTheme();
+    tablePositionKnob.updateTheme();
 
     octaveSelector.updateTheme();
 
@@ -167,35 +158,19 @@ void OscillatorComponent::updateTheme()
 
 void OscillatorComponent::createWaveformSelector()
 {
-    // Load waveform Drawables
-    waveformImages.emplace_back(juce::Drawable::createFromImageData(BinaryData::Sine_png, BinaryData::Sine_pngSize));
-    waveformImages.emplace_back(juce::Drawable::createFromImageData(BinaryData::Square_png, BinaryData::Square_pngSize));
-    waveformImages.emplace_back(juce::Drawable::createFromImageData(BinaryData::Triangle_png, BinaryData::Triangle_pngSize));
-    waveformImages.emplace_back(juce::Drawable::createFromImageData(BinaryData::Sawtooth_png, BinaryData::Sawtooth_pngSize));
-    waveformImages.emplace_back(juce::Drawable::createFromImageData(BinaryData::WhiteNoise_png, BinaryData::WhiteNoise_pngSize));
-
-    waveformSelector.setImageList(waveformImages);
+    // The icons are decoded and rasterised once per process, shared by every editor
+    waveformSelector.setImageList(waveformIcons->getDrawables());
     waveformSelector.clear(juce::dontSendNotification);
 
     // Get spec for display consistency
     const auto waveformSpec = Oscillator::getComboBoxParamSpecs(Oscillator::ParamID::Waveform, index);
 
-    // Create scaled images for popup menu rendering
-    for (int j = 0; j < waveformImages.size(); ++j)
-    {
-        juce::Image img(juce::Image::ARGB,
-            static_cast<int>(ComboBox::imageWidth * ComboBox::popupImageScaleFactor),
-            static_cast<int>(ComboBox::imageHeight * ComboBox::popupImageScaleFactor),
-            true);
-
-        juce::Graphics g(img);
-        g.addTransform(juce::AffineTransform::scale(ComboBox::popupImageScaleFactor));
-        waveformImages[j]->drawWithin(g,
-            juce::Rectangle<float>(0, 0, ComboBox::imageWidth, ComboBox::imageHeight),
-            juce::RectanglePlacement::centred, 1.0f);
-
-        waveformSelector.getRootMenu()->addItem(j + 1, "", true, false, img);
-    }
+    for (int j = 0; j < WaveformIcons::numIcons; ++j)
+        waveformSelector.getRootMenu()->addItem(j + 1, "", true, false, waveformIcons->getPopupImage(j));
+
+    // Choices past the icons, the imported table, are listed by name
+    for (int j = WaveformIcons::numIcons; j < waveformSpec.choices.size(); ++j)
+        waveformSelector.getRootMenu()->addItem(j + 1, waveformSpec.choices[j]);
 
     waveformSelector.setSelectedId(waveformSpec.defaultIndex + 1);
 }
@@ -5,6 +5,7 @@
 #include "../Knob/Knob.h"
 #include "../ComboBox/ComboBox.h"
 #include "Oscillator.h"
+#include "WaveformIcons.h"
 #include <JuceHeader.h>
 
 /**
@@ -26,13 +27,6 @@ public:
     /** @brief Destructor. Resets APVTS attachments. */
     ~OscillatorComponent() override;
 
-    /**
-     * @brief Registers modulation parameters for all knobs.
-     * @param index Oscillator index.
-     * @param layout Reference to the APVTS parameter layout.
-     */
-    static void registerModulationParameters(int index, juce::AudioProcessorValueTreeState::ParameterLayout& layout);
-
     /**
      * @brief Returns the total height required by the component.
      * @return Height in pixels.
@@ -90,7 +84,7 @@ private:
     static constexpr int selectorWidth = 90;        ///< Width of each selector label
 
     static constexpr int knobRowHeight = 120;       ///< Height of the knob row
-    static constexpr int numKnobs = 4;              ///< Number of knobs in layout
+    static constexpr int numKnobs = 5;              ///< Number of knobs in layout
 
     juce::Label titleLabel;                         ///< Title label
     juce::ToggleButton bypassButton;                ///< Bypass toggle button
@@ -103,8 +97,9 @@ private:
     Knob panKnob;                                   ///< Stereo pan knob
     Knob voicesKnob;                                ///< Polyphony count knob
     Knob detuneKnob;                                ///< Unison detune knob
+    Knob tablePositionKnob;                         ///< User table position knob
 
-    std::vector<std::unique_ptr<juce::Drawable>> waveformImages; ///< Cached waveform icons
+    juce::SharedResourcePointer<WaveformIcons> waveformIcons; ///< Waveform icons shared by every editor
 
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> bypassAttachment;     ///< APVTS attachment for bypass
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> waveformAttachment; ///< APVTS attachment for waveform
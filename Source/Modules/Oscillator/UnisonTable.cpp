@@ -0,0 +1,49 @@
+#include "UnisonTable.h"
+
+namespace
+{
+    constexpr float monoDownmixGain = 0.25f;    // Centre pan gain times the average of a voice's left and right gains
+}
+
+UnisonTable::UnisonTable()
+{
+    constexpr float halfPi = juce::MathConstants<float>::halfPi;
+
+    for (int numVoices = 1; numVoices <= maxVoices; ++numVoices)
+    {
+        auto& layout = layouts[static_cast<size_t>(numVoices - 1)];
+        float sumOfSquares = 0.0f;
+
+        for (int voice = 0; voice < numVoices; ++voice)
+        {
+            const auto v = static_cast<size_t>(voice);
+
+            if (numVoices > 1)
+            {
+                // Spread voices symmetrically around the centre, panned with sinusoidal spacing
+                const float panNorm = static_cast<float>(voice) / static_cast<float>(numVoices - 1);
+                const float panAngle = std::sin(panNorm * halfPi);
+
+                layout.spread[v] = static_cast<float>(voice) - static_cast<float>(numVoices - 1) * 0.5f;
+                layout.leftGains[v] = std::cos(panAngle * halfPi);
+                layout.rightGains[v] = std::sin(panAngle * halfPi);
+            }
+            else
+            {
+                // Single voice: centre pan, no detune
+                layout.leftGains[v] = layout.rightGains[v] = 1.0f;
+            }
+
+            layout.monoGains[v] = monoDownmixGain * (layout.leftGains[v] + layout.rightGains[v]);
+            sumOfSquares += layout.leftGains[v] * layout.leftGains[v] + layout.rightGains[v] * layout.rightGains[v];
+        }
+
+        layout.normalization = 1.0f / std::sqrt(sumOfSquares);
+    }
+}
+
+const UnisonTable::Layout& UnisonTable::getLayout(int numVoices) noexcept
+{
+    static const UnisonTable table;
+    return table.layouts[static_cast<size_t>(juce::jlimit(1, maxVoices, numVoices) - 1)];
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * @class UnisonTable
+ * @brief Spread, pan gains and level normalization of every unison voice count, built once per process.
+ *
+ * None of these depend on anything but the voice count, so the oscillators
+ * read them from here instead of evaluating the pan law whenever the count
+ * changes. Only the detune ratios, which also follow the DETUNE knob, are
+ * left for the oscillator to compute.
+ */
+class UnisonTable
+{
+public:
+    static constexpr int maxVoices = 16;  ///< Unison voices per note at most
+
+    /**
+     * @struct Layout
+     * @brief Placement of the voices of one voice count, entries past the count are unused.
+     */
+    struct Layout
+    {
+        std::array<float, maxVoices> spread{};      ///< Offset of each voice from the centre, in detune steps
+        std::array<float, maxVoices> leftGains{};   ///< Left pan gain of each voice
+        std::array<float, maxVoices> rightGains{};  ///< Right pan gain of each voice
+        std::array<float, maxVoices> monoGains{};   ///< Gain of each voice on a mono bus, the centred downmix
+        float normalization = 1.0f;                 ///< Reciprocal RMS of the stereo gains, keeps the stack's level steady
+    };
+
+    /**
+     * @brief Returns the layout of a voice count.
+     * @param numVoices Voice count, clamped to [1, maxVoices].
+     */
+    static const Layout& getLayout(int numVoices) noexcept;
+
+private:
+    /**
+     * @brief Evaluates the pan law for every voice count.
+     */
+    UnisonTable();
+
+    std::array<Layout, maxVoices> layouts;  ///< Layouts by voice count minus one
+};
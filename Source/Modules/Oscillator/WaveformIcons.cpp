@@ -0,0 +1,54 @@
+#include "WaveformIcons.h"
+#include "../ComboBox/ComboBox.h"
+
+namespace
+{
+    struct IconData
+    {
+        const char* data;  ///< PNG bytes in BinaryData
+        int size;          ///< Number of bytes
+    };
+
+    const std::array<IconData, WaveformIcons::numIcons> iconData{ {
+        { BinaryData::Sine_png, BinaryData::Sine_pngSize },
+        { BinaryData::Square_png, BinaryData::Square_pngSize },
+        { BinaryData::Triangle_png, BinaryData::Triangle_pngSize },
+        { BinaryData::Sawtooth_png, BinaryData::Sawtooth_pngSize },
+        { BinaryData::WhiteNoise_png, BinaryData::WhiteNoise_pngSize }
+    } };
+}
+
+WaveformIcons::WaveformIcons()
+{
+    const int popupWidth = static_cast<int>(ComboBox::imageWidth * ComboBox::popupImageScaleFactor);
+    const int popupHeight = static_cast<int>(ComboBox::imageHeight * ComboBox::popupImageScaleFactor);
+
+    for (size_t i = 0; i < iconData.size(); ++i)
+    {
+        // ImageCache keys on the data, so the pixels are decoded once however many copies exist
+        const auto image = juce::ImageCache::getFromMemory(iconData[i].data, iconData[i].size);
+
+        auto drawable = std::make_unique<juce::DrawableImage>();
+        drawable->setImage(image);
+
+        popupImages[i] = juce::Image(juce::Image::ARGB, popupWidth, popupHeight, true);
+        juce::Graphics g(popupImages[i]);
+        g.addTransform(juce::AffineTransform::scale(ComboBox::popupImageScaleFactor));
+        drawable->drawWithin(g,
+            juce::Rectangle<float>(0, 0, ComboBox::imageWidth, ComboBox::imageHeight),
+            juce::RectanglePlacement::centred, 1.0f);
+
+        drawables.push_back(std::move(drawable));
+    }
+}
+
+const std::vector<std::unique_ptr<juce::Drawable>>& WaveformIcons::getDrawables() const noexcept
+{
+    return drawables;
+}
+
+const juce::Image& WaveformIcons::getPopupImage(int index) const noexcept
+{
+    jassert(index >= 0 && index < numIcons);
+    return popupImages[static_cast<size_t>(index)];
+}
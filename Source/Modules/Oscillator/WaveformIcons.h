@@ -0,0 +1,45 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+/**
+ * @class WaveformIcons
+ * @brief Decoded waveform selector icons, shared by every oscillator editor in the process.
+ *
+ * Held through juce::SharedResourcePointer: the first editor to open decodes
+ * the PNGs from BinaryData through juce::ImageCache and rasterises the popup
+ * menu variants at the popup scale, every later editor reuses them, and the
+ * last one to close frees them. Opening an editor again decodes nothing.
+ */
+class WaveformIcons
+{
+public:
+    static constexpr int numIcons = 5; ///< Sine, Square, Triangle, Sawtooth and White Noise, in waveform order
+
+    /**
+     * @brief Decodes the icons and renders their popup variants. Message thread only.
+     */
+    WaveformIcons();
+
+    /**
+     * @brief Returns the icons as Drawables, in waveform order.
+     *
+     * The Drawables are never added to a component, only drawn, so every
+     * selector can point at the same ones.
+     */
+    const std::vector<std::unique_ptr<juce::Drawable>>& getDrawables() const noexcept;
+
+    /**
+     * @brief Returns an icon rasterised at the popup menu scale.
+     * @param index Waveform index.
+     */
+    const juce::Image& getPopupImage(int index) const noexcept;
+
+private:
+    std::vector<std::unique_ptr<juce::Drawable>> drawables; ///< Icons wrapping the cached images
+    std::array<juce::Image, numIcons> popupImages;          ///< Icons pre-rendered for the popup menu
+
+    JUCE_DECLARE_NON_COPYABLE(WaveformIcons)
+};
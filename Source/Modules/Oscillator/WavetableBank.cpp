@@ -0,0 +1,89 @@
+#include "WavetableBank.h"
+
+WavetableBank::WavetableBank()
+{
+    // One exact sine period, so harmonic k at index n is sine[(k * n) % tableSize]
+    std::vector<double> sine(tableSize);
+    for (int n = 0; n < tableSize; ++n)
+        sine[n] = std::sin(juce::MathConstants<double>::twoPi * n / tableSize);
+
+    const int mask = tableSize - 1;
+    const int quarter = tableSize / 4;
+    std::vector<double> accum(tableSize);
+
+    for (int shapeIndex = 0; shapeIndex < static_cast<int>(Shape::Count); ++shapeIndex)
+    {
+        const auto shape = static_cast<Shape>(shapeIndex);
+        auto& bands = tables[shapeIndex];
+
+        std::fill(accum.begin(), accum.end(), 0.0);
+        int harmonicsDone = 0;
+
+        // Build from the top band down, each lower band adds harmonics to the previous one
+        for (int band = numBands - 1; band >= 0; --band)
+        {
+            const int harmonics = (shape == Shape::Sine) ? 1 : getHarmonicsForBand(band);
+
+            for (int k = harmonicsDone + 1; k <= harmonics; ++k)
+            {
+                double amplitude = 0.0;
+                int phaseOffset = 0;
+
+                switch (shape)
+                {
+                case Shape::Sine:
+                    amplitude = 1.0;
+                    break;
+                case Shape::Square:
+                    amplitude = (k % 2 == 1) ? 4.0 / (juce::MathConstants<double>::pi * k) : 0.0;
+                    break;
+                case Shape::Triangle:
+                    // Negative cosine series, starts at -1 like the naive shape
+                    amplitude = (k % 2 == 1) ? -8.0 / (juce::MathConstants<double>::pi * juce::MathConstants<double>::pi * k * k) : 0.0;
+                    phaseOffset = quarter;
+                    break;
+                case Shape::Sawtooth:
+                    amplitude = ((k % 2 == 1) ? 2.0 : -2.0) / (juce::MathConstants<double>::pi * k);
+                    break;
+                default:
+                    break;
+                }
+
+                if (amplitude == 0.0)
+                    continue;
+
+                for (int n = 0; n < tableSize; ++n)
+                    accum[n] += amplitude * sine[(k * n + phaseOffset) & mask];
+            }
+
+            harmonicsDone = juce::jmax(harmonicsDone, harmonics);
+
+            auto& table = bands[band];
+            for (int n = 0; n < tableSize; ++n)
+                table[n] = static_cast<float>(accum[n]);
+            table[tableSize] = table[0];
+        }
+    }
+}
+
+const float* WavetableBank::getTable(Shape shape, double cyclesPerSample) const
+{
+    jassert(shape != Shape::Count);
+    return tables[static_cast<int>(shape)][getBand(cyclesPerSample)].data();
+}
+
+int WavetableBank::getBand(double cyclesPerSample) noexcept
+{
+    // Smallest band whose highest harmonic stays below Nyquist
+    int band = 0;
+    const double harmonicsAllowed = 0.5 / juce::jmax(cyclesPerSample, 1.0e-9);
+    while (band < numBands - 1 && getHarmonicsForBand(band) > harmonicsAllowed)
+        ++band;
+
+    return band;
+}
+
+int WavetableBank::getHarmonicsForBand(int band) noexcept
+{
+    return maxHarmonics >> band;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class WavetableBank
+ * @brief Shared, read-only bank of band-limited, mip-mapped single-cycle tables.
+ *
+ * Each periodic waveform is stored as one table per octave band. Lower bands
+ * hold more harmonics; the band for a given pitch is chosen so that no harmonic
+ * exceeds Nyquist. Oscillators hold the bank through juce::SharedResourcePointer,
+ * so it is built when the first plugin instance in the process is created,
+ * shared read-only by every oscillator of every instance, and freed with the
+ * last one. Later instances construct without rebuilding a single table.
+ */
+class WavetableBank
+{
+public:
+    /**
+     * @enum Shape
+     * @brief Periodic waveform shapes stored in the bank.
+     */
+    enum class Shape
+    {
+        Sine,     ///< Pure sine, a single band
+        Square,   ///< Odd harmonics, 1/k amplitude
+        Triangle, ///< Odd harmonics, 1/k^2 amplitude
+        Sawtooth, ///< All harmonics, 1/k amplitude
+        Count
+    };
+
+    /**
+     * @enum Interpolation
+     * @brief How a table is read between its samples, cheapest first.
+     */
+    enum class Interpolation
+    {
+        Truncated, ///< Nearest sample below, see lookupTruncated()
+        Linear,    ///< Straight line between neighbours, see lookup()
+        Cubic      ///< Four-point Hermite curve, see lookupCubic()
+    };
+
+    static constexpr int tableSize = 2048;                ///< Samples per single-cycle table (power of two)
+    static constexpr int numBands = 11;                   ///< Octave bands, from tableSize / 2 harmonics down to one
+    static constexpr int maxHarmonics = tableSize / 2;    ///< Harmonics held by the lowest band
+
+    /**
+     * @brief Builds all tables using additive synthesis. Use through juce::SharedResourcePointer.
+     */
+    WavetableBank();
+
+    /**
+     * @brief Returns the band-limited table for a shape at a given pitch.
+     * @param shape Waveform shape.
+     * @param cyclesPerSample Fundamental frequency divided by the sample rate.
+     * @return Pointer to tableSize + 1 samples (last sample is a wrap guard).
+     */
+    const float* getTable(Shape shape, double cyclesPerSample) const;
+
+    /**
+     * @brief Returns the band to read at a given pitch, the one with the most harmonics below Nyquist.
+     * @param cyclesPerSample Fundamental frequency divided by the sample rate.
+     * @return Band index in [0, numBands).
+     */
+    static int getBand(double cyclesPerSample) noexcept;
+
+    /**
+     * @brief Returns the number of harmonics held by a band.
+     * @param band Band index.
+     * @return Harmonic count.
+     */
+    static int getHarmonicsForBand(int band) noexcept;
+
+    /**
+     * @brief Reads a table with linear interpolation.
+     * @param table Table returned by getTable().
+     * @param position Read position in samples, in range [0, tableSize).
+     * @return Interpolated sample value.
+     */
+    static float lookup(const float* table, double position) noexcept
+    {
+        const int i0 = static_cast<int>(position) & (tableSize - 1);
+        const float frac = static_cast<float>(position - std::floor(position));
+        return table[i0] + frac * (table[i0 + 1] - table[i0]);
+    }
+
+    /**
+     * @brief Reads a table with four-point Hermite interpolation, for offline renders.
+     *
+     * The curve follows the band's harmonics much more closely than a straight
+     * line, which lowers the interpolation noise of high notes at the cost of
+     * a few more reads and multiplies per sample.
+     *
+     * @param table Table returned by getTable().
+     * @param position Read position in samples, in range [0, tableSize).
+     * @return Interpolated sample value.
+     */
+    static float lookupCubic(const float* table, double position) noexcept
+    {
+        constexpr int mask = tableSize - 1;
+        const int i1 = static_cast<int>(position) & mask;
+        const float frac = static_cast<float>(position - std::floor(position));
+
+        const float y0 = table[(i1 - 1) & mask];
+        const float y1 = table[i1];
+        const float y2 = table[i1 + 1];
+        const float y3 = table[(i1 + 2) & mask];
+
+        const float c1 = 0.5f * (y2 - y0);
+        const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+        const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+        return ((c3 * frac + c2) * frac + c1) * frac + y1;
+    }
+
+    /**
+     * @brief Reads a table without interpolation, cheaper but noisier than lookup().
+     * @param table Table returned by getTable().
+     * @param position Read position in samples, in range [0, tableSize).
+     * @return Sample at the position rounded down.
+     */
+    static float lookupTruncated(const float* table, double position) noexcept
+    {
+        return table[static_cast<int>(position) & (tableSize - 1)];
+    }
+
+private:
+    using Table = std::array<float, tableSize + 1>; ///< Single-cycle table with guard sample
+
+    std::array<std::array<Table, numBands>, static_cast<int>(Shape::Count)> tables; ///< Tables per shape and band
+
+    JUCE_DECLARE_NON_COPYABLE(WavetableBank)
+};
@@ -0,0 +1,77 @@
+#include "ParameterRelay.h"
+
+namespace
+{
+    const juce::Identifier idProperty{ "id" };       // Parameter ID of a tree entry
+    const juce::Identifier valueProperty{ "value" }; // Plain value of a tree entry
+}
+
+ParameterRelay::ParameterRelay(juce::AudioProcessorValueTreeState& apvtsIn)
+    : apvts(apvtsIn)
+{
+    const auto& parameters = apvts.processor.getParameters();
+    slots.resize(static_cast<size_t>(parameters.size()));
+    pending = std::make_unique<std::atomic<bool>[]>(slots.size());
+
+    for (auto* parameter : parameters)
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        if (ranged == nullptr)
+            continue;
+
+        auto& slot = slots[static_cast<size_t>(parameter->getParameterIndex())];
+        slot.rawValue = apvts.getRawParameterValue(ranged->getParameterID());
+        slot.parameter = (slot.rawValue != nullptr) ? ranged : nullptr;
+    }
+
+    startTimer(notifyIntervalMs);
+}
+
+ParameterRelay::~ParameterRelay()
+{
+    stopTimer();
+}
+
+void ParameterRelay::push(juce::RangedAudioParameter& parameter, float normalized) noexcept
+{
+    const int index = parameter.getParameterIndex();
+    if (!juce::isPositiveAndBelow(index, static_cast<int>(slots.size())))
+        return;
+
+    auto& slot = slots[static_cast<size_t>(index)];
+    jassert(slot.parameter == &parameter);
+    if (slot.parameter != &parameter)
+        return;
+
+    // setValue() of the JUCE parameter types only stores the value, the raw value is what the DSP reads
+    parameter.setValue(normalized);
+    slot.rawValue->store(parameter.convertFrom0to1(parameter.getValue()), std::memory_order_relaxed);
+
+    pending[static_cast<size_t>(index)].store(true, std::memory_order_release);
+    anyPending.store(true, std::memory_order_release);
+}
+
+bool ParameterRelay::hasPendingChanges() const noexcept
+{
+    return anyPending.load(std::memory_order_acquire);
+}
+
+void ParameterRelay::timerCallback()
+{
+    if (!anyPending.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+        if (!pending[i].exchange(false, std::memory_order_acq_rel))
+            continue;
+
+        auto* parameter = slots[i].parameter;
+        parameter->sendValueChangedMessageToListeners(parameter->getValue());
+
+        // The tree's adapter sees its raw value already current and skips the tree, so the entry is written here
+        auto entry = apvts.state.getChildWithProperty(idProperty, parameter->getParameterID());
+        if (entry.isValid())
+            entry.setProperty(valueProperty, slots[i].rawValue->load(std::memory_order_relaxed), nullptr);
+    }
+}
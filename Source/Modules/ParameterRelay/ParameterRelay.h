@@ -0,0 +1,69 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ParameterRelay
+ * @brief Applies parameter changes made on the audio thread, and announces them from the message thread.
+ *
+ * setValueNotifyingHost() calls every parameter listener on the calling thread,
+ * editor components among them, which may lock or post messages. Audio-thread
+ * sources (MIDI CC, Program Change, OSC) push through the relay instead. A push
+ * sets the parameter and the value the DSP reads through getRawParameterValue()
+ * at once, without calling anyone. A timer on the message thread then tells the
+ * host and the listeners and updates the parameter's entry in the state tree.
+ * A parameter pushed several times between two ticks is announced once with
+ * its latest value. Pushing never locks or allocates.
+ */
+class ParameterRelay : private juce::Timer
+{
+public:
+    static constexpr int notifyIntervalMs = 20; ///< Delay at most between a push and its announcement
+
+    /**
+     * @brief Builds the per-parameter table and starts the timer. Message thread only.
+     * @param apvts Parameter tree of the processor; its parameters must outlive the relay.
+     */
+    explicit ParameterRelay(juce::AudioProcessorValueTreeState& apvts);
+
+    /**
+     * @brief Stops the timer, changes not yet announced are dropped.
+     */
+    ~ParameterRelay() override;
+
+    /**
+     * @brief Sets a parameter from the audio thread without notifying anyone there.
+     * @param parameter A parameter of the tree the relay was built for.
+     * @param normalized New value in the 0 to 1 range.
+     */
+    void push(juce::RangedAudioParameter& parameter, float normalized) noexcept;
+
+    /**
+     * @brief Returns true if pushed changes are waiting for the next tick.
+     */
+    bool hasPendingChanges() const noexcept;
+
+private:
+    /** @brief Announces the changes pushed since the last tick. */
+    void timerCallback() override;
+
+    /**
+     * @struct Slot
+     * @brief One parameter, by its processor index.
+     */
+    struct Slot
+    {
+        juce::RangedAudioParameter* parameter = nullptr; ///< The parameter, nullptr for parameters outside the tree
+        std::atomic<float>* rawValue = nullptr;          ///< Plain value the DSP reads
+    };
+
+    juce::AudioProcessorValueTreeState& apvts;           ///< Tree whose entries are updated on announcing
+    std::vector<Slot> slots;                             ///< Parameters by processor index, never resized after construction
+    std::unique_ptr<std::atomic<bool>[]> pending;        ///< Per slot, set by a push until announced
+    std::atomic<bool> anyPending{ false };               ///< Set after any entry of pending
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterRelay)
+};
@@ -0,0 +1,279 @@
+#include "PluginStateCodec.h"
+#include <cstring>
+
+namespace
+{
+    // Type of the APVTS children holding parameter values
+    const juce::Identifier parameterType{ "PARAM" };
+}
+
+PluginStateCodec::PluginStateCodec(juce::AudioProcessorValueTreeState& apvtsIn)
+    : apvts(apvtsIn)
+{
+    // FNV-1a over the IDs, stable across platforms and runs unlike pointer order
+    uint32_t hash = 2166136261u;
+    const auto addByte = [&hash](uint8_t byte)
+        {
+            hash ^= byte;
+            hash *= 16777619u;
+        };
+
+    const auto& processorParameters = apvts.processor.getParameters();
+    slotOfParameterIndex.assign(static_cast<size_t>(processorParameters.size()), -1);
+
+    for (auto* parameter : processorParameters)
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        jassert(ranged != nullptr);
+        if (ranged == nullptr)
+            continue;
+
+        slotOfParameterIndex[static_cast<size_t>(parameter->getParameterIndex())] = static_cast<int>(parameters.size());
+        parameters.push_back(ranged);
+
+        const auto id = ranged->getParameterID();
+        for (auto* c = id.toRawUTF8(); *c != 0; ++c)
+            addByte(static_cast<uint8_t>(*c));
+        addByte(0);
+    }
+
+    layoutHash = static_cast<int>(hash);
+
+    juce::MemoryOutputStream ids(idSection, false);
+    for (const auto* parameter : parameters)
+        ids.writeString(parameter->getParameterID());
+    ids.flush();
+
+    dirtyValues = std::make_unique<std::atomic<bool>[]>(parameters.size());
+    for (size_t i = 0; i < parameters.size(); ++i)
+        dirtyValues[i] = false;
+
+    for (auto* parameter : parameters)
+        parameter->addListener(this);
+    apvts.state.addListener(this);
+}
+
+PluginStateCodec::~PluginStateCodec()
+{
+    apvts.state.removeListener(this);
+    for (auto* parameter : parameters)
+        parameter->removeListener(this);
+}
+
+void PluginStateCodec::write(juce::MemoryBlock& destData)
+{
+    const juce::ScopedLock lock(writeLock);
+
+    // Flags are cleared before the values are read, so a change racing this write marks the next one
+    const bool treeChanged = treeDirty.exchange(false);
+    const bool valuesChanged = valuesDirty.exchange(false);
+
+    if (cachedState.isEmpty() || treeChanged || ++writesSinceFullSnapshot >= fullSnapshotInterval)
+        writeFullSnapshot();
+    else if (valuesChanged)
+        patchDirtyValues();
+
+    destData = cachedState;
+}
+
+void PluginStateCodec::invalidate() noexcept
+{
+    treeDirty = true;
+}
+
+void PluginStateCodec::writeFullSnapshot()
+{
+    writesSinceFullSnapshot = 0;
+
+    cachedState.reset();
+    juce::MemoryOutputStream out(cachedState, false);
+
+    out.writeInt(magic);
+    out.writeInt(formatVersion);
+    out.writeInt(layoutHash);
+    out.writeInt(static_cast<int>(parameters.size()));
+
+    // Read from the parameters themselves, the state tree only catches up on the APVTS timer
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        dirtyValues[i] = false;
+        out.writeFloat(parameters[i]->getValue());
+    }
+
+    out.writeInt(static_cast<int>(idSection.getSize()));
+    out.write(idSection.getData(), idSection.getSize());
+
+    juce::ValueTree extras(apvts.state.getType());
+    extras.copyPropertiesFrom(apvts.state, nullptr);
+    for (const auto& child : apvts.state)
+    {
+        if (!child.hasType(parameterType))
+            extras.appendChild(child.createCopy(), nullptr);
+    }
+
+    extras.writeToStream(out);
+}
+
+void PluginStateCodec::patchDirtyValues()
+{
+    jassert(cachedState.getSize() >= valuesOffset + parameters.size() * sizeof(float));
+    auto* values = static_cast<char*>(cachedState.getData()) + valuesOffset;
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        if (!dirtyValues[i].exchange(false))
+            continue;
+
+        // Same bytes MemoryOutputStream::writeFloat() gives, little-endian
+        const float value = parameters[i]->getValue();
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = juce::ByteOrder::swapIfBigEndian(bits);
+        std::memcpy(values + i * sizeof(float), &bits, sizeof(bits));
+    }
+}
+
+void PluginStateCodec::parameterValueChanged(int parameterIndex, float)
+{
+    if (parameterIndex < 0 || parameterIndex >= static_cast<int>(slotOfParameterIndex.size()))
+        return;
+
+    const int slot = slotOfParameterIndex[static_cast<size_t>(parameterIndex)];
+    if (slot < 0)
+        return;
+
+    dirtyValues[static_cast<size_t>(slot)] = true;
+    valuesDirty = true;
+}
+
+void PluginStateCodec::parameterGestureChanged(int, bool)
+{
+}
+
+void PluginStateCodec::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier&)
+{
+    // PARAM children only mirror the parameters, which are tracked on their own
+    if (!tree.hasType(parameterType))
+        treeDirty = true;
+}
+
+void PluginStateCodec::valueTreeChildAdded(juce::ValueTree&, juce::ValueTree&)
+{
+    treeDirty = true;
+}
+
+void PluginStateCodec::valueTreeChildRemoved(juce::ValueTree&, juce::ValueTree&, int)
+{
+    treeDirty = true;
+}
+
+void PluginStateCodec::valueTreeChildOrderChanged(juce::ValueTree&, int, int)
+{
+    treeDirty = true;
+}
+
+void PluginStateCodec::valueTreeRedirected(juce::ValueTree&)
+{
+    treeDirty = true;
+}
+
+bool PluginStateCodec::read(const void* data, int sizeInBytes)
+{
+    if (!isBinaryState(data, sizeInBytes))
+        return false;
+
+    juce::MemoryInputStream in(data, static_cast<size_t>(sizeInBytes), false);
+    in.readInt(); // magic
+
+    const int version = in.readInt();
+    if (version < 1 || version > formatVersion)
+        return false; // Saved by a newer version
+
+    const int savedHash = in.readInt();
+    const int numSaved = in.readInt();
+    if (numSaved < 0 || static_cast<juce::int64>(numSaved) * 4 + 4 > in.getNumBytesRemaining())
+        return false;
+
+    std::vector<float> values(static_cast<size_t>(numSaved));
+    for (auto& value : values)
+        value = in.readFloat();
+
+    const int idSectionSize = in.readInt();
+    if (idSectionSize < 0 || idSectionSize > in.getNumBytesRemaining())
+        return false;
+
+    // Same layout: values map one to one, the IDs need not be parsed
+    std::vector<std::pair<juce::RangedAudioParameter*, float>> assignments;
+    assignments.reserve(parameters.size());
+
+    if (savedHash == layoutHash && numSaved == static_cast<int>(parameters.size()))
+    {
+        for (size_t i = 0; i < parameters.size(); ++i)
+            assignments.emplace_back(parameters[i], values[i]);
+
+        in.skipNextBytes(idSectionSize);
+    }
+    else
+    {
+        juce::MemoryBlock idSection;
+        in.readIntoMemoryBlock(idSection, idSectionSize);
+        juce::MemoryInputStream ids(idSection, false);
+
+        std::map<juce::RangedAudioParameter*, float> saved;
+        for (const float value : values)
+        {
+            if (ids.isExhausted())
+                return false;
+
+            const auto id = ids.readString();
+            if (auto* parameter = dynamic_cast<juce::RangedAudioParameter*>(apvts.getParameter(id)))
+                saved[parameter] = value;
+        }
+
+        for (auto* parameter : parameters)
+        {
+            const auto it = saved.find(parameter);
+            assignments.emplace_back(parameter, it != saved.end() ? it->second : parameter->getDefaultValue());
+        }
+    }
+
+    auto extras = juce::ValueTree::readFromStream(in);
+    if (!extras.isValid())
+        return false;
+
+    // Parsed completely, now apply
+    for (const auto& [parameter, value] : assignments)
+    {
+        const float clamped = juce::jlimit(0.0f, 1.0f, value);
+        if (parameter->getValue() != clamped)
+            parameter->setValueNotifyingHost(clamped);
+    }
+
+    auto& state = apvts.state;
+    state.copyPropertiesFrom(extras, nullptr);
+
+    for (int i = state.getNumChildren(); --i >= 0;)
+    {
+        if (!state.getChild(i).hasType(parameterType))
+            state.removeChild(i, nullptr);
+    }
+
+    while (extras.getNumChildren() > 0)
+    {
+        auto child = extras.getChild(0);
+        extras.removeChild(0, nullptr);
+        state.appendChild(child, nullptr);
+    }
+
+    // The tree listener already saw the changes, this keeps the next write full regardless
+    treeDirty = true;
+    return true;
+}
+
+bool PluginStateCodec::isBinaryState(const void* data, int sizeInBytes) noexcept
+{
+    if (data == nullptr || sizeInBytes < 8)
+        return false;
+
+    return static_cast<int>(juce::ByteOrder::littleEndianInt(data)) == magic;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+/**
+ * @class PluginStateCodec
+ * @brief Compact, versioned binary form of the plugin state exchanged with the host.
+ *
+ * Hosts save and restore state often (undo snapshots, autosave), so the codec
+ * avoids XML entirely. Parameter values are written as one fixed-order run of
+ * normalized floats, which a matching parameter layout reads straight back into
+ * the parameters; a parameter that changed alters only its own four bytes, so
+ * consecutive snapshots diff well. The parameter IDs follow in their own section,
+ * read only when the layout differs from the one that saved the state. Everything
+ * else in the APVTS state (modulation routing and the like) follows as one binary
+ * ValueTree.
+ *
+ * Layout, little-endian:
+ * @code
+ * int32  magic
+ * int32  version
+ * int32  layoutHash
+ * int32  numParameters
+ * float  values[numParameters]   // normalized, in layout order
+ * int32  idSectionSize
+ * string ids[numParameters]      // UTF-8, null-terminated
+ * tree   extras                  // root properties and non-parameter children
+ * @endcode
+ *
+ * Data not starting with the magic number is not handled here, the processor
+ * then falls back to the XML format older versions saved.
+ *
+ * The last serialized state is kept. The codec listens to every parameter and
+ * to the state tree, so a write() with nothing changed returns that blob as it
+ * is, and one after parameter moves only patches the moved values in place;
+ * the ID section never changes. A change to the tree beyond the parameters,
+ * and every fullSnapshotInterval-th write as a guard against a change that
+ * sent no notification, serialize the whole state again.
+ */
+class PluginStateCodec : private juce::AudioProcessorParameter::Listener,
+                         private juce::ValueTree::Listener
+{
+public:
+    static constexpr int formatVersion = 1;         ///< Version written by write()
+    static constexpr int fullSnapshotInterval = 64; ///< Writes after which the state is serialized in full even if unchanged
+
+    /**
+     * @brief Constructs a codec for the parameters the state holds.
+     * @param apvts The processor's parameter state, whose layout must be complete.
+     */
+    explicit PluginStateCodec(juce::AudioProcessorValueTreeState& apvts);
+
+    /**
+     * @brief Stops listening to the parameters and the state tree.
+     */
+    ~PluginStateCodec() override;
+
+    /**
+     * @brief Serializes the current state, from the cached blob where it still holds.
+     *
+     * Safe to call from any thread the host pulls state on, but not while the
+     * state tree itself is being modified.
+     *
+     * @param destData Receives the state, replacing its previous content.
+     */
+    void write(juce::MemoryBlock& destData);
+
+    /**
+     * @brief Makes the next write() serialize the whole state, for changes that sent no notification.
+     */
+    void invalidate() noexcept;
+
+    /**
+     * @brief Restores a state produced by write().
+     *
+     * The data is fully parsed before anything is applied, so a truncated or
+     * corrupt block leaves the current state untouched. Parameters missing from
+     * the data return to their defaults, as with a replaced APVTS state.
+     *
+     * @param data Pointer to the state.
+     * @param sizeInBytes Size of the state.
+     * @return False if the data is not a state this version can read.
+     */
+    bool read(const void* data, int sizeInBytes);
+
+    /**
+     * @brief Returns true if the data starts like a state produced by write().
+     * @param data Pointer to the state.
+     * @param sizeInBytes Size of the state.
+     */
+    static bool isBinaryState(const void* data, int sizeInBytes) noexcept;
+
+private:
+    static constexpr int magic = 0x4e595344; ///< "DSYN" read as a little-endian int32
+    static constexpr size_t valuesOffset = 16; ///< Byte offset of the values, after the four header ints
+
+    /**
+     * @brief Serializes the whole state into the cache and clears every dirty flag.
+     */
+    void writeFullSnapshot();
+
+    /**
+     * @brief Rewrites the cached values of the parameters that changed since the last write.
+     */
+    void patchDirtyValues();
+
+    /** @brief Marks a parameter dirty, on whatever thread changed it. */
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+
+    /** @brief Gestures do not change the state. */
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+
+    /** @brief Marks the tree dirty, except for the parameter values the APVTS mirrors into it. */
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+
+    /** @brief Marks the tree dirty. */
+    void valueTreeChildAdded(juce::ValueTree& parent, juce::ValueTree& child) override;
+
+    /** @brief Marks the tree dirty. */
+    void valueTreeChildRemoved(juce::ValueTree& parent, juce::ValueTree& child, int index) override;
+
+    /** @brief Marks the tree dirty. */
+    void valueTreeChildOrderChanged(juce::ValueTree& parent, int oldIndex, int newIndex) override;
+
+    /** @brief Marks the tree dirty, after the APVTS replaced its state. */
+    void valueTreeRedirected(juce::ValueTree& tree) override;
+
+    juce::AudioProcessorValueTreeState& apvts;           ///< State the codec reads and writes
+    std::vector<juce::RangedAudioParameter*> parameters; ///< Parameters in layout order
+    std::vector<int> slotOfParameterIndex;               ///< Layout position of each processor parameter index, -1 if not written
+    int layoutHash = 0;                                  ///< Hash of the parameter IDs in layout order
+    juce::MemoryBlock idSection;                         ///< Serialized IDs, fixed with the layout
+
+    juce::CriticalSection writeLock;                     ///< Serializes writes from concurrent host threads
+    juce::MemoryBlock cachedState;                       ///< Last state written, empty until the first write
+    int writesSinceFullSnapshot = 0;                     ///< Writes served from the cache since it was last rebuilt
+
+    std::unique_ptr<std::atomic<bool>[]> dirtyValues;    ///< Per layout position, set when the value changed since the last write
+    std::atomic<bool> valuesDirty{ false };              ///< Set after any entry of dirtyValues
+    std::atomic<bool> treeDirty{ true };                 ///< Set when the tree beyond the parameter values changed, or by invalidate()
+
+    JUCE_DECLARE_NON_COPYABLE(PluginStateCodec)
+};
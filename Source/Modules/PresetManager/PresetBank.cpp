@@ -0,0 +1,235 @@
+#include "PresetBank.h"
+
+namespace
+{
+    // APVTS layout of a saved parameter
+    const juce::Identifier parameterType{ "PARAM" };
+    const juce::Identifier idProperty{ "id" };
+    const juce::Identifier valueProperty{ "value" };
+}
+
+PresetBank::PresetBank(juce::AudioProcessorValueTreeState& apvtsIn, PresetLibrary& libraryIn, juce::ThreadPool& loaderIn)
+    : apvts(apvtsIn), library(libraryIn), loader(loaderIn)
+{
+    startTimer(timerIntervalMs);
+}
+
+PresetBank::~PresetBank()
+{
+    stopTimer();
+}
+
+void PresetBank::setCapacity(int newCapacity)
+{
+    capacity = juce::jlimit(1, numPrograms, newCapacity);
+    enforceCapacity();
+}
+
+void PresetBank::preload(int firstProgram, int count)
+{
+    const int last = juce::jmin(numPrograms, library.getNumPresets(), firstProgram + juce::jmin(count, capacity));
+
+    for (int program = juce::jmax(0, firstProgram); program < last; ++program)
+    {
+        if (snapshots[program] != nullptr || loading[program])
+            continue;
+
+        const auto file = library.getEntry(program).file;
+        if (file == juce::File())
+            continue;
+
+        loading[program] = true;
+        const int generation = clearGeneration.load();
+
+        loader.addJob([this, program, file, generation]
+            {
+                auto snapshot = parse(file);
+
+                const juce::ScopedLock lock(arrivedLock);
+                if (generation == clearGeneration.load())
+                    arrived.emplace_back(program, std::move(snapshot));
+            });
+    }
+}
+
+void PresetBank::clear()
+{
+    {
+        const juce::ScopedLock lock(arrivedLock);
+        ++clearGeneration;
+        arrived.clear();
+    }
+
+    loading.fill(false);
+
+    for (int program = 0; program < numPrograms; ++program)
+    {
+        if (snapshots[program] != nullptr)
+            evict(program);
+    }
+}
+
+bool PresetBank::isCached(int program) const
+{
+    return juce::isPositiveAndBelow(program, numPrograms) && snapshots[program] != nullptr;
+}
+
+void PresetBank::requestProgram(int program) noexcept
+{
+    if (juce::isPositiveAndBelow(program, numPrograms))
+        requestedProgram.store(program, std::memory_order_relaxed);
+}
+
+void PresetBank::applyPendingProgram(ParameterRelay& relay) noexcept
+{
+    const int program = requestedProgram.exchange(-1, std::memory_order_relaxed);
+    if (program < 0)
+        return;
+
+    auto* snapshot = published[program].load();
+    if (snapshot != nullptr)
+    {
+        // Announce the read, then make sure the snapshot was not retired in between
+        inUse.store(snapshot);
+        if (published[program].load() != snapshot)
+            snapshot = nullptr;
+    }
+
+    if (snapshot == nullptr)
+    {
+        inUse.store(nullptr);
+        missedProgram.store(program);
+        return;
+    }
+
+    // Unchanged values are skipped, so presets sharing most settings notify the host little
+    for (const auto& [parameter, value] : snapshot->values)
+    {
+        if (parameter->getValue() != value)
+            relay.push(*parameter, value);
+    }
+
+    inUse.store(nullptr);
+    appliedProgram.store(program);
+}
+
+std::unique_ptr<PresetBank::Snapshot> PresetBank::parse(const juce::File& file) const
+{
+    const auto xml = juce::XmlDocument::parse(file);
+    if (xml == nullptr)
+        return nullptr;
+
+    auto state = juce::ValueTree::fromXml(*xml);
+    if (!state.isValid())
+        return nullptr;
+
+    std::map<juce::String, juce::var> saved;
+    for (const auto& child : state)
+    {
+        if (child.hasType(parameterType))
+            saved[child[idProperty].toString()] = child[valueProperty];
+    }
+
+    auto snapshot = std::make_unique<Snapshot>();
+    snapshot->file = file;
+    snapshot->state = state;
+
+    // Parameters a preset leaves out return to their defaults, as with a replaced APVTS state
+    for (auto* parameter : apvts.processor.getParameters())
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        if (ranged == nullptr)
+            continue;
+
+        const auto it = saved.find(ranged->getParameterID());
+        const float value = (it != saved.end() && !it->second.isVoid())
+            ? ranged->convertTo0to1(static_cast<float>(it->second))
+            : ranged->getDefaultValue();
+
+        snapshot->values.emplace_back(ranged, juce::jlimit(0.0f, 1.0f, value));
+    }
+
+    return snapshot;
+}
+
+void PresetBank::timerCallback()
+{
+    std::vector<std::pair<int, std::unique_ptr<Snapshot>>> ready;
+    {
+        const juce::ScopedLock lock(arrivedLock);
+        std::swap(ready, arrived);
+    }
+
+    for (auto& [program, snapshot] : ready)
+    {
+        loading[program] = false;
+        if (snapshot == nullptr)
+            continue;
+
+        if (snapshots[program] != nullptr)
+            evict(program);
+
+        published[program].store(snapshot.get());
+        snapshots[program] = std::move(snapshot);
+        lastUsed[program] = ++useCounter;
+    }
+
+    enforceCapacity();
+
+    const int applied = appliedProgram.exchange(-1);
+    if (applied >= 0)
+    {
+        // Evicted between the audio thread's switch and now, finish through a regular load
+        if (snapshots[applied] == nullptr)
+        {
+            if (onProgramMissed)
+                onProgramMissed(applied);
+        }
+        else
+        {
+            lastUsed[applied] = ++useCounter;
+            if (onProgramApplied)
+                onProgramApplied(snapshots[applied]->state, snapshots[applied]->file);
+        }
+    }
+
+    const int missed = missedProgram.exchange(-1);
+    if (missed >= 0 && onProgramMissed)
+        onProgramMissed(missed);
+
+    // Only the snapshot the audio thread is reading right now has to stay
+    const auto* reading = inUse.load();
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+        [reading](const std::unique_ptr<Snapshot>& snapshot) { return snapshot.get() != reading; }),
+        retired.end());
+}
+
+void PresetBank::evict(int program)
+{
+    published[program].store(nullptr);
+    retired.push_back(std::move(snapshots[program]));
+}
+
+void PresetBank::enforceCapacity()
+{
+    for (;;)
+    {
+        int cached = 0;
+        int oldest = -1;
+
+        for (int program = 0; program < numPrograms; ++program)
+        {
+            if (snapshots[program] == nullptr)
+                continue;
+
+            ++cached;
+            if (oldest < 0 || lastUsed[program] < lastUsed[oldest])
+                oldest = program;
+        }
+
+        if (cached <= capacity)
+            return;
+
+        evict(oldest);
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../ParameterRelay/ParameterRelay.h"
+#include "PresetLibrary.h"
+#include <JuceHeader.h>
+
+/**
+ * @class PresetBank
+ * @brief Hot cache of parsed presets, so MIDI Program Change switches sounds without disk or parser.
+ *
+ * Program numbers map to library entries in order. Up to getCapacity() presets are
+ * kept parsed in memory as a state tree plus a flat list of normalized parameter
+ * values, the least recently used one making room when the bank is full.
+ *
+ * The audio thread applies a cached program at the next block boundary by setting
+ * the parameter values through a ParameterRelay, the same way MIDI CC bindings do, so the new sound
+ * starts within one block. The message thread then swaps in the rest of the
+ * cached state (modulation routing and the like) through the onProgramApplied
+ * callback. A program that is not cached falls back to onProgramMissed, which
+ * normally starts a regular load and caches the preset for next time.
+ */
+class PresetBank : private juce::Timer
+{
+public:
+    static constexpr int numPrograms = 128;     ///< MIDI program numbers 0 to 127
+    static constexpr int defaultCapacity = 16;  ///< Presets kept parsed by default
+
+    /**
+     * @brief Constructs an empty bank.
+     * @param apvts State whose parameters the snapshots address.
+     * @param library Library the program numbers index into.
+     * @param loader Background thread that reads and parses preset files.
+     */
+    PresetBank(juce::AudioProcessorValueTreeState& apvts, PresetLibrary& library, juce::ThreadPool& loader);
+
+    /**
+     * @brief Frees every snapshot. Loader jobs must be finished or removed first.
+     */
+    ~PresetBank() override;
+
+    /**
+     * @brief Sets how many presets stay parsed, evicting the least recently used ones.
+     * @param newCapacity Number of presets, at least 1.
+     */
+    void setCapacity(int newCapacity);
+
+    /**
+     * @brief Returns how many presets stay parsed.
+     */
+    int getCapacity() const noexcept { return capacity; }
+
+    /**
+     * @brief Parses a range of programs in the background and caches them.
+     * @param firstProgram First program number.
+     * @param count Number of programs, clipped to the library and the capacity.
+     */
+    void preload(int firstProgram, int count);
+
+    /**
+     * @brief Drops every cached program, for example after the library changed.
+     */
+    void clear();
+
+    /**
+     * @brief Returns true if a program is cached. Message thread only.
+     * @param program Program number.
+     */
+    bool isCached(int program) const;
+
+    /**
+     * @brief Asks for a program to be applied at the next block boundary. Audio thread.
+     * @param program Program number, later requests in the same block win.
+     */
+    void requestProgram(int program) noexcept;
+
+    /**
+     * @brief Applies the program requested during the previous block, if cached. Audio thread.
+     *
+     * Call at the start of a block, before parameters are read.
+     *
+     * @param relay Relay the parameter values are set through.
+     */
+    void applyPendingProgram(ParameterRelay& relay) noexcept;
+
+    /** @brief Called on the message thread after the audio thread applied a cached program. */
+    std::function<void(const juce::ValueTree& state, const juce::File& file)> onProgramApplied;
+
+    /** @brief Called on the message thread for a requested program that was not cached. */
+    std::function<void(int program)> onProgramMissed;
+
+private:
+    /**
+     * @struct Snapshot
+     * @brief A parsed preset, ready to be applied.
+     */
+    struct Snapshot
+    {
+        juce::File file;                                                  ///< Preset file
+        juce::ValueTree state;                                            ///< Complete parsed state
+        std::vector<std::pair<juce::RangedAudioParameter*, float>> values; ///< Normalized value of every parameter
+    };
+
+    /**
+     * @brief Reads and parses a preset file into a snapshot. Runs on the loader thread.
+     */
+    std::unique_ptr<Snapshot> parse(const juce::File& file) const;
+
+    /**
+     * @brief Publishes parsed snapshots, reports applied and missed programs and frees retired snapshots.
+     */
+    void timerCallback() override;
+
+    /**
+     * @brief Unpublishes a program and retires its snapshot.
+     */
+    void evict(int program);
+
+    /**
+     * @brief Evicts least recently used programs until the bank fits its capacity.
+     */
+    void enforceCapacity();
+
+    juce::AudioProcessorValueTreeState& apvts; ///< State the snapshots address
+    PresetLibrary& library;                    ///< Library the program numbers index into
+    juce::ThreadPool& loader;                  ///< Shared background loader
+
+    int capacity = defaultCapacity;            ///< Presets kept parsed
+    juce::uint32 useCounter = 0;               ///< Increments on every use, orders the LRU
+
+    // Message thread only
+    std::array<std::unique_ptr<Snapshot>, numPrograms> snapshots; ///< Owned snapshot of each cached program
+    std::array<juce::uint32, numPrograms> lastUsed{};             ///< useCounter at the program's last use
+    std::vector<std::unique_ptr<Snapshot>> retired;               ///< Evicted snapshots the audio thread may still read
+    std::array<bool, numPrograms> loading{};                      ///< True while a program is being parsed
+
+    // Shared with the audio thread
+    std::array<std::atomic<Snapshot*>, numPrograms> published{};  ///< Snapshot the audio thread applies for each program
+    std::atomic<Snapshot*> inUse{ nullptr };                      ///< Snapshot the audio thread is applying
+    std::atomic<int> requestedProgram{ -1 };                      ///< Program to apply at the next block
+    std::atomic<int> appliedProgram{ -1 };                        ///< Program applied, waiting for the message thread
+    std::atomic<int> missedProgram{ -1 };                         ///< Program requested but not cached
+
+    // Handed over from the loader thread
+    juce::CriticalSection arrivedLock;                            ///< Guards arrived
+    std::vector<std::pair<int, std::unique_ptr<Snapshot>>> arrived; ///< Parsed snapshots not published yet
+    std::atomic<int> clearGeneration{ 0 };                        ///< Bumped by clear(), drops stale loads
+
+    static constexpr int timerIntervalMs = 20; ///< How often the message thread follows up
+
+    JUCE_DECLARE_NON_COPYABLE(PresetBank)
+};
@@ -0,0 +1,345 @@
+#include "PresetLibrary.h"
+
+namespace
+{
+    const juce::String folderSetting{ "presetFolder" };
+
+    const juce::Identifier indexType{ "PRESET_INDEX" };
+    const juce::Identifier entryType{ "PRESET" };
+    const juce::Identifier folderProperty{ "folder" };
+    const juce::Identifier pathProperty{ "path" };
+    const juce::Identifier nameProperty{ "name" };
+    const juce::Identifier tagsProperty{ "tags" };
+    const juce::Identifier modifiedProperty{ "modified" };
+    const juce::Identifier sizeProperty{ "size" };
+    const juce::Identifier hashProperty{ "hash" };
+
+    // Attributes a preset file's root element may carry
+    const juce::String presetNameAttribute{ "presetName" };
+    const juce::String presetTagsAttribute{ "tags" };
+    const juce::String presetRootTag{ "PARAMETERS" };
+
+    juce::PropertiesFile::Options getSettingsOptions()
+    {
+        juce::PropertiesFile::Options options;
+        options.applicationName = "DigitalSynthesizer";
+        options.folderName = "DigitalSynthesizer";
+        options.filenameSuffix = ".settings";
+        options.osxLibrarySubFolder = "Application Support";
+        return options;
+    }
+
+    juce::String buildSearchText(const juce::String& name, const juce::StringArray& tags)
+    {
+        return (name + " " + tags.joinIntoString(" ")).toLowerCase();
+    }
+}
+
+PresetLibrary::PresetLibrary()
+    : settings(getSettingsOptions())
+{
+    const auto savedFolder = settings.getValue(folderSetting);
+    if (juce::File::isAbsolutePath(savedFolder))
+    {
+        folder = juce::File(savedFolder);
+    }
+    else
+    {
+        folder = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+            .getChildFile("DigitalSynthesizer")
+            .getChildFile("Presets");
+        installFactoryPresets(folder);
+    }
+
+    loadCachedIndex();
+    rescan();
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    cancelPendingUpdate();
+    scanner.removeAllJobs(true, -1);
+}
+
+juce::File PresetLibrary::getFolder() const
+{
+    juce::File result;
+    {
+        const juce::ScopedLock sl(lock);
+        result = folder;
+    }
+
+    result.createDirectory();
+    return result;
+}
+
+void PresetLibrary::setFolder(const juce::File& newFolder)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        if (newFolder == folder)
+            return;
+
+        folder = newFolder;
+        entries.clear();
+    }
+
+    settings.setValue(folderSetting, newFolder.getFullPathName());
+    settings.saveIfNeeded();
+
+    triggerAsyncUpdate();
+    rescan();
+}
+
+void PresetLibrary::rescan()
+{
+    if (scanQueued.exchange(true))
+        return;
+
+    scanner.addJob([this] { scan(); });
+}
+
+int PresetLibrary::getNumPresets() const
+{
+    const juce::ScopedLock sl(lock);
+    return static_cast<int>(entries.size());
+}
+
+PresetLibrary::Entry PresetLibrary::getEntry(int index) const
+{
+    const juce::ScopedLock sl(lock);
+    if (juce::isPositiveAndBelow(index, static_cast<int>(entries.size())))
+        return entries[static_cast<size_t>(index)];
+
+    return {};
+}
+
+int PresetLibrary::indexOf(const juce::File& file) const
+{
+    const juce::ScopedLock sl(lock);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        if (entries[i].file == file)
+            return static_cast<int>(i);
+    }
+
+    return -1;
+}
+
+std::vector<int> PresetLibrary::search(const juce::String& query) const
+{
+    juce::StringArray words;
+    words.addTokens(query.toLowerCase(), true);
+    words.removeEmptyStrings();
+
+    std::vector<int> matches;
+
+    const juce::ScopedLock sl(lock);
+    matches.reserve(entries.size());
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const auto& text = entries[i].searchText;
+        const bool matchesAll = std::all_of(words.begin(), words.end(),
+            [&text](const juce::String& word) { return text.contains(word); });
+
+        if (matchesAll)
+            matches.push_back(static_cast<int>(i));
+    }
+
+    return matches;
+}
+
+void PresetLibrary::addListener(Listener* listener)
+{
+    listeners.add(listener);
+}
+
+void PresetLibrary::removeListener(Listener* listener)
+{
+    listeners.remove(listener);
+}
+
+void PresetLibrary::scan()
+{
+    // Cleared first, so a rescan requested while this one runs still happens
+    scanQueued.store(false);
+
+    juce::File scannedFolder;
+    std::vector<Entry> previous;
+    {
+        const juce::ScopedLock sl(lock);
+        scannedFolder = folder;
+        previous = entries;
+    }
+
+    std::map<juce::String, const Entry*> known;
+    for (const auto& entry : previous)
+        known[entry.file.getFullPathName()] = &entry;
+
+    auto* job = juce::ThreadPoolJob::getCurrentThreadPoolJob();
+
+    std::vector<Entry> scanned;
+    for (const auto& item : juce::RangedDirectoryIterator(scannedFolder, true, "*.xml", juce::File::findFiles))
+    {
+        if (job != nullptr && job->shouldExit())
+            return;
+
+        const auto& file = item.getFile();
+        const auto modified = item.getModificationTime().toMilliseconds();
+        const auto size = item.getFileSize();
+
+        // Unchanged files keep their cached entry and are never opened
+        const auto it = known.find(file.getFullPathName());
+        if (it != known.end() && it->second->modifiedTime == modified && it->second->size == size)
+        {
+            scanned.push_back(*it->second);
+            continue;
+        }
+
+        Entry entry;
+        entry.file = file;
+        entry.modifiedTime = modified;
+        entry.size = size;
+
+        if (readEntry(file, entry))
+            scanned.push_back(std::move(entry));
+    }
+
+    std::sort(scanned.begin(), scanned.end(), [](const Entry& a, const Entry& b)
+        {
+            const int order = a.name.compareNatural(b.name);
+            return order != 0 ? order < 0 : a.file.getFullPathName() < b.file.getFullPathName();
+        });
+
+    const bool changed = scanned.size() != previous.size()
+        || !std::equal(scanned.begin(), scanned.end(), previous.begin(), [](const Entry& a, const Entry& b)
+            {
+                return a.file == b.file && a.hash == b.hash && a.name == b.name && a.tags == b.tags;
+            });
+
+    {
+        const juce::ScopedLock sl(lock);
+        if (folder != scannedFolder)
+            return; // Moved meanwhile, the scan queued by setFolder takes over
+
+        if (changed)
+            entries = scanned;
+    }
+
+    if (changed)
+    {
+        saveIndex(scanned, scannedFolder);
+        triggerAsyncUpdate();
+    }
+}
+
+bool PresetLibrary::readEntry(const juce::File& file, Entry& entry)
+{
+    juce::MemoryBlock data;
+    if (!file.loadFileAsData(data))
+        return false;
+
+    // Only the root element is needed for the name and tags
+    juce::XmlDocument document(data.toString());
+    const auto root = document.getDocumentElement(true);
+    if (root == nullptr || !root->hasTagName(presetRootTag))
+        return false;
+
+    uint64_t hash = 14695981039346656037ull;
+    const auto* bytes = static_cast<const uint8_t*>(data.getData());
+    for (size_t i = 0; i < data.getSize(); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+
+    entry.name = root->getStringAttribute(presetNameAttribute, file.getFileNameWithoutExtension());
+    entry.tags.addTokens(root->getStringAttribute(presetTagsAttribute), ",", "\"");
+    entry.tags.trim();
+    entry.tags.removeEmptyStrings();
+    entry.hash = juce::String::toHexString(static_cast<juce::int64>(hash));
+    entry.searchText = buildSearchText(entry.name, entry.tags);
+    return true;
+}
+
+void PresetLibrary::installFactoryPresets(const juce::File& target)
+{
+    // An existing folder was installed before or made by the user, whose deletions are kept
+    if (target.exists() || !target.createDirectory())
+        return;
+
+    for (int i = 0; i < BinaryData::namedResourceListSize; ++i)
+    {
+        const juce::String fileName = BinaryData::getNamedResourceOriginalFilename(BinaryData::namedResourceList[i]);
+        if (!fileName.endsWithIgnoreCase(".xml"))
+            continue;
+
+        int size = 0;
+        if (const auto* data = BinaryData::getNamedResource(BinaryData::namedResourceList[i], size))
+            target.getChildFile(fileName).replaceWithData(data, static_cast<size_t>(size));
+    }
+}
+
+void PresetLibrary::loadCachedIndex()
+{
+    const auto xml = juce::XmlDocument::parse(getIndexFile());
+    if (xml == nullptr)
+        return;
+
+    const auto index = juce::ValueTree::fromXml(*xml);
+    if (!index.hasType(indexType) || index[folderProperty].toString() != folder.getFullPathName())
+        return;
+
+    for (const auto& child : index)
+    {
+        if (!child.hasType(entryType))
+            continue;
+
+        Entry entry;
+        entry.file = juce::File(child[pathProperty].toString());
+        entry.name = child[nameProperty].toString();
+        entry.tags.addTokens(child[tagsProperty].toString(), ",", "\"");
+        entry.tags.removeEmptyStrings();
+        entry.modifiedTime = static_cast<juce::int64>(child[modifiedProperty]);
+        entry.size = static_cast<juce::int64>(child[sizeProperty]);
+        entry.hash = child[hashProperty].toString();
+        entry.searchText = buildSearchText(entry.name, entry.tags);
+        entries.push_back(std::move(entry));
+    }
+}
+
+void PresetLibrary::saveIndex(const std::vector<Entry>& indexEntries, const juce::File& indexedFolder) const
+{
+    juce::ValueTree index(indexType);
+    index.setProperty(folderProperty, indexedFolder.getFullPathName(), nullptr);
+
+    for (const auto& entry : indexEntries)
+    {
+        juce::ValueTree child(entryType);
+        child.setProperty(pathProperty, entry.file.getFullPathName(), nullptr);
+        child.setProperty(nameProperty, entry.name, nullptr);
+        child.setProperty(tagsProperty, entry.tags.joinIntoString(","), nullptr);
+        child.setProperty(modifiedProperty, entry.modifiedTime, nullptr);
+        child.setProperty(sizeProperty, entry.size, nullptr);
+        child.setProperty(hashProperty, entry.hash, nullptr);
+        index.appendChild(child, nullptr);
+    }
+
+    if (auto xml = index.createXml())
+    {
+        const auto file = getIndexFile();
+        file.getParentDirectory().createDirectory();
+        xml->writeTo(file);
+    }
+}
+
+juce::File PresetLibrary::getIndexFile()
+{
+    return getSettingsOptions().getDefaultFile().getSiblingFile("PresetIndex.xml");
+}
+
+void PresetLibrary::handleAsyncUpdate()
+{
+    listeners.call([](Listener& l) { l.presetLibraryChanged(); });
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class PresetLibrary
+ * @brief Cached index of the preset files in the user's preset folder.
+ *
+ * The folder is scanned on a background thread. Only files whose size or
+ * modification time changed since the last scan are opened, and then only their
+ * outer element is parsed for the name and tags. The index is saved next to the
+ * plugin's settings, so a new instance can browse thousands of presets at once
+ * and then refresh quietly. Searching and stepping read the in-memory index and
+ * never touch the disk.
+ *
+ * A preset file may name itself and carry tags through "presetName" and "tags"
+ * (comma-separated) attributes on its root element. Files without them are named
+ * after the file.
+ *
+ * The default folder lives in the user's documents. The first time it is used
+ * it is created and filled with the factory presets bundled in BinaryData.
+ */
+class PresetLibrary : private juce::AsyncUpdater
+{
+public:
+    /**
+     * @struct Entry
+     * @brief One indexed preset file.
+     */
+    struct Entry
+    {
+        juce::File file;                ///< Preset file
+        juce::String name;              ///< Display name
+        juce::StringArray tags;         ///< Tags, in file order
+        juce::int64 modifiedTime = 0;   ///< Last modification, in milliseconds since the epoch
+        juce::int64 size = 0;           ///< File size in bytes
+        juce::String hash;              ///< FNV-1a hash of the file's content, as hex
+        juce::String searchText;        ///< Lowercase name and tags, matched by search()
+    };
+
+    /**
+     * @class Listener
+     * @brief Receives index changes, always on the message thread.
+     */
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        /**
+         * @brief Called after a scan changed the index or the folder changed.
+         */
+        virtual void presetLibraryChanged() = 0;
+    };
+
+    /**
+     * @brief Loads the cached index and starts a background scan of the preset folder.
+     */
+    PresetLibrary();
+
+    /**
+     * @brief Stops a running scan.
+     */
+    ~PresetLibrary() override;
+
+    /**
+     * @brief Returns the folder the library indexes, creating it if needed.
+     */
+    juce::File getFolder() const;
+
+    /**
+     * @brief Moves the library to another folder, remembered across sessions, and rescans.
+     * @param newFolder The folder holding the user's presets.
+     */
+    void setFolder(const juce::File& newFolder);
+
+    /**
+     * @brief Starts a background scan, unless one is already queued.
+     */
+    void rescan();
+
+    /**
+     * @brief Returns the number of indexed presets.
+     */
+    int getNumPresets() const;
+
+    /**
+     * @brief Returns a copy of an entry, sorted by name, or an empty entry if out of range.
+     * @param index Index into the sorted library.
+     */
+    Entry getEntry(int index) const;
+
+    /**
+     * @brief Returns the index of the entry for a file, or -1.
+     * @param file A preset file.
+     */
+    int indexOf(const juce::File& file) const;
+
+    /**
+     * @brief Returns the indices of the entries matching every word of a query.
+     *
+     * Words match case-insensitively anywhere in the name or tags, an empty
+     * query matches every preset.
+     *
+     * @param query Search text.
+     */
+    std::vector<int> search(const juce::String& query) const;
+
+    /**
+     * @brief Registers a listener.
+     */
+    void addListener(Listener* listener);
+
+    /**
+     * @brief Unregisters a listener.
+     */
+    void removeListener(Listener* listener);
+
+private:
+    /**
+     * @brief Scans the folder and swaps the new index in. Runs on the scanner thread.
+     */
+    void scan();
+
+    /**
+     * @brief Reads one preset file into an entry.
+     * @param file The file to read.
+     * @param entry Receives the file's metadata.
+     * @return False if the file is not a readable preset.
+     */
+    static bool readEntry(const juce::File& file, Entry& entry);
+
+    /**
+     * @brief Writes the bundled factory presets into a folder that does not exist yet.
+     * @param target The default preset folder.
+     */
+    static void installFactoryPresets(const juce::File& target);
+
+    /**
+     * @brief Loads the index saved by a previous session, if it still describes the folder.
+     */
+    void loadCachedIndex();
+
+    /**
+     * @brief Saves the index for the next session.
+     */
+    void saveIndex(const std::vector<Entry>& entries, const juce::File& folder) const;
+
+    /**
+     * @brief Returns the file the index is cached in.
+     */
+    static juce::File getIndexFile();
+
+    /** @brief Tells the listeners about a new index. */
+    void handleAsyncUpdate() override;
+
+    juce::PropertiesFile settings;          ///< Remembers the preset folder across sessions
+    juce::ThreadPool scanner{ 1 };          ///< Background thread scanning the folder
+    std::atomic<bool> scanQueued{ false };  ///< True while a scan waits for or runs on the scanner
+
+    juce::CriticalSection lock;             ///< Guards entries and folder
+    std::vector<Entry> entries;             ///< Index, sorted by name
+    juce::File folder;                      ///< Indexed folder
+
+    juce::ListenerList<Listener> listeners; ///< Registered listeners
+
+    JUCE_DECLARE_NON_COPYABLE(PresetLibrary)
+};
@@ -4,21 +4,63 @@
 PresetManager::PresetManager(juce::AudioProcessorValueTreeState& apvts, DigitalSynthesizerAudioProcessor& processor)
     : apvts(apvts), processor(processor)
 {
+    bank.onProgramApplied = [this](const juce::ValueTree& state, const juce::File& file) { finishProgramChange(state, file); };
+    bank.onProgramMissed = [this](int program)
+        {
+            if (loadPreset(program))
+                bank.preload(program, 1);
+        };
+
+    library.addListener(this);
+    bank.preload(0, bank.getCapacity());
+}
+
+PresetManager::~PresetManager()
+{
+    library.removeListener(this);
+    stopTimer();
+    cancelPendingUpdate();
+    loader.removeAllJobs(true, -1);
+
+    if (swappingState.isValid())
+        processor.endStateSwap();
 }
 
 juce::File PresetManager::getDefaultPresetFolder()
 {
-    auto root = juce::File(__FILE__);
-    for (int i = 0; i < 4; ++i)
-        root = root.getParentDirectory();
+    return library.getFolder();
+}
 
-    auto folder = root.getChildFile("Presets");
-    folder.createDirectory();
-    return folder;
+PresetLibrary& PresetManager::getLibrary()
+{
+    return library;
+}
+
+PresetBank& PresetManager::getBank()
+{
+    return bank;
+}
+
+int PresetManager::getCurrentPresetIndex() const
+{
+    juce::File current;
+    {
+        const juce::ScopedLock lock(pendingLock);
+        current = currentPresetFile;
+    }
+
+    return current == juce::File() ? -1 : library.indexOf(current);
 }
 
 void PresetManager::initPreset()
 {
+    {
+        const juce::ScopedLock lock(pendingLock);
+        currentPresetFile = juce::File();
+    }
+
+    cancelPendingLoad();
+
     for (auto* knob : processor.getKnobs())
     {
         if (knob != nullptr)
@@ -30,34 +72,168 @@ void PresetManager::initPreset()
     }
 
     apvts.replaceState(juce::ValueTree("PARAMETERS"));
+    processor.storeEngineOptions();
+    processor.restoreUserWavetables();
 }
 
 bool PresetManager::savePreset(const juce::File& presetFile)
 {
-    if (auto xml = apvts.copyState().createXml())
-        return xml->writeTo(presetFile);
-    return false;
+    auto xml = apvts.copyState().createXml();
+    if (xml == nullptr || !xml->writeTo(presetFile))
+        return false;
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        currentPresetFile = presetFile;
+    }
+
+    library.rescan();
+    return true;
 }
 
 bool PresetManager::loadPreset(const juce::File& presetFile)
 {
+    if (!presetFile.existsAsFile())
+        return false;
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        currentPresetFile = presetFile;
+    }
+
+    const int generation = ++loadGeneration;
+    loader.addJob([this, presetFile, generation] { parsePreset(presetFile, generation); });
+    return true;
+}
+
+bool PresetManager::loadPreset(int index)
+{
+    const auto entry = library.getEntry(index);
+    return entry.file != juce::File() && loadPreset(entry.file);
+}
+
+void PresetManager::stepPreset(int delta)
+{
+    const int numPresets = library.getNumPresets();
+    if (numPresets == 0)
+        return;
+
+    // From no preset in the library, the first step lands on either end
+    const int current = getCurrentPresetIndex();
+    const int start = current >= 0 ? current : (delta > 0 ? -1 : 0);
+    loadPreset(((start + delta) % numPresets + numPresets) % numPresets);
+}
+
+void PresetManager::parsePreset(const juce::File& presetFile, int generation)
+{
+    // A newer request already queued, skip the read altogether
+    if (generation != loadGeneration.load())
+        return;
+
     auto xml = juce::XmlDocument::parse(presetFile);
-    if (xml)
+    if (xml == nullptr)
+        return;
+
+    auto newTree = juce::ValueTree::fromXml(*xml);
+    if (!newTree.isValid() || generation != loadGeneration.load())
+        return;
+
     {
-        auto newTree = juce::ValueTree::fromXml(*xml);
-        if (newTree.isValid())
-        {
-            apvts.replaceState(newTree);
+        const juce::ScopedLock lock(pendingLock);
+        pendingState = newTree;
+    }
 
-            // Clear stale routing first
-            processor.getModulationRouter().disconnectAll();
+    triggerAsyncUpdate();
+}
 
-            // Restore routing from APVTS
-            processor.restoreModulationRouting();
-            return true;
-        }
+void PresetManager::handleAsyncUpdate()
+{
+    juce::ValueTree parsed;
+    {
+        const juce::ScopedLock lock(pendingLock);
+        std::swap(parsed, pendingState);
+    }
+
+    if (!parsed.isValid())
+        return;
+
+    // A swap already waiting for silence just takes the newer state
+    const bool alreadySwapping = swappingState.isValid();
+    swappingState = parsed;
+
+    if (alreadySwapping)
+        return;
+
+    processor.beginStateSwap();
+    swapStartTime = juce::Time::getMillisecondCounter();
+    startTimer(swapPollIntervalMs);
+}
+
+void PresetManager::timerCallback()
+{
+    if (!processor.isStateSwapHeld()
+        && juce::Time::getMillisecondCounter() - swapStartTime < swapTimeoutMs)
+        return;
+
+    stopTimer();
+    applyPendingPreset();
+}
+
+void PresetManager::presetLibraryChanged()
+{
+    // Program numbers follow the library order, so what the bank holds may now be other programs
+    bank.clear();
+    bank.preload(0, bank.getCapacity());
+
+    processor.updateHostDisplay(juce::AudioProcessor::ChangeDetails().withProgramChanged(true));
+}
+
+void PresetManager::cancelPendingLoad()
+{
+    // Supersede any preset still being read or waiting to be swapped in
+    ++loadGeneration;
+    cancelPendingUpdate();
+    if (swappingState.isValid())
+    {
+        stopTimer();
+        swappingState = {};
+        processor.endStateSwap();
     }
-    return false;
+}
+
+void PresetManager::finishProgramChange(const juce::ValueTree& state, const juce::File& file)
+{
+    cancelPendingLoad();
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        currentPresetFile = file;
+    }
+
+    // The parameters already match, this brings in routing and the rest of the state
+    apvts.replaceState(state.createCopy());
+    processor.storeEngineOptions();
+    processor.getModulationRouter().disconnectAll();
+    processor.restoreModulationRouting();
+    processor.restoreUserWavetables();
+
+    processor.updateHostDisplay(juce::AudioProcessor::ChangeDetails().withProgramChanged(true));
+}
+
+void PresetManager::applyPendingPreset()
+{
+    apvts.replaceState(swappingState);
+    swappingState = {};
+    processor.storeEngineOptions();
+
+    // Clear stale routing first
+    processor.getModulationRouter().disconnectAll();
+
+    // Restore routing from the new state
+    processor.restoreModulationRouting();
+    processor.restoreUserWavetables();
+
+    processor.endStateSwap();
 }
 
 void PresetManager::showLoadDialogBox()
@@ -133,6 +309,19 @@ void PresetManager::showSaveDialogBox()
         false);
 }
 
+void PresetManager::showChooseFolderDialogBox()
+{
+    folderChooser = std::make_unique<juce::FileChooser>("Choose the preset folder", library.getFolder());
+
+    folderChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectDirectories,
+        [this](const juce::FileChooser& chooser)
+        {
+            const auto folder = chooser.getResult();
+            if (folder.isDirectory())
+                library.setFolder(folder);
+        });
+}
+
 void PresetManager::setDialogBoundsWithAspectRatio(juce::FileChooserDialogBox* dialog)
 {
     const int width = dialogBoxWidth;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../../Common.h"
+#include "PresetBank.h"
+#include "PresetLibrary.h"
 #include <JuceHeader.h>
 
 class DigitalSynthesizerAudioProcessor;
@@ -8,8 +10,21 @@ class DigitalSynthesizerAudioProcessor;
 /**
  * @class PresetManager
  * @brief Manages synthesizer preset functionality including init, load, and save operations.
+ *
+ * Loading never blocks the message thread on file I/O: the file is read and parsed
+ * on a background thread, and only the finished state comes back. The swap itself
+ * waits until the processor has faded its output out and holds it silent, so the
+ * audio thread never plays a half-replaced state, and the output fades back in once
+ * parameters and routing are all in place.
+ *
+ * Presets are browsed and stepped through the PresetLibrary index of the user's
+ * preset folder, which also backs the host's program list. The first programs of
+ * the library stay parsed in a PresetBank, so MIDI Program Change recalls them at
+ * the next block.
  */
-class PresetManager
+class PresetManager : private juce::AsyncUpdater,
+    private juce::Timer,
+    private PresetLibrary::Listener
 {
 public:
     /**
@@ -20,11 +35,31 @@ public:
     PresetManager(juce::AudioProcessorValueTreeState& apvts, DigitalSynthesizerAudioProcessor& processor);
 
     /**
-     * @brief Returns the default preset folder path, ensuring it exists.
-     * @return A juce::File object representing the default preset folder.
+     * @brief Waits for a file still being read and drops a swap not applied yet.
+     */
+    ~PresetManager() override;
+
+    /**
+     * @brief Returns the user's preset folder, ensuring it exists.
+     * @return A juce::File object representing the preset folder.
      */
     juce::File getDefaultPresetFolder();
 
+    /**
+     * @brief Returns the index of the preset folder.
+     */
+    PresetLibrary& getLibrary();
+
+    /**
+     * @brief Returns the cache of parsed presets that MIDI Program Change reads.
+     */
+    PresetBank& getBank();
+
+    /**
+     * @brief Returns the library index of the preset loaded last, or -1 if it is not in the library.
+     */
+    int getCurrentPresetIndex() const;
+
     /**
      * @brief Resets the synth parameters to their initial/default state.
      */
@@ -38,12 +73,29 @@ public:
     bool savePreset(const juce::File& presetFile);
 
     /**
-     * @brief Loads a preset from the specified file into the plugin state.
+     * @brief Starts loading a preset from the specified file into the plugin state.
+     *
+     * Returns at once, the state is replaced a few blocks later. A newer request
+     * supersedes one whose file is still being read.
+     *
      * @param presetFile File to load the preset from.
-     * @return true if loaded successfully, false otherwise.
+     * @return true if the file exists and loading started, false otherwise.
      */
     bool loadPreset(const juce::File& presetFile);
 
+    /**
+     * @brief Starts loading a preset from the library.
+     * @param index Index into the library.
+     * @return true if the index names a preset and loading started, false otherwise.
+     */
+    bool loadPreset(int index);
+
+    /**
+     * @brief Steps to another preset of the library, wrapping around at either end.
+     * @param delta +1 for the next preset, -1 for the previous one.
+     */
+    void stepPreset(int delta);
+
     /**
      * @brief Displays a file dialog to let the user choose a preset file to load.
      */
@@ -54,10 +106,67 @@ public:
      */
     void showSaveDialogBox();
 
+    /**
+     * @brief Displays a folder chooser to move the user's preset folder.
+     */
+    void showChooseFolderDialogBox();
+
 private:
+    /**
+     * @brief Reads and parses a preset file. Runs on the loader thread.
+     * @param presetFile File to read.
+     * @param generation Request the file belongs to.
+     */
+    void parsePreset(const juce::File& presetFile, int generation);
+
+    /**
+     * @brief Starts the swap of a parsed preset, on the message thread.
+     */
+    void handleAsyncUpdate() override;
+
+    /**
+     * @brief Applies the parsed preset once the output is held silent.
+     */
+    void timerCallback() override;
+
+    /**
+     * @brief Replaces the state and rebuilds routing, then lets the output fade back in.
+     */
+    void applyPendingPreset();
+
+    /**
+     * @brief Drops a preset still being read or waiting to be swapped in.
+     */
+    void cancelPendingLoad();
+
+    /**
+     * @brief Swaps in the rest of a program the audio thread already switched to.
+     */
+    void finishProgramChange(const juce::ValueTree& state, const juce::File& file);
+
+    /**
+     * @brief Tells the host its program list changed.
+     */
+    void presetLibraryChanged() override;
+
     juce::AudioProcessorValueTreeState& apvts;   ///< Reference to the AudioProcessorValueTreeState.
     DigitalSynthesizerAudioProcessor& processor; ///< Reference to the processor.
 
+    PresetLibrary library;                    ///< Index of the preset folder
+    std::unique_ptr<juce::FileChooser> folderChooser; ///< Folder chooser while it is open
+
+    juce::ThreadPool loader{ 1 };             ///< Background thread reading preset files
+    PresetBank bank{ apvts, library, loader }; ///< Parsed presets for Program Change
+    std::atomic<int> loadGeneration{ 0 };     ///< Incremented by every load request
+    juce::CriticalSection pendingLock;        ///< Guards pendingState and currentPresetFile across threads
+    juce::ValueTree pendingState;             ///< Parsed state waiting to be swapped in
+    juce::File currentPresetFile;             ///< Preset loaded or saved last
+    juce::ValueTree swappingState;            ///< State being swapped in, message thread only
+    juce::uint32 swapStartTime = 0;           ///< When the swap started waiting, in milliseconds
+
+    static constexpr int swapPollIntervalMs = 5; ///< How often the message thread checks the fade-out
+    static constexpr juce::uint32 swapTimeoutMs = 250; ///< Applies anyway when no audio callback runs
+
     static constexpr int dialogBoxHeight = 400; ///< Default dialog height in pixels.
     static constexpr int dialogBoxWidth = 800;  ///< Default dialog width in pixels.
 
@@ -0,0 +1,32 @@
+#include "RefreshScheduler.h"
+
+RefreshScheduler::~RefreshScheduler()
+{
+    stopTimer();
+}
+
+void RefreshScheduler::add(Client* client)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert(client != nullptr);
+
+    clients.add(client);
+
+    if (!isTimerRunning())
+        startTimerHz(refreshRateHz);
+}
+
+void RefreshScheduler::remove(Client* client)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    clients.remove(client);
+
+    if (clients.isEmpty())
+        stopTimer();
+}
+
+void RefreshScheduler::timerCallback()
+{
+    clients.call([](Client& client) { client.refresh(); });
+}
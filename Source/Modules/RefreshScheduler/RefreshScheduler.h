@@ -0,0 +1,70 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class RefreshScheduler
+ * @brief One shared, frame-rate-limited UI refresh tick for every animated component.
+ *
+ * Held through juce::SharedResourcePointer, so all editors in the process share
+ * a single timer instead of each knob and meter running its own. Components
+ * register while they have something to animate and get refresh() once per
+ * frame; the timer only runs while at least one client is registered.
+ */
+class RefreshScheduler : private juce::Timer
+{
+public:
+    static constexpr int refreshRateHz = 30; ///< Frames per second delivered to clients
+
+    /**
+     * @class Client
+     * @brief A component that redraws from the shared tick.
+     */
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+
+        /**
+         * @brief Called once per frame on the message thread while registered.
+         *
+         * Clients read their latest state here and repaint at most once.
+         */
+        virtual void refresh() = 0;
+    };
+
+    /**
+     * @brief Constructs an idle scheduler.
+     */
+    RefreshScheduler() = default;
+
+    /**
+     * @brief Stops the shared timer.
+     */
+    ~RefreshScheduler() override;
+
+    /**
+     * @brief Registers a client, starting the timer if it was idle. Adding twice has no effect.
+     * @param client Client to tick. Message thread only.
+     */
+    void add(Client* client);
+
+    /**
+     * @brief Unregisters a client, stopping the timer once none are left.
+     *
+     * Safe to call from inside the client's own refresh().
+     *
+     * @param client Client to remove. Message thread only.
+     */
+    void remove(Client* client);
+
+private:
+    /**
+     * @brief Ticks every registered client.
+     */
+    void timerCallback() override;
+
+    juce::ListenerList<Client> clients; ///< Registered clients, safe against removal while ticking
+
+    JUCE_DECLARE_NON_COPYABLE(RefreshScheduler)
+};
@@ -0,0 +1,123 @@
+#include "OscRemoteControl.h"
+
+bool OscRemoteControl::isSupported() noexcept
+{
+    return OSC_REMOTE_AVAILABLE;
+}
+
+OscRemoteControl::OscRemoteControl(juce::AudioProcessor& processor)
+{
+    const juce::String prefix = juce::String(addressPrefix) + "/";
+
+    for (auto* parameter : processor.getParameters())
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        if (ranged == nullptr)
+            continue;
+
+        const auto address = (prefix + ranged->getParameterID()).toStdString();
+        addresses[address] = { ranged, false };
+        addresses[address + "/value"] = { ranged, true };
+    }
+
+#if OSC_REMOTE_AVAILABLE
+    receiver.addListener(this);
+#endif
+}
+
+OscRemoteControl::~OscRemoteControl()
+{
+    disconnect();
+
+#if OSC_REMOTE_AVAILABLE
+    receiver.removeListener(this);
+#endif
+}
+
+bool OscRemoteControl::connect(int newPort)
+{
+    jassert(newPort > 0 && newPort <= 65535);
+
+    // The old network thread has stopped once disconnect() returns, so the queue keeps a single producer
+    disconnect();
+
+#if OSC_REMOTE_AVAILABLE
+    if (newPort <= 0 || newPort > 65535 || !receiver.connect(newPort))
+        return false;
+
+    port = newPort;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void OscRemoteControl::disconnect()
+{
+#if OSC_REMOTE_AVAILABLE
+    if (port != 0)
+        receiver.disconnect();
+#endif
+
+    port = 0;
+}
+
+int OscRemoteControl::getPort() const noexcept
+{
+    return port.load();
+}
+
+void OscRemoteControl::applyPendingChanges(ParameterRelay& relay) noexcept
+{
+    Change change;
+    while (changes.pop(change))
+    {
+        // Show-control systems resend unchanged values, skip those rather than notify the host again
+        if (change.parameter->getValue() != change.normalized)
+            relay.push(*change.parameter, change.normalized);
+    }
+}
+
+int OscRemoteControl::getNumDroppedChanges() const noexcept
+{
+    return droppedChanges.load(std::memory_order_relaxed);
+}
+
+#if OSC_REMOTE_AVAILABLE
+void OscRemoteControl::oscMessageReceived(const juce::OSCMessage& message)
+{
+    if (message.isEmpty())
+        return;
+
+    const auto found = addresses.find(message.getAddressPattern().toString().toStdString());
+    if (found == addresses.end())
+        return;
+
+    const auto& argument = message[0];
+    float value = 0.0f;
+
+    if (argument.isFloat32())
+        value = argument.getFloat32();
+    else if (argument.isInt32())
+        value = static_cast<float>(argument.getInt32());
+    else
+        return;
+
+    const auto& address = found->second;
+    const float normalized = address.plainValue ? address.parameter->convertTo0to1(value) : value;
+
+    if (!changes.push({ address.parameter, juce::jlimit(0.0f, 1.0f, normalized) }))
+        droppedChanges.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OscRemoteControl::oscBundleReceived(const juce::OSCBundle& bundle)
+{
+    for (const auto& element : bundle)
+    {
+        if (element.isMessage())
+            oscMessageReceived(element.getMessage());
+        else if (element.isBundle())
+            oscBundleReceived(element.getBundle());
+    }
+}
+#endif
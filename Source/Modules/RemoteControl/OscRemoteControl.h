@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../../Common.h"
+#include "../CommandQueue/SpscQueue.h"
+#include "../ParameterRelay/ParameterRelay.h"
+#include <JuceHeader.h>
+#include <string>
+#include <unordered_map>
+
+#define OSC_REMOTE_AVAILABLE (OSC_REMOTE_CONTROL && JUCE_MODULE_AVAILABLE_juce_osc) ///< 1 if OscRemoteControl can listen for OSC
+
+/**
+ * @class OscRemoteControl
+ * @brief Parameter control over OSC, applied on the audio thread at the start of each block.
+ *
+ * A UDP receiver runs on its own network thread and resolves every message
+ * address to a parameter through a table built once at construction:
+ *
+ *     /synth/<PARAM_ID>        float or int in [0, 1], the normalized value
+ *     /synth/<PARAM_ID>/value  float or int in the parameter's own units
+ *
+ * Resolved changes go through a wait-free SPSC queue the audio thread drains
+ * before anything reads parameters, so a change lands exactly on the next
+ * block boundary and takes the same automation ramp as host automation. The
+ * values are set through a ParameterRelay, so the host and the editor hear of
+ * them from the message thread. The processor owns the receiver, so control
+ * works without an editor. Neither side ever blocks; changes arriving while
+ * the queue is full are dropped and counted. Bundles are applied as they
+ * arrive, their time tags ignored.
+ *
+ * Builds without the juce_osc module or with OSC_REMOTE_CONTROL off compile
+ * the receiver out and connect() always fails.
+ */
+class OscRemoteControl
+#if OSC_REMOTE_AVAILABLE
+    : private juce::OSCReceiver::Listener<juce::OSCReceiver::RealtimeCallback>
+#endif
+{
+public:
+    static constexpr const char* addressPrefix = "/synth"; ///< First part of every parameter address
+    static constexpr int queueCapacity = 1024;             ///< Changes that may wait for the audio thread
+
+    /**
+     * @brief Returns true if this build can listen for OSC.
+     */
+    static bool isSupported() noexcept;
+
+    /**
+     * @brief Builds the address table of every parameter of a processor. Not connected yet.
+     * @param processor Processor whose parameters are controlled; must outlive this object.
+     */
+    explicit OscRemoteControl(juce::AudioProcessor& processor);
+
+    /**
+     * @brief Stops the receiver thread.
+     */
+    ~OscRemoteControl();
+
+    /**
+     * @brief Starts listening on a UDP port, replacing any port listened on before.
+     *
+     * Never call from the audio thread, nor concurrently with disconnect().
+     *
+     * @param port UDP port in [1, 65535].
+     * @return False if the build has no OSC support or the port could not be bound.
+     */
+    bool connect(int port);
+
+    /**
+     * @brief Stops listening and waits for the network thread to end. Never call from the audio thread.
+     */
+    void disconnect();
+
+    /**
+     * @brief Returns the port listened on, 0 while disconnected.
+     */
+    int getPort() const noexcept;
+
+    /**
+     * @brief Applies every change received since the last call. Audio thread, at the start of a block.
+     * @param relay Relay the values are set through.
+     */
+    void applyPendingChanges(ParameterRelay& relay) noexcept;
+
+    /**
+     * @brief Returns how many changes were dropped on a full queue since construction.
+     */
+    int getNumDroppedChanges() const noexcept;
+
+private:
+    /**
+     * @struct Change
+     * @brief One parameter change on its way to the audio thread.
+     */
+    struct Change
+    {
+        juce::RangedAudioParameter* parameter = nullptr; ///< Parameter to write
+        float normalized = 0.0f;                         ///< New normalized value
+    };
+
+    /**
+     * @struct Address
+     * @brief What an OSC address controls.
+     */
+    struct Address
+    {
+        juce::RangedAudioParameter* parameter = nullptr; ///< Parameter written
+        bool plainValue = false;                         ///< True if the argument is in the parameter's own units
+    };
+
+#if OSC_REMOTE_AVAILABLE
+    /** @brief Queues the change a message addresses, on the network thread. */
+    void oscMessageReceived(const juce::OSCMessage& message) override;
+
+    /** @brief Queues the changes of every message in a bundle, on the network thread. */
+    void oscBundleReceived(const juce::OSCBundle& bundle) override;
+
+    juce::OSCReceiver receiver{ "OSC Remote Control" };  ///< Socket and its network thread
+#endif
+
+    std::unordered_map<std::string, Address> addresses;   ///< Parameter per address, read-only after construction
+    SpscQueue<Change, queueCapacity> changes;             ///< Network thread to audio thread
+    std::atomic<int> droppedChanges{ 0 };                 ///< Changes lost to a full queue
+    std::atomic<int> port{ 0 };                           ///< Port listened on, 0 while disconnected
+
+    JUCE_DECLARE_NON_COPYABLE(OscRemoteControl)
+};
@@ -0,0 +1,62 @@
+#include "RenderPool.h"
+
+RenderPool::~RenderPool()
+{
+    release();
+}
+
+void RenderPool::prepare(int numWorkers)
+{
+    if (numWorkers <= 0)
+    {
+        release();
+        return;
+    }
+
+    if (lane == nullptr)
+        lane = scheduler->attach();
+
+    maxHelpers = (lane != nullptr) ? numWorkers : 0;
+}
+
+void RenderPool::release()
+{
+    scheduler->detach(lane);
+    lane = nullptr;
+    maxHelpers = 0;
+}
+
+int RenderPool::getNumWorkers() const noexcept
+{
+    return juce::jmin(maxHelpers, scheduler->getNumWorkers());
+}
+
+void RenderPool::beginBlock(int numSamples, double sampleRate) noexcept
+{
+    if (lane == nullptr || sampleRate <= 0.0)
+        return;
+
+    const double blockSeconds = numSamples / sampleRate;
+    RenderScheduler::setDeadline(*lane, juce::Time::getHighResolutionTicks() + juce::Time::secondsToHighResolutionTicks(blockSeconds));
+}
+
+void RenderPool::run(Task task, void* context, int numTasks) noexcept
+{
+    if (numTasks <= 0)
+        return;
+
+    // Nothing to share, skip the handoff
+    if (lane == nullptr || getNumWorkers() == 0 || numTasks == 1)
+    {
+        for (int i = 0; i < numTasks; ++i)
+            task(context, i);
+        return;
+    }
+
+    scheduler->run(*lane, task, context, numTasks, maxHelpers);
+}
+
+int RenderPool::getRecommendedWorkerCount(int maxUseful) noexcept
+{
+    return juce::jlimit(0, juce::jmax(0, maxUseful), RenderScheduler::getMachineWorkerCount());
+}
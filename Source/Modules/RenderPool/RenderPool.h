@@ -0,0 +1,81 @@
+#pragma once
+
+#include "RenderScheduler.h"
+#include <JuceHeader.h>
+
+/**
+ * @class RenderPool
+ * @brief One instance's handle onto the shared RenderScheduler, running batches of independent render tasks in parallel.
+ *
+ * The audio thread publishes a batch with run() and works on it alongside the
+ * shared workers. Tasks are claimed from an atomic counter in the instance's
+ * lane, so an idle thread picks up the next unclaimed task. The workers belong
+ * to the whole process and serve the instance whose block is due first, which
+ * beginBlock() tells them. Nothing on the hot path takes a lock or allocates.
+ */
+class RenderPool
+{
+public:
+    using Task = RenderScheduler::Task;
+
+    /**
+     * @brief Constructs a pool that renders serially until prepared.
+     */
+    RenderPool() = default;
+
+    /**
+     * @brief Leaves the shared scheduler.
+     */
+    ~RenderPool();
+
+    /**
+     * @brief Joins or leaves the shared scheduler.
+     *
+     * Must not be called while run() is in progress.
+     *
+     * @param numWorkers Most shared workers a batch of this instance uses, zero to render serially.
+     */
+    void prepare(int numWorkers);
+
+    /**
+     * @brief Leaves the shared scheduler, batches then run on the calling thread.
+     */
+    void release();
+
+    /**
+     * @brief Returns the number of shared workers a batch of this instance can use.
+     */
+    int getNumWorkers() const noexcept;
+
+    /**
+     * @brief Marks the start of an audio block, whose end is the deadline the workers order instances by.
+     * @param numSamples Length of the block.
+     * @param sampleRate Sample rate of the block.
+     */
+    void beginBlock(int numSamples, double sampleRate) noexcept;
+
+    /**
+     * @brief Runs a batch of tasks and returns once all of them finished.
+     *
+     * The calling thread takes part in the batch, so the pool also works with no workers.
+     *
+     * @param task Function to run for every task index.
+     * @param context Opaque pointer passed to every task.
+     * @param numTasks Number of tasks in the batch.
+     */
+    void run(Task task, void* context, int numTasks) noexcept;
+
+    /**
+     * @brief Returns the number of shared workers worth using for one batch on this machine.
+     * @param maxUseful Upper bound, usually the number of independent tasks minus one.
+     * @return Worker count, zero on single-core machines.
+     */
+    static int getRecommendedWorkerCount(int maxUseful) noexcept;
+
+private:
+    juce::SharedResourcePointer<RenderScheduler> scheduler; ///< Workers shared by every instance in the process
+    RenderScheduler::Lane* lane = nullptr;                  ///< This instance's lane, nullptr while rendering serially
+    int maxHelpers = 0;                                     ///< Most workers woken for one batch
+
+    JUCE_DECLARE_NON_COPYABLE(RenderPool)
+};
@@ -0,0 +1,249 @@
+#include "RenderScheduler.h"
+#include "../EngineStats/AllocationTracker.h"
+
+RenderScheduler::~RenderScheduler()
+{
+    // Every instance detaches before its SharedResourcePointer lets go
+    jassert(numAttached == 0);
+    stopWorkers();
+}
+
+RenderScheduler::Lane* RenderScheduler::attach()
+{
+    if (getMachineWorkerCount() == 0)
+        return nullptr;
+
+    const juce::ScopedLock lock(attachLock);
+
+    for (int i = 0; i < maxLanes; ++i)
+    {
+        auto& lane = lanes[static_cast<size_t>(i)];
+        if (lane.attached)
+            continue;
+
+        lane.attached = true;
+        lane.deadline.store(0, std::memory_order_relaxed);
+        numLanesInUse.store(juce::jmax(numLanesInUse.load(std::memory_order_relaxed), i + 1), std::memory_order_release);
+
+        if (numAttached++ == 0)
+            startWorkers();
+
+        return &lane;
+    }
+
+    return nullptr;
+}
+
+void RenderScheduler::detach(Lane* lane)
+{
+    if (lane == nullptr)
+        return;
+
+    const juce::ScopedLock lock(attachLock);
+    jassert(lane->attached && !lane->hasOpenTasks());
+
+    lane->attached = false;
+
+    int highest = 0;
+    for (int i = 0; i < maxLanes; ++i)
+        if (lanes[static_cast<size_t>(i)].attached)
+            highest = i + 1;
+    numLanesInUse.store(highest, std::memory_order_release);
+
+    if (--numAttached == 0)
+        stopWorkers();
+}
+
+int RenderScheduler::getNumWorkers() const noexcept
+{
+    return numWorkers.load(std::memory_order_relaxed);
+}
+
+void RenderScheduler::run(Lane& lane, Task task, void* context, int numTasks, int maxHelpers) noexcept
+{
+    // Close the batch while its fields are rewritten, so late claims from the last batch fail
+    const uint64_t generation = static_cast<uint64_t>(generationOf(lane.batchState.load(std::memory_order_relaxed)) + 1) << 32;
+    lane.batchState.store(generation | closedIndex, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    lane.batchTask.store(task, std::memory_order_relaxed);
+    lane.batchContext.store(context, std::memory_order_relaxed);
+    lane.batchSize.store(numTasks, std::memory_order_relaxed);
+    lane.tasksRemaining.store(numTasks, std::memory_order_relaxed);
+
+    lane.batchState.store(generation, std::memory_order_release);
+    publishCount.fetch_add(1, std::memory_order_release);
+
+    // Only sleeping workers need the (locking) event, spinning ones see the new count
+    int toWake = juce::jmin(maxHelpers, numTasks - 1);
+    for (auto& worker : workers)
+    {
+        if (toWake <= 0)
+            break;
+
+        if (worker->sleeping.exchange(false, std::memory_order_acq_rel))
+        {
+            worker->wakeEvent.signal();
+            --toWake;
+        }
+    }
+
+    while (lane.runNextTask())
+    {
+    }
+
+    // Wait for tasks still running on workers
+    int spins = 0;
+    while (lane.tasksRemaining.load(std::memory_order_acquire) > 0)
+    {
+        if (++spins > spinIterations)
+            juce::Thread::yield();
+    }
+}
+
+void RenderScheduler::setDeadline(Lane& lane, int64_t deadlineTicks) noexcept
+{
+    lane.deadline.store(deadlineTicks, std::memory_order_relaxed);
+}
+
+int RenderScheduler::getMachineWorkerCount() noexcept
+{
+    return juce::jlimit(0, maxWorkers, juce::SystemStats::getNumPhysicalCpus() - 1);
+}
+
+bool RenderScheduler::runEarliestTask() noexcept
+{
+    for (;;)
+    {
+        const int numLanes = numLanesInUse.load(std::memory_order_acquire);
+
+        // Earliest deadline first, among the lanes with unclaimed tasks
+        Lane* earliest = nullptr;
+        int64_t earliestDeadline = 0;
+        for (int i = 0; i < numLanes; ++i)
+        {
+            auto& lane = lanes[static_cast<size_t>(i)];
+            if (!lane.hasOpenTasks())
+                continue;
+
+            const int64_t due = lane.deadline.load(std::memory_order_relaxed);
+            if (earliest == nullptr || due < earliestDeadline)
+            {
+                earliest = &lane;
+                earliestDeadline = due;
+            }
+        }
+
+        if (earliest == nullptr)
+            return false;
+
+        // The lane may have drained since the scan, then another one can still be open
+        if (earliest->runNextTask())
+            return true;
+    }
+}
+
+void RenderScheduler::startWorkers()
+{
+    for (int i = 0; i < getMachineWorkerCount(); ++i)
+    {
+        auto worker = std::make_unique<Worker>(*this, i);
+        if (!worker->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(9)))
+            break;
+
+        workers.push_back(std::move(worker));
+    }
+
+    numWorkers.store(static_cast<int>(workers.size()), std::memory_order_relaxed);
+}
+
+void RenderScheduler::stopWorkers()
+{
+    for (auto& worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->wakeEvent.signal();
+    }
+
+    for (auto& worker : workers)
+        worker->stopThread(1000);
+
+    workers.clear();
+    numWorkers.store(0, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// RenderScheduler::Lane
+
+bool RenderScheduler::Lane::runNextTask() noexcept
+{
+    for (;;)
+    {
+        uint64_t state = batchState.load(std::memory_order_acquire);
+        const uint32_t index = indexOf(state);
+        if (index == closedIndex)
+            return false;
+
+        const Task task = batchTask.load(std::memory_order_relaxed);
+        void* const context = batchContext.load(std::memory_order_relaxed);
+        const int numTasks = batchSize.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (index >= static_cast<uint32_t>(numTasks))
+            return false;
+
+        // The claim only succeeds if the batch was not closed since the fields were read
+        if (batchState.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            // Tasks are part of the owner's audio callback, whichever thread runs them
+            const AllocationTracker::ScopedRealtime realtime;
+            task(context, static_cast<int>(index));
+            tasksRemaining.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+bool RenderScheduler::Lane::hasOpenTasks() const noexcept
+{
+    const uint32_t index = indexOf(batchState.load(std::memory_order_acquire));
+    return index != closedIndex && index < static_cast<uint32_t>(batchSize.load(std::memory_order_relaxed));
+}
+
+//==============================================================================
+// RenderScheduler::Worker
+
+RenderScheduler::Worker::Worker(RenderScheduler& owner, int index)
+    : juce::Thread("Render Worker " + juce::String(index + 1)), scheduler(owner), workerIndex(index)
+{
+}
+
+void RenderScheduler::Worker::run()
+{
+    // Keep each worker on its own core, away from core 0 where hosts tend to put the audio thread
+    const int numCpus = juce::jmax(1, juce::SystemStats::getNumCpus());
+    juce::Thread::setCurrentThreadAffinityMask(1u << ((workerIndex + 1) % juce::jmin(numCpus, 32)));
+
+    while (!threadShouldExit())
+    {
+        // Read before stealing, a batch published during the scan then shows as a changed count
+        const uint64_t observed = scheduler.publishCount.load(std::memory_order_acquire);
+        if (scheduler.runEarliestTask())
+            continue;
+
+        int spins = 0;
+        while (scheduler.publishCount.load(std::memory_order_acquire) == observed && spins < spinIterations)
+            ++spins;
+
+        if (scheduler.publishCount.load(std::memory_order_acquire) == observed)
+        {
+            sleeping.store(true, std::memory_order_release);
+
+            // Re-check after announcing, a batch published in between would otherwise be missed
+            if (scheduler.publishCount.load(std::memory_order_acquire) == observed)
+                wakeEvent.wait(100);
+
+            sleeping.store(false, std::memory_order_release);
+        }
+    }
+}
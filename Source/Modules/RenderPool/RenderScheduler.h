@@ -0,0 +1,176 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class RenderScheduler
+ * @brief Process-wide set of real-time render workers shared by every plugin instance.
+ *
+ * Each instance holds it through a juce::SharedResourcePointer and attaches a
+ * Lane, its own slot for one batch at a time. The workers are sized to the
+ * machine rather than to the instance count, so a session with dozens of
+ * instances adds no threads beyond one per spare physical core. A free worker
+ * steals the next task from the open lane whose block is due first, and picks
+ * again after every task, so the instance closest to its deadline gets the
+ * help. Workers spin briefly once nothing is open and then sleep, leaving the
+ * cores to the host's own threads.
+ *
+ * Attaching and detaching take a lock and start or stop the workers with the
+ * first and last lane; publishing, stealing and waiting never do.
+ */
+class RenderScheduler
+{
+public:
+    /**
+     * @brief A render task.
+     * @param context Opaque pointer passed with the batch.
+     * @param taskIndex Index of the task within the batch.
+     */
+    using Task = void (*)(void* context, int taskIndex);
+
+    static constexpr int maxLanes = 64;    ///< Instances that can render in parallel at once, later ones render serially
+    static constexpr int maxWorkers = 31;  ///< Upper bound on shared workers, one core stays with the host
+
+    /**
+     * @class Lane
+     * @brief One instance's batch slot, drained by its audio thread and stolen from by the workers.
+     */
+    class alignas(64) Lane
+    {
+    public:
+        /**
+         * @brief Claims and runs one task of the open batch.
+         * @return False if the batch has no unclaimed task left.
+         */
+        bool runNextTask() noexcept;
+
+        /**
+         * @brief Returns true if the batch has unclaimed tasks.
+         */
+        bool hasOpenTasks() const noexcept;
+
+    private:
+        friend class RenderScheduler;
+
+        std::atomic<uint64_t> batchState{ 0 };        ///< Generation in the high half, next task index in the low half
+        std::atomic<Task> batchTask{ nullptr };       ///< Task of the current batch
+        std::atomic<void*> batchContext{ nullptr };   ///< Context of the current batch
+        std::atomic<int> batchSize{ 0 };              ///< Number of tasks in the current batch
+        std::atomic<int> tasksRemaining{ 0 };         ///< Tasks of the current batch not yet finished
+        std::atomic<int64_t> deadline{ 0 };           ///< High-resolution tick by which the owner's block is due
+        bool attached = false;                        ///< True while an instance owns the lane, guarded by the scheduler lock
+    };
+
+    /**
+     * @brief Constructs the scheduler without workers, they start with the first lane.
+     */
+    RenderScheduler() = default;
+
+    /**
+     * @brief Stops the workers.
+     */
+    ~RenderScheduler();
+
+    /**
+     * @brief Gives an instance a lane, starting the workers if it is the first.
+     * @return The lane, or nullptr if all lanes are taken or the machine has no spare core.
+     */
+    Lane* attach();
+
+    /**
+     * @brief Returns a lane, stopping the workers if it was the last.
+     *
+     * Must not be called while its owner is in run().
+     *
+     * @param lane Lane returned by attach(), may be nullptr.
+     */
+    void detach(Lane* lane);
+
+    /**
+     * @brief Returns the number of running shared workers.
+     */
+    int getNumWorkers() const noexcept;
+
+    /**
+     * @brief Runs a batch on a lane and returns once all of its tasks finished.
+     *
+     * The calling thread works on its own lane while free workers steal from it.
+     *
+     * @param lane The caller's attached lane.
+     * @param task Function to run for every task index.
+     * @param context Opaque pointer passed to every task.
+     * @param numTasks Number of tasks in the batch.
+     * @param maxHelpers Most workers woken for this batch.
+     */
+    void run(Lane& lane, Task task, void* context, int numTasks, int maxHelpers) noexcept;
+
+    /**
+     * @brief Sets when the owner's current block is due, which orders the lanes for the workers.
+     * @param lane The caller's attached lane.
+     * @param deadlineTicks High-resolution tick, see juce::Time::getHighResolutionTicks().
+     */
+    static void setDeadline(Lane& lane, int64_t deadlineTicks) noexcept;
+
+    /**
+     * @brief Returns the number of shared workers worth starting on this machine.
+     */
+    static int getMachineWorkerCount() noexcept;
+
+private:
+    /**
+     * @class Worker
+     * @brief A pinned real-time thread that steals tasks from the lanes.
+     */
+    class Worker : public juce::Thread
+    {
+    public:
+        /**
+         * @brief Constructs a worker for the scheduler.
+         * @param owner Scheduler whose lanes this worker serves.
+         * @param index Index of the worker, used for naming and core pinning.
+         */
+        Worker(RenderScheduler& owner, int index);
+
+        /** @brief Steals tasks, spinning and then sleeping while no lane is open, until asked to exit. */
+        void run() override;
+
+        std::atomic<bool> sleeping{ false }; ///< True while blocked on wakeEvent
+        juce::WaitableEvent wakeEvent;       ///< Signalled when a batch arrives for a sleeping worker
+
+    private:
+        RenderScheduler& scheduler; ///< Owning scheduler
+        int workerIndex;            ///< Index of this worker
+    };
+
+    /**
+     * @brief Runs one task of the open lane due first.
+     * @return False if no lane had an unclaimed task.
+     */
+    bool runEarliestTask() noexcept;
+
+    void startWorkers();
+    void stopWorkers();
+
+    /**
+     * @brief Returns the generation stored in a batch state word.
+     */
+    static uint32_t generationOf(uint64_t state) noexcept { return static_cast<uint32_t>(state >> 32); }
+
+    /**
+     * @brief Returns the next task index stored in a batch state word.
+     */
+    static uint32_t indexOf(uint64_t state) noexcept { return static_cast<uint32_t>(state); }
+
+    static constexpr int spinIterations = 4000;          ///< Polls before a worker goes to sleep
+    static constexpr uint32_t closedIndex = 0xffffffffu; ///< Task index that marks a batch being rewritten
+
+    juce::CriticalSection attachLock;                    ///< Guards attaching, detaching and the worker list
+    std::array<Lane, maxLanes> lanes;                    ///< Lane slots, never freed while the scheduler lives
+    std::atomic<int> numLanesInUse{ 0 };                 ///< Slots up to the highest attached lane, the range workers scan
+    int numAttached = 0;                                 ///< Attached lanes, guarded by attachLock
+    std::vector<std::unique_ptr<Worker>> workers;        ///< Running workers
+    std::atomic<int> numWorkers{ 0 };                    ///< Size of workers, readable from any thread
+    std::atomic<uint64_t> publishCount{ 0 };             ///< Bumped on every published batch, a worker waits for it to change
+
+    JUCE_DECLARE_NON_COPYABLE(RenderScheduler)
+};
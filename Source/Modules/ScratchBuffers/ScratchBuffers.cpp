@@ -0,0 +1,26 @@
+#include "ScratchBuffers.h"
+
+void ScratchBuffers::prepare(int maxBlockSize)
+{
+    capacity = juce::jmax(1, maxBlockSize);
+
+    for (auto& buffer : buffers)
+        buffer.setSize(maxChannels, capacity);
+}
+
+juce::AudioBuffer<float>& ScratchBuffers::get(Slot slot, int numChannels, int numSamples)
+{
+    // Hosts may exceed the announced block size; growing is allowed but allocates
+    jassert(numChannels <= maxChannels);
+    jassert(numSamples <= capacity);
+
+    auto& buffer = buffers[static_cast<size_t>(slot)];
+    buffer.setSize(numChannels, numSamples, false, false, true);
+    return buffer;
+}
+
+size_t ScratchBuffers::getMemoryBytes() const noexcept
+{
+    // get() only shrinks the visible size, the prepared storage stays
+    return buffers.size() * static_cast<size_t>(maxChannels) * static_cast<size_t>(capacity) * sizeof(float);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class ScratchBuffers
+ * @brief Preallocated scratch audio buffers shared by the DSP stages.
+ *
+ * Owned by the processor and sized in prepareToPlay(). Each processing stage
+ * borrows its own slot for the duration of a call, so stages that nest
+ * (Oscillator -> Filter) never share storage, and the audio
+ * thread does not allocate in steady state.
+ */
+class ScratchBuffers
+{
+public:
+    /**
+     * @enum Slot
+     * @brief One buffer per processing stage that needs scratch storage.
+     */
+    enum class Slot
+    {
+        OscillatorLanes,  ///< Per-note render lanes of an Oscillator
+        OscillatorFilter, ///< Oscillator output before it goes through the linked Filter
+        OscillatorBranch, ///< One parallel filter branch of an Oscillator
+        FilterDry,        ///< Dry copy for the Filter's dry/wet mix
+        Count
+    };
+
+    static constexpr int maxChannels = 16; ///< Channels preallocated per slot
+
+    /**
+     * @brief Allocates every slot for the given block size.
+     * @param maxBlockSize Largest block size expected from the host.
+     */
+    void prepare(int maxBlockSize);
+
+    /**
+     * @brief Borrows a slot's buffer, resized without reallocating.
+     *
+     * The contents are undefined, callers are expected to clear or overwrite them.
+     *
+     * @param slot The stage's slot.
+     * @param numChannels Number of channels needed (at most maxChannels).
+     * @param numSamples Number of samples needed.
+     * @return Reference to the slot's buffer.
+     */
+    juce::AudioBuffer<float>& get(Slot slot, int numChannels, int numSamples);
+
+    /**
+     * @brief Returns the bytes of sample storage prepare() allocated.
+     */
+    size_t getMemoryBytes() const noexcept;
+
+private:
+    std::array<juce::AudioBuffer<float>, static_cast<size_t>(Slot::Count)> buffers; ///< Buffer per slot
+    int capacity = 0;                                                              ///< Prepared samples per slot
+};
@@ -0,0 +1,176 @@
+#include "SignalGraph.h"
+
+namespace
+{
+    const SignalGraph::Program emptyProgram{};  // Rendered until the first program is picked up
+}
+
+SignalGraph::SignalGraph()
+{
+    publishProgram();
+}
+
+SignalGraph::~SignalGraph()
+{
+    freeRetiredPrograms();
+    delete pendingProgram.exchange(nullptr);
+    delete audioProgram;
+}
+
+void SignalGraph::setEnvelope(int oscillator, Envelope* envelope)
+{
+    if (oscillator < 0 || oscillator >= NUM_OF_OSCILLATORS)
+    {
+        jassertfalse;
+        return;
+    }
+
+    auto& node = nodes[static_cast<size_t>(oscillator)];
+    if (node.envelope == envelope)
+        return;
+
+    node.envelope = envelope;
+    publishProgram();
+}
+
+void SignalGraph::connectFilter(int node, Filter* filter)
+{
+    if (node < 0 || node > bus || filter == nullptr)
+    {
+        jassertfalse;
+        return;
+    }
+
+    auto& filters = nodes[static_cast<size_t>(node)].filters;
+    if (std::find(filters.begin(), filters.end(), filter) != filters.end())
+        return;
+
+    // A filter holds the state of one signal, so it leaves the chain it was in
+    for (auto& other : nodes)
+        other.filters.erase(std::remove(other.filters.begin(), other.filters.end(), filter), other.filters.end());
+
+    filters.push_back(filter);
+    jassert(static_cast<int>(filters.size()) <= maxChainFilters);
+    publishProgram();
+}
+
+void SignalGraph::disconnectFilter(int node, Filter* filter)
+{
+    if (node < 0 || node > bus)
+    {
+        jassertfalse;
+        return;
+    }
+
+    auto& filters = nodes[static_cast<size_t>(node)].filters;
+    const auto it = std::find(filters.begin(), filters.end(), filter);
+    if (it == filters.end())
+        return;
+
+    filters.erase(it);
+    publishProgram();
+}
+
+void SignalGraph::clear()
+{
+    for (auto& node : nodes)
+    {
+        node.envelope = nullptr;
+        node.filters.clear();
+    }
+
+    publishProgram();
+}
+
+Envelope* SignalGraph::getEnvelope(int oscillator) const
+{
+    if (oscillator < 0 || oscillator >= NUM_OF_OSCILLATORS)
+        return nullptr;
+
+    return nodes[static_cast<size_t>(oscillator)].envelope;
+}
+
+const std::vector<Filter*>& SignalGraph::getFilters(int node) const
+{
+    jassert(node >= 0 && node <= bus);
+    return nodes[static_cast<size_t>(juce::jlimit(0, bus, node))].filters;
+}
+
+juce::String SignalGraph::getBusName()
+{
+    return "Oscillator Bus";
+}
+
+bool SignalGraph::beginBlock() noexcept
+{
+    // Keep the current program until there is room to hand it back
+    if (retiredFifo.getFreeSpace() == 0)
+        return false;
+
+    auto* next = pendingProgram.exchange(nullptr, std::memory_order_acq_rel);
+    if (next == nullptr)
+        return false;
+
+    if (audioProgram != nullptr)
+    {
+        const auto scope = retiredFifo.write(1);
+        retiredPrograms[scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2] = audioProgram;
+    }
+
+    audioProgram = next;
+    return true;
+}
+
+const SignalGraph::Program& SignalGraph::getProgram() const noexcept
+{
+    return audioProgram != nullptr ? *audioProgram : emptyProgram;
+}
+
+void SignalGraph::publishProgram()
+{
+    auto program = std::make_unique<Program>();
+
+    const auto compileChain = [this](int index, Chain& chain)
+        {
+            const auto& node = nodes[static_cast<size_t>(index)];
+            chain.oscillator = index;
+            chain.envelope = node.envelope;
+            chain.numFilters = juce::jmin(maxChainFilters, static_cast<int>(node.filters.size()));
+            std::copy_n(node.filters.begin(), chain.numFilters, chain.filters.begin());
+        };
+
+    // Oscillators are the only sources and a filter feeds one chain, so oscillator
+    // order followed by link order, and the bus last, is a topological order of the graph
+    compileChain(bus, program->busChain);
+
+    for (int oscillator = 0; oscillator < NUM_OF_OSCILLATORS; ++oscillator)
+    {
+        auto& chain = program->chains[static_cast<size_t>(oscillator)];
+        compileChain(oscillator, chain);
+        chain.feedsBus = chain.numFilters == 0 && program->busChain.numFilters > 0;
+    }
+
+    // A shared envelope is driven by every chain it plays, which must then run on one thread
+    for (int a = 0; a < NUM_OF_OSCILLATORS; ++a)
+    {
+        const auto* envelope = nodes[static_cast<size_t>(a)].envelope;
+        for (int b = a + 1; b < NUM_OF_OSCILLATORS && envelope != nullptr; ++b)
+            if (nodes[static_cast<size_t>(b)].envelope == envelope)
+                program->independentChains = false;
+    }
+
+    freeRetiredPrograms();
+
+    // A program the audio thread never picked up was never read, it can go right away
+    delete pendingProgram.exchange(program.release(), std::memory_order_acq_rel);
+}
+
+void SignalGraph::freeRetiredPrograms()
+{
+    const auto scope = retiredFifo.read(retiredFifo.getNumReady());
+    scope.forEach([this](int index)
+        {
+            delete retiredPrograms[index];
+            retiredPrograms[index] = nullptr;
+        });
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "../../Common.h"
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+class Envelope;
+class Filter;
+
+/**
+ * @class SignalGraph
+ * @brief Explicit routing of the oscillators through their envelopes and filters to the output.
+ *
+ * The message thread edits the graph: each oscillator is played by at most
+ * one envelope and runs through an ordered list of filters before it reaches
+ * its bus. A filter feeds a single chain, so linking it elsewhere moves it.
+ * Every edit compiles the graph into a Program, a flat list of chains in
+ * processing order with the links resolved to pointers and the questions the
+ * audio thread used to ask per block (can the chains render on separate
+ * threads?) answered up front.
+ *
+ * Filters can also be linked to the oscillator bus. Every oscillator without
+ * filters of its own then sums into one buffer that goes through the bus
+ * filters once, so a patch filtering all oscillators the same way pays for a
+ * single filter.
+ *
+ * Programs are published through an atomic pointer and picked up in
+ * beginBlock(), the way ModulationRouter hands over its routing tables, so the
+ * audio thread never reads a link while the UI changes it.
+ */
+class SignalGraph
+{
+public:
+    static constexpr int maxChainFilters = NUM_OF_FILTERS; ///< Filters one chain can run through at most
+    static constexpr int bus = NUM_OF_OSCILLATORS;         ///< Node index of the oscillator bus, after the oscillators
+
+    /**
+     * @struct Chain
+     * @brief Compiled route of one oscillator, in signal order.
+     */
+    struct Chain
+    {
+        int oscillator = 0;                                 ///< Index of the oscillator rendering the chain, or bus
+        Envelope* envelope = nullptr;                       ///< Envelope playing its notes, nullptr if none
+        std::array<Filter*, maxChainFilters> filters{};     ///< Filters the oscillator runs through, in link order
+        int numFilters = 0;                                 ///< Entries in filters
+        bool feedsBus = false;                              ///< True if the oscillator sums into the bus filters
+    };
+
+    /**
+     * @struct Program
+     * @brief Immutable snapshot of the whole graph, read by the audio thread.
+     */
+    struct Program
+    {
+        std::array<Chain, NUM_OF_OSCILLATORS> chains{};     ///< One chain per oscillator, in processing order
+        Chain busChain;                                     ///< Filters of the bus, run after every chain feeding it
+        bool independentChains = true;                      ///< True if no two chains share an envelope, so they may render in parallel
+    };
+
+    /**
+     * @brief Publishes the empty graph.
+     */
+    SignalGraph();
+
+    /**
+     * @brief Frees every program, the audio thread must have stopped.
+     */
+    ~SignalGraph();
+
+    /**
+     * @brief Sets the envelope playing an oscillator's notes. Message thread only.
+     * @param oscillator Oscillator index.
+     * @param envelope Envelope to link, or nullptr to unlink.
+     */
+    void setEnvelope(int oscillator, Envelope* envelope);
+
+    /**
+     * @brief Appends a filter to an oscillator's chain or the bus, taking it out of any other chain. Message thread only.
+     * @param node Oscillator index, or bus.
+     * @param filter The filter.
+     */
+    void connectFilter(int node, Filter* filter);
+
+    /**
+     * @brief Removes a filter from an oscillator's chain or the bus, if it is there. Message thread only.
+     */
+    void disconnectFilter(int node, Filter* filter);
+
+    /**
+     * @brief Unlinks every envelope and filter. Message thread only.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the envelope linked to an oscillator, as last edited. Message thread only.
+     */
+    Envelope* getEnvelope(int oscillator) const;
+
+    /**
+     * @brief Returns the filters linked to an oscillator or the bus, as last edited. Message thread only.
+     */
+    const std::vector<Filter*>& getFilters(int node) const;
+
+    /**
+     * @brief Returns the name filters show for the bus in their link list.
+     */
+    static juce::String getBusName();
+
+    /**
+     * @brief Adopts the latest published program. Audio thread, once per block.
+     * @return True if the program changed and the processor must apply it.
+     */
+    bool beginBlock() noexcept;
+
+    /**
+     * @brief Returns the program the audio thread renders with. Audio thread only.
+     */
+    const Program& getProgram() const noexcept;
+
+private:
+    /**
+     * @struct Node
+     * @brief Links of one oscillator, or of the bus, as edited.
+     */
+    struct Node
+    {
+        Envelope* envelope = nullptr;   ///< Linked envelope
+        std::vector<Filter*> filters;   ///< Linked filters in signal order
+    };
+
+    /**
+     * @brief Compiles the graph into a new program and publishes it to the audio thread.
+     */
+    void publishProgram();
+
+    /**
+     * @brief Frees the programs the audio thread stopped using.
+     */
+    void freeRetiredPrograms();
+
+    std::array<Node, NUM_OF_OSCILLATORS + 1> nodes;     ///< Graph as edited, the bus last, message thread only
+
+    std::atomic<Program*> pendingProgram{ nullptr };    ///< Published program not yet picked up by the audio thread
+    Program* audioProgram = nullptr;                    ///< Program the audio thread renders with
+
+    static constexpr int retiredQueueSize = 8;                  ///< Programs the audio thread can hand back between two edits
+    std::array<Program*, retiredQueueSize> retiredPrograms{};   ///< Programs replaced on the audio thread
+    juce::AbstractFifo retiredFifo{ retiredQueueSize };         ///< SPSC indices into retiredPrograms
+
+    JUCE_DECLARE_NON_COPYABLE(SignalGraph)
+};
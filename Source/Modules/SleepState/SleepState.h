@@ -0,0 +1,88 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class SleepState
+ * @brief Lets a processing stage skip blocks once its input is silent and its tail has decayed.
+ *
+ * A stage asks canSkip() before processing a block and reports the result
+ * through settle() after it. The stage falls asleep once a whole block came in
+ * silent, went out silent and left its own state below the threshold, so a
+ * resonance still ringing or a delay line still holding signal keeps it awake
+ * for as long as the tail lasts. While asleep, canSkip() returns true for
+ * silent input and false on the first block that is not, so the stage wakes
+ * without a block of latency. The stage clears its state on falling asleep,
+ * which lets it restart from silence exactly.
+ */
+class SleepState
+{
+public:
+    static constexpr float threshold = 1.0e-5f; ///< Level below which input, output and state count as silent
+
+    /**
+     * @brief Checks a block before processing it, waking the stage if the block is not silent.
+     * @param input The block the stage is about to process.
+     * @return True if the stage is asleep and the block is silent, so processing may be skipped.
+     */
+    bool canSkip(const juce::dsp::AudioBlock<float>& input) noexcept
+    {
+        inputSilent = getPeak(input) < threshold;
+        if (!inputSilent)
+            asleep = false;
+
+        return asleep;
+    }
+
+    /**
+     * @brief Checks a processed block, putting the stage to sleep if its tail has decayed.
+     * @param output The block as the stage left it.
+     * @param stateMagnitude Largest magnitude the stage's internal state holds.
+     * @return True if the stage just fell asleep; the caller then clears its state.
+     */
+    bool settle(const juce::dsp::AudioBlock<float>& output, float stateMagnitude) noexcept
+    {
+        if (asleep || !inputSilent || stateMagnitude >= threshold || getPeak(output) >= threshold)
+            return false;
+
+        asleep = true;
+        return true;
+    }
+
+    /**
+     * @brief Marks the stage asleep after its state was cleared from outside.
+     */
+    void setAsleep() noexcept
+    {
+        asleep = true;
+    }
+
+    /**
+     * @brief Returns true while the stage skips silent blocks.
+     */
+    bool isAsleep() const noexcept
+    {
+        return asleep;
+    }
+
+    /**
+     * @brief Returns the largest absolute sample of a block.
+     */
+    static float getPeak(const juce::dsp::AudioBlock<float>& block) noexcept
+    {
+        const int numSamples = static_cast<int>(block.getNumSamples());
+        float peak = 0.0f;
+
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer(ch), numSamples);
+            peak = juce::jmax(peak, -range.getStart(), range.getEnd());
+        }
+
+        return peak;
+    }
+
+private:
+    bool asleep = true;       ///< True while the stage's state is cleared and silent blocks are skipped
+    bool inputSilent = false; ///< True if the block last checked by canSkip() was silent
+};
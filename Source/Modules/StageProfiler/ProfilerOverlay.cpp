@@ -0,0 +1,89 @@
+#include "ProfilerOverlay.h"
+
+#if STAGE_PROFILING
+
+ProfilerOverlay::ProfilerOverlay(const StageProfiler& profilerIn)
+    : profiler(profilerIn)
+{
+    setInterceptsMouseClicks(false, false);
+    refreshScheduler->add(this);
+}
+
+ProfilerOverlay::~ProfilerOverlay()
+{
+    refreshScheduler->remove(this);
+}
+
+int ProfilerOverlay::getPreferredHeight() const
+{
+    // Header, column titles and one row per stage
+    return rowHeight * (static_cast<int>(summaries.size()) + 2) + 8;
+}
+
+void ProfilerOverlay::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.withAlpha(0.75f));
+    g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 11.0f, juce::Font::plain));
+
+    const double budget = profiler.getBlockBudgetMicroseconds();
+    auto area = getLocalBounds().reduced(6, 4);
+
+    const auto drawRow = [&g, &area](const juce::String& name, const juce::String& mean,
+                                     const juce::String& peak, const juce::String& load)
+        {
+            auto row = area.removeFromTop(rowHeight);
+            g.drawText(name, row.removeFromLeft(112), juce::Justification::centredLeft);
+            g.drawText(mean, row.removeFromLeft(56), juce::Justification::centredRight);
+            g.drawText(peak, row.removeFromLeft(56), juce::Justification::centredRight);
+            g.drawText(load, row, juce::Justification::centredRight);
+        };
+
+    g.setColour(juce::Colours::white);
+    g.drawText("Budget " + juce::String(budget, 0) + " us, dropped " + juce::String(profiler.getNumDroppedEvents()),
+               area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+
+    g.setColour(juce::Colours::grey);
+    drawRow("Stage", "mean us", "peak us", "load");
+
+    for (const auto& summary : summaries)
+    {
+        // Peaks past the budget are the overruns
+        g.setColour(budget > 0.0 && summary.peak > budget ? juce::Colours::orangered : juce::Colours::white);
+        drawRow(StageProfiler::getStageName(summary.stage, summary.index),
+                juce::String(summary.mean, 1),
+                juce::String(summary.peak, 1),
+                budget > 0.0 ? juce::String(summary.mean / budget * 100.0, 1) + "%" : juce::String("-"));
+    }
+}
+
+void ProfilerOverlay::visibilityChanged()
+{
+    if (isVisible())
+        refreshScheduler->add(this);
+    else
+        refreshScheduler->remove(this);
+}
+
+void ProfilerOverlay::refresh()
+{
+    auto latest = profiler.getSummaries();
+
+    const bool changed = latest.size() != summaries.size()
+        || !std::equal(latest.begin(), latest.end(), summaries.begin(), [](const auto& a, const auto& b)
+            {
+                return a.stage == b.stage && a.index == b.index && a.mean == b.mean && a.peak == b.peak;
+            });
+
+    if (!changed)
+        return;
+
+    const bool resized = latest.size() != summaries.size();
+    summaries = std::move(latest);
+
+    if (resized)
+        setSize(width, getPreferredHeight());
+
+    repaint();
+}
+
+#endif
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "StageProfiler.h"
+#include "../RefreshScheduler/RefreshScheduler.h"
+#include <JuceHeader.h>
+
+#if STAGE_PROFILING
+
+/**
+ * @class ProfilerOverlay
+ * @brief Translucent table of the time each stage took per block, over the last second.
+ *
+ * Lists the mean and peak time of every stage the profiler saw, and the mean as
+ * a share of the block budget, so an overrun can be traced to a stage on the
+ * machine that shows it. Ignores the mouse, so the controls beneath stay usable.
+ */
+class ProfilerOverlay : public juce::Component, private RefreshScheduler::Client
+{
+public:
+    static constexpr int width = 280;      ///< Width in pixels
+    static constexpr int rowHeight = 14;   ///< Height of one row in pixels
+
+    /**
+     * @brief Constructs the overlay for a profiler.
+     * @param profiler Profiler to read, must outlive the overlay.
+     */
+    explicit ProfilerOverlay(const StageProfiler& profiler);
+
+    /**
+     * @brief Leaves the refresh scheduler.
+     */
+    ~ProfilerOverlay() override;
+
+    /**
+     * @brief Returns the height needed to show every row.
+     */
+    int getPreferredHeight() const;
+
+    /**
+     * @brief Draws the table.
+     */
+    void paint(juce::Graphics& g) override;
+
+    /**
+     * @brief Starts or stops refreshing along with visibility.
+     */
+    void visibilityChanged() override;
+
+private:
+    /**
+     * @brief Fetches the latest summaries and repaints if they changed.
+     */
+    void refresh() override;
+
+    const StageProfiler& profiler;                        ///< Profiler read on every frame
+    std::vector<StageProfiler::Summary> summaries;        ///< Rows currently shown
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler; ///< Shared UI refresh tick
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProfilerOverlay)
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include "StageProfiler.h"
+
+#if STAGE_PROFILING
+
+StageProfiler::ScopedStage::ScopedStage(StageProfiler* profilerIn, Stage stageIn, int indexIn) noexcept
+    : profiler(profilerIn), stage(stageIn), index(indexIn),
+      start(profilerIn != nullptr ? juce::Time::getHighResolutionTicks() : 0)
+{
+}
+
+StageProfiler::ScopedStage::~ScopedStage()
+{
+    if (profiler != nullptr)
+        profiler->record(stage, index, start, juce::Time::getHighResolutionTicks());
+}
+
+StageProfiler::StageProfiler()
+    : history(historySize)
+{
+    startTimer(drainIntervalMs);
+}
+
+StageProfiler::~StageProfiler()
+{
+    stopTimer();
+}
+
+void StageProfiler::record(Stage stage, int index, juce::int64 start, juce::int64 end) noexcept
+{
+    Event event;
+    event.start = start;
+    event.end = end;
+    event.thread = reinterpret_cast<std::uintptr_t>(juce::Thread::getCurrentThreadId());
+    event.stage = stage;
+    event.index = static_cast<juce::uint8>(juce::jlimit(0, maxIndices - 1, index));
+
+    if (!queue.push(event))
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StageProfiler::setBlockBudget(double seconds) noexcept
+{
+    blockBudget.store(seconds);
+}
+
+double StageProfiler::getBlockBudgetMicroseconds() const noexcept
+{
+    return blockBudget.load() * 1.0e6;
+}
+
+std::vector<StageProfiler::Summary> StageProfiler::getSummaries() const
+{
+    return summaries;
+}
+
+int StageProfiler::getNumDroppedEvents() const noexcept
+{
+    return droppedEvents.load(std::memory_order_relaxed);
+}
+
+void StageProfiler::timerCallback()
+{
+    Event event;
+    while (queue.pop(event))
+    {
+        history[historyWrite] = event;
+        historyWrite = (historyWrite + 1) % historySize;
+        historyFull = historyFull || historyWrite == 0;
+
+        accumulate(event);
+    }
+}
+
+void StageProfiler::accumulate(const Event& event)
+{
+    const int slot = static_cast<int>(event.stage) * maxIndices + event.index;
+    blockTotals[static_cast<size_t>(slot)] += juce::Time::highResolutionTicksToSeconds(event.end - event.start);
+
+    // Inner stages are recorded before the block that contains them ends
+    if (event.stage != Stage::Block)
+        return;
+
+    for (size_t i = 0; i < blockTotals.size(); ++i)
+    {
+        if (blockTotals[i] <= 0.0)
+            continue;
+
+        windowTotals[i] += blockTotals[i];
+        windowPeaks[i] = juce::jmax(windowPeaks[i], blockTotals[i]);
+        windowSeen[i] = true;
+        blockTotals[i] = 0.0;
+    }
+
+    ++windowBlocks;
+
+    if (windowStart == 0)
+        windowStart = event.end;
+
+    if (juce::Time::highResolutionTicksToSeconds(event.end - windowStart) < 1.0)
+        return;
+
+    summaries.clear();
+    for (int i = 0; i < numSlots; ++i)
+    {
+        if (!windowSeen[static_cast<size_t>(i)])
+            continue;
+
+        Summary summary;
+        summary.stage = static_cast<Stage>(i / maxIndices);
+        summary.index = i % maxIndices;
+        summary.mean = windowTotals[static_cast<size_t>(i)] / windowBlocks * 1.0e6;
+        summary.peak = windowPeaks[static_cast<size_t>(i)] * 1.0e6;
+        summaries.push_back(summary);
+    }
+
+    windowTotals.fill(0.0);
+    windowPeaks.fill(0.0);
+    windowSeen.fill(false);
+    windowBlocks = 0;
+    windowStart = event.end;
+}
+
+bool StageProfiler::writeChromeTrace(const juce::File& file) const
+{
+    const size_t count = historyFull ? historySize : historyWrite;
+    const size_t first = historyFull ? historyWrite : 0;
+
+    // Small thread numbers in order of appearance, traces read better than raw handles
+    std::map<std::uintptr_t, int> threadNumbers;
+    juce::int64 origin = std::numeric_limits<juce::int64>::max();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& event = history[(first + i) % historySize];
+        threadNumbers.emplace(event.thread, static_cast<int>(threadNumbers.size()) + 1);
+        origin = juce::jmin(origin, event.start);
+    }
+
+    const auto toMicroseconds = [](juce::int64 ticks)
+        {
+            return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+        };
+
+    juce::MemoryOutputStream out;
+    out << "{\"traceEvents\":[";
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& event = history[(first + i) % historySize];
+
+        out << (i > 0 ? ",\n" : "\n")
+            << "{\"name\":\"" << getStageName(event.stage, event.index) << "\",\"ph\":\"X\",\"pid\":1"
+            << ",\"tid\":" << threadNumbers[event.thread]
+            << ",\"ts\":" << juce::String(toMicroseconds(event.start - origin), 3)
+            << ",\"dur\":" << juce::String(toMicroseconds(event.end - event.start), 3) << "}";
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return file.replaceWithData(out.getData(), out.getDataSize());
+}
+
+juce::String StageProfiler::getStageName(Stage stage, int index)
+{
+    switch (stage)
+    {
+    case Stage::Block:            return "Block";
+    case Stage::UpdateParameters: return "Parameters";
+    case Stage::Lfos:             return "LFOs";
+    case Stage::Envelopes:        return "Envelopes";
+    case Stage::Segment:          return "Segments";
+    case Stage::Oscillator:       return "Osc " + juce::String(index + 1);
+    case Stage::Filter:           return index >= NUM_OF_OSCILLATORS ? juce::String("Bus Filter")
+                                                                     : "Osc " + juce::String(index + 1) + " Filter";
+    case Stage::Effects:          return "Effects";
+    case Stage::FinalizeNotes:    return "Finalize Notes";
+    case Stage::Count:            break;
+    }
+
+    return {};
+}
+
+#endif
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "../../Common.h"
+#include "../CommandQueue/CommandQueue.h"
+#include <JuceHeader.h>
+
+/**
+ * @file StageProfiler.h
+ * @brief Optional timing of the audio callback's stages, compiled out unless STAGE_PROFILING is 1.
+ *
+ * Stages are marked with PROFILE_STAGE, which expands to nothing in regular
+ * builds, so the instrumentation costs nothing unless a profiling build variant
+ * (see the exporter configurations in the .jucer) turns it on.
+ */
+
+#if STAGE_PROFILING
+
+/**
+ * @class StageProfiler
+ * @brief Collects timestamps of the processor's stages and summarizes them for the editor.
+ *
+ * Any thread may record, including the render workers; records go into a
+ * lock-free queue and never block or allocate. On the message thread the
+ * profiler drains the queue into a history of recent events, kept for Chrome
+ * trace dumps (chrome://tracing or ui.perfetto.dev), and into per-stage
+ * statistics over the last second, shown by the ProfilerOverlay.
+ */
+class StageProfiler : private juce::Timer
+{
+public:
+    /**
+     * @enum Stage
+     * @brief Timed stages of a block.
+     */
+    enum class Stage : juce::uint8
+    {
+        Block,            ///< The whole processBlock call
+        UpdateParameters, ///< Refresh of every module's parameters
+        Lfos,             ///< LFO rendering and retriggers
+        Envelopes,        ///< Envelope modulation spans and end-of-block rendering
+        Segment,          ///< One renderAudioSegment call
+        Oscillator,       ///< One oscillator's chain, filter included
+        Filter,           ///< One filter pass, indexed by the oscillator that runs it, NUM_OF_OSCILLATORS for the bus
+        Effects,          ///< The effects chain over the main mix
+        FinalizeNotes,    ///< Removal of finished notes
+        Count
+    };
+
+    static constexpr int maxIndices = NUM_OF_OSCILLATORS + 1; ///< Distinct module indices tracked per stage, the filter bus last
+
+    /**
+     * @struct Event
+     * @brief One timed stage.
+     */
+    struct Event
+    {
+        juce::int64 start = 0;         ///< High resolution ticks at entry
+        juce::int64 end = 0;           ///< High resolution ticks at exit
+        std::uintptr_t thread = 0;     ///< Thread the stage ran on
+        Stage stage = Stage::Block;    ///< Timed stage
+        juce::uint8 index = 0;         ///< Module index, for per-module stages
+    };
+
+    /**
+     * @struct Summary
+     * @brief Time one stage took per block, over the last second. Times are in microseconds.
+     */
+    struct Summary
+    {
+        Stage stage = Stage::Block;    ///< Summarized stage
+        int index = 0;                 ///< Module index, for per-module stages
+        double mean = 0.0;             ///< Mean time per block
+        double peak = 0.0;             ///< Slowest block
+    };
+
+    /**
+     * @class ScopedStage
+     * @brief Times the scope it lives in. Use through PROFILE_STAGE.
+     */
+    class ScopedStage
+    {
+    public:
+        /**
+         * @brief Starts timing.
+         * @param profiler Profiler to record into, nothing is recorded if nullptr.
+         * @param stage Stage the scope belongs to.
+         * @param index Module index, for per-module stages.
+         */
+        ScopedStage(StageProfiler* profiler, Stage stage, int index = 0) noexcept;
+
+        /**
+         * @brief Records the stage.
+         */
+        ~ScopedStage();
+
+    private:
+        StageProfiler* profiler;       ///< Profiler to record into
+        Stage stage;                   ///< Timed stage
+        int index;                     ///< Module index
+        juce::int64 start;             ///< Ticks at entry
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    /**
+     * @brief Starts draining recorded events.
+     */
+    StageProfiler();
+
+    /**
+     * @brief Stops draining.
+     */
+    ~StageProfiler() override;
+
+    /**
+     * @brief Records a stage. Safe to call from any thread, never blocks.
+     */
+    void record(Stage stage, int index, juce::int64 start, juce::int64 end) noexcept;
+
+    /**
+     * @brief Sets the time one block may take, shown as the overlay's reference.
+     * @param seconds Block duration, samplesPerBlock / sampleRate.
+     */
+    void setBlockBudget(double seconds) noexcept;
+
+    /**
+     * @brief Returns the time one block may take, in microseconds.
+     */
+    double getBlockBudgetMicroseconds() const noexcept;
+
+    /**
+     * @brief Returns the stages seen during the last complete second, in stage order.
+     */
+    std::vector<Summary> getSummaries() const;
+
+    /**
+     * @brief Returns how many events were dropped because the queue was full.
+     */
+    int getNumDroppedEvents() const noexcept;
+
+    /**
+     * @brief Writes the event history as a Chrome trace.
+     * @param file Destination, usually with a .json extension.
+     * @return False if the file could not be written.
+     */
+    bool writeChromeTrace(const juce::File& file) const;
+
+    /**
+     * @brief Returns the display name of a stage.
+     * @param stage The stage.
+     * @param index Oscillator index, numbered from 1 in the name of per-oscillator stages.
+     */
+    static juce::String getStageName(Stage stage, int index);
+
+private:
+    /**
+     * @brief Moves queued events into the history and the statistics. Message thread.
+     */
+    void timerCallback() override;
+
+    /**
+     * @brief Adds one event to the current block's totals, closing the block on a Block event.
+     */
+    void accumulate(const Event& event);
+
+    static constexpr int queueCapacity = 1 << 15;     ///< Events that may wait between drains
+    static constexpr size_t historySize = 1 << 16;    ///< Events kept for trace dumps
+    static constexpr int numSlots = static_cast<int>(Stage::Count) * maxIndices; ///< Stage and index pairs
+    static constexpr int drainIntervalMs = 20;        ///< How often the queue is drained
+
+    CommandQueue<Event, queueCapacity> queue;         ///< Events on their way to the message thread
+    std::atomic<int> droppedEvents{ 0 };              ///< Events lost to a full queue
+    std::atomic<double> blockBudget{ 0.0 };           ///< Block duration in seconds
+
+    // Message thread only
+    std::vector<Event> history;                       ///< Ring of the latest events
+    size_t historyWrite = 0;                          ///< Next history slot
+    bool historyFull = false;                         ///< True once the ring wrapped
+
+    std::array<double, numSlots> blockTotals{};       ///< Seconds per slot in the open block
+    std::array<double, numSlots> windowTotals{};      ///< Seconds per slot in the open window
+    std::array<double, numSlots> windowPeaks{};       ///< Slowest block per slot in the open window
+    std::array<bool, numSlots> windowSeen{};          ///< True for slots seen in the open window
+    int windowBlocks = 0;                             ///< Blocks in the open window
+    juce::int64 windowStart = 0;                      ///< Ticks the open window started at
+    std::vector<Summary> summaries;                   ///< Statistics of the last closed window
+
+    JUCE_DECLARE_NON_COPYABLE(StageProfiler)
+};
+
+ #define PROFILE_STAGE(profiler, ...) \
+    const StageProfiler::ScopedStage JUCE_JOIN_MACRO(profiledStage_, __LINE__)(profiler, __VA_ARGS__)
+
+#else
+
+ #define PROFILE_STAGE(profiler, ...)
+
+#endif
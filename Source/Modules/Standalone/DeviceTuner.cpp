@@ -0,0 +1,151 @@
+#include "DeviceTuner.h"
+
+DeviceTuner::DeviceTuner(juce::AudioDeviceManager& deviceManagerIn, LowLatencyPlayer& playerIn)
+    : deviceManager(deviceManagerIn), player(playerIn)
+{
+}
+
+DeviceTuner::~DeviceTuner()
+{
+    stopTimer();
+}
+
+juce::StringArray DeviceTuner::getPreferredDeviceTypes()
+{
+    return { "ASIO", "JACK", "Windows Audio (Exclusive Mode)", "Windows Audio (Low Latency Mode)", "CoreAudio", "ALSA" };
+}
+
+bool DeviceTuner::selectPreferredDeviceType()
+{
+    const auto& types = deviceManager.getAvailableDeviceTypes();
+
+    for (const auto& name : getPreferredDeviceTypes())
+    {
+        for (auto* type : types)
+        {
+            if (type->getTypeName() != name)
+                continue;
+
+            type->scanForDevices();
+            if (type->getDeviceNames(false).isEmpty())
+                break;
+
+            deviceManager.setCurrentAudioDeviceType(name, true);
+            if (deviceManager.getCurrentAudioDevice() != nullptr)
+                return true;
+
+            break;
+        }
+    }
+
+    return false;
+}
+
+void DeviceTuner::findSmallestStableBufferSize()
+{
+    stopTimer();
+
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr)
+    {
+        finish(State::Failed);
+        return;
+    }
+
+    candidateSizes.clearQuick();
+    for (const int size : device->getAvailableBufferSizes())
+        if (size >= minimumBufferSize)
+            candidateSizes.addIfNotAlreadyThere(size);
+    candidateSizes.sort();
+
+    if (candidateSizes.isEmpty())
+    {
+        bufferSize = device->getCurrentBufferSizeSamples();
+        finish(State::Failed);
+        return;
+    }
+
+    state = State::Probing;
+    tryCandidate(0);
+}
+
+DeviceTuner::State DeviceTuner::getState() const noexcept
+{
+    return state;
+}
+
+int DeviceTuner::getBufferSize() const noexcept
+{
+    return bufferSize;
+}
+
+void DeviceTuner::tryCandidate(int index)
+{
+    candidateIndex = index;
+    bufferSize = candidateSizes[index];
+
+    auto setup = deviceManager.getAudioDeviceSetup();
+    setup.bufferSize = bufferSize;
+    deviceManager.setAudioDeviceSetup(setup, true);
+
+    settling = true;
+    startTimer(settleMilliseconds);
+}
+
+void DeviceTuner::timerCallback()
+{
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr)
+    {
+        finish(State::Failed);
+        return;
+    }
+
+    // Restarting a driver often glitches once, judging starts after that
+    if (settling)
+    {
+        settling = false;
+        bufferSize = device->getCurrentBufferSizeSamples(); // Drivers round to sizes they support
+        player.resetCounters();
+        xrunsAtStart = device->getXRunCount();
+        startTimer(probeMilliseconds);
+        return;
+    }
+
+    if (isCurrentSizeStable())
+    {
+        finish(State::Found);
+        return;
+    }
+
+    if (candidateIndex + 1 < candidateSizes.size())
+        tryCandidate(candidateIndex + 1);
+    else
+        finish(State::Failed);
+}
+
+bool DeviceTuner::isCurrentSizeStable() const
+{
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr)
+        return false;
+
+    const int xruns = device->getXRunCount();
+    const bool driverClean = xrunsAtStart < 0 || xruns < 0 || xruns == xrunsAtStart;
+
+    const auto& load = player.getLoadMeter();
+    return driverClean
+        && player.getNumLateCallbacks() == 0
+        && load.getNumOverruns() == 0
+        && load.getPeakLoad() < maxProbeLoad;
+}
+
+void DeviceTuner::finish(State newState)
+{
+    stopTimer();
+    settling = false;
+    state = newState;
+
+    if (onFinished)
+        onFinished();
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "LowLatencyPlayer.h"
+#include <JuceHeader.h>
+
+/**
+ * @class DeviceTuner
+ * @brief Picks the lowest-latency audio device type and probes for the smallest stable buffer size.
+ *
+ * Device types are tried in order of the latency they reach: ASIO, JACK,
+ * WASAPI in exclusive mode, WASAPI in low-latency mode, CoreAudio and ALSA,
+ * whichever this build and machine offer. ASIO needs the Steinberg SDK and
+ * JUCE_ASIO enabled, JACK needs JUCE_JACK.
+ *
+ * The buffer probe runs each size the device offers, smallest first, for
+ * probeMilliseconds after it settled. A size is stable if the driver reports
+ * no xrun, no callback came late, none overran its deadline and the peak load
+ * stayed under maxProbeLoad, which leaves room for playing since the probe
+ * runs with no notes held. The first stable size is kept; if none is, the
+ * largest is. Everything runs on the message thread.
+ */
+class DeviceTuner : private juce::Timer
+{
+public:
+    /**
+     * @enum State
+     * @brief Progress of the buffer probe.
+     */
+    enum class State
+    {
+        Idle,     ///< No probe ran yet
+        Probing,  ///< A size is being tried
+        Found,    ///< The probe settled on a stable size
+        Failed    ///< No size was stable, the largest is used
+    };
+
+    static constexpr int minimumBufferSize = 16;     ///< Smallest size tried, below which drivers rarely keep up
+    static constexpr int settleMilliseconds = 500;   ///< Time given to a restarted device before it is judged
+    static constexpr int probeMilliseconds = 3000;   ///< Time a size must run cleanly
+    static constexpr float maxProbeLoad = 0.5f;      ///< Peak callback load a stable size stays under
+
+    /**
+     * @brief Constructs an idle tuner.
+     * @param deviceManager The app's device manager; must outlive the tuner.
+     * @param player The callback running on it, whose counters judge a size; must outlive the tuner.
+     */
+    DeviceTuner(juce::AudioDeviceManager& deviceManager, LowLatencyPlayer& player);
+
+    /**
+     * @brief Stops a running probe.
+     */
+    ~DeviceTuner() override;
+
+    /**
+     * @brief Returns the device type names tried by selectPreferredDeviceType(), best first.
+     */
+    static juce::StringArray getPreferredDeviceTypes();
+
+    /**
+     * @brief Opens the default device of the best available device type.
+     * @return True if a device of one of the preferred types opened.
+     */
+    bool selectPreferredDeviceType();
+
+    /**
+     * @brief Starts probing the current device's buffer sizes, smallest first.
+     */
+    void findSmallestStableBufferSize();
+
+    /**
+     * @brief Returns the progress of the buffer probe.
+     */
+    State getState() const noexcept;
+
+    /**
+     * @brief Returns the size being tried, or the one the last probe kept.
+     */
+    int getBufferSize() const noexcept;
+
+    std::function<void()> onFinished; ///< Called once a probe kept a size, found stable or not
+
+private:
+    /** @brief Judges the running size once it settled and ran for probeMilliseconds. */
+    void timerCallback() override;
+
+    /**
+     * @brief Switches the device to a candidate size and waits for it to settle.
+     * @param index Index into candidateSizes.
+     */
+    void tryCandidate(int index);
+
+    /**
+     * @brief Returns true if the running size produced no glitch since the counters were reset.
+     */
+    bool isCurrentSizeStable() const;
+
+    /**
+     * @brief Ends the probe on a size.
+     * @param newState Found or Failed.
+     */
+    void finish(State newState);
+
+    juce::AudioDeviceManager& deviceManager;   ///< Device manager being tuned
+    LowLatencyPlayer& player;                  ///< Callback whose counters judge a size
+    juce::Array<int> candidateSizes;           ///< Sizes the device offers, ascending
+    int candidateIndex = 0;                    ///< Index of the size being tried
+    int xrunsAtStart = 0;                      ///< Driver xrun count when judging started, -1 if unsupported
+    bool settling = false;                     ///< True until the restarted device settled
+    State state = State::Idle;                 ///< Probe progress
+    int bufferSize = 0;                        ///< Size being tried or kept
+
+    JUCE_DECLARE_NON_COPYABLE(DeviceTuner)
+};
@@ -0,0 +1,144 @@
+#include "LatencyPanel.h"
+
+namespace
+{
+    constexpr int buttonWidth = 78; // Width of each button
+    constexpr int margin = 4;       // Gap around and between the buttons
+
+    juce::String toMilliseconds(int samples, double sampleRate)
+    {
+        return juce::String(1000.0 * samples / sampleRate, 1) + " ms";
+    }
+}
+
+LatencyPanel::LatencyPanel(juce::AudioDeviceManager& deviceManagerIn, LowLatencyPlayer& playerIn, DeviceTuner& tunerIn)
+    : deviceManager(deviceManagerIn), player(playerIn), tuner(tunerIn)
+{
+    settingsButton.onClick = [this]
+        {
+            if (onShowSettings)
+                onShowSettings();
+        };
+
+    tuneButton.onClick = [this]
+        {
+            notice.clear();
+            tuner.findSmallestStableBufferSize();
+            refresh();
+        };
+
+    measureButton.onClick = [this] { measureRoundTrip(); };
+
+    addAndMakeVisible(settingsButton);
+    addAndMakeVisible(tuneButton);
+    addAndMakeVisible(measureButton);
+
+    refreshScheduler->add(this);
+}
+
+LatencyPanel::~LatencyPanel()
+{
+    refreshScheduler->remove(this);
+}
+
+void LatencyPanel::paint(juce::Graphics& g)
+{
+    g.fillAll(UI::Colors::VolumeMeterBackground);
+    g.setColour(UI::Colors::VolumeMeterText);
+    g.setFont(12.0f);
+
+    auto text = getLocalBounds().reduced(8, 0);
+    text.removeFromRight(3 * (buttonWidth + margin));
+    g.drawFittedText(statusText, text, juce::Justification::centredLeft, 1);
+}
+
+void LatencyPanel::resized()
+{
+    auto bounds = getLocalBounds().reduced(margin);
+
+    measureButton.setBounds(bounds.removeFromRight(buttonWidth));
+    bounds.removeFromRight(margin);
+    tuneButton.setBounds(bounds.removeFromRight(buttonWidth));
+    bounds.removeFromRight(margin);
+    settingsButton.setBounds(bounds.removeFromRight(buttonWidth));
+}
+
+void LatencyPanel::refresh()
+{
+    const bool probing = tuner.getState() == DeviceTuner::State::Probing;
+    tuneButton.setEnabled(!probing);
+    measureButton.setEnabled(!probing && !player.isMeasuring());
+
+    const auto latest = makeStatusText();
+    if (latest == statusText)
+        return;
+
+    statusText = latest;
+    repaint();
+}
+
+juce::String LatencyPanel::makeStatusText() const
+{
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr)
+        return "No audio device";
+
+    const double sampleRate = device->getCurrentSampleRate();
+    const int bufferSize = device->getCurrentBufferSizeSamples();
+
+    juce::StringArray parts;
+    parts.add(device->getTypeName() + ", " + juce::String(juce::roundToInt(sampleRate)) + " Hz, "
+        + juce::String(bufferSize) + " smp");
+
+    if (tuner.getState() == DeviceTuner::State::Probing)
+    {
+        parts.add("Tuning " + juce::String(tuner.getBufferSize()) + " smp...");
+        return parts.joinIntoString("  |  ");
+    }
+
+    // The driver's figures include its own buffers, the loopback measurement everything in between
+    const int reported = device->getInputLatencyInSamples() + device->getOutputLatencyInSamples();
+    juce::String roundTrip = "Round trip " + toMilliseconds(reported, sampleRate);
+
+    if (notice.isNotEmpty())
+        roundTrip << ", " << notice;
+    else if (player.isMeasuring())
+        roundTrip << ", measuring...";
+    else if (player.getMeasuredRoundTripSamples() >= 0)
+        roundTrip << ", measured " << toMilliseconds(player.getMeasuredRoundTripSamples(), sampleRate);
+    parts.add(roundTrip);
+
+    parts.add("MIDI +" + toMilliseconds(player.getMidiLatencySamples() + device->getOutputLatencyInSamples(), sampleRate));
+
+    switch (player.getRealtimeStatus())
+    {
+    case LowLatencyPlayer::RealtimeStatus::Realtime:    parts.add("RT priority"); break;
+    case LowLatencyPlayer::RealtimeStatus::NotRealtime: parts.add("No RT priority"); break;
+    case LowLatencyPlayer::RealtimeStatus::Unknown:     break;
+    }
+
+    const auto& load = player.getLoadMeter();
+    const int xruns = juce::jmax(0, device->getXRunCount());
+    parts.add("Load " + juce::String(juce::roundToInt(load.getLoad() * 100.0f)) + "%, glitches "
+        + juce::String(xruns + player.getNumLateCallbacks() + load.getNumOverruns()));
+
+    return parts.joinIntoString("  |  ");
+}
+
+void LatencyPanel::measureRoundTrip()
+{
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr)
+        return;
+
+    if (device->getActiveInputChannels().isZero())
+    {
+        notice = "enable an input wired to an output to measure";
+        refresh();
+        return;
+    }
+
+    notice.clear();
+    player.startRoundTripMeasurement();
+    refresh();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../../Common.h"
+#include "../RefreshScheduler/RefreshScheduler.h"
+#include "DeviceTuner.h"
+#include "LowLatencyPlayer.h"
+#include <JuceHeader.h>
+
+/**
+ * @class LatencyPanel
+ * @brief Strip under the standalone editor reporting the device, its latency and the audio thread's health.
+ *
+ * Shows the device type and buffer, the round trip the driver reports and
+ * the last loopback measurement, the delay MIDI input gets, whether the audio
+ * thread runs with real-time priority, and the callback load and glitches.
+ * Buttons open the device settings, run the buffer probe and start a loopback
+ * measurement.
+ */
+class LatencyPanel : public juce::Component, private RefreshScheduler::Client
+{
+public:
+    static constexpr int height = 26; ///< Preferred height in pixels.
+
+    /**
+     * @brief Constructs the panel.
+     * @param deviceManager The app's device manager.
+     * @param player The callback running on it.
+     * @param tuner The device tuner of the same device manager.
+     */
+    LatencyPanel(juce::AudioDeviceManager& deviceManager, LowLatencyPlayer& player, DeviceTuner& tuner);
+
+    /**
+     * @brief Leaves the refresh scheduler.
+     */
+    ~LatencyPanel() override;
+
+    /**
+     * @brief Draws the background and the status line.
+     * @param g JUCE graphics context
+     */
+    void paint(juce::Graphics& g) override;
+
+    /**
+     * @brief Places the buttons at the right edge.
+     */
+    void resized() override;
+
+    std::function<void()> onShowSettings; ///< Called when the device settings button is clicked
+
+private:
+    /**
+     * @brief Shared refresh tick, repaints when the status line changed.
+     */
+    void refresh() override;
+
+    /**
+     * @brief Builds the status line from the current readings.
+     */
+    juce::String makeStatusText() const;
+
+    /**
+     * @brief Starts a loopback measurement if the device has an input to listen on.
+     */
+    void measureRoundTrip();
+
+    juce::AudioDeviceManager& deviceManager;   ///< The app's device manager
+    LowLatencyPlayer& player;                  ///< The callback running on it
+    DeviceTuner& tuner;                        ///< Buffer probe of the same device
+
+    juce::TextButton settingsButton{ "Audio/MIDI" }; ///< Opens the device settings
+    juce::TextButton tuneButton{ "Tune" };           ///< Runs the buffer probe
+    juce::TextButton measureButton{ "Measure" };     ///< Starts a loopback measurement
+
+    juce::String statusText;                   ///< Status line at the last tick
+    juce::String notice;                       ///< One-off message shown instead of the measurement
+
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler; ///< Shared UI refresh tick.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatencyPanel)
+};
@@ -0,0 +1,280 @@
+#include "LowLatencyPlayer.h"
+
+#if JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <mach/mach.h>
+ #include <pthread.h>
+#else
+ #include <pthread.h>
+ #include <sched.h>
+#endif
+
+namespace
+{
+    // Whether the calling thread is scheduled ahead of ordinary threads
+    bool isCurrentThreadRealtime() noexcept
+    {
+#if JUCE_WINDOWS
+        // ASIO drivers and MMCSS "Pro Audio" threads report at least this priority
+        return GetThreadPriority(GetCurrentThread()) >= THREAD_PRIORITY_HIGHEST;
+#elif JUCE_MAC || JUCE_IOS
+        thread_time_constraint_policy_data_t policy{};
+        mach_msg_type_number_t count = THREAD_TIME_CONSTRAINT_POLICY_COUNT;
+        boolean_t isDefault = FALSE;
+        const auto result = thread_policy_get(pthread_mach_thread_np(pthread_self()), THREAD_TIME_CONSTRAINT_POLICY,
+            reinterpret_cast<thread_policy_t>(&policy), &count, &isDefault);
+        return result == KERN_SUCCESS && !isDefault;
+#else
+        int policy = 0;
+        sched_param param{};
+        return pthread_getschedparam(pthread_self(), &policy, &param) == 0
+            && (policy == SCHED_FIFO || policy == SCHED_RR);
+#endif
+    }
+
+    constexpr int bytesPerMidiEvent = 16; // MidiBuffer header and data of a short message, rounded up
+    constexpr float clickLevel = 0.5f;    // Level of the loopback click
+}
+
+LowLatencyPlayer::LowLatencyPlayer(juce::AudioProcessor& processorIn)
+    : processor(processorIn)
+{
+}
+
+LowLatencyPlayer::RealtimeStatus LowLatencyPlayer::getRealtimeStatus() const noexcept
+{
+    return realtimeStatus.load(std::memory_order_relaxed);
+}
+
+const DspLoadMeter& LowLatencyPlayer::getLoadMeter() const noexcept
+{
+    return loadMeter;
+}
+
+int LowLatencyPlayer::getNumLateCallbacks() const noexcept
+{
+    return lateCallbacks.load(std::memory_order_relaxed);
+}
+
+void LowLatencyPlayer::resetCounters() noexcept
+{
+    lateCallbacks.store(0, std::memory_order_relaxed);
+    loadMeter.resetPeaks();
+}
+
+int LowLatencyPlayer::getNumDroppedMidiEvents() const noexcept
+{
+    return droppedMidiEvents.load(std::memory_order_relaxed);
+}
+
+int LowLatencyPlayer::getMidiLatencySamples() const noexcept
+{
+    return midiLatencySamples.load(std::memory_order_relaxed);
+}
+
+void LowLatencyPlayer::startRoundTripMeasurement() noexcept
+{
+    measurementRequested.store(true, std::memory_order_release);
+}
+
+bool LowLatencyPlayer::isMeasuring() const noexcept
+{
+    return measuring.load(std::memory_order_relaxed) || measurementRequested.load(std::memory_order_relaxed);
+}
+
+int LowLatencyPlayer::getMeasuredRoundTripSamples() const noexcept
+{
+    return measuredRoundTrip.load(std::memory_order_relaxed);
+}
+
+void LowLatencyPlayer::audioDeviceIOCallbackWithContext(const float* const* inputChannelData, int numInputChannels,
+    float* const* outputChannelData, int numOutputChannels, int numSamples,
+    const juce::AudioIODeviceCallbackContext&)
+{
+    const DspLoadMeter::ScopedMeasurement measurement(loadMeter, numSamples);
+    const double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+
+    if (realtimeStatus.load(std::memory_order_relaxed) == RealtimeStatus::Unknown)
+        realtimeStatus.store(isCurrentThreadRealtime() ? RealtimeStatus::Realtime : RealtimeStatus::NotRealtime,
+            std::memory_order_relaxed);
+
+    // Callbacks follow each other one period apart, one half a period later missed its slot on the device
+    if (lastCallbackTime > 0.0 && now - lastCallbackTime > 1.5 * numSamples / sampleRate)
+        lateCallbacks.fetch_add(1, std::memory_order_relaxed);
+    lastCallbackTime = now;
+
+    if (blockSize <= 0 || numSamples <= 0)
+    {
+        for (int ch = 0; ch < numOutputChannels; ++ch)
+            if (outputChannelData[ch] != nullptr)
+                juce::FloatVectorOperations::clear(outputChannelData[ch], numSamples);
+        return;
+    }
+
+    placeMidi(now, numSamples);
+
+    const int numProcessorChannels = processBuffer.getNumChannels();
+    const int numProcessorInputs = processor.getTotalNumInputChannels();
+    const int numProcessorOutputs = processor.getTotalNumOutputChannels();
+
+    // Devices may deliver more than they announced, the processor never sees more than it was prepared for
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        const int chunk = juce::jmin(blockSize, numSamples - start);
+        juce::AudioBuffer<float> block(processBuffer.getArrayOfWritePointers(), numProcessorChannels, chunk);
+
+        for (int ch = 0; ch < numProcessorChannels; ++ch)
+        {
+            if (ch < numProcessorInputs && ch < numInputChannels && inputChannelData[ch] != nullptr)
+                block.copyFrom(ch, 0, inputChannelData[ch] + start, chunk);
+            else
+                block.clear(ch, 0, chunk);
+        }
+
+        auto* midi = &midiBuffer;
+        if (chunk != numSamples)
+        {
+            chunkMidi.clear();
+            chunkMidi.addEvents(midiBuffer, start, chunk, -start);
+            midi = &chunkMidi;
+        }
+
+        {
+            const juce::ScopedLock lock(processor.getCallbackLock());
+
+            if (processor.isSuspended())
+                block.clear();
+            else
+                processor.processBlock(block, *midi);
+        }
+
+        for (int ch = 0; ch < numOutputChannels; ++ch)
+        {
+            if (outputChannelData[ch] == nullptr)
+                continue;
+
+            // A mono output feeds every device channel, extra device channels stay silent otherwise
+            const int source = (numProcessorOutputs == 1) ? 0 : ch;
+            if (source < numProcessorOutputs)
+                juce::FloatVectorOperations::copy(outputChannelData[ch] + start, block.getReadPointer(source), chunk);
+            else
+                juce::FloatVectorOperations::clear(outputChannelData[ch] + start, chunk);
+        }
+    }
+
+    midiBuffer.clear();
+
+    runMeasurement(inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples);
+}
+
+void LowLatencyPlayer::placeMidi(double now, int numSamples) noexcept
+{
+    MidiEvent event;
+    while (midiQueue.pop(event))
+    {
+        // An event received just now plays at the end of the block, one received a period ago at its start
+        const auto age = static_cast<int>((now - event.timestamp) * sampleRate);
+        const int offset = juce::jlimit(0, numSamples - 1, numSamples - age);
+        midiBuffer.addEvent(event.data, event.size, offset);
+    }
+}
+
+void LowLatencyPlayer::runMeasurement(const float* const* inputChannelData, int numInputChannels,
+    float* const* outputChannelData, int numOutputChannels, int numSamples) noexcept
+{
+    const float* input = (numInputChannels > 0) ? inputChannelData[0] : nullptr;
+
+    if (measurementRequested.exchange(false, std::memory_order_acquire))
+    {
+        if (input == nullptr)
+        {
+            measuredRoundTrip.store(-1, std::memory_order_relaxed);
+            return;
+        }
+
+        for (int ch = 0; ch < numOutputChannels; ++ch)
+            if (outputChannelData[ch] != nullptr)
+                outputChannelData[ch][0] = clickLevel;
+
+        // This block's input was recorded before the click left, listening starts with the next one
+        measurementElapsed = numSamples;
+        measuring.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    if (!measuring.load(std::memory_order_relaxed) || input == nullptr)
+        return;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (std::abs(input[i]) > measurementThreshold)
+        {
+            measuredRoundTrip.store(static_cast<int>(measurementElapsed + i), std::memory_order_relaxed);
+            measuring.store(false, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    measurementElapsed += numSamples;
+    if (measurementElapsed > static_cast<juce::int64>(measurementTimeoutSeconds * sampleRate))
+    {
+        measuredRoundTrip.store(-1, std::memory_order_relaxed);
+        measuring.store(false, std::memory_order_relaxed);
+    }
+}
+
+void LowLatencyPlayer::audioDeviceAboutToStart(juce::AudioIODevice* device)
+{
+    jassert(device != nullptr);
+
+    sampleRate = device->getCurrentSampleRate();
+    blockSize = device->getCurrentBufferSizeSamples();
+    lastCallbackTime = 0.0;
+
+    const int numChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+    processBuffer.setSize(numChannels, blockSize);
+    midiBuffer.ensureSize(static_cast<size_t>(midiQueueSize * bytesPerMidiEvent));
+    chunkMidi.ensureSize(static_cast<size_t>(midiQueueSize * bytesPerMidiEvent));
+
+    // Events queued while stopped would all land on the first sample
+    MidiEvent stale;
+    while (midiQueue.pop(stale))
+    {
+    }
+
+    loadMeter.prepare(sampleRate);
+    realtimeStatus.store(RealtimeStatus::Unknown, std::memory_order_relaxed);
+    lateCallbacks.store(0, std::memory_order_relaxed);
+    midiLatencySamples.store(blockSize, std::memory_order_relaxed);
+    measuring.store(false, std::memory_order_relaxed);
+
+    const juce::ScopedLock lock(processor.getCallbackLock());
+    processor.setNonRealtime(false);
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+}
+
+void LowLatencyPlayer::audioDeviceStopped()
+{
+    const juce::ScopedLock lock(processor.getCallbackLock());
+    processor.releaseResources();
+}
+
+void LowLatencyPlayer::handleIncomingMidiMessage(juce::MidiInput*, const juce::MidiMessage& message)
+{
+    const int size = message.getRawDataSize();
+    if (size <= 0 || size > 3)
+        return;
+
+    MidiEvent event;
+    event.timestamp = message.getTimeStamp();
+    std::memcpy(event.data, message.getRawData(), static_cast<size_t>(size));
+    event.size = static_cast<juce::uint8>(size);
+
+    if (!midiQueue.push(event))
+        droppedMidiEvents.fetch_add(1, std::memory_order_relaxed);
+}
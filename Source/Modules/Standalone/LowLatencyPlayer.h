@@ -0,0 +1,156 @@
+#pragma once
+
+#include "../CommandQueue/CommandQueue.h"
+#include "../DspLoad/DspLoadMeter.h"
+#include <JuceHeader.h>
+
+/**
+ * @class LowLatencyPlayer
+ * @brief Audio device callback of the standalone app, running the processor with device-timed MIDI.
+ *
+ * Takes the place of juce::AudioProcessorPlayer. MIDI arrives on the input
+ * devices' threads with the time the device received it and is queued without
+ * locking; each audio callback places the events of the past block period at
+ * their own sample offsets, one block later. Every note is then delayed by the
+ * same fixed block instead of snapping to whichever callback picks it up.
+ * SysEx and other messages longer than three bytes are ignored.
+ *
+ * Alongside, the player checks the scheduling policy of the audio thread on
+ * its first callback, times every callback against its deadline, counts
+ * callbacks arriving late, and can measure the round trip from an output to
+ * an input through a loopback cable.
+ */
+class LowLatencyPlayer : public juce::AudioIODeviceCallback,
+                         public juce::MidiInputCallback
+{
+public:
+    /**
+     * @enum RealtimeStatus
+     * @brief Scheduling found on the audio thread.
+     */
+    enum class RealtimeStatus
+    {
+        Unknown,    ///< No callback ran since the device started
+        Realtime,   ///< The thread runs with a real-time or time-critical priority
+        NotRealtime ///< The thread runs with an ordinary priority, and glitches under load
+    };
+
+    static constexpr int midiQueueSize = 1024;                 ///< MIDI events queued between two callbacks
+    static constexpr float measurementThreshold = 0.25f;       ///< Input level at which the loopback click counts as returned
+    static constexpr double measurementTimeoutSeconds = 1.0;   ///< Time after which a click that did not return fails
+
+    /**
+     * @brief Constructs a player for a processor.
+     * @param processor The plugin instance; must outlive the player.
+     */
+    explicit LowLatencyPlayer(juce::AudioProcessor& processor);
+
+    /**
+     * @brief Returns the scheduling the audio thread was found with.
+     */
+    RealtimeStatus getRealtimeStatus() const noexcept;
+
+    /**
+     * @brief Returns the load of the whole callback, processor and MIDI placement included.
+     */
+    const DspLoadMeter& getLoadMeter() const noexcept;
+
+    /**
+     * @brief Returns how many callbacks came more than half a period after their due time.
+     */
+    int getNumLateCallbacks() const noexcept;
+
+    /**
+     * @brief Clears the late callback count and the load peaks. Safe from any thread.
+     */
+    void resetCounters() noexcept;
+
+    /**
+     * @brief Returns how many MIDI events were dropped because the queue was full.
+     */
+    int getNumDroppedMidiEvents() const noexcept;
+
+    /**
+     * @brief Returns the latency device MIDI sees before it reaches the processor, in samples.
+     */
+    int getMidiLatencySamples() const noexcept;
+
+    /**
+     * @brief Sends a click on every output and waits for it on the first input.
+     *
+     * Needs an output wired back to the first active input, and no note playing.
+     */
+    void startRoundTripMeasurement() noexcept;
+
+    /**
+     * @brief Returns true while a measurement click is out.
+     */
+    bool isMeasuring() const noexcept;
+
+    /**
+     * @brief Returns the last measured round trip in samples, -1 if none succeeded.
+     */
+    int getMeasuredRoundTripSamples() const noexcept;
+
+    /** @brief Runs the processor for one device block. */
+    void audioDeviceIOCallbackWithContext(const float* const* inputChannelData, int numInputChannels,
+        float* const* outputChannelData, int numOutputChannels, int numSamples,
+        const juce::AudioIODeviceCallbackContext& context) override;
+
+    /** @brief Prepares the processor for the device's rate and buffer size. */
+    void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
+
+    /** @brief Releases the processor's resources. */
+    void audioDeviceStopped() override;
+
+    /** @brief Queues a message with its device time stamp, on the MIDI input thread. */
+    void handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message) override;
+
+private:
+    /**
+     * @struct MidiEvent
+     * @brief A short MIDI message and the time its device received it.
+     */
+    struct MidiEvent
+    {
+        double timestamp = 0.0;          ///< Receive time in seconds, on the millisecond counter clock
+        juce::uint8 data[3] = {};        ///< Message bytes
+        juce::uint8 size = 0;            ///< Number of bytes used
+    };
+
+    /**
+     * @brief Moves the queued MIDI into midiBuffer, each event at its offset within the block.
+     * @param now Time of this callback in seconds.
+     * @param numSamples Samples in the block.
+     */
+    void placeMidi(double now, int numSamples) noexcept;
+
+    /**
+     * @brief Sends, or listens for, the loopback click of a running measurement.
+     */
+    void runMeasurement(const float* const* inputChannelData, int numInputChannels,
+        float* const* outputChannelData, int numOutputChannels, int numSamples) noexcept;
+
+    juce::AudioProcessor& processor;                   ///< The plugin instance
+    juce::AudioBuffer<float> processBuffer;            ///< Processor channels of one block, allocated on device start
+    juce::MidiBuffer midiBuffer;                       ///< MIDI of the current device block
+    juce::MidiBuffer chunkMidi;                        ///< MIDI of one processor block when a device block is split
+    CommandQueue<MidiEvent, midiQueueSize> midiQueue;  ///< Events from the input threads
+
+    double sampleRate = 44100.0;                       ///< Rate of the running device
+    int blockSize = 0;                                 ///< Largest block the processor was prepared for
+    double lastCallbackTime = 0.0;                     ///< Time of the previous callback, 0 before the first
+
+    DspLoadMeter loadMeter;                            ///< Callback time against the deadline
+    std::atomic<RealtimeStatus> realtimeStatus{ RealtimeStatus::Unknown }; ///< Set on the first callback
+    std::atomic<int> lateCallbacks{ 0 };               ///< Callbacks later than half a period
+    std::atomic<int> droppedMidiEvents{ 0 };           ///< Events lost to a full queue
+    std::atomic<int> midiLatencySamples{ 0 };          ///< One block, the delay every MIDI event gets
+
+    std::atomic<bool> measurementRequested{ false };   ///< Set by startRoundTripMeasurement()
+    std::atomic<bool> measuring{ false };              ///< True while the click is out
+    std::atomic<int> measuredRoundTrip{ -1 };          ///< Last measured round trip in samples
+    juce::int64 measurementElapsed = 0;                ///< Samples since the click was sent
+
+    JUCE_DECLARE_NON_COPYABLE(LowLatencyPlayer)
+};
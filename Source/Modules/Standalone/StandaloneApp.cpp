@@ -0,0 +1,231 @@
+#include "../../Common.h"
+#include "DeviceTuner.h"
+#include "LatencyPanel.h"
+#include "LowLatencyPlayer.h"
+#include <JuceHeader.h>
+
+// Replaces the JUCE standalone window, see the JUCE_USE_CUSTOM_PLUGIN_STANDALONE_APP option in the .jucer
+#if JucePlugin_Build_Standalone && JUCE_USE_CUSTOM_PLUGIN_STANDALONE_APP
+
+#include <juce_audio_plugin_client/detail/juce_CreatePluginFilter.h>
+
+namespace
+{
+    const juce::String audioSetupKey{ "audioSetup" };   // Device manager state
+    const juce::String pluginStateKey{ "pluginState" }; // Processor state, base64
+
+    constexpr int maxInputChannels = 2;   // Inputs offered in the settings, for the sidechain and the loopback measurement
+    constexpr int maxOutputChannels = 2;  // Outputs offered in the settings
+
+    /**
+     * @class StandaloneContent
+     * @brief The plugin editor with the latency panel under it, sized after the editor.
+     */
+    class StandaloneContent : public juce::Component, private juce::ComponentListener
+    {
+    public:
+        StandaloneContent(juce::AudioProcessor& processor, juce::AudioDeviceManager& deviceManagerIn,
+            LowLatencyPlayer& player, DeviceTuner& tuner)
+            : deviceManager(deviceManagerIn), panel(deviceManagerIn, player, tuner)
+        {
+            editor.reset(processor.createEditorIfNeeded());
+            jassert(editor != nullptr);
+
+            addAndMakeVisible(*editor);
+            addAndMakeVisible(panel);
+            editor->addComponentListener(this);
+
+            panel.onShowSettings = [this] { showSettings(); };
+            fitToEditor();
+        }
+
+        ~StandaloneContent() override
+        {
+            editor->removeComponentListener(this);
+        }
+
+        void resized() override
+        {
+            auto bounds = getLocalBounds();
+            panel.setBounds(bounds.removeFromBottom(LatencyPanel::height));
+            editor->setBounds(editor->getBounds().withPosition(0, 0));
+        }
+
+    private:
+        /** @brief Follows the editor's own size changes. */
+        void componentMovedOrResized(juce::Component&, bool, bool wasResized) override
+        {
+            if (wasResized)
+                fitToEditor();
+        }
+
+        void fitToEditor()
+        {
+            setSize(editor->getWidth(), editor->getHeight() + LatencyPanel::height);
+        }
+
+        void showSettings()
+        {
+            auto selector = std::make_unique<juce::AudioDeviceSelectorComponent>(deviceManager,
+                0, maxInputChannels, 1, maxOutputChannels, true, false, true, false);
+            selector->setSize(500, 450);
+
+            juce::DialogWindow::LaunchOptions options;
+            options.content.setOwned(selector.release());
+            options.dialogTitle = "Audio/MIDI Settings";
+            options.dialogBackgroundColour = UI::Colors::VolumeMeterBackground;
+            options.escapeKeyTriggersCloseButton = true;
+            options.useNativeTitleBar = true;
+            options.resizable = false;
+            options.launchAsync();
+        }
+
+        juce::AudioDeviceManager& deviceManager;            ///< Device manager the settings edit
+        std::unique_ptr<juce::AudioProcessorEditor> editor; ///< The plugin editor
+        LatencyPanel panel;                                 ///< Device and latency report
+
+        JUCE_DECLARE_NON_COPYABLE(StandaloneContent)
+    };
+
+    /**
+     * @class StandaloneWindow
+     * @brief Main window of the standalone app, quitting when closed.
+     */
+    class StandaloneWindow : public juce::DocumentWindow
+    {
+    public:
+        StandaloneWindow(const juce::String& name, juce::AudioProcessor& processor,
+            juce::AudioDeviceManager& deviceManager, LowLatencyPlayer& player, DeviceTuner& tuner)
+            : juce::DocumentWindow(name, UI::Colors::VolumeMeterBackground, juce::DocumentWindow::minimiseButton | juce::DocumentWindow::closeButton)
+        {
+            setUsingNativeTitleBar(true);
+            setContentOwned(new StandaloneContent(processor, deviceManager, player, tuner), true);
+            centreWithSize(getWidth(), getHeight());
+            setVisible(true);
+        }
+
+        void closeButtonPressed() override
+        {
+            juce::JUCEApplication::getInstance()->systemRequestedQuit();
+        }
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(StandaloneWindow)
+    };
+}
+
+/**
+ * @class StandaloneApp
+ * @brief Standalone app hosting the plugin on the lowest-latency device this machine offers.
+ *
+ * On first launch the best device type is opened, every MIDI input enabled
+ * and the buffer probe run; afterwards the saved device setup is restored.
+ * The processor runs from a LowLatencyPlayer instead of AudioProcessorPlayer,
+ * so MIDI input keeps its device timing.
+ */
+class StandaloneApp : public juce::JUCEApplication, private juce::ChangeListener
+{
+public:
+    const juce::String getApplicationName() override { return JucePlugin_Name; }
+    const juce::String getApplicationVersion() override { return JucePlugin_VersionString; }
+    bool moreThanOneInstanceAllowed() override { return true; }
+
+    void initialise(const juce::String&) override
+    {
+        juce::PropertiesFile::Options options;
+        options.applicationName = getApplicationName();
+        options.filenameSuffix = ".settings";
+        options.osxLibrarySubFolder = "Application Support";
+#if JUCE_LINUX || JUCE_BSD
+        options.folderName = "~/.config";
+#else
+        options.folderName = "";
+#endif
+        properties.setStorageParameters(options);
+        auto* settings = properties.getUserSettings();
+
+        processor = juce::createPluginFilterOfType(juce::AudioProcessor::wrapperType_Standalone);
+        jassert(processor != nullptr);
+
+        juce::MemoryBlock state;
+        if (state.fromBase64Encoding(settings->getValue(pluginStateKey)) && state.getSize() > 0)
+            processor->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+
+        player = std::make_unique<LowLatencyPlayer>(*processor);
+        tuner = std::make_unique<DeviceTuner>(deviceManager, *player);
+        tuner->onFinished = [this] { saveAudioSetup(); };
+
+        const auto savedSetup = settings->getXmlValue(audioSetupKey);
+        deviceManager.initialise(0, processor->getMainBusNumOutputChannels(), savedSetup.get(), true);
+
+        const bool firstLaunch = (savedSetup == nullptr);
+        if (firstLaunch)
+        {
+            tuner->selectPreferredDeviceType();
+            for (const auto& input : juce::MidiInput::getAvailableDevices())
+                deviceManager.setMidiInputDeviceEnabled(input.identifier, true);
+        }
+
+        deviceManager.addMidiInputDeviceCallback({}, player.get());
+        deviceManager.addAudioCallback(player.get());
+        deviceManager.addChangeListener(this);
+
+        if (firstLaunch)
+            tuner->findSmallestStableBufferSize();
+
+        window = std::make_unique<StandaloneWindow>(getApplicationName(), *processor, deviceManager, *player, *tuner);
+    }
+
+    void shutdown() override
+    {
+        // The editor goes before the processor it shows
+        window = nullptr;
+
+        savePluginState();
+        saveAudioSetup();
+
+        deviceManager.removeChangeListener(this);
+        deviceManager.removeAudioCallback(player.get());
+        deviceManager.removeMidiInputDeviceCallback({}, player.get());
+        deviceManager.closeAudioDevice();
+
+        tuner = nullptr;
+        player = nullptr;
+        processor = nullptr;
+
+        properties.closeFiles();
+    }
+
+private:
+    /** @brief Keeps the device setup saved as the settings dialog changes it. */
+    void changeListenerCallback(juce::ChangeBroadcaster*) override
+    {
+        // The probe saves once it kept a size, not for every size it tries
+        if (tuner->getState() != DeviceTuner::State::Probing)
+            saveAudioSetup();
+    }
+
+    void saveAudioSetup()
+    {
+        if (auto xml = deviceManager.createStateXml())
+            properties.getUserSettings()->setValue(audioSetupKey, xml.get());
+    }
+
+    void savePluginState()
+    {
+        juce::MemoryBlock state;
+        processor->getStateInformation(state);
+        properties.getUserSettings()->setValue(pluginStateKey, state.toBase64Encoding());
+    }
+
+    juce::ApplicationProperties properties;            ///< Settings file of the app
+    juce::AudioDeviceManager deviceManager;            ///< The audio and MIDI devices
+    std::unique_ptr<juce::AudioProcessor> processor;   ///< The plugin instance
+    std::unique_ptr<LowLatencyPlayer> player;          ///< Callback running the processor
+    std::unique_ptr<DeviceTuner> tuner;                ///< Device type and buffer selection
+    std::unique_ptr<StandaloneWindow> window;          ///< Main window
+};
+
+JUCE_CREATE_APPLICATION_DEFINE(StandaloneApp)
+
+#endif
@@ -0,0 +1,201 @@
+#include "UserWavetable.h"
+
+namespace
+{
+    constexpr int fftOrder = 11;               // log2 of the table size
+    constexpr float normalizedPeak = 1.0f;     // Peak of the loudest frame after import
+
+    static_assert((1 << fftOrder) == UserWavetable::tableSize, "The FFT must span one table");
+
+    /**
+     * @brief Fixed-size header of a cache file.
+     */
+    struct CacheHeader
+    {
+        char magic[4];          ///< "DSWT"
+        uint32_t version;       ///< Format version
+        uint32_t tableSize;     ///< Samples per band, before the guard
+        uint32_t numBands;      ///< Bands per frame
+        uint32_t numFrames;     ///< Frames held
+        uint32_t reserved;      ///< Zero, pads the header to a multiple of eight bytes
+        uint64_t sourceHash;    ///< Identifies the source the cache was built from
+    };
+
+    static_assert(sizeof(CacheHeader) == 32, "The samples must start on a float boundary");
+
+    constexpr char cacheMagic[4] = { 'D', 'S', 'W', 'T' };
+    constexpr size_t samplesPerFrame = static_cast<size_t>(UserWavetable::numBands) * (UserWavetable::tableSize + 1);
+
+    /**
+     * @brief Reads an audio file into one cycle per frame, mixed to mono.
+     * @return The frames back to back, empty if the file could not be read.
+     */
+    std::vector<float> readFrames(const juce::File& source, int& numFrames)
+    {
+        constexpr int tableSize = UserWavetable::tableSize;
+
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(source));
+        if (reader == nullptr || reader->lengthInSamples <= 0 || reader->numChannels == 0)
+            return {};
+
+        const auto maxLength = static_cast<juce::int64>(UserWavetable::maxFrames) * tableSize;
+        const int length = static_cast<int>(juce::jmin(reader->lengthInSamples, maxLength));
+
+        juce::AudioBuffer<float> audio(static_cast<int>(reader->numChannels), length);
+        if (!reader->read(&audio, 0, length, 0, true, true))
+            return {};
+
+        std::vector<float> mono(static_cast<size_t>(length), 0.0f);
+        const float channelGain = 1.0f / static_cast<float>(audio.getNumChannels());
+        for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+            juce::FloatVectorOperations::addWithMultiply(mono.data(), audio.getReadPointer(channel), channelGain, length);
+
+        // Whole frames are a multi-frame table, anything else is one cycle of its own length
+        if (length % tableSize == 0)
+        {
+            numFrames = length / tableSize;
+            return mono;
+        }
+
+        std::vector<float> cycle(static_cast<size_t>(tableSize));
+        const double step = static_cast<double>(length) / tableSize;
+        for (int n = 0; n < tableSize; ++n)
+        {
+            const double position = n * step;
+            const int i0 = static_cast<int>(position);
+            const int i1 = (i0 + 1) % length;
+            const float frac = static_cast<float>(position - i0);
+            cycle[static_cast<size_t>(n)] = mono[static_cast<size_t>(i0)] + frac * (mono[static_cast<size_t>(i1)] - mono[static_cast<size_t>(i0)]);
+        }
+
+        numFrames = 1;
+        return cycle;
+    }
+}
+
+bool UserWavetable::build(const juce::File& source, const juce::File& cacheFile, uint64_t sourceHash)
+{
+    int numFrames = 0;
+    const auto frames = readFrames(source, numFrames);
+    if (frames.empty())
+        return false;
+
+    juce::dsp::FFT fft(fftOrder);
+    std::vector<float> spectrum(static_cast<size_t>(2 * tableSize));
+    std::vector<float> band(static_cast<size_t>(2 * tableSize));
+    std::vector<float> samples(static_cast<size_t>(numFrames) * samplesPerFrame);
+
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+        std::copy_n(frames.begin() + static_cast<std::ptrdiff_t>(frame) * tableSize, tableSize, spectrum.begin());
+        fft.performRealOnlyForwardTransform(spectrum.data());
+
+        for (int b = 0; b < numBands; ++b)
+        {
+            // Keep harmonics 1 to the band's limit and their mirrors, DC is dropped
+            const int harmonics = WavetableBank::getHarmonicsForBand(b);
+            std::fill(band.begin(), band.end(), 0.0f);
+            for (int k = 1; k <= harmonics; ++k)
+            {
+                for (const int bin : { k, tableSize - k })
+                {
+                    band[static_cast<size_t>(2 * bin)] = spectrum[static_cast<size_t>(2 * bin)];
+                    band[static_cast<size_t>(2 * bin + 1)] = spectrum[static_cast<size_t>(2 * bin + 1)];
+                }
+            }
+
+            fft.performRealOnlyInverseTransform(band.data());
+
+            float* table = samples.data() + static_cast<size_t>(frame) * samplesPerFrame + static_cast<size_t>(b) * (tableSize + 1);
+            std::copy_n(band.begin(), tableSize, table);
+            table[tableSize] = table[0];
+        }
+    }
+
+    // One gain for every frame and band keeps the frames' levels relative to each other
+    const auto range = juce::FloatVectorOperations::findMinAndMax(samples.data(), static_cast<int>(samples.size()));
+    const float peak = juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd()));
+    if (peak <= 0.0f)
+        return false;
+
+    juce::FloatVectorOperations::multiply(samples.data(), normalizedPeak / peak, static_cast<int>(samples.size()));
+
+    CacheHeader header{};
+    std::copy_n(cacheMagic, 4, header.magic);
+    header.version = static_cast<uint32_t>(cacheVersion);
+    header.tableSize = static_cast<uint32_t>(tableSize);
+    header.numBands = static_cast<uint32_t>(numBands);
+    header.numFrames = static_cast<uint32_t>(numFrames);
+    header.sourceHash = sourceHash;
+
+    // Written next to the target and moved over it, so a reader never maps half a file
+    cacheFile.getParentDirectory().createDirectory();
+    juce::TemporaryFile temporary(cacheFile);
+    {
+        juce::FileOutputStream out(temporary.getFile());
+        if (!out.openedOk()
+            || !out.write(&header, sizeof(header))
+            || !out.write(samples.data(), samples.size() * sizeof(float)))
+            return false;
+    }
+
+    return temporary.overwriteTargetFileWithTemporary();
+}
+
+std::unique_ptr<UserWavetable> UserWavetable::open(const juce::File& cacheFile, const juce::File& source, uint64_t sourceHash)
+{
+    if (!cacheFile.existsAsFile())
+        return nullptr;
+
+    auto mapping = std::make_unique<juce::MemoryMappedFile>(cacheFile, juce::MemoryMappedFile::readOnly);
+    if (mapping->getData() == nullptr || mapping->getSize() < sizeof(CacheHeader))
+        return nullptr;
+
+    CacheHeader header;
+    std::memcpy(&header, mapping->getData(), sizeof(header));
+
+    const bool valid = std::equal(cacheMagic, cacheMagic + 4, header.magic)
+        && header.version == static_cast<uint32_t>(cacheVersion)
+        && header.tableSize == static_cast<uint32_t>(tableSize)
+        && header.numBands == static_cast<uint32_t>(numBands)
+        && header.numFrames >= 1 && header.numFrames <= static_cast<uint32_t>(maxFrames)
+        && header.sourceHash == sourceHash
+        && mapping->getSize() == sizeof(CacheHeader) + header.numFrames * samplesPerFrame * sizeof(float);
+
+    if (!valid)
+        return nullptr;
+
+    return std::unique_ptr<UserWavetable>(new UserWavetable(std::move(mapping), source, sourceHash, static_cast<int>(header.numFrames)));
+}
+
+UserWavetable::UserWavetable(std::unique_ptr<juce::MemoryMappedFile> mapping, const juce::File& source, uint64_t hash, int frames)
+    : mappedFile(std::move(mapping)), sourceFile(source), sourceHash(hash), numFrames(frames)
+{
+    samples = static_cast<const float*>(juce::addBytesToPointer(mappedFile->getData(), sizeof(CacheHeader)));
+}
+
+int UserWavetable::getNumFrames() const noexcept
+{
+    return numFrames;
+}
+
+const juce::File& UserWavetable::getSourceFile() const noexcept
+{
+    return sourceFile;
+}
+
+uint64_t UserWavetable::getSourceHash() const noexcept
+{
+    return sourceHash;
+}
+
+const float* UserWavetable::getTable(int frame, double cyclesPerSample) const noexcept
+{
+    const auto f = static_cast<size_t>(juce::jlimit(0, numFrames - 1, frame));
+    const auto b = static_cast<size_t>(WavetableBank::getBand(cyclesPerSample));
+    return samples + f * samplesPerFrame + b * (tableSize + 1);
+}
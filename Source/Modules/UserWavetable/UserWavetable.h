@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../Oscillator/WavetableBank.h"
+#include <JuceHeader.h>
+
+/**
+ * @class UserWavetable
+ * @brief An imported wavetable, band-limited like the built-in shapes and read from a memory-mapped cache file.
+ *
+ * A table holds one or more frames, each a single cycle of tableSize samples
+ * stored as the same octave bands as WavetableBank, so an oscillator reads it
+ * exactly like a built-in shape. The bands are generated once, by build(), and
+ * written to a cache file; open() maps that file read-only, so a table costs no
+ * resident memory until its pages are first read and nothing is parsed at load.
+ *
+ * Cache layout, native byte order (the cache never leaves the machine):
+ * @code
+ * char   magic[4]      // "DSWT"
+ * uint32 version
+ * uint32 tableSize
+ * uint32 numBands
+ * uint32 numFrames
+ * uint32 reserved
+ * uint64 sourceHash     // identifies the source file the cache was built from
+ * float  samples[numFrames][numBands][tableSize + 1]
+ * @endcode
+ */
+class UserWavetable
+{
+public:
+    static constexpr int tableSize = WavetableBank::tableSize;   ///< Samples per frame and band
+    static constexpr int numBands = WavetableBank::numBands;     ///< Octave bands per frame
+    static constexpr int maxFrames = 256;                        ///< Frames kept of a multi-frame table at most
+    static constexpr int cacheVersion = 1;                       ///< Version written by build()
+
+    /**
+     * @brief Reads an audio file and writes the band-limited frames to a cache file.
+     *
+     * A file whose length is a whole number of tableSize frames is read as a
+     * multi-frame table, any other file as one cycle resampled to tableSize.
+     * Each frame is taken to the frequency domain once, and every band is the
+     * inverse transform with the harmonics above its limit removed. Slow, call
+     * from a background thread.
+     * @param source WAV or other audio file known to juce::AudioFormatManager.
+     * @param cacheFile File to write, replaced only once complete.
+     * @param sourceHash Hash stored in the cache, see open().
+     * @return True if the cache was written.
+     */
+    static bool build(const juce::File& source, const juce::File& cacheFile, uint64_t sourceHash);
+
+    /**
+     * @brief Maps a cache file written by build().
+     * @param cacheFile The cache file.
+     * @param source Source file the table was imported from, kept for getSourceFile().
+     * @param sourceHash Hash the cache must carry, so an edited source is rebuilt.
+     * @return The table, or nullptr if the file is missing, stale or damaged.
+     */
+    static std::unique_ptr<UserWavetable> open(const juce::File& cacheFile, const juce::File& source, uint64_t sourceHash);
+
+    /**
+     * @brief Returns the number of frames.
+     */
+    int getNumFrames() const noexcept;
+
+    /**
+     * @brief Returns the source file the table was imported from.
+     */
+    const juce::File& getSourceFile() const noexcept;
+
+    /**
+     * @brief Returns the hash of the source file the cache was built from.
+     */
+    uint64_t getSourceHash() const noexcept;
+
+    /**
+     * @brief Returns the band-limited table of a frame at a given pitch. Safe on the audio thread.
+     * @param frame Frame index, clamped to the frames held.
+     * @param cyclesPerSample Fundamental frequency divided by the sample rate.
+     * @return Pointer to tableSize + 1 samples (last sample is a wrap guard).
+     */
+    const float* getTable(int frame, double cyclesPerSample) const noexcept;
+
+private:
+    /**
+     * @brief Adopts a validated mapping.
+     */
+    UserWavetable(std::unique_ptr<juce::MemoryMappedFile> mapping, const juce::File& source, uint64_t sourceHash, int numFrames);
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;  ///< Read-only mapping of the cache file
+    juce::File sourceFile;                               ///< File the table was imported from
+    uint64_t sourceHash = 0;                             ///< Hash of the source when the table was imported
+    const float* samples = nullptr;                      ///< First sample of the first band, inside the mapping
+    int numFrames = 0;                                   ///< Frames held
+
+    JUCE_DECLARE_NON_COPYABLE(UserWavetable)
+};
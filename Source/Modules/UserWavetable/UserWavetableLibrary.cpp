@@ -0,0 +1,106 @@
+#include "UserWavetableLibrary.h"
+
+namespace
+{
+    const juce::String cacheExtension{ ".dswt" };
+}
+
+UserWavetableLibrary::UserWavetableLibrary() = default;
+
+UserWavetableLibrary::~UserWavetableLibrary()
+{
+    loader.removeAllJobs(true, -1);
+}
+
+void UserWavetableLibrary::load(const juce::File& source)
+{
+    if (source == juce::File())
+        return;
+
+    // An edited file hashes differently, so it is imported again rather than taken as loaded
+    const auto sourceHash = hashSource(source);
+    {
+        const juce::ScopedLock scope(lock);
+        if (requested.contains(sourceHash))
+            return;
+
+        requested.add(sourceHash);
+    }
+
+    loader.addJob([this, source, sourceHash] { loadOnLoaderThread(source, sourceHash); });
+}
+
+const UserWavetable* UserWavetableLibrary::find(const juce::File& source) const
+{
+    if (source == juce::File())
+        return nullptr;
+
+    const auto sourceHash = hashSource(source);
+
+    const juce::ScopedLock scope(lock);
+    for (const auto& table : tables)
+    {
+        if (table->getSourceHash() == sourceHash)
+            return table.get();
+    }
+
+    return nullptr;
+}
+
+juce::File UserWavetableLibrary::getCacheFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("DigitalSynthesizer")
+        .getChildFile("WavetableCache");
+}
+
+void UserWavetableLibrary::loadOnLoaderThread(const juce::File& source, uint64_t sourceHash)
+{
+    const auto cacheFile = getCacheFile(source, sourceHash);
+
+    // A current cache is only mapped, the bands are generated once per source
+    auto table = UserWavetable::open(cacheFile, source, sourceHash);
+    if (table == nullptr && UserWavetable::build(source, cacheFile, sourceHash))
+        table = UserWavetable::open(cacheFile, source, sourceHash);
+
+    const juce::ScopedLock scope(lock);
+    if (table == nullptr)
+    {
+        // Forget the failure, so importing the file again retries
+        requested.removeFirstMatchingValue(sourceHash);
+        return;
+    }
+
+    tables.push_back(std::move(table));
+    sendChangeMessage();
+}
+
+uint64_t UserWavetableLibrary::hashSource(const juce::File& source)
+{
+    // FNV-1a over what changes when the file does, without reading it
+    uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](const void* data, size_t size)
+        {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+
+    const auto path = source.getFullPathName().toStdString();
+    const auto size = source.getSize();
+    const auto modified = source.getLastModificationTime().toMilliseconds();
+
+    mix(path.data(), path.size());
+    mix(&size, sizeof(size));
+    mix(&modified, sizeof(modified));
+    return hash;
+}
+
+juce::File UserWavetableLibrary::getCacheFile(const juce::File& source, uint64_t sourceHash)
+{
+    return getCacheFolder().getChildFile(juce::File::createLegalFileName(source.getFileNameWithoutExtension())
+        + "-" + juce::String::toHexString(static_cast<juce::int64>(sourceHash)) + cacheExtension);
+}
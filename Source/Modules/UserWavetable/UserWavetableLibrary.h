@@ -0,0 +1,78 @@
+#pragma once
+
+#include "UserWavetable.h"
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * @class UserWavetableLibrary
+ * @brief Imports user wavetables on a background thread and keeps them mapped for every plugin instance.
+ *
+ * Processors hold the library through juce::SharedResourcePointer. A request
+ * names a source file; the loader thread maps its cache if it is current, or
+ * builds the cache first, and a change message then tells the processors to
+ * pick the table up. Tables are keyed on the source's path, size and
+ * modification time, so a file edited since it was loaded is imported again. Neither importing nor a preset naming a table ever
+ * blocks the message or audio thread.
+ *
+ * Loaded tables are kept until the last instance closes, so an oscillator can
+ * go on reading a table while the user switches to another one. They are
+ * memory-mapped, so a table no oscillator plays costs address space only.
+ */
+class UserWavetableLibrary : public juce::ChangeBroadcaster
+{
+public:
+    /**
+     * @brief Starts the loader thread.
+     */
+    UserWavetableLibrary();
+
+    /**
+     * @brief Waits for a table still being imported.
+     */
+    ~UserWavetableLibrary() override;
+
+    /**
+     * @brief Requests a table, mapping or building its cache on the loader thread. Message thread only.
+     *
+     * Does nothing if the table is loaded or on its way, unless the file changed since.
+     * A change message follows once it is.
+     * @param source Audio file to import.
+     */
+    void load(const juce::File& source);
+
+    /**
+     * @brief Returns a loaded table. Message thread only.
+     * @param source Audio file the table was imported from.
+     * @return The table of the file as it is now, or nullptr if that is not loaded (yet, or it failed to import).
+     */
+    const UserWavetable* find(const juce::File& source) const;
+
+    /**
+     * @brief Returns the folder the caches are written to.
+     */
+    static juce::File getCacheFolder();
+
+private:
+    /**
+     * @brief Maps a source's cache, building it first if it is missing or stale. Runs on the loader thread.
+     */
+    void loadOnLoaderThread(const juce::File& source, uint64_t sourceHash);
+
+    /**
+     * @brief Returns a hash of a source file's path, size and modification time.
+     */
+    static uint64_t hashSource(const juce::File& source);
+
+    /**
+     * @brief Returns the cache file of a source.
+     */
+    static juce::File getCacheFile(const juce::File& source, uint64_t sourceHash);
+
+    juce::ThreadPool loader{ 1 };                       ///< Background thread mapping and building tables
+    mutable juce::CriticalSection lock;                 ///< Guards tables and requested
+    std::vector<std::unique_ptr<UserWavetable>> tables; ///< Loaded tables, never removed
+    juce::Array<uint64_t> requested;                    ///< Source hashes loaded or queued
+
+    JUCE_DECLARE_NON_COPYABLE(UserWavetableLibrary)
+};
@@ -0,0 +1,382 @@
+#include "VoiceAllocator.h"
+
+VoiceAllocator::VoiceAllocator(juce::AudioProcessorValueTreeState& apvts)
+{
+    polyphonyHandle = apvts.getRawParameterValue(getPolyphonyParamSpecs().id);
+    policyHandle = apvts.getRawParameterValue(getStealPolicyParamSpecs().paramID);
+    voiceModeHandle = apvts.getRawParameterValue(getVoiceModeParamSpecs().paramID);
+    glideHandle = apvts.getRawParameterValue(getGlideParamSpecs().id);
+    releaseFadeHandle = apvts.getRawParameterValue(getReleaseFadeParamSpecs().id);
+    jassert(polyphonyHandle != nullptr && policyHandle != nullptr
+        && voiceModeHandle != nullptr && glideHandle != nullptr && releaseFadeHandle != nullptr);
+}
+
+KnobParamSpecs VoiceAllocator::getPolyphonyParamSpecs()
+{
+    return { "POLYPHONY", "Polyphony", 1.0f, static_cast<float>(maxPolyphony), 1.0f,
+             static_cast<float>(maxPolyphony), FormattingUtils::FormatType::Normal, true };
+}
+
+ComboBoxParamSpecs VoiceAllocator::getStealPolicyParamSpecs()
+{
+    ComboBoxParamSpecs spec;
+
+    spec.paramID = "VOICE_STEALING";
+    spec.label = "Voice Stealing";
+    spec.choices = { "Oldest", "Quietest", "Released First" };
+    spec.defaultIndex = static_cast<int>(StealPolicy::ReleasedFirst);
+
+    jassert(spec.choices.size() == static_cast<int>(StealPolicy::Count));
+    return spec;
+}
+
+ComboBoxParamSpecs VoiceAllocator::getVoiceModeParamSpecs()
+{
+    ComboBoxParamSpecs spec;
+
+    spec.paramID = "VOICE_MODE";
+    spec.label = "Voice Mode";
+    spec.choices = { "Poly", "Mono", "Legato" };
+    spec.defaultIndex = static_cast<int>(VoiceMode::Poly);
+
+    jassert(spec.choices.size() == static_cast<int>(VoiceMode::Count));
+    return spec;
+}
+
+KnobParamSpecs VoiceAllocator::getGlideParamSpecs()
+{
+    return { "GLIDE", "Glide", 0.0f, maxGlideMs, 1.0f, 0.0f, FormattingUtils::FormatType::Normal };
+}
+
+KnobParamSpecs VoiceAllocator::getReleaseFadeParamSpecs()
+{
+    return { "RELEASE_FADE", "Release Fade", 0.0f, maxReleaseFadeMs, 0.1f, 2.0f, FormattingUtils::FormatType::Normal };
+}
+
+void VoiceAllocator::addParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout)
+{
+    const auto polyphonySpec = getPolyphonyParamSpecs();
+    layout.add(std::make_unique<juce::AudioParameterInt>(
+        polyphonySpec.id, polyphonySpec.name,
+        static_cast<int>(polyphonySpec.minValue),
+        static_cast<int>(polyphonySpec.maxValue),
+        static_cast<int>(polyphonySpec.defaultValue)));
+
+    const auto policySpec = getStealPolicyParamSpecs();
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        policySpec.paramID, policySpec.label, policySpec.choices, policySpec.defaultIndex));
+
+    const auto modeSpec = getVoiceModeParamSpecs();
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        modeSpec.paramID, modeSpec.label, modeSpec.choices, modeSpec.defaultIndex));
+
+    const auto glideSpec = getGlideParamSpecs();
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        glideSpec.id, glideSpec.name,
+        juce::NormalisableRange<float>(glideSpec.minValue, glideSpec.maxValue, glideSpec.stepSize),
+        glideSpec.defaultValue));
+
+    const auto fadeSpec = getReleaseFadeParamSpecs();
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        fadeSpec.id, fadeSpec.name,
+        juce::NormalisableRange<float>(fadeSpec.minValue, fadeSpec.maxValue, fadeSpec.stepSize),
+        fadeSpec.defaultValue));
+}
+
+void VoiceAllocator::updateFromParameters() noexcept
+{
+    // A lower limit takes effect at the next note-on, held notes are not cut
+    polyphony = juce::jlimit(1, maxPolyphony, static_cast<int>(polyphonyHandle->load()));
+
+    const int policyIndex = juce::jlimit(0, static_cast<int>(StealPolicy::Count) - 1, static_cast<int>(policyHandle->load()));
+    policy = static_cast<StealPolicy>(policyIndex);
+
+    // Held keys only mean something in the mode that recorded them
+    const int modeIndex = juce::jlimit(0, static_cast<int>(VoiceMode::Count) - 1, static_cast<int>(voiceModeHandle->load()));
+    const auto newMode = static_cast<VoiceMode>(modeIndex);
+    if (newMode != voiceMode)
+    {
+        voiceMode = newMode;
+        numHeldKeys = 0;
+        monoNote = -1;
+    }
+
+    glideSeconds = juce::jlimit(0.0f, maxGlideMs, glideHandle->load()) * 0.001f;
+    releaseFadeSeconds = juce::jlimit(0.0f, maxReleaseFadeMs, releaseFadeHandle->load()) * 0.001f;
+}
+
+void VoiceAllocator::reset() noexcept
+{
+    numNotes = numPlaying = numFading = 0;
+    numHeldKeys = 0;
+    monoNote = -1;
+}
+
+void VoiceAllocator::noteOn(int midiNote, float velocity, Steals& steals) noexcept
+{
+    int index = find(midiNote);
+
+    // Retriggering a held note takes no new voice
+    if (index >= 0 && !notes[static_cast<size_t>(index)].fading)
+    {
+        auto& note = notes[static_cast<size_t>(index)];
+        note.age = nextAge++;
+        note.velocity = velocity;
+        note.level = velocity;
+        note.released = false;
+        return;
+    }
+
+    // A fading note comes back as a new one, its envelope voice restarts
+    if (index >= 0)
+        remove(index);
+
+    while (numPlaying >= polyphony)
+    {
+        const int victim = chooseVictim();
+        if (victim < 0)
+            break;
+
+        steal(victim, steals);
+    }
+
+    jassert(numNotes < capacity);
+    if (numNotes >= capacity)
+        return;
+
+    auto& note = notes[static_cast<size_t>(numNotes++)];
+    note.midiNote = midiNote;
+    note.age = nextAge++;
+    note.velocity = velocity;
+    note.level = velocity;
+    note.released = false;
+    note.fading = false;
+    ++numPlaying;
+}
+
+void VoiceAllocator::noteOff(int midiNote) noexcept
+{
+    const int index = find(midiNote);
+    if (index >= 0)
+        notes[static_cast<size_t>(index)].released = true;
+}
+
+int VoiceAllocator::getNumPlayingNotes() const noexcept
+{
+    return numPlaying;
+}
+
+bool VoiceAllocator::isMonophonic() const noexcept
+{
+    return voiceMode != VoiceMode::Poly;
+}
+
+float VoiceAllocator::getGlideSeconds() const noexcept
+{
+    return glideSeconds;
+}
+
+float VoiceAllocator::getReleaseFadeSeconds() const noexcept
+{
+    return releaseFadeSeconds;
+}
+
+VoiceAllocator::MonoTransition VoiceAllocator::monoNoteOn(int midiNote, float velocity) noexcept
+{
+    jassert(isMonophonic());
+    if (midiNote < 0 || midiNote >= numMidiNotes)
+        return {};
+
+    // Legato keeps the envelope going only while another key is held
+    const bool otherKeyHeld = (numHeldKeys > 0);
+
+    releaseHeldKey(midiNote);
+    heldKeys[static_cast<size_t>(numHeldKeys++)] = midiNote;
+    heldVelocities[static_cast<size_t>(midiNote)] = velocity;
+
+    MonoTransition transition;
+    transition.to = midiNote;
+    transition.velocity = velocity;
+    transition.retrigger = (voiceMode == VoiceMode::Mono) || !otherKeyHeld;
+
+    // Pressing the sounding key again, or nothing left to hand over, is a regular note-on
+    const int from = monoNote;
+    if (from >= 0 && from != midiNote && moveMonoNote(from, midiNote, velocity, transition.retrigger))
+        transition.from = from;
+
+    monoNote = midiNote;
+    return transition;
+}
+
+VoiceAllocator::MonoTransition VoiceAllocator::monoNoteOff(int midiNote) noexcept
+{
+    jassert(isMonophonic());
+    releaseHeldKey(midiNote);
+
+    // Any other key plays nothing, or a note left from Poly mode that releases as usual
+    if (midiNote != monoNote || numHeldKeys == 0)
+        return {};
+
+    const int to = heldKeys[static_cast<size_t>(numHeldKeys - 1)];
+    MonoTransition transition;
+    transition.to = to;
+    transition.velocity = heldVelocities[static_cast<size_t>(to)];
+    transition.retrigger = (voiceMode == VoiceMode::Mono);
+
+    if (!moveMonoNote(midiNote, to, transition.velocity, transition.retrigger))
+        return {};
+
+    transition.from = midiNote;
+    monoNote = to;
+    return transition;
+}
+
+int VoiceAllocator::find(int midiNote) const noexcept
+{
+    for (int i = 0; i < numNotes; ++i)
+    {
+        if (notes[static_cast<size_t>(i)].midiNote == midiNote)
+            return i;
+    }
+
+    return -1;
+}
+
+int VoiceAllocator::chooseVictim() const noexcept
+{
+    int victim = -1;
+
+    for (int i = 0; i < numNotes; ++i)
+    {
+        const auto& candidate = notes[static_cast<size_t>(i)];
+        if (candidate.fading)
+            continue;
+
+        if (victim < 0)
+        {
+            victim = i;
+            continue;
+        }
+
+        const auto& current = notes[static_cast<size_t>(victim)];
+        bool better = false;
+
+        switch (policy)
+        {
+        case StealPolicy::Oldest:
+            better = isOlder(candidate, current);
+            break;
+
+        case StealPolicy::Quietest:
+            better = candidate.level < current.level
+                || (candidate.level == current.level && isOlder(candidate, current));
+            break;
+
+        case StealPolicy::ReleasedFirst:
+        case StealPolicy::Count:
+            better = (candidate.released != current.released)
+                ? candidate.released
+                : isOlder(candidate, current);
+            break;
+        }
+
+        if (better)
+            victim = i;
+    }
+
+    return victim;
+}
+
+int VoiceAllocator::findOldestFading() const noexcept
+{
+    int oldest = -1;
+
+    for (int i = 0; i < numNotes; ++i)
+    {
+        const auto& note = notes[static_cast<size_t>(i)];
+        if (note.fading && (oldest < 0 || isOlder(note, notes[static_cast<size_t>(oldest)])))
+            oldest = i;
+    }
+
+    return oldest;
+}
+
+void VoiceAllocator::steal(int index, Steals& steals) noexcept
+{
+    auto& note = notes[static_cast<size_t>(index)];
+    jassert(!note.fading);
+
+    note.fading = true;
+    --numPlaying;
+    ++numFading;
+
+    if (steals.numFaded < static_cast<int>(steals.faded.size()))
+        steals.faded[static_cast<size_t>(steals.numFaded++)] = note.midiNote;
+
+    // Every spare voice is fading already, the oldest fade ends now
+    if (numFading > maxFadingNotes)
+    {
+        const int oldest = findOldestFading();
+        if (steals.numStopped < static_cast<int>(steals.stopped.size()))
+            steals.stopped[static_cast<size_t>(steals.numStopped++)] = notes[static_cast<size_t>(oldest)].midiNote;
+
+        remove(oldest);
+    }
+}
+
+bool VoiceAllocator::moveMonoNote(int from, int to, float velocity, bool retrigger) noexcept
+{
+    int index = find(from);
+    if (index < 0 || notes[static_cast<size_t>(index)].fading)
+        return false;
+
+    // A note left on the new key would be played twice
+    if (const int stale = find(to); stale >= 0)
+    {
+        remove(stale);
+        index = find(from);
+    }
+
+    auto& note = notes[static_cast<size_t>(index)];
+    note.midiNote = to;
+    note.released = false;
+
+    if (retrigger)
+    {
+        note.age = nextAge++;
+        note.velocity = velocity;
+        note.level = velocity;
+    }
+
+    return true;
+}
+
+void VoiceAllocator::releaseHeldKey(int midiNote) noexcept
+{
+    for (int i = 0; i < numHeldKeys; ++i)
+    {
+        if (heldKeys[static_cast<size_t>(i)] != midiNote)
+            continue;
+
+        // Keep the press order of the keys after it
+        for (int j = i + 1; j < numHeldKeys; ++j)
+            heldKeys[static_cast<size_t>(j - 1)] = heldKeys[static_cast<size_t>(j)];
+
+        --numHeldKeys;
+        return;
+    }
+}
+
+void VoiceAllocator::remove(int index) noexcept
+{
+    jassert(index >= 0 && index < numNotes);
+
+    if (notes[static_cast<size_t>(index)].fading)
+        --numFading;
+    else
+        --numPlaying;
+
+    const int last = --numNotes;
+    if (index != last)
+        notes[static_cast<size_t>(index)] = notes[static_cast<size_t>(last)];
+}
@@ -0,0 +1,310 @@
+#pragma once
+
+#include "../../Common.h"
+#include "../Envelope/Envelope.h"
+#include <JuceHeader.h>
+
+/**
+ * @class VoiceAllocator
+ * @brief Keeps the number of sounding notes within the polyphony limit, across every oscillator.
+ *
+ * The processor reports every note-on and note-off by incoming MIDI note.
+ * Once more notes play than the POLYPHONY parameter allows, the allocator
+ * picks a note to steal according to the VOICE_STEALING parameter; the
+ * processor fades that note out over a few milliseconds instead of cutting
+ * it. Fading notes live in a few extra envelope voices, and when those are
+ * all taken the oldest fade is stopped outright. The work per block is thus
+ * bounded by the limit, however many keys are held.
+ *
+ * In the Mono and Legato voice modes a single voice follows the most
+ * recently pressed key and falls back to the keys still held when it is
+ * released. Moving to another key hands the sounding note over to it, and
+ * its pitch glides there over the GLIDE time. Mono restarts the envelope on
+ * every key, Legato only when no other key was held.
+ *
+ * RELEASE_FADE sets the micro-fade every released note falls over at least,
+ * so a zero release cannot click and a note-off never waits on the waveform.
+ */
+class VoiceAllocator
+{
+public:
+    /**
+     * @enum StealPolicy
+     * @brief How the note to steal is chosen.
+     */
+    enum class StealPolicy
+    {
+        Oldest,        ///< The note that started first
+        Quietest,      ///< The note with the lowest level at the end of the last block
+        ReleasedFirst, ///< The oldest released note, the oldest held one if none is released
+        Count
+    };
+
+    /**
+     * @enum VoiceMode
+     * @brief Whether notes get voices of their own or share a single one.
+     */
+    enum class VoiceMode
+    {
+        Poly,   ///< A voice per note, up to the polyphony limit
+        Mono,   ///< One voice, retriggered by every key
+        Legato, ///< One voice, retriggered only when no other key is held
+        Count
+    };
+
+    /**
+     * @struct MonoTransition
+     * @brief What a key does to the single voice of the Mono and Legato modes.
+     *
+     * With from set the sounding note moves to a new key: the caller moves its
+     * envelope voice and oscillator slots over and glides the pitch. Without
+     * from the caller handles the key as it would in Poly mode.
+     */
+    struct MonoTransition
+    {
+        int from = -1;           ///< Incoming MIDI note the voice leaves, -1 for a regular note-on or note-off
+        int to = -1;             ///< Incoming MIDI note the voice moves to
+        float velocity = 1.0f;   ///< Velocity of the key moved to
+        bool retrigger = false;  ///< True if the envelope restarts at the new key
+    };
+
+    static constexpr int maxPolyphony = Envelope::maxPolyphony;        ///< Highest polyphony limit
+    static constexpr int maxFadingNotes = Envelope::numFadingVoices;   ///< Stolen notes fading at once
+    static constexpr float stealFadeSeconds = 0.005f;                  ///< Fade time of a stolen note
+    static constexpr float maxGlideMs = 2000.0f;                       ///< Longest glide time
+    static constexpr float maxReleaseFadeMs = 20.0f;                   ///< Longest release micro-fade
+
+    /**
+     * @struct Steals
+     * @brief Notes a note-on takes voices from, by incoming MIDI note.
+     */
+    struct Steals
+    {
+        std::array<int, maxPolyphony> faded{};   ///< Notes to fade out
+        int numFaded = 0;                        ///< Entries in faded
+        std::array<int, maxPolyphony> stopped{}; ///< Fading notes to stop at once
+        int numStopped = 0;                      ///< Entries in stopped
+    };
+
+    /**
+     * @brief Constructs the allocator and resolves its parameter handles.
+     * @param apvts Reference to the AudioProcessorValueTreeState.
+     */
+    explicit VoiceAllocator(juce::AudioProcessorValueTreeState& apvts);
+
+    /**
+     * @brief Returns the polyphony limit parameter spec.
+     */
+    static KnobParamSpecs getPolyphonyParamSpecs();
+
+    /**
+     * @brief Returns the stealing policy parameter spec.
+     */
+    static ComboBoxParamSpecs getStealPolicyParamSpecs();
+
+    /**
+     * @brief Returns the voice mode parameter spec.
+     */
+    static ComboBoxParamSpecs getVoiceModeParamSpecs();
+
+    /**
+     * @brief Returns the glide time parameter spec, in milliseconds.
+     */
+    static KnobParamSpecs getGlideParamSpecs();
+
+    /**
+     * @brief Returns the release micro-fade parameter spec, in milliseconds.
+     */
+    static KnobParamSpecs getReleaseFadeParamSpecs();
+
+    /**
+     * @brief Adds the polyphony, stealing, voice mode, glide and release fade parameters to the APVTS layout.
+     * @param layout The parameter layout to append to.
+     */
+    static void addParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout);
+
+    /**
+     * @brief Reads the polyphony limit, the stealing policy, the voice mode, the glide time and the release fade.
+     *
+     * Audio thread, once per block.
+     */
+    void updateFromParameters() noexcept;
+
+    /**
+     * @brief Forgets every note.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Registers a note-on and picks the notes it steals from.
+     *
+     * A note that is already playing restarts in place; a fading one counts
+     * against the limit again, like a new note.
+     *
+     * @param midiNote Incoming MIDI note number.
+     * @param velocity Note velocity in [0, 1], weighs the note's level for Quietest.
+     * @param steals Receives the notes to fade out and to stop.
+     */
+    void noteOn(int midiNote, float velocity, Steals& steals) noexcept;
+
+    /**
+     * @brief Marks a note as released, a preferred victim for ReleasedFirst.
+     * @param midiNote Incoming MIDI note number.
+     */
+    void noteOff(int midiNote) noexcept;
+
+    /**
+     * @brief Refreshes the level of every note and forgets finished ones. Once per block.
+     * @param getLevel Called with an incoming MIDI note, returns its loudest envelope value
+     *                 or a negative value once no envelope plays it.
+     */
+    template <typename LevelFunction>
+    void update(LevelFunction&& getLevel)
+    {
+        for (int i = 0; i < numNotes; )
+        {
+            const float level = getLevel(notes[static_cast<size_t>(i)].midiNote);
+            if (level < 0.0f)
+            {
+                remove(i);
+                continue;
+            }
+
+            auto& note = notes[static_cast<size_t>(i)];
+            note.level = level * note.velocity;
+            ++i;
+        }
+    }
+
+    /**
+     * @brief Returns the number of notes counted against the limit.
+     */
+    int getNumPlayingNotes() const noexcept;
+
+    /**
+     * @brief Returns true in the Mono and Legato voice modes.
+     */
+    bool isMonophonic() const noexcept;
+
+    /**
+     * @brief Returns the glide time of the single voice in seconds, 0 for none.
+     */
+    float getGlideSeconds() const noexcept;
+
+    /**
+     * @brief Returns the release micro-fade in seconds, 0 for none.
+     */
+    float getReleaseFadeSeconds() const noexcept;
+
+    /**
+     * @brief Registers a key press in the Mono and Legato modes.
+     *
+     * While the previous key's note still sounds, it is handed over to the new
+     * key and recorded under it. Otherwise the key starts a regular note,
+     * which the caller also registers with noteOn().
+     *
+     * @param midiNote Incoming MIDI note number.
+     * @param velocity Note velocity in [0, 1].
+     * @return The transition to apply.
+     */
+    MonoTransition monoNoteOn(int midiNote, float velocity) noexcept;
+
+    /**
+     * @brief Registers a key release in the Mono and Legato modes.
+     *
+     * Releasing the sounding key hands its note back to the last key still
+     * held. With none held, or for any other key, the caller releases the
+     * note as usual, including noteOff().
+     *
+     * @param midiNote Incoming MIDI note number.
+     * @return The transition to apply.
+     */
+    MonoTransition monoNoteOff(int midiNote) noexcept;
+
+private:
+    /**
+     * @struct Note
+     * @brief Bookkeeping of one incoming note.
+     */
+    struct Note
+    {
+        int midiNote = -1;       ///< Incoming MIDI note number
+        uint32_t age = 0;        ///< Start order
+        float velocity = 1.0f;   ///< Note velocity in [0, 1]
+        float level = 1.0f;      ///< Loudest envelope value times velocity at the last update
+        bool released = false;   ///< True after its note-off
+        bool fading = false;     ///< True once stolen
+    };
+
+    static constexpr int capacity = maxPolyphony + maxFadingNotes; ///< Notes tracked at most
+
+    /**
+     * @brief Returns the index of a note, or -1.
+     */
+    int find(int midiNote) const noexcept;
+
+    /**
+     * @brief Returns the playing note to steal according to the policy, or -1 if none plays.
+     */
+    int chooseVictim() const noexcept;
+
+    /**
+     * @brief Returns the oldest fading note, or -1 if none fades.
+     */
+    int findOldestFading() const noexcept;
+
+    /**
+     * @brief Marks a playing note as stolen, stopping the oldest fade if too many are fading.
+     */
+    void steal(int index, Steals& steals) noexcept;
+
+    /**
+     * @brief Removes a note by moving the last one into its place.
+     */
+    void remove(int index) noexcept;
+
+    /**
+     * @brief Records a sounding note under another key, returns false if it no longer plays.
+     */
+    bool moveMonoNote(int from, int to, float velocity, bool retrigger) noexcept;
+
+    /**
+     * @brief Removes a key from the held keys, if held.
+     */
+    void releaseHeldKey(int midiNote) noexcept;
+
+    /**
+     * @brief Returns true if a started before b, wrap-safe.
+     */
+    static bool isOlder(const Note& a, const Note& b) noexcept
+    {
+        return static_cast<int32_t>(a.age - b.age) < 0;
+    }
+
+    std::array<Note, capacity> notes;                 ///< Packed notes, [0, numNotes) in use
+    int numNotes = 0;                                 ///< Notes in use
+    int numPlaying = 0;                               ///< Notes not fading
+    int numFading = 0;                                ///< Notes fading
+    uint32_t nextAge = 0;                             ///< Age given to the next note-on
+
+    int polyphony = maxPolyphony;                     ///< Current limit
+    StealPolicy policy = StealPolicy::ReleasedFirst;  ///< Current policy
+    VoiceMode voiceMode = VoiceMode::Poly;            ///< Current voice mode
+    float glideSeconds = 0.0f;                        ///< Current glide time
+    float releaseFadeSeconds = 0.0f;                  ///< Current release micro-fade
+
+    static constexpr int numMidiNotes = 128;          ///< Keys that can be held
+
+    std::array<int, numMidiNotes> heldKeys{};         ///< Held keys, the last pressed at the end
+    std::array<float, numMidiNotes> heldVelocities{}; ///< Velocity of every key when pressed
+    int numHeldKeys = 0;                              ///< Entries in heldKeys
+    int monoNote = -1;                                ///< Key the single voice plays, -1 if none
+
+    std::atomic<float>* polyphonyHandle = nullptr;    ///< Cached handle of the polyphony parameter
+    std::atomic<float>* policyHandle = nullptr;       ///< Cached handle of the stealing parameter
+    std::atomic<float>* voiceModeHandle = nullptr;    ///< Cached handle of the voice mode parameter
+    std::atomic<float>* glideHandle = nullptr;        ///< Cached handle of the glide parameter
+    std::atomic<float>* releaseFadeHandle = nullptr;  ///< Cached handle of the release fade parameter
+
+    JUCE_DECLARE_NON_COPYABLE(VoiceAllocator)
+};
@@ -0,0 +1,191 @@
+#include "MeterBus.h"
+
+void MeterBus::prepare(double sampleRate)
+{
+    // ITU-R BS.1770 K-weighting, re-derived for the actual sample rate
+    const double pi = juce::MathConstants<double>::pi;
+
+    Biquad shelf;
+    {
+        const double k = std::tan(pi * 1681.974450955533 / sampleRate);
+        const double q = 0.7071752369554196;
+        const double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = static_cast<float>((vh + vb * k / q + k * k) / a0);
+        shelf.b1 = static_cast<float>(2.0 * (k * k - vh) / a0);
+        shelf.b2 = static_cast<float>((vh - vb * k / q + k * k) / a0);
+        shelf.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        shelf.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+
+    Biquad highPass;
+    {
+        const double k = std::tan(pi * 38.13547087602444 / sampleRate);
+        const double q = 0.5003270373238773;
+        const double a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.0f;
+        highPass.b1 = -2.0f;
+        highPass.b2 = 1.0f;
+        highPass.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        highPass.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+
+    for (auto& stages : kWeighting)
+    {
+        stages[0] = shelf;
+        stages[1] = highPass;
+    }
+
+    samplesPerBin = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+    loudnessBins.fill(0.0);
+    currentBinEnergy = 0.0;
+    currentBinSamples = 0;
+    nextBin = 0;
+    momentaryLoudness = silenceLufs;
+
+    pending = {};
+    pendingSquares.fill(0.0);
+    fifo.reset();
+}
+
+float MeterBus::accumulate(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    if (numSamples <= 0)
+        return 0.0f;
+
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    float segmentPeak = 0.0f;
+    double weightedEnergy = 0.0;
+
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        const float* data = buffer.getReadPointer(ch, startSample);
+
+        const auto range = juce::FloatVectorOperations::findMinAndMax(data, numSamples);
+        const float peak = juce::jmax(-range.getStart(), range.getEnd());
+        pending.peak[ch] = juce::jmax(pending.peak[ch], peak);
+        segmentPeak = juce::jmax(segmentPeak, peak);
+
+        float squares = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            squares += data[i] * data[i];
+        pendingSquares[ch] += squares;
+
+        // The filters are recursive, so this pass stays scalar
+        auto& shelf = kWeighting[ch][0];
+        auto& highPass = kWeighting[ch][1];
+        float weighted = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float y = highPass.process(shelf.process(data[i]));
+            weighted += y * y;
+        }
+        weightedEnergy += weighted;
+    }
+
+    pending.numSamples += numSamples;
+    addLoudnessEnergy(weightedEnergy, numSamples);
+
+    return segmentPeak;
+}
+
+void MeterBus::accumulateSilence(int numSamples) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    // Silent blocks only follow a tail that already decayed, so the filters can start over
+    for (auto& stages : kWeighting)
+        for (auto& stage : stages)
+            stage.z1 = stage.z2 = 0.0f;
+
+    pending.numSamples += numSamples;
+    addLoudnessEnergy(0.0, numSamples);
+}
+
+void MeterBus::addLoudnessEnergy(double energy, int numSamples) noexcept
+{
+    // A segment can straddle bins, split its energy in proportion to the samples in each
+    while (numSamples > 0)
+    {
+        const int take = juce::jmin(numSamples, samplesPerBin - currentBinSamples);
+        const double share = energy * static_cast<double>(take) / static_cast<double>(numSamples);
+
+        currentBinEnergy += share;
+        currentBinSamples += take;
+        energy -= share;
+        numSamples -= take;
+
+        if (currentBinSamples < samplesPerBin)
+            break;
+
+        loudnessBins[nextBin] = currentBinEnergy;
+        nextBin = (nextBin + 1) % numLoudnessBins;
+        currentBinEnergy = 0.0;
+        currentBinSamples = 0;
+
+        double windowEnergy = 0.0;
+        for (const double bin : loudnessBins)
+            windowEnergy += bin;
+
+        const double meanSquare = windowEnergy / static_cast<double>(numLoudnessBins * samplesPerBin);
+        momentaryLoudness = (meanSquare > 0.0)
+            ? juce::jmax(silenceLufs, static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare)))
+            : silenceLufs;
+    }
+}
+
+void MeterBus::publish() noexcept
+{
+    if (pending.numSamples == 0)
+        return;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        pending.meanSquare[ch] = static_cast<float>(pendingSquares[ch] / pending.numSamples);
+    pending.momentaryLoudness = momentaryLoudness;
+
+    const auto scope = fifo.write(1);
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+        return; // The UI is behind, keep accumulating into the same frame
+
+    frames[scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2] = pending;
+
+    pending = {};
+    pendingSquares.fill(0.0);
+}
+
+bool MeterBus::pop(Frame& result) noexcept
+{
+    const int ready = fifo.getNumReady();
+    if (ready == 0)
+        return false;
+
+    Frame merged;
+    std::array<double, numChannels> squares{};
+
+    const auto scope = fifo.read(ready);
+    scope.forEach([&](int index)
+        {
+            const auto& frame = frames[index];
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                merged.peak[ch] = juce::jmax(merged.peak[ch], frame.peak[ch]);
+                squares[ch] += static_cast<double>(frame.meanSquare[ch]) * frame.numSamples;
+            }
+
+            merged.numSamples += frame.numSamples;
+            merged.momentaryLoudness = frame.momentaryLoudness; // Already a sliding window, the newest wins
+        });
+
+    if (merged.numSamples > 0)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            merged.meanSquare[ch] = static_cast<float>(squares[ch] / merged.numSamples);
+    }
+
+    result = merged;
+    return true;
+}
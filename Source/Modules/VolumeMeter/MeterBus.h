@@ -0,0 +1,140 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * @class MeterBus
+ * @brief Lock-free single-producer/single-consumer bus carrying output levels to the UI.
+ *
+ * The audio thread accumulates peak, RMS and K-weighted energy over every
+ * segment of a block and publishes one frame per block. The UI pops all
+ * frames published since its last poll and reads them as one aggregate, so
+ * no peak between two timer ticks is lost and nothing on either side locks.
+ */
+class MeterBus
+{
+public:
+    static constexpr int numChannels = 2;         ///< Metered output channels
+    static constexpr float silenceLufs = -100.0f; ///< Loudness reported for digital silence
+
+    /**
+     * @struct Frame
+     * @brief Output levels over one or more blocks, as linear values.
+     */
+    struct Frame
+    {
+        std::array<float, numChannels> peak{};       ///< Largest absolute sample per channel
+        std::array<float, numChannels> meanSquare{}; ///< Mean of the squared samples per channel
+        float momentaryLoudness = silenceLufs;        ///< Momentary (400 ms) loudness in LUFS
+        int numSamples = 0;                           ///< Samples covered by the frame
+
+        /**
+         * @brief Returns the RMS level of a channel.
+         * @param channel Channel index.
+         */
+        float getRms(int channel) const noexcept { return std::sqrt(meanSquare[channel]); }
+    };
+
+    /**
+     * @brief Constructs an idle bus.
+     */
+    MeterBus() = default;
+
+    /**
+     * @brief Prepares the K-weighting filters and the loudness window.
+     *
+     * Call from prepareToPlay(), never while the audio thread is running.
+     *
+     * @param sampleRate Output sample rate in Hz.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Adds a rendered segment to the frame being built.
+     *
+     * Audio thread only.
+     *
+     * @param buffer Output buffer.
+     * @param startSample First sample of the segment.
+     * @param numSamples Number of samples in the segment.
+     * @return Largest absolute sample of the segment, over all metered channels.
+     */
+    float accumulate(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+
+    /**
+     * @brief Adds a block of digital silence to the frame being built.
+     *
+     * Audio thread only.
+     *
+     * @param numSamples Number of silent samples.
+     */
+    void accumulateSilence(int numSamples) noexcept;
+
+    /**
+     * @brief Publishes the frame built since the last call.
+     *
+     * If the UI has fallen behind and the queue is full, the frame keeps
+     * accumulating and goes out with the next publish instead. Audio thread only.
+     */
+    void publish() noexcept;
+
+    /**
+     * @brief Pops every published frame and merges them into one.
+     *
+     * Message thread only.
+     *
+     * @param result Receives the aggregate of all frames popped.
+     * @return False if no frame was published since the last call.
+     */
+    bool pop(Frame& result) noexcept;
+
+private:
+    /**
+     * @struct Biquad
+     * @brief Transposed direct form II biquad section with its own state.
+     */
+    struct Biquad
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f; ///< Feed-forward coefficients
+        float a1 = 0.0f, a2 = 0.0f;            ///< Feedback coefficients (a0 normalized to 1)
+        float z1 = 0.0f, z2 = 0.0f;            ///< State
+
+        /**
+         * @brief Filters one sample.
+         */
+        float process(float x) noexcept
+        {
+            const float y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    /**
+     * @brief Adds K-weighted channel energy to the loudness window.
+     * @param energy Sum over channels of squared K-weighted samples.
+     * @param numSamples Number of samples the energy covers.
+     */
+    void addLoudnessEnergy(double energy, int numSamples) noexcept;
+
+    static constexpr int queueSize = 32;          ///< Frames the UI may fall behind by
+    static constexpr int numLoudnessBins = 4;     ///< 100 ms bins in the 400 ms momentary window
+
+    std::array<Frame, queueSize> frames;          ///< Published frames
+    juce::AbstractFifo fifo{ queueSize };         ///< SPSC indices into frames
+
+    Frame pending;                                ///< Frame being built by the audio thread
+    std::array<double, numChannels> pendingSquares{}; ///< Sum of squares per channel for pending
+
+    std::array<std::array<Biquad, 2>, numChannels> kWeighting; ///< Shelf and high-pass stage per channel
+
+    std::array<double, numLoudnessBins> loudnessBins{}; ///< K-weighted energy of the last complete bins
+    double currentBinEnergy = 0.0;                ///< Energy of the bin being filled
+    int currentBinSamples = 0;                    ///< Samples in the bin being filled
+    int nextBin = 0;                              ///< Bin that the current one replaces
+    int samplesPerBin = 4800;                     ///< 100 ms at the prepared sample rate
+    float momentaryLoudness = silenceLufs;        ///< Loudness over the last full window
+
+    JUCE_DECLARE_NON_COPYABLE(MeterBus)
+};
@@ -1,9 +1,10 @@
 ﻿#include "VolumeMeter.h"
 #include "../../PluginProcessor.h"
+#include "../FastMath/FastMath.h"
 
 VolumeMeter::VolumeMeter()
 {
-    startTimerHz(30);
+    refreshScheduler->add(this);
 }
 
 VolumeMeter::~VolumeMeter()
@@ -13,18 +14,19 @@ VolumeMeter::~VolumeMeter()
 
 void VolumeMeter::cleanup()
 {
-    stopTimer();
+    refreshScheduler->remove(this);
     processor = nullptr;
 }
 
 void VolumeMeter::setAudioProcessorReference(DigitalSynthesizerAudioProcessor& p)
 {
     processor = &p;
-    startTimerHz(30);
+    refreshScheduler->add(this);
 }
 
 void VolumeMeter::updateTheme()
 {
+    backgroundImage = {};
     repaint();
 }
 
@@ -37,30 +39,28 @@ void VolumeMeter::setLevels(float leftDb, float rightDb)
 
 void VolumeMeter::paint(juce::Graphics& g)
 {
-    auto bounds = getLocalBounds();
-    g.fillAll(UI::Colors::VolumeMeterBackground);
-    g.setColour(UI::Colors::VolumeMeterText);
-    g.setFont(juce::Font(UI::Fonts::defaultFontSize));
+    // Everything that does not move per frame is one cached image, a single texture under OpenGL
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (backgroundImage.isNull() || scale != backgroundScale)
+        renderBackground(scale);
 
-    g.drawFittedText("Master", bounds.removeFromTop(40), juce::Justification::centred, 1);
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
 
-    const int meterHeight = bounds.getHeight() - 45;
-
-    auto drawMeter = [&](int x, float levelDb, const juce::String& label)
+    g.setColour(UI::Colors::VolumeMeterText);
+    g.setFont(9.0f);
+    const juce::String loudnessText = (loudnessLufs > minDisplayDb)
+        ? juce::String(loudnessLufs, 1) + " LUFS"
+        : juce::String("-inf LUFS");
+    g.drawFittedText(loudnessText, getLocalBounds().withTrimmedTop(titleHeight).withHeight(loudnessHeight),
+        juce::Justification::centred, 1);
+
+    auto drawLevel = [&](int x, float levelDb, float rmsDb)
         {
-            juce::Rectangle<float> meterBounds(
-                static_cast<float>(x),
-                static_cast<float>(bounds.getY()),
-                static_cast<float>(meterWidth),
-                static_cast<float>(meterHeight)
-            );
+            const auto meterBounds = getMeterBounds(x);
+            const float meterHeight = meterBounds.getHeight();
 
             float normalized = juce::jmap(juce::jlimit(minDisplayDb, maxDisplayDb, levelDb), minDisplayDb, maxDisplayDb, 0.0f, 1.0f);
-            float filledHeight = normalized * static_cast<float>(meterHeight);
-
-            // Background
-            g.setColour(UI::Colors::VolumeMeterBarBackground);
-            g.fillRect(meterBounds);
+            float filledHeight = normalized * meterHeight;
 
             // Gradient fill
             juce::ColourGradient gradient(
@@ -69,7 +69,60 @@ void VolumeMeter::paint(juce::Graphics& g)
             gradient.addColour(0.7, juce::Colours::yellow);
 
             g.setGradientFill(gradient);
-            g.fillRect(meterBounds.removeFromBottom(filledHeight));
+            g.fillRect(meterBounds.withTop(meterBounds.getBottom() - filledHeight));
+
+            // RMS marker, a rectangle rather than a stroked line so it stays a plain quad
+            if (rmsDb > minDisplayDb)
+            {
+                float rmsNormalized = juce::jmap(juce::jlimit(minDisplayDb, maxDisplayDb, rmsDb), minDisplayDb, maxDisplayDb, 0.0f, 1.0f);
+                float rmsY = meterBounds.getBottom() - rmsNormalized * meterHeight;
+                g.setColour(UI::Colors::VolumeMeterText);
+                g.fillRect(meterBounds.getX(), rmsY - 1.0f, meterBounds.getWidth(), 2.0f);
+            }
+
+            // dB level text
+            g.setColour(UI::Colors::VolumeMeterText);
+            g.setFont(9.0f);
+            juce::String dbText = juce::String(juce::jlimit(minDisplayDb, maxDisplayDb, levelDb), 1) + " dB";
+            g.drawText(dbText, x - 10, static_cast<int>(meterBounds.getBottom()) + 4, meterWidth + 20, 16, juce::Justification::centred);
+        };
+
+    const int centerX = getLocalBounds().getCentreX();
+    drawLevel(centerX - meterSpacing - meterWidth, leftDisplayDb, leftRmsDb);
+    drawLevel(centerX + meterSpacing, rightDisplayDb, rightRmsDb);
+}
+
+juce::Rectangle<float> VolumeMeter::getMeterBounds(int x) const
+{
+    const auto bounds = getLocalBounds().withTrimmedTop(titleHeight + loudnessHeight);
+    return { static_cast<float>(x), static_cast<float>(bounds.getY()),
+             static_cast<float>(meterWidth), static_cast<float>(bounds.getHeight() - 45) };
+}
+
+void VolumeMeter::renderBackground(float scale)
+{
+    backgroundScale = scale;
+    backgroundImage = juce::Image(juce::Image::ARGB,
+        juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+        juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)),
+        true);
+
+    juce::Graphics g(backgroundImage);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
+    g.fillAll(UI::Colors::VolumeMeterBackground);
+    g.setColour(UI::Colors::VolumeMeterText);
+    g.setFont(juce::Font(UI::Fonts::defaultFontSize));
+    g.drawFittedText("Master", getLocalBounds().withHeight(titleHeight), juce::Justification::centred, 1);
+
+    auto drawScale = [&](int x, const juce::String& label)
+        {
+            const auto meterBounds = getMeterBounds(x);
+            const float meterHeight = meterBounds.getHeight();
+
+            // Background
+            g.setColour(UI::Colors::VolumeMeterBarBackground);
+            g.fillRect(meterBounds);
 
             // Graduation ticks
             g.setFont(10.0f);
@@ -78,7 +131,7 @@ void VolumeMeter::paint(juce::Graphics& g)
             for (float db = std::floor(maxDisplayDb / interval) * interval; db >= minDisplayDb; db -= interval)
             {
                 float norm = juce::jmap(db, minDisplayDb, maxDisplayDb, 0.0f, 1.0f);
-                float y = static_cast<float>(bounds.getY() + meterHeight) - norm * meterHeight;
+                float y = meterBounds.getBottom() - norm * meterHeight;
                 juce::String labelText = (db >= 0.0f ? "+" : "") + juce::String((int)db);
 
                 if (label == "L")
@@ -93,22 +146,19 @@ void VolumeMeter::paint(juce::Graphics& g)
                 }
             }
 
-            // dB level text
-            g.setFont(9.0f);
-            juce::String dbText = juce::String(juce::jlimit(minDisplayDb, maxDisplayDb, levelDb), 1) + " dB";
-            g.drawText(dbText, x - 10, bounds.getY() + meterHeight + 4, meterWidth + 20, 16, juce::Justification::centred);
-
             // L/R label
-            g.drawText(label, x, bounds.getY() + meterHeight + 20, meterWidth, 16, juce::Justification::centred);
+            g.setFont(9.0f);
+            g.drawText(label, x, static_cast<int>(meterBounds.getBottom()) + 20, meterWidth, 16, juce::Justification::centred);
         };
 
-    int centerX = bounds.getCentreX();
-    drawMeter(centerX - meterSpacing - meterWidth, leftDisplayDb, "L");
-    drawMeter(centerX + meterSpacing, rightDisplayDb, "R");
+    const int centerX = getLocalBounds().getCentreX();
+    drawScale(centerX - meterSpacing - meterWidth, "L");
+    drawScale(centerX + meterSpacing, "R");
 }
 
 void VolumeMeter::resized()
 {
+    backgroundImage = {};
 }
 
 int VolumeMeter::getTotalWidth() const noexcept
@@ -116,16 +166,28 @@ int VolumeMeter::getTotalWidth() const noexcept
     return totalMeterWidth;
 }
 
-void VolumeMeter::timerCallback()
+void VolumeMeter::refresh()
 {
     if (processor == nullptr || !isVisible())
     {
-        stopTimer();
+        refreshScheduler->remove(this);
         return;
     }
 
-    const float leftDb = processor->getMasterVolumeL();
-    const float rightDb = processor->getMasterVolumeR();
+    // Everything the audio thread published since the last tick, empty while the host is not processing
+    // or when its blocks are longer than a tick; the RMS and loudness readouts then keep their last frame
+    MeterBus::Frame frame;
+    float leftDb = initialVolumeDb;
+    float rightDb = initialVolumeDb;
+
+    if (processor->getMeterBus().pop(frame))
+    {
+        leftDb = FastMath::gainToDecibels(frame.peak[0], initialVolumeDb);
+        rightDb = FastMath::gainToDecibels(frame.peak[1], initialVolumeDb);
+        leftRmsDb = FastMath::gainToDecibels(frame.getRms(0), initialVolumeDb);
+        rightRmsDb = FastMath::gainToDecibels(frame.getRms(1), initialVolumeDb);
+        loudnessLufs = juce::jmax(initialVolumeDb, frame.momentaryLoudness);
+    }
 
     constexpr float smoothing = 0.2f;
 
@@ -2,13 +2,14 @@
 
 #include "../../Common.h"
 #include <JuceHeader.h>
+#include "../RefreshScheduler/RefreshScheduler.h"
 
 class DigitalSynthesizerAudioProcessor;
 /**
  * @class VolumeMeter
  * @brief A stereo volume meter component displaying left and right channel levels in dB.
  */
-class VolumeMeter : public juce::Component, private juce::Timer
+class VolumeMeter : public juce::Component, private RefreshScheduler::Client
 {
 public:
     static constexpr float minDisplayDb = -50.0f;          ///< Minimum visible dB level for display purposes.
@@ -26,7 +27,7 @@ public:
     ~VolumeMeter() override;
 
     /**
-     * @brief Manually stops the timer and nullifies the processor reference.
+     * @brief Manually leaves the refresh scheduler and nullifies the processor reference.
      */
     void cleanup();
 
@@ -72,16 +73,37 @@ private:
     float rightLevelDb{ initialVolumeDb };      ///< Current level of the right channel in dB.
     float leftDisplayDb{ initialVolumeDb };     ///< Displayed level for left channel (smoothed).
     float rightDisplayDb{ initialVolumeDb };    ///< Displayed level for right channel (smoothed).
+    float leftRmsDb{ initialVolumeDb };         ///< RMS level of the left channel since the last tick in dB.
+    float rightRmsDb{ initialVolumeDb };        ///< RMS level of the right channel since the last tick in dB.
+    float loudnessLufs{ initialVolumeDb };      ///< Momentary loudness in LUFS.
 
     static constexpr int totalMeterWidth = 120; ///< Preferred width of the volume meter in pixels.
     static constexpr int meterWidth = 20;       ///< Width of each volume meter (L and R).
     static constexpr int meterSpacing = 7;      ///< Spacing between the L and R meters.
     static constexpr int meterMargin = 10;      ///< Inner margin between the edge and meters.
+    static constexpr int titleHeight = 24;      ///< Height of the "Master" title.
+    static constexpr int loudnessHeight = 16;   ///< Height of the loudness readout below the title.
+
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler; ///< Shared UI refresh tick.
+
+    juce::Image backgroundImage;                ///< Cached title, bar backgrounds, ticks and labels, null when invalid.
+    float backgroundScale = 1.0f;               ///< Physical pixel scale backgroundImage was rendered at.
+
+    /**
+     * @brief Returns the bar area of the meter starting at x.
+     */
+    juce::Rectangle<float> getMeterBounds(int x) const;
+
+    /**
+     * @brief Renders everything that does not change per frame into backgroundImage.
+     * @param scale Physical pixel scale of the target context.
+     */
+    void renderBackground(float scale);
 
     /**
-     * @brief Timer callback to update the smoothed display levels.
+     * @brief Shared refresh tick, updates the smoothed display levels.
      */
-    void timerCallback() override;
+    void refresh() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VolumeMeter)
 };
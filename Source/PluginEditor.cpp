@@ -2,7 +2,8 @@
 #include "PluginProcessor.h"
 
 DigitalSynthesizerAudioProcessorEditor::DigitalSynthesizerAudioProcessorEditor(DigitalSynthesizerAudioProcessor& p)
-    : AudioProcessorEditor(&p), audioProcessor(p)
+    : AudioProcessorEditor(&p), audioProcessor(p), dspLoadIndicator(p.getDspLoadMeter(), p.getQualityGovernor()),
+      engineStatsOverlay(p.getEngineStats())
 {
     getLookAndFeel().setDefaultSansSerifTypefaceName(UI::Fonts::defaultFont.getTypefaceName());
 
@@ -42,6 +43,14 @@ DigitalSynthesizerAudioProcessorEditor::DigitalSynthesizerAudioProcessorEditor(D
         });
     contentComponent->addAndMakeVisible(menuBar.get());
 
+    // OpenGL rendering is opt-in, and a context that fails to come up leaves the software renderer in place
+    gpuRenderer.onFallback = [this]()
+        {
+            audioProcessor.getAPVTS().state.setProperty("openGLRendering", false, nullptr);
+        };
+    gpuRenderer.setEnabled(static_cast<bool>(state.getProperty("openGLRendering", false)));
+    menuBar->setGpuRenderer(&gpuRenderer);
+
     // Create Oscillators
     oscillators.reserve(NUM_OF_OSCILLATORS);
     for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
@@ -86,6 +95,18 @@ DigitalSynthesizerAudioProcessorEditor::DigitalSynthesizerAudioProcessorEditor(D
     // Volume Meter
     contentComponent->addAndMakeVisible(volumeMeter);
     volumeMeter.setAudioProcessorReference(audioProcessor);
+    contentComponent->addAndMakeVisible(dspLoadIndicator);
+
+    // Above every module, hidden until shown from the menu bar
+    contentComponent->addChildComponent(engineStatsOverlay);
+    menuBar->setEngineStatsOverlay(&engineStatsOverlay);
+
+#if STAGE_PROFILING
+    // Above every module, hidden until shown from the menu bar
+    profilerOverlay = std::make_unique<ProfilerOverlay>(audioProcessor.getStageProfiler());
+    contentComponent->addChildComponent(*profilerOverlay);
+    menuBar->setProfilerOverlay(profilerOverlay.get());
+#endif
 
     layoutContentComponents();
 
@@ -126,6 +147,10 @@ DigitalSynthesizerAudioProcessorEditor::DigitalSynthesizerAudioProcessorEditor(D
 
 DigitalSynthesizerAudioProcessorEditor::~DigitalSynthesizerAudioProcessorEditor()
 {
+    // The context paints the children, so it goes before them
+    gpuRenderer.onFallback = nullptr;
+    gpuRenderer.setEnabled(false);
+
     // Save window size to APVTS state
     auto& state = audioProcessor.getAPVTS().state;
     state.setProperty("editorWidth", getWidth(), nullptr);
@@ -147,8 +172,19 @@ DigitalSynthesizerAudioProcessorEditor::~DigitalSynthesizerAudioProcessorEditor(
 
     volumeMeter.cleanup();
 
+#if STAGE_PROFILING
     if (menuBar)
+        menuBar->setProfilerOverlay(nullptr);
+
+    profilerOverlay.reset();
+#endif
+
+    if (menuBar)
+    {
         menuBar->setOnThemeChanged(nullptr);
+        menuBar->setGpuRenderer(nullptr);
+        menuBar->setEngineStatsOverlay(nullptr);
+    }
 
     volumeMeter.removeAllChildren();
     menuBar.reset();
@@ -182,7 +218,7 @@ void DigitalSynthesizerAudioProcessorEditor::resized()
     const int lfoHeight = LFOComponent::getTotalHeight();
 
     const int baseWidth = margin + oscWidth + margin + envWidth + margin + filterWidth + margin + meterWidth + margin;
-    const int baseHeight = menuHeight + margin + (oscHeight + margin) * NUM_OF_OSCILLATORS + lfoHeight + margin;
+    const int baseHeight = menuHeight + margin + (oscHeight + margin) * SynthConfig::numModuleRows + lfoHeight + margin;
 
     if (contentComponent)
         contentComponent->setBounds(0, 0, baseWidth, baseHeight);
@@ -202,7 +238,7 @@ void DigitalSynthesizerAudioProcessorEditor::updateEditorSize()
     const int filterWidth = FilterComponent::getTotalWidth();
     const int meterWidth = volumeMeter.getTotalWidth();
 
-    const int contentHeight = (oscHeight + margin) * NUM_OF_OSCILLATORS + LFOComponent::getTotalHeight() + margin;
+    const int contentHeight = (oscHeight + margin) * SynthConfig::numModuleRows + LFOComponent::getTotalHeight() + margin;
     const int totalHeight = menuHeight + margin + contentHeight;
 
     const int totalWidth = margin + oscWidth + margin + envWidth + margin + filterWidth + margin + meterWidth + margin;
@@ -226,7 +262,7 @@ void DigitalSynthesizerAudioProcessorEditor::layoutContentComponents()
 
     int yPos = menuHeight + margin;
 
-    for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
+    for (int i = 0; i < SynthConfig::numModuleRows; ++i)
     {
         const int xOsc = margin;
         const int xEnv = xOsc + oscWidth + margin;
@@ -258,6 +294,15 @@ void DigitalSynthesizerAudioProcessorEditor::layoutContentComponents()
 
     const int meterX = totalWidth - meterWidth - margin;
     const int meterY = menuHeight + margin;
-    const int meterHeight = (oscHeight + margin) * NUM_OF_OSCILLATORS + LFOComponent::getTotalHeight();
+    const int meterHeight = (oscHeight + margin) * SynthConfig::numModuleRows + LFOComponent::getTotalHeight()
+        - DspLoadIndicator::height - margin;
     volumeMeter.setBounds(meterX, meterY, meterWidth, meterHeight);
+    dspLoadIndicator.setBounds(meterX, meterY + meterHeight + margin, meterWidth, DspLoadIndicator::height);
+    engineStatsOverlay.setBounds(meterX - margin - EngineStatsOverlay::width, meterY,
+                                 EngineStatsOverlay::width, EngineStatsOverlay::getPreferredHeight());
+
+#if STAGE_PROFILING
+    if (profilerOverlay)
+        profilerOverlay->setBounds(margin, menuHeight + margin, ProfilerOverlay::width, profilerOverlay->getPreferredHeight());
+#endif
 }
@@ -1,12 +1,16 @@
 #pragma once
 
 #include "Common.h"
+#include "Modules/DspLoad/DspLoadIndicator.h"
 #include "Modules/MenuBar/MenuBar.h"
 #include "Modules/Oscillator/OscillatorComponent.h"
 #include "Modules/Envelope/EnvelopeComponent.h"
+#include "Modules/GpuRendering/GpuRenderer.h"
 #include "Modules/VolumeMeter/VolumeMeter.h"
 #include "Modules/Filter/FilterComponent.h"
 #include "Modules/LFO/LFOComponent.h"
+#include "Modules/EngineStats/EngineStatsOverlay.h"
+#include "Modules/StageProfiler/ProfilerOverlay.h"
 #include <JuceHeader.h>
 
 /**
@@ -50,6 +54,7 @@ public:
 
 private:
     DigitalSynthesizerAudioProcessor& audioProcessor; ///< Reference to the processor.
+    GpuRenderer gpuRenderer{ *this };                 ///< Optional OpenGL rendering of the whole editor, toggled from the menu bar.
 
     std::unique_ptr<juce::Component> contentComponent; ///< Container component that holds all visible UI components and gets uniformly scaled.
 
@@ -57,12 +62,18 @@ private:
 
     std::unique_ptr<MenuBar> menuBar; ///< The menu bar component for selecting themes.
     VolumeMeter volumeMeter;          ///< Visual stereo volume meter for displaying the master output signal levels.
+    DspLoadIndicator dspLoadIndicator; ///< Audio callback load and overruns, below the volume meter.
+    EngineStatsOverlay engineStatsOverlay; ///< Voice, block, memory and allocation counters, toggled from the menu bar.
 
     std::vector<std::unique_ptr<OscillatorComponent>> oscillators; ///< UI components for controlling oscillators.
     std::vector<std::unique_ptr<EnvelopeComponent>> envelopes;     ///< UI components for envelope shaping (ADSR).
     std::vector<std::unique_ptr<FilterComponent>> filters;         ///< UI components for filters.
     std::vector<std::unique_ptr<LFOComponent>> lfos;               ///< UI components for LFOs.
 
+#if STAGE_PROFILING
+    std::unique_ptr<ProfilerOverlay> profilerOverlay;              ///< Per-stage timings, toggled from the menu bar.
+#endif
+
     /**
      * @brief Lays out all subcomponents inside the contentComponent using fixed coordinates.
      */
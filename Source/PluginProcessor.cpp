@@ -1,17 +1,24 @@
 ﻿#include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "Modules/Linkable/LinkableUtils.h"
+#include "Modules/EngineStats/AllocationTracker.h"
+#include "Modules/GainRamp/GainRamp.h"
+
+namespace
+{
+    const juce::Identifier userWavetablesType{ "USER_WAVETABLES" };
+    const juce::Identifier remoteControlPortProperty{ "oscPort" };
+    const juce::Identifier multiCoreRenderingProperty{ "multiCore" };
+
+    juce::Identifier getUserWavetableProperty(int oscillator)
+    {
+        return "osc" + juce::String(oscillator + 1);
+    }
+}
 
 DigitalSynthesizerAudioProcessor::DigitalSynthesizerAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
-    : AudioProcessor(BusesProperties()
-#if !JucePlugin_IsMidiEffect
-#if !JucePlugin_IsSynth
-        .withInput("Input", juce::AudioChannelSet::stereo(), true)
-#endif
-        .withOutput("Output", juce::AudioChannelSet::stereo(), true)
-#endif
-    ),
+    : AudioProcessor(createBusesProperties()),
     apvts(*this, nullptr, "PARAMETERS", createParameterLayout())
 #endif
 {
@@ -21,7 +28,15 @@ DigitalSynthesizerAudioProcessor::DigitalSynthesizerAudioProcessor()
     for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
     {
         oscillators.push_back(std::make_unique<Oscillator>(Oscillator::getDefaultSampleRate(), i, apvts));
+        oscillators[i]->setScratchBuffers(&oscillatorScratchBuffers[i]);
+#if STAGE_PROFILING
+        oscillators[i]->setProfiler(&stageProfiler);
+#endif
         registerLinkableTarget(oscillators[i].get());
+
+        // Each oscillator can be cross-modulated by the one before it, which updates first
+        if (i > 0)
+            oscillators[i]->setModulator(oscillators[i - 1].get());
     }
 
     envelopes.reserve(NUM_OF_ENVELOPES);
@@ -33,18 +48,23 @@ DigitalSynthesizerAudioProcessor::DigitalSynthesizerAudioProcessor()
     filters.reserve(NUM_OF_FILTERS);
     for (int i = 0; i < NUM_OF_FILTERS; ++i)
     {
-        filters.push_back(std::make_unique<Filter>(i));
+        filters.push_back(std::make_unique<Filter>(i, apvts));
+        filters[i]->setScratchBuffers(&filterScratchBuffers[i]);
     }
 
     lfos.reserve(NUM_OF_LFOS);
     for (int i = 0; i < NUM_OF_LFOS; ++i)
-        lfos.push_back(std::make_unique<LFO>(i));
+        lfos.push_back(std::make_unique<LFO>(i, apvts));
 
     initializeModulationTargets();
+    connectModulationTargets();
+
+    userWavetables->addChangeListener(this);
 }
 
 DigitalSynthesizerAudioProcessor::~DigitalSynthesizerAudioProcessor()
 {
+    userWavetables->removeChangeListener(this);
     knobs.clear();
 }
 
@@ -82,26 +102,39 @@ bool DigitalSynthesizerAudioProcessor::isMidiEffect() const
 
 double DigitalSynthesizerAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // Sound continues after the last note-off for as long as the slowest release
+    float tail = 0.0f;
+    for (const auto& env : envelopes)
+        tail = std::max(tail, env->getReleaseTimeSeconds());
+
+    // The effects ring on after the last voice
+    return tail + effectsChain.getTailLengthSeconds();
 }
 
 int DigitalSynthesizerAudioProcessor::getNumPrograms()
 {
-    return 1;
+    // Some hosts misbehave when told there are 0 programs
+    return juce::jmax(1, presetManager->getLibrary().getNumPresets());
 }
 
 int DigitalSynthesizerAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return juce::jmax(0, presetManager->getCurrentPresetIndex());
 }
 
 void DigitalSynthesizerAudioProcessor::setCurrentProgram(int index)
 {
+    // Hosts re-select the reported program when restoring a session, that must not load anything.
+    // Compared with the raw index, so program 0 can still be picked from the init patch
+    if (index == presetManager->getCurrentPresetIndex())
+        return;
+
+    presetManager->loadPreset(index);
 }
 
 const juce::String DigitalSynthesizerAudioProcessor::getProgramName(int index)
 {
-    return {};
+    return presetManager->getLibrary().getEntry(index).name;
 }
 
 void DigitalSynthesizerAudioProcessor::changeProgramName(int index, const juce::String& newName)
@@ -110,20 +143,34 @@ void DigitalSynthesizerAudioProcessor::changeProgramName(int index, const juce::
 
 void DigitalSynthesizerAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    if (auto state = apvts.copyState().createXml())
-    {
-        copyXmlToBinary(*state, destData);
-    }
+    // Values the relay set but has not announced yet never marked the cached state dirty
+    if (parameterRelay.hasPendingChanges())
+        stateCodec.invalidate();
+
+    stateCodec.write(destData);
 }
 
 void DigitalSynthesizerAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    if (auto state = getXmlFromBinary(data, sizeInBytes))
+    if (PluginStateCodec::isBinaryState(data, sizeInBytes))
+    {
+        if (!stateCodec.read(data, sizeInBytes))
+            return;
+    }
+    else if (auto state = getXmlFromBinary(data, sizeInBytes))
     {
+        // Sessions saved before the binary format
         apvts.replaceState(juce::ValueTree::fromXml(*state));
-
-        restoreModulationRouting();
     }
+    else
+    {
+        return;
+    }
+
+    restoreModulationRouting();
+    restoreUserWavetables();
+    restoreRemoteControl();
+    setMultiCoreRenderingEnabled(apvts.state.getProperty(multiCoreRenderingProperty, false));
 }
 
 double DigitalSynthesizerAudioProcessor::getSampleRate() const
@@ -131,6 +178,27 @@ double DigitalSynthesizerAudioProcessor::getSampleRate() const
     return processorSampleRate;
 }
 
+void DigitalSynthesizerAudioProcessor::beginStateSwap()
+{
+    auto expected = StateSwapPhase::Idle;
+    stateSwapPhase.compare_exchange_strong(expected, StateSwapPhase::FadingOut);
+}
+
+bool DigitalSynthesizerAudioProcessor::isStateSwapHeld() const
+{
+    return stateSwapPhase.load() == StateSwapPhase::Held;
+}
+
+void DigitalSynthesizerAudioProcessor::endStateSwap()
+{
+    stateSwapPhase.store(StateSwapPhase::Idle);
+}
+
+void DigitalSynthesizerAudioProcessor::setStateSwapFadeTime(float seconds)
+{
+    stateSwapFadeSeconds.store(juce::jmax(0.0f, seconds));
+}
+
 PresetManager* DigitalSynthesizerAudioProcessor::getPresetManager()
 {
     return presetManager.get();
@@ -150,21 +218,127 @@ void DigitalSynthesizerAudioProcessor::prepareToPlay(double sampleRate, int samp
 {
     processorSampleRate = sampleRate;
 
-    juce::ignoreUnused(samplesPerBlock);
     masterVolume.reset(sampleRate, 0.01);
+    stateSwapGain.reset(sampleRate, stateSwapFadeSeconds.load());
+
+    for (auto& oscillatorScratch : oscillatorScratchBuffers)
+        oscillatorScratch.prepare(samplesPerBlock);
+
+    for (auto& filterScratch : filterScratchBuffers)
+        filterScratch.prepare(samplesPerBlock);
+
+    // Parallel chains only stage the main mix, chains with their own bus write to it directly
+    for (auto& output : oscillatorOutputs)
+        output.setSize(getMainBusNumOutputChannels(), samplesPerBlock);
+
+    filterBusBuffer.setSize(getMainBusNumOutputChannels(), samplesPerBlock);
+
+    preparedBlockSize = samplesPerBlock;
+
+    renderPool.prepare(multiCoreRendering ? RenderPool::getRecommendedWorkerCount(NUM_OF_OSCILLATORS - 1) : 0);
+
+    for (auto& osc : oscillators)
+        osc->prepareToPlay(sampleRate);
 
     for (auto& env : envelopes)
-        env->setSampleRate(sampleRate);
+        env->prepareToPlay(sampleRate, samplesPerBlock);
 
+    // Mono buses alone render and filter a single channel
+    const int numRenderChannels = getNumRenderChannels();
     for (auto& filter : filters)
-        filter->prepareToPlay(sampleRate, samplesPerBlock);
+        filter->prepareToPlay(sampleRate, samplesPerBlock, numRenderChannels);
+
+    for (auto& lfo : lfos)
+        lfo->prepareToPlay(samplesPerBlock);
+
+    // The talkbox only adds its latency while a sidechain is connected
+    const auto* sidechain = getBus(true, sidechainBus);
+    sidechainConnected = sidechain != nullptr && sidechain->isEnabled() && sidechain->getNumberOfChannels() > 0;
+    sidechainSamples.assign(sidechainConnected ? samplesPerBlock : 0, 0.0f);
+    sidechainTalkbox.prepare(juce::jlimit(1, SidechainTalkbox::maxChannels, getMainBusNumOutputChannels()));
+    setLatencySamples(sidechainConnected ? SidechainTalkbox::getLatencySamples() : 0);
+
+    effectsChain.prepare(sampleRate);
+
+    for (auto& envelopeBuffer : envelopeModulationBuffers)
+        envelopeBuffer.assign(samplesPerBlock, 0.0f);
+
+    masterGainRamp.assign(samplesPerBlock, 0.0f);
+
+#if STAGE_PROFILING
+    stageProfiler.setBlockBudget(samplesPerBlock / sampleRate);
+#endif
+    stateSwapRamp.assign(samplesPerBlock, 0.0f);
+    meterBus.prepare(sampleRate);
+    dspLoadMeter.prepare(sampleRate);
+    qualityGovernor.prepare(sampleRate);
+    midiEvents.prepare(expectedMidiEventsPerBlock + Arpeggiator::maxEventsPerBlock);
+    chunkMidi.ensureSize(static_cast<size_t>(expectedMidiEventsPerBlock) * midiBytesPerEvent);
+    arpeggiator.prepare(sampleRate);
+    noteExpression.reset();
+    engineStats.prepare();
 
     resetAllLfos();
+    updateMemoryStats();
 }
 
 void DigitalSynthesizerAudioProcessor::releaseResources()
 {
     resetAllLfos();
+    renderPool.release();
+}
+
+void DigitalSynthesizerAudioProcessor::setMultiCoreRenderingEnabled(bool shouldBeEnabled)
+{
+    if (multiCoreRendering.exchange(shouldBeEnabled) == shouldBeEnabled)
+        return;
+
+    {
+        // The callback lock keeps processBlock out while workers start or stop
+        const juce::ScopedLock lock(getCallbackLock());
+        renderPool.prepare(shouldBeEnabled ? RenderPool::getRecommendedWorkerCount(NUM_OF_OSCILLATORS - 1) : 0);
+    }
+
+    storeEngineOptions();
+}
+
+bool DigitalSynthesizerAudioProcessor::isMultiCoreRenderingEnabled() const
+{
+    return multiCoreRendering;
+}
+
+void DigitalSynthesizerAudioProcessor::setNoteRenderCacheEnabled(bool shouldBeEnabled)
+{
+    // The caches are allocated here and freed when this goes out of scope, processBlock is only kept out for the swap
+    std::array<NoteRenderCache, NUM_OF_OSCILLATORS> replacements;
+    if (shouldBeEnabled)
+        for (size_t i = 0; i < replacements.size(); ++i)
+            oscillators[i]->prepareRenderCache(replacements[i]);
+
+    {
+        const juce::ScopedLock lock(getCallbackLock());
+        for (size_t i = 0; i < replacements.size(); ++i)
+            oscillators[i]->swapRenderCache(replacements[i]);
+    }
+
+    updateMemoryStats();
+}
+
+bool DigitalSynthesizerAudioProcessor::isNoteRenderCacheEnabled() const
+{
+    return oscillators.front()->isRenderCacheEnabled();
+}
+
+void DigitalSynthesizerAudioProcessor::setRandomSeed(uint32_t seed)
+{
+    // The oscillators and the arpeggiator reseed in prepareToPlay(), the LFOs redraw their steps now
+    for (auto& osc : oscillators)
+        osc->setSeedOffset(seed);
+
+    for (auto& lfo : lfos)
+        lfo->setSeedOffset(seed);
+
+    arpeggiator.setSeedOffset(seed);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -182,6 +356,22 @@ bool DigitalSynthesizerAudioProcessor::isBusesLayoutSupported(const BusesLayout&
         && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
         return false;
 
+    // The sidechain is off, mono or stereo
+    if (sidechainBus < layouts.inputBuses.size())
+    {
+        const auto& set = layouts.inputBuses.getReference(sidechainBus);
+        if (!set.isDisabled() && set != juce::AudioChannelSet::mono() && set != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
+    // Each oscillator chain's own output is off, mono or stereo
+    for (int bus = firstOscillatorBus; bus < layouts.outputBuses.size(); ++bus)
+    {
+        const auto& set = layouts.outputBuses.getReference(bus);
+        if (!set.isDisabled() && set != juce::AudioChannelSet::mono() && set != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
     // This checks if the input layout matches the output layout
 #if !JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
@@ -197,33 +387,190 @@ void DigitalSynthesizerAudioProcessor::processBlock(juce::AudioBuffer<float>& bu
     juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    const AllocationTracker::ScopedRealtime realtime;
     if (buffer.getNumSamples() == 0)
         return;
 
+    // The render buffers hold the prepared block, longer host blocks are split to fit
+    if (preparedBlockSize > 0 && buffer.getNumSamples() > preparedBlockSize)
+    {
+        processOversizedBlock(buffer, midiMessages);
+        return;
+    }
+
+    const DspLoadMeter::ScopedMeasurement loadMeasurement(dspLoadMeter, buffer.getNumSamples());
+    PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::Block);
+
+    // The shared render workers help the instance whose block is due first
+    renderPool.beginBlock(buffer.getNumSamples(), getSampleRate());
+
+    // Keep the sidechain before the output overwrites the input channels
+    captureSidechain(buffer);
+
     // Clear the output buffer
     buffer.clear();
 
-    // Refresh all synth parameters from the APVTS
+    // Route this block with the connections published last
+    modulationRouter.beginBlock();
+    if (signalGraph.beginBlock())
+        applySignalGraph();
+    beginStateSwapBlock();
+
+    // Switch to a program requested during the previous block before anything reads parameters
+    presetManager->getBank().applyPendingProgram(parameterRelay);
+
+    // Remote changes received since the last block land on its boundary, ahead of the automation ramps
+    oscRemoteControl.applyPendingChanges(parameterRelay);
+
+    // Decode the block's MIDI once, everything below walks this list
+    midiEvents.build(midiMessages, buffer.getNumSamples());
+
+    // Let the arpeggiator put its notes in place of the keys, on this block's tempo and position
+    updateHostTransport();
+    arpeggiator.process(midiEvents, hostTransport, buffer.getNumSamples());
+
+    // Ramp host automation across the block, skipped blocks included so no stale value ramps later
+    trackHostAutomation(buffer.getNumSamples());
+
+    // Nothing sounding and nothing starting, skip rendering altogether
+    if (canSkipBlock())
+    {
+        processSilentBlock(buffer.getNumSamples());
+        publishEngineStats(false);
+        endStateSwapBlock();
+        return;
+    }
+
+    blockPeak = 0.0f;
+
+    // Start this block on every envelope's clock
+    for (auto& env : envelopes)
+        env->beginBlock(buffer.getNumSamples());
+
+    // Cap rendering cost by the load of the last blocks, then refresh all synth parameters from the APVTS
+    applyQualityLimits(buffer.getNumSamples());
     updateParameters();
 
+    // Render this block's LFO spans before the audio that consumes them, envelope spans fill segment by segment
+    renderAllLFOs(buffer.getNumSamples());
+    beginEnvelopeModulation(buffer.getNumSamples());
+
     // Handle incoming MIDI and render audio between events
-    handleMidiAndRender(buffer, midiMessages);
+    handleMidiAndRender(buffer);
+
+    // Talkbox, effects and meters run once over the whole block
+    processMasterStage(buffer);
 
-    // Advance all ADSR envelopes by one block
-    tickEnvelopes();
+    // Finish the block for voices no oscillator read to the end
+    endEnvelopeBlock();
 
     // Push each envelope’s output into the modulation router
     pushEnvelopeModulation();
 
-    // Advance and route all LFOs for this block
-    renderAllLFOs(buffer.getNumSamples());
+    // Push each LFO's block-end value into the modulation router
+    pushLfoModulation();
+
+    // Sum every parameter's extra slots from the values just pushed
+    modulationRouter.applyModulationSlots();
 
     // Remove finished notes and disable LFOs if idle
     finalizeNotes();
+
+    lastBlockPeak = blockPeak;
+    meterBus.publish();
+    publishEngineStats(true);
+    endStateSwapBlock();
+}
+
+void DigitalSynthesizerAudioProcessor::processOversizedBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    const int totalSamples = buffer.getNumSamples();
+    for (int start = 0; start < totalSamples; start += preparedBlockSize)
+    {
+        const int length = juce::jmin(preparedBlockSize, totalSamples - start);
+
+        // Refers to the host's channels, the channel pointers fit the buffer's preallocated space
+        juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, length);
+
+        chunkMidi.clear();
+        chunkMidi.addEvents(midiMessages, start, length, -start);
+        processBlock(chunk, chunkMidi);
+    }
+}
+
+bool DigitalSynthesizerAudioProcessor::canSkipBlock() const
+{
+    if (lastBlockPeak >= silenceThreshold)
+        return false;
+
+    for (const auto& osc : oscillators)
+        if (osc->isPlaying())
+            return false;
+
+    for (const auto& env : envelopes)
+        if (env->isActive())
+            return false;
+
+    // The talkbox still delays the end of the last note
+    if (sidechainConnected && !sidechainTalkbox.isSilent())
+        return false;
+
+    // Echoes and reverb keep ringing after the voices stopped
+    if (!effectsChain.isSilent())
+        return false;
+
+    return !midiEvents.hasNoteOns();
+}
+
+void DigitalSynthesizerAudioProcessor::processSilentBlock(int numSamples)
+{
+    // MIDI learn and CC-mapped knobs keep working while idle
+    for (const auto& event : midiEvents)
+    {
+        // Expression sent ahead of a note must be in place when the note starts
+        updateNoteExpression(event);
+
+        if (event.type == MidiEventList::Type::Controller)
+            handleControllerMessage(event.number, event.value);
+        else if (event.type == MidiEventList::Type::ProgramChange)
+            presetManager->getBank().requestProgram(event.number);
+    }
+
+    // Keep the master volume ramp in time, so it does not resume halfway on the next note
+    masterVolume.skip(numSamples);
+    stateSwapGain.skip(numSamples);
+
+    meterBus.accumulateSilence(numSamples);
+    meterBus.publish();
+}
+
+void DigitalSynthesizerAudioProcessor::beginStateSwapBlock() noexcept
+{
+    const float target = stateSwapPhase.load() == StateSwapPhase::Idle ? 1.0f : 0.0f;
+    if (stateSwapGain.getTargetValue() == target)
+        return;
+
+    // Pick up a changed fade time, unless that would cut a fade short
+    if (!stateSwapGain.isSmoothing())
+        stateSwapGain.reset(processorSampleRate, stateSwapFadeSeconds.load());
+
+    stateSwapGain.setTargetValue(target);
+}
+
+void DigitalSynthesizerAudioProcessor::endStateSwapBlock() noexcept
+{
+    if (stateSwapGain.isSmoothing() || stateSwapGain.getCurrentValue() != 0.0f)
+        return;
+
+    // The message thread may have given up waiting and gone back to Idle meanwhile
+    auto expected = StateSwapPhase::FadingOut;
+    stateSwapPhase.compare_exchange_strong(expected, StateSwapPhase::Held);
 }
 
 void DigitalSynthesizerAudioProcessor::updateParameters()
 {
+    PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::UpdateParameters);
+
     for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
     {
         oscillators[i]->updateFromParameters();
@@ -236,114 +583,511 @@ void DigitalSynthesizerAudioProcessor::updateParameters()
 
     for (int i = 0; i < NUM_OF_FILTERS; ++i)
     {
-        filters[i]->updateFromParameters(apvts, i);
+        filters[i]->updateFromParameters();
         filters[i]->updateParametersIfNeeded();
     }
+
+    voiceAllocator.updateFromParameters();
+    for (int i = 0; i < NUM_OF_ENVELOPES; ++i)
+        envelopes[i]->setReleaseFade(voiceAllocator.getReleaseFadeSeconds());
+
+    sidechainTalkbox.updateFromParameters();
+    effectsChain.updateFromParameters();
 }
 
-void DigitalSynthesizerAudioProcessor::handleMidiAndRender(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages)
+void DigitalSynthesizerAudioProcessor::handleMidiAndRender(juce::AudioBuffer<float>& buffer)
 {
     const int totalSamples = buffer.getNumSamples();
     int currentSample = 0;
+    bool retriggerLfos = false;
 
-    for (const auto metadata : midiMessages)
+    for (const auto& event : midiEvents)
     {
-        const int eventSample = metadata.samplePosition;
-        const auto message = metadata.getMessage();
+        // Takes effect at the next block, so it does not split this one
+        if (event.type == MidiEventList::Type::ProgramChange)
+        {
+            presetManager->getBank().requestProgram(event.number);
+            continue;
+        }
 
-        // Render audio from currentSample up to the MIDI event
-        if (eventSample > currentSample)
-            renderAudioSegment(buffer, currentSample, eventSample - currentSample);
+        // A poly note-off releases its envelopes at the event sample, so it needs no split
+        const bool splits = event.type != MidiEventList::Type::NoteOff || voiceAllocator.isMonophonic();
 
-        // Apply MIDI event
-        currentSample = eventSample;
+        // Render audio from currentSample up to the event, a chord's notes share one split
+        if (splits && event.sample > currentSample)
+        {
+            if (retriggerLfos)
+            {
+                handleNoteOnLfos(currentSample, totalSamples);
+                retriggerLfos = false;
+            }
 
-        if (message.isNoteOn())
+            renderAudioSegment(buffer, currentSample, event.sample - currentSample);
+            currentSample = event.sample;
+        }
+
+        // Apply MIDI event
+        switch (event.type)
         {
+        case MidiEventList::Type::NoteOn:
+        {
+            // A single voice hands the sounding note over to the new key
+            if (voiceAllocator.isMonophonic())
+            {
+                const auto transition = voiceAllocator.monoNoteOn(event.number, event.getVelocity());
+                if (transition.from >= 0)
+                {
+                    applyMonoTransition(transition, event.channel, event.sample);
+                    retriggerLfos = retriggerLfos || transition.retrigger;
+                    break;
+                }
+            }
+
+            // Make room within the polyphony limit before the new note takes its voices
+            VoiceAllocator::Steals steals;
+            voiceAllocator.noteOn(event.number, event.getVelocity(), steals);
+            applyVoiceSteals(steals, event.sample);
+
             for (auto& osc : oscillators)
             {
+                // A note without an envelope voice would never end, so it is not started
                 auto* env = osc->getEnvelope();
-                if (env != nullptr)
+                if (env != nullptr && !env->noteOn(osc->calculateMidiNoteWithOctaveOffset(event.number), event.sample))
+                    continue;
+
+                osc->noteOn(event.number, event.getVelocity(), event.channel, noteExpression.getLanes(event.channel));
+            }
+            retriggerLfos = true;
+            break;
+        }
+
+        case MidiEventList::Type::NoteOff:
+            // Releasing the sounding key of a single voice falls back to the last key still held
+            if (voiceAllocator.isMonophonic())
+            {
+                const auto transition = voiceAllocator.monoNoteOff(event.number);
+                if (transition.from >= 0)
                 {
-                    const int midiNote = osc->calculateMidiNoteWithOctaveOffset(message.getNoteNumber());
-                    env->noteOn(midiNote);
+                    applyMonoTransition(transition, event.channel, event.sample);
+                    retriggerLfos = retriggerLfos || transition.retrigger;
+                    break;
                 }
+            }
+
+            voiceAllocator.noteOff(event.number);
+            for (auto& osc : oscillators)
+            {
+                if (auto* env = osc->getEnvelope())
+                    env->noteOff(osc->calculateMidiNoteWithOctaveOffset(event.number), event.sample);
+
+                osc->noteOff(event.number);
+            }
+            break;
 
-                osc->noteOn(message);
+        case MidiEventList::Type::Controller:
+        case MidiEventList::Type::PitchBend:
+        case MidiEventList::Type::ChannelPressure:
+            if (updateNoteExpression(event))
+            {
+                for (auto& osc : oscillators)
+                    osc->updateNoteExpression(noteExpression);
             }
-            handleNoteOnLfos();
+
+            if (event.type == MidiEventList::Type::Controller)
+                handleControllerMessage(event.number, event.value);
+            break;
+
+        case MidiEventList::Type::ProgramChange:
+            break;
+        }
+    }
+
+    if (retriggerLfos)
+        handleNoteOnLfos(currentSample, totalSamples);
+
+    // Render any remaining audio
+    if (currentSample < totalSamples)
+        renderAudioSegment(buffer, currentSample, totalSamples - currentSample);
+}
+
+void DigitalSynthesizerAudioProcessor::applyMonoTransition(const VoiceAllocator::MonoTransition& transition, int channel, int sampleOffset)
+{
+    const float glideSeconds = voiceAllocator.getGlideSeconds();
+
+    for (auto& osc : oscillators)
+    {
+        auto* env = osc->getEnvelope();
+        if (env == nullptr)
+            continue;
+
+        const int toNote = osc->calculateMidiNoteWithOctaveOffset(transition.to);
+        env->moveNote(osc->calculateMidiNoteWithOctaveOffset(transition.from), toNote);
+        osc->glideNote(transition.from, transition.to, glideSeconds);
+
+        // Retriggering restarts the moved voice in place, the glide carries on
+        if (transition.retrigger && env->noteOn(toNote, sampleOffset))
+            osc->noteOn(transition.to, transition.velocity, channel, noteExpression.getLanes(channel));
+    }
+}
+
+void DigitalSynthesizerAudioProcessor::applyVoiceSteals(const VoiceAllocator::Steals& steals, int sampleOffset)
+{
+    engineStats.addStolenVoices(steals.numFaded + steals.numStopped);
+
+    for (int i = 0; i < steals.numFaded; ++i)
+    {
+        for (auto& osc : oscillators)
+        {
+            if (auto* env = osc->getEnvelope())
+                env->fadeOut(osc->calculateMidiNoteWithOctaveOffset(steals.faded[i]), sampleOffset, VoiceAllocator::stealFadeSeconds);
         }
-        else if (message.isNoteOff())
+    }
+
+    for (int i = 0; i < steals.numStopped; ++i)
+    {
+        for (auto& osc : oscillators)
+        {
+            if (auto* env = osc->getEnvelope())
+                env->stopNote(osc->calculateMidiNoteWithOctaveOffset(steals.stopped[i]));
+
+            osc->stopNote(steals.stopped[i]);
+        }
+    }
+}
+
+bool DigitalSynthesizerAudioProcessor::updateNoteExpression(const MidiEventList::Event& event) noexcept
+{
+    switch (event.type)
+    {
+    case MidiEventList::Type::PitchBend:
+        noteExpression.setPitchBend(event.channel, event.value);
+        return true;
+
+    case MidiEventList::Type::ChannelPressure:
+        noteExpression.setPressure(event.channel, event.value);
+        return event.channel != NoteExpression::masterChannel;
+
+    case MidiEventList::Type::Controller:
+        if (event.number != slideController || event.channel == NoteExpression::masterChannel)
+            return false;
+
+        noteExpression.setSlide(event.channel, event.value);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void DigitalSynthesizerAudioProcessor::renderAudioSegment(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::Segment);
+
+    // Every enabled bus gets the same gain staging, so the chain outputs sum to the main mix
+    const int numChannels = buffer.getNumChannels();
+    const float normalization = headroomFactor / NUM_OF_OSCILLATORS;
+    auto mainOutput = getBusBuffer(buffer, false, 0);
+
+    // Step 1: Clear the segment we are going to write into, on every bus
+    for (int ch = 0; ch < numChannels; ++ch)
+        buffer.clear(ch, startSample, numSamples);
+
+    // Parallel chains render into their own buffers, which must fit this block
+    const bool renderInParallel = renderPool.getNumWorkers() > 0
+        && oscillatorOutputs[0].getNumSamples() >= buffer.getNumSamples()
+        && oscillatorOutputs[0].getNumChannels() == mainOutput.getNumChannels()
+        && canRenderOscillatorsInParallel();
+
+    // Oscillators without filters of their own sum into the bus, which is filtered once per sub-block
+    const bool filterBusActive = signalGraph.getProgram().busChain.numFilters > 0;
+    if (filterBusActive)
+        filterBusBuffer.setSize(mainOutput.getNumChannels(), buffer.getNumSamples(), true, false, true);
+
+    // The segment's events are applied, so the envelopes' real output for it can go out before anything reads it
+    renderEnvelopeModulation(startSample, numSamples);
+
+    // Step 2: Each oscillator sums into the buffer, in sub-blocks while modulation spans are active
+    const int step = (modulationRouter.hasActiveSpans() || automationRamping) ? modulationSubBlockSize : numSamples;
+    for (int offset = 0; offset < numSamples; offset += step)
+    {
+        const int subBlockStart = startSample + offset;
+        const int subBlockLength = juce::jmin(step, numSamples - offset);
+
+        applyModulation(subBlockStart);
+
+        if (filterBusActive)
+            for (int ch = 0; ch < filterBusBuffer.getNumChannels(); ++ch)
+                filterBusBuffer.clear(ch, subBlockStart, subBlockLength);
+
+        if (!renderInParallel)
         {
             for (auto& osc : oscillators)
             {
-                auto* env = osc->getEnvelope();
-                if (env != nullptr)
+                PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::Oscillator, osc->getIndex());
+
+                if (feedsFilterBus(osc->getIndex()))
                 {
-                    const int midiNote = osc->calculateMidiNoteWithOctaveOffset(message.getNoteNumber());
-                    env->noteOff(midiNote);
+                    osc->processBlock(filterBusBuffer, subBlockStart, subBlockLength);
+                    continue;
                 }
 
-                osc->noteOff(message);
+                auto output = getOscillatorOutput(buffer, osc->getIndex());
+                osc->processBlock(output, subBlockStart, subBlockLength);
+            }
+        }
+        else
+        {
+            parallelBuffer = &buffer;
+            parallelStartSample = subBlockStart;
+            parallelNumSamples = subBlockLength;
+            renderPool.run(&DigitalSynthesizerAudioProcessor::renderOscillatorTask, this, NUM_OF_OSCILLATORS);
+
+            // Reduce in oscillator order, so the result does not depend on which thread finished first
+            for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
+            {
+                if (hasOwnOutput(i))
+                    continue;
+
+                auto& destination = feedsFilterBus(i) ? filterBusBuffer : mainOutput;
+                for (int ch = 0; ch < mainOutput.getNumChannels(); ++ch)
+                    destination.addFrom(ch, subBlockStart, oscillatorOutputs[i], ch, subBlockStart, subBlockLength);
             }
         }
 
-        if (message.isController())
-            handleControllerMessage(message);
+        if (filterBusActive)
+            processFilterBus(mainOutput, subBlockStart, subBlockLength);
     }
 
-    // Render any remaining audio
-    if (currentSample < totalSamples)
-        renderAudioSegment(buffer, currentSample, totalSamples - currentSample);
+    // Step 3: Apply normalization and master gain, advancing the master ramp once for all channels
+    // processBlock() never hands on more than the prepared block, which the ramps are sized for
+    jassert(numSamples <= static_cast<int>(masterGainRamp.size()) && numSamples <= static_cast<int>(stateSwapRamp.size()));
+
+    const auto masterRamp = GainRamp::render(masterVolume, masterGainRamp.data(), numSamples);
+    for (int ch = 0; ch < numChannels; ++ch)
+        masterRamp.applyTo(buffer.getWritePointer(ch, startSample), numSamples, normalization);
+
+    // Fade around a state swap, free while no swap is under way
+    if (stateSwapGain.isSmoothing() || stateSwapGain.getCurrentValue() != 1.0f)
+    {
+        const auto swapRamp = GainRamp::render(stateSwapGain, stateSwapRamp.data(), numSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+            swapRamp.applyTo(buffer.getWritePointer(ch, startSample), numSamples);
+    }
 }
 
-void DigitalSynthesizerAudioProcessor::renderAudioSegment(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+void DigitalSynthesizerAudioProcessor::processMasterStage(juce::AudioBuffer<float>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    auto mainOutput = getBusBuffer(buffer, false, 0);
+
+    // Impose the sidechain's spectral envelope on the main mix
+    if (sidechainConnected && static_cast<int>(sidechainSamples.size()) >= numSamples)
+        sidechainTalkbox.process(mainOutput, 0, numSamples, sidechainSamples.data());
+
+    {
+        PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::Effects);
+        effectsChain.process(mainOutput, numSamples);
+    }
+
+    // Update meters from the main mix; the chain outputs only keep their tails from being skipped
+    updateOutputPeakLevels(mainOutput, 0, numSamples);
+
+    for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
+        if (hasOwnOutput(i))
+            blockPeak = std::max(blockPeak, getOscillatorOutput(buffer, i).getMagnitude(0, numSamples));
+}
+
+bool DigitalSynthesizerAudioProcessor::feedsFilterBus(int oscillatorIndex) const
+{
+    // A chain with its own bus keeps it, the filter bus only collects the main mix
+    return signalGraph.getProgram().chains[static_cast<size_t>(oscillatorIndex)].feedsBus && !hasOwnOutput(oscillatorIndex);
+}
+
+void DigitalSynthesizerAudioProcessor::processFilterBus(juce::AudioBuffer<float>& mainOutput, int startSample, int numSamples)
+{
+    const auto& busChain = signalGraph.getProgram().busChain;
+
+    auto block = juce::dsp::AudioBlock<float>(filterBusBuffer).getSubBlock(static_cast<size_t>(startSample), static_cast<size_t>(numSamples));
+    for (int f = 0; f < busChain.numFilters; ++f)
+    {
+        PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::Filter, SignalGraph::bus);
+        busChain.filters[static_cast<size_t>(f)]->process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
+
+    for (int ch = 0; ch < mainOutput.getNumChannels(); ++ch)
+        mainOutput.addFrom(ch, startSample, filterBusBuffer, ch, startSample, numSamples);
+}
+
+bool DigitalSynthesizerAudioProcessor::canRenderOscillatorsInParallel() const
+{
+    return signalGraph.getProgram().independentChains;
+}
+
+void DigitalSynthesizerAudioProcessor::applySignalGraph()
+{
+    for (const auto& chain : signalGraph.getProgram().chains)
+    {
+        auto& osc = oscillators[static_cast<size_t>(chain.oscillator)];
+        osc->setEnvelope(chain.envelope);
+        osc->setFilters(chain.filters.data(), chain.numFilters);
+    }
+}
+
+void DigitalSynthesizerAudioProcessor::renderOscillatorTask(void* context, int oscillatorIndex)
+{
+    auto& processor = *static_cast<DigitalSynthesizerAudioProcessor*>(context);
+    const int start = processor.parallelStartSample;
+    const int length = processor.parallelNumSamples;
+
+    PROFILE_STAGE(&processor.stageProfiler, StageProfiler::Stage::Oscillator, oscillatorIndex);
+
+    // A chain with its own bus owns those channels, so it can write there from any thread
+    if (processor.hasOwnOutput(oscillatorIndex))
+    {
+        auto output = processor.getOscillatorOutput(*processor.parallelBuffer, oscillatorIndex);
+        processor.oscillators[oscillatorIndex]->processBlock(output, start, length);
+        return;
+    }
+
+    auto& output = processor.oscillatorOutputs[oscillatorIndex];
+    for (int ch = 0; ch < output.getNumChannels(); ++ch)
+        output.clear(ch, start, length);
+
+    processor.oscillators[oscillatorIndex]->processBlock(output, start, length);
+}
+
+void DigitalSynthesizerAudioProcessor::captureSidechain(juce::AudioBuffer<float>& buffer)
+{
+    if (!sidechainConnected)
+        return;
+
+    const int numSamples = juce::jmin(buffer.getNumSamples(), static_cast<int>(sidechainSamples.size()));
+    juce::FloatVectorOperations::clear(sidechainSamples.data(), numSamples);
+
+    const auto input = getBusBuffer(buffer, true, sidechainBus);
+    if (input.getNumChannels() == 0)
+        return;
+
+    const float scale = 1.0f / static_cast<float>(input.getNumChannels());
+    for (int ch = 0; ch < input.getNumChannels(); ++ch)
+        juce::FloatVectorOperations::addWithMultiply(sidechainSamples.data(), input.getReadPointer(ch), scale, numSamples);
+}
+
+juce::AudioBuffer<float> DigitalSynthesizerAudioProcessor::getOscillatorOutput(juce::AudioBuffer<float>& buffer, int oscillatorIndex)
+{
+    return getBusBuffer(buffer, false, hasOwnOutput(oscillatorIndex) ? firstOscillatorBus + oscillatorIndex : 0);
+}
+
+bool DigitalSynthesizerAudioProcessor::hasOwnOutput(int oscillatorIndex) const
+{
+    const auto* bus = getBus(false, firstOscillatorBus + oscillatorIndex);
+    return bus != nullptr && bus->isEnabled() && bus->getNumberOfChannels() > 0;
+}
+
+int DigitalSynthesizerAudioProcessor::getNumRenderChannels() const
+{
+    int numChannels = 1;
+    for (int bus = 0; bus < getBusCount(false); ++bus)
+        numChannels = juce::jmax(numChannels, getChannelCountOfBus(false, bus));
+
+    return juce::jmin(numChannels, 2);
+}
+
+void DigitalSynthesizerAudioProcessor::endEnvelopeBlock()
 {
-    const int numChannels = getTotalNumOutputChannels();
-    const float normalization = headroomFactor / NUM_OF_OSCILLATORS;
+    PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::Envelopes);
 
-    // Step 1: Clear the segment we are going to write into
-    for (int ch = 0; ch < numChannels; ++ch)
-        buffer.clear(ch, startSample, numSamples);
+    for (auto& env : envelopes)
+        env->endBlock();
+}
 
-    // Step 2: Each oscillator sums into the buffer
-    for (auto& osc : oscillators)
+void DigitalSynthesizerAudioProcessor::pushEnvelopeModulation()
+{
+    for (int i = 0; i < static_cast<int>(envelopes.size()); ++i)
     {
-        osc->processBlock(buffer, startSample, numSamples);
+        float envOut = envelopes[i]->getModulationValue();
+        modulationRouter.pushModulationValue({ ModulationSourceType::Envelope, i }, envOut);
     }
+}
 
-    // Step 3: Apply normalization and master gain
-    for (int ch = 0; ch < numChannels; ++ch)
+void DigitalSynthesizerAudioProcessor::beginEnvelopeModulation(int blockSize)
+{
+    for (int i = 0; i < NUM_OF_ENVELOPES; ++i)
     {
-        float* channelData = buffer.getWritePointer(ch, startSample);
-        for (int i = 0; i < numSamples; ++i)
-        {
-            float masterGain = masterVolume.getNextValue();
-            channelData[i] *= normalization * masterGain;
-        }
+        auto& envelopeBuffer = envelopeModulationBuffers[i];
+
+        // processBlock() splits longer host blocks, so the span always fits the prepared buffer
+        jassert(blockSize <= static_cast<int>(envelopeBuffer.size()));
+
+        // Nothing reads a sample before renderEnvelopeModulation() has written it
+        modulationRouter.setModulationSpan({ ModulationSourceType::Envelope, i }, envelopeBuffer.data(), blockSize);
     }
+}
 
-    // Step 4: Update meters
-    updateOutputPeakLevels(buffer, startSample, numSamples);
+void DigitalSynthesizerAudioProcessor::renderEnvelopeModulation(int startSample, int numSamples)
+{
+    PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::Envelopes);
+
+    for (int i = 0; i < NUM_OF_ENVELOPES; ++i)
+        envelopes[i]->renderModulation(envelopeModulationBuffers[i].data() + startSample, startSample, numSamples);
 }
 
-void DigitalSynthesizerAudioProcessor::tickEnvelopes()
+void DigitalSynthesizerAudioProcessor::trackHostAutomation(int numSamples)
 {
-    for (auto& env : envelopes)
-        env->tick();
+    automationRamping = false;
+    for (auto& target : modulationTargets)
+        automationRamping |= target->beginAutomationBlock(numSamples);
 }
 
-void DigitalSynthesizerAudioProcessor::pushEnvelopeModulation()
+void DigitalSynthesizerAudioProcessor::applyModulation(int sampleIndex)
 {
-    for (int i = 0; i < static_cast<int>(envelopes.size()); ++i)
+    for (auto& osc : oscillators)
+        osc->applyModulation(sampleIndex);
+
+    for (auto& filter : filters)
+        filter->applyModulation(sampleIndex);
+}
+
+void DigitalSynthesizerAudioProcessor::applyQualityLimits(int numSamples)
+{
+    static_assert(QualityGovernor::Limits{}.modulationSubBlockSize == ModulationRouter::subBlockSize,
+                  "Full quality must apply modulation at the router's rate");
+    static_assert(QualityGovernor::Limits{}.maxUnisonVoices == Oscillator::maxVoices,
+                  "Full quality must render every unison voice");
+
+    static constexpr QualityGovernor::Limits fullQuality;
+
+    const bool realtime = !isNonRealtime();
+    if (realtime)
+        qualityGovernor.update(dspLoadMeter.getLoad(), numSamples);
+
+    const auto& offlineLimits = qualityGovernor.isHighQualityOffline() ? QualityGovernor::offlineLimits : fullQuality;
+    const auto& limits = realtime ? qualityGovernor.getLimits() : offlineLimits;
+
+    using Interpolation = WavetableBank::Interpolation;
+    const auto interpolation = limits.cubicTables ? Interpolation::Cubic
+                             : limits.interpolateTables ? Interpolation::Linear
+                             : Interpolation::Truncated;
+
+    for (auto& osc : oscillators)
+        osc->setQualityLimits(limits.maxUnisonVoices, interpolation);
+
+    const auto minOversampling = static_cast<Filter::Oversampling>(
+        juce::jlimit(0, static_cast<int>(Filter::Oversampling::Count) - 1, limits.minOversampling));
+
+    for (auto& filter : filters)
     {
-        float envOut = envelopes[i]->getModulationValue();
-        modulationRouter.pushModulationValue({ ModulationSourceType::Envelope, i }, envOut);
+        filter->setOversamplingAllowed(limits.allowOversampling);
+        filter->setMinimumOversampling(minOversampling);
     }
+
+    modulationSubBlockSize = limits.modulationSubBlockSize;
 }
 
 void DigitalSynthesizerAudioProcessor::finalizeNotes()
 {
+    PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::FinalizeNotes);
+
     // Remove any released notes
     for (auto& osc : oscillators)
     {
@@ -354,7 +1098,22 @@ void DigitalSynthesizerAudioProcessor::finalizeNotes()
             });
     }
 
-    // If no envelopes remain active, disable all LFO modulation
+    // Levels for the Quietest policy, notes no envelope plays any more are forgotten
+    voiceAllocator.update([this](int midiNote)
+        {
+            float level = -1.0f;
+            for (auto& osc : oscillators)
+            {
+                if (auto* env = osc->getEnvelope())
+                    level = juce::jmax(level, env->getNoteLevel(osc->calculateMidiNoteWithOctaveOffset(midiNote)));
+            }
+            return level;
+        });
+
+    // Once no envelope remains active, disable all LFO modulation until the next note
+    if (!lfoModulationActive)
+        return;
+
     bool anyActive = std::any_of(envelopes.begin(), envelopes.end(),
         [](const std::unique_ptr<Envelope>& env)
         {
@@ -365,6 +1124,8 @@ void DigitalSynthesizerAudioProcessor::finalizeNotes()
     {
         for (auto& lfo : lfos)
             lfo->setModulationActive(false);
+
+        lfoModulationActive = false;
     }
 }
 
@@ -398,13 +1159,13 @@ LFO* DigitalSynthesizerAudioProcessor::getLFO(int index)
 
 bool DigitalSynthesizerAudioProcessor::isEnvelopeLinkedToOscillator(int envelopeIndex) const
 {
-    if (envelopeIndex < 0 || envelopeIndex >= NUM_OF_OSCILLATORS)
+    if (envelopeIndex < 0 || envelopeIndex >= NUM_OF_ENVELOPES)
         return false;
 
-    for (const auto& osc : oscillators)
+    // The links as last edited, the audio thread may pick them up a block later
+    for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
     {
-        const Envelope* linkedEnv = osc->getEnvelope();
-        if (linkedEnv == envelopes[envelopeIndex].get())
+        if (signalGraph.getEnvelope(i) == envelopes[envelopeIndex].get())
             return true;
     }
 
@@ -419,36 +1180,55 @@ void DigitalSynthesizerAudioProcessor::registerKnob(Knob* knob)
     }
 }
 
-void DigitalSynthesizerAudioProcessor::handleControllerMessage(const juce::MidiMessage& message)
+void DigitalSynthesizerAudioProcessor::handleControllerMessage(int controller, int value)
 {
-    int ccNumber = message.getControllerNumber();
-    float ccValue = message.getControllerValue() / 127.0f;
-
-    if (MidiController::assignedKnobs.find(ccNumber) == MidiController::assignedKnobs.end())
+    if (MidiController::assignedKnobs.find(controller) == MidiController::assignedKnobs.end())
         return;
 
+    midiCCMap.handleController(controller, value, parameterRelay);
+}
+
+bool DigitalSynthesizerAudioProcessor::setRemoteControlPort(int port)
+{
+    const bool connected = port > 0 ? oscRemoteControl.connect(port) : false;
+    if (!connected)
+        oscRemoteControl.disconnect();
+
+    apvts.state.setProperty(remoteControlPortProperty, connected ? port : 0, nullptr);
+    return connected || port == 0;
+}
+
+int DigitalSynthesizerAudioProcessor::getRemoteControlPort() const
+{
+    return oscRemoteControl.getPort();
+}
+
+void DigitalSynthesizerAudioProcessor::storeEngineOptions()
+{
+    apvts.state.setProperty(multiCoreRenderingProperty, multiCoreRendering.load(), nullptr);
+}
 
-    if (getActiveEditor() == nullptr)
+void DigitalSynthesizerAudioProcessor::restoreRemoteControl()
+{
+    const int port = apvts.state.getProperty(remoteControlPortProperty, 0);
+    if (port == oscRemoteControl.getPort())
         return;
 
-    for (auto* knob : knobs)
-    {
-        if (!knob)
-            continue;
+    if (port <= 0 || !oscRemoteControl.connect(port))
+        oscRemoteControl.disconnect();
+}
 
-        if (knob->isLearning())
-        {
-            juce::MessageManager::callAsync([knob, ccNumber]() {
-                knob->assignMidiCC(ccNumber);
-                });
-            return;
-        }
+void DigitalSynthesizerAudioProcessor::dispatchMidiLearnEvents()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
 
-        if (knob->getAssignedMidiCC() == ccNumber)
+    MidiCCMap::LearnEvent event;
+    while (midiCCMap.popLearnEvent(event))
+    {
+        for (auto* knob : knobs)
         {
-            juce::MessageManager::callAsync([knob, ccValue]() {
-                knob->setSliderValue(ccValue);
-                });
+            if (knob != nullptr && knob->getParamID() == event.parameter->paramID)
+                knob->assignMidiCC(event.controller);
         }
     }
 }
@@ -477,13 +1257,10 @@ bool DigitalSynthesizerAudioProcessor::registerEnvelopeLinkOwnership(Linkable* t
 
 bool DigitalSynthesizerAudioProcessor::registerFilterLinkOwnership(Linkable* target, FilterComponent* newOwner)
 {
-    auto it = filterOwners.find(target);
-    if (it != filterOwners.end() && it->second != newOwner)
-    {
-        it->second->unlinkTarget(target);
-    }
+    auto& owners = filterOwners[target];
+    if (std::find(owners.begin(), owners.end(), newOwner) == owners.end())
+        owners.push_back(newOwner);
 
-    filterOwners[target] = newOwner;
     return true;
 }
 
@@ -497,7 +1274,12 @@ void DigitalSynthesizerAudioProcessor::unregisterEnvelopeLink(Linkable* target,
 void DigitalSynthesizerAudioProcessor::unregisterFilterLink(Linkable* target, FilterComponent* owner)
 {
     auto it = filterOwners.find(target);
-    if (it != filterOwners.end() && it->second == owner)
+    if (it == filterOwners.end())
+        return;
+
+    auto& owners = it->second;
+    owners.erase(std::remove(owners.begin(), owners.end(), owner), owners.end());
+    if (owners.empty())
         filterOwners.erase(it);
 }
 
@@ -507,6 +1289,86 @@ void DigitalSynthesizerAudioProcessor::clearLinkOwnerships()
     filterOwners.clear();
 }
 
+void DigitalSynthesizerAudioProcessor::linkEnvelope(Linkable* target, Envelope* envelope)
+{
+    if (auto* osc = dynamic_cast<Oscillator*>(target))
+        signalGraph.setEnvelope(osc->getIndex(), envelope);
+}
+
+void DigitalSynthesizerAudioProcessor::linkFilter(Linkable* target, Filter* filter)
+{
+    auto* osc = dynamic_cast<Oscillator*>(target);
+    if (osc != nullptr && filter != nullptr)
+        signalGraph.connectFilter(osc->getIndex(), filter);
+}
+
+void DigitalSynthesizerAudioProcessor::unlinkFilter(Linkable* target, Filter* filter)
+{
+    if (auto* osc = dynamic_cast<Oscillator*>(target))
+        signalGraph.disconnectFilter(osc->getIndex(), filter);
+}
+
+void DigitalSynthesizerAudioProcessor::loadUserWavetable(int oscillator, const juce::File& source)
+{
+    if (oscillator < 0 || oscillator >= NUM_OF_OSCILLATORS || !source.existsAsFile())
+    {
+        jassertfalse;
+        return;
+    }
+
+    apvts.state.getOrCreateChildWithName(userWavetablesType, nullptr)
+        .setProperty(getUserWavetableProperty(oscillator), source.getFullPathName(), nullptr);
+
+    // The previous table keeps playing until the new one is mapped
+    if (const auto* table = userWavetables->find(source))
+        oscillators[oscillator]->setUserWavetable(table);
+    userWavetables->load(source);
+
+    const auto waveformSpec = Oscillator::getComboBoxParamSpecs(Oscillator::ParamID::Waveform, oscillator);
+    if (auto* param = apvts.getParameter(waveformSpec.paramID))
+        param->setValueNotifyingHost(param->convertTo0to1(static_cast<float>(Oscillator::waveformToIndex(Oscillator::Waveform::User))));
+}
+
+void DigitalSynthesizerAudioProcessor::clearUserWavetable(int oscillator)
+{
+    if (oscillator < 0 || oscillator >= NUM_OF_OSCILLATORS)
+        return;
+
+    auto tables = apvts.state.getChildWithName(userWavetablesType);
+    if (tables.isValid())
+        tables.removeProperty(getUserWavetableProperty(oscillator), nullptr);
+
+    oscillators[oscillator]->setUserWavetable(nullptr);
+}
+
+juce::File DigitalSynthesizerAudioProcessor::getUserWavetableFile(int oscillator) const
+{
+    const auto path = apvts.state.getChildWithName(userWavetablesType)
+        .getProperty(getUserWavetableProperty(oscillator)).toString();
+
+    return juce::File::isAbsolutePath(path) ? juce::File(path) : juce::File();
+}
+
+void DigitalSynthesizerAudioProcessor::restoreUserWavetables()
+{
+    for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
+    {
+        // Tables another instance imported already are mapped, the rest arrive with a change message
+        const auto source = getUserWavetableFile(i);
+        oscillators[i]->setUserWavetable(userWavetables->find(source));
+        userWavetables->load(source);
+    }
+}
+
+void DigitalSynthesizerAudioProcessor::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
+    {
+        if (const auto* table = userWavetables->find(getUserWavetableFile(i)))
+            oscillators[i]->setUserWavetable(table);
+    }
+}
+
 std::vector<std::pair<ModulationSourceID, juce::String>> DigitalSynthesizerAudioProcessor::getAvailableModulationSources(ModulationSourceType type) const
 {
     std::vector<std::pair<ModulationSourceID, juce::String>> sources;
@@ -540,34 +1402,18 @@ ModulationRouter& DigitalSynthesizerAudioProcessor::getModulationRouter()
     return modulationRouter;
 }
 
+ModulationMatrix& DigitalSynthesizerAudioProcessor::getModulationMatrix()
+{
+    return modulationMatrix;
+}
+
 void DigitalSynthesizerAudioProcessor::restoreModulationRouting()
 {
     for (auto* knob : knobs)
     {
-        const auto ids = KnobModulationEngine::getParameterIDsFor(knob->getParamID());
-
-        auto* modeParam = apvts.getRawParameterValue(ids[0]);
-        auto* indexParam = apvts.getRawParameterValue(ids[1]);
-
-        if (modeParam && indexParam)
-        {
-            auto mode = static_cast<ModulationMode>(static_cast<int>(modeParam->load()));
-            auto index = static_cast<int>(indexParam->load());
-
-            switch (mode)
-            {
-            case ModulationMode::Envelope:
-                modulationRouter.connect({ ModulationSourceType::Envelope, index }, knob);
-                break;
-
-            case ModulationMode::LFO:
-                modulationRouter.connect({ ModulationSourceType::LFO, index }, knob);
-                break;
-
-            default:
-                break;
-            }
-        }
+        const auto route = modulationMatrix.getMainRoute(knob->getParamID());
+        if (route.isModulated())
+            modulationRouter.connect(route.getSource(), knob);
     }
 }
 
@@ -579,13 +1425,36 @@ void DigitalSynthesizerAudioProcessor::clearAllKnobs()
             modulationRouter.disconnect(knob);
     }
     knobs.clear();
+
+    // No knob is left to show a pending learn
+    midiCCMap.cancelLearn();
 }
-void DigitalSynthesizerAudioProcessor::handleNoteOnLfos()
+void DigitalSynthesizerAudioProcessor::handleNoteOnLfos(int sampleIndex, int blockSize)
 {
-    for (auto& lfo : lfos)
+    PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::Lfos);
+
+    // Only the first note after the envelopes went idle turns modulation back on
+    const bool reactivate = !lfoModulationActive;
+    lfoModulationActive = true;
+
+    for (int i = 0; i < static_cast<int>(lfos.size()); ++i)
     {
+        auto& lfo = lfos[i];
+        const bool wasRendered = lfo->isActive();
+
         lfo->noteOn();
-        lfo->setModulationActive(true);
+        if (reactivate)
+            lfo->setModulationActive(true);
+
+        if (lfo->isBypassed())
+            continue;
+
+        // The rest of the block must follow the reset phase, or start the newly running LFO
+        if (!wasRendered || lfo->getMode() == LFO::Mode::Retrigger)
+            lfo->renderFrom(sampleIndex, blockSize, static_cast<float>(getSampleRate()));
+
+        modulationRouter.setModulationSpan({ ModulationSourceType::LFO, i },
+            lfo->getModulationBuffer(), lfo->getModulationBufferSize());
     }
 }
 
@@ -595,26 +1464,89 @@ void DigitalSynthesizerAudioProcessor::resetAllLfos()
         lfo->resetTrigger();
 }
 
+void DigitalSynthesizerAudioProcessor::updateHostTransport()
+{
+    // Without a playhead or a tempo the last known tempo stays, and nothing locks to a position
+    hostTransport.isPlaying = false;
+
+    auto* playHead = getPlayHead();
+    if (playHead == nullptr)
+        return;
+
+    const auto position = playHead->getPosition();
+    if (!position.hasValue())
+        return;
+
+    if (const auto bpm = position->getBpm(); bpm.hasValue() && *bpm > 0.0)
+        hostTransport.bpm = *bpm;
+
+    if (const auto ppq = position->getPpqPosition(); ppq.hasValue() && position->getIsPlaying())
+    {
+        hostTransport.ppqPosition = *ppq;
+        hostTransport.isPlaying = true;
+    }
+}
+
 void DigitalSynthesizerAudioProcessor::renderAllLFOs(int blockSize)
 {
+    PROFILE_STAGE(&stageProfiler, StageProfiler::Stage::Lfos);
+
     for (int i = 0; i < static_cast<int>(lfos.size()); ++i)
     {
         auto& lfo = lfos[i];
 
-        lfo->updateFromAPVTS(apvts);
+        lfo->updateFromParameters();
+        lfo->setTransport(hostTransport);
 
-        if (lfo->isBypassed())
+        const ModulationSourceID source{ ModulationSourceType::LFO, i };
+        const auto state = lfo->isBypassed() ? LfoSourceState::Bypassed
+                         : lfo->isActive() ? LfoSourceState::Running
+                         : LfoSourceState::Idle;
+
+        // A span set by a note-on is kept while the LFO runs, anything else leaves it once
+        auto& previousState = lfoSourceStates[static_cast<size_t>(i)];
+        if (state != previousState)
+        {
+            if (state != LfoSourceState::Running)
+                modulationRouter.clearModulationSpan(source);
+
+            previousState = state;
+        }
+
+        if (state == LfoSourceState::Bypassed)
         {
-            modulationRouter.disconnectAllTargetsUsing({ ModulationSourceType::LFO, i });
+            // Cut links when bypassed and when made while bypassed, never again once the table is clean
+            if (modulationRouter.isSourceRouted(source))
+                modulationRouter.disconnectAllTargetsUsing(source);
             continue;
         }
 
-        if (!lfo->isActive())
+        if (state == LfoSourceState::Idle)
             continue;
 
         lfo->advance(blockSize, static_cast<float>(getSampleRate()));
-        float val = lfo->getNextValue();
-        modulationRouter.pushModulationValue({ ModulationSourceType::LFO, i }, val);
+
+        if (lfo->isModulationActive())
+            modulationRouter.setModulationSpan(source, lfo->getModulationBuffer(), lfo->getModulationBufferSize());
+        else
+            modulationRouter.clearModulationSpan(source);
+    }
+}
+
+void DigitalSynthesizerAudioProcessor::pushLfoModulation()
+{
+    for (int i = 0; i < static_cast<int>(lfos.size()); ++i)
+    {
+        auto& lfo = lfos[i];
+        if (lfo->isBypassed() || !lfo->isActive())
+            continue;
+
+        const ModulationSourceID source{ ModulationSourceType::LFO, i };
+        const auto span = modulationRouter.getModulationSpan(source);
+
+        // Inactive modulation drives targets to the bottom of their range, as before
+        const float value = (lfo->isModulationActive() && span.isValid()) ? span.getLastValue() : 0.0f;
+        modulationRouter.pushModulationValue(source, value);
     }
 }
 
@@ -623,31 +1555,81 @@ void DigitalSynthesizerAudioProcessor::setMasterVolume(float newVolume)
     masterVolume.setTargetValue(juce::jlimit(0.0f, 1.0f, newVolume));
 }
 
-float DigitalSynthesizerAudioProcessor::getMasterVolumeL() const noexcept
+MeterBus& DigitalSynthesizerAudioProcessor::getMeterBus() noexcept
 {
-    return masterVolumeLDb;
+    return meterBus;
 }
 
-float DigitalSynthesizerAudioProcessor::getMasterVolumeR() const noexcept
+DspLoadMeter& DigitalSynthesizerAudioProcessor::getDspLoadMeter() noexcept
 {
-    return masterVolumeRDb;
+    return dspLoadMeter;
 }
 
-void DigitalSynthesizerAudioProcessor::updateOutputPeakLevels(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+QualityGovernor& DigitalSynthesizerAudioProcessor::getQualityGovernor() noexcept
 {
-    float peakL = 0.0f;
-    float peakR = 0.0f;
+    return qualityGovernor;
+}
 
-    for (int i = startSample; i < startSample + numSamples; ++i)
-    {
-        peakL = std::max(peakL, std::abs(buffer.getSample(0, i)));
-        if (buffer.getNumChannels() > 1)
-            peakR = std::max(peakR, std::abs(buffer.getSample(1, i)));
-    }
+EngineStats& DigitalSynthesizerAudioProcessor::getEngineStats() noexcept
+{
+    return engineStats;
+}
+
+void DigitalSynthesizerAudioProcessor::updateMemoryStats()
+{
+    const auto bufferBytes = [](const juce::AudioBuffer<float>& buffer)
+        {
+            return static_cast<size_t>(buffer.getNumChannels()) * static_cast<size_t>(buffer.getNumSamples()) * sizeof(float);
+        };
+
+    const auto vectorBytes = [](const std::vector<float>& samples)
+        {
+            return samples.capacity() * sizeof(float);
+        };
+
+    // The band-limited tables are shared by every instance, this one counts them as its own
+    size_t bytes = sizeof(WavetableBank);
+
+    for (const auto& scratch : oscillatorScratchBuffers)
+        bytes += scratch.getMemoryBytes();
+
+    for (const auto& scratch : filterScratchBuffers)
+        bytes += scratch.getMemoryBytes();
+
+    for (const auto& output : oscillatorOutputs)
+        bytes += bufferBytes(output);
 
-    constexpr float minLevel = 1e-5f; // avoid log(0)
-    masterVolumeLDb = 20.0f * std::log10(std::max(peakL, minLevel));
-    masterVolumeRDb = 20.0f * std::log10(std::max(peakR, minLevel));
+    for (const auto& osc : oscillators)
+        bytes += osc->getMemoryBytes();
+
+    for (const auto& env : envelopes)
+        bytes += env->getMemoryBytes();
+
+    for (const auto& envelopeBuffer : envelopeModulationBuffers)
+        bytes += vectorBytes(envelopeBuffer);
+
+    bytes += bufferBytes(filterBusBuffer)
+        + vectorBytes(sidechainSamples) + vectorBytes(masterGainRamp) + vectorBytes(stateSwapRamp)
+        + effectsChain.getMemoryBytes();
+
+    engineStats.setMemoryBytes(bytes);
+}
+
+void DigitalSynthesizerAudioProcessor::publishEngineStats(bool rendered) noexcept
+{
+    for (int i = 0; i < static_cast<int>(oscillators.size()); ++i)
+        engineStats.setOscillatorVoices(i, oscillators[static_cast<size_t>(i)]->getNumActiveNotes());
+
+    for (int i = 0; i < static_cast<int>(envelopes.size()); ++i)
+        engineStats.setEnvelopeVoices(i, envelopes[static_cast<size_t>(i)]->getNumActiveVoices());
+
+    engineStats.addBlock(rendered);
+}
+
+void DigitalSynthesizerAudioProcessor::updateOutputPeakLevels(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    // Levels accumulate over the whole block and are published once at its end
+    blockPeak = std::max(blockPeak, meterBus.accumulate(buffer, startSample, numSamples));
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -655,6 +1637,25 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
     return new DigitalSynthesizerAudioProcessor();
 }
 
+juce::AudioProcessor::BusesProperties DigitalSynthesizerAudioProcessor::createBusesProperties()
+{
+    BusesProperties buses;
+
+#if !JucePlugin_IsMidiEffect
+#if !JucePlugin_IsSynth
+    buses.addBus(true, "Input", juce::AudioChannelSet::stereo(), true);
+#endif
+    buses.addBus(false, "Output", juce::AudioChannelSet::stereo(), true);
+
+    for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
+        buses.addBus(false, "Osc " + juce::String(i + 1), juce::AudioChannelSet::stereo(), false);
+
+    buses.addBus(true, "Sidechain", juce::AudioChannelSet::stereo(), false);
+#endif
+
+    return buses;
+}
+
 juce::AudioProcessorValueTreeState& DigitalSynthesizerAudioProcessor::getAPVTS()
 {
     return apvts;
@@ -668,30 +1669,38 @@ juce::AudioProcessorValueTreeState::ParameterLayout DigitalSynthesizerAudioProce
     for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
     {
         Oscillator::addParameters(i, layout);
-        OscillatorComponent::registerModulationParameters(i, layout);
     }
 
     // === Envelopes ===
     for (int i = 0; i < NUM_OF_ENVELOPES; ++i)
     {
         Envelope::addParameters(i, layout);
-        EnvelopeComponent::registerModulationParameters(i, layout);
     }
 
     // === Filters ===
     for (int i = 0; i < NUM_OF_FILTERS; ++i)
     {
         Filter::addParameters(i, layout);
-        FilterComponent::registerModulationParameters(i, layout);
     }
 
     // === LFOs ===
     for (int i = 0; i < NUM_OF_LFOS; ++i)
     {
         LFO::addParameters(i, layout);
-        LFOComponent::registerModulationParameters(i, layout);
     }
 
+    // === Voices ===
+    VoiceAllocator::addParameters(layout);
+
+    // === Arpeggiator ===
+    Arpeggiator::addParameters(layout);
+
+    // === Sidechain Talkbox ===
+    SidechainTalkbox::addParameters(layout);
+
+    // === Effects ===
+    EffectsChain::addParameters(layout);
+
     return layout;
 }
 
@@ -700,42 +1709,56 @@ void DigitalSynthesizerAudioProcessor::initializeModulationTargets()
     // Loop every base parameter ID that our proxies should manage
     for (auto& baseID : ModulationTarget::getAllBaseParameterIDs())
     {
-        // Create the proxy and cache it
-        auto proxy = std::make_unique<ModulationTarget>(apvts, modulationRouter, baseID);
-
-        // Fetch the companion modulation parameters for this baseID
-        auto ids = KnobModulationEngine::getParameterIDsFor(baseID);
-        auto* modeParam = apvts.getRawParameterValue(ids[0]);
-        auto* indexParam = apvts.getRawParameterValue(ids[1]);
-        auto* minParam = apvts.getRawParameterValue(ids[2]);
-        auto* maxParam = apvts.getRawParameterValue(ids[3]);
-
-        if (modeParam && indexParam && minParam && maxParam)
-        {
-            // Read current modulation settings
-            int modeInt = static_cast<int>(modeParam->load());
-            int index = static_cast<int>(indexParam->load());
-            float minNorm = minParam->load();
-            float maxNorm = maxParam->load();
-
-            // Configure the proxy’s mode & range
-            proxy->setModulationMode(static_cast<ModulationMode>(modeInt));
-            proxy->setModulationRange(minNorm, maxNorm);
-
-            // If the proxy is in Envelope or LFO mode, connect it now
-            if (static_cast<ModulationMode>(modeInt) == ModulationMode::Envelope)
-            {
-                modulationRouter.connect({ ModulationSourceType::Envelope, index },
-                    proxy.get());
-            }
-            else if (static_cast<ModulationMode>(modeInt) == ModulationMode::LFO)
-            {
-                modulationRouter.connect({ ModulationSourceType::LFO, index },
-                    proxy.get());
-            }
-        }
+        // The proxy applies its stored routing itself
+        auto proxy = std::make_unique<ModulationTarget>(apvts, modulationRouter, modulationMatrix, baseID);
 
         // Finally, take ownership of the proxy
         modulationTargets.push_back(std::move(proxy));
     }
 }
+
+ModulationTarget* DigitalSynthesizerAudioProcessor::findModulationTarget(const juce::String& baseParamID) const
+{
+    for (const auto& target : modulationTargets)
+    {
+        if (target->getBaseParameterID() == baseParamID)
+            return target.get();
+    }
+
+    return nullptr;
+}
+
+void DigitalSynthesizerAudioProcessor::connectModulationTargets()
+{
+    for (int i = 0; i < NUM_OF_OSCILLATORS; ++i)
+    {
+        using P = Oscillator::ParamID;
+        for (auto id : { P::Volume, P::Pan, P::Voices, P::Detune, P::TablePosition })
+            oscillators[i]->setModulationTarget(id, findModulationTarget(Oscillator::getKnobParamSpecs(id, i).id));
+    }
+
+    for (int i = 0; i < NUM_OF_ENVELOPES; ++i)
+    {
+        const auto& specs = Envelope::getParamSpecs(i);
+        for (int stage = 0; stage < static_cast<int>(Envelope::ADSR::Count); ++stage)
+            envelopes[i]->setModulationTarget(static_cast<Envelope::ADSR>(stage), findModulationTarget(specs[stage].id));
+    }
+
+    for (int i = 0; i < NUM_OF_FILTERS; ++i)
+    {
+        using FP = Filter::ParamID;
+        for (auto id : { FP::Cutoff, FP::Resonance, FP::Drive, FP::Mix })
+            filters[i]->setModulationTarget(id, findModulationTarget(Filter::getKnobParamSpecs(id, i).id));
+
+        using TP = TalkboxFilter::ParamID;
+        for (auto id : { TP::Morph, TP::Factor })
+            filters[i]->setModulationTarget(id, findModulationTarget(TalkboxFilter::getKnobParamSpecs(id, i).id));
+    }
+
+    for (int i = 0; i < NUM_OF_LFOS; ++i)
+    {
+        using LP = LFO::ParamID;
+        for (auto id : { LP::Freq, LP::Shape, LP::Steps })
+            lfos[i]->setModulationTarget(id, findModulationTarget(LFO::getKnobParamSpecs(id, i).id));
+    }
+}
@@ -1,15 +1,35 @@
 ﻿#pragma once
 
 #include "Common.h"
+#include "Modules/Arpeggiator/Arpeggiator.h"
 #include "Modules/Linkable/Linkable.h"
 #include "Modules/PresetManager/PresetManager.h"
 #include "Modules/Oscillator/Oscillator.h"
+#include "Modules/PluginState/PluginStateCodec.h"
+#include "Modules/RemoteControl/OscRemoteControl.h"
 #include "Modules/Knob/Knob.h"
 #include "Modules/Knob/KnobModulation.h"
+#include "Modules/Knob/MidiCCMap.h"
 #include "Modules/Knob/ModulationTarget.h"
+#include "Modules/DspLoad/DspLoadMeter.h"
+#include "Modules/DspLoad/QualityGovernor.h"
 #include "Modules/Envelope/Envelope.h"
+#include "Modules/Effects/EffectsChain.h"
+#include "Modules/EngineStats/EngineStats.h"
 #include "Modules/Filter/Filter.h"
+#include "Modules/Filter/SidechainTalkbox.h"
 #include "Modules/LFO/LFO.h"
+#include "Modules/MidiEventList/MidiEventList.h"
+#include "Modules/ModulationMatrix/ModulationMatrix.h"
+#include "Modules/NoteExpression/NoteExpression.h"
+#include "Modules/ParameterRelay/ParameterRelay.h"
+#include "Modules/RenderPool/RenderPool.h"
+#include "Modules/ScratchBuffers/ScratchBuffers.h"
+#include "Modules/SignalGraph/SignalGraph.h"
+#include "Modules/StageProfiler/StageProfiler.h"
+#include "Modules/UserWavetable/UserWavetableLibrary.h"
+#include "Modules/VoiceAllocator/VoiceAllocator.h"
+#include "Modules/VolumeMeter/MeterBus.h"
 #include "Modules/VolumeMeter/VolumeMeter.h"
 #include <JuceHeader.h>
 
@@ -17,7 +37,8 @@
  * @class DigitalSynthesizerAudioProcessor
  * @brief The main audio processing unit for the digital synthesizer plugin.
  */
-class DigitalSynthesizerAudioProcessor : public juce::AudioProcessor
+class DigitalSynthesizerAudioProcessor : public juce::AudioProcessor,
+    private juce::ChangeListener
 {
 public:
     //==============================================================================
@@ -132,6 +153,31 @@ public:
      */
     PresetManager* getPresetManager();
 
+    /**
+     * @brief Starts fading the output out ahead of a state swap.
+     *
+     * Once the fade is complete the audio thread holds the output silent until
+     * endStateSwap(), so a state replaced in between never sounds half applied.
+     * Message thread only.
+     */
+    void beginStateSwap();
+
+    /**
+     * @brief Returns true once the output is held silent for a state swap.
+     */
+    bool isStateSwapHeld() const;
+
+    /**
+     * @brief Fades the output back in after a state swap. Message thread only.
+     */
+    void endStateSwap();
+
+    /**
+     * @brief Sets how long the output fades out, and back in, around a state swap.
+     * @param seconds Fade time, 0 to swap at the next block boundary without a fade.
+     */
+    void setStateSwapFadeTime(float seconds);
+
     //==============================================================================
     /** @name Editor & UI */
     //==============================================================================
@@ -164,6 +210,52 @@ public:
      */
     void releaseResources() override;
 
+    /**
+     * @brief Enables or disables rendering the oscillator chains on worker threads.
+     *
+     * Off by default. Hosts that already spread plugins across cores gain nothing
+     * from it, so it is meant for heavy patches in otherwise light sessions.
+     * The setting is saved with the session, not with presets. Call from the
+     * message thread.
+     *
+     * @param shouldBeEnabled True to render oscillator + filter chains in parallel.
+     */
+    void setMultiCoreRenderingEnabled(bool shouldBeEnabled);
+
+    /**
+     * @brief Returns true if multi-core rendering is enabled.
+     */
+    bool isMultiCoreRenderingEnabled() const;
+
+    /**
+     * @brief Offsets the seed of every noise and random source.
+     *
+     * Renders from the same patch, notes and seed are identical, and different
+     * seeds give independent noise and random steps. Seed 0 is the built-in
+     * seeds the golden renders use. Call before prepareToPlay(), never while
+     * the audio thread is running.
+     *
+     * @param seed Offset added to every module's seed.
+     */
+    void setRandomSeed(uint32_t seed);
+
+    /**
+     * @brief Enables or disables the oscillators' note render caches, see NoteRenderCache.
+     *
+     * Off by default. With it on, a one-shot patch renders each key's unison
+     * stack once and replays it on later hits for as long as nothing about the
+     * oscillator changes; modulated patches render live as before. Costs about
+     * 6 MB per oscillator at 48 kHz. Call from the message thread.
+     *
+     * @param shouldBeEnabled True to cache notes.
+     */
+    void setNoteRenderCacheEnabled(bool shouldBeEnabled);
+
+    /**
+     * @brief Returns true if the note render caches are enabled.
+     */
+    bool isNoteRenderCacheEnabled() const;
+
 #ifndef JucePlugin_PreferredChannelConfigurations
     /**
      * @brief Checks if the given channel layout is supported.
@@ -181,6 +273,7 @@ public:
      * @brief Main per-block audio and MIDI processing entry point.
      * Clears the buffer, updates parameters, renders MIDI by events,
      * generates audio, moves envelopes and LFOs forward, and removes finished notes.
+     * The whole render path is float, so double-precision hosts convert around this call.
      * @param buffer The audio buffer to fill.
      * @param midiMessages The MIDI events for this block.
      */
@@ -220,10 +313,39 @@ public:
     void registerKnob(Knob* knob);
 
     /**
-     * @brief Handles incoming MIDI control change messages.
-     * @param message The incoming MIDI message.
+     * @brief Handles an incoming MIDI control change. Audio thread only.
+     * @param controller CC number.
+     * @param value 7-bit controller value.
+     */
+    void handleControllerMessage(int controller, int value);
+
+    /**
+     * @brief Returns the CC to parameter table used by MIDI Learn.
+     */
+    MidiCCMap& getMidiCCMap() { return midiCCMap; }
+
+    /**
+     * @brief Starts or stops parameter control over OSC and stores the port in the state.
+     *
+     * The port is restored with the state, so a session keeps listening without
+     * an editor. Never call from the audio thread.
+     *
+     * @param port UDP port to listen on, 0 to stop listening.
+     * @return False if the port could not be bound, remote control is then off.
+     */
+    bool setRemoteControlPort(int port);
+
+    /**
+     * @brief Returns the UDP port listened on for OSC, 0 if remote control is off.
+     */
+    int getRemoteControlPort() const;
+
+    /**
+     * @brief Hands bindings made by MIDI Learn on the audio thread to the registered knobs.
+     *
+     * Message thread only.
      */
-    void handleControllerMessage(const juce::MidiMessage& message);
+    void dispatchMidiLearnEvents();
 
     //==============================================================================
     /** @name Linkable Modulation System */
@@ -250,7 +372,9 @@ public:
     bool registerEnvelopeLinkOwnership(Linkable* target, class EnvelopeComponent* newOwner);
 
     /**
-     * @brief Registers ownership of a target Linkable by a FilterComponent.
+     * @brief Registers a FilterComponent as linking a target Linkable.
+     *
+     * A target runs through every filter linked to it, so no other owner is unlinked.
      * @return True if the link was successful.
      */
     bool registerFilterLinkOwnership(Linkable* target, class FilterComponent* newOwner);
@@ -274,6 +398,54 @@ public:
      */
     void clearLinkOwnerships();
 
+    /**
+     * @brief Links an envelope to a target's notes in the signal graph. Message thread only.
+     * @param target The Linkable to play.
+     * @param envelope The envelope, or nullptr to unlink.
+     */
+    void linkEnvelope(Linkable* target, Envelope* envelope);
+
+    /**
+     * @brief Appends a filter to a target's chain in the signal graph. Message thread only.
+     */
+    void linkFilter(Linkable* target, Filter* filter);
+
+    /**
+     * @brief Removes a filter from a target's chain in the signal graph. Message thread only.
+     */
+    void unlinkFilter(Linkable* target, Filter* filter);
+
+    /**
+     * @brief Returns the routing of the oscillators through their envelopes and filters.
+     */
+    SignalGraph& getSignalGraph() { return signalGraph; }
+
+    /**
+     * @brief Imports a wavetable for an oscillator and switches it to the User waveform. Message thread only.
+     *
+     * The file is kept in the state, so presets and sessions bring it back.
+     * The import runs in the background; the oscillator stays silent until
+     * the table arrives.
+     * @param oscillator Oscillator index.
+     * @param source Audio file to import.
+     */
+    void loadUserWavetable(int oscillator, const juce::File& source);
+
+    /**
+     * @brief Forgets an oscillator's imported wavetable. Message thread only.
+     */
+    void clearUserWavetable(int oscillator);
+
+    /**
+     * @brief Returns the file an oscillator's wavetable is imported from, or an empty File.
+     */
+    juce::File getUserWavetableFile(int oscillator) const;
+
+    /**
+     * @brief Requests the wavetables the current state names, after a preset or session was loaded.
+     */
+    void restoreUserWavetables();
+
     /** @brief Returns a reference to the registered knob pointers. */
     const std::vector<Knob*>& getKnobs() const { return knobs; }
 
@@ -301,14 +473,31 @@ public:
      */
     ModulationRouter& getModulationRouter();
 
+    /**
+     * @brief Provides access to the additional modulation slots stored with the state.
+     *
+     * Used by UI components (e.g., Knob) to add sources on top of a parameter's main source.
+     *
+     * @return Reference to the internal ModulationMatrix.
+     */
+    ModulationMatrix& getModulationMatrix();
+
     /**
      * @brief Re-establishes modulation connections for all registered knobs
-     *        based on their saved MOD_SOURCE and MOD_INDEX APVTS values.
+     *        based on their main routes in the ModulationMatrix.
      *
      * Called after loading a preset to restore correct runtime routing.
      */
     void restoreModulationRouting();
 
+    /**
+     * @brief Writes the session's engine options into the state, after a preset replaced it.
+     *
+     * Presets carry sound settings only, so multi-core rendering is stamped
+     * back into the tree for the session to keep saving it.
+     */
+    void storeEngineOptions();
+
     /** @brief Unregister all knobs (called when editor is closed). */
     void clearAllKnobs();
 
@@ -320,22 +509,39 @@ public:
     void setMasterVolume(float newVolume);
 
     /**
-     * @brief Gets the current peak volume (in dB) of the left output channel.
-     * @return The left channel volume in decibels.
+     * @brief Gets the bus carrying output levels from the audio thread to the meters.
+     * @return Reference to the meter bus, popped from the message thread only.
      */
-    float getMasterVolumeL() const noexcept;
+    MeterBus& getMeterBus() noexcept;
 
     /**
-     * @brief Gets the current peak volume (in dB) of the right output channel.
-     * @return The right channel volume in decibels.
+     * @brief Gets the meter timing processBlock against its deadline.
+     * @return Reference to the load meter, read from any thread.
      */
-    float getMasterVolumeR() const noexcept;
+    DspLoadMeter& getDspLoadMeter() noexcept;
 
     /**
-     * @brief Measures the output peak levels (in dB) across stereo channels and stores them.
-     *
-     * This method scans the given buffer region and computes the peak amplitude
-     * per channel, converting the result to decibels.
+     * @brief Gets the governor that lowers rendering quality while the load nears the deadline.
+     * @return Reference to the governor; enable, disable and read its level from any thread.
+     */
+    QualityGovernor& getQualityGovernor() noexcept;
+
+    /**
+     * @brief Gets the engine's voice, block, memory and allocation counters.
+     * @return Reference to the counters, read and reset from any thread.
+     */
+    EngineStats& getEngineStats() noexcept;
+
+#if STAGE_PROFILING
+    /**
+     * @brief Gets the profiler timing the stages of processBlock.
+     * @return Reference to the profiler, read from the message thread only.
+     */
+    StageProfiler& getStageProfiler() noexcept { return stageProfiler; }
+#endif
+
+    /**
+     * @brief Adds a rendered segment to the output meters and the block peak.
      *
      * @param buffer The audio buffer to scan.
      * @param startSample The starting sample index.
@@ -359,6 +565,15 @@ public:
      */
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    /**
+     * @brief Creates the bus layout: the main stereo output, one optional output per oscillator chain
+     *        and the optional talkbox sidechain input.
+     *
+     * The per-chain outputs and the sidechain start disabled, so hosts that
+     * only use the main bus see the plugin as before.
+     */
+    static BusesProperties createBusesProperties();
+
     //==============================================================================
     /** @name Internal Modulation Proxy System */
     //@{
@@ -380,6 +595,9 @@ private:
     /** @brief The sample rate of the processor, initialized during prepareToPlay. */
     double processorSampleRate{};
 
+    /** @brief Largest block announced in prepareToPlay, the capacity of the render buffers. */
+    int preparedBlockSize = 0;
+
     //==============================================================================
     /** @name Parameter System (APVTS) */
     //==============================================================================
@@ -387,6 +605,9 @@ private:
     /** @brief AudioProcessorValueTreeState (APVTS) for managing plugin parameters. */
     juce::AudioProcessorValueTreeState apvts;
 
+    /** @brief Sets parameters from the audio thread and announces them from the message thread. */
+    ParameterRelay parameterRelay{ apvts };
+
     //==============================================================================
     /** @name Preset & State Management */
     //==============================================================================
@@ -396,6 +617,11 @@ private:
      */
     std::unique_ptr<PresetManager> presetManager;
 
+    /**
+     * @brief Reads and writes the binary state exchanged with the host.
+     */
+    PluginStateCodec stateCodec{ apvts };
+
     //==============================================================================
     /** @name Synthesizer's Elements */
     //==============================================================================
@@ -433,6 +659,39 @@ private:
      */
     std::vector<std::unique_ptr<LFO>> lfos;
 
+    /** @brief Host tempo and song position of the current block, read by updateHostTransport(). */
+    LFO::Transport hostTransport;
+
+    /**
+     * @brief Scratch buffers borrowed by each oscillator during rendering.
+     *
+     * One set per module so oscillator chains can render on different threads.
+     * Sized in prepareToPlay() so the audio thread does not allocate.
+     */
+    std::array<ScratchBuffers, NUM_OF_OSCILLATORS> oscillatorScratchBuffers;
+
+    /** @brief Scratch buffers borrowed by each filter, see oscillatorScratchBuffers. */
+    std::array<ScratchBuffers, NUM_OF_FILTERS> filterScratchBuffers;
+
+    /** @brief Lane on the process-wide render workers, rendering oscillator chains in parallel when multi-core rendering is on. */
+    RenderPool renderPool;
+
+#if STAGE_PROFILING
+    /** @brief Times the stages of processBlock, on the audio thread and the render workers. */
+    StageProfiler stageProfiler;
+#endif
+
+    /** @brief Per-oscillator output of a parallel render, summed into the host buffer afterwards. */
+    std::array<juce::AudioBuffer<float>, NUM_OF_OSCILLATORS> oscillatorOutputs;
+
+    /** @brief Sum of the oscillators feeding the filter bus, filtered once and added to the main mix. */
+    juce::AudioBuffer<float> filterBusBuffer;
+
+    std::atomic<bool> multiCoreRendering{ false }; ///< True if multi-core rendering is enabled
+    int parallelStartSample = 0;                   ///< Start of the sub-block handed to the render tasks
+    int parallelNumSamples = 0;                    ///< Length of the sub-block handed to the render tasks
+    juce::AudioBuffer<float>* parallelBuffer = nullptr; ///< Host buffer written by chains with their own output bus
+
     //==============================================================================
     /** @name Audio + MIDI Processing */
     //==============================================================================
@@ -443,11 +702,24 @@ private:
     void updateParameters();
 
     /**
-     * @brief Processes MIDI and renders audio.
+     * @brief Renders a block longer than prepareToPlay() announced, in chunks of the prepared size.
+     *
+     * Every render buffer is sized for the prepared block, so a longer one
+     * is processed as consecutive blocks that fit instead of growing them on
+     * the audio thread.
+     * @param buffer The host buffer.
+     * @param midiMessages The host's MIDI for the whole block.
+     */
+    void processOversizedBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
+
+    /**
+     * @brief Applies the block's MIDI events and renders audio between them.
+     *
+     * Events sharing a sample position split the block once, and LFOs retrigger
+     * once for all note-ons at that position.
      * @param buffer The audio buffer to fill with synthesized samples.
-     * @param midiMessages The MIDI events to process for this block.
      */
-    void handleMidiAndRender(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages);
+    void handleMidiAndRender(juce::AudioBuffer<float>& buffer);
 
     /**
      * @brief Renders a contiguous block of audio samples.
@@ -458,20 +730,197 @@ private:
     void renderAudioSegment(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
 
     /**
-     * @brief Advances all ADSR envelopes.
+     * @brief Runs the sidechain talkbox and the effects over the rendered main mix, then meters it.
+     * @param buffer The host buffer, rendered for the whole block.
+     */
+    void processMasterStage(juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Renders every envelope voice to the end of the block.
+     */
+    void endEnvelopeBlock();
+
+    /**
+     * @brief Returns true if the oscillator chains share no envelope and can render concurrently.
+     */
+    bool canRenderOscillatorsInParallel() const;
+
+    /**
+     * @brief Hands the links of the signal graph's current program to the oscillators. Audio thread only.
+     */
+    void applySignalGraph();
+
+    /**
+     * @brief Returns true if an oscillator renders into the filter bus instead of its output.
+     */
+    bool feedsFilterBus(int oscillatorIndex) const;
+
+    /**
+     * @brief Runs the filter bus through its filters and adds it to the main mix.
+     * @param mainOutput The main output bus.
+     * @param startSample Start of the sub-block.
+     * @param numSamples Length of the sub-block.
+     */
+    void processFilterBus(juce::AudioBuffer<float>& mainOutput, int startSample, int numSamples);
+
+    /**
+     * @brief Render task: renders one oscillator chain into its own output buffer.
+     * @param context The processor.
+     * @param oscillatorIndex Index of the oscillator to render.
+     */
+    static void renderOscillatorTask(void* context, int oscillatorIndex);
+
+    /**
+     * @brief Returns the channels an oscillator chain writes to.
+     *
+     * A chain whose auxiliary output bus the host enabled writes straight into
+     * that bus and is left out of the main mix; every other chain writes to
+     * the main bus.
+     *
+     * @param buffer The host buffer, holding every enabled output bus.
+     * @param oscillatorIndex Index of the oscillator.
+     * @return A buffer referring to the chain's channels of the host buffer.
+     */
+    juce::AudioBuffer<float> getOscillatorOutput(juce::AudioBuffer<float>& buffer, int oscillatorIndex);
+
+    /**
+     * @brief Returns true if the host enabled the auxiliary output bus of an oscillator chain.
+     */
+    bool hasOwnOutput(int oscillatorIndex) const;
+
+    /**
+     * @brief Returns the channels oscillators and filters render, 2 if any enabled output bus is stereo.
      */
-    void tickEnvelopes();
+    int getNumRenderChannels() const;
 
     /**
      * @brief Routes envelope outputs into the modulation system.
      */
     void pushEnvelopeModulation();
 
+    /**
+     * @brief Publishes every envelope's per-sample modulation span for the coming block.
+     *
+     * The spans are filled by renderEnvelopeModulation() as the segments render.
+     * @param blockSize Number of samples in the block.
+     */
+    void beginEnvelopeModulation(int blockSize);
+
+    /**
+     * @brief Fills the envelope spans over a segment with the voices' per-sample output.
+     *
+     * Runs once the segment's MIDI events are applied and before the oscillators
+     * read it, so a note-on inside the block shapes its targets from its own sample.
+     * @param startSample First sample of the segment.
+     * @param numSamples Length of the segment.
+     */
+    void renderEnvelopeModulation(int startSample, int numSamples);
+
+    /**
+     * @brief Starts the automation ramp of every modulatable parameter for a block.
+     * @param numSamples Number of samples in the block.
+     */
+    void trackHostAutomation(int numSamples);
+
+    /**
+     * @brief Lets every DSP module sample the modulation spans before a sub-block.
+     * @param sampleIndex Sample index relative to the start of the block.
+     */
+    void applyModulation(int sampleIndex);
+
+    /**
+     * @brief Steps the quality governor and hands its limits to the oscillators and filters.
+     *
+     * Offline renders have no deadline and always run at full quality.
+     * @param numSamples Number of samples in the block about to be rendered.
+     */
+    void applyQualityLimits(int numSamples);
+
+    /**
+     * @brief Returns the modulation proxy of a base parameter.
+     * @param baseParamID The base parameter ID.
+     * @return The proxy, or nullptr if the parameter is not modulatable.
+     */
+    ModulationTarget* findModulationTarget(const juce::String& baseParamID) const;
+
+    /**
+     * @brief Hands each DSP module the modulation proxies of its parameters.
+     */
+    void connectModulationTargets();
+
     /**
      * @brief Removes finished notes and disables idle modulation.
      */
     void finalizeNotes();
 
+    /**
+     * @brief Returns true if the block can take the silent fast path.
+     *
+     * That is the case when no oscillator or envelope voice is active, the last
+     * block's output already decayed below silenceThreshold, and no note starts.
+     */
+    bool canSkipBlock() const;
+
+    /**
+     * @brief Silent fast path: handles controllers only and leaves the cleared buffer silent.
+     * @param numSamples Number of samples in the block.
+     */
+    void processSilentBlock(int numSamples);
+
+    /**
+     * @brief Points the state swap gain at silence or full gain for the requested phase.
+     */
+    void beginStateSwapBlock() noexcept;
+
+    /**
+     * @brief Reports the output held silent once a requested fade-out has finished.
+     */
+    void endStateSwapBlock() noexcept;
+
+    /**
+     * @brief Stores a pitch bend, pressure or slide event in the per-channel expression state.
+     * @param event Decoded MIDI event.
+     * @return True if the event was an expression event and the notes' lanes need refreshing.
+     */
+    bool updateNoteExpression(const MidiEventList::Event& event) noexcept;
+
+    static constexpr int expectedMidiEventsPerBlock = 256; ///< MIDI events reserved for up front
+    static constexpr size_t midiBytesPerEvent = 16;        ///< MidiBuffer bytes reserved per event, header included
+    static constexpr int slideController = 74;             ///< MPE slide (timbre) CC number
+
+    MidiEventList midiEvents; ///< This block's decoded MIDI, built once at the start of processBlock
+    juce::MidiBuffer chunkMidi; ///< MIDI of one chunk of an oversized block, reserved in prepareToPlay
+    VoiceAllocator voiceAllocator{ apvts }; ///< Polyphony limit and voice stealing across all oscillators
+    Arpeggiator arpeggiator{ apvts };       ///< Replaces the held keys by arpeggiated or sequenced notes
+
+    SidechainTalkbox sidechainTalkbox{ apvts }; ///< Vocodes the main mix with the sidechain input
+    std::vector<float> sidechainSamples;        ///< This block's sidechain input summed to mono
+    bool sidechainConnected = false;            ///< True if the host enabled the sidechain bus, set in prepareToPlay
+
+    EffectsChain effectsChain{ apvts };         ///< Chorus, delay and reverb over the main mix
+
+    /**
+     * @brief Sums the sidechain input to mono before the buffer is cleared for rendering.
+     * @param buffer The host buffer, whose first channels hold the inputs.
+     */
+    void captureSidechain(juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Moves the single voice of the Mono and Legato modes to another key, in every oscillator.
+     * @param transition Keys and retrigger chosen by the voice allocator.
+     * @param channel MIDI channel of the key event.
+     * @param sampleOffset Position of the key event within the current block.
+     */
+    void applyMonoTransition(const VoiceAllocator::MonoTransition& transition, int channel, int sampleOffset);
+
+    /**
+     * @brief Fades out and stops the notes a note-on stole voices from, in every oscillator.
+     * @param steals Notes chosen by the voice allocator.
+     * @param sampleOffset Position of the note-on within the current block.
+     */
+    void applyVoiceSteals(const VoiceAllocator::Steals& steals, int sampleOffset);
+    NoteExpression::ChannelState noteExpression; ///< Latest MPE expression per MIDI channel
+
     //==============================================================================
     /** @name Linkable Modulation System */
     //==============================================================================
@@ -484,20 +933,38 @@ private:
     std::unordered_map<Linkable*, class EnvelopeComponent*> envelopeOwners;
 
     /**
-    * @brief Tracks which filterComponent currently owns each Linkable target.
+    * @brief Tracks which FilterComponents currently link each Linkable target, in link order.
     */
-    std::unordered_map<Linkable*, class FilterComponent*> filterOwners;
+    std::unordered_map<Linkable*, std::vector<class FilterComponent*>> filterOwners;
+
+    /** @brief Oscillator to envelope and filter links, compiled for the audio thread. */
+    SignalGraph signalGraph;
+
+    /** @brief Imported wavetables, shared by every instance. */
+    juce::SharedResourcePointer<UserWavetableLibrary> userWavetables;
+
+    /**
+     * @brief Hands every oscillator the loaded table its state names, when the library finished a table.
+     */
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
 
     /** @brief Routes modulation values from sources (e.g., Envelopes) to registered knobs. */
     ModulationRouter modulationRouter;
 
+    /** @brief Additional modulation slots per parameter, kept in the APVTS state. */
+    ModulationMatrix modulationMatrix{ apvts };
+
     //==============================================================================
     /** @name LFOs handlers
     //==============================================================================
     /**
      * @brief Triggers all LFOs when a MIDI note-on is received.
+     *
+     * LFOs that restart or start running at the note re-render the rest of the block.
+     * @param sampleIndex Position of the note-on within the block.
+     * @param blockSize Number of samples in the block.
      */
-    void handleNoteOnLfos();
+    void handleNoteOnLfos(int sampleIndex, int blockSize);
 
     /**
      * @brief Resets all LFO triggers (e.g., on playback stop).
@@ -505,10 +972,41 @@ private:
     void resetAllLfos();
 
     /**
-     * @brief Advances and pushes modulation values for all triggered LFOs.
+     * @brief Reads the host tempo and song position once for the coming block.
+     */
+    void updateHostTransport();
+
+    /**
+     * @brief Renders all triggered LFOs for the coming block and publishes their spans.
+     *
+     * Idle and bypassed LFOs are skipped; their spans are cleared once, when
+     * they stop or get bypassed, and a bypassed LFO's links are only cut
+     * while the routing table still reads it.
      */
     void renderAllLFOs(int blockSize);
 
+    /**
+     * @enum LfoSourceState
+     * @brief What the modulation router was last told about an LFO.
+     */
+    enum class LfoSourceState : uint8_t
+    {
+        Idle,      ///< Not triggered, no span published
+        Running,   ///< Triggered, publishing a span every block
+        Bypassed   ///< Bypassed, no span and no links kept
+    };
+
+    /** @brief State of every LFO as of the last block, so transitions are applied once. */
+    std::array<LfoSourceState, NUM_OF_LFOS> lfoSourceStates{};
+
+    /** @brief True while the LFOs apply modulation, cleared once every envelope went idle. */
+    bool lfoModulationActive = true;
+
+    /**
+     * @brief Pushes each LFO's block-end value to its targets.
+     */
+    void pushLfoModulation();
+
     //==============================================================================
     /** @name Knob / MIDI Control System */
     //==============================================================================
@@ -518,6 +1016,21 @@ private:
      */
     std::vector<Knob*> knobs;
 
+    /**
+     * @brief CC to parameter bindings, applied on the audio thread with or without an editor.
+     */
+    MidiCCMap midiCCMap;
+
+    /**
+     * @brief OSC receiver whose parameter changes are applied at the start of each block.
+     */
+    OscRemoteControl oscRemoteControl{ *this };
+
+    /**
+     * @brief Listens on the OSC port stored in the state, or stops listening if it has none.
+     */
+    void restoreRemoteControl();
+
     /**
     * @brief Invisible proxies for each base parameter that support modulation.
     *
@@ -526,6 +1039,9 @@ private:
     */
     std::vector<std::unique_ptr<ModulationTarget>> modulationTargets;
 
+    /** @brief Per-sample envelope modulation values of the current block. */
+    std::array<std::vector<float>, NUM_OF_ENVELOPES> envelopeModulationBuffers;
+
     //==============================================================================
     /** @name Volume Control & Metering */
     //==============================================================================
@@ -533,12 +1049,78 @@ private:
     /** @brief Smoothed master volume to prevent clicks when adjusting output gain. */
     juce::SmoothedValue<float> masterVolume{ 1.0f };
 
-    /** @brief Last measured left channel peak volume in dB. */
-    float masterVolumeLDb = VolumeMeter::initialVolumeDb;
+    /** @brief Storage for the master volume ramp of the current segment. */
+    std::vector<float> masterGainRamp;
+
+    /**
+     * @enum StateSwapPhase
+     * @brief Progress of a state swap, see beginStateSwap().
+     */
+    enum class StateSwapPhase
+    {
+        Idle,      ///< No swap, output at full gain or fading back in
+        FadingOut, ///< Swap requested, output fading out
+        Held       ///< Output silent, the state may be replaced
+    };
+
+    /** @brief Current swap phase, advanced by the message thread and the audio thread. */
+    std::atomic<StateSwapPhase> stateSwapPhase{ StateSwapPhase::Idle };
+
+    /** @brief Smoothed output gain around a state swap. Audio thread only. */
+    juce::SmoothedValue<float> stateSwapGain{ 1.0f };
+
+    /** @brief Storage for the state swap ramp of the current segment. */
+    std::vector<float> stateSwapRamp;
+
+    /** @brief Fade time around a state swap in seconds. */
+    std::atomic<float> stateSwapFadeSeconds{ 0.01f };
+
+    /** @brief Output levels published once per block for the meters. */
+    MeterBus meterBus;
 
-    /** @brief Last measured right channel peak volume in dB. */
-    float masterVolumeRDb = VolumeMeter::initialVolumeDb;
+    /** @brief Time processBlock takes relative to the block it renders. */
+    DspLoadMeter dspLoadMeter;
+
+    /** @brief Lowers rendering cost while dspLoadMeter reports the deadline is near. */
+    QualityGovernor qualityGovernor;
+
+    /** @brief Voice, block and memory counters published for the editor and the logs. */
+    EngineStats engineStats;
+
+    /**
+     * @brief Publishes the bytes held in buffers, delay lines, caches and tables to engineStats.
+     *
+     * Call after anything resizes, never from the audio thread.
+     */
+    void updateMemoryStats();
+
+    /**
+     * @brief Publishes every oscillator's notes and every envelope's voices and counts the block.
+     * @param rendered True if the block rendered audio, false if it was skipped as silent.
+     */
+    void publishEngineStats(bool rendered) noexcept;
+
+    /** @brief Samples between modulation updates while spans are active, set by the quality governor. */
+    int modulationSubBlockSize = ModulationRouter::subBlockSize;
+
+    /** @brief True if host automation moved a modulatable parameter since the last block, sub-blocks then apply the ramp. */
+    bool automationRamping = false;
+
+    /** @brief Largest absolute output sample of the current block, over both channels. */
+    float blockPeak = 0.0f;
+
+    /** @brief Largest absolute output sample of the previous block. */
+    float lastBlockPeak = 0.0f;
+
+    /** @brief Output level (-100 dB) below which a tail counts as decayed. */
+    static constexpr float silenceThreshold = 1e-5f;
 
     /** @brief Global headroom factor for volume control. */
     static constexpr float headroomFactor = 0.7f;
+
+    /** @brief Input bus of the talkbox sidechain, after the main input of an effect build. */
+    static constexpr int sidechainBus = JucePlugin_IsSynth ? 0 : 1;
+
+    /** @brief Output bus of the first oscillator chain, the main bus being bus 0. */
+    static constexpr int firstOscillatorBus = 1;
 };
\ No newline at end of file